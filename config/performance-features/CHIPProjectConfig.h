@@ -0,0 +1,59 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      CHIP project configuration for standalone builds with the optional
+ *      performance features enabled, so that the unit tests cover them. Used with
+ *      chip_project_config_include_dirs=["//config/performance-features"].
+ *
+ */
+#ifndef PERFORMANCE_FEATURES_CHIPPROJECTCONFIG_H
+#define PERFORMANCE_FEATURES_CHIPPROJECTCONFIG_H
+
+#include "../standalone/CHIPProjectConfig.h"
+
+#define CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX 1
+
+// Few buckets, so that the tests share buckets between keys.
+#define CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX_BUCKETS 16
+
+#define CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS 1
+
+#define CHIP_IM_SERVER_LIST_ITEM_CARRY 1
+
+#define CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE 8
+
+#define CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING 1
+
+#define CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE 8
+
+#define CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE 16
+
+#define CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE 8
+
+#define CHIP_CONFIG_MRP_RTT_ESTIMATOR 1
+
+#define CHIP_CONFIG_GROUP_KEY_HINT_CACHE_SIZE 8
+
+#define CHIP_CONFIG_ACCESS_CONTROL_INDEX 1
+
+#define CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX 1
+
+#define CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX 1
+
+#endif /* PERFORMANCE_FEATURES_CHIPPROJECTCONFIG_H */
@@ -0,0 +1,29 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      chip::System project configuration for standalone builds with the
+ *      optional performance features enabled: the same as config/standalone.
+ *
+ */
+#ifndef PERFORMANCE_FEATURES_SYSTEMPROJECTCONFIG_H
+#define PERFORMANCE_FEATURES_SYSTEMPROJECTCONFIG_H
+
+#include "../standalone/SystemProjectConfig.h"
+
+#endif /* PERFORMANCE_FEATURES_SYSTEMPROJECTCONFIG_H */
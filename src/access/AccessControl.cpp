@@ -23,6 +23,12 @@
 
 #include "AccessControl.h"
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+#include "AccessControlIndex.h"
+
+#include <lib/support/CHIPMem.h>
+#endif
+
 #include <lib/core/Global.h>
 
 namespace chip {
@@ -49,27 +55,6 @@ static_assert(((unsigned(Privilege::kAdminister) & unsigned(Privilege::kManage))
                   ((unsigned(Privilege::kView) & unsigned(Privilege::kProxyView)) == 0),
               "Privilege bits must be unique");
 
-bool CheckRequestPrivilegeAgainstEntryPrivilege(Privilege requestPrivilege, Privilege entryPrivilege)
-{
-    switch (entryPrivilege)
-    {
-    case Privilege::kView:
-        return requestPrivilege == Privilege::kView;
-    case Privilege::kProxyView:
-        return requestPrivilege == Privilege::kProxyView || requestPrivilege == Privilege::kView;
-    case Privilege::kOperate:
-        return requestPrivilege == Privilege::kOperate || requestPrivilege == Privilege::kView;
-    case Privilege::kManage:
-        return requestPrivilege == Privilege::kManage || requestPrivilege == Privilege::kOperate ||
-            requestPrivilege == Privilege::kView;
-    case Privilege::kAdminister:
-        return requestPrivilege == Privilege::kAdminister || requestPrivilege == Privilege::kManage ||
-            requestPrivilege == Privilege::kOperate || requestPrivilege == Privilege::kView ||
-            requestPrivilege == Privilege::kProxyView;
-    }
-    return false;
-}
-
 constexpr bool IsValidCaseNodeId(NodeId aNodeId)
 {
     if (IsOperationalNodeId(aNodeId))
@@ -192,6 +177,27 @@ char GetRequestTypeStringForLogging(RequestType requestType)
 
 } // namespace
 
+bool AccessControl::CheckRequestPrivilegeAgainstEntryPrivilege(Privilege requestPrivilege, Privilege entryPrivilege)
+{
+    switch (entryPrivilege)
+    {
+    case Privilege::kView:
+        return requestPrivilege == Privilege::kView;
+    case Privilege::kProxyView:
+        return requestPrivilege == Privilege::kProxyView || requestPrivilege == Privilege::kView;
+    case Privilege::kOperate:
+        return requestPrivilege == Privilege::kOperate || requestPrivilege == Privilege::kView;
+    case Privilege::kManage:
+        return requestPrivilege == Privilege::kManage || requestPrivilege == Privilege::kOperate ||
+            requestPrivilege == Privilege::kView;
+    case Privilege::kAdminister:
+        return requestPrivilege == Privilege::kAdminister || requestPrivilege == Privilege::kManage ||
+            requestPrivilege == Privilege::kOperate || requestPrivilege == Privilege::kView ||
+            requestPrivilege == Privilege::kProxyView;
+    }
+    return false;
+}
+
 Global<AccessControl::Entry::Delegate> AccessControl::Entry::mDefaultDelegate;
 Global<AccessControl::EntryIterator::Delegate> AccessControl::EntryIterator::mDefaultDelegate;
 
@@ -207,6 +213,15 @@ CHIP_ERROR AccessControl::Init(AccessControl::Delegate * delegate, DeviceTypeRes
     {
         mDelegate           = delegate;
         mDeviceTypeResolver = &deviceTypeResolver;
+
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+        // Without the index, checks fall back to reading the entries.
+        mIndex = Platform::New<AccessControlIndex>();
+        if (mIndex != nullptr)
+        {
+            AddEntryListener(*mIndex);
+        }
+#endif
     }
 
     return retval;
@@ -216,6 +231,14 @@ void AccessControl::Finish()
 {
     VerifyOrReturn(IsInitialized());
     ChipLogProgress(DataManagement, "AccessControl: finishing");
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+    if (mIndex != nullptr)
+    {
+        RemoveEntryListener(*mIndex);
+        Platform::Delete(mIndex);
+        mIndex = nullptr;
+    }
+#endif
     mDelegate->Finish();
     mDelegate = nullptr;
 }
@@ -398,6 +421,26 @@ CHIP_ERROR AccessControl::CheckACL(const SubjectDescriptor & subjectDescriptor,
         return CHIP_NO_ERROR;
     }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+    if (mIndex != nullptr)
+    {
+        CHIP_ERROR result = mIndex->Check(*this, *mDeviceTypeResolver, subjectDescriptor, requestPath, requestPrivilege);
+        if (result == CHIP_NO_ERROR)
+        {
+#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+            ChipLogProgress(DataManagement, "AccessControl: allowed");
+#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+            return result;
+        }
+        if (result == CHIP_ERROR_ACCESS_DENIED)
+        {
+            ChipLogProgress(DataManagement, "AccessControl: denied");
+            return result;
+        }
+        // The entries could not be compiled: check them one by one, which reports any error they hold.
+    }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX
+
     EntryIterator iterator;
     ReturnErrorOnFailure(Entries(iterator, &subjectDescriptor.fabricIndex));
 
@@ -512,6 +555,18 @@ CHIP_ERROR AccessControl::CheckACL(const SubjectDescriptor & subjectDescriptor,
     return CHIP_ERROR_ACCESS_DENIED;
 }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX && CONFIG_BUILD_FOR_HOST_UNIT_TEST
+CHIP_ERROR AccessControl::CheckWithoutIndexForTesting(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                                      Privilege requestPrivilege)
+{
+    AccessControlIndex * index = mIndex;
+    mIndex                     = nullptr;
+    CHIP_ERROR result          = Check(subjectDescriptor, requestPath, requestPrivilege);
+    mIndex                     = index;
+    return result;
+}
+#endif // CHIP_CONFIG_ACCESS_CONTROL_INDEX && CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
 #if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
 CHIP_ERROR AccessControl::CheckARL(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
                                    Privilege requestPrivilege)
@@ -700,6 +755,16 @@ exit:
     return false;
 }
 
+void AccessControl::InvalidateIndex(const FabricIndex * fabricIndex)
+{
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+    if (mIndex != nullptr)
+    {
+        mIndex->Invalidate((fabricIndex != nullptr) ? *fabricIndex : kUndefinedFabricIndex);
+    }
+#endif
+}
+
 void AccessControl::NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index,
                                        const Entry * entry, EntryListener::ChangeType changeType)
 {
@@ -38,6 +38,8 @@
 namespace chip {
 namespace Access {
 
+class AccessControlIndex;
+
 class AccessControl
 {
 public:
@@ -503,7 +505,9 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
-        return mDelegate->CreateEntry(index, entry, fabricIndex);
+        ReturnErrorOnFailure(mDelegate->CreateEntry(index, entry, fabricIndex));
+        InvalidateIndex(fabricIndex);
+        return CHIP_NO_ERROR;
     }
 
     /**
@@ -553,7 +557,9 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
-        return mDelegate->UpdateEntry(index, entry, fabricIndex);
+        ReturnErrorOnFailure(mDelegate->UpdateEntry(index, entry, fabricIndex));
+        InvalidateIndex(fabricIndex);
+        return CHIP_NO_ERROR;
     }
 
     /**
@@ -574,7 +580,9 @@ public:
     CHIP_ERROR DeleteEntry(size_t index, const FabricIndex * fabricIndex = nullptr)
     {
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
-        return mDelegate->DeleteEntry(index, fabricIndex);
+        ReturnErrorOnFailure(mDelegate->DeleteEntry(index, fabricIndex));
+        InvalidateIndex(fabricIndex);
+        return CHIP_NO_ERROR;
     }
 
     /**
@@ -662,15 +670,31 @@ public:
      */
     CHIP_ERROR Check(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege);
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX && CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    /**
+     * Check access like Check does, but by reading the entries one by one, without the index,
+     * for tests to compare the index against.
+     */
+    CHIP_ERROR CheckWithoutIndexForTesting(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                           Privilege requestPrivilege);
+#endif
+
 #if CHIP_ACCESS_CONTROL_DUMP_ENABLED
     CHIP_ERROR Dump(const Entry & entry);
 #endif
 
 private:
+    friend class AccessControlIndex;
+
+    static bool CheckRequestPrivilegeAgainstEntryPrivilege(Privilege requestPrivilege, Privilege entryPrivilege);
+
     bool IsInitialized() const { return (mDelegate != nullptr); }
 
     bool IsValid(const Entry & entry);
 
+    // Discards the compiled entries of the fabric (of all fabrics if null) after a change that listeners are not told of.
+    void InvalidateIndex(const FabricIndex * fabricIndex);
+
     void NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index, const Entry * entry,
                             EntryListener::ChangeType changeType);
 
@@ -694,6 +718,10 @@ private:
 
     EntryListener * mEntryListener = nullptr;
 
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+    AccessControlIndex * mIndex = nullptr;
+#endif
+
 #if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
     AccessRestrictionProvider * mAccessRestrictionProvider;
 #endif
@@ -0,0 +1,325 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "AccessControlIndex.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace chip {
+namespace Access {
+
+using Target = AccessControl::Entry::Target;
+
+namespace {
+
+constexpr size_t kBitsPerMatchWord = 32;
+
+bool SubjectLess(AuthMode authModeA, NodeId subjectA, AuthMode authModeB, NodeId subjectB)
+{
+    return (authModeA != authModeB) ? (authModeA < authModeB) : (subjectA < subjectB);
+}
+
+bool TargetLess(EndpointId endpointA, ClusterId clusterA, EndpointId endpointB, ClusterId clusterB)
+{
+    return (endpointA != endpointB) ? (endpointA < endpointB) : (clusterA < clusterB);
+}
+
+bool IsMatch(const uint32_t * matches, uint16_t entry)
+{
+    return (matches[entry / kBitsPerMatchWord] >> (entry % kBitsPerMatchWord)) & 1;
+}
+
+} // namespace
+
+void AccessControlIndex::Fabric::Clear()
+{
+    fabricIndex  = kUndefinedFabricIndex;
+    compiled     = false;
+    entryCount   = 0;
+    subjectCount = 0;
+    targetCount  = 0;
+    privileges.Free();
+    subjects.Free();
+    targets.Free();
+    for (auto & slot : subjectCache)
+    {
+        slot.valid = false;
+        slot.matches.Free();
+    }
+    nextSubjectCacheSlot = 0;
+}
+
+void AccessControlIndex::Invalidate(FabricIndex fabricIndex)
+{
+    for (auto & fabric : mFabrics)
+    {
+        if (fabricIndex == kUndefinedFabricIndex || fabric.fabricIndex == fabricIndex)
+        {
+            fabric.Clear();
+        }
+    }
+}
+
+CHIP_ERROR AccessControlIndex::Check(const AccessControl & accessControl, AccessControl::DeviceTypeResolver & deviceTypeResolver,
+                                     const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                     Privilege requestPrivilege)
+{
+    Fabric * fabric = nullptr;
+    ReturnErrorOnFailure(GetCompiledFabric(accessControl, subjectDescriptor.fabricIndex, fabric));
+
+    const uint32_t * matches = GetSubjectMatches(*fabric, subjectDescriptor);
+    VerifyOrReturnError(matches != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    // A target matches the request path if its endpoint and cluster are either equal or missing.
+    const EndpointId endpoints[] = { requestPath.endpoint, kInvalidEndpointId };
+    const ClusterId clusters[]   = { requestPath.cluster, kInvalidClusterId };
+
+    const CompiledTarget * targetsBegin = fabric->targets.Get();
+    const CompiledTarget * targetsEnd   = targetsBegin + fabric->targetCount;
+
+    for (EndpointId endpoint : endpoints)
+    {
+        for (ClusterId cluster : clusters)
+        {
+            const CompiledTarget * target =
+                std::lower_bound(targetsBegin, targetsEnd, 0, [&](const CompiledTarget & t, int) {
+                    return TargetLess(t.endpoint, t.cluster, endpoint, cluster);
+                });
+            for (; target != targetsEnd && target->endpoint == endpoint && target->cluster == cluster; ++target)
+            {
+                if (IsMatch(matches, target->entry) &&
+                    AccessControl::CheckRequestPrivilegeAgainstEntryPrivilege(requestPrivilege,
+                                                                              fabric->privileges[target->entry]) &&
+                    (!target->hasDeviceType ||
+                     deviceTypeResolver.IsDeviceTypeOnEndpoint(target->deviceType, requestPath.endpoint)))
+                {
+                    return CHIP_NO_ERROR;
+                }
+            }
+        }
+    }
+
+    return CHIP_ERROR_ACCESS_DENIED;
+}
+
+CHIP_ERROR AccessControlIndex::GetCompiledFabric(const AccessControl & accessControl, FabricIndex fabricIndex, Fabric *& fabric)
+{
+    fabric = nullptr;
+    for (auto & candidate : mFabrics)
+    {
+        if (candidate.fabricIndex == fabricIndex)
+        {
+            fabric = &candidate;
+            break;
+        }
+    }
+
+    if (fabric == nullptr)
+    {
+        // More fabrics are being checked than can be kept compiled: recycle one in turn.
+        fabric      = &mFabrics[mNextFabric];
+        mNextFabric = static_cast<uint8_t>((mNextFabric + 1) % kFabricCount);
+        fabric->Clear();
+        fabric->fabricIndex = fabricIndex;
+    }
+
+    if (!fabric->compiled)
+    {
+        CHIP_ERROR err = Compile(accessControl, *fabric);
+        if (err != CHIP_NO_ERROR)
+        {
+            fabric->Clear();
+            fabric = nullptr;
+            return err;
+        }
+        fabric->compiled = true;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AccessControlIndex::Compile(const AccessControl & accessControl, Fabric & fabric)
+{
+    // First pass: size the tables, and reject the same malformed entries as the default check algorithm.
+    size_t entryCount   = 0;
+    size_t subjectCount = 0;
+    size_t targetCount  = 0;
+    {
+        AccessControl::EntryIterator iterator;
+        AccessControl::Entry entry;
+        ReturnErrorOnFailure(accessControl.Entries(fabric.fabricIndex, iterator));
+        while (iterator.Next(entry) == CHIP_NO_ERROR)
+        {
+            AuthMode authMode = AuthMode::kNone;
+            ReturnErrorOnFailure(entry.GetAuthMode(authMode));
+            VerifyOrReturnError(authMode == AuthMode::kCase || authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+
+            size_t count = 0;
+            ReturnErrorOnFailure(entry.GetSubjectCount(count));
+            subjectCount += std::max<size_t>(count, 1);
+            ReturnErrorOnFailure(entry.GetTargetCount(count));
+            targetCount += std::max<size_t>(count, 1);
+            entryCount++;
+        }
+    }
+    VerifyOrReturnError(entryCount <= kMaxCompiledSize && subjectCount <= kMaxCompiledSize && targetCount <= kMaxCompiledSize,
+                        CHIP_ERROR_NO_MEMORY);
+
+    VerifyOrReturnError(fabric.privileges.Alloc(std::max<size_t>(entryCount, 1)), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(fabric.subjects.Alloc(std::max<size_t>(subjectCount, 1)), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(fabric.targets.Alloc(std::max<size_t>(targetCount, 1)), CHIP_ERROR_NO_MEMORY);
+
+    // Second pass: fill the tables.
+    uint16_t entryIndex = 0;
+    uint16_t subjects   = 0;
+    uint16_t targets    = 0;
+    {
+        AccessControl::EntryIterator iterator;
+        AccessControl::Entry entry;
+        ReturnErrorOnFailure(accessControl.Entries(fabric.fabricIndex, iterator));
+        while (entryIndex < entryCount && iterator.Next(entry) == CHIP_NO_ERROR)
+        {
+            AuthMode authMode = AuthMode::kNone;
+            ReturnErrorOnFailure(entry.GetAuthMode(authMode));
+            ReturnErrorOnFailure(entry.GetPrivilege(fabric.privileges[entryIndex]));
+
+            size_t count = 0;
+            ReturnErrorOnFailure(entry.GetSubjectCount(count));
+            VerifyOrReturnError(subjects + std::max<size_t>(count, 1) <= subjectCount, CHIP_ERROR_INCORRECT_STATE);
+            for (size_t i = 0; i < count; ++i)
+            {
+                NodeId subject = kUndefinedNodeId;
+                ReturnErrorOnFailure(entry.GetSubject(i, subject));
+                if (IsOperationalNodeId(subject) || IsCASEAuthTag(subject))
+                {
+                    VerifyOrReturnError(authMode == AuthMode::kCase, CHIP_ERROR_INCORRECT_STATE);
+                }
+                else
+                {
+                    // Operational PASE not supported for v1.0.
+                    VerifyOrReturnError(IsGroupId(subject) && authMode == AuthMode::kGroup, CHIP_ERROR_INCORRECT_STATE);
+                }
+                fabric.subjects[subjects++] = CompiledSubject{ subject, entryIndex, authMode };
+            }
+            if (count == 0)
+            {
+                fabric.subjects[subjects++] = CompiledSubject{ kUndefinedNodeId, entryIndex, authMode };
+            }
+
+            ReturnErrorOnFailure(entry.GetTargetCount(count));
+            VerifyOrReturnError(targets + std::max<size_t>(count, 1) <= targetCount, CHIP_ERROR_INCORRECT_STATE);
+            for (size_t i = 0; i < count; ++i)
+            {
+                Target target;
+                ReturnErrorOnFailure(entry.GetTarget(i, target));
+                CompiledTarget & compiled = fabric.targets[targets++];
+                compiled.cluster          = (target.flags & Target::kCluster) ? target.cluster : kInvalidClusterId;
+                compiled.deviceType       = target.deviceType;
+                compiled.endpoint         = (target.flags & Target::kEndpoint) ? target.endpoint : kInvalidEndpointId;
+                compiled.entry            = entryIndex;
+                compiled.hasDeviceType    = (target.flags & Target::kDeviceType) != 0;
+            }
+            if (count == 0)
+            {
+                fabric.targets[targets++] = CompiledTarget{ kInvalidClusterId, 0, kInvalidEndpointId, entryIndex, false };
+            }
+
+            entryIndex++;
+        }
+    }
+
+    fabric.entryCount   = entryIndex;
+    fabric.subjectCount = subjects;
+    fabric.targetCount  = targets;
+
+    std::sort(fabric.subjects.Get(), fabric.subjects.Get() + subjects, [](const CompiledSubject & a, const CompiledSubject & b) {
+        return SubjectLess(a.authMode, a.subject, b.authMode, b.subject);
+    });
+    std::sort(fabric.targets.Get(), fabric.targets.Get() + targets, [](const CompiledTarget & a, const CompiledTarget & b) {
+        return TargetLess(a.endpoint, a.cluster, b.endpoint, b.cluster);
+    });
+
+    return CHIP_NO_ERROR;
+}
+
+const uint32_t * AccessControlIndex::GetSubjectMatches(Fabric & fabric, const SubjectDescriptor & subjectDescriptor)
+{
+    for (auto & slot : fabric.subjectCache)
+    {
+        if (slot.valid && slot.authMode == subjectDescriptor.authMode && slot.subject == subjectDescriptor.subject &&
+            slot.cats.values == subjectDescriptor.cats.values)
+        {
+            return slot.matches.Get();
+        }
+    }
+
+    SubjectCacheSlot & slot     = fabric.subjectCache[fabric.nextSubjectCacheSlot];
+    fabric.nextSubjectCacheSlot = static_cast<uint8_t>((fabric.nextSubjectCacheSlot + 1) % kSubjectCacheSize);
+
+    const size_t wordCount = (fabric.entryCount + kBitsPerMatchWord - 1) / kBitsPerMatchWord;
+    slot.valid             = false;
+    VerifyOrReturnValue(slot.matches.Calloc(std::max<size_t>(wordCount, 1)), nullptr);
+
+    const AuthMode authMode = subjectDescriptor.authMode;
+    uint32_t * matches      = slot.matches.Get();
+
+    // Entries without subjects.
+    MarkSubjectMatches(fabric, authMode, kUndefinedNodeId, kUndefinedNodeId, matches);
+
+    // Entries naming the node or group itself.
+    if (subjectDescriptor.subject != kUndefinedNodeId && !IsCASEAuthTag(subjectDescriptor.subject))
+    {
+        MarkSubjectMatches(fabric, authMode, subjectDescriptor.subject, subjectDescriptor.subject, matches);
+    }
+
+    // Entries naming one of the node's CATs, at the same or a lower (non-zero) version.
+    if (authMode == AuthMode::kCase)
+    {
+        for (CASEAuthTag cat : subjectDescriptor.cats.values)
+        {
+            if (cat != kUndefinedCAT && GetCASEAuthTagVersion(cat) > 0)
+            {
+                const CASEAuthTag lowestVersion = (cat & static_cast<CASEAuthTag>(kTagIdentifierMask)) | 1;
+                MarkSubjectMatches(fabric, authMode, NodeIdFromCASEAuthTag(lowestVersion), NodeIdFromCASEAuthTag(cat), matches);
+            }
+        }
+    }
+
+    slot.valid    = true;
+    slot.authMode = authMode;
+    slot.subject  = subjectDescriptor.subject;
+    slot.cats     = subjectDescriptor.cats;
+    return matches;
+}
+
+void AccessControlIndex::MarkSubjectMatches(const Fabric & fabric, AuthMode authMode, NodeId first, NodeId last,
+                                            uint32_t * matches)
+{
+    const CompiledSubject * end     = fabric.subjects.Get() + fabric.subjectCount;
+    const CompiledSubject * subject = std::lower_bound(fabric.subjects.Get(), end, 0, [&](const CompiledSubject & s, int) {
+        return SubjectLess(s.authMode, s.subject, authMode, first);
+    });
+    for (; subject != end && subject->authMode == authMode && subject->subject <= last; ++subject)
+    {
+        matches[subject->entry / kBitsPerMatchWord] |= static_cast<uint32_t>(1) << (subject->entry % kBitsPerMatchWord);
+    }
+}
+
+} // namespace Access
+} // namespace chip
@@ -0,0 +1,139 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include "AccessControl.h"
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/ScopedBuffer.h>
+
+namespace chip {
+namespace Access {
+
+/**
+ * Compiled form of the access control entries, used by AccessControl::Check
+ * when CHIP_CONFIG_ACCESS_CONTROL_INDEX is enabled.
+ *
+ * The entries of a fabric are compiled, the first time they are checked after
+ * a change, into:
+ *
+ *   - a table of subjects sorted by (auth mode, subject), where CATs sort by
+ *     identifier then version, and entries without subjects are keyed by
+ *     kUndefinedNodeId;
+ *   - a table of targets sorted by (endpoint, cluster), where a missing
+ *     endpoint or cluster is keyed by kInvalidEndpointId or kInvalidClusterId,
+ *     and entries without targets match both.
+ *
+ * The entries matching a subject descriptor are kept as a bit set in a small
+ * per-fabric cache, so the many checks made for one read or subscribe request
+ * only look up the targets of the request path.
+ *
+ * Changes made through AccessControl invalidate the affected fabric, either
+ * through the EntryListener interface or by AccessControl calling Invalidate().
+ */
+class AccessControlIndex : public AccessControl::EntryListener
+{
+public:
+    AccessControlIndex() = default;
+
+    AccessControlIndex(const AccessControlIndex &)             = delete;
+    AccessControlIndex & operator=(const AccessControlIndex &) = delete;
+
+    /**
+     * Check the entries of the subject's fabric, in the same way as the default check algorithm
+     * of AccessControl (so neither the delegate check nor implicit PASE access is applied).
+     *
+     * @retval #CHIP_NO_ERROR if allowed.
+     * @retval #CHIP_ERROR_ACCESS_DENIED if denied.
+     * @retval other errors if the entries could not be compiled, in which case the caller should
+     *         check the entries directly.
+     */
+    CHIP_ERROR Check(const AccessControl & accessControl, AccessControl::DeviceTypeResolver & deviceTypeResolver,
+                     const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege);
+
+    /**
+     * Discard what was compiled for a fabric, or for all fabrics if the fabric index is undefined.
+     */
+    void Invalidate(FabricIndex fabricIndex);
+
+    void OnEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index,
+                        const AccessControl::Entry * entry, ChangeType changeType) override
+    {
+        Invalidate(fabric);
+    }
+
+private:
+    static constexpr size_t kFabricCount       = CHIP_CONFIG_MAX_FABRICS;
+    static constexpr size_t kSubjectCacheSize  = CHIP_CONFIG_ACCESS_CONTROL_INDEX_SUBJECT_CACHE_SIZE;
+    static constexpr uint16_t kMaxCompiledSize = UINT16_MAX;
+
+    static_assert(kSubjectCacheSize > 0, "The access control index needs a subject cache");
+
+    struct CompiledSubject
+    {
+        NodeId subject; // kUndefinedNodeId if the entry has no subjects
+        uint16_t entry;
+        AuthMode authMode;
+    };
+
+    struct CompiledTarget
+    {
+        ClusterId cluster; // kInvalidClusterId if any cluster matches
+        DeviceTypeId deviceType;
+        EndpointId endpoint; // kInvalidEndpointId if any endpoint matches
+        uint16_t entry;
+        bool hasDeviceType;
+    };
+
+    struct SubjectCacheSlot
+    {
+        bool valid = false;
+        AuthMode authMode;
+        NodeId subject;
+        CATValues cats;
+        Platform::ScopedMemoryBuffer<uint32_t> matches; // Bit set of the entries matching the subject
+    };
+
+    struct Fabric
+    {
+        void Clear();
+
+        FabricIndex fabricIndex = kUndefinedFabricIndex;
+        bool compiled           = false;
+        uint16_t entryCount     = 0;
+        uint16_t subjectCount   = 0;
+        uint16_t targetCount    = 0;
+        Platform::ScopedMemoryBuffer<Privilege> privileges;
+        Platform::ScopedMemoryBuffer<CompiledSubject> subjects;
+        Platform::ScopedMemoryBuffer<CompiledTarget> targets;
+        SubjectCacheSlot subjectCache[kSubjectCacheSize];
+        uint8_t nextSubjectCacheSlot = 0;
+    };
+
+    CHIP_ERROR GetCompiledFabric(const AccessControl & accessControl, FabricIndex fabricIndex, Fabric *& fabric);
+    static CHIP_ERROR Compile(const AccessControl & accessControl, Fabric & fabric);
+    static const uint32_t * GetSubjectMatches(Fabric & fabric, const SubjectDescriptor & subjectDescriptor);
+    static void MarkSubjectMatches(const Fabric & fabric, AuthMode authMode, NodeId first, NodeId last, uint32_t * matches);
+
+    Fabric mFabrics[kFabricCount];
+    uint8_t mNextFabric = 0;
+};
+
+} // namespace Access
+} // namespace chip
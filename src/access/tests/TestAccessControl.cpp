@@ -17,12 +17,14 @@
  */
 
 #include "access/AccessControl.h"
+#include "access/AccessControlIndex.h"
 #include "access/examples/ExampleAccessControlDelegate.h"
 
 #include <pw_unit_test/framework.h>
 
 #include <lib/core/CHIPCore.h>
 #include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
 
 namespace chip {
 namespace Access {
@@ -1084,6 +1086,7 @@ public: // protected
     void SetUp() override { ASSERT_EQ(ClearAccessControl(accessControl), CHIP_NO_ERROR); }
     static void SetUpTestSuite()
     {
+        ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR);
         AccessControl::Delegate * delegate = Examples::GetAccessControlDelegate();
         SetAccessControl(accessControl);
         VerifyOrDie(GetAccessControl().Init(delegate, testDeviceTypeResolver) == CHIP_NO_ERROR);
@@ -1092,6 +1095,7 @@ public: // protected
     {
         GetAccessControl().Finish();
         ResetAccessControlToDefault();
+        chip::Platform::MemoryShutdown();
     }
 };
 
@@ -1760,6 +1764,140 @@ TEST_F(TestAccessControl, TestCheck)
     }
 }
 
+TEST_F(TestAccessControl, TestCheckIndex)
+{
+    AccessControlIndex index;
+    accessControl.AddEntryListener(index);
+
+    // Entries created without a subject descriptor aren't notified to listeners.
+    LoadAccessControl(accessControl, entryData1, entryData1Count);
+    index.Invalidate(kUndefinedFabricIndex);
+
+    // The first pass compiles the entries, the second one hits the subject cache.
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (const auto & checkData : checkData1)
+        {
+            // Implicit PASE access is granted by AccessControl, not by the entries.
+            if (checkData.subjectDescriptor.authMode == AuthMode::kPase)
+            {
+                continue;
+            }
+            CHIP_ERROR expectedResult = checkData.allow ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+            EXPECT_EQ(index.Check(accessControl, testDeviceTypeResolver, checkData.subjectDescriptor, checkData.requestPath,
+                                  checkData.privilege),
+                      expectedResult);
+        }
+    }
+
+    // Removing the entries of fabric 1 is notified, and only denies checks on fabric 1.
+    EXPECT_EQ(accessControl.DeleteAllEntriesForFabric(1), CHIP_NO_ERROR);
+    for (const auto & checkData : checkData1)
+    {
+        if (checkData.subjectDescriptor.authMode == AuthMode::kPase)
+        {
+            continue;
+        }
+        bool allow                = checkData.allow && checkData.subjectDescriptor.fabricIndex != 1;
+        CHIP_ERROR expectedResult = allow ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+        EXPECT_EQ(index.Check(accessControl, testDeviceTypeResolver, checkData.subjectDescriptor, checkData.requestPath,
+                              checkData.privilege),
+                  expectedResult);
+    }
+
+    accessControl.RemoveEntryListener(index);
+}
+
+TEST_F(TestAccessControl, TestCheckIndexMatchesEntries)
+{
+    // Operational node IDs first, so descriptors can pick from them only.
+    constexpr NodeId caseSubjects[]  = { kOperationalNodeId1, kOperationalNodeId2, kCASEAuthTagAsNodeId0, kCASEAuthTagAsNodeId1,
+                                         kCASEAuthTagAsNodeId2 };
+    constexpr NodeId groupSubjects[] = { kGroup2, kGroup4 };
+    constexpr EndpointId endpoints[] = { 1, 2 };
+    constexpr ClusterId clusters[]   = { kOnOffCluster, kLevelControlCluster };
+    constexpr int targetFlags[]      = { Target::kCluster, Target::kEndpoint, Target::kCluster | Target::kEndpoint,
+                                         Target::kDeviceType, Target::kCluster | Target::kDeviceType };
+    constexpr CATValues cats[]       = { kUndefinedCATs,
+                                         { { kCASEAuthTag0, kUndefinedCAT, kUndefinedCAT } },
+                                         { { kCASEAuthTag1, kCASEAuthTag3, kUndefinedCAT } },
+                                         { { kCASEAuthTag4, kUndefinedCAT, kUndefinedCAT } } };
+
+    uint32_t seed = 0x5eed;
+    auto random   = [&seed](size_t bound) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return static_cast<size_t>(seed % bound);
+    };
+
+    AccessControlIndex index;
+    for (int round = 0; round < 100; ++round)
+    {
+        ASSERT_EQ(ClearAccessControl(accessControl), CHIP_NO_ERROR);
+        for (FabricIndex fabricIndex = 1; fabricIndex <= 2; ++fabricIndex)
+        {
+            for (size_t count = random(5); count > 0; --count)
+            {
+                Entry entry;
+                ASSERT_EQ(accessControl.PrepareEntry(entry), CHIP_NO_ERROR);
+                bool group          = random(4) == 0;
+                Privilege privilege = privileges[random(group ? ArraySize(privileges) - 1 : ArraySize(privileges))];
+                EXPECT_EQ(entry.SetAuthMode(group ? AuthMode::kGroup : AuthMode::kCase), CHIP_NO_ERROR);
+                EXPECT_EQ(entry.SetFabricIndex(fabricIndex), CHIP_NO_ERROR);
+                EXPECT_EQ(entry.SetPrivilege(privilege), CHIP_NO_ERROR);
+                for (size_t i = random(3); i > 0; --i)
+                {
+                    NodeId subject = group ? groupSubjects[random(ArraySize(groupSubjects))]
+                                           : caseSubjects[random(ArraySize(caseSubjects))];
+                    EXPECT_EQ(entry.AddSubject(nullptr, subject), CHIP_NO_ERROR);
+                }
+                for (size_t i = random(3); i > 0; --i)
+                {
+                    Target target = { .flags      = targetFlags[random(ArraySize(targetFlags))],
+                                      .cluster    = clusters[random(ArraySize(clusters))],
+                                      .endpoint   = endpoints[random(ArraySize(endpoints))],
+                                      .deviceType = validDeviceTypes[0] };
+                    EXPECT_EQ(entry.AddTarget(nullptr, target), CHIP_NO_ERROR);
+                }
+                EXPECT_EQ(accessControl.CreateEntry(nullptr, entry), CHIP_NO_ERROR);
+            }
+        }
+        index.Invalidate(kUndefinedFabricIndex);
+
+        for (int check = 0; check < 50; ++check)
+        {
+            SubjectDescriptor subjectDescriptor;
+            subjectDescriptor.fabricIndex = static_cast<FabricIndex>(1 + random(2));
+            if (random(4) == 0)
+            {
+                subjectDescriptor.authMode = AuthMode::kGroup;
+                subjectDescriptor.subject  = groupSubjects[random(ArraySize(groupSubjects))];
+            }
+            else
+            {
+                subjectDescriptor.authMode = AuthMode::kCase;
+                subjectDescriptor.subject  = caseSubjects[random(2)];
+                subjectDescriptor.cats     = cats[random(ArraySize(cats))];
+            }
+            RequestPath requestPath    = { .cluster  = clusters[random(ArraySize(clusters))],
+                                           .endpoint = endpoints[random(ArraySize(endpoints))] };
+            Privilege requestPrivilege = privileges[random(ArraySize(privileges))];
+#if CHIP_CONFIG_USE_ACCESS_RESTRICTIONS
+            requestPath.requestType = Access::RequestType::kAttributeReadRequest;
+#endif
+            // The reference result reads the entries one by one, even when AccessControl has an index of its own.
+#if CHIP_CONFIG_ACCESS_CONTROL_INDEX
+            CHIP_ERROR expectedResult = accessControl.CheckWithoutIndexForTesting(subjectDescriptor, requestPath, requestPrivilege);
+#else
+            CHIP_ERROR expectedResult = accessControl.Check(subjectDescriptor, requestPath, requestPrivilege);
+#endif
+            EXPECT_EQ(index.Check(accessControl, testDeviceTypeResolver, subjectDescriptor, requestPath, requestPrivilege),
+                      expectedResult);
+        }
+    }
+}
+
 TEST_F(TestAccessControl, TestCreateReadEntry)
 {
     for (size_t i = 0; i < entryData1Count; ++i)
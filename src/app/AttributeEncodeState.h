@@ -21,6 +21,8 @@
 namespace chip {
 namespace app {
 
+class AttributeListItemCarry;
+
 /// Maintains the internal state of list encoding
 ///
 /// List encoding is generally assumed incremental and chunkable (i.e.
@@ -31,6 +33,10 @@ namespace app {
 ///   - CurrentEncodingListIndex representing the list index that is next
 ///     to be encoded in the output. kInvalidListIndex means that a new list
 ///     encoding has been started.
+///
+/// It may also point to an AttributeListItemCarry, which lets list encoding
+/// carry the item that did not fit in a chunk to the next chunk, rather than
+/// encoding it again. Without one, that item is encoded again.
 class AttributeEncodeState
 {
 public:
@@ -50,11 +56,15 @@ public:
         {
             mCurrentEncodingListIndex = kInvalidListIndex;
             mAllowPartialData         = false;
+            mLargestListItemLength    = 0;
+            mpListItemCarry           = nullptr;
         }
     }
 
     bool AllowPartialData() const { return mAllowPartialData; }
     ListIndex CurrentEncodingListIndex() const { return mCurrentEncodingListIndex; }
+    uint32_t LargestListItemLength() const { return mLargestListItemLength; }
+    AttributeListItemCarry * ListItemCarry() const { return mpListItemCarry; }
 
     AttributeEncodeState & SetAllowPartialData(bool allow)
     {
@@ -68,10 +78,24 @@ public:
         return *this;
     }
 
+    AttributeEncodeState & NoteListItemLength(uint32_t length)
+    {
+        mLargestListItemLength = (length > mLargestListItemLength) ? length : mLargestListItemLength;
+        return *this;
+    }
+
+    AttributeEncodeState & SetListItemCarry(AttributeListItemCarry * carry)
+    {
+        mpListItemCarry = carry;
+        return *this;
+    }
+
+    /// Resets the list encoding progress. The list item carry, if any, is kept.
     void Reset()
     {
         mCurrentEncodingListIndex = kInvalidListIndex;
         mAllowPartialData         = false;
+        mLargestListItemLength    = 0;
     }
 
 private:
@@ -97,6 +121,17 @@ private:
      * TODO: There might be a better name for this variable.
      */
     bool mAllowPartialData = false;
+
+    /**
+     * The length of the largest list item encoded so far, including its AttributeReportIB when items are appended
+     * one per report. List items are staged in mpListItemCarry once the space left in the chunk gets close to it.
+     */
+    uint32_t mLargestListItemLength = 0;
+
+    /**
+     * Where list items are staged and carried between chunks, if anywhere. Not owned.
+     */
+    AttributeListItemCarry * mpListItemCarry = nullptr;
 };
 
 } // namespace app
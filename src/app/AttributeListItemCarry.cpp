@@ -0,0 +1,101 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AttributeListItemCarry.h>
+
+#include <lib/core/TLVReader.h>
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR AttributeListItemCarry::EnsureBuffer()
+{
+    if (mBuffer.IsNull())
+    {
+        // A list item has to fit in a report packet, so a buffer of the largest packet size can stage any item that can
+        // be reported.
+        mBuffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+        VerifyOrReturnError(!mBuffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AttributeListItemCarry::FinishStaging(uint32_t aLength)
+{
+    TLV::TLVReader reader;
+    reader.Init(mBuffer->Start(), aLength);
+    ReturnErrorOnFailure(reader.Next());
+    VerifyOrReturnError(reader.GetTag() == TLV::AnonymousTag(), CHIP_ERROR_INVALID_TLV_TAG);
+
+    mType = reader.GetType();
+    if (TLV::TLVTypeIsContainer(mType))
+    {
+        // The members, including the end of the container, run to the end of the item.
+        mpValue      = reader.GetReadPoint();
+        mValueLength = static_cast<uint32_t>(mBuffer->Start() + aLength - mpValue);
+        VerifyOrReturnError(mValueLength > 0 &&
+                                mpValue[mValueLength - 1] == static_cast<uint8_t>(TLV::TLVElementType::EndOfContainer),
+                            CHIP_ERROR_INVALID_TLV_ELEMENT);
+    }
+
+    mLength = aLength;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AttributeListItemCarry::CopyTo(TLV::TLVWriter & aWriter, TLV::Tag aTag) const
+{
+    VerifyOrReturnError(mLength > 0, CHIP_ERROR_INCORRECT_STATE);
+
+    if (mpValue != nullptr)
+    {
+        return aWriter.PutPreEncodedContainer(aTag, mType, mpValue, mValueLength);
+    }
+
+    TLV::TLVReader reader;
+    reader.Init(mBuffer->Start(), mLength);
+    ReturnErrorOnFailure(reader.Next());
+    return aWriter.CopyElement(aTag, reader);
+}
+
+void AttributeListItemCarry::Hold(const ConcreteAttributePath & aPath, DataVersion aDataVersion, ListIndex aListIndex)
+{
+    VerifyOrReturn(mLength > 0);
+
+    mHolding     = true;
+    mPath        = aPath;
+    mDataVersion = aDataVersion;
+    mListIndex   = aListIndex;
+}
+
+void AttributeListItemCarry::Clear()
+{
+    mLength      = 0;
+    mType        = TLV::kTLVType_NotSpecified;
+    mpValue      = nullptr;
+    mValueLength = 0;
+    mHolding     = false;
+    mListIndex   = kInvalidListIndex;
+}
+
+void AttributeListItemCarry::Release()
+{
+    Clear();
+    mBuffer = nullptr;
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,116 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/TLVTags.h>
+#include <lib/core/TLVTypes.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemPacketBuffer.h>
+
+namespace chip {
+namespace app {
+
+/// Holds one encoded list item, so that an item that does not fit in a report chunk
+/// is carried to the next chunk instead of being encoded again.
+///
+/// When list chunking gets close to the end of a report packet, AttributeValueEncoder
+/// encodes the next list items here first (`Stage`) and copies them into the report
+/// (`CopyTo`). An item that does not fit is kept (`Hold`), identified by its attribute
+/// path, data version and list index, and the encoder copies it into the next chunk
+/// when it gets to that list index again.
+///
+/// Items are encoded with an anonymous tag and get the tag of their report when copied:
+/// the same encoding works for the initial list and for the items appended to it.
+///
+/// The encoding is held in a packet buffer, allocated on the first `Stage` and released
+/// with `Release()` or when the object is destroyed.
+class AttributeListItemCarry
+{
+public:
+    AttributeListItemCarry() = default;
+
+    AttributeListItemCarry(const AttributeListItemCarry &)             = delete;
+    AttributeListItemCarry & operator=(const AttributeListItemCarry &) = delete;
+
+    /// Encodes an item, replacing what was staged or held before.
+    ///
+    /// aEncodeItem(TLV::TLVWriter &) must encode exactly one element, with an anonymous tag.
+    ///
+    /// @retval CHIP_ERROR_NO_MEMORY if the buffer cannot be allocated.
+    /// @retval the error returned by aEncodeItem, if any (e.g. when the item does not fit in a packet).
+    template <typename EncodeFunction>
+    CHIP_ERROR Stage(EncodeFunction && aEncodeItem)
+    {
+        Clear();
+        ReturnErrorOnFailure(EnsureBuffer());
+
+        TLV::TLVWriter writer;
+        writer.Init(mBuffer->Start(), mBuffer->AvailableDataLength());
+        ReturnErrorOnFailure(aEncodeItem(writer));
+        return FinishStaging(writer.GetLengthWritten());
+    }
+
+    /// Writes the staged item to aWriter, with the given tag.
+    ///
+    /// @retval CHIP_ERROR_INCORRECT_STATE if no item is staged.
+    /// @retval CHIP_ERROR_BUFFER_TOO_SMALL or CHIP_ERROR_NO_MEMORY if aWriter does not have enough space left, in which case
+    ///         aWriter may hold part of the item and has to be rolled back.
+    CHIP_ERROR CopyTo(TLV::TLVWriter & aWriter, TLV::Tag aTag) const;
+
+    /// Keeps the staged item for the given list index of the given attribute, read at the given data version.
+    void Hold(const ConcreteAttributePath & aPath, DataVersion aDataVersion, ListIndex aListIndex);
+
+    /// Whether the held item is the given list index of the given attribute, read at the given data version.
+    bool Holds(const ConcreteAttributePath & aPath, DataVersion aDataVersion, ListIndex aListIndex) const
+    {
+        return mHolding && (mListIndex == aListIndex) && (mDataVersion == aDataVersion) && (mPath == aPath);
+    }
+
+    bool IsHolding() const { return mHolding; }
+
+    /// Length of the staged item, with its anonymous tag.
+    uint32_t GetLength() const { return mLength; }
+
+    /// Drops the staged or held item, keeping the buffer.
+    void Clear();
+
+    /// Drops the staged or held item and frees the buffer.
+    void Release();
+
+private:
+    CHIP_ERROR EnsureBuffer();
+
+    // Locates the value of the item, so that copying a container does not have to parse it again.
+    CHIP_ERROR FinishStaging(uint32_t aLength);
+
+    System::PacketBufferHandle mBuffer;
+    uint32_t mLength        = 0;
+    TLV::TLVType mType      = TLV::kTLVType_NotSpecified;
+    const uint8_t * mpValue = nullptr;
+    uint32_t mValueLength   = 0;
+    bool mHolding           = false;
+    ConcreteAttributePath mPath;
+    DataVersion mDataVersion = 0;
+    ListIndex mListIndex     = kInvalidListIndex;
+};
+
+} // namespace app
+} // namespace chip
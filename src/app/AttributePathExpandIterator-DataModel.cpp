@@ -61,7 +61,7 @@ std::optional<AttributeId> AttributePathExpandIteratorDataModel::NextAttributeId
     {
         if (mpAttributePath->mValue.HasWildcardAttributeId())
         {
-            AttributeEntry entry = mDataModelProvider->FirstAttribute(mOutputPath);
+            AttributeEntry entry = mDataModelProvider->FirstAttributeWithCursor(mOutputPath, mCursor);
             return entry.IsValid()                                         //
                 ? entry.path.mAttributeId                                  //
                 : Clusters::Globals::Attributes::GeneratedCommandList::Id; //
@@ -99,7 +99,7 @@ std::optional<AttributeId> AttributePathExpandIteratorDataModel::NextAttributeId
         return std::nullopt;
     }
 
-    AttributeEntry entry = mDataModelProvider->NextAttribute(mOutputPath);
+    AttributeEntry entry = mDataModelProvider->NextAttributeWithCursor(mOutputPath, mCursor);
     if (entry.IsValid())
     {
         return entry.path.mAttributeId;
@@ -117,7 +117,7 @@ std::optional<ClusterId> AttributePathExpandIteratorDataModel::NextClusterId()
     {
         if (mpAttributePath->mValue.HasWildcardClusterId())
         {
-            ClusterEntry entry = mDataModelProvider->FirstCluster(mOutputPath.mEndpointId);
+            ClusterEntry entry = mDataModelProvider->FirstClusterWithCursor(mOutputPath.mEndpointId, mCursor);
             return entry.IsValid() ? std::make_optional(entry.path.mClusterId) : std::nullopt;
         }
 
@@ -133,7 +133,7 @@ std::optional<ClusterId> AttributePathExpandIteratorDataModel::NextClusterId()
 
     VerifyOrReturnValue(mpAttributePath->mValue.HasWildcardClusterId(), std::nullopt);
 
-    ClusterEntry entry = mDataModelProvider->NextCluster(mOutputPath);
+    ClusterEntry entry = mDataModelProvider->NextClusterWithCursor(mOutputPath, mCursor);
     return entry.IsValid() ? std::make_optional(entry.path.mClusterId) : std::nullopt;
 }
 
@@ -143,7 +143,7 @@ std::optional<ClusterId> AttributePathExpandIteratorDataModel::NextEndpointId()
     {
         if (mpAttributePath->mValue.HasWildcardEndpointId())
         {
-            EndpointId id = mDataModelProvider->FirstEndpoint();
+            EndpointId id = mDataModelProvider->FirstEndpointWithCursor(mCursor);
             return (id != kInvalidEndpointId) ? std::make_optional(id) : std::nullopt;
         }
 
@@ -152,7 +152,7 @@ std::optional<ClusterId> AttributePathExpandIteratorDataModel::NextEndpointId()
 
     VerifyOrReturnValue(mpAttributePath->mValue.HasWildcardEndpointId(), std::nullopt);
 
-    EndpointId id = mDataModelProvider->NextEndpoint(mOutputPath.mEndpointId);
+    EndpointId id = mDataModelProvider->NextEndpointWithCursor(mOutputPath.mEndpointId, mCursor);
     return (id != kInvalidEndpointId) ? std::make_optional(id) : std::nullopt;
 }
 
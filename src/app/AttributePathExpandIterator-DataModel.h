@@ -92,6 +92,10 @@ private:
     SingleLinkedListNode<AttributePathParams> * mpAttributePath;
     ConcreteAttributePath mOutputPath;
 
+    /// Position of mOutputPath in the data model, so that wildcard expansion continues
+    /// from it without the provider searching for mOutputPath again
+    DataModel::MetadataCursor mCursor;
+
     /// Move to the next endpoint/cluster/attribute triplet that is valid given
     /// the current mOutputPath and mpAttributePath
     ///
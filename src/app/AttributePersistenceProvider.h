@@ -70,6 +70,23 @@ public:
      */
     virtual CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                                  MutableByteSpan & aValue) = 0;
+
+    /**
+     * Start a batch of writes: the values written until the matching
+     * EndWriteBatch may be held back, and stored together by it.  Batches
+     * may nest; the values are stored when the outermost batch ends.
+     *
+     * The default implementation stores each value as it is written.
+     */
+    virtual void StartWriteBatch() {}
+
+    /**
+     * End a batch of writes started by StartWriteBatch, storing the values
+     * held back if it is the outermost batch.
+     *
+     * @return the first error storing the values held back.
+     */
+    virtual CHIP_ERROR EndWriteBatch() { return CHIP_NO_ERROR; }
 };
 
 /**
@@ -61,16 +61,32 @@ public:
     template <typename T, std::enable_if_t<!DataModel::IsFabricScoped<T>::value, bool> = true, typename... Ts>
     CHIP_ERROR EncodeValue(AttributeReportIBs::Builder & aAttributeReportIBs, TLV::Tag tag, T && item, Ts &&... aArgs)
     {
-        return DataModel::Encode(*(aAttributeReportIBs.GetAttributeReport().GetAttributeData().GetWriter()), tag, item,
-                                 std::forward<Ts>(aArgs)...);
+        return EncodeValue(*(aAttributeReportIBs.GetAttributeReport().GetAttributeData().GetWriter()), tag,
+                           std::forward<T>(item), std::forward<Ts>(aArgs)...);
     }
 
     template <typename T, std::enable_if_t<DataModel::IsFabricScoped<T>::value, bool> = true, typename... Ts>
     CHIP_ERROR EncodeValue(AttributeReportIBs::Builder & aAttributeReportIBs, TLV::Tag tag, FabricIndex accessingFabricIndex,
                            T && item, Ts &&... aArgs)
     {
-        return DataModel::EncodeForRead(*(aAttributeReportIBs.GetAttributeReport().GetAttributeData().GetWriter()), tag,
-                                        accessingFabricIndex, item, std::forward<Ts>(aArgs)...);
+        return EncodeValue(*(aAttributeReportIBs.GetAttributeReport().GetAttributeData().GetWriter()), tag, accessingFabricIndex,
+                           std::forward<T>(item), std::forward<Ts>(aArgs)...);
+    }
+
+    /**
+     * Same as EncodeValue above, for a value encoded with the given writer rather than the writer of the report, e.g. a list
+     * item staged out of the report.
+     */
+    template <typename T, std::enable_if_t<!DataModel::IsFabricScoped<T>::value, bool> = true, typename... Ts>
+    CHIP_ERROR EncodeValue(TLV::TLVWriter & aWriter, TLV::Tag tag, T && item, Ts &&... aArgs)
+    {
+        return DataModel::Encode(aWriter, tag, item, std::forward<Ts>(aArgs)...);
+    }
+
+    template <typename T, std::enable_if_t<DataModel::IsFabricScoped<T>::value, bool> = true, typename... Ts>
+    CHIP_ERROR EncodeValue(TLV::TLVWriter & aWriter, TLV::Tag tag, FabricIndex accessingFabricIndex, T && item, Ts &&... aArgs)
+    {
+        return DataModel::EncodeForRead(aWriter, tag, accessingFabricIndex, item, std::forward<Ts>(aArgs)...);
     }
 };
 
@@ -26,6 +26,11 @@ constexpr uint32_t kEndOfListByteCount = 1;
 constexpr uint32_t kEndOfAttributeReportIBByteCount = 2;
 constexpr TLV::TLVType kAttributeDataIBType         = TLV::kTLVType_Structure;
 
+bool IsOutOfWriterSpaceError(CHIP_ERROR err)
+{
+    return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
+}
+
 } // anonymous namespace
 
 CHIP_ERROR AttributeValueEncoder::EnsureListStarted()
@@ -109,5 +114,50 @@ void AttributeValueEncoder::EnsureListEnded()
     }
 }
 
+bool AttributeValueEncoder::ShouldStageListItem() const
+{
+    VerifyOrReturnValue(mEncodeState.ListItemCarry() != nullptr, false);
+
+    // Items are not all the same length: twice the largest one leaves room for one a bit larger than those before it to
+    // be staged rather than encoded in part.
+    return mAttributeReportIBsBuilder.GetWriter()->GetRemainingFreeLength() < 2 * mEncodeState.LargestListItemLength();
+}
+
+CHIP_ERROR AttributeValueEncoder::CopyStagedListItem()
+{
+    AttributeListItemCarry & carry = *mEncodeState.ListItemCarry();
+
+    // The writer of the attribute data is only set up once the attribute report is prepared.
+    CHIP_ERROR err;
+    if (mEncodingInitialList)
+    {
+        err = carry.CopyTo(*mAttributeReportIBsBuilder.GetAttributeReport().GetAttributeData().GetWriter(), TLV::AnonymousTag());
+    }
+    else
+    {
+        AttributeReportBuilder builder;
+        err = builder.PrepareAttribute(mAttributeReportIBsBuilder, mPath, mDataVersion);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = carry.CopyTo(*mAttributeReportIBsBuilder.GetAttributeReport().GetAttributeData().GetWriter(),
+                               TLV::ContextTag(AttributeDataIB::Tag::kData));
+        }
+        if (err == CHIP_NO_ERROR)
+        {
+            err = builder.FinishAttribute(mAttributeReportIBsBuilder);
+        }
+    }
+
+    if (IsOutOfWriterSpaceError(err))
+    {
+        carry.Hold(mPath, mDataVersion, mCurrentEncodingListIndex);
+    }
+    else
+    {
+        carry.Clear();
+    }
+    return err;
+}
+
 } // namespace app
 } // namespace chip
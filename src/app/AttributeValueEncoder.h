@@ -18,6 +18,7 @@
 
 #include <access/SubjectDescriptor.h>
 #include <app/AttributeEncodeState.h>
+#include <app/AttributeListItemCarry.h>
 #include <app/AttributeReportBuilder.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/MessageDef/AttributeReportIBs.h>
@@ -178,9 +179,26 @@ private:
 
         TLV::TLVWriter backup;
         mAttributeReportIBsBuilder.Checkpoint(backup);
+        const uint32_t lengthBefore = mAttributeReportIBsBuilder.GetWriter()->GetLengthWritten();
+
+        // An item carried from the previous chunk is copied as it was encoded then. Close to the end of the chunk, items are
+        // staged out of the report first, so that one that does not fit does not have to be encoded again.
+        AttributeListItemCarry * carry = mEncodeState.ListItemCarry();
+        bool staged                    = (carry != nullptr) && carry->Holds(mPath, mDataVersion, mCurrentEncodingListIndex);
+        if (!staged && ShouldStageListItem())
+        {
+            staged = (carry->Stage([&](TLV::TLVWriter & writer) {
+                         AttributeReportBuilder builder;
+                         return builder.EncodeValue(writer, TLV::AnonymousTag(), aArgs...);
+                     }) == CHIP_NO_ERROR);
+        }
 
         CHIP_ERROR err;
-        if (mEncodingInitialList)
+        if (staged)
+        {
+            err = CopyStagedListItem();
+        }
+        else if (mEncodingInitialList)
         {
             // Just encode a single item, with an anonymous tag.
             AttributeReportBuilder builder;
@@ -199,12 +217,25 @@ private:
             return err;
         }
 
+        mEncodeState.NoteListItemLength(mAttributeReportIBsBuilder.GetWriter()->GetLengthWritten() - lengthBefore);
         mCurrentEncodingListIndex++;
         mEncodeState.SetCurrentEncodingListIndex(mCurrentEncodingListIndex);
         mEncodedAtLeastOneListItem = true;
         return CHIP_NO_ERROR;
     }
 
+    /**
+     * Whether the next list item should be staged in the list item carry: when there is one, and the space left in the chunk
+     * is getting close to the length of the largest item encoded so far.
+     */
+    bool ShouldStageListItem() const;
+
+    /**
+     * Copies the list item staged in the list item carry into the report, as an item of the initial list or in its own
+     * AttributeReportIB. If it does not fit, the carry holds it for the next chunk.
+     */
+    CHIP_ERROR CopyStagedListItem();
+
     /**
      * Builds a single AttributeReportIB in AttributeReportIBs.  The caller is
      * responsible for setting up mPath correctly.
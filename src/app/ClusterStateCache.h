@@ -24,6 +24,7 @@
 #include <app/AppConfig.h>
 #include <app/AttributePathParams.h>
 #include <app/BufferedReadCallback.h>
+#include <app/ClusterStateCacheStorage.h>
 #include <app/ReadClient.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
@@ -61,12 +62,18 @@ namespace app {
  * through to a registered callback. In addition, it provides its own enhancements to the base ReadClient::Callback
  * to make it easier to know what has changed in the cache.
  *
+ * Attribute state is kept either in a tree of maps with a buffer per attribute value (the default), or, when
+ * UseFlatStorage is true, in sorted vectors with all the attribute values of the node in one arena (see
+ * ClusterStateCacheFlatStorage). The flat storage uses much less memory and fewer allocations for large caches,
+ * but the TLV buffers handed out by the Get() methods for attributes then only remain valid until the cache
+ * is next updated.
+ *
  * **NOTE**
  * 1. This already includes the BufferedReadCallback, so there is no need to add that to the ReadClient callback chain.
  * 2. The same cache cannot be used by multiple subscribe/read interactions at the same time.
  *
  */
-template <bool CanEnableDataCaching>
+template <bool CanEnableDataCaching, bool UseFlatStorage = false>
 class ClusterStateCacheT : protected ReadClient::Callback
 {
 public:
@@ -372,18 +379,11 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(EndpointId endpointId, ClusterId clusterId, IteratorFunc func) const
     {
-        CHIP_ERROR err;
-
-        auto clusterState = GetClusterState(endpointId, clusterId, err);
-        ReturnErrorOnFailure(err);
-
-        for (auto & attributeIter : clusterState->mAttributes)
-        {
-            const ConcreteAttributePath path(endpointId, clusterId, attributeIter.first);
-            ReturnErrorOnFailure(func(path));
-        }
-
-        return CHIP_NO_ERROR;
+        return mCache.ForEachAttribute(endpointId, clusterId,
+                                       [endpointId, clusterId, &func](AttributeId attributeId, const AttributeValue &) {
+                                           const ConcreteAttributePath path(endpointId, clusterId, attributeId);
+                                           return func(path);
+                                       });
     }
 
     /*
@@ -402,21 +402,14 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(ClusterId clusterId, IteratorFunc func) const
     {
-        for (auto & endpointIter : mCache)
-        {
-            for (auto & clusterIter : endpointIter.second)
-            {
-                if (clusterIter.first == clusterId)
+        return mCache.ForEachCluster(
+            [this, clusterId, &func](EndpointId endpointId, ClusterId clusterIdIter, const DataVersions &) {
+                if (clusterIdIter != clusterId)
                 {
-                    for (auto & attributeIter : clusterIter.second.mAttributes)
-                    {
-                        const ConcreteAttributePath path(endpointIter.first, clusterId, attributeIter.first);
-                        ReturnErrorOnFailure(func(path));
-                    }
+                    return CHIP_NO_ERROR;
                 }
-            }
-        }
-        return CHIP_NO_ERROR;
+                return ForEachAttribute(endpointId, clusterId, func);
+            });
     }
 
     /*
@@ -435,15 +428,7 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
-        auto endpointIter = mCache.find(endpointId);
-        if (endpointIter->first == endpointId)
-        {
-            for (auto & clusterIter : endpointIter->second)
-            {
-                ReturnErrorOnFailure(func(clusterIter.first));
-            }
-        }
-        return CHIP_NO_ERROR;
+        return mCache.ForEachCluster(endpointId, func);
     }
 
     /*
@@ -547,34 +532,15 @@ public:
      */
     CHIP_ERROR GetLastReportDataPath(ConcreteClusterPath & aPath);
 
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    const auto & GetStorageForTesting() const { return mCache; }
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
 private:
-    // An attribute state can be one of three things:
-    // * If we got a path-specific error for the attribute, the corresponding
-    //   status.
-    // * If we got data for the attribute and we are storing data ourselves, the
-    //   data.
-    // * If we got data for the attribute and we are not storing data
-    //   oureselves, the size of the data, so we can still prioritize sending
-    //   DataVersions correctly.
-    //
-    // The data for a single attribute is not going to be gigabytes in size, so
-    // using uint32_t for the size is fine; on 64-bit systems this can save
-    // quite a bit of space.
-    using AttributeData  = Platform::ScopedMemoryBufferWithSize<uint8_t>;
-    using AttributeState = std::conditional_t<CanEnableDataCaching, Variant<StatusIB, AttributeData, uint32_t>, uint32_t>;
-    // mPendingDataVersion represents a tentative data version for a cluster that we have gotten some reports for.
-    //
-    // mCurrentDataVersion represents a known data version for a cluster.  In order for this to have a
-    // value the cluster must be included in a path in mRequestPathSet that has a wildcard attribute
-    // and we must not be in the middle of receiving reports for that cluster.
-    struct ClusterState
-    {
-        std::map<AttributeId, AttributeState> mAttributes;
-        Optional<DataVersion> mPendingDataVersion;
-        Optional<DataVersion> mCommittedDataVersion;
-    };
-    using EndpointState = std::map<ClusterId, ClusterState>;
-    using NodeState     = std::map<EndpointId, EndpointState>;
+    using NodeState =
+        std::conditional_t<UseFlatStorage, ClusterStateCacheFlatStorage, ClusterStateCacheMapStorage<CanEnableDataCaching>>;
+    using AttributeValue = ClusterStateCacheAttributeValue;
+    using DataVersions   = ClusterStateCacheDataVersions;
 
     struct Comparator
     {
@@ -598,23 +564,6 @@ private:
         }
     };
 
-    /*
-     * These functions provide a way to index into the cached state with different sub-sets of a path, returning
-     * appropriate slices of the data as requested.
-     *
-     * In all variants, the respective slice is returned if a valid path is provided. 'err' is updated to reflect
-     * the status of the operation.
-     *
-     * Notable status values:
-     *      - If a cluster instance corresponding to endpointId and clusterId doesn't exist in the cache,
-     *        CHIP_ERROR_KEY_NOT_FOUND shall be returned.
-     *
-     */
-    const EndpointState * GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const;
-    const ClusterState * GetClusterState(EndpointId endpointId, ClusterId clusterId, CHIP_ERROR & err) const;
-    const AttributeState * GetAttributeState(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId,
-                                             CHIP_ERROR & err) const;
-
     const EventData * GetEventData(EventNumber number, CHIP_ERROR & err) const;
 
     /*
@@ -701,8 +650,10 @@ private:
     const bool mCacheData                   = CanEnableDataCaching;
 };
 
-using ClusterStateCache       = ClusterStateCacheT<true>;
-using ClusterStateCacheNoData = ClusterStateCacheT<false>;
+using ClusterStateCache           = ClusterStateCacheT<true>;
+using ClusterStateCacheNoData     = ClusterStateCacheT<false>;
+using ClusterStateCacheFlat       = ClusterStateCacheT<true, true>;
+using ClusterStateCacheFlatNoData = ClusterStateCacheT<false, true>;
 
 };     // namespace app
 };     // namespace chip
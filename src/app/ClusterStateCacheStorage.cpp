@@ -0,0 +1,300 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/ClusterStateCacheStorage.h>
+
+#include <algorithm>
+#include <tuple>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// Below this much garbage, compacting the arena is not worth a copy of the live data.
+constexpr size_t kMinCompactionGarbageSize = 1024;
+
+} // anonymous namespace
+
+size_t ClusterStateCacheFlatStorage::ClusterLowerBound(EndpointId endpointId, ClusterId clusterId) const
+{
+    auto key = std::make_tuple(endpointId, clusterId);
+    auto it  = std::lower_bound(mClusters.begin(), mClusters.end(), key, [](const ClusterRecord & record, const auto & k) {
+        return std::make_tuple(record.mEndpointId, record.mClusterId) < k;
+    });
+    return static_cast<size_t>(it - mClusters.begin());
+}
+
+size_t ClusterStateCacheFlatStorage::LowerBound(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId) const
+{
+    auto key = std::make_tuple(endpointId, clusterId, attributeId);
+    auto it  = std::lower_bound(mAttributes.begin(), mAttributes.end(), key, [](const AttributeRecord & record, const auto & k) {
+        return std::make_tuple(record.mEndpointId, record.mClusterId, record.mAttributeId) < k;
+    });
+    return static_cast<size_t>(it - mAttributes.begin());
+}
+
+bool ClusterStateCacheFlatStorage::HasEndpoint(EndpointId endpointId) const
+{
+    return std::binary_search(mEndpoints.begin(), mEndpoints.end(), endpointId);
+}
+
+const ClusterStateCacheFlatStorage::DataVersions * ClusterStateCacheFlatStorage::FindCluster(EndpointId endpointId,
+                                                                                             ClusterId clusterId) const
+{
+    size_t index = ClusterLowerBound(endpointId, clusterId);
+    if (index == mClusters.size() || mClusters[index].mEndpointId != endpointId || mClusters[index].mClusterId != clusterId)
+    {
+        return nullptr;
+    }
+    return &mClusters[index].mVersions;
+}
+
+ClusterStateCacheFlatStorage::DataVersions & ClusterStateCacheFlatStorage::GetOrAddCluster(EndpointId endpointId,
+                                                                                           ClusterId clusterId)
+{
+    // Reports list clusters in increasing order, so new clusters usually go at the end.
+    if (mClusters.empty() || std::make_tuple(mClusters.back().mEndpointId, mClusters.back().mClusterId) <
+                                 std::make_tuple(endpointId, clusterId))
+    {
+        if (mEndpoints.empty() || mEndpoints.back() < endpointId)
+        {
+            mEndpoints.push_back(endpointId);
+        }
+        else if (!HasEndpoint(endpointId))
+        {
+            mEndpoints.insert(std::lower_bound(mEndpoints.begin(), mEndpoints.end(), endpointId), endpointId);
+        }
+        mClusters.push_back({ endpointId, clusterId, DataVersions() });
+        return mClusters.back().mVersions;
+    }
+
+    size_t index = ClusterLowerBound(endpointId, clusterId);
+    if (mClusters[index].mEndpointId != endpointId || mClusters[index].mClusterId != clusterId)
+    {
+        if (!HasEndpoint(endpointId))
+        {
+            mEndpoints.insert(std::lower_bound(mEndpoints.begin(), mEndpoints.end(), endpointId), endpointId);
+        }
+        mClusters.insert(mClusters.begin() + static_cast<std::ptrdiff_t>(index), { endpointId, clusterId, DataVersions() });
+    }
+    return mClusters[index].mVersions;
+}
+
+ClusterStateCacheFlatStorage::AttributeRecord & ClusterStateCacheFlatStorage::GetOrAddAttribute(const ConcreteAttributePath & path)
+{
+    GetOrAddCluster(path.mEndpointId, path.mClusterId);
+
+    AttributeRecord newRecord = {};
+    newRecord.mClusterId      = path.mClusterId;
+    newRecord.mAttributeId    = path.mAttributeId;
+    newRecord.mEndpointId     = path.mEndpointId;
+    newRecord.mType           = AttributeValue::Type::kSize;
+
+    auto key = std::make_tuple(path.mEndpointId, path.mClusterId, path.mAttributeId);
+    if (mAttributes.empty() ||
+        std::make_tuple(mAttributes.back().mEndpointId, mAttributes.back().mClusterId, mAttributes.back().mAttributeId) < key)
+    {
+        mAttributes.push_back(newRecord);
+        return mAttributes.back();
+    }
+
+    size_t index = LowerBound(path.mEndpointId, path.mClusterId, path.mAttributeId);
+    if (std::make_tuple(mAttributes[index].mEndpointId, mAttributes[index].mClusterId, mAttributes[index].mAttributeId) != key)
+    {
+        mAttributes.insert(mAttributes.begin() + static_cast<std::ptrdiff_t>(index), newRecord);
+    }
+    return mAttributes[index];
+}
+
+void ClusterStateCacheFlatStorage::ReleaseData(const AttributeRecord & record)
+{
+    if (record.mType == AttributeValue::Type::kData)
+    {
+        mLiveDataSize -= record.mSize;
+    }
+}
+
+CHIP_ERROR ClusterStateCacheFlatStorage::SetAttributeData(const ConcreteAttributePath & path, TLV::TLVReader & data,
+                                                          uint32_t elementSize)
+{
+    const size_t offset = mArena.size();
+    VerifyOrReturnError(offset + elementSize <= UINT32_MAX, CHIP_ERROR_NO_MEMORY);
+
+    mArena.resize(offset + elementSize);
+    TLV::TLVWriter writer;
+    writer.Init(mArena.data() + offset, elementSize);
+    CHIP_ERROR err = writer.CopyElement(TLV::AnonymousTag(), data);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = writer.Finalize();
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        mArena.resize(offset);
+        return err;
+    }
+
+    AttributeRecord & record = GetOrAddAttribute(path);
+    ReleaseData(record);
+    record.mType   = AttributeValue::Type::kData;
+    record.mOffset = static_cast<uint32_t>(offset);
+    record.mSize   = elementSize;
+    mLiveDataSize += elementSize;
+    return CHIP_NO_ERROR;
+}
+
+void ClusterStateCacheFlatStorage::SetAttributeStatus(const ConcreteAttributePath & path, const StatusIB & status)
+{
+    AttributeRecord & record = GetOrAddAttribute(path);
+    ReleaseData(record);
+    record.mType   = AttributeValue::Type::kStatus;
+    record.mStatus = status;
+}
+
+void ClusterStateCacheFlatStorage::SetAttributeSize(const ConcreteAttributePath & path, uint32_t size)
+{
+    AttributeRecord & record = GetOrAddAttribute(path);
+    ReleaseData(record);
+    record.mType = AttributeValue::Type::kSize;
+    record.mSize = size;
+}
+
+ClusterStateCacheFlatStorage::AttributeValue ClusterStateCacheFlatStorage::ToAttributeValue(const AttributeRecord & record) const
+{
+    AttributeValue value;
+    value.mType = record.mType;
+    switch (record.mType)
+    {
+    case AttributeValue::Type::kStatus:
+        value.mStatus = record.mStatus;
+        break;
+    case AttributeValue::Type::kData:
+        value.mData = ByteSpan(mArena.data() + record.mOffset, record.mSize);
+        break;
+    case AttributeValue::Type::kSize:
+        value.mSize = record.mSize;
+        break;
+    }
+    return value;
+}
+
+CHIP_ERROR ClusterStateCacheFlatStorage::GetAttribute(const ConcreteAttributePath & path, AttributeValue & value) const
+{
+    size_t index = LowerBound(path.mEndpointId, path.mClusterId, path.mAttributeId);
+    VerifyOrReturnError(index < mAttributes.size(), CHIP_ERROR_KEY_NOT_FOUND);
+
+    const AttributeRecord & record = mAttributes[index];
+    VerifyOrReturnError(record.mEndpointId == path.mEndpointId && record.mClusterId == path.mClusterId &&
+                            record.mAttributeId == path.mAttributeId,
+                        CHIP_ERROR_KEY_NOT_FOUND);
+
+    value = ToAttributeValue(record);
+    return CHIP_NO_ERROR;
+}
+
+void ClusterStateCacheFlatStorage::RemoveAttributes(size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        ReleaseData(mAttributes[i]);
+    }
+    mAttributes.erase(mAttributes.begin() + static_cast<std::ptrdiff_t>(begin),
+                      mAttributes.begin() + static_cast<std::ptrdiff_t>(end));
+}
+
+void ClusterStateCacheFlatStorage::RemoveEndpoint(EndpointId endpointId)
+{
+    auto endpointIter = std::lower_bound(mEndpoints.begin(), mEndpoints.end(), endpointId);
+    if (endpointIter == mEndpoints.end() || *endpointIter != endpointId)
+    {
+        return;
+    }
+    mEndpoints.erase(endpointIter);
+
+    size_t begin = ClusterLowerBound(endpointId, 0);
+    size_t end   = begin;
+    while (end < mClusters.size() && mClusters[end].mEndpointId == endpointId)
+    {
+        end++;
+    }
+    mClusters.erase(mClusters.begin() + static_cast<std::ptrdiff_t>(begin), mClusters.begin() + static_cast<std::ptrdiff_t>(end));
+
+    begin = LowerBound(endpointId, 0, 0);
+    end   = begin;
+    while (end < mAttributes.size() && mAttributes[end].mEndpointId == endpointId)
+    {
+        end++;
+    }
+    RemoveAttributes(begin, end);
+}
+
+void ClusterStateCacheFlatStorage::RemoveCluster(const ConcreteClusterPath & path)
+{
+    size_t index = ClusterLowerBound(path.mEndpointId, path.mClusterId);
+    if (index == mClusters.size() || mClusters[index].mEndpointId != path.mEndpointId ||
+        mClusters[index].mClusterId != path.mClusterId)
+    {
+        return;
+    }
+    mClusters.erase(mClusters.begin() + static_cast<std::ptrdiff_t>(index));
+
+    size_t begin = LowerBound(path.mEndpointId, path.mClusterId, 0);
+    size_t end   = begin;
+    while (end < mAttributes.size() && mAttributes[end].mEndpointId == path.mEndpointId &&
+           mAttributes[end].mClusterId == path.mClusterId)
+    {
+        end++;
+    }
+    RemoveAttributes(begin, end);
+}
+
+void ClusterStateCacheFlatStorage::RemoveAttribute(const ConcreteAttributePath & path)
+{
+    size_t index = LowerBound(path.mEndpointId, path.mClusterId, path.mAttributeId);
+    if (index < mAttributes.size() && mAttributes[index].mEndpointId == path.mEndpointId &&
+        mAttributes[index].mClusterId == path.mClusterId && mAttributes[index].mAttributeId == path.mAttributeId)
+    {
+        RemoveAttributes(index, index + 1);
+    }
+}
+
+void ClusterStateCacheFlatStorage::Compact()
+{
+    const size_t garbageSize = mArena.size() - mLiveDataSize;
+    if (garbageSize < kMinCompactionGarbageSize || garbageSize < mLiveDataSize)
+    {
+        return;
+    }
+
+    std::vector<uint8_t> arena;
+    arena.reserve(mLiveDataSize);
+    for (auto & record : mAttributes)
+    {
+        if (record.mType == AttributeValue::Type::kData)
+        {
+            const uint8_t * data = mArena.data() + record.mOffset;
+            record.mOffset       = static_cast<uint32_t>(arena.size());
+            arena.insert(arena.end(), data, data + record.mSize);
+        }
+    }
+    mArena.swap(arena);
+}
+
+} // namespace app
+} // namespace chip
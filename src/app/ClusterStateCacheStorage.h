@@ -0,0 +1,420 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the two ways ClusterStateCacheT can store the attribute state of a node:
+ *
+ *      - ClusterStateCacheMapStorage, a tree of std::map keyed by endpoint, cluster and attribute ID,
+ *        with a separate heap buffer holding the TLV of each attribute value.
+ *
+ *      - ClusterStateCacheFlatStorage, sorted vectors of fixed-size endpoint, cluster and attribute
+ *        records, with the TLV of all attribute values in one contiguous arena that is compacted
+ *        when cluster data versions change.
+ *
+ *      Both expose the same interface to ClusterStateCacheT.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/ConcreteClusterPath.h>
+#include <app/MessageDef/StatusIB.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/Optional.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+#include <lib/support/Variant.h>
+
+#include <map>
+#include <type_traits>
+#include <vector>
+
+namespace chip {
+namespace app {
+
+/*
+ * mPendingDataVersion represents a tentative data version for a cluster that we have gotten some reports for.
+ *
+ * mCommittedDataVersion represents a known data version for a cluster.  In order for this to have a
+ * value the cluster must be included in a path in the cache's request path set that has a wildcard attribute
+ * and we must not be in the middle of receiving reports for that cluster.
+ */
+struct ClusterStateCacheDataVersions
+{
+    Optional<DataVersion> mPendingDataVersion;
+    Optional<DataVersion> mCommittedDataVersion;
+};
+
+/*
+ * A view of the cached state of an attribute, which is one of three things:
+ * - If we got a path-specific error for the attribute, the corresponding status.
+ * - If we got data for the attribute and we are storing data, the TLV of the data.
+ * - If we got data for the attribute and we are not storing data, the size of the data, so we can
+ *   still prioritize sending DataVersions correctly.
+ *
+ * mData only remains valid until the cache is next updated.
+ */
+struct ClusterStateCacheAttributeValue
+{
+    enum class Type : uint8_t
+    {
+        kStatus,
+        kData,
+        kSize,
+    };
+
+    Type mType = Type::kSize;
+    StatusIB mStatus;
+    ByteSpan mData;
+    uint32_t mSize = 0;
+};
+
+template <bool CanEnableDataCaching>
+class ClusterStateCacheMapStorage
+{
+public:
+    using DataVersions   = ClusterStateCacheDataVersions;
+    using AttributeValue = ClusterStateCacheAttributeValue;
+
+    bool HasEndpoint(EndpointId endpointId) const { return mCache.find(endpointId) != mCache.end(); }
+
+    const DataVersions * FindCluster(EndpointId endpointId, ClusterId clusterId) const
+    {
+        const ClusterState * clusterState = FindClusterState(endpointId, clusterId);
+        return (clusterState != nullptr) ? &clusterState->mVersions : nullptr;
+    }
+
+    DataVersions & GetOrAddCluster(EndpointId endpointId, ClusterId clusterId) { return mCache[endpointId][clusterId].mVersions; }
+
+    CHIP_ERROR SetAttributeData(const ConcreteAttributePath & path, TLV::TLVReader & data, uint32_t elementSize)
+    {
+        if constexpr (CanEnableDataCaching)
+        {
+            Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
+            backingBuffer.Calloc(elementSize);
+            VerifyOrReturnError(backingBuffer.Get() != nullptr, CHIP_ERROR_NO_MEMORY);
+            TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), elementSize);
+            ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), data));
+            ReturnErrorOnFailure(writer.Finalize(backingBuffer));
+
+            AttributeState state;
+            state.template Set<AttributeData>(std::move(backingBuffer));
+            GetAttributeState(path) = std::move(state);
+            return CHIP_NO_ERROR;
+        }
+        else
+        {
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+    }
+
+    void SetAttributeStatus(const ConcreteAttributePath & path, const StatusIB & status)
+    {
+        if constexpr (CanEnableDataCaching)
+        {
+            GetAttributeState(path).template Set<StatusIB>(status);
+        }
+    }
+
+    void SetAttributeSize(const ConcreteAttributePath & path, uint32_t size)
+    {
+        if constexpr (CanEnableDataCaching)
+        {
+            GetAttributeState(path).template Set<uint32_t>(size);
+        }
+        else
+        {
+            GetAttributeState(path) = size;
+        }
+    }
+
+    /*
+     * Returns CHIP_ERROR_KEY_NOT_FOUND if there is no state for the attribute.
+     */
+    CHIP_ERROR GetAttribute(const ConcreteAttributePath & path, AttributeValue & value) const
+    {
+        const ClusterState * clusterState = FindClusterState(path.mEndpointId, path.mClusterId);
+        VerifyOrReturnError(clusterState != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+        auto attributeIter = clusterState->mAttributes.find(path.mAttributeId);
+        VerifyOrReturnError(attributeIter != clusterState->mAttributes.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+        value = ToAttributeValue(attributeIter->second);
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * Calls func(AttributeId, const AttributeValue &) for each attribute of the cluster, in increasing
+     * attribute ID order. Returns CHIP_ERROR_KEY_NOT_FOUND if the cluster is not in the cache.
+     */
+    template <typename Func>
+    CHIP_ERROR ForEachAttribute(EndpointId endpointId, ClusterId clusterId, Func func) const
+    {
+        const ClusterState * clusterState = FindClusterState(endpointId, clusterId);
+        VerifyOrReturnError(clusterState != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+        for (auto & attributeIter : clusterState->mAttributes)
+        {
+            ReturnErrorOnFailure(func(attributeIter.first, ToAttributeValue(attributeIter.second)));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * Calls func(EndpointId, ClusterId, const DataVersions &) for each cluster, in increasing
+     * (endpoint ID, cluster ID) order.
+     */
+    template <typename Func>
+    CHIP_ERROR ForEachCluster(Func func) const
+    {
+        for (auto & endpointIter : mCache)
+        {
+            for (auto & clusterIter : endpointIter.second)
+            {
+                ReturnErrorOnFailure(func(endpointIter.first, clusterIter.first, clusterIter.second.mVersions));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * Calls func(ClusterId) for each cluster of the endpoint, in increasing cluster ID order.
+     */
+    template <typename Func>
+    CHIP_ERROR ForEachCluster(EndpointId endpointId, Func func) const
+    {
+        auto endpointIter = mCache.find(endpointId);
+        if (endpointIter != mCache.end())
+        {
+            for (auto & clusterIter : endpointIter->second)
+            {
+                ReturnErrorOnFailure(func(clusterIter.first));
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    void RemoveEndpoint(EndpointId endpointId) { mCache.erase(endpointId); }
+
+    void RemoveCluster(const ConcreteClusterPath & path)
+    {
+        auto endpointIter = mCache.find(path.mEndpointId);
+        if (endpointIter != mCache.end())
+        {
+            endpointIter->second.erase(path.mClusterId);
+        }
+    }
+
+    void RemoveAttribute(const ConcreteAttributePath & path)
+    {
+        auto endpointIter = mCache.find(path.mEndpointId);
+        if (endpointIter == mCache.end())
+        {
+            return;
+        }
+
+        auto clusterIter = endpointIter->second.find(path.mClusterId);
+        if (clusterIter != endpointIter->second.end())
+        {
+            clusterIter->second.mAttributes.erase(path.mAttributeId);
+        }
+    }
+
+    // Every value has its own buffer, so there is nothing to compact.
+    void Compact() {}
+
+private:
+    // The data for a single attribute is not going to be gigabytes in size, so
+    // using uint32_t for the size is fine; on 64-bit systems this can save
+    // quite a bit of space.
+    using AttributeData  = Platform::ScopedMemoryBufferWithSize<uint8_t>;
+    using AttributeState = std::conditional_t<CanEnableDataCaching, Variant<StatusIB, AttributeData, uint32_t>, uint32_t>;
+
+    struct ClusterState
+    {
+        std::map<AttributeId, AttributeState> mAttributes;
+        DataVersions mVersions;
+    };
+    using EndpointState = std::map<ClusterId, ClusterState>;
+    using NodeState     = std::map<EndpointId, EndpointState>;
+
+    static AttributeValue ToAttributeValue(const AttributeState & state)
+    {
+        AttributeValue value;
+        if constexpr (CanEnableDataCaching)
+        {
+            if (state.template Is<StatusIB>())
+            {
+                value.mType   = AttributeValue::Type::kStatus;
+                value.mStatus = state.template Get<StatusIB>();
+            }
+            else if (state.template Is<AttributeData>())
+            {
+                const AttributeData & data = state.template Get<AttributeData>();
+                value.mType                = AttributeValue::Type::kData;
+                value.mData                = ByteSpan(data.Get(), data.AllocatedSize());
+            }
+            else
+            {
+                VerifyOrDie(state.template Is<uint32_t>());
+                value.mSize = state.template Get<uint32_t>();
+            }
+        }
+        else
+        {
+            value.mSize = state;
+        }
+        return value;
+    }
+
+    const ClusterState * FindClusterState(EndpointId endpointId, ClusterId clusterId) const
+    {
+        auto endpointIter = mCache.find(endpointId);
+        if (endpointIter == mCache.end())
+        {
+            return nullptr;
+        }
+
+        auto clusterIter = endpointIter->second.find(clusterId);
+        return (clusterIter != endpointIter->second.end()) ? &clusterIter->second : nullptr;
+    }
+
+    AttributeState & GetAttributeState(const ConcreteAttributePath & path)
+    {
+        return mCache[path.mEndpointId][path.mClusterId].mAttributes[path.mAttributeId];
+    }
+
+    NodeState mCache;
+};
+
+/*
+ * The state of a node is kept in three sorted vectors of fixed-size records (endpoints, clusters and
+ * attributes), so lookups are binary searches over contiguous memory and a cache holding hundreds of
+ * attributes needs a handful of allocations. Attribute values are appended to a single TLV arena;
+ * values that get replaced or removed leave garbage behind, which is reclaimed by Compact() once it
+ * outweighs the live data.
+ *
+ * Attribute data therefore only remains valid until the cache is next updated, rather than until the
+ * value of that particular attribute is.
+ */
+class ClusterStateCacheFlatStorage
+{
+public:
+    using DataVersions   = ClusterStateCacheDataVersions;
+    using AttributeValue = ClusterStateCacheAttributeValue;
+
+    bool HasEndpoint(EndpointId endpointId) const;
+
+    const DataVersions * FindCluster(EndpointId endpointId, ClusterId clusterId) const;
+
+    DataVersions & GetOrAddCluster(EndpointId endpointId, ClusterId clusterId);
+
+    CHIP_ERROR SetAttributeData(const ConcreteAttributePath & path, TLV::TLVReader & data, uint32_t elementSize);
+    void SetAttributeStatus(const ConcreteAttributePath & path, const StatusIB & status);
+    void SetAttributeSize(const ConcreteAttributePath & path, uint32_t size);
+
+    CHIP_ERROR GetAttribute(const ConcreteAttributePath & path, AttributeValue & value) const;
+
+    template <typename Func>
+    CHIP_ERROR ForEachAttribute(EndpointId endpointId, ClusterId clusterId, Func func) const
+    {
+        VerifyOrReturnError(FindCluster(endpointId, clusterId) != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+        for (size_t i = LowerBound(endpointId, clusterId, 0); i < mAttributes.size(); i++)
+        {
+            const AttributeRecord & record = mAttributes[i];
+            if (record.mEndpointId != endpointId || record.mClusterId != clusterId)
+            {
+                break;
+            }
+            ReturnErrorOnFailure(func(record.mAttributeId, ToAttributeValue(record)));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    template <typename Func>
+    CHIP_ERROR ForEachCluster(Func func) const
+    {
+        for (auto & record : mClusters)
+        {
+            ReturnErrorOnFailure(func(record.mEndpointId, record.mClusterId, record.mVersions));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    template <typename Func>
+    CHIP_ERROR ForEachCluster(EndpointId endpointId, Func func) const
+    {
+        for (size_t i = ClusterLowerBound(endpointId, 0); i < mClusters.size() && mClusters[i].mEndpointId == endpointId; i++)
+        {
+            ReturnErrorOnFailure(func(mClusters[i].mClusterId));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    void RemoveEndpoint(EndpointId endpointId);
+    void RemoveCluster(const ConcreteClusterPath & path);
+    void RemoveAttribute(const ConcreteAttributePath & path);
+
+    /*
+     * Move the live attribute data to a new arena if most of the current one is garbage.
+     */
+    void Compact();
+
+    size_t GetArenaSize() const { return mArena.size(); }
+    size_t GetLiveDataSize() const { return mLiveDataSize; }
+
+private:
+    struct ClusterRecord
+    {
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        DataVersions mVersions;
+    };
+
+    struct AttributeRecord
+    {
+        ClusterId mClusterId;
+        AttributeId mAttributeId;
+        uint32_t mOffset; // Offset of the TLV in the arena, for kData
+        uint32_t mSize;   // Length of the TLV for kData, size of the value for kSize
+        EndpointId mEndpointId;
+        AttributeValue::Type mType;
+        StatusIB mStatus; // For kStatus
+    };
+
+    size_t ClusterLowerBound(EndpointId endpointId, ClusterId clusterId) const;
+    size_t LowerBound(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId) const;
+    AttributeRecord & GetOrAddAttribute(const ConcreteAttributePath & path);
+    void ReleaseData(const AttributeRecord & record);
+    void RemoveAttributes(size_t begin, size_t end);
+    AttributeValue ToAttributeValue(const AttributeRecord & record) const;
+
+    std::vector<EndpointId> mEndpoints;
+    std::vector<ClusterRecord> mClusters;
+    std::vector<AttributeRecord> mAttributes;
+    std::vector<uint8_t> mArena;
+    size_t mLiveDataSize = 0; // Bytes of the arena referenced by attribute records
+};
+
+} // namespace app
+} // namespace chip
@@ -19,6 +19,9 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/SafeInt.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <string.h>
 
 namespace chip {
 namespace app {
@@ -27,13 +30,16 @@ CHIP_ERROR DefaultAttributePersistenceProvider::InternalWriteValue(const Storage
 {
     VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
-    // TODO: we may want to have a small cache for values that change a lot, so
-    //  we only write them once a bunch of changes happen or on timer or
-    //  shutdown.
     if (!CanCastTo<uint16_t>(aValue.size()))
     {
         return CHIP_ERROR_BUFFER_TOO_SMALL;
     }
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+    if (mWriteBatchDepth > 0)
+    {
+        return BatchWrite(aKey, aValue);
+    }
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
     return mStorage->SyncSetKeyValue(aKey.KeyName(), aValue.data(), static_cast<uint16_t>(aValue.size()));
 }
 
@@ -41,6 +47,15 @@ CHIP_ERROR DefaultAttributePersistenceProvider::InternalReadValue(const StorageK
 {
     VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+    // A value held back by a write batch is newer than the stored one.
+    const BatchedWrite * write = FindBatchedWrite(aKey);
+    if (write != nullptr)
+    {
+        return CopySpanToMutableSpan(ByteSpan(write->mValue.Get(), write->mValue.AllocatedSize()), aValue);
+    }
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+
     uint16_t size = static_cast<uint16_t>(min(aValue.size(), static_cast<size_t>(UINT16_MAX)));
     ReturnErrorOnFailure(mStorage->SyncGetKeyValue(aKey.KeyName(), aValue.data(), size));
     aValue.reduce_size(size);
@@ -99,6 +114,90 @@ CHIP_ERROR DefaultAttributePersistenceProvider::SafeReadValue(const ConcreteAttr
         DefaultStorageKeyAllocator::SafeAttributeValue(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId), aValue);
 }
 
+void DefaultAttributePersistenceProvider::StartWriteBatch()
+{
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+    mWriteBatchDepth++;
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+}
+
+CHIP_ERROR DefaultAttributePersistenceProvider::EndWriteBatch()
+{
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+    VerifyOrReturnError(mWriteBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+    mWriteBatchDepth--;
+    VerifyOrReturnError(mWriteBatchDepth == 0, CHIP_NO_ERROR);
+    return StoreBatchedWrites();
+#else
+    return CHIP_NO_ERROR;
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+}
+
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+CHIP_ERROR DefaultAttributePersistenceProvider::BatchWrite(const StorageKeyName & aKey, const ByteSpan & aValue)
+{
+    BatchedWrite * write = FindBatchedWrite(aKey);
+    if (write == nullptr && mBatchedWriteCount < ArraySize(mBatchedWrites))
+    {
+        write       = &mBatchedWrites[mBatchedWriteCount++];
+        write->mKey = aKey;
+    }
+
+    if (write != nullptr && write->mValue.AllocatedSize() != aValue.size())
+    {
+        write->mValue.Alloc(aValue.size());
+    }
+    if (write != nullptr && write->mValue.Get() == nullptr)
+    {
+        // Out of memory: drop the entry, whose older value must not overwrite this one when the batch ends.
+        *write = std::move(mBatchedWrites[--mBatchedWriteCount]);
+        mBatchedWrites[mBatchedWriteCount].mValue.Free();
+        write = nullptr;
+    }
+    if (write == nullptr)
+    {
+        // The batch is full: the value is stored right away.
+        return mStorage->SyncSetKeyValue(aKey.KeyName(), aValue.data(), static_cast<uint16_t>(aValue.size()));
+    }
+
+    memcpy(write->mValue.Get(), aValue.data(), aValue.size());
+    return CHIP_NO_ERROR;
+}
+
+DefaultAttributePersistenceProvider::BatchedWrite *
+DefaultAttributePersistenceProvider::FindBatchedWrite(const StorageKeyName & aKey)
+{
+    for (size_t i = 0; i < mBatchedWriteCount; i++)
+    {
+        if (strcmp(mBatchedWrites[i].mKey.KeyName(), aKey.KeyName()) == 0)
+        {
+            return &mBatchedWrites[i];
+        }
+    }
+    return nullptr;
+}
+
+CHIP_ERROR DefaultAttributePersistenceProvider::StoreBatchedWrites()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    for (size_t i = 0; i < mBatchedWriteCount; i++)
+    {
+        BatchedWrite & write = mBatchedWrites[i];
+        CHIP_ERROR writeErr  = mStorage->SyncSetKeyValue(write.mKey.KeyName(), write.mValue.Get(),
+                                                        static_cast<uint16_t>(write.mValue.AllocatedSize()));
+        if (writeErr != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to store attribute value %s: %" CHIP_ERROR_FORMAT, write.mKey.KeyName(),
+                         writeErr.Format());
+            err = (err == CHIP_NO_ERROR) ? writeErr : err;
+        }
+        write.mValue.Free();
+    }
+    mBatchedWriteCount = 0;
+    return err;
+}
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+
 namespace {
 
 AttributePersistenceProvider * gAttributeSaver = nullptr;
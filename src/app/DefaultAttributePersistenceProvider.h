@@ -19,6 +19,7 @@
 #include <app/SafeAttributePersistenceProvider.h>
 #include <lib/core/CHIPPersistentStorageDelegate.h>
 #include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/ScopedBuffer.h>
 
 namespace chip {
 namespace app {
@@ -53,6 +54,8 @@ public:
     CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override;
     CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                          MutableByteSpan & aValue) override;
+    void StartWriteBatch() override;
+    CHIP_ERROR EndWriteBatch() override;
 
     // SafeAttributePersistenceProvider implementation.
     CHIP_ERROR SafeWriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override;
@@ -66,6 +69,23 @@ private:
     CHIP_ERROR InternalReadValue(const StorageKeyName & aKey, MutableByteSpan & aValue);
     CHIP_ERROR InternalReadValue(const StorageKeyName & aKey, EmberAfAttributeType aType, size_t aExpectedSize,
                                  MutableByteSpan & aValue);
+
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+    // A value written during a write batch, to store when the batch ends.
+    struct BatchedWrite
+    {
+        StorageKeyName mKey = StorageKeyName::Uninitialized();
+        Platform::ScopedMemoryBufferWithSize<uint8_t> mValue;
+    };
+
+    CHIP_ERROR BatchWrite(const StorageKeyName & aKey, const ByteSpan & aValue);
+    BatchedWrite * FindBatchedWrite(const StorageKeyName & aKey);
+    CHIP_ERROR StoreBatchedWrites();
+
+    BatchedWrite mBatchedWrites[CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE];
+    size_t mBatchedWriteCount = 0;
+    uint16_t mWriteBatchDepth = 0;
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
 };
 
 } // namespace app
@@ -71,6 +71,10 @@ public:
     CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
                          MutableByteSpan & aValue) override;
 
+    // The writes that are not deferred are batched by the decorated persister.
+    void StartWriteBatch() override { mPersister.StartWriteBatch(); }
+    CHIP_ERROR EndWriteBatch() override { return mPersister.EndWriteBatch(); }
+
 private:
     void FlushAndScheduleNext();
 
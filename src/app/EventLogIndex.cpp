@@ -0,0 +1,130 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/EventLogIndex.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace app {
+
+void EventLogIndex::Init(Entry * apEntries, size_t aCapacity)
+{
+    mpEntries = apEntries;
+    mCapacity = aCapacity;
+    Clear();
+}
+
+void EventLogIndex::Clear()
+{
+    mFirst           = 0;
+    mCount           = 0;
+    mUnindexedLength = 0;
+    mIndexedLength   = 0;
+    mValid           = (mCapacity > 0);
+}
+
+void EventLogIndex::Append(const Entry & aEntry)
+{
+    VerifyOrReturn(mValid);
+
+    if (mCount == mCapacity)
+    {
+        DropOldest();
+    }
+
+    const uint32_t offset = (mCount > 0) ? At(0).mOffset + mIndexedLength : 0;
+
+    Entry & entry  = At(mCount);
+    entry          = aEntry;
+    entry.mOffset  = offset;
+    mIndexedLength = mIndexedLength + aEntry.mLength;
+    mCount++;
+}
+
+void EventLogIndex::DropOldest()
+{
+    const uint32_t length = At(0).mLength;
+
+    mUnindexedLength = mUnindexedLength + length;
+    mIndexedLength   = mIndexedLength - length;
+    mFirst           = (mFirst + 1) % mCapacity;
+    mCount--;
+}
+
+void EventLogIndex::Remove(EventNumber aEventNumber, uint32_t aLength)
+{
+    VerifyOrReturn(mValid);
+
+    if (mCount == 0 || aEventNumber < At(0).mEventNumber)
+    {
+        // One of the oldest events, no longer indexed.
+        VerifyOrReturn(aLength <= mUnindexedLength, Invalidate());
+        mUnindexedLength = mUnindexedLength - aLength;
+        return;
+    }
+
+    const size_t position = LowerBound(aEventNumber);
+    VerifyOrReturn(position < mCount && At(position).mEventNumber == aEventNumber && At(position).mLength == aLength,
+                   Invalidate());
+
+    // Dropping an event only happens from the head of a buffer, which is usually the one of the least
+    // important events, at the end of the log: there are few entries to move.
+    for (size_t i = position + 1; i < mCount; i++)
+    {
+        Entry & entry = At(i);
+        entry.mOffset = entry.mOffset - aLength;
+        At(i - 1)     = entry;
+    }
+
+    mIndexedLength = mIndexedLength - aLength;
+    mCount--;
+}
+
+void EventLogIndex::FabricRemoved(FabricIndex aFabricIndex)
+{
+    for (size_t i = 0; i < mCount; i++)
+    {
+        Entry & entry = At(i);
+        if (entry.mHasFabricIndex && entry.mFabricIndex == aFabricIndex)
+        {
+            entry.mFabricIndex = kUndefinedFabricIndex;
+        }
+    }
+}
+
+size_t EventLogIndex::LowerBound(EventNumber aEventNumber) const
+{
+    size_t low  = 0;
+    size_t high = mCount;
+    while (low < high)
+    {
+        const size_t middle = low + (high - low) / 2;
+        if (At(middle).mEventNumber < aEventNumber)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+} // namespace app
+} // namespace chip
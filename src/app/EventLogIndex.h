@@ -0,0 +1,116 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/// Index of the events held in the event log of EventManagement, so that fetching events
+/// does not have to parse every event of the log to find the ones to report.
+///
+/// The log is read as one stream of events, from the buffer of the most critical events to
+/// the buffer of the least important ones. Logging appends events to the end of that stream,
+/// moving an event to the next buffer leaves it in place and dropping an event removes it,
+/// so the stream stays in event number order. The index records, in that order, the event
+/// number, path, fabric and length of each event, and computes the offsets of the events in
+/// the stream from their lengths.
+///
+/// The index holds up to a fixed number of entries, provided to Init. When it is full, the
+/// entries of the oldest events are dropped and these events are only accounted for by their
+/// total length: fetches of events that old have to scan the log.
+class EventLogIndex
+{
+public:
+    struct Entry
+    {
+        EventNumber mEventNumber = 0;
+        ClusterId mClusterId     = 0;
+        EventId mEventId         = 0;
+        uint32_t mOffset         = 0; ///< Offset of the event in the log (see Get).
+        uint32_t mLength         = 0;
+        EndpointId mEndpointId   = 0;
+        FabricIndex mFabricIndex = kUndefinedFabricIndex;
+        bool mHasFabricIndex     = false; ///< Whether the event is fabric sensitive (its fabric may be removed since).
+    };
+
+    /// Uses aCapacity entries of apEntries, for an empty log.
+    void Init(Entry * apEntries, size_t aCapacity);
+
+    /// Marks the index as out of sync with the log, until it is rebuilt (Clear, then Append).
+    void Invalidate() { mValid = false; }
+
+    /// Empties the index, making it valid for an empty log.
+    void Clear();
+
+    bool IsValid() const { return mValid; }
+
+    /// Whether the events since aEventNumber are all indexed.
+    bool Covers(EventNumber aEventNumber) const
+    {
+        return mValid && ((mUnindexedLength == 0) || (mCount > 0 && aEventNumber >= At(0).mEventNumber));
+    }
+
+    /// Length of the log, in bytes, as the index accounts for it.
+    uint32_t GetLogLength() const { return mUnindexedLength + mIndexedLength; }
+
+    /// Records an event added to the end of the log. aEntry.mOffset is ignored.
+    void Append(const Entry & aEntry);
+
+    /// Records that the event with the given number and length was dropped from the log.
+    void Remove(EventNumber aEventNumber, uint32_t aLength);
+
+    /// Records that the events of the given fabric were made unreadable (see EventManagement::FabricRemoved).
+    void FabricRemoved(FabricIndex aFabricIndex);
+
+    /// Number of indexed events.
+    size_t Count() const { return mCount; }
+
+    /// Position of the first indexed event with an event number of at least aEventNumber, or Count() if there is none.
+    size_t LowerBound(EventNumber aEventNumber) const;
+
+    /// The indexed event at aPosition, oldest first, with its offset from the start of the log.
+    Entry Get(size_t aPosition) const
+    {
+        // Offsets are stored from an arbitrary origin, so that dropping the oldest entry does not
+        // change the others: they are relative to the oldest one, which follows the unindexed events.
+        Entry entry   = At(aPosition);
+        entry.mOffset = mUnindexedLength + (entry.mOffset - At(0).mOffset);
+        return entry;
+    }
+
+private:
+    Entry & At(size_t aPosition) { return mpEntries[(mFirst + aPosition) % mCapacity]; }
+    const Entry & At(size_t aPosition) const { return mpEntries[(mFirst + aPosition) % mCapacity]; }
+
+    void DropOldest();
+
+    Entry * mpEntries         = nullptr;
+    size_t mCapacity          = 0;
+    size_t mFirst             = 0;
+    size_t mCount             = 0;
+    uint32_t mUnindexedLength = 0; ///< Length of the oldest events of the log, dropped from the index.
+    uint32_t mIndexedLength   = 0;
+    bool mValid               = false;
+};
+
+} // namespace app
+} // namespace chip
@@ -102,5 +102,40 @@ CHIP_ERROR LogEvent(const T & aEventData, EndpointId aEndpoint, EventNumber & aE
     return logMgmt.LogEvent(&eventData, eventOptions, aEventNumber);
 }
 
+#if CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+/**
+ * @brief
+ *   Log an event from any thread, without the Matter stack lock.
+ *
+ * The event data is encoded into the lock-free staging queue of the event
+ * management, and the event is logged on the Matter thread, where it gets
+ * its event number and timestamp.  See EventManagement::StageEvent.
+ *
+ * @param[in] aEventData  The event cluster object
+ * @param[in] aEndpoint   The current cluster's Endpoint Id
+ *
+ * @retval #CHIP_ERROR_NO_MEMORY  Too many events are waiting to be logged.
+ *
+ * @return CHIP_ERROR  CHIP Error Code
+ */
+template <typename T>
+CHIP_ERROR LogEventFromAnyThread(const T & aEventData, EndpointId aEndpoint)
+{
+    EventOptions eventOptions;
+    eventOptions.mPath     = ConcreteEventPath(aEndpoint, aEventData.GetClusterId(), aEventData.GetEventId());
+    eventOptions.mPriority = aEventData.GetPriorityLevel();
+    if constexpr (DataModel::IsFabricScoped<T>::value)
+    {
+        eventOptions.mFabricIndex = aEventData.GetFabricIndex();
+        // Same as LogEvent: skip the event if it's fabric-scoped but no fabric association exists yet.
+        VerifyOrReturnError(eventOptions.mFabricIndex != kUndefinedFabricIndex, CHIP_ERROR_INVALID_FABRIC_INDEX);
+    }
+
+    return EventManagement::GetInstance().StageEvent(eventOptions, [&aEventData](TLV::TLVWriter & aWriter) {
+        return DataModel::Encode(aWriter, TLV::ContextTag(EventDataIB::Tag::kData), aEventData);
+    });
+}
+#endif // CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+
 } // namespace app
 } // namespace chip
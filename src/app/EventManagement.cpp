@@ -23,10 +23,14 @@
 #include <app/InteractionModelEngine.h>
 #include <app/RequiredPrivilege.h>
 #include <assert.h>
+#include <atomic>
 #include <inttypes.h>
 #include <lib/core/TLVUtilities.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
+#if CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+#include <platform/PlatformManager.h>
+#endif // CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
 
 using namespace chip::TLV;
 
@@ -54,6 +58,13 @@ public:
      */
     void Init(CircularEventBufferWrapper * apBuf);
 
+    /**
+     * @brief
+     *   Moves the reader forward to the event at aOffset bytes from the start of the log, without parsing the events
+     *   before it. Next() then reads that event.
+     */
+    CHIP_ERROR SkipTo(uint32_t aOffset);
+
     virtual ~CircularEventReader() = default;
 };
 
@@ -66,7 +77,22 @@ struct ReclaimEventCtx
 {
     CircularEventBuffer * mpEventBuffer = nullptr;
     size_t mSpaceNeededForMovedEvent    = 0;
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    EventLogIndex * mpIndex = nullptr;
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+};
+
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+/**
+ * @brief
+ *  Internal structure for indexing the events of the log again.
+ */
+struct IndexEventCtx
+{
+    EventLogIndex * mpIndex = nullptr;
+    uint32_t mLogLength     = 0;
 };
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
 
 /**
  * @brief
@@ -88,6 +114,7 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
     CircularEventBuffer * current = nullptr;
     CircularEventBuffer * prev    = nullptr;
     CircularEventBuffer * next    = nullptr;
+    bool restored                 = false;
 
     if (aNumBuffers == 0)
     {
@@ -114,6 +141,20 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
 
         current->mProcessEvictedElement = nullptr;
         current->mAppData               = nullptr;
+
+        if (apLogStorageResources[bufferIndex].mpPersistedState != nullptr)
+        {
+            CHIP_ERROR err = current->RestoreState(apLogStorageResources[bufferIndex].mpPersistedState);
+            if (err == CHIP_NO_ERROR)
+            {
+                restored = true;
+            }
+            else if (err != CHIP_ERROR_NOT_FOUND)
+            {
+                ChipLogError(EventLogging, "Dropped the persisted events of priority %u: %" CHIP_ERROR_FORMAT,
+                             static_cast<unsigned>(current->GetPriority()), err.Format());
+            }
+        }
     }
 
     mpEventNumberCounter = apEventNumberCounter;
@@ -123,6 +164,20 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
     mState        = EventManagementStates::Idle;
     mBytesWritten = 0;
 
+    if (restored)
+    {
+        CheckRestoredEvents();
+    }
+
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    mIndex.Init(mIndexEntries, ArraySize(mIndexEntries));
+    if (GetLogLength() > 0)
+    {
+        // Index the restored events on the first fetch.
+        mIndex.Invalidate();
+    }
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
     mMonotonicStartupTime = aMonotonicStartupTime;
 }
 
@@ -154,6 +209,7 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
 
     err = writer.Finalize();
     SuccessOrExit(err);
+    nextBuffer->PersistState();
 
     ChipLogDetail(EventLogging, "Copy Event to next buffer with priority %u", static_cast<unsigned>(nextBuffer->GetPriority()));
 exit:
@@ -170,6 +226,9 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
     size_t requiredSpace              = aRequiredSpace;
     CircularEventBuffer * eventBuffer = mpEventBuffer;
     ReclaimEventCtx ctx;
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    ctx.mpIndex = &mIndex;
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
 
     // Check that we have this much space in all our event buffers that might
     // hold the event. If we do not, that will prevent the event from being
@@ -200,6 +259,11 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
             eventBuffer->mProcessEvictedElement = EvictEvent;
             eventBuffer->mAppData               = &ctx;
             err                                 = eventBuffer->EvictHead();
+            if (err == CHIP_NO_ERROR)
+            {
+                // Record the eviction before the space of the event is reused.
+                eventBuffer->PersistState();
+            }
 
             // one of two things happened: either the element was evicted immediately if the head's priority is same as current
             // buffer(final one), or we figured out how much space we need to evict it into the next buffer, the check happens in
@@ -228,6 +292,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // caller know that we could not honor the
                     // request
                     SuccessOrExit(err);
+                    eventBuffer->PersistState();
                     continue;
                 }
                 // we cannot copy event outright. We remember the
@@ -380,14 +445,17 @@ CHIP_ERROR EventManagement::CopyAndAdjustDeltaTime(const TLVReader & aReader, si
         // Does not go on the wire.
         return CHIP_NO_ERROR;
     }
+    // Events restored from persistent storage may have system timestamps of a previous boot, larger than the following ones.
     if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kSystemTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType) &&
+        (ctx->mpContext->mCurrentTime.mValue >= ctx->mpContext->mPreviousTime.mValue))
     {
         return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaSystemTimestamp),
                                   ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
     }
     if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kEpochTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType) &&
+        (ctx->mpContext->mCurrentTime.mValue >= ctx->mpContext->mPreviousTime.mValue))
     {
         return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaEpochTimestamp),
                                   ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
@@ -418,6 +486,63 @@ CHIP_ERROR EventManagement::LogEvent(EventLoggingDelegate * apDelegate, const Ev
     return LogEventPrivate(apDelegate, aEventOptions, aEventNumber);
 }
 
+#if CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+namespace {
+/**
+ * @brief
+ *   Writes the data of an event encoded into the staging queue.
+ */
+class StagedEventLogger : public EventLoggingDelegate
+{
+public:
+    StagedEventLogger(ByteSpan aEncodedData) : mEncodedData(aEncodedData) {}
+
+    CHIP_ERROR WriteEvent(TLV::TLVWriter & aWriter) override
+    {
+        TLVReader reader;
+        TLVType containerType;
+        reader.Init(mEncodedData);
+        ReturnErrorOnFailure(reader.Next(kTLVType_Structure, AnonymousTag()));
+        ReturnErrorOnFailure(reader.EnterContainer(containerType));
+        ReturnErrorOnFailure(reader.Next());
+        return aWriter.CopyElement(reader);
+    }
+
+private:
+    ByteSpan mEncodedData;
+};
+} // namespace
+
+CHIP_ERROR EventManagement::ScheduleStagedEventsLogging()
+{
+    VerifyOrReturnError(mStagedEvents.SetDrainPending(), CHIP_NO_ERROR);
+
+    CHIP_ERROR err = DeviceLayer::PlatformMgr().ScheduleWork(LogStagedEvents, reinterpret_cast<intptr_t>(this));
+    if (err != CHIP_NO_ERROR)
+    {
+        // Let the next staged event try again.
+        mStagedEvents.ClearDrainPending();
+    }
+    return err;
+}
+
+void EventManagement::LogStagedEvents(intptr_t aEventManagement)
+{
+    EventManagement * const eventManagement = reinterpret_cast<EventManagement *>(aEventManagement);
+
+    eventManagement->mStagedEvents.ClearDrainPending();
+    eventManagement->mStagedEvents.Drain([eventManagement](const EventOptions & aEventOptions, ByteSpan aEncodedData) {
+        StagedEventLogger logger(aEncodedData);
+        EventNumber eventNumber;
+        CHIP_ERROR err = eventManagement->LogEvent(&logger, aEventOptions, eventNumber);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(EventLogging, "Failed to log staged event: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    });
+}
+#endif // CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+
 CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions,
                                             EventNumber & aEventNumber)
 {
@@ -467,10 +592,35 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
 
     err = ConstructEvent(&ctxt, apDelegate, &opts);
     SuccessOrExit(err);
+    mpEventBuffer->PersistState();
 
     mBytesWritten += writer.GetLengthWritten();
 
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    {
+        EventLogIndex::Entry entry;
+        entry.mEventNumber    = ctxt.mCurrentEventNumber;
+        entry.mEndpointId     = opts.mPath.mEndpointId;
+        entry.mClusterId      = opts.mPath.mClusterId;
+        entry.mEventId        = opts.mPath.mEventId;
+        entry.mFabricIndex    = opts.mFabricIndex;
+        entry.mHasFabricIndex = (opts.mFabricIndex != kUndefinedFabricIndex);
+        entry.mLength         = writer.GetLengthWritten();
+        mIndex.Append(entry);
+    }
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
 exit:
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    // Making space for the event is expected to go through EvictEvent, and the event to take the space computed by
+    // CalculateEventSize. Should anything else have changed the log, its index has to be rebuilt.
+    if (mIndex.IsValid() && mIndex.GetLogLength() != GetLogLength())
+    {
+        ChipLogError(EventLogging, "Event log index out of sync, rebuilding it on the next fetch");
+        mIndex.Invalidate();
+    }
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(EventLogging, "Log event with error %" CHIP_ERROR_FORMAT, err.Format());
@@ -572,8 +722,7 @@ CHIP_ERROR EventManagement::CheckEventContext(EventLoadOutContext * eventLoadOut
     return ret;
 }
 
-CHIP_ERROR EventManagement::EventIterator(const TLVReader & aReader, size_t aDepth, EventLoadOutContext * apEventLoadOutContext,
-                                          EventEnvelopeContext * event)
+CHIP_ERROR EventManagement::ReadEventEnvelope(const TLVReader & aReader, EventEnvelopeContext * event)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
     TLVReader innerReader;
@@ -597,6 +746,13 @@ CHIP_ERROR EventManagement::EventIterator(const TLVReader & aReader, size_t aDep
     {
         err = CHIP_NO_ERROR;
     }
+    return err;
+}
+
+CHIP_ERROR EventManagement::EventIterator(const TLVReader & aReader, size_t aDepth, EventLoadOutContext * apEventLoadOutContext,
+                                          EventEnvelopeContext * event)
+{
+    CHIP_ERROR err = ReadEventEnvelope(aReader, event);
     ReturnErrorOnFailure(err);
 
     apEventLoadOutContext->mCurrentTime        = event->mCurrentTime;
@@ -615,6 +771,29 @@ CHIP_ERROR EventManagement::EventIterator(const TLVReader & aReader, size_t aDep
     return err;
 }
 
+CHIP_ERROR EventManagement::CopyFoundEvent(const TLVReader & aReader, EventLoadOutContext * apContext)
+{
+    // checkpoint the writer
+    TLV::TLVWriter checkpoint = apContext->mWriter;
+
+    CHIP_ERROR err = CopyEvent(aReader, apContext->mWriter, apContext);
+
+    // CHIP_NO_ERROR and CHIP_END_OF_TLV signify a
+    // successful copy.  In all other cases, roll back the
+    // writer state back to the checkpoint, i.e., the state
+    // before we began the copy operation.
+    if ((err != CHIP_NO_ERROR) && (err != CHIP_END_OF_TLV))
+    {
+        apContext->mWriter = checkpoint;
+        return err;
+    }
+
+    apContext->mPreviousTime.mValue = apContext->mCurrentTime.mValue;
+    apContext->mFirst               = false;
+    apContext->mEventCount++;
+    return err;
+}
+
 CHIP_ERROR EventManagement::CopyEventsSince(const TLVReader & aReader, size_t aDepth, void * apContext)
 {
     EventLoadOutContext * const loadOutContext = static_cast<EventLoadOutContext *>(apContext);
@@ -622,28 +801,133 @@ CHIP_ERROR EventManagement::CopyEventsSince(const TLVReader & aReader, size_t aD
     CHIP_ERROR err = EventIterator(aReader, aDepth, loadOutContext, &event);
     if (err == CHIP_EVENT_ID_FOUND)
     {
-        // checkpoint the writer
-        TLV::TLVWriter checkpoint = loadOutContext->mWriter;
+        err = CopyFoundEvent(aReader, loadOutContext);
+    }
+    return err;
+}
 
-        err = CopyEvent(aReader, loadOutContext->mWriter, loadOutContext);
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+CHIP_ERROR EventManagement::FetchIndexedEventsSince(EventLoadOutContext & aContext)
+{
+    CircularEventBufferWrapper bufWrapper;
+    CircularEventReader reader;
+    bufWrapper.mpCurrent = GetPriorityBuffer(PriorityLevel::Critical);
+    reader.Init(&bufWrapper);
+
+    const size_t count = mIndex.Count();
+    size_t position    = mIndex.LowerBound(aContext.mStartingEventNumber);
+    if (position == count && count > 0)
+    {
+        // Nothing to report: like a scan of the log, end with the last event.
+        aContext.mCurrentEventNumber = mIndex.Get(count - 1).mEventNumber;
+    }
 
-        // CHIP_NO_ERROR and CHIP_END_OF_TLV signify a
-        // successful copy.  In all other cases, roll back the
-        // writer state back to the checkpoint, i.e., the state
-        // before we began the copy operation.
-        if ((err != CHIP_NO_ERROR) && (err != CHIP_END_OF_TLV))
+    for (; position < count; position++)
+    {
+        const EventLogIndex::Entry entry = mIndex.Get(position);
+        EventEnvelopeContext event;
+        event.mEndpointId  = entry.mEndpointId;
+        event.mClusterId   = entry.mClusterId;
+        event.mEventId     = entry.mEventId;
+        event.mEventNumber = entry.mEventNumber;
+        if (entry.mHasFabricIndex)
+        {
+            event.mFabricIndex.SetValue(entry.mFabricIndex);
+        }
+        aContext.mCurrentEventNumber = entry.mEventNumber;
+
+        CHIP_ERROR err = CheckEventContext(&aContext, event);
+        if (err == CHIP_ERROR_UNEXPECTED_EVENT)
         {
-            loadOutContext->mWriter = checkpoint;
-            return err;
+            continue;
         }
+        ReturnErrorOnFailure(err);
 
-        loadOutContext->mPreviousTime.mValue = loadOutContext->mCurrentTime.mValue;
-        loadOutContext->mFirst               = false;
-        loadOutContext->mEventCount++;
+        // Only the events to report are read, for their timestamp and data.
+        EventEnvelopeContext envelope;
+        err = reader.SkipTo(entry.mOffset);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = reader.Next();
+        }
+        if (err == CHIP_NO_ERROR)
+        {
+            err = ReadEventEnvelope(reader, &envelope);
+        }
+        if (err != CHIP_NO_ERROR || envelope.mEventNumber != entry.mEventNumber)
+        {
+            ChipLogError(EventLogging, "Event log index out of sync at event number 0x" ChipLogFormatX64,
+                         ChipLogValueX64(entry.mEventNumber));
+            mIndex.Invalidate();
+            aContext.mStartingEventNumber = entry.mEventNumber;
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+
+        aContext.mCurrentTime = envelope.mCurrentTime;
+        ReturnErrorOnFailure(CopyFoundEvent(reader, &aContext));
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventManagement::IndexEvent(const TLVReader & aReader, size_t, void * apContext)
+{
+    IndexEventCtx * const ctx = static_cast<IndexEventCtx *>(apContext);
+    EventEnvelopeContext event;
+    ReturnErrorOnFailure(ReadEventEnvelope(aReader, &event));
+
+    TLVReader reader;
+    reader.Init(aReader);
+    ReturnErrorOnFailure(reader.Skip());
+
+    EventLogIndex::Entry entry;
+    entry.mEventNumber    = event.mEventNumber;
+    entry.mEndpointId     = event.mEndpointId;
+    entry.mClusterId      = event.mClusterId;
+    entry.mEventId        = event.mEventId;
+    entry.mHasFabricIndex = event.mFabricIndex.HasValue();
+    entry.mFabricIndex    = event.mFabricIndex.ValueOr(kUndefinedFabricIndex);
+    entry.mLength         = reader.GetLengthRead() - ctx->mLogLength;
+    ctx->mpIndex->Append(entry);
+
+    ctx->mLogLength = reader.GetLengthRead();
+    return CHIP_NO_ERROR;
+}
+
+void EventManagement::RebuildIndex()
+{
+    TLVReader reader;
+    CircularEventBufferWrapper bufWrapper;
+    IndexEventCtx ctx;
+    ctx.mpIndex = &mIndex;
+
+    mIndex.Clear();
+    CHIP_ERROR err = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = TLV::Utilities::Iterate(reader, IndexEvent, &ctx, false /*recurse*/);
+    }
+    if (err == CHIP_END_OF_TLV)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    if (err != CHIP_NO_ERROR || mIndex.GetLogLength() != GetLogLength())
+    {
+        ChipLogError(EventLogging, "Failed to rebuild the event log index: %" CHIP_ERROR_FORMAT, err.Format());
+        mIndex.Invalidate();
     }
-    return err;
 }
 
+uint32_t EventManagement::GetLogLength() const
+{
+    uint32_t length = 0;
+    for (auto * buffer = mpEventBuffer; buffer != nullptr; buffer = buffer->GetNextCircularEventBuffer())
+    {
+        length += buffer->DataLength();
+    }
+    return length;
+}
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
 CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const SingleLinkedListNode<EventPathParams> * apEventPathList,
                                              EventNumber & aEventMin, size_t & aEventCount,
                                              const Access::SubjectDescriptor & aSubjectDescriptor)
@@ -657,7 +941,21 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const SingleLi
 
     context.mSubjectDescriptor     = aSubjectDescriptor;
     context.mpInterestedEventPaths = apEventPathList;
-    err                            = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
+
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    if (!mIndex.IsValid())
+    {
+        RebuildIndex();
+    }
+    if (mIndex.Covers(aEventMin))
+    {
+        err = FetchIndexedEventsSince(context);
+        // If the index is out of sync, scan the log for the events not fetched yet.
+        VerifyOrExit(err == CHIP_ERROR_INCORRECT_STATE && !mIndex.IsValid(), /* done */);
+    }
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
+    err = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
     SuccessOrExit(err);
 
     err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
@@ -737,6 +1035,9 @@ CHIP_ERROR EventManagement::FabricRemoved(FabricIndex aFabricIndex)
     {
         err = CHIP_NO_ERROR;
     }
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    mIndex.FabricRemoved(aFabricIndex);
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
     return err;
 }
 
@@ -835,6 +1136,12 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
     CircularEventBuffer * const eventBuffer = ctx->mpEventBuffer;
     if (eventBuffer->IsFinalDestinationForPriority(imp))
     {
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+        if (ctx->mpIndex != nullptr)
+        {
+            ctx->mpIndex->Remove(context.mEventNumber, aReader.GetLengthRead());
+        }
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
         ChipLogProgress(EventLogging,
                         "Dropped 1 event from buffer with priority %u and event number  0x" ChipLogFormatX64
                         " due to overflow: event priority_level: %u",
@@ -849,6 +1156,92 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
     return CHIP_END_OF_TLV;
 }
 
+CHIP_ERROR EventManagement::CheckRestoredBuffer(CircularEventBuffer & aBuffer, Optional<EventNumber> & aLastEventNumber)
+{
+    CircularTLVReader reader;
+    uint32_t duplicateLength = 0;
+    uint32_t validLength     = 0;
+
+    reader.Init(aBuffer);
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        EventEnvelopeContext event;
+        if (reader.GetType() != kTLVType_Structure || ReadEventEnvelope(reader, &event) != CHIP_NO_ERROR ||
+            reader.Skip() != CHIP_NO_ERROR)
+        {
+            break;
+        }
+
+        if (aLastEventNumber.HasValue() && event.mEventNumber <= aLastEventNumber.Value())
+        {
+            // A crash while moving events to this buffer from the previous one can leave the first events of this buffer
+            // in both: drop them from this one. Any other event out of order is not an event this buffer was left with.
+            if (validLength != duplicateLength)
+            {
+                break;
+            }
+            duplicateLength = reader.GetLengthRead();
+            validLength     = duplicateLength;
+            continue;
+        }
+
+        aLastEventNumber.SetValue(event.mEventNumber);
+        validLength = reader.GetLengthRead();
+    }
+
+    VerifyOrReturnError(validLength != aBuffer.DataLength() || duplicateLength > 0, CHIP_NO_ERROR);
+
+    // Keep the valid events, after the duplicates.
+    ChipLogError(EventLogging, "Dropped %" PRIu32 " bytes of persisted events of priority %u",
+                 aBuffer.DataLength() - validLength + duplicateLength, static_cast<unsigned>(aBuffer.GetPriority()));
+    const uint32_t headOffset = static_cast<uint32_t>(aBuffer.QueueHead() - aBuffer.GetQueue()) + duplicateLength;
+    ReturnErrorOnFailure(aBuffer.SetQueueState(headOffset % aBuffer.GetTotalDataLength(), validLength - duplicateLength));
+    aBuffer.PersistState();
+    return CHIP_NO_ERROR;
+}
+
+void EventManagement::CheckRestoredEvents()
+{
+    // The events are in event number order from the buffer of the most critical events to the one of the least important.
+    CircularEventBuffer * buffer = mpEventBuffer;
+    while (buffer->GetNextCircularEventBuffer() != nullptr)
+    {
+        buffer = buffer->GetNextCircularEventBuffer();
+    }
+
+    Optional<EventNumber> lastEventNumber;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    for (; buffer != nullptr && err == CHIP_NO_ERROR; buffer = buffer->GetPreviousCircularEventBuffer())
+    {
+        err = CheckRestoredBuffer(*buffer, lastEventNumber);
+    }
+
+    if (err == CHIP_NO_ERROR && lastEventNumber.HasValue() && lastEventNumber.Value() >= mLastEventNumber)
+    {
+        // New events would get the numbers of restored ones.
+        ChipLogError(EventLogging, "Event number counter 0x" ChipLogFormatX64 " is behind the persisted events",
+                     ChipLogValueX64(mLastEventNumber));
+        err = CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(EventLogging, "Dropped the persisted events: %" CHIP_ERROR_FORMAT, err.Format());
+        for (buffer = mpEventBuffer; buffer != nullptr; buffer = buffer->GetNextCircularEventBuffer())
+        {
+            buffer->SetQueueState(0, 0);
+            buffer->PersistState();
+        }
+        return;
+    }
+
+    if (lastEventNumber.HasValue())
+    {
+        ChipLogProgress(EventLogging, "Restored persisted events up to event number 0x" ChipLogFormatX64,
+                        ChipLogValueX64(lastEventNumber.Value()));
+    }
+}
+
 void EventManagement::SetScheduledEventInfo(EventNumber & aEventNumber, uint32_t & aInitialWrittenEventBytes) const
 {
     aEventNumber              = mLastEventNumber;
@@ -859,9 +1252,10 @@ void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, Circu
                                CircularEventBuffer * apNext, PriorityLevel aPriorityLevel)
 {
     TLVCircularBuffer::Init(apBuffer, aBufferLength);
-    mpPrev    = apPrev;
-    mpNext    = apNext;
-    mPriority = aPriorityLevel;
+    mpPrev           = apPrev;
+    mpNext           = apNext;
+    mPriority        = aPriorityLevel;
+    mpPersistedState = nullptr;
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -880,6 +1274,92 @@ CHIP_ERROR CircularEventBuffer::OnInit(TLV::TLVWriter & writer, uint8_t *& bufSt
     return CHIP_NO_ERROR;
 }
 
+namespace {
+// FNV-1a of the fields of a record, so that a record torn by a crash is not taken for a valid one.
+uint32_t ComputeRecordCheck(const PersistedEventBufferState::Record & aRecord)
+{
+    uint32_t check = 2166136261u;
+    for (uint32_t field : { aRecord.mSequence, aRecord.mHeadOffset, aRecord.mDataLength })
+    {
+        for (unsigned shift = 0; shift < 32; shift += 8)
+        {
+            check = (check ^ ((field >> shift) & 0xFF)) * 16777619u;
+        }
+    }
+    return check;
+}
+
+bool IsValidRecord(const PersistedEventBufferState::Record & aRecord)
+{
+    return aRecord.mSequence != 0 && aRecord.mCheck == ComputeRecordCheck(aRecord);
+}
+} // namespace
+
+CHIP_ERROR CircularEventBuffer::RestoreState(PersistedEventBufferState * apState)
+{
+    VerifyOrReturnError(apState != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mpPersistedState   = apState;
+    mPersistedSequence = 0;
+    mPersistedRecord   = 1;
+
+    for (uint8_t i = 0; i < ArraySize(apState->mRecords); i++)
+    {
+        const PersistedEventBufferState::Record & record = apState->mRecords[i];
+        if (IsValidRecord(record) &&
+            (mPersistedSequence == 0 || static_cast<int32_t>(record.mSequence - mPersistedSequence) > 0))
+        {
+            mPersistedSequence = record.mSequence;
+            mPersistedRecord   = i;
+        }
+    }
+
+    CHIP_ERROR err = CHIP_ERROR_NOT_FOUND;
+    if (mPersistedSequence != 0)
+    {
+        const PersistedEventBufferState::Record & record = apState->mRecords[mPersistedRecord];
+        err = SetQueueState(record.mHeadOffset, record.mDataLength);
+    }
+
+    if (err == CHIP_NO_ERROR)
+    {
+        mPersistedHeadOffset = apState->mRecords[mPersistedRecord].mHeadOffset;
+        mPersistedDataLength = apState->mRecords[mPersistedRecord].mDataLength;
+    }
+    else
+    {
+        // Start over with an empty buffer, and record it.
+        SetQueueState(0, 0);
+        mPersistedDataLength = UINT32_MAX;
+        PersistState();
+    }
+    return err;
+}
+
+void CircularEventBuffer::PersistState()
+{
+    VerifyOrReturn(mpPersistedState != nullptr);
+
+    const uint32_t headOffset = static_cast<uint32_t>(QueueHead() - GetQueue());
+    VerifyOrReturn(headOffset != mPersistedHeadOffset || DataLength() != mPersistedDataLength);
+
+    // The events the state covers have to be in memory first. This does not order the writeback of a mapped file.
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Overwrite the older record: the latest one stays valid until this one is complete.
+    mPersistedSequence = (mPersistedSequence == UINT32_MAX) ? 1 : mPersistedSequence + 1;
+    mPersistedRecord   = static_cast<uint8_t>(1 - mPersistedRecord);
+
+    PersistedEventBufferState::Record & record = mpPersistedState->mRecords[mPersistedRecord];
+    record.mSequence                           = mPersistedSequence;
+    record.mHeadOffset                         = headOffset;
+    record.mDataLength                         = DataLength();
+    record.mCheck                              = ComputeRecordCheck(record);
+
+    mPersistedHeadOffset = headOffset;
+    mPersistedDataLength = DataLength();
+}
+
 void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
 {
     CircularEventBuffer * prev;
@@ -898,6 +1378,15 @@ void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
     }
 }
 
+CHIP_ERROR CircularEventReader::SkipTo(uint32_t aOffset)
+{
+    VerifyOrReturnError(aOffset >= mLenRead, CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorOnFailure(ReadData(nullptr, aOffset - mLenRead));
+    // The reader is now between top-level elements: there is no current element to skip.
+    ClearElementState();
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR CircularEventBufferWrapper::GetNextBuffer(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
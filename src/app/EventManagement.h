@@ -28,7 +28,9 @@
 
 #include "EventLoggingDelegate.h"
 #include <access/SubjectDescriptor.h>
+#include <app/EventLogIndex.h>
 #include <app/EventLoggingTypes.h>
+#include <app/EventStagingQueue.h>
 #include <app/MessageDef/EventDataIB.h>
 #include <app/MessageDef/StatusIB.h>
 #include <app/util/basic-types.h>
@@ -76,6 +78,35 @@ inline constexpr size_t kMaxEventSizeReserve            = 512;
 constexpr uint16_t kRequiredEventField =
     (1 << to_underlying(EventDataIB::Tag::kPriority)) | (1 << to_underlying(EventDataIB::Tag::kPath));
 
+/**
+ * @brief
+ *   The head and data length of a CircularEventBuffer, kept next to its
+ *   storage so that the events it holds can be restored after a restart
+ *   (see LogStorageResources::mpPersistedState).
+ *
+ * The state is written to the two records in turn, each with a sequence
+ * number and a check value: a crash while writing one record leaves the
+ * other one, the previous state, to restore from.  The state is written
+ * after the data it covers, and before the space of evicted events is
+ * reused, so either record describes complete events.
+ *
+ * That order only holds in memory, which is what a crash of the process
+ * leaves behind.  Storage that is written back later, such as a mapped file,
+ * may store the record before the data it covers: see MappedEventLogStorage.
+ */
+struct PersistedEventBufferState
+{
+    struct Record
+    {
+        uint32_t mSequence;
+        uint32_t mHeadOffset;
+        uint32_t mDataLength;
+        uint32_t mCheck;
+    };
+
+    Record mRecords[2];
+};
+
 /**
  * @brief
  *   Internal event buffer, built around the TLV::TLVCircularBuffer
@@ -128,6 +159,24 @@ public:
     void SetRequiredSpaceforEvicted(size_t aRequiredSpace) { mRequiredSpaceForEvicted = aRequiredSpace; }
     size_t GetRequiredSpaceforEvicted() const { return mRequiredSpaceForEvicted; }
 
+    /**
+     * @brief
+     *   Keep the head and data length of the buffer in apState from now on,
+     *   restoring them from apState first if it holds a valid state.
+     *
+     * @retval #CHIP_NO_ERROR         The buffer was restored from apState.
+     * @retval #CHIP_ERROR_NOT_FOUND  apState holds no valid state: the buffer is empty.
+     * @retval other                  The state does not fit the buffer: the buffer is empty.
+     */
+    CHIP_ERROR RestoreState(PersistedEventBufferState * apState);
+
+    /**
+     * @brief
+     *   Record the head and data length of the buffer in its persisted state,
+     *   if it has one and they changed.
+     */
+    void PersistState();
+
     ~CircularEventBuffer() override = default;
 
 private:
@@ -139,6 +188,12 @@ private:
 
     size_t mRequiredSpaceForEvicted = 0; ///< Required space for previous buffer to evict event to new buffer
 
+    PersistedEventBufferState * mpPersistedState = nullptr;
+    uint32_t mPersistedSequence                  = 0;
+    uint32_t mPersistedHeadOffset                = 0;
+    uint32_t mPersistedDataLength                = 0;
+    uint8_t mPersistedRecord                     = 1; ///< The latest of the records of mpPersistedState
+
     CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
 };
 
@@ -187,6 +242,9 @@ struct LogStorageResources
     uint32_t mBufferSize = 0; ///< The size, in bytes, of the `mBuffer`.
     PriorityLevel mPriority =
         PriorityLevel::Invalid; // Log priority level associated with the resources provided in this structure.
+    PersistedEventBufferState * mpPersistedState =
+        nullptr; // Optional state of the buffer kept with `mpBuffer` in persistent storage (see MappedEventLogStorage): the
+                 // events it holds are restored on Init, and it is updated as events are logged.
 };
 
 /**
@@ -209,6 +267,11 @@ public:
      * least important events, and the last element corresponds to the most
      * critical events.
      *
+     * When the LogStorageResources have a persisted state, the events left in
+     * their buffers by the previous run are restored.  Their event numbers
+     * must be lower than the value of apEventNumberCounter, as they are with
+     * a persisted counter: otherwise they are dropped.
+     *
      * @param[in] apExchangeManager         ExchangeManager to be used with this logging subsystem
      *
      * @param[in] aNumBuffers  Number of elements in the apLogStorageResources
@@ -304,6 +367,39 @@ public:
      */
     CHIP_ERROR LogEvent(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions, EventNumber & aEventNumber);
 
+#if CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+    /**
+     * @brief
+     *   Queue an event to be logged, from any thread, without the Matter stack lock.
+     *
+     * The event data is encoded right away into a lock-free staging queue, by
+     * `aEncodeData(TLV::TLVWriter &)` with the EventDataIB::Tag::kData tag, and
+     * the event is logged with LogEvent on the Matter thread, where it gets its
+     * event number and timestamp.  Events staged by one thread are logged in
+     * the order they were staged.
+     *
+     * @param[in] aEventOptions The options for the event metadata.
+     *
+     * @param[in] aEncodeData   The function encoding the event data.
+     *
+     * The logging is scheduled even when the event could not be staged, so that the
+     * events staged behind it, or already in a full queue, still get logged.
+     *
+     * @retval #CHIP_ERROR_NO_MEMORY  The staging queue is full.
+     * @retval other                  The error of aEncodeData, e.g. when the event
+     *                                data is larger than CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_SIZE,
+     *                                or of scheduling the logging, in which case the
+     *                                event is logged with the next staged one.
+     */
+    template <typename EncodeFunction>
+    CHIP_ERROR StageEvent(const EventOptions & aEventOptions, EncodeFunction && aEncodeData)
+    {
+        CHIP_ERROR err            = mStagedEvents.Push(aEventOptions, std::forward<EncodeFunction>(aEncodeData));
+        CHIP_ERROR scheduleResult = ScheduleStagedEventsLogging();
+        return (err != CHIP_NO_ERROR) ? err : scheduleResult;
+    }
+#endif // CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+
     /**
      * @brief
      *   A helper method to get tlv reader along with buffer has data from particular priority
@@ -440,6 +536,21 @@ private:
      */
     CHIP_ERROR CopyToNextBuffer(CircularEventBuffer * apEventBuffer);
 
+    /**
+     * @brief
+     *   Check the events restored from the persisted state of the buffers,
+     *   dropping the ones that a crash left incomplete or duplicated, or all
+     *   of them if the event number counter is behind them.
+     */
+    void CheckRestoredEvents();
+
+    /**
+     * @brief
+     *   Trim the events of a restored buffer that do not follow aLastEventNumber,
+     *   the number of the last valid event of the buffers of more critical events.
+     */
+    static CHIP_ERROR CheckRestoredBuffer(CircularEventBuffer & aBuffer, Optional<EventNumber> & aLastEventNumber);
+
     /**
      * @brief Ensure that:
      *
@@ -493,6 +604,17 @@ private:
     static CHIP_ERROR EventIterator(const TLV::TLVReader & aReader, size_t aDepth, EventLoadOutContext * apEventLoadOutContext,
                                     EventEnvelopeContext * event);
 
+    /**
+     * @brief Read the envelope (path, number, priority, timestamp and fabric) of the event aReader is positioned on.
+     */
+    static CHIP_ERROR ReadEventEnvelope(const TLV::TLVReader & aReader, EventEnvelopeContext * event);
+
+    /**
+     * @brief Copy the event aReader is positioned on, which passed CheckEventContext, into the report, rolling the
+     * writer back if it does not fit.
+     */
+    static CHIP_ERROR CopyFoundEvent(const TLV::TLVReader & aReader, EventLoadOutContext * apContext);
+
     /**
      * @brief Internal iterator function used to fetch event into EventEnvelopeContext, then EventIterator would filter event
      * based upon EventEnvelopeContext
@@ -545,6 +667,35 @@ private:
      */
     CircularEventBuffer * GetPriorityBuffer(PriorityLevel aPriority) const;
 
+#if CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+    // Schedule LogStagedEvents on the Matter thread, unless it already is. Safe to call from any thread.
+    CHIP_ERROR ScheduleStagedEventsLogging();
+
+    // Log the events of the staging queue, on the Matter thread.
+    static void LogStagedEvents(intptr_t aEventManagement);
+#endif // CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    /**
+     * @brief Implement #FetchEventsSince with the event log index: only the events that match the interested paths are read
+     * from the log.
+     *
+     * @retval #CHIP_ERROR_INCORRECT_STATE if the index turned out to be out of sync with the log, in which case the index is
+     *          invalidated and the events from aContext.mStartingEventNumber on are still to be fetched.
+     */
+    CHIP_ERROR FetchIndexedEventsSince(EventLoadOutContext & aContext);
+
+    /**
+     * @brief Index the events of the log again, after the index got out of sync with it.
+     */
+    void RebuildIndex();
+
+    static CHIP_ERROR IndexEvent(const TLV::TLVReader & aReader, size_t aDepth, void * apContext);
+
+    // Length of the data held in all the event buffers.
+    uint32_t GetLogLength() const;
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
     // EventBuffer for debug level,
     CircularEventBuffer * mpEventBuffer        = nullptr;
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
@@ -558,6 +709,15 @@ private:
     Timestamp mLastEventTimestamp;    ///< The timestamp of the last event in this buffer
 
     System::Clock::Milliseconds64 mMonotonicStartupTime;
+
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    EventLogIndex mIndex;
+    EventLogIndex::Entry mIndexEntries[CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE];
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
+#if CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+    EventStagingQueue<CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE, CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_SIZE> mStagedEvents;
+#endif // CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
 };
 } // namespace app
 } // namespace chip
@@ -0,0 +1,174 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/EventLoggingTypes.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Span.h>
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/// A bounded queue of encoded events, that any number of threads can add events to without
+/// a lock, and that one thread (the Matter thread) takes them from to log them.
+///
+/// Each slot holds the options of an event and its data, encoded by the producer with the
+/// EventDataIB data tag, in an anonymous structure. A producer claims the next free slot with a compare-and-swap of the
+/// enqueue position, encodes the event into it, then publishes it by advancing the sequence
+/// number of the slot. The consumer takes published slots in order and gives them back by
+/// advancing their sequence number by a lap.
+///
+/// A producer that is preempted between claiming and publishing a slot holds back the events
+/// queued after it, until it publishes: events are logged in the order their slots were claimed.
+template <size_t kCapacity, size_t kMaxDataSize>
+class EventStagingQueue
+{
+public:
+    static_assert(kCapacity > 0, "EventStagingQueue needs at least one slot");
+    static_assert(ATOMIC_LONG_LOCK_FREE, "EventStagingQueue is not lock free");
+
+    EventStagingQueue()
+    {
+        for (size_t i = 0; i < kCapacity; i++)
+        {
+            mSlots[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    EventStagingQueue(const EventStagingQueue &)             = delete;
+    EventStagingQueue & operator=(const EventStagingQueue &) = delete;
+
+    /// Queues an event. May be called from any thread.
+    ///
+    /// aEncodeData(TLV::TLVWriter &) encodes the event data, with the EventDataIB::Tag::kData context tag.
+    ///
+    /// @retval CHIP_ERROR_NO_MEMORY if all the slots are taken.
+    /// @retval the error of aEncodeData, e.g. CHIP_ERROR_BUFFER_TOO_SMALL if the data is larger than kMaxDataSize; the
+    ///         event is not logged.
+    template <typename EncodeFunction>
+    CHIP_ERROR Push(const EventOptions & aOptions, EncodeFunction && aEncodeData)
+    {
+        unsigned long position = mEnqueuePosition.load(std::memory_order_relaxed);
+        Slot * slot;
+        for (;;)
+        {
+            slot                         = &mSlots[position % kCapacity];
+            const unsigned long sequence = slot->mSequence.load(std::memory_order_acquire);
+            const long lag               = static_cast<long>(sequence - position);
+            if (lag == 0)
+            {
+                if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (lag < 0)
+            {
+                // The slot is still held by the previous lap: the queue is full.
+                return CHIP_ERROR_NO_MEMORY;
+            }
+            else
+            {
+                position = mEnqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        TLV::TLVWriter writer;
+        TLV::TLVType containerType;
+        writer.Init(slot->mData, sizeof(slot->mData));
+        CHIP_ERROR err = writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, containerType);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = aEncodeData(writer);
+        }
+        if (err == CHIP_NO_ERROR)
+        {
+            err = writer.EndContainer(containerType);
+        }
+        if (err == CHIP_NO_ERROR)
+        {
+            err = writer.Finalize();
+        }
+
+        // The slot is published even if the encoding failed, as an empty slot for the consumer to skip.
+        slot->mOptions = aOptions;
+        slot->mLength  = (err == CHIP_NO_ERROR) ? static_cast<uint16_t>(writer.GetLengthWritten()) : 0;
+        slot->mSequence.store(position + 1, std::memory_order_release);
+        return err;
+    }
+
+    /// Takes the published events in order, calling aLogEvent(const EventOptions &, ByteSpan aEncodedData) for each,
+    /// where aEncodedData is the anonymous structure holding the event data. Must only be called from the consumer thread.
+    ///
+    /// @return the number of events taken.
+    template <typename LogFunction>
+    size_t Drain(LogFunction && aLogEvent)
+    {
+        size_t count = 0;
+        for (;;)
+        {
+            Slot & slot = mSlots[mDequeuePosition % kCapacity];
+            if (slot.mSequence.load(std::memory_order_acquire) != mDequeuePosition + 1)
+            {
+                // Empty, or claimed but not published yet.
+                return count;
+            }
+
+            if (slot.mLength > 0)
+            {
+                aLogEvent(slot.mOptions, ByteSpan(slot.mData, slot.mLength));
+                count++;
+            }
+            slot.mSequence.store(mDequeuePosition + kCapacity, std::memory_order_release);
+            mDequeuePosition++;
+        }
+    }
+
+    /// Marks that the consumer has to drain the queue. May be called from any thread.
+    ///
+    /// @return whether the drain was not pending yet, in which case the caller is the one to schedule it.
+    bool SetDrainPending() { return !mDrainPending.exchange(true, std::memory_order_acq_rel); }
+
+    /// Called by the consumer before draining the queue, so that events published while it drains
+    /// schedule another drain.
+    void ClearDrainPending() { mDrainPending.store(false, std::memory_order_release); }
+
+private:
+    struct Slot
+    {
+        std::atomic<unsigned long> mSequence{ 0 };
+        EventOptions mOptions;
+        uint16_t mLength = 0;
+        uint8_t mData[kMaxDataSize];
+    };
+
+    static_assert(kMaxDataSize <= UINT16_MAX, "Staged events are too large");
+
+    Slot mSlots[kCapacity];
+    std::atomic<unsigned long> mEnqueuePosition{ 0 };
+    unsigned long mDequeuePosition = 0;
+    std::atomic<bool> mDrainPending{ false };
+};
+
+} // namespace app
+} // namespace chip
@@ -164,6 +164,15 @@ void InteractionModelEngine::Shutdown()
     }
 
     mReportingEngine.Shutdown();
+
+    // Let the data model provider free what it allocated (e.g. the codegen metadata index)
+    // while the platform memory is still initialized.
+    DataModel::Provider * provider = GetDataModelProvider();
+    if (provider != nullptr)
+    {
+        LogErrorOnFailure(provider->Shutdown());
+    }
+
     mAttributePathPool.ReleaseAll();
     mEventPathPool.ReleaseAll();
     mDataVersionFilterPool.ReleaseAll();
@@ -1730,7 +1739,12 @@ DataModel::Provider * InteractionModelEngine::SetDataModelProvider(DataModel::Pr
     VerifyOrDie(mReadHandlers.begin() == mReadHandlers.end());
 
     DataModel::Provider * oldModel = GetDataModelProvider();
-    mDataModelProvider             = model;
+    if ((oldModel != nullptr) && (oldModel != model))
+    {
+        // The replaced provider may have allocated state (e.g. the codegen metadata index) that nothing else would free
+        LogErrorOnFailure(oldModel->Shutdown());
+    }
+    mDataModelProvider = model;
     return oldModel;
 }
 
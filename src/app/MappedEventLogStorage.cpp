@@ -0,0 +1,158 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/MappedEventLogStorage.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemError.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+constexpr uint8_t kMagic[8]     = { 'C', 'H', 'I', 'P', 'E', 'V', 'L', 'G' };
+constexpr uint32_t kVersion     = 1;
+constexpr size_t kDataAlignment = 64;
+
+constexpr size_t AlignUp(size_t aValue)
+{
+    return (aValue + kDataAlignment - 1) / kDataAlignment * kDataAlignment;
+}
+} // namespace
+
+CHIP_ERROR MappedEventLogStorage::Open(const char * apPath, LogStorageResources * apResources, size_t aResourceCount)
+{
+    VerifyOrReturnError(!IsOpen(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(apPath != nullptr && apResources != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aResourceCount > 0 && aResourceCount <= kMaxBufferCount, CHIP_ERROR_INVALID_ARGUMENT);
+
+    size_t size = AlignUp(sizeof(Header));
+    for (size_t i = 0; i < aResourceCount; i++)
+    {
+        VerifyOrReturnError(apResources[i].mBufferSize > 0, CHIP_ERROR_INVALID_ARGUMENT);
+        size += AlignUp(apResources[i].mBufferSize);
+    }
+
+    mFd = open(apPath, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    struct stat status;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    bool formatted = false;
+    VerifyOrExit(fstat(mFd, &status) == 0, err = CHIP_ERROR_POSIX(errno));
+    if (static_cast<size_t>(status.st_size) != size)
+    {
+        // A new file, or one for other buffers: start over from an empty log.
+        VerifyOrExit(ftruncate(mFd, 0) == 0 && ftruncate(mFd, static_cast<off_t>(size)) == 0, err = CHIP_ERROR_POSIX(errno));
+        formatted = true;
+    }
+
+    {
+        void * mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+        VerifyOrExit(mapping != MAP_FAILED, err = CHIP_ERROR_POSIX(errno));
+        mpMapping    = static_cast<uint8_t *>(mapping);
+        mMappingSize = size;
+    }
+
+    if (formatted || !IsHeaderValid(apResources, aResourceCount))
+    {
+        ChipLogProgress(EventLogging, "Creating the event log in %s", apPath);
+        SuccessOrExit(err = Format(apResources, aResourceCount));
+    }
+
+    {
+        Header * header = reinterpret_cast<Header *>(mpMapping);
+        uint8_t * data  = mpMapping + AlignUp(sizeof(Header));
+        for (size_t i = 0; i < aResourceCount; i++)
+        {
+            apResources[i].mpBuffer         = data;
+            apResources[i].mpPersistedState = &header->mStates[i];
+            data += AlignUp(apResources[i].mBufferSize);
+        }
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(EventLogging, "Failed to open the event log in %s: %" CHIP_ERROR_FORMAT, apPath, err.Format());
+        Close();
+    }
+    return err;
+}
+
+bool MappedEventLogStorage::IsHeaderValid(const LogStorageResources * apResources, size_t aResourceCount) const
+{
+    const Header * header = reinterpret_cast<const Header *>(mpMapping);
+    VerifyOrReturnValue(memcmp(header->mMagic, kMagic, sizeof(kMagic)) == 0, false);
+    VerifyOrReturnValue(header->mVersion == kVersion && header->mBufferCount == aResourceCount, false);
+    for (size_t i = 0; i < aResourceCount; i++)
+    {
+        VerifyOrReturnValue(header->mBufferSizes[i] == apResources[i].mBufferSize, false);
+    }
+    return true;
+}
+
+CHIP_ERROR MappedEventLogStorage::Format(const LogStorageResources * apResources, size_t aResourceCount)
+{
+    Header * header = reinterpret_cast<Header *>(mpMapping);
+
+    // Write the layout before the magic number that makes it valid, so that a crash leaves the file to format again.
+    memset(header, 0, sizeof(Header));
+    header->mVersion     = kVersion;
+    header->mBufferCount = static_cast<uint32_t>(aResourceCount);
+    for (size_t i = 0; i < aResourceCount; i++)
+    {
+        header->mBufferSizes[i] = apResources[i].mBufferSize;
+    }
+    VerifyOrReturnError(msync(mpMapping, sizeof(Header), MS_SYNC) == 0, CHIP_ERROR_POSIX(errno));
+
+    memcpy(header->mMagic, kMagic, sizeof(kMagic));
+    return Sync();
+}
+
+CHIP_ERROR MappedEventLogStorage::Sync()
+{
+    VerifyOrReturnError(IsOpen(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(msync(mpMapping, mMappingSize, MS_SYNC) == 0, CHIP_ERROR_POSIX(errno));
+    return CHIP_NO_ERROR;
+}
+
+void MappedEventLogStorage::Close()
+{
+    if (mpMapping != nullptr)
+    {
+        munmap(mpMapping, mMappingSize);
+        mpMapping    = nullptr;
+        mMappingSize = 0;
+    }
+    if (mFd >= 0)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+}
+
+} // namespace app
+} // namespace chip
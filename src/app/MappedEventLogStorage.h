@@ -0,0 +1,95 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/EventManagement.h>
+#include <lib/core/CHIPError.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/// Storage of the event log of EventManagement in a memory-mapped file, so that the events survive a
+/// restart of the device, and the log can be larger than the RAM the device can spare for it.
+///
+/// Open maps the file and points the buffers and persisted states of the LogStorageResources given to
+/// it into the mapping, for EventManagement::CreateEventManagement to restore the events left there by
+/// the previous run:
+///
+///     LogStorageResources resources[] = {
+///         { nullptr, 1024 * 1024, PriorityLevel::Debug },
+///         { nullptr, 1024 * 1024, PriorityLevel::Info },
+///         { nullptr, 256 * 1024, PriorityLevel::Critical },
+///     };
+///     ReturnErrorOnFailure(storage.Open("/var/lib/chip/events", resources, ArraySize(resources)));
+///     EventManagement::CreateEventManagement(&exchangeManager, ArraySize(resources), buffers, resources, &eventCounter);
+///
+/// The event number counter (eventCounter) has to be persisted too, so that new events get numbers above the restored
+/// ones. The file is in the byte order of the device.
+///
+/// The file is written through the page cache, so the log is only crash-safe against crashes of the process:
+/// the kernel still holds everything the process wrote. A power loss (or a crash of the kernel) keeps only
+/// the pages that were written back, which the kernel does in any order. A persisted state may then be stored
+/// without the events it covers, or over events that were since evicted; EventManagement drops the events it
+/// finds torn, but may restore stale ones. Only the log as of the last Sync is safe from a power loss.
+class MappedEventLogStorage
+{
+public:
+    /// Largest number of buffers (of LogStorageResources) in a file.
+    static constexpr size_t kMaxBufferCount = 4;
+
+    MappedEventLogStorage() = default;
+    ~MappedEventLogStorage() { Close(); }
+
+    MappedEventLogStorage(const MappedEventLogStorage &)             = delete;
+    MappedEventLogStorage & operator=(const MappedEventLogStorage &) = delete;
+
+    /// Maps the file at apPath, creating it if needed, and sets the mpBuffer and mpPersistedState of
+    /// the aResourceCount entries of apResources, whose mBufferSize and mPriority are set by the caller.
+    /// The file is emptied if it was created for other buffer sizes.
+    CHIP_ERROR Open(const char * apPath, LogStorageResources * apResources, size_t aResourceCount);
+
+    /// Writes the log back to the file and waits for it to be stored.
+    CHIP_ERROR Sync();
+
+    /// Unmaps the file. EventManagement must not use the buffers anymore.
+    void Close();
+
+    bool IsOpen() const { return mpMapping != nullptr; }
+
+private:
+    struct Header
+    {
+        uint8_t mMagic[8];
+        uint32_t mVersion;
+        uint32_t mBufferCount;
+        uint32_t mBufferSizes[kMaxBufferCount];
+        PersistedEventBufferState mStates[kMaxBufferCount];
+    };
+
+    bool IsHeaderValid(const LogStorageResources * apResources, size_t aResourceCount) const;
+    CHIP_ERROR Format(const LogStorageResources * apResources, size_t aResourceCount);
+
+    int mFd             = -1;
+    uint8_t * mpMapping = nullptr;
+    size_t mMappingSize = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -133,6 +133,12 @@ void ReadHandler::OnSubscriptionResumed(const SessionHandle & sessionHandle,
     // Notify the observer that a subscription has been resumed
     mObserver->OnSubscriptionEstablished(this);
 
+    if (mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().RegisterAttributeInterest(*this) != CHIP_NO_ERROR)
+    {
+        Close();
+        return;
+    }
+
     MoveToState(HandlerState::CanStartReporting);
 
     SingleLinkedListNode<AttributePathParams> * attributePath = mpAttributePathList;
@@ -159,6 +165,7 @@ ReadHandler::~ReadHandler()
     {
         mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm();
     }
+    mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().UnregisterAttributeInterest(*this);
     mManagementCallback.GetInteractionModelEngine()->ReleaseAttributePathList(mpAttributePathList);
     mManagementCallback.GetInteractionModelEngine()->ReleaseEventPathList(mpEventPathList);
     mManagementCallback.GetInteractionModelEngine()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
@@ -511,7 +518,7 @@ CHIP_ERROR ReadHandler::ProcessAttributePaths(AttributePathIBs::Parser & aAttrib
     {
         mManagementCallback.GetInteractionModelEngine()->RemoveDuplicateConcreteAttributePath(mpAttributePathList);
         mAttributePathExpandIterator.ResetTo(mpAttributePathList);
-        err = CHIP_NO_ERROR;
+        err = mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().RegisterAttributeInterest(*this);
     }
     return err;
 }
@@ -622,6 +629,13 @@ void ReadHandler::MoveToState(const HandlerState aTargetState)
         mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().OnReportConfirm();
     }
 
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+    if (aTargetState != HandlerState::CanStartReporting)
+    {
+        mReportableSince = System::Clock::kZero;
+    }
+#endif // CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+
     mState = aTargetState;
     ChipLogDetail(DataManagement, "IM RH moving to [%s]", GetStateStr());
 
@@ -633,6 +647,12 @@ void ReadHandler::MoveToState(const HandlerState aTargetState)
     {
         if (ShouldReportUnscheduled())
         {
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+            if (mReportableSince == System::Clock::kZero)
+            {
+                mReportableSince = System::SystemClock().GetMonotonicMicroseconds64();
+            }
+#endif // CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
             mManagementCallback.GetInteractionModelEngine()->GetReportingEngine().ScheduleRun();
         }
         else
@@ -569,6 +569,15 @@ private:
 
     uint32_t mLastWrittenEventsBytes = 0;
 
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+    // The state of the fair report scheduling of the reporting engine: the virtual time at which the last report of this
+    // handler finished, the run of the engine that last served it, and since when it is reportable, set when it becomes
+    // reportable (by the report scheduler, or right away for the handlers reporting unscheduled) and cleared when it stops.
+    uint64_t mReportFinishTag                      = 0;
+    uint32_t mReportRunGeneration                  = 0;
+    System::Clock::Microseconds64 mReportableSince = System::Clock::kZero;
+#endif
+
     // The detailed encoding state for a single attribute, used by list chunking feature.
     // The size of AttributeEncoderState is 2 bytes for now.
     AttributeEncodeState mAttributeEncoderState;
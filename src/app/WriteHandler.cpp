@@ -18,6 +18,7 @@
 
 #include <app/AppConfig.h>
 #include <app/AttributeAccessInterfaceRegistry.h>
+#include <app/AttributePersistenceProvider.h>
 #include <app/InteractionModelEngine.h>
 #include <app/MessageDef/EventPathIB.h>
 #include <app/MessageDef/StatusIB.h>
@@ -66,6 +67,24 @@ void WriteHandler::Close()
     MoveToState(State::Uninitialized);
 }
 
+void WriteHandler::StartWriteBatch()
+{
+    AttributePersistenceProvider * provider = GetAttributePersistenceProvider();
+    VerifyOrReturn(provider != nullptr);
+    provider->StartWriteBatch();
+}
+
+void WriteHandler::EndWriteBatch()
+{
+    AttributePersistenceProvider * provider = GetAttributePersistenceProvider();
+    VerifyOrReturn(provider != nullptr);
+    CHIP_ERROR err = provider->EndWriteBatch();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to store the written attribute values: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
 Status WriteHandler::HandleWriteRequestMessage(Messaging::ExchangeContext * apExchangeContext,
                                                System::PacketBufferHandle && aPayload, bool aIsTimedWrite)
 {
@@ -79,7 +98,13 @@ Status WriteHandler::HandleWriteRequestMessage(Messaging::ExchangeContext * apEx
     mWriteResponseBuilder.CreateWriteResponses();
     VerifyOrReturnError(mWriteResponseBuilder.GetError() == CHIP_NO_ERROR, Status::Failure);
 
+    // The values written by the message are stored together, and each path written is marked dirty once, after the whole
+    // message is processed. The batches do not outlive the message: nothing else is written on the node meanwhile.
+    InteractionModelEngine::GetInstance()->GetReportingEngine().StartDirtyPathBatch();
+    StartWriteBatch();
     Status status = ProcessWriteRequest(std::move(aPayload), aIsTimedWrite);
+    EndWriteBatch();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().EndDirtyPathBatch();
 
     // Do not send response on Group Write
     if (status == Status::Success && !apExchangeContext->IsGroupExchangeContext())
@@ -16,8 +16,7 @@
  */
 #include <app/codegen-data-model-provider/CodegenDataModelProvider.h>
 
-#include <app-common/zap-generated/attribute-type.h>
-#include <app/RequiredPrivilege.h>
+#include <app/codegen-data-model-provider/EmberMetadata.h>
 #include <app/util/IMClusterCommandHandler.h>
 #include <app/util/attribute-storage.h>
 #include <app/util/endpoint-config-api.h>
@@ -108,39 +107,12 @@ DataModel::ClusterEntry FirstServerClusterEntry(EndpointId endpointId, const Emb
     return DataModel::ClusterEntry::kInvalid;
 }
 
-/// Load the attribute information into the specified destination
-///
-/// `info` is assumed to be default-constructed/clear (i.e. this sets flags, but does not reset them).
-void LoadAttributeInfo(const ConcreteAttributePath & path, const EmberAfAttributeMetadata & attribute,
-                       DataModel::AttributeInfo * info)
-{
-    info->readPrivilege = RequiredPrivilege::ForReadAttribute(path);
-    if (!attribute.IsReadOnly())
-    {
-        info->writePrivilege = RequiredPrivilege::ForWriteAttribute(path);
-    }
-
-    info->flags.Set(DataModel::AttributeQualityFlags::kListAttribute, (attribute.attributeType == ZCL_ARRAY_ATTRIBUTE_TYPE));
-    info->flags.Set(DataModel::AttributeQualityFlags::kTimed, attribute.MustUseTimedWrite());
-
-    // NOTE: we do NOT provide additional info for:
-    //    - IsExternal/IsSingleton/IsAutomaticallyPersisted is not used by IM handling
-    //    - IsSingleton spec defines it for CLUSTERS where as we have it for ATTRIBUTES
-    //    - Several specification flags are not available (reportable, quieter reporting,
-    //      fixed, source attribution)
-
-    // TODO: Set additional flags:
-    // info->flags.Set(DataModel::AttributeQualityFlags::kFabricScoped)
-    // info->flags.Set(DataModel::AttributeQualityFlags::kFabricSensitive)
-    // info->flags.Set(DataModel::AttributeQualityFlags::kChangesOmitted)
-}
-
 DataModel::AttributeEntry AttributeEntryFrom(const ConcreteClusterPath & clusterPath, const EmberAfAttributeMetadata & attribute)
 {
     DataModel::AttributeEntry entry;
 
     entry.path = ConcreteAttributePath(clusterPath.mEndpointId, clusterPath.mClusterId, attribute.attributeId);
-    LoadAttributeInfo(entry.path, attribute, &entry.info);
+    Ember::LoadAttributeInfo(entry.path, attribute, &entry.info);
 
     return entry;
 }
@@ -148,19 +120,27 @@ DataModel::AttributeEntry AttributeEntryFrom(const ConcreteClusterPath & cluster
 DataModel::CommandEntry CommandEntryFrom(const ConcreteClusterPath & clusterPath, CommandId clusterCommandId)
 {
     DataModel::CommandEntry entry;
-    entry.path                 = ConcreteCommandPath(clusterPath.mEndpointId, clusterPath.mClusterId, clusterCommandId);
-    entry.info.invokePrivilege = RequiredPrivilege::ForInvokeCommand(entry.path);
-
-    entry.info.flags.Set(DataModel::CommandQualityFlags::kTimed, CommandNeedsTimedInvoke(clusterPath.mClusterId, clusterCommandId));
-
-    entry.info.flags.Set(DataModel::CommandQualityFlags::kFabricScoped,
-                         CommandIsFabricScoped(clusterPath.mClusterId, clusterCommandId));
-
+    entry.path = ConcreteCommandPath(clusterPath.mEndpointId, clusterPath.mClusterId, clusterCommandId);
+    entry.info = Ember::LoadAcceptedCommandInfo(entry.path);
     return entry;
 }
 
 const ConcreteCommandPath kInvalidCommandPath(kInvalidEndpointId, kInvalidClusterId, kInvalidCommandId);
 
+/// Returns the index of the first enabled endpoint at or after start_index, if any
+std::optional<uint16_t> FirstEnabledEndpointIndex(unsigned start_index)
+{
+    const uint16_t lastEndpointIndex = emberAfEndpointCount();
+    for (unsigned endpoint_idx = start_index; endpoint_idx < lastEndpointIndex; endpoint_idx++)
+    {
+        if (emberAfEndpointIndexIsEnabled(static_cast<uint16_t>(endpoint_idx)))
+        {
+            return std::make_optional(static_cast<uint16_t>(endpoint_idx));
+        }
+    }
+    return std::nullopt;
+}
+
 } // namespace
 
 std::optional<CommandId> CodegenDataModelProvider::EmberCommandListIterator::First(const CommandId * list)
@@ -229,6 +209,15 @@ bool CodegenDataModelProvider::EmberCommandListIterator::Exists(const CommandId
     return (*mCurrentHint == toCheck);
 }
 
+CHIP_ERROR CodegenDataModelProvider::Shutdown()
+{
+#if CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+    mMetadataIndex.Clear();
+    mMetadataIndexFailedGeneration.reset();
+#endif // CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+    return CHIP_NO_ERROR;
+}
+
 DataModel::ActionReturnStatus CodegenDataModelProvider::Invoke(const DataModel::InvokeRequest & request,
                                                                TLV::TLVReader & input_arguments, CommandHandler * handler)
 {
@@ -366,6 +355,20 @@ DataModel::ClusterEntry CodegenDataModelProvider::NextCluster(const ConcreteClus
 
 std::optional<DataModel::ClusterInfo> CodegenDataModelProvider::GetClusterInfo(const ConcreteClusterPath & path)
 {
+#if CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+    if (const Ember::EmberMetadataIndex * index = MetadataIndex())
+    {
+        std::optional<Ember::EmberMetadataIndex::Slot> cluster = index->FindServerCluster(path);
+        VerifyOrReturnValue(cluster.has_value(), std::nullopt);
+
+        // A missing data version is reported by LoadClusterInfo below
+        if (DataVersion * version = index->GetDataVersion(*cluster); version != nullptr)
+        {
+            return std::make_optional<DataModel::ClusterInfo>(*version);
+        }
+    }
+#endif // CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+
     const EmberAfCluster * cluster = FindServerCluster(path);
 
     VerifyOrReturnValue(cluster != nullptr, std::nullopt);
@@ -428,7 +431,19 @@ const EmberAfCluster * CodegenDataModelProvider::FindServerCluster(const Concret
         return mPreviouslyFoundCluster->cluster;
     }
 
-    const EmberAfCluster * cluster = emberAfFindServerCluster(path.mEndpointId, path.mClusterId);
+    const EmberAfCluster * cluster = nullptr;
+#if CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+    if (const Ember::EmberMetadataIndex * index = MetadataIndex())
+    {
+        std::optional<Ember::EmberMetadataIndex::Slot> slot = index->FindServerCluster(path);
+        cluster = slot.has_value() ? index->GetCluster(*slot) : nullptr;
+    }
+    else
+#endif // CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+    {
+        cluster = emberAfFindServerCluster(path.mEndpointId, path.mClusterId);
+    }
+
     if (cluster != nullptr)
     {
         mPreviouslyFoundCluster = std::make_optional<ClusterReference>(path, cluster);
@@ -461,8 +476,182 @@ DataModel::AttributeEntry CodegenDataModelProvider::NextAttribute(const Concrete
     return DataModel::AttributeEntry::kInvalid;
 }
 
+std::optional<unsigned> CodegenDataModelProvider::TryFindEndpointIndex(EndpointId id, DataModel::MetadataCursor & cursor) const
+{
+    if ((cursor.endpointIndex < emberAfEndpointCount()) &&
+        emberAfEndpointIndexIsEnabled(static_cast<uint16_t>(cursor.endpointIndex)) &&
+        (id == emberAfEndpointFromIndex(static_cast<uint16_t>(cursor.endpointIndex))))
+    {
+        return std::make_optional<unsigned>(cursor.endpointIndex);
+    }
+
+    std::optional<unsigned> endpoint_idx = TryFindEndpointIndex(id);
+    cursor                               = DataModel::MetadataCursor();
+    if (endpoint_idx.has_value())
+    {
+        cursor.endpointIndex = *endpoint_idx;
+    }
+    return endpoint_idx;
+}
+
+const EmberAfEndpointType * CodegenDataModelProvider::FindEndpointType(EndpointId id, DataModel::MetadataCursor & cursor) const
+{
+    // emberAfEndpointTypeFromIndex checks the index is valid and enabled, leaving only the id to check
+    if (cursor.endpointIndex < kEmberInvalidEndpointIndex)
+    {
+        const EmberAfEndpointType * endpoint = emberAfEndpointTypeFromIndex(static_cast<uint16_t>(cursor.endpointIndex));
+        if ((endpoint != nullptr) && (emberAfEndpointFromIndex(static_cast<uint16_t>(cursor.endpointIndex)) == id))
+        {
+            return endpoint;
+        }
+    }
+
+    std::optional<unsigned> endpoint_idx = TryFindEndpointIndex(id, cursor);
+    VerifyOrReturnValue(endpoint_idx.has_value(), nullptr);
+
+    return emberAfEndpointTypeFromIndex(static_cast<uint16_t>(*endpoint_idx));
+}
+
+const EmberAfCluster * CodegenDataModelProvider::FindServerCluster(const ConcreteClusterPath & path,
+                                                                   DataModel::MetadataCursor & cursor) const
+{
+    const EmberAfEndpointType * endpoint = FindEndpointType(path.mEndpointId, cursor);
+    VerifyOrReturnValue(endpoint != nullptr, nullptr);
+    VerifyOrReturnValue(endpoint->cluster != nullptr, nullptr);
+
+    if (cursor.clusterIndex < endpoint->clusterCount)
+    {
+        const EmberAfCluster & cluster = endpoint->cluster[cursor.clusterIndex];
+        if (cluster.IsServer() && (cluster.clusterId == path.mClusterId))
+        {
+            return &cluster;
+        }
+    }
+
+    std::optional<unsigned> cluster_idx = TryFindServerClusterIndex(endpoint, path.mClusterId);
+    cursor.clusterIndex                 = DataModel::MetadataCursor::kUnknownIndex;
+    cursor.attributeIndex               = DataModel::MetadataCursor::kUnknownIndex;
+    VerifyOrReturnValue(cluster_idx.has_value(), nullptr);
+
+    cursor.clusterIndex = *cluster_idx;
+    return &endpoint->cluster[*cluster_idx];
+}
+
+EndpointId CodegenDataModelProvider::FirstEndpointWithCursor(DataModel::MetadataCursor & cursor)
+{
+    cursor = DataModel::MetadataCursor();
+
+    std::optional<uint16_t> endpoint_idx = FirstEnabledEndpointIndex(0);
+    VerifyOrReturnValue(endpoint_idx.has_value(), kInvalidEndpointId);
+
+    cursor.endpointIndex = *endpoint_idx;
+    return emberAfEndpointFromIndex(*endpoint_idx);
+}
+
+EndpointId CodegenDataModelProvider::NextEndpointWithCursor(EndpointId before, DataModel::MetadataCursor & cursor)
+{
+    std::optional<unsigned> before_idx = TryFindEndpointIndex(before, cursor);
+    VerifyOrReturnValue(before_idx.has_value(), kInvalidEndpointId);
+
+    cursor                               = DataModel::MetadataCursor();
+    std::optional<uint16_t> endpoint_idx = FirstEnabledEndpointIndex(*before_idx + 1);
+    VerifyOrReturnValue(endpoint_idx.has_value(), kInvalidEndpointId);
+
+    cursor.endpointIndex = *endpoint_idx;
+    return emberAfEndpointFromIndex(*endpoint_idx);
+}
+
+DataModel::ClusterEntry CodegenDataModelProvider::FirstClusterWithCursor(EndpointId endpointId, DataModel::MetadataCursor & cursor)
+{
+    const EmberAfEndpointType * endpoint = FindEndpointType(endpointId, cursor);
+    VerifyOrReturnValue(endpoint != nullptr, DataModel::ClusterEntry::kInvalid);
+    VerifyOrReturnValue(endpoint->clusterCount > 0, DataModel::ClusterEntry::kInvalid);
+    VerifyOrReturnValue(endpoint->cluster != nullptr, DataModel::ClusterEntry::kInvalid);
+
+    unsigned cluster_idx  = 0;
+    auto entry            = FirstServerClusterEntry(endpointId, endpoint, 0, cluster_idx);
+    cursor.clusterIndex   = entry.IsValid() ? cluster_idx : DataModel::MetadataCursor::kUnknownIndex;
+    cursor.attributeIndex = DataModel::MetadataCursor::kUnknownIndex;
+    return entry;
+}
+
+DataModel::ClusterEntry CodegenDataModelProvider::NextClusterWithCursor(const ConcreteClusterPath & before,
+                                                                        DataModel::MetadataCursor & cursor)
+{
+    const EmberAfCluster * cluster = FindServerCluster(before, cursor);
+    VerifyOrReturnValue(cluster != nullptr, DataModel::ClusterEntry::kInvalid);
+
+    // FindServerCluster succeeding means the cursor points at the endpoint and `before`
+    const EmberAfEndpointType * endpoint = emberAfEndpointTypeFromIndex(static_cast<uint16_t>(cursor.endpointIndex));
+
+    unsigned cluster_idx  = 0;
+    auto entry            = FirstServerClusterEntry(before.mEndpointId, endpoint, cursor.clusterIndex + 1, cluster_idx);
+    cursor.clusterIndex   = entry.IsValid() ? cluster_idx : DataModel::MetadataCursor::kUnknownIndex;
+    cursor.attributeIndex = DataModel::MetadataCursor::kUnknownIndex;
+    return entry;
+}
+
+DataModel::AttributeEntry CodegenDataModelProvider::FirstAttributeWithCursor(const ConcreteClusterPath & path,
+                                                                             DataModel::MetadataCursor & cursor)
+{
+    const EmberAfCluster * cluster = FindServerCluster(path, cursor);
+
+    VerifyOrReturnValue(cluster != nullptr, DataModel::AttributeEntry::kInvalid);
+    VerifyOrReturnValue(cluster->attributeCount > 0, DataModel::AttributeEntry::kInvalid);
+    VerifyOrReturnValue(cluster->attributes != nullptr, DataModel::AttributeEntry::kInvalid);
+
+    cursor.attributeIndex = 0;
+    return AttributeEntryFrom(path, cluster->attributes[0]);
+}
+
+DataModel::AttributeEntry CodegenDataModelProvider::NextAttributeWithCursor(const ConcreteAttributePath & before,
+                                                                            DataModel::MetadataCursor & cursor)
+{
+    const EmberAfCluster * cluster = FindServerCluster(before, cursor);
+    VerifyOrReturnValue(cluster != nullptr, DataModel::AttributeEntry::kInvalid);
+    VerifyOrReturnValue(cluster->attributeCount > 0, DataModel::AttributeEntry::kInvalid);
+    VerifyOrReturnValue(cluster->attributes != nullptr, DataModel::AttributeEntry::kInvalid);
+
+    std::optional<unsigned> attribute_idx;
+    if ((cursor.attributeIndex < cluster->attributeCount) &&
+        (cluster->attributes[cursor.attributeIndex].attributeId == before.mAttributeId))
+    {
+        attribute_idx = std::make_optional<unsigned>(cursor.attributeIndex);
+    }
+    else
+    {
+        attribute_idx = TryFindAttributeIndex(cluster, before.mAttributeId);
+    }
+
+    cursor.attributeIndex = DataModel::MetadataCursor::kUnknownIndex;
+    VerifyOrReturnValue(attribute_idx.has_value(), DataModel::AttributeEntry::kInvalid);
+
+    unsigned next_idx = *attribute_idx + 1;
+    if (next_idx < cluster->attributeCount)
+    {
+        cursor.attributeIndex = next_idx;
+        return AttributeEntryFrom(before, cluster->attributes[next_idx]);
+    }
+
+    // iteration complete
+    return DataModel::AttributeEntry::kInvalid;
+}
+
 std::optional<DataModel::AttributeInfo> CodegenDataModelProvider::GetAttributeInfo(const ConcreteAttributePath & path)
 {
+#if CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+    if (const Ember::EmberMetadataIndex * index = MetadataIndex())
+    {
+        std::optional<Ember::EmberMetadataIndex::Slot> cluster = index->FindServerCluster(path);
+        VerifyOrReturnValue(cluster.has_value(), std::nullopt);
+
+        std::optional<Ember::EmberMetadataIndex::Slot> attribute = index->FindAttribute(*cluster, path.mAttributeId);
+        VerifyOrReturnValue(attribute.has_value(), std::nullopt);
+
+        return std::make_optional(index->GetAttributeInfo(*attribute));
+    }
+#endif // CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+
     const EmberAfCluster * cluster = FindServerCluster(path);
 
     VerifyOrReturnValue(cluster != nullptr, std::nullopt);
@@ -477,7 +666,7 @@ std::optional<DataModel::AttributeInfo> CodegenDataModelProvider::GetAttributeIn
     }
 
     DataModel::AttributeInfo info;
-    LoadAttributeInfo(path, cluster->attributes[*attribute_idx], &info);
+    Ember::LoadAttributeInfo(path, cluster->attributes[*attribute_idx], &info);
     return std::make_optional(info);
 }
 
@@ -507,6 +696,19 @@ DataModel::CommandEntry CodegenDataModelProvider::NextAcceptedCommand(const Conc
 
 std::optional<DataModel::CommandInfo> CodegenDataModelProvider::GetAcceptedCommandInfo(const ConcreteCommandPath & path)
 {
+#if CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+    if (const Ember::EmberMetadataIndex * index = MetadataIndex())
+    {
+        std::optional<Ember::EmberMetadataIndex::Slot> cluster = index->FindServerCluster(path);
+        VerifyOrReturnValue(cluster.has_value(), std::nullopt);
+
+        std::optional<Ember::EmberMetadataIndex::Slot> command = index->FindAcceptedCommand(*cluster, path.mCommandId);
+        VerifyOrReturnValue(command.has_value(), std::nullopt);
+
+        return std::make_optional(index->GetAcceptedCommandInfo(*command));
+    }
+#endif // CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+
     const EmberAfCluster * cluster = FindServerCluster(path);
 
     VerifyOrReturnValue(cluster != nullptr, std::nullopt);
@@ -538,5 +740,45 @@ ConcreteCommandPath CodegenDataModelProvider::NextGeneratedCommand(const Concret
     return ConcreteCommandPath(before.mEndpointId, before.mClusterId, *commandId);
 }
 
+std::variant<const EmberAfCluster *, const EmberAfAttributeMetadata *, Protocols::InteractionModel::Status>
+CodegenDataModelProvider::FindAttributeMetadata(const ConcreteAttributePath & path)
+{
+#if CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+    if (const Ember::EmberMetadataIndex * index = MetadataIndex())
+    {
+        return index->FindAttributeMetadata(path);
+    }
+#endif // CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+
+    return Ember::FindAttributeMetadata(path);
+}
+
+#if CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+const Ember::EmberMetadataIndex * CodegenDataModelProvider::MetadataIndex()
+{
+    if (mMetadataIndex.IsCurrent())
+    {
+        return &mMetadataIndex;
+    }
+
+    const uint32_t generation = emberAfEndpointConfigurationGeneration();
+    VerifyOrReturnValue(mMetadataIndexFailedGeneration != generation, nullptr);
+
+    // Cluster pointers remembered from the previous configuration may be gone
+    mPreviouslyFoundCluster.reset();
+
+    CHIP_ERROR err = mMetadataIndex.Build();
+    if (err != CHIP_NO_ERROR)
+    {
+        // Lookups still work without the index, only slower
+        ChipLogError(AppServer, "Failed to build the data model metadata index: %" CHIP_ERROR_FORMAT, err.Format());
+        mMetadataIndexFailedGeneration = generation;
+        return nullptr;
+    }
+    mMetadataIndexFailedGeneration.reset();
+    return &mMetadataIndex;
+}
+#endif // CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+
 } // namespace app
 } // namespace chip
@@ -20,6 +20,15 @@
 #include <app/data-model-provider/Provider.h>
 
 #include <app/util/af-types.h>
+#include <lib/core/CHIPConfig.h>
+#include <protocols/interaction_model/StatusCode.h>
+
+#if CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+#include <app/codegen-data-model-provider/EmberMetadataIndex.h>
+#endif // CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+
+#include <optional>
+#include <variant>
 
 namespace chip {
 namespace app {
@@ -67,7 +76,7 @@ private:
 
 public:
     /// Generic model implementations
-    CHIP_ERROR Shutdown() override { return CHIP_NO_ERROR; }
+    CHIP_ERROR Shutdown() override;
 
     DataModel::ActionReturnStatus ReadAttribute(const DataModel::ReadAttributeRequest & request,
                                                 AttributeValueEncoder & encoder) override;
@@ -88,6 +97,16 @@ public:
     DataModel::AttributeEntry NextAttribute(const ConcreteAttributePath & before) override;
     std::optional<DataModel::AttributeInfo> GetAttributeInfo(const ConcreteAttributePath & path) override;
 
+    /// attribute tree iteration from a cursor, which holds ember endpoint/cluster/attribute indexes
+    EndpointId FirstEndpointWithCursor(DataModel::MetadataCursor & cursor) override;
+    EndpointId NextEndpointWithCursor(EndpointId before, DataModel::MetadataCursor & cursor) override;
+    DataModel::ClusterEntry FirstClusterWithCursor(EndpointId endpoint, DataModel::MetadataCursor & cursor) override;
+    DataModel::ClusterEntry NextClusterWithCursor(const ConcreteClusterPath & before, DataModel::MetadataCursor & cursor) override;
+    DataModel::AttributeEntry FirstAttributeWithCursor(const ConcreteClusterPath & cluster,
+                                                       DataModel::MetadataCursor & cursor) override;
+    DataModel::AttributeEntry NextAttributeWithCursor(const ConcreteAttributePath & before,
+                                                      DataModel::MetadataCursor & cursor) override;
+
     DataModel::CommandEntry FirstAcceptedCommand(const ConcreteClusterPath & cluster) override;
     DataModel::CommandEntry NextAcceptedCommand(const ConcreteCommandPath & before) override;
     std::optional<DataModel::CommandInfo> GetAcceptedCommandInfo(const ConcreteCommandPath & path) override;
@@ -128,6 +147,28 @@ private:
 
     /// Find the index of the given endpoint id
     std::optional<unsigned> TryFindEndpointIndex(chip::EndpointId id) const;
+
+    /// Cursor based lookups: use the cursor indexes if they point at the given ids and
+    /// search (then update the cursor) otherwise.
+    std::optional<unsigned> TryFindEndpointIndex(chip::EndpointId id, DataModel::MetadataCursor & cursor) const;
+    const EmberAfEndpointType * FindEndpointType(chip::EndpointId id, DataModel::MetadataCursor & cursor) const;
+    const EmberAfCluster * FindServerCluster(const ConcreteClusterPath & path, DataModel::MetadataCursor & cursor) const;
+
+    /// Same as `Ember::FindAttributeMetadata`, using the metadata index if it is enabled
+    std::variant<const EmberAfCluster *, const EmberAfAttributeMetadata *, Protocols::InteractionModel::Status>
+    FindAttributeMetadata(const ConcreteAttributePath & path);
+
+#if CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+    Ember::EmberMetadataIndex mMetadataIndex;
+
+    /// Configuration generation for which building the index failed: it is not built again
+    /// (and the failure not logged again) until the configuration changes.
+    std::optional<uint32_t> mMetadataIndexFailedGeneration;
+
+    /// Returns the metadata index, built again first if the ember configuration changed
+    /// since it was last built, or nullptr if it cannot be built.
+    const Ember::EmberMetadataIndex * MetadataIndex();
+#endif // CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
 };
 
 } // namespace app
@@ -295,7 +295,7 @@ DataModel::ActionReturnStatus CodegenDataModelProvider::ReadAttribute(const Data
         }
     }
 
-    auto metadata = Ember::FindAttributeMetadata(request.path);
+    auto metadata = FindAttributeMetadata(request.path);
 
     // Explicit failure in finding a suitable metadata
     if (const Status * status = std::get_if<Status>(&metadata))
@@ -16,7 +16,10 @@
  */
 #include <app/codegen-data-model-provider/EmberMetadata.h>
 
+#include <app-common/zap-generated/attribute-type.h>
+#include <app-common/zap-generated/cluster-objects.h>
 #include <app/GlobalAttributes.h>
+#include <app/RequiredPrivilege.h>
 #include <app/util/attribute-storage.h>
 #include <app/util/endpoint-config-api.h>
 
@@ -76,6 +79,41 @@ FindAttributeMetadata(const ConcreteAttributePath & aPath)
     return metadata;
 }
 
+void LoadAttributeInfo(const ConcreteAttributePath & path, const EmberAfAttributeMetadata & attribute,
+                       DataModel::AttributeInfo * info)
+{
+    info->readPrivilege = RequiredPrivilege::ForReadAttribute(path);
+    if (!attribute.IsReadOnly())
+    {
+        info->writePrivilege = RequiredPrivilege::ForWriteAttribute(path);
+    }
+
+    info->flags.Set(DataModel::AttributeQualityFlags::kListAttribute, (attribute.attributeType == ZCL_ARRAY_ATTRIBUTE_TYPE));
+    info->flags.Set(DataModel::AttributeQualityFlags::kTimed, attribute.MustUseTimedWrite());
+
+    // NOTE: we do NOT provide additional info for:
+    //    - IsExternal/IsSingleton/IsAutomaticallyPersisted is not used by IM handling
+    //    - IsSingleton spec defines it for CLUSTERS where as we have it for ATTRIBUTES
+    //    - Several specification flags are not available (reportable, quieter reporting,
+    //      fixed, source attribution)
+
+    // TODO: Set additional flags:
+    // info->flags.Set(DataModel::AttributeQualityFlags::kFabricScoped)
+    // info->flags.Set(DataModel::AttributeQualityFlags::kFabricSensitive)
+    // info->flags.Set(DataModel::AttributeQualityFlags::kChangesOmitted)
+}
+
+DataModel::CommandInfo LoadAcceptedCommandInfo(const ConcreteCommandPath & path)
+{
+    DataModel::CommandInfo info;
+    info.invokePrivilege = RequiredPrivilege::ForInvokeCommand(path);
+
+    info.flags.Set(DataModel::CommandQualityFlags::kTimed, CommandNeedsTimedInvoke(path.mClusterId, path.mCommandId));
+    info.flags.Set(DataModel::CommandQualityFlags::kFabricScoped, CommandIsFabricScoped(path.mClusterId, path.mCommandId));
+
+    return info;
+}
+
 } // namespace Ember
 } // namespace app
 } // namespace chip
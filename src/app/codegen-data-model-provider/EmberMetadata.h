@@ -16,6 +16,9 @@
  */
 #pragma once
 
+#include <app/ConcreteAttributePath.h>
+#include <app/ConcreteCommandPath.h>
+#include <app/data-model-provider/MetadataTypes.h>
 #include <app/util/af-types.h>
 #include <lib/core/CHIPError.h>
 #include <protocols/interaction_model/StatusCode.h>
@@ -42,6 +45,15 @@ std::variant<const EmberAfCluster *,             // global attribute, data from
              >
 FindAttributeMetadata(const ConcreteAttributePath & aPath);
 
+/// Load the attribute information into the specified destination
+///
+/// `info` is assumed to be default-constructed/clear (i.e. this sets flags, but does not reset them).
+void LoadAttributeInfo(const ConcreteAttributePath & path, const EmberAfAttributeMetadata & attribute,
+                       DataModel::AttributeInfo * info);
+
+/// Returns the information of the given accepted command (privilege and flags)
+DataModel::CommandInfo LoadAcceptedCommandInfo(const ConcreteCommandPath & path);
+
 } // namespace Ember
 } // namespace app
 } // namespace chip
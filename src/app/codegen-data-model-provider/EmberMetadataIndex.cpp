@@ -0,0 +1,299 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <app/codegen-data-model-provider/EmberMetadataIndex.h>
+
+#include <app/GlobalAttributes.h>
+#include <app/codegen-data-model-provider/EmberMetadata.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/endpoint-config-api.h>
+#include <lib/support/CodeUtils.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+namespace Ember {
+
+using Protocols::InteractionModel::Status;
+
+namespace {
+
+/// Finds `id` in the sorted range ids[begin, end)
+///
+/// Lookups are for unrelated paths, so the comparisons of a binary search are unpredictable: this
+/// one is written so that the halving compiles to conditional moves rather than branches.
+template <typename Id>
+std::optional<EmberMetadataIndex::Slot> FindSorted(const Id * ids, EmberMetadataIndex::Slot begin, EmberMetadataIndex::Slot end,
+                                                   Id id)
+{
+    VerifyOrReturnValue(begin < end, std::nullopt);
+
+    const Id * first = ids + begin;
+    size_t count     = end - begin;
+    while (count > 1)
+    {
+        const size_t half = count / 2;
+        first             = (first[half] <= id) ? first + half : first;
+        count -= half;
+    }
+
+    VerifyOrReturnValue(*first == id, std::nullopt);
+    return std::make_optional(static_cast<EmberMetadataIndex::Slot>(first - ids));
+}
+
+/// Ember accepted command lists are either null or terminated by kInvalidCommandId
+size_t CommandCount(const CommandId * list)
+{
+    size_t count = 0;
+    while ((list != nullptr) && (list[count] != kInvalidCommandId))
+    {
+        count++;
+    }
+    return count;
+}
+
+/// The index tables may be empty, however a zero sized allocation is not guaranteed to succeed.
+template <typename T>
+bool AllocateTable(Platform::ScopedMemoryBuffer<T> & table, size_t count)
+{
+    return table.Alloc(std::max<size_t>(count, 1)).Get() != nullptr;
+}
+
+} // namespace
+
+CHIP_ERROR EmberMetadataIndex::Build()
+{
+    Clear();
+
+    // Read first, so that any configuration change while building makes the index outdated.
+    mGeneration = emberAfEndpointConfigurationGeneration();
+
+    const uint16_t endpointCount = emberAfEndpointCount();
+    for (uint16_t endpoint_idx = 0; endpoint_idx < endpointCount; endpoint_idx++)
+    {
+        const EmberAfEndpointType * endpoint = emberAfEndpointTypeFromIndex(endpoint_idx);
+        if (endpoint == nullptr)
+        {
+            continue;
+        }
+
+        mEndpointCount++;
+        for (unsigned cluster_idx = 0; cluster_idx < endpoint->clusterCount; cluster_idx++)
+        {
+            const EmberAfCluster & cluster = endpoint->cluster[cluster_idx];
+            if (!cluster.IsServer())
+            {
+                continue;
+            }
+
+            mClusterCount++;
+            mAttributeCount += (cluster.attributes != nullptr) ? cluster.attributeCount : 0;
+            mCommandCount += CommandCount(cluster.acceptedCommandList);
+        }
+    }
+
+    // Endpoints are sorted by id through a table of their ember indexes.
+    Platform::ScopedMemoryBuffer<uint16_t> endpointOrder;
+    CHIP_ERROR err = Allocate();
+    if ((err == CHIP_NO_ERROR) && !AllocateTable(endpointOrder, mEndpointCount))
+    {
+        err = CHIP_ERROR_NO_MEMORY;
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        Clear();
+        return err;
+    }
+
+    Fill(endpointOrder.Get());
+    mBuilt = true;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EmberMetadataIndex::Allocate()
+{
+    VerifyOrReturnError(AllocateTable(mEndpointIds, mEndpointCount), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(AllocateTable(mEndpointClusters, mEndpointCount + 1), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(AllocateTable(mClusterIds, mClusterCount), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(AllocateTable(mClusters, mClusterCount), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(AllocateTable(mDataVersions, mClusterCount), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(AllocateTable(mClusterAttributes, mClusterCount + 1), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(AllocateTable(mClusterCommands, mClusterCount + 1), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(AllocateTable(mAttributeIds, mAttributeCount), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(AllocateTable(mAttributes, mAttributeCount), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(AllocateTable(mAttributeInfos, mAttributeCount), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(AllocateTable(mCommandIds, mCommandCount), CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(AllocateTable(mCommandInfos, mCommandCount), CHIP_ERROR_NO_MEMORY);
+    return CHIP_NO_ERROR;
+}
+
+void EmberMetadataIndex::Fill(uint16_t * endpointOrder)
+{
+    Slot endpointSlot            = 0;
+    const uint16_t endpointCount = emberAfEndpointCount();
+    for (uint16_t endpoint_idx = 0; endpoint_idx < endpointCount; endpoint_idx++)
+    {
+        if (emberAfEndpointTypeFromIndex(endpoint_idx) != nullptr)
+        {
+            endpointOrder[endpointSlot++] = endpoint_idx;
+        }
+    }
+    std::sort(endpointOrder, endpointOrder + mEndpointCount,
+              [](uint16_t a, uint16_t b) { return emberAfEndpointFromIndex(a) < emberAfEndpointFromIndex(b); });
+
+    Slot clusterSlot   = 0;
+    Slot attributeSlot = 0;
+    Slot commandSlot   = 0;
+    for (endpointSlot = 0; endpointSlot < mEndpointCount; endpointSlot++)
+    {
+        const EmberAfEndpointType * endpoint = emberAfEndpointTypeFromIndex(endpointOrder[endpointSlot]);
+        const EndpointId endpointId          = emberAfEndpointFromIndex(endpointOrder[endpointSlot]);
+
+        mEndpointIds[endpointSlot]      = endpointId;
+        mEndpointClusters[endpointSlot] = clusterSlot;
+
+        const Slot firstCluster = clusterSlot;
+        for (unsigned cluster_idx = 0; cluster_idx < endpoint->clusterCount; cluster_idx++)
+        {
+            if (endpoint->cluster[cluster_idx].IsServer())
+            {
+                mClusters[clusterSlot++] = &endpoint->cluster[cluster_idx];
+            }
+        }
+        std::sort(mClusters.Get() + firstCluster, mClusters.Get() + clusterSlot,
+                  [](const EmberAfCluster * a, const EmberAfCluster * b) { return a->clusterId < b->clusterId; });
+
+        for (Slot cluster = firstCluster; cluster < clusterSlot; cluster++)
+        {
+            const EmberAfCluster * emberCluster = mClusters[cluster];
+            const ConcreteClusterPath clusterPath(endpointId, emberCluster->clusterId);
+
+            mClusterIds[cluster]        = emberCluster->clusterId;
+            mDataVersions[cluster]      = emberAfDataVersionStorage(clusterPath);
+            mClusterAttributes[cluster] = attributeSlot;
+            mClusterCommands[cluster]   = commandSlot;
+
+            const Slot firstAttribute     = attributeSlot;
+            const unsigned attributeCount = (emberCluster->attributes != nullptr) ? emberCluster->attributeCount : 0;
+            for (unsigned attribute_idx = 0; attribute_idx < attributeCount; attribute_idx++)
+            {
+                mAttributes[attributeSlot++] = &emberCluster->attributes[attribute_idx];
+            }
+            std::sort(mAttributes.Get() + firstAttribute, mAttributes.Get() + attributeSlot,
+                      [](const EmberAfAttributeMetadata * a, const EmberAfAttributeMetadata * b) {
+                          return a->attributeId < b->attributeId;
+                      });
+            for (Slot attribute = firstAttribute; attribute < attributeSlot; attribute++)
+            {
+                mAttributeIds[attribute] = mAttributes[attribute]->attributeId;
+                LoadAttributeInfo(ConcreteAttributePath(endpointId, clusterPath.mClusterId, mAttributeIds[attribute]),
+                                  *mAttributes[attribute], &mAttributeInfos[attribute]);
+            }
+
+            const Slot firstCommand   = commandSlot;
+            const size_t commandCount = CommandCount(emberCluster->acceptedCommandList);
+            for (size_t command_idx = 0; command_idx < commandCount; command_idx++)
+            {
+                mCommandIds[commandSlot++] = emberCluster->acceptedCommandList[command_idx];
+            }
+            std::sort(mCommandIds.Get() + firstCommand, mCommandIds.Get() + commandSlot);
+            for (Slot command = firstCommand; command < commandSlot; command++)
+            {
+                mCommandInfos[command] =
+                    LoadAcceptedCommandInfo(ConcreteCommandPath(endpointId, clusterPath.mClusterId, mCommandIds[command]));
+            }
+        }
+    }
+
+    mEndpointClusters[mEndpointCount] = clusterSlot;
+    mClusterAttributes[mClusterCount] = attributeSlot;
+    mClusterCommands[mClusterCount]   = commandSlot;
+}
+
+void EmberMetadataIndex::Clear()
+{
+    mBuilt          = false;
+    mEndpointCount  = 0;
+    mClusterCount   = 0;
+    mAttributeCount = 0;
+    mCommandCount   = 0;
+
+    mEndpointIds.Free();
+    mEndpointClusters.Free();
+    mClusterIds.Free();
+    mClusters.Free();
+    mDataVersions.Free();
+    mClusterAttributes.Free();
+    mClusterCommands.Free();
+    mAttributeIds.Free();
+    mAttributes.Free();
+    mAttributeInfos.Free();
+    mCommandIds.Free();
+    mCommandInfos.Free();
+}
+
+bool EmberMetadataIndex::IsCurrent() const
+{
+    return mBuilt && (mGeneration == emberAfEndpointConfigurationGeneration());
+}
+
+std::optional<EmberMetadataIndex::Slot> EmberMetadataIndex::FindEndpoint(EndpointId endpointId) const
+{
+    VerifyOrReturnValue(mBuilt, std::nullopt);
+    return FindSorted(mEndpointIds.Get(), 0, static_cast<Slot>(mEndpointCount), endpointId);
+}
+
+std::optional<EmberMetadataIndex::Slot> EmberMetadataIndex::FindServerCluster(const ConcreteClusterPath & path) const
+{
+    std::optional<Slot> endpoint = FindEndpoint(path.mEndpointId);
+    VerifyOrReturnValue(endpoint.has_value(), std::nullopt);
+    return FindSorted(mClusterIds.Get(), mEndpointClusters[*endpoint], mEndpointClusters[*endpoint + 1], path.mClusterId);
+}
+
+std::optional<EmberMetadataIndex::Slot> EmberMetadataIndex::FindAttribute(Slot cluster, AttributeId attributeId) const
+{
+    return FindSorted(mAttributeIds.Get(), mClusterAttributes[cluster], mClusterAttributes[cluster + 1], attributeId);
+}
+
+std::optional<EmberMetadataIndex::Slot> EmberMetadataIndex::FindAcceptedCommand(Slot cluster, CommandId commandId) const
+{
+    return FindSorted(mCommandIds.Get(), mClusterCommands[cluster], mClusterCommands[cluster + 1], commandId);
+}
+
+std::variant<const EmberAfCluster *, const EmberAfAttributeMetadata *, Status>
+EmberMetadataIndex::FindAttributeMetadata(const ConcreteAttributePath & path) const
+{
+    std::optional<Slot> cluster = FindServerCluster(path);
+    if (!cluster.has_value())
+    {
+        return HasEndpoint(path.mEndpointId) ? Status::UnsupportedCluster : Status::UnsupportedEndpoint;
+    }
+
+    if (IsSupportedGlobalAttributeNotInMetadata(path.mAttributeId))
+    {
+        return GetCluster(*cluster);
+    }
+
+    std::optional<Slot> attribute = FindAttribute(*cluster, path.mAttributeId);
+    VerifyOrReturnValue(attribute.has_value(), Status::UnsupportedAttribute);
+    return GetAttribute(*attribute);
+}
+
+} // namespace Ember
+} // namespace app
+} // namespace chip
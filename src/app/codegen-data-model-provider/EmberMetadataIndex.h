@@ -0,0 +1,144 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/ConcreteClusterPath.h>
+#include <app/ConcreteCommandPath.h>
+#include <app/data-model-provider/MetadataTypes.h>
+#include <app/util/af-types.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/ScopedBuffer.h>
+#include <protocols/interaction_model/StatusCode.h>
+
+#include <optional>
+#include <variant>
+
+namespace chip {
+namespace app {
+namespace Ember {
+
+/// A compact, sorted copy of the ember endpoint configuration, for lookups by id.
+///
+/// Ember keeps its metadata as arrays in configuration order, so finding an endpoint, a
+/// cluster, an attribute or a command by id is a linear search (over all endpoints for
+/// an endpoint id). This index holds the enabled endpoints and their server clusters,
+/// attributes and accepted commands as sorted arrays of ids (struct of arrays: the ids
+/// that searches go through are contiguous, and what is found for them is kept in
+/// parallel arrays), so that each of them is found with a binary search.
+///
+/// Clusters are stored with their data version storage, attributes with their
+/// `DataModel::AttributeInfo` and accepted commands with their `DataModel::CommandInfo`,
+/// which are computed once when building rather than on every lookup.
+///
+/// The index is a snapshot: it is valid until `emberAfEndpointConfigurationGeneration()`
+/// changes (endpoints enabled or disabled, dynamic endpoints set or cleared). `IsCurrent`
+/// tells whether it needs to be built again.
+///
+/// Lookups return slots, which are indexes into the index tables and are only valid until
+/// the next `Build` or `Clear`.
+class EmberMetadataIndex
+{
+public:
+    using Slot = uint32_t;
+
+    EmberMetadataIndex() = default;
+
+    EmberMetadataIndex(const EmberMetadataIndex &)             = delete;
+    EmberMetadataIndex & operator=(const EmberMetadataIndex &) = delete;
+
+    /// Builds the index from the current ember configuration, replacing any previous content.
+    ///
+    /// On failure, the index is left empty (and not current).
+    ///
+    /// @retval CHIP_ERROR_NO_MEMORY if the index tables cannot be allocated.
+    CHIP_ERROR Build();
+
+    /// Frees the index tables.
+    void Clear();
+
+    /// Whether the index was built from the current ember configuration.
+    bool IsCurrent() const;
+
+    std::optional<Slot> FindServerCluster(const ConcreteClusterPath & path) const;
+    bool HasEndpoint(EndpointId endpointId) const { return FindEndpoint(endpointId).has_value(); }
+
+    const EmberAfCluster * GetCluster(Slot cluster) const { return mClusters[cluster]; }
+    DataVersion * GetDataVersion(Slot cluster) const { return mDataVersions[cluster]; }
+
+    /// Finds the given attribute in the server cluster at the given slot
+    std::optional<Slot> FindAttribute(Slot cluster, AttributeId attributeId) const;
+
+    const EmberAfAttributeMetadata * GetAttribute(Slot attribute) const { return mAttributes[attribute]; }
+    const DataModel::AttributeInfo & GetAttributeInfo(Slot attribute) const { return mAttributeInfos[attribute]; }
+
+    /// Finds the given command in the accepted commands of the server cluster at the given slot
+    std::optional<Slot> FindAcceptedCommand(Slot cluster, CommandId commandId) const;
+
+    const DataModel::CommandInfo & GetAcceptedCommandInfo(Slot command) const { return mCommandInfos[command]; }
+
+    /// Same as `Ember::FindAttributeMetadata`, using the index.
+    std::variant<const EmberAfCluster *, const EmberAfAttributeMetadata *, Protocols::InteractionModel::Status>
+    FindAttributeMetadata(const ConcreteAttributePath & path) const;
+
+    size_t EndpointCount() const { return mEndpointCount; }
+    size_t ClusterCount() const { return mClusterCount; }
+    size_t AttributeCount() const { return mAttributeCount; }
+    size_t AcceptedCommandCount() const { return mCommandCount; }
+
+private:
+    CHIP_ERROR Allocate();
+    void Fill(uint16_t * endpointOrder);
+
+    std::optional<Slot> FindEndpoint(EndpointId endpointId) const;
+
+    bool mBuilt          = false;
+    uint32_t mGeneration = 0;
+
+    size_t mEndpointCount  = 0;
+    size_t mClusterCount   = 0;
+    size_t mAttributeCount = 0;
+    size_t mCommandCount   = 0;
+
+    // Endpoints, sorted by id. The server clusters of mEndpointIds[i] are the ones
+    // in [mEndpointClusters[i], mEndpointClusters[i + 1]).
+    Platform::ScopedMemoryBuffer<EndpointId> mEndpointIds;
+    Platform::ScopedMemoryBuffer<Slot> mEndpointClusters;
+
+    // Server clusters, grouped by endpoint and sorted by id within an endpoint. The
+    // attributes of mClusterIds[i] are in [mClusterAttributes[i], mClusterAttributes[i + 1])
+    // and its accepted commands in [mClusterCommands[i], mClusterCommands[i + 1]).
+    Platform::ScopedMemoryBuffer<ClusterId> mClusterIds;
+    Platform::ScopedMemoryBuffer<const EmberAfCluster *> mClusters;
+    Platform::ScopedMemoryBuffer<DataVersion *> mDataVersions;
+    Platform::ScopedMemoryBuffer<Slot> mClusterAttributes;
+    Platform::ScopedMemoryBuffer<Slot> mClusterCommands;
+
+    // Attributes, grouped by cluster and sorted by id within a cluster.
+    Platform::ScopedMemoryBuffer<AttributeId> mAttributeIds;
+    Platform::ScopedMemoryBuffer<const EmberAfAttributeMetadata *> mAttributes;
+    Platform::ScopedMemoryBuffer<DataModel::AttributeInfo> mAttributeInfos;
+
+    // Accepted commands, grouped by cluster and sorted by id within a cluster.
+    Platform::ScopedMemoryBuffer<CommandId> mCommandIds;
+    Platform::ScopedMemoryBuffer<DataModel::CommandInfo> mCommandInfos;
+};
+
+} // namespace Ember
+} // namespace app
+} // namespace chip
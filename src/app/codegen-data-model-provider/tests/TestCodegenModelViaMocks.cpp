@@ -57,6 +57,7 @@
 #include <lib/core/TLVTags.h>
 #include <lib/core/TLVTypes.h>
 #include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/Span.h>
 #include <protocols/interaction_model/StatusCode.h>
 
@@ -891,9 +892,17 @@ void WriteLe16(void * buffer, uint16_t value)
     chip::Encoding::LittleEndian::Write16(p, value);
 }
 
+class TestCodegenModelViaMocks : public ::testing::Test
+{
+public:
+    // The provider allocates its metadata index, when CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX is enabled.
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
 } // namespace
 
-TEST(TestCodegenModelViaMocks, IterateOverEndpoints)
+TEST_F(TestCodegenModelViaMocks, IterateOverEndpoints)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -921,7 +930,7 @@ TEST(TestCodegenModelViaMocks, IterateOverEndpoints)
     EXPECT_EQ(model.NextEndpoint(987u), kInvalidEndpointId);
 }
 
-TEST(TestCodegenModelViaMocks, IterateOverClusters)
+TEST_F(TestCodegenModelViaMocks, IterateOverClusters)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -983,7 +992,7 @@ TEST(TestCodegenModelViaMocks, IterateOverClusters)
     }
 }
 
-TEST(TestCodegenModelViaMocks, GetClusterInfo)
+TEST_F(TestCodegenModelViaMocks, GetClusterInfo)
 {
 
     UseMockNodeConfig config(gTestNodeConfig);
@@ -1009,7 +1018,7 @@ TEST(TestCodegenModelViaMocks, GetClusterInfo)
     EXPECT_EQ(info->flags.Raw(), 0u); // NOLINT(bugprone-unchecked-optional-access)
 }
 
-TEST(TestCodegenModelViaMocks, IterateOverAttributes)
+TEST_F(TestCodegenModelViaMocks, IterateOverAttributes)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1080,7 +1089,104 @@ TEST(TestCodegenModelViaMocks, IterateOverAttributes)
     }
 }
 
-TEST(TestCodegenModelViaMocks, GetAttributeInfo)
+TEST_F(TestCodegenModelViaMocks, IterateWithCursors)
+{
+    UseMockNodeConfig config(gTestNodeConfig);
+    CodegenDataModelProviderWithContext model;
+
+    // collect the full tree through the `before` based iteration
+    std::vector<ConcreteAttributePath> expected;
+    for (EndpointId endpoint = model.FirstEndpoint(); endpoint != kInvalidEndpointId; endpoint = model.NextEndpoint(endpoint))
+    {
+        for (ClusterEntry cluster = model.FirstCluster(endpoint); cluster.IsValid(); cluster = model.NextCluster(cluster.path))
+        {
+            for (AttributeEntry attribute = model.FirstAttribute(cluster.path); attribute.IsValid();
+                 attribute                = model.NextAttribute(attribute.path))
+            {
+                expected.push_back(attribute.path);
+            }
+        }
+    }
+    ASSERT_FALSE(expected.empty());
+
+    // Two interleaved iterations, each with its own cursor, go over the same paths
+    std::vector<ConcreteAttributePath> actual[2];
+    MetadataCursor cursors[2];
+    AttributeEntry current[2];
+    for (unsigned i = 0; i < 2; i++)
+    {
+        EndpointId endpoint = model.FirstEndpointWithCursor(cursors[i]);
+        ASSERT_NE(endpoint, kInvalidEndpointId);
+        ClusterEntry cluster = model.FirstClusterWithCursor(endpoint, cursors[i]);
+        ASSERT_TRUE(cluster.IsValid());
+        current[i] = model.FirstAttributeWithCursor(cluster.path, cursors[i]);
+        ASSERT_TRUE(current[i].IsValid());
+    }
+
+    while (current[0].IsValid() || current[1].IsValid())
+    {
+        for (unsigned i = 0; i < 2; i++)
+        {
+            if (!current[i].IsValid())
+            {
+                continue;
+            }
+            actual[i].push_back(current[i].path);
+
+            MetadataCursor & cursor = cursors[i];
+            AttributeEntry next     = model.NextAttributeWithCursor(current[i].path, cursor);
+            ConcreteClusterPath clusterPath(current[i].path.mEndpointId, current[i].path.mClusterId);
+            while (!next.IsValid())
+            {
+                ClusterEntry cluster = model.NextClusterWithCursor(clusterPath, cursor);
+                while (!cluster.IsValid())
+                {
+                    EndpointId endpoint = model.NextEndpointWithCursor(clusterPath.mEndpointId, cursor);
+                    if (endpoint == kInvalidEndpointId)
+                    {
+                        break;
+                    }
+                    clusterPath = ConcreteClusterPath(endpoint, kInvalidClusterId);
+                    cluster     = model.FirstClusterWithCursor(endpoint, cursor);
+                }
+                if (!cluster.IsValid())
+                {
+                    break;
+                }
+                clusterPath = cluster.path;
+                next        = model.FirstAttributeWithCursor(cluster.path, cursor);
+            }
+            current[i] = next;
+        }
+    }
+
+    for (auto & paths : actual)
+    {
+        ASSERT_EQ(paths.size(), expected.size());
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            EXPECT_TRUE(paths[i] == expected[i]);
+        }
+    }
+
+    // A cursor that does not match the given path is ignored
+    MetadataCursor stale;
+    ASSERT_NE(model.FirstEndpointWithCursor(stale), kInvalidEndpointId);
+    AttributeEntry entry =
+        model.NextAttributeWithCursor(ConcreteAttributePath(kMockEndpoint2, MockClusterId(2), MockAttributeId(1)), stale);
+    ASSERT_TRUE(entry.IsValid());
+    ASSERT_EQ(entry.path.mEndpointId, kMockEndpoint2);
+    ASSERT_EQ(entry.path.mClusterId, MockClusterId(2));
+    ASSERT_EQ(entry.path.mAttributeId, MockAttributeId(2));
+
+    MetadataCursor unused;
+    ASSERT_FALSE(
+        model.NextAttributeWithCursor(ConcreteAttributePath(kEndpointIdThatIsMissing, MockClusterId(1), 1u), unused).IsValid());
+    ASSERT_FALSE(model.NextClusterWithCursor(ConcreteClusterPath(kMockEndpoint1, MockClusterId(10)), unused).IsValid());
+    ASSERT_EQ(model.NextEndpointWithCursor(kEndpointIdThatIsMissing, unused), kInvalidEndpointId);
+}
+
+TEST_F(TestCodegenModelViaMocks, GetAttributeInfo)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1120,7 +1226,7 @@ TEST(TestCodegenModelViaMocks, GetAttributeInfo)
 }
 
 // global attributes are EXPLICITLY not supported
-TEST(TestCodegenModelViaMocks, GlobalAttributeInfo)
+TEST_F(TestCodegenModelViaMocks, GlobalAttributeInfo)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1135,7 +1241,7 @@ TEST(TestCodegenModelViaMocks, GlobalAttributeInfo)
     ASSERT_FALSE(info.has_value());
 }
 
-TEST(TestCodegenModelViaMocks, IterateOverAcceptedCommands)
+TEST_F(TestCodegenModelViaMocks, IterateOverAcceptedCommands)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1200,7 +1306,7 @@ TEST(TestCodegenModelViaMocks, IterateOverAcceptedCommands)
     }
 }
 
-TEST(TestCodegenModelViaMocks, AcceptedCommandInfo)
+TEST_F(TestCodegenModelViaMocks, AcceptedCommandInfo)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1232,7 +1338,7 @@ TEST(TestCodegenModelViaMocks, AcceptedCommandInfo)
     ASSERT_FALSE(info.has_value());
 }
 
-TEST(TestCodegenModelViaMocks, IterateOverGeneratedCommands)
+TEST_F(TestCodegenModelViaMocks, IterateOverGeneratedCommands)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1291,7 +1397,7 @@ TEST(TestCodegenModelViaMocks, IterateOverGeneratedCommands)
     }
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadAclDeny)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadAclDeny)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1304,7 +1410,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeReadAclDeny)
     ASSERT_EQ(model.ReadAttribute(testRequest.request, *encoder), Status::UnsupportedAccess);
 }
 
-TEST(TestCodegenModelViaMocks, ReadForInvalidGlobalAttributePath)
+TEST_F(TestCodegenModelViaMocks, ReadForInvalidGlobalAttributePath)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1325,7 +1431,7 @@ TEST(TestCodegenModelViaMocks, ReadForInvalidGlobalAttributePath)
     }
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeInvalidRead)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeInvalidRead)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1359,7 +1465,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeInvalidRead)
     }
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributePathExpansionAccessDeniedRead)
+TEST_F(TestCodegenModelViaMocks, EmberAttributePathExpansionAccessDeniedRead)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1377,7 +1483,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributePathExpansionAccessDeniedRead)
     ASSERT_FALSE(encoder->TriedEncode());
 }
 
-TEST(TestCodegenModelViaMocks, AccessInterfaceUnsupportedRead)
+TEST_F(TestCodegenModelViaMocks, AccessInterfaceUnsupportedRead)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1399,63 +1505,63 @@ TEST(TestCodegenModelViaMocks, AccessInterfaceUnsupportedRead)
     ASSERT_FALSE(encoder->TriedEncode());
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadInt32S)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadInt32S)
 {
     TestEmberScalarTypeRead<int32_t, ZCL_INT32S_ATTRIBUTE_TYPE>(-1234);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadEnum16)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadEnum16)
 {
     TestEmberScalarTypeRead<uint16_t, ZCL_ENUM16_ATTRIBUTE_TYPE>(0x1234);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadFloat)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadFloat)
 {
     TestEmberScalarTypeRead<float, ZCL_SINGLE_ATTRIBUTE_TYPE>(0.625);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadDouble)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadDouble)
 {
     TestEmberScalarTypeRead<double, ZCL_DOUBLE_ATTRIBUTE_TYPE>(0.625);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadInt24U)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadInt24U)
 {
     TestEmberScalarTypeRead<OddSizedInteger<3, false>, ZCL_INT24U_ATTRIBUTE_TYPE>(0x1234AB);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadInt32U)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadInt32U)
 {
     TestEmberScalarTypeRead<uint32_t, ZCL_INT32U_ATTRIBUTE_TYPE>(0x1234ABCD);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadInt40U)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadInt40U)
 {
     TestEmberScalarTypeRead<OddSizedInteger<5, false>, ZCL_INT40U_ATTRIBUTE_TYPE>(0x1122334455);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadInt48U)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadInt48U)
 {
     TestEmberScalarTypeRead<OddSizedInteger<6, false>, ZCL_INT48U_ATTRIBUTE_TYPE>(0xAABB11223344);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadInt56U)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadInt56U)
 {
     TestEmberScalarTypeRead<OddSizedInteger<7, false>, ZCL_INT56U_ATTRIBUTE_TYPE>(0xAABB11223344);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadBool)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadBool)
 {
     TestEmberScalarTypeRead<bool, ZCL_BOOLEAN_ATTRIBUTE_TYPE>(true);
     TestEmberScalarTypeRead<bool, ZCL_BOOLEAN_ATTRIBUTE_TYPE>(false);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadInt8U)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadInt8U)
 {
     TestEmberScalarTypeRead<uint8_t, ZCL_INT8U_ATTRIBUTE_TYPE>(0x12);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadNulls)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadNulls)
 {
     TestEmberScalarNullRead<uint8_t, ZCL_INT8U_ATTRIBUTE_TYPE>();
     TestEmberScalarNullRead<uint16_t, ZCL_INT16U_ATTRIBUTE_TYPE>();
@@ -1481,7 +1587,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeReadNulls)
     TestEmberScalarNullRead<double, ZCL_DOUBLE_ATTRIBUTE_TYPE>();
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadErrorReading)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadErrorReading)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1517,7 +1623,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeReadErrorReading)
     chip::Test::SetEmberReadOutput(ByteSpan());
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadNullOctetString)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadNullOctetString)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1552,7 +1658,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeReadNullOctetString)
     ASSERT_TRUE(actual.IsNull());
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadOctetString)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadOctetString)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1591,7 +1697,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeReadOctetString)
     ASSERT_TRUE(actual.data_equal(expected));
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadLongOctetString)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadLongOctetString)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1628,7 +1734,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeReadLongOctetString)
     ASSERT_TRUE(actual.data_equal(expected));
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadShortString)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadShortString)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1664,7 +1770,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeReadShortString)
     ASSERT_TRUE(actual.data_equal("abcde"_span));
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeReadLongString)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeReadLongString)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1701,7 +1807,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeReadLongString)
     ASSERT_TRUE(actual.data_equal("abcde"_span));
 }
 
-TEST(TestCodegenModelViaMocks, AttributeAccessInterfaceStructRead)
+TEST_F(TestCodegenModelViaMocks, AttributeAccessInterfaceStructRead)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1744,7 +1850,7 @@ TEST(TestCodegenModelViaMocks, AttributeAccessInterfaceStructRead)
     ASSERT_TRUE(actual.e.data_equal("foo"_span));
 }
 
-TEST(TestCodegenModelViaMocks, AttributeAccessInterfaceReadError)
+TEST_F(TestCodegenModelViaMocks, AttributeAccessInterfaceReadError)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1759,7 +1865,7 @@ TEST(TestCodegenModelViaMocks, AttributeAccessInterfaceReadError)
     ASSERT_EQ(model.ReadAttribute(testRequest.request, *encoder), CHIP_ERROR_KEY_NOT_FOUND);
 }
 
-TEST(TestCodegenModelViaMocks, AttributeAccessInterfaceListRead)
+TEST_F(TestCodegenModelViaMocks, AttributeAccessInterfaceListRead)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1811,7 +1917,7 @@ TEST(TestCodegenModelViaMocks, AttributeAccessInterfaceListRead)
     }
 }
 
-TEST(TestCodegenModelViaMocks, AttributeAccessInterfaceListOverflowRead)
+TEST_F(TestCodegenModelViaMocks, AttributeAccessInterfaceListOverflowRead)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1870,7 +1976,7 @@ TEST(TestCodegenModelViaMocks, AttributeAccessInterfaceListOverflowRead)
     }
 }
 
-TEST(TestCodegenModelViaMocks, AttributeAccessInterfaceListIncrementalRead)
+TEST_F(TestCodegenModelViaMocks, AttributeAccessInterfaceListIncrementalRead)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1932,7 +2038,7 @@ TEST(TestCodegenModelViaMocks, AttributeAccessInterfaceListIncrementalRead)
     }
 }
 
-TEST(TestCodegenModelViaMocks, ReadGlobalAttributeAttributeList)
+TEST_F(TestCodegenModelViaMocks, ReadGlobalAttributeAttributeList)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -1988,7 +2094,7 @@ TEST(TestCodegenModelViaMocks, ReadGlobalAttributeAttributeList)
     }
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteAclDeny)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteAclDeny)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2001,7 +2107,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteAclDeny)
     ASSERT_TRUE(model.ChangeListener().DirtyList().empty());
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteBasicTypes)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteBasicTypes)
 {
     TestEmberScalarTypeWrite<uint8_t, ZCL_INT8U_ATTRIBUTE_TYPE>(0x12);
     TestEmberScalarTypeWrite<uint16_t, ZCL_ENUM16_ATTRIBUTE_TYPE>(0x1234);
@@ -2027,7 +2133,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteBasicTypes)
     TestEmberScalarTypeWrite<double, ZCL_DOUBLE_ATTRIBUTE_TYPE>(0.625);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteInvalidValueToNullable)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteInvalidValueToNullable)
 {
     TestEmberScalarTypeWriteNullValueToNullable<uint8_t, ZCL_INT8U_ATTRIBUTE_TYPE>();
     TestEmberScalarTypeWriteNullValueToNullable<uint16_t, ZCL_ENUM16_ATTRIBUTE_TYPE>();
@@ -2053,7 +2159,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteInvalidValueToNullable)
     TestEmberScalarTypeWriteNullValueToNullable<double, ZCL_DOUBLE_ATTRIBUTE_TYPE>();
 }
 
-TEST(TestCodegenModelViaMocks, EmberTestWriteReservedNullPlaceholderToNullable)
+TEST_F(TestCodegenModelViaMocks, EmberTestWriteReservedNullPlaceholderToNullable)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2071,7 +2177,7 @@ TEST(TestCodegenModelViaMocks, EmberTestWriteReservedNullPlaceholderToNullable)
     ASSERT_EQ(model.WriteAttribute(test.request, decoder), Status::ConstraintError);
 }
 
-TEST(TestCodegenModelViaMocks, EmberTestWriteOutOfRepresentableRangeOddIntegerNonNullable)
+TEST_F(TestCodegenModelViaMocks, EmberTestWriteOutOfRepresentableRangeOddIntegerNonNullable)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2090,7 +2196,7 @@ TEST(TestCodegenModelViaMocks, EmberTestWriteOutOfRepresentableRangeOddIntegerNo
     ASSERT_EQ(model.WriteAttribute(test.request, decoder), CHIP_ERROR_INVALID_ARGUMENT);
 }
 
-TEST(TestCodegenModelViaMocks, EmberTestWriteOutOfRepresentableRangeOddIntegerNullable)
+TEST_F(TestCodegenModelViaMocks, EmberTestWriteOutOfRepresentableRangeOddIntegerNullable)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2109,7 +2215,7 @@ TEST(TestCodegenModelViaMocks, EmberTestWriteOutOfRepresentableRangeOddIntegerNu
     ASSERT_EQ(model.WriteAttribute(test.request, decoder), CHIP_ERROR_INVALID_ARGUMENT);
 }
 
-TEST(TestCodegenModelViaMoceNullValueToNullables, EmberAttributeWriteBasicTypesLowestValue)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteBasicTypesLowestValue)
 {
     TestEmberScalarTypeWrite<int8_t, ZCL_INT8S_ATTRIBUTE_TYPE>(-127);
     TestEmberScalarTypeWrite<int16_t, ZCL_INT16S_ATTRIBUTE_TYPE>(-32767);
@@ -2121,7 +2227,7 @@ TEST(TestCodegenModelViaMoceNullValueToNullables, EmberAttributeWriteBasicTypesL
     TestEmberScalarTypeWrite<int64_t, ZCL_INT64S_ATTRIBUTE_TYPE>(-9223372036854775807);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteNulls)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteNulls)
 {
     TestEmberScalarNullWrite<uint8_t, ZCL_INT8U_ATTRIBUTE_TYPE>();
     TestEmberScalarNullWrite<uint16_t, ZCL_ENUM16_ATTRIBUTE_TYPE>();
@@ -2145,7 +2251,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteNulls)
     TestEmberScalarNullWrite<double, ZCL_DOUBLE_ATTRIBUTE_TYPE>();
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteShortString)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteShortString)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2162,7 +2268,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteShortString)
     ASSERT_TRUE(asCharSpan.data_equal("\x0Bhello world"_span));
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteLongStringOutOfBounds)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteLongStringOutOfBounds)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2179,7 +2285,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteLongStringOutOfBounds)
     ASSERT_EQ(model.WriteAttribute(test.request, decoder), Status::InvalidValue);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteLongString)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteLongString)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2200,7 +2306,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteLongString)
     ASSERT_TRUE(asCharSpan.data_equal("text"_span));
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteNullableLongStringValue)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteNullableLongStringValue)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2222,7 +2328,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteNullableLongStringValue)
     ASSERT_TRUE(asCharSpan.data_equal("text"_span));
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteLongNullableStringNull)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteLongNullableStringNull)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2240,7 +2346,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteLongNullableStringNull)
     ASSERT_EQ(writtenData[1], 0xFF);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteShortBytes)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteShortBytes)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2262,7 +2368,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteShortBytes)
     EXPECT_EQ(writtenData[3], 13u);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteLongBytes)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteLongBytes)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2286,7 +2392,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteLongBytes)
     EXPECT_EQ(writtenData[4], 13u);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteTimedWrite)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteTimedWrite)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2302,7 +2408,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteTimedWrite)
     ASSERT_EQ(model.WriteAttribute(test.request, decoder), CHIP_NO_ERROR);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteReadOnlyAttribute)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteReadOnlyAttribute)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2318,7 +2424,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteReadOnlyAttribute)
     ASSERT_EQ(model.WriteAttribute(test.request, decoder), CHIP_NO_ERROR);
 }
 
-TEST(TestCodegenModelViaMocks, EmberAttributeWriteDataVersion)
+TEST_F(TestCodegenModelViaMocks, EmberAttributeWriteDataVersion)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2345,7 +2451,7 @@ TEST(TestCodegenModelViaMocks, EmberAttributeWriteDataVersion)
     ASSERT_EQ(model.WriteAttribute(test.request, decoder), CHIP_NO_ERROR);
 }
 
-TEST(TestCodegenModelViaMocks, WriteToInvalidPath)
+TEST_F(TestCodegenModelViaMocks, WriteToInvalidPath)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2369,7 +2475,7 @@ TEST(TestCodegenModelViaMocks, WriteToInvalidPath)
     }
 }
 
-TEST(TestCodegenModelViaMocks, WriteToGlobalAttribute)
+TEST_F(TestCodegenModelViaMocks, WriteToGlobalAttribute)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2380,7 +2486,7 @@ TEST(TestCodegenModelViaMocks, WriteToGlobalAttribute)
     ASSERT_EQ(model.WriteAttribute(test.request, decoder), Status::UnsupportedWrite);
 }
 
-TEST(TestCodegenModelViaMocks, EmberWriteFailure)
+TEST_F(TestCodegenModelViaMocks, EmberWriteFailure)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2404,7 +2510,7 @@ TEST(TestCodegenModelViaMocks, EmberWriteFailure)
     chip::Test::SetEmberReadOutput(ByteSpan());
 }
 
-TEST(TestCodegenModelViaMocks, EmberWriteAttributeAccessInterfaceTest)
+TEST_F(TestCodegenModelViaMocks, EmberWriteAttributeAccessInterfaceTest)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2440,7 +2546,7 @@ TEST(TestCodegenModelViaMocks, EmberWriteAttributeAccessInterfaceTest)
     TestEmberScalarNullWrite<int64_t, ZCL_INT64S_ATTRIBUTE_TYPE>();
 }
 
-TEST(TestCodegenModelViaMocks, EmberInvokeTest)
+TEST_F(TestCodegenModelViaMocks, EmberInvokeTest)
 {
     // Ember invoke is fully code-generated - there is a single function for Dispatch
     // that will do a `switch` on the path elements and invoke a corresponding `emberAf*`
@@ -2481,7 +2587,7 @@ TEST(TestCodegenModelViaMocks, EmberInvokeTest)
     }
 }
 
-TEST(TestCodegenModelViaMocks, EmberWriteAttributeAccessInterfaceReturningError)
+TEST_F(TestCodegenModelViaMocks, EmberWriteAttributeAccessInterfaceReturningError)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
@@ -2505,7 +2611,7 @@ TEST(TestCodegenModelViaMocks, EmberWriteAttributeAccessInterfaceReturningError)
     ASSERT_TRUE(model.ChangeListener().DirtyList().empty());
 }
 
-TEST(TestCodegenModelViaMocks, EmberWriteInvalidDataType)
+TEST_F(TestCodegenModelViaMocks, EmberWriteInvalidDataType)
 {
     UseMockNodeConfig config(gTestNodeConfig);
     CodegenDataModelProviderWithContext model;
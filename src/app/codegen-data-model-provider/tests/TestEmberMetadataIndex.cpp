@@ -0,0 +1,247 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/ConcreteAttributePath.h>
+#include <app/ConcreteClusterPath.h>
+#include <app/ConcreteCommandPath.h>
+#include <app/codegen-data-model-provider/EmberMetadata.h>
+#include <app/codegen-data-model-provider/EmberMetadataIndex.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
+#include <app/util/mock/MockNodeConfig.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <protocols/interaction_model/StatusCode.h>
+
+using namespace chip;
+using namespace chip::Test;
+using namespace chip::app;
+using namespace chip::app::Clusters::Globals::Attributes;
+
+using chip::Protocols::InteractionModel::Status;
+using Slot = chip::app::Ember::EmberMetadataIndex::Slot;
+
+namespace {
+
+constexpr AttributeId kTimedWriteAttributeId = 0x3002;
+constexpr AttributeId kListAttributeId       = 0x3003;
+
+// Ids are deliberately out of order at every level, as ember allows.
+// clang-format off
+const MockNodeConfig gUnsortedNodeConfig({
+    MockEndpointConfig(9, {
+        MockClusterConfig(MockClusterId(3), { ClusterRevision::Id, FeatureMap::Id }),
+    }),
+    MockEndpointConfig(2, {
+        MockClusterConfig(MockClusterId(7), {
+            ClusterRevision::Id, FeatureMap::Id, MockAttributeId(5), MockAttributeId(1),
+            MockAttributeConfig(kTimedWriteAttributeId, ZCL_INT32U_ATTRIBUTE_TYPE,
+                                ATTRIBUTE_MASK_WRITABLE | ATTRIBUTE_MASK_MUST_USE_TIMED_WRITE),
+            MockAttributeConfig(kListAttributeId, ZCL_ARRAY_ATTRIBUTE_TYPE, ATTRIBUTE_MASK_WRITABLE),
+        }, {}, { 0x44, 0x11, 0x22 }),
+        MockClusterConfig(MockClusterId(2), { ClusterRevision::Id, FeatureMap::Id, MockAttributeId(2) }),
+    }),
+    MockEndpointConfig(5, {}),
+});
+
+const MockNodeConfig gChangedNodeConfig({
+    MockEndpointConfig(2, {
+        MockClusterConfig(MockClusterId(2), { ClusterRevision::Id, FeatureMap::Id }),
+    }),
+});
+// clang-format on
+
+struct UseMockNodeConfig
+{
+    UseMockNodeConfig(const MockNodeConfig & config) { SetMockNodeConfig(config); }
+    ~UseMockNodeConfig() { ResetMockNodeConfig(); }
+};
+
+class TestEmberMetadataIndex : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+TEST_F(TestEmberMetadataIndex, FindsEverythingEmberHas)
+{
+    UseMockNodeConfig config(gUnsortedNodeConfig);
+    Ember::EmberMetadataIndex index;
+
+    EXPECT_FALSE(index.IsCurrent());
+    ASSERT_EQ(index.Build(), CHIP_NO_ERROR);
+    EXPECT_TRUE(index.IsCurrent());
+
+    EXPECT_EQ(index.EndpointCount(), 3u);
+    EXPECT_EQ(index.ClusterCount(), 3u);
+    EXPECT_EQ(index.AttributeCount(), 11u);
+    EXPECT_EQ(index.AcceptedCommandCount(), 3u);
+
+    EXPECT_TRUE(index.HasEndpoint(2));
+    EXPECT_TRUE(index.HasEndpoint(5));
+    EXPECT_TRUE(index.HasEndpoint(9));
+    EXPECT_FALSE(index.HasEndpoint(0));
+    EXPECT_FALSE(index.HasEndpoint(3));
+    EXPECT_FALSE(index.HasEndpoint(kInvalidEndpointId));
+
+    for (const MockEndpointConfig & endpoint : gUnsortedNodeConfig.endpoints)
+    {
+        for (const MockClusterConfig & cluster : endpoint.clusters)
+        {
+            std::optional<Slot> clusterSlot = index.FindServerCluster(ConcreteClusterPath(endpoint.id, cluster.id));
+            ASSERT_TRUE(clusterSlot.has_value());
+            EXPECT_EQ(index.GetCluster(*clusterSlot)->clusterId, cluster.id);
+            EXPECT_EQ(index.GetDataVersion(*clusterSlot), emberAfDataVersionStorage(ConcreteClusterPath(endpoint.id, cluster.id)));
+
+            for (const MockAttributeConfig & attribute : cluster.attributes)
+            {
+                const ConcreteAttributePath path(endpoint.id, cluster.id, attribute.id);
+                std::optional<Slot> attributeSlot = index.FindAttribute(*clusterSlot, attribute.id);
+                ASSERT_TRUE(attributeSlot.has_value());
+                EXPECT_EQ(index.GetAttribute(*attributeSlot)->attributeId, attribute.id);
+                EXPECT_EQ(index.GetAttribute(*attributeSlot)->mask, attribute.attributeMetaData.mask);
+
+                DataModel::AttributeInfo expected;
+                Ember::LoadAttributeInfo(path, *index.GetAttribute(*attributeSlot), &expected);
+                const DataModel::AttributeInfo & info = index.GetAttributeInfo(*attributeSlot);
+                EXPECT_EQ(info.flags.Raw(), expected.flags.Raw());
+                EXPECT_EQ(info.readPrivilege, expected.readPrivilege);
+                EXPECT_EQ(info.writePrivilege, expected.writePrivilege);
+            }
+            EXPECT_FALSE(index.FindAttribute(*clusterSlot, MockAttributeId(100)).has_value());
+        }
+        EXPECT_FALSE(index.FindServerCluster(ConcreteClusterPath(endpoint.id, MockClusterId(100))).has_value());
+    }
+
+    // Clusters only exist on their own endpoint.
+    EXPECT_FALSE(index.FindServerCluster(ConcreteClusterPath(9, MockClusterId(7))).has_value());
+    EXPECT_FALSE(index.FindServerCluster(ConcreteClusterPath(3, MockClusterId(7))).has_value());
+}
+
+TEST_F(TestEmberMetadataIndex, AttributeAndCommandInfo)
+{
+    UseMockNodeConfig config(gUnsortedNodeConfig);
+    Ember::EmberMetadataIndex index;
+    ASSERT_EQ(index.Build(), CHIP_NO_ERROR);
+
+    std::optional<Slot> cluster = index.FindServerCluster(ConcreteClusterPath(2, MockClusterId(7)));
+    ASSERT_TRUE(cluster.has_value());
+
+    std::optional<Slot> attribute = index.FindAttribute(*cluster, kTimedWriteAttributeId);
+    ASSERT_TRUE(attribute.has_value());
+    EXPECT_TRUE(index.GetAttributeInfo(*attribute).flags.Has(DataModel::AttributeQualityFlags::kTimed));
+    EXPECT_FALSE(index.GetAttributeInfo(*attribute).flags.Has(DataModel::AttributeQualityFlags::kListAttribute));
+    EXPECT_TRUE(index.GetAttributeInfo(*attribute).writePrivilege.has_value());
+
+    attribute = index.FindAttribute(*cluster, kListAttributeId);
+    ASSERT_TRUE(attribute.has_value());
+    EXPECT_FALSE(index.GetAttributeInfo(*attribute).flags.Has(DataModel::AttributeQualityFlags::kTimed));
+    EXPECT_TRUE(index.GetAttributeInfo(*attribute).flags.Has(DataModel::AttributeQualityFlags::kListAttribute));
+
+    for (CommandId commandId : { 0x11u, 0x22u, 0x44u })
+    {
+        std::optional<Slot> command = index.FindAcceptedCommand(*cluster, commandId);
+        ASSERT_TRUE(command.has_value());
+
+        const DataModel::CommandInfo expected =
+            Ember::LoadAcceptedCommandInfo(ConcreteCommandPath(2, MockClusterId(7), commandId));
+        EXPECT_EQ(index.GetAcceptedCommandInfo(*command).flags.Raw(), expected.flags.Raw());
+        EXPECT_EQ(index.GetAcceptedCommandInfo(*command).invokePrivilege, expected.invokePrivilege);
+    }
+    EXPECT_FALSE(index.FindAcceptedCommand(*cluster, 0x33).has_value());
+    EXPECT_FALSE(index.FindAcceptedCommand(*cluster, kInvalidCommandId).has_value());
+
+    // Clusters without accepted commands
+    cluster = index.FindServerCluster(ConcreteClusterPath(2, MockClusterId(2)));
+    ASSERT_TRUE(cluster.has_value());
+    EXPECT_FALSE(index.FindAcceptedCommand(*cluster, 0x11).has_value());
+}
+
+TEST_F(TestEmberMetadataIndex, FindAttributeMetadataMatchesEmber)
+{
+    UseMockNodeConfig config(gUnsortedNodeConfig);
+    Ember::EmberMetadataIndex index;
+    ASSERT_EQ(index.Build(), CHIP_NO_ERROR);
+
+    const ConcreteAttributePath paths[] = {
+        ConcreteAttributePath(2, MockClusterId(7), MockAttributeId(5)),       // attribute
+        ConcreteAttributePath(2, MockClusterId(7), FeatureMap::Id),           // global attribute in metadata
+        ConcreteAttributePath(2, MockClusterId(7), AttributeList::Id),        // global attribute not in metadata
+        ConcreteAttributePath(9, MockClusterId(3), AcceptedCommandList::Id),  // global attribute not in metadata
+        ConcreteAttributePath(2, MockClusterId(7), MockAttributeId(100)),     // unsupported attribute
+        ConcreteAttributePath(2, MockClusterId(100), MockAttributeId(5)),     // unsupported cluster
+        ConcreteAttributePath(5, MockClusterId(7), AttributeList::Id),        // unsupported cluster, no clusters
+        ConcreteAttributePath(3, MockClusterId(7), MockAttributeId(5)),       // unsupported endpoint
+        ConcreteAttributePath(3, MockClusterId(7), GeneratedCommandList::Id), // unsupported endpoint
+    };
+
+    for (const ConcreteAttributePath & path : paths)
+    {
+        auto expected = Ember::FindAttributeMetadata(path);
+        auto actual   = index.FindAttributeMetadata(path);
+        ASSERT_EQ(actual.index(), expected.index());
+
+        // The mock ember configuration keeps copies of its metadata, so compare ids rather than pointers
+        if (const EmberAfCluster ** cluster = std::get_if<const EmberAfCluster *>(&actual))
+        {
+            EXPECT_EQ((*cluster)->clusterId, std::get<const EmberAfCluster *>(expected)->clusterId);
+        }
+        else if (const EmberAfAttributeMetadata ** attribute = std::get_if<const EmberAfAttributeMetadata *>(&actual))
+        {
+            EXPECT_EQ((*attribute)->attributeId, std::get<const EmberAfAttributeMetadata *>(expected)->attributeId);
+        }
+        else
+        {
+            EXPECT_EQ(std::get<Status>(actual), std::get<Status>(expected));
+        }
+    }
+
+    EXPECT_EQ(std::get<Status>(index.FindAttributeMetadata(paths[4])), Status::UnsupportedAttribute);
+    EXPECT_EQ(std::get<Status>(index.FindAttributeMetadata(paths[5])), Status::UnsupportedCluster);
+    EXPECT_EQ(std::get<Status>(index.FindAttributeMetadata(paths[7])), Status::UnsupportedEndpoint);
+}
+
+TEST_F(TestEmberMetadataIndex, RebuildAfterConfigurationChange)
+{
+    UseMockNodeConfig config(gUnsortedNodeConfig);
+    Ember::EmberMetadataIndex index;
+    ASSERT_EQ(index.Build(), CHIP_NO_ERROR);
+    EXPECT_TRUE(index.FindServerCluster(ConcreteClusterPath(2, MockClusterId(7))).has_value());
+
+    SetMockNodeConfig(gChangedNodeConfig);
+    EXPECT_FALSE(index.IsCurrent());
+
+    ASSERT_EQ(index.Build(), CHIP_NO_ERROR);
+    EXPECT_TRUE(index.IsCurrent());
+    EXPECT_EQ(index.EndpointCount(), 1u);
+    EXPECT_FALSE(index.HasEndpoint(9));
+    EXPECT_FALSE(index.FindServerCluster(ConcreteClusterPath(2, MockClusterId(7))).has_value());
+    EXPECT_TRUE(index.FindServerCluster(ConcreteClusterPath(2, MockClusterId(2))).has_value());
+
+    index.Clear();
+    EXPECT_FALSE(index.IsCurrent());
+    EXPECT_EQ(index.EndpointCount(), 0u);
+    EXPECT_FALSE(index.HasEndpoint(2));
+}
+
+} // namespace
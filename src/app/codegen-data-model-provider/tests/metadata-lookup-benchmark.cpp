@@ -0,0 +1,310 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the metadata lookups done by
+ *      CodegenDataModelProvider, with and without its metadata index
+ *      (CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX).
+ *
+ *      It models a bridge (200 bridged endpoints by default, each with
+ *      Descriptor, Bridged Device Basic Information, On/Off and Level Control
+ *      clusters) on top of the mock ember configuration, and looks up every
+ *      attribute and accepted command of it, in a shuffled order, the way
+ *      the provider does for:
+ *        - reads and writes: the attribute metadata (Ember::FindAttributeMetadata),
+ *        - attribute info: the attribute privileges and quality flags,
+ *        - cluster info: the cluster data version,
+ *        - command info: the accepted command privilege and flags.
+ *      Lookups without the index go through the ember search functions, which
+ *      are those of the mock here: they search the endpoints, clusters and
+ *      attributes in order, as the ones of src/app/util do.
+ *
+ *      Usage: metadata-lookup-benchmark [bridged-endpoint-count] [round-count]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <app-common/zap-generated/ids/Attributes.h>
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app-common/zap-generated/ids/Commands.h>
+#include <app/codegen-data-model-provider/EmberMetadata.h>
+#include <app/codegen-data-model-provider/EmberMetadataIndex.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/endpoint-config-api.h>
+#include <app/util/mock/Functions.h>
+#include <app/util/mock/MockNodeConfig.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+
+#include <algorithm>
+#include <variant>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+using namespace chip::Test;
+
+namespace {
+
+constexpr uint32_t kMaxBridgedEndpoints = 60000;
+
+MockNodeConfig BuildBridgeConfig(uint32_t bridgedEndpointCount)
+{
+    using namespace Globals::Attributes;
+
+    std::vector<MockEndpointConfig> endpoints;
+    endpoints.reserve(bridgedEndpointCount + 2);
+
+    // clang-format off
+    endpoints.push_back(MockEndpointConfig(kRootEndpointId, {
+        MockClusterConfig(Descriptor::Id, {
+            ClusterRevision::Id, FeatureMap::Id, Descriptor::Attributes::DeviceTypeList::Id,
+            Descriptor::Attributes::ServerList::Id, Descriptor::Attributes::ClientList::Id, Descriptor::Attributes::PartsList::Id,
+        }),
+    }));
+
+    // Aggregator
+    endpoints.push_back(MockEndpointConfig(1, {
+        MockClusterConfig(Descriptor::Id, {
+            ClusterRevision::Id, FeatureMap::Id, Descriptor::Attributes::DeviceTypeList::Id,
+            Descriptor::Attributes::ServerList::Id, Descriptor::Attributes::ClientList::Id, Descriptor::Attributes::PartsList::Id,
+        }),
+    }));
+
+    for (uint32_t i = 0; i < bridgedEndpointCount; i++)
+    {
+        endpoints.push_back(MockEndpointConfig(static_cast<EndpointId>(2 + i), {
+            MockClusterConfig(Descriptor::Id, {
+                ClusterRevision::Id, FeatureMap::Id, Descriptor::Attributes::DeviceTypeList::Id,
+                Descriptor::Attributes::ServerList::Id, Descriptor::Attributes::ClientList::Id,
+                Descriptor::Attributes::PartsList::Id,
+            }),
+            MockClusterConfig(BridgedDeviceBasicInformation::Id, {
+                ClusterRevision::Id, FeatureMap::Id, BridgedDeviceBasicInformation::Attributes::VendorName::Id,
+                BridgedDeviceBasicInformation::Attributes::ProductName::Id,
+                BridgedDeviceBasicInformation::Attributes::NodeLabel::Id,
+                BridgedDeviceBasicInformation::Attributes::Reachable::Id,
+                BridgedDeviceBasicInformation::Attributes::UniqueID::Id,
+            }),
+            MockClusterConfig(OnOff::Id, {
+                ClusterRevision::Id, FeatureMap::Id, OnOff::Attributes::OnOff::Id, OnOff::Attributes::GlobalSceneControl::Id,
+                OnOff::Attributes::OnTime::Id, OnOff::Attributes::OffWaitTime::Id, OnOff::Attributes::StartUpOnOff::Id,
+            }, {}, {
+                OnOff::Commands::Off::Id, OnOff::Commands::On::Id, OnOff::Commands::Toggle::Id,
+            }),
+            MockClusterConfig(LevelControl::Id, {
+                ClusterRevision::Id, FeatureMap::Id, LevelControl::Attributes::CurrentLevel::Id,
+                LevelControl::Attributes::RemainingTime::Id, LevelControl::Attributes::MinLevel::Id,
+                LevelControl::Attributes::MaxLevel::Id, LevelControl::Attributes::OnOffTransitionTime::Id,
+                LevelControl::Attributes::OnLevel::Id, LevelControl::Attributes::Options::Id,
+                LevelControl::Attributes::StartUpCurrentLevel::Id,
+            }, {}, {
+                LevelControl::Commands::MoveToLevel::Id, LevelControl::Commands::Move::Id, LevelControl::Commands::Step::Id,
+                LevelControl::Commands::Stop::Id, LevelControl::Commands::MoveToLevelWithOnOff::Id,
+                LevelControl::Commands::MoveWithOnOff::Id, LevelControl::Commands::StepWithOnOff::Id,
+                LevelControl::Commands::StopWithOnOff::Id,
+            }),
+        }));
+    }
+    // clang-format on
+
+    return MockNodeConfig(endpoints);
+}
+
+/// Shuffles the paths in a fixed order, so that consecutive lookups do not hit the same endpoint.
+template <typename Path>
+void Shuffle(std::vector<Path> & paths)
+{
+    uint32_t state = 0x12345678;
+    for (size_t i = paths.size(); i > 1; i--)
+    {
+        state = state * 1664525u + 1013904223u;
+        std::swap(paths[i - 1], paths[state % i]);
+    }
+}
+
+/// Lookups as the provider does them without the index
+struct EmberLookup
+{
+    static bool AttributeMetadata(const ConcreteAttributePath & path)
+    {
+        return !std::holds_alternative<Protocols::InteractionModel::Status>(Ember::FindAttributeMetadata(path));
+    }
+
+    static bool AttributeInfo(const ConcreteAttributePath & path)
+    {
+        const EmberAfCluster * cluster = emberAfFindServerCluster(path.mEndpointId, path.mClusterId);
+        VerifyOrReturnValue(cluster != nullptr, false);
+        for (unsigned i = 0; i < cluster->attributeCount; i++)
+        {
+            if (cluster->attributes[i].attributeId == path.mAttributeId)
+            {
+                DataModel::AttributeInfo info;
+                Ember::LoadAttributeInfo(path, cluster->attributes[i], &info);
+                return info.readPrivilege.has_value();
+            }
+        }
+        return false;
+    }
+
+    static bool ClusterInfo(const ConcreteAttributePath & path)
+    {
+        const EmberAfCluster * cluster = emberAfFindServerCluster(path.mEndpointId, path.mClusterId);
+        VerifyOrReturnValue(cluster != nullptr, false);
+        return emberAfDataVersionStorage(path) != nullptr;
+    }
+
+    static bool CommandInfo(const ConcreteCommandPath & path)
+    {
+        const EmberAfCluster * cluster = emberAfFindServerCluster(path.mEndpointId, path.mClusterId);
+        VerifyOrReturnValue(cluster != nullptr, false);
+        for (const CommandId * command = cluster->acceptedCommandList; (command != nullptr) && (*command != kInvalidCommandId);
+             command++)
+        {
+            if (*command == path.mCommandId)
+            {
+                return Ember::LoadAcceptedCommandInfo(path).invokePrivilege != Access::Privilege::kView;
+            }
+        }
+        return false;
+    }
+};
+
+/// Lookups as the provider does them with the index
+struct IndexLookup
+{
+    static const Ember::EmberMetadataIndex * sIndex;
+
+    static bool AttributeMetadata(const ConcreteAttributePath & path)
+    {
+        return !std::holds_alternative<Protocols::InteractionModel::Status>(sIndex->FindAttributeMetadata(path));
+    }
+
+    static bool AttributeInfo(const ConcreteAttributePath & path)
+    {
+        std::optional<Ember::EmberMetadataIndex::Slot> cluster = sIndex->FindServerCluster(path);
+        VerifyOrReturnValue(cluster.has_value(), false);
+        std::optional<Ember::EmberMetadataIndex::Slot> attribute = sIndex->FindAttribute(*cluster, path.mAttributeId);
+        VerifyOrReturnValue(attribute.has_value(), false);
+        return sIndex->GetAttributeInfo(*attribute).readPrivilege.has_value();
+    }
+
+    static bool ClusterInfo(const ConcreteAttributePath & path)
+    {
+        std::optional<Ember::EmberMetadataIndex::Slot> cluster = sIndex->FindServerCluster(path);
+        VerifyOrReturnValue(cluster.has_value(), false);
+        return sIndex->GetDataVersion(*cluster) != nullptr;
+    }
+
+    static bool CommandInfo(const ConcreteCommandPath & path)
+    {
+        std::optional<Ember::EmberMetadataIndex::Slot> cluster = sIndex->FindServerCluster(path);
+        VerifyOrReturnValue(cluster.has_value(), false);
+        std::optional<Ember::EmberMetadataIndex::Slot> command = sIndex->FindAcceptedCommand(*cluster, path.mCommandId);
+        VerifyOrReturnValue(command.has_value(), false);
+        return sIndex->GetAcceptedCommandInfo(*command).invokePrivilege != Access::Privilege::kView;
+    }
+};
+
+const Ember::EmberMetadataIndex * IndexLookup::sIndex = nullptr;
+
+template <typename Path, typename Lookup>
+double Run(const std::vector<Path> & paths, uint32_t roundCount, Lookup lookup)
+{
+    size_t found = 0;
+
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t round = 0; round < roundCount; round++)
+    {
+        for (const Path & path : paths)
+        {
+            found += lookup(path) ? 1 : 0;
+        }
+    }
+    const double elapsed = ElapsedNanoseconds(start);
+
+    // Every path exists, so every lookup must find it.
+    VerifyOrDie(found == paths.size() * roundCount);
+    return elapsed / static_cast<double>(paths.size() * roundCount);
+}
+
+void Print(const char * name, double ember, double index)
+{
+    printf("  %-20s %8.1f ns/lookup searching, %8.1f ns/lookup indexed (x%.2f)\n", name, ember, index, ember / index);
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t bridgedEndpointCount = std::min(std::max(1u, ParseArg(argc, argv, 1, 200)), kMaxBridgedEndpoints);
+    const uint32_t roundCount           = std::max(1u, ParseArg(argc, argv, 2, 5));
+
+    ScopedPlatformMemory platformMemory;
+
+    const MockNodeConfig bridgeConfig = BuildBridgeConfig(bridgedEndpointCount);
+    SetMockNodeConfig(bridgeConfig);
+
+    std::vector<ConcreteAttributePath> attributePaths;
+    std::vector<ConcreteCommandPath> commandPaths;
+    for (const MockEndpointConfig & endpoint : bridgeConfig.endpoints)
+    {
+        for (const MockClusterConfig & cluster : endpoint.clusters)
+        {
+            for (const MockAttributeConfig & attribute : cluster.attributes)
+            {
+                attributePaths.emplace_back(endpoint.id, cluster.id, attribute.id);
+            }
+            const CommandId * commands = cluster.emberCluster()->acceptedCommandList;
+            for (; (commands != nullptr) && (*commands != kInvalidCommandId); commands++)
+            {
+                commandPaths.emplace_back(endpoint.id, cluster.id, *commands);
+            }
+        }
+    }
+    Shuffle(attributePaths);
+    Shuffle(commandPaths);
+
+    Ember::EmberMetadataIndex index;
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    VerifyOrDie(index.Build() == CHIP_NO_ERROR);
+    const double build = ElapsedNanoseconds(start);
+    IndexLookup::sIndex = &index;
+
+    printf("Metadata lookup benchmark: %" PRIu32 " bridged endpoints, %zu attributes, %zu commands, %" PRIu32 " rounds\n",
+           bridgedEndpointCount, attributePaths.size(), commandPaths.size(), roundCount);
+    printf("  index built in %.1f us: %zu endpoints, %zu clusters, %zu attributes, %zu accepted commands\n", build / 1000.0,
+           index.EndpointCount(), index.ClusterCount(), index.AttributeCount(), index.AcceptedCommandCount());
+
+    Print("attribute metadata:", Run(attributePaths, roundCount, EmberLookup::AttributeMetadata),
+          Run(attributePaths, roundCount, IndexLookup::AttributeMetadata));
+    Print("attribute info:", Run(attributePaths, roundCount, EmberLookup::AttributeInfo),
+          Run(attributePaths, roundCount, IndexLookup::AttributeInfo));
+    Print("cluster info:", Run(attributePaths, roundCount, EmberLookup::ClusterInfo),
+          Run(attributePaths, roundCount, IndexLookup::ClusterInfo));
+    Print("command info:", Run(commandPaths, roundCount, EmberLookup::CommandInfo),
+          Run(commandPaths, roundCount, IndexLookup::CommandInfo));
+
+    index.Clear();
+    ResetMockNodeConfig();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,255 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the wildcard path expansion done
+ *      when priming subscriptions, over a CodegenDataModelProvider.
+ *
+ *      It models a bridge (200 bridged endpoints by default, each with
+ *      Descriptor, Bridged Device Basic Information, On/Off and Level Control
+ *      clusters) on top of the mock ember configuration. 1 then 5 full wildcard
+ *      subscriptions are primed concurrently: like reporting::Engine does, each
+ *      report takes the next 32 paths of one subscription, in turn. Paths are
+ *      expanded by AttributePathExpandIteratorDataModel with the provider
+ *      searching for the previous path on every step, then with metadata
+ *      cursors, and by AttributePathExpandIteratorEmber when it is built.
+ *      Only path expansion is measured, not attribute reads or encoding.
+ *
+ *      Usage: wildcard-priming-benchmark [bridged-endpoint-count] [round-count]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <app-common/zap-generated/ids/Attributes.h>
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app/AppConfig.h>
+#include <app/AttributePathParams.h>
+#include <app/codegen-data-model-provider/CodegenDataModelProvider.h>
+#include <app/util/mock/Functions.h>
+#include <app/util/mock/MockNodeConfig.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/LinkedList.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+
+#if CHIP_CONFIG_USE_DATA_MODEL_INTERFACE
+#include <app/AttributePathExpandIterator-DataModel.h>
+#endif
+#if CHIP_CONFIG_USE_EMBER_DATA_MODEL && CHIP_CONFIG_USE_DATA_MODEL_INTERFACE
+#include <app/AttributePathExpandIterator-Ember.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+using namespace chip::Test;
+
+namespace {
+
+constexpr uint32_t kSubscriptionCounts[] = { 1, 5 };
+constexpr uint32_t kPathsPerReport       = 32;
+constexpr uint32_t kMaxBridgedEndpoints  = 60000;
+
+/// The `before` path based iteration the metadata tree offered before cursors: the
+/// iterator is the same, but the provider has to find its position on every call.
+class ProviderWithoutCursors : public CodegenDataModelProvider
+{
+public:
+    EndpointId FirstEndpointWithCursor(DataModel::MetadataCursor & cursor) override { return FirstEndpoint(); }
+    EndpointId NextEndpointWithCursor(EndpointId before, DataModel::MetadataCursor & cursor) override
+    {
+        return NextEndpoint(before);
+    }
+    DataModel::ClusterEntry FirstClusterWithCursor(EndpointId endpoint, DataModel::MetadataCursor & cursor) override
+    {
+        return FirstCluster(endpoint);
+    }
+    DataModel::ClusterEntry NextClusterWithCursor(const ConcreteClusterPath & before, DataModel::MetadataCursor & cursor) override
+    {
+        return NextCluster(before);
+    }
+    DataModel::AttributeEntry FirstAttributeWithCursor(const ConcreteClusterPath & cluster,
+                                                       DataModel::MetadataCursor & cursor) override
+    {
+        return FirstAttribute(cluster);
+    }
+    DataModel::AttributeEntry NextAttributeWithCursor(const ConcreteAttributePath & before,
+                                                      DataModel::MetadataCursor & cursor) override
+    {
+        return NextAttribute(before);
+    }
+};
+
+MockNodeConfig BuildBridgeConfig(uint32_t bridgedEndpointCount)
+{
+    using namespace Globals::Attributes;
+
+    std::vector<MockEndpointConfig> endpoints;
+    endpoints.reserve(bridgedEndpointCount + 2);
+
+    // clang-format off
+    endpoints.push_back(MockEndpointConfig(kRootEndpointId, {
+        MockClusterConfig(Descriptor::Id, {
+            ClusterRevision::Id, FeatureMap::Id, Descriptor::Attributes::DeviceTypeList::Id,
+            Descriptor::Attributes::ServerList::Id, Descriptor::Attributes::ClientList::Id, Descriptor::Attributes::PartsList::Id,
+        }),
+        MockClusterConfig(BasicInformation::Id, {
+            ClusterRevision::Id, FeatureMap::Id, BasicInformation::Attributes::DataModelRevision::Id,
+            BasicInformation::Attributes::VendorName::Id, BasicInformation::Attributes::VendorID::Id,
+            BasicInformation::Attributes::ProductName::Id, BasicInformation::Attributes::ProductID::Id,
+            BasicInformation::Attributes::NodeLabel::Id, BasicInformation::Attributes::Location::Id,
+            BasicInformation::Attributes::HardwareVersion::Id, BasicInformation::Attributes::SoftwareVersion::Id,
+        }),
+    }));
+
+    // Aggregator
+    endpoints.push_back(MockEndpointConfig(1, {
+        MockClusterConfig(Descriptor::Id, {
+            ClusterRevision::Id, FeatureMap::Id, Descriptor::Attributes::DeviceTypeList::Id,
+            Descriptor::Attributes::ServerList::Id, Descriptor::Attributes::ClientList::Id, Descriptor::Attributes::PartsList::Id,
+        }),
+    }));
+
+    for (uint32_t i = 0; i < bridgedEndpointCount; i++)
+    {
+        endpoints.push_back(MockEndpointConfig(static_cast<EndpointId>(2 + i), {
+            MockClusterConfig(Descriptor::Id, {
+                ClusterRevision::Id, FeatureMap::Id, Descriptor::Attributes::DeviceTypeList::Id,
+                Descriptor::Attributes::ServerList::Id, Descriptor::Attributes::ClientList::Id,
+                Descriptor::Attributes::PartsList::Id,
+            }),
+            MockClusterConfig(BridgedDeviceBasicInformation::Id, {
+                ClusterRevision::Id, FeatureMap::Id, BridgedDeviceBasicInformation::Attributes::VendorName::Id,
+                BridgedDeviceBasicInformation::Attributes::ProductName::Id,
+                BridgedDeviceBasicInformation::Attributes::NodeLabel::Id,
+                BridgedDeviceBasicInformation::Attributes::Reachable::Id,
+                BridgedDeviceBasicInformation::Attributes::UniqueID::Id,
+            }),
+            MockClusterConfig(OnOff::Id, {
+                ClusterRevision::Id, FeatureMap::Id, OnOff::Attributes::OnOff::Id, OnOff::Attributes::GlobalSceneControl::Id,
+                OnOff::Attributes::OnTime::Id, OnOff::Attributes::OffWaitTime::Id, OnOff::Attributes::StartUpOnOff::Id,
+            }),
+            MockClusterConfig(LevelControl::Id, {
+                ClusterRevision::Id, FeatureMap::Id, LevelControl::Attributes::CurrentLevel::Id,
+                LevelControl::Attributes::RemainingTime::Id, LevelControl::Attributes::MinLevel::Id,
+                LevelControl::Attributes::MaxLevel::Id, LevelControl::Attributes::OnOffTransitionTime::Id,
+                LevelControl::Attributes::OnLevel::Id, LevelControl::Attributes::Options::Id,
+                LevelControl::Attributes::StartUpCurrentLevel::Id,
+            }),
+        }));
+    }
+    // clang-format on
+
+    return MockNodeConfig(endpoints);
+}
+
+/// Primes subscriptionCount full wildcard subscriptions, one report of kPathsPerReport
+/// paths at a time, and returns the number of paths expanded for all of them.
+template <typename Iterator>
+size_t Prime(DataModel::Provider * provider, SingleLinkedListNode<AttributePathParams> * paths, uint32_t subscriptionCount)
+{
+    std::vector<Iterator> iterators(subscriptionCount, Iterator(provider, paths));
+    size_t pathCount = 0;
+    bool priming     = true;
+
+    while (priming)
+    {
+        priming = false;
+        for (Iterator & iterator : iterators)
+        {
+            ConcreteAttributePath path;
+            for (uint32_t i = 0; (i < kPathsPerReport) && iterator.Get(path); i++)
+            {
+                pathCount++;
+                iterator.Next();
+            }
+            priming = iterator.Get(path) || priming;
+        }
+    }
+
+    return pathCount;
+}
+
+template <typename Iterator>
+double Run(DataModel::Provider * provider, uint32_t subscriptionCount, uint32_t roundCount, size_t & pathCount)
+{
+    SingleLinkedListNode<AttributePathParams> wildcard;
+
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t round = 0; round < roundCount; round++)
+    {
+        pathCount = Prime<Iterator>(provider, &wildcard, subscriptionCount);
+    }
+    return ElapsedNanoseconds(start);
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+#if CHIP_CONFIG_USE_DATA_MODEL_INTERFACE
+    const uint32_t bridgedEndpointCount = std::min(std::max(1u, ParseArg(argc, argv, 1, 200)), kMaxBridgedEndpoints);
+    const uint32_t roundCount           = std::max(1u, ParseArg(argc, argv, 2, 5));
+
+    ScopedPlatformMemory platformMemory;
+
+    const MockNodeConfig bridgeConfig = BuildBridgeConfig(bridgedEndpointCount);
+    SetMockNodeConfig(bridgeConfig);
+
+    ProviderWithoutCursors withoutCursors;
+    CodegenDataModelProvider withCursors;
+
+    printf("Wildcard priming benchmark: %" PRIu32 " bridged endpoints, %" PRIu32 " rounds, %" PRIu32 " paths per report\n",
+           bridgedEndpointCount, roundCount, kPathsPerReport);
+
+    for (uint32_t subscriptionCount : kSubscriptionCounts)
+    {
+        size_t searchPathCount = 0;
+        size_t cursorPathCount = 0;
+        const double search =
+            Run<AttributePathExpandIteratorDataModel>(&withoutCursors, subscriptionCount, roundCount, searchPathCount);
+        const double cursor =
+            Run<AttributePathExpandIteratorDataModel>(&withCursors, subscriptionCount, roundCount, cursorPathCount);
+        VerifyOrDie(searchPathCount == cursorPathCount);
+
+        const double pathsPerRound = static_cast<double>(cursorPathCount);
+        printf("  %" PRIu32 " subscriptions, %zu paths each: %8.1f ns/path searching, %8.1f ns/path with cursors (x%.2f)\n",
+               subscriptionCount, cursorPathCount / subscriptionCount, search / roundCount / pathsPerRound,
+               cursor / roundCount / pathsPerRound, search / cursor);
+
+#if CHIP_CONFIG_USE_EMBER_DATA_MODEL
+        size_t emberPathCount = 0;
+        const double ember    = Run<AttributePathExpandIteratorEmber>(&withCursors, subscriptionCount, roundCount, emberPathCount);
+        VerifyOrDie(emberPathCount == cursorPathCount);
+        printf("  %" PRIu32 " subscriptions, ember iterator: %8.1f ns/path\n", subscriptionCount,
+               ember / roundCount / pathsPerRound);
+#endif // CHIP_CONFIG_USE_EMBER_DATA_MODEL
+    }
+
+    ResetMockNodeConfig();
+    return EXIT_SUCCESS;
+#else
+    printf("Wildcard priming benchmark: requires the data model interface (chip_use_data_model_interface)\n");
+    return EXIT_SUCCESS;
+#endif // CHIP_CONFIG_USE_DATA_MODEL_INTERFACE
+}
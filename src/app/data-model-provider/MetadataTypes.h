@@ -105,6 +105,23 @@ struct CommandEntry
     static const CommandEntry kInvalid;
 };
 
+/// Opaque position of an endpoint/cluster/attribute iteration, kept by the caller between
+/// `*WithCursor` iteration calls.
+///
+/// Its content is defined by the provider (e.g. indexes into its own metadata tables) and
+/// callers must not interpret it. A default-constructed cursor is valid and carries no position.
+/// A cursor that does not match the `before` path it is given (e.g. because the data model
+/// structure changed) is ignored and fixed by the provider, so it is never a correctness issue,
+/// only a performance one.
+struct MetadataCursor
+{
+    static constexpr uint32_t kUnknownIndex = UINT32_MAX;
+
+    uint32_t endpointIndex  = kUnknownIndex;
+    uint32_t clusterIndex   = kUnknownIndex;
+    uint32_t attributeIndex = kUnknownIndex;
+};
+
 /// Provides metadata information for a data model
 ///
 /// The data model can be viewed as a tree of endpoint/cluster/(attribute+commands+events)
@@ -121,6 +138,12 @@ struct CommandEntry
 ///       are returned, when iterating over a cluster, all attributes/commands are iterated over)
 ///     - uniqueness and completeness (iterate over all possible distinct values as long as no
 ///       internal structural changes occur)
+///
+/// `Next*` calls only get the `before` path, so a provider has to locate it again on every call.
+/// The `*WithCursor` variants additionally get a `MetadataCursor` that the provider updates on
+/// every call, so that iterating does not need to search (e.g. when many iterations are interleaved,
+/// like wildcard subscriptions priming reports over several chunks). Their default implementation
+/// ignores the cursor and uses the `before` path calls.
 class ProviderMetadataTree
 {
 public:
@@ -139,6 +162,23 @@ public:
     virtual AttributeEntry NextAttribute(const ConcreteAttributePath & before)                = 0;
     virtual std::optional<AttributeInfo> GetAttributeInfo(const ConcreteAttributePath & path) = 0;
 
+    // Tree iteration that resumes from a caller-kept position
+    virtual EndpointId FirstEndpointWithCursor(MetadataCursor & cursor) { return FirstEndpoint(); }
+    virtual EndpointId NextEndpointWithCursor(EndpointId before, MetadataCursor & cursor) { return NextEndpoint(before); }
+    virtual ClusterEntry FirstClusterWithCursor(EndpointId endpoint, MetadataCursor & cursor) { return FirstCluster(endpoint); }
+    virtual ClusterEntry NextClusterWithCursor(const ConcreteClusterPath & before, MetadataCursor & cursor)
+    {
+        return NextCluster(before);
+    }
+    virtual AttributeEntry FirstAttributeWithCursor(const ConcreteClusterPath & cluster, MetadataCursor & cursor)
+    {
+        return FirstAttribute(cluster);
+    }
+    virtual AttributeEntry NextAttributeWithCursor(const ConcreteAttributePath & before, MetadataCursor & cursor)
+    {
+        return NextAttribute(before);
+    }
+
     // Command iteration and accessors provide cluster-level access over commands
     virtual CommandEntry FirstAcceptedCommand(const ConcreteClusterPath & cluster)              = 0;
     virtual CommandEntry NextAcceptedCommand(const ConcreteCommandPath & before)                = 0;
@@ -372,6 +372,22 @@ const EmberAfEndpointType * emberAfFindEndpointType(EndpointId endpoint)
     return nullptr;
 }
 
+const EmberAfEndpointType * emberAfEndpointTypeFromIndex(uint16_t index)
+{
+    if (index == 0)
+    {
+        return &otaProviderEndpoint;
+    }
+
+    return nullptr;
+}
+
+uint32_t emberAfEndpointConfigurationGeneration()
+{
+    // The single OTA provider endpoint never changes.
+    return 0;
+}
+
 const EmberAfCluster * emberAfFindServerCluster(EndpointId endpoint, ClusterId cluster)
 {
     if (endpoint == kSupportedEndpoint && cluster == Clusters::OtaSoftwareUpdateProvider::Id)
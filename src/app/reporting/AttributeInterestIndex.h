@@ -0,0 +1,197 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/LinkedList.h>
+#include <lib/support/Pool.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * An inverted index from attribute paths to the readers interested in them.
+ *
+ * Every interest path of a reader is stored under its (endpoint, cluster, attribute) key, where any of the three may be a
+ * wildcard. The keys are hashed into kBucketCount buckets. Looking up the readers interested in a concrete path probes
+ * one key per combination of wildcards (at most 8), skipping the combinations no reader uses, so that the cost depends on
+ * the number of interested readers rather than on the total number of interest paths.
+ *
+ * The index does not dereference readers. A reader must be removed, with the same path list it was added with, before
+ * either of them goes away.
+ */
+template <class Reader, size_t kEntryPoolSize, size_t kBucketCount>
+class AttributeInterestIndex
+{
+public:
+    using PathList = SingleLinkedListNode<AttributePathParams>;
+
+    static_assert(kBucketCount > 0 && (kBucketCount & (kBucketCount - 1)) == 0, "kBucketCount must be a power of two");
+
+    AttributeInterestIndex() { Clear(); }
+    ~AttributeInterestIndex() { Clear(); }
+
+    /**
+     * Add every path of aPaths as an interest of aReader.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY if the index is full, in which case none of the paths are added.
+     */
+    CHIP_ERROR Add(Reader & aReader, const PathList * aPaths)
+    {
+        for (auto path = aPaths; path != nullptr; path = path->mpNext)
+        {
+            Entry * entry = mEntryPool.CreateObject(aReader, path->mValue);
+            if (entry == nullptr)
+            {
+                Remove(aReader, aPaths);
+                return CHIP_ERROR_NO_MEMORY;
+            }
+
+            Entry *& head = mBuckets[BucketIndex(entry->mEndpointId, entry->mClusterId, entry->mAttributeId)];
+            entry->mpNext = head;
+            head          = entry;
+            mShapeCount[entry->Shape()]++;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Remove the interests of aReader that were added with aPaths.
+     */
+    void Remove(Reader & aReader, const PathList * aPaths)
+    {
+        for (auto path = aPaths; path != nullptr; path = path->mpNext)
+        {
+            const AttributePathParams & params = path->mValue;
+
+            // Removes every entry of the reader in the bucket, including those for its other paths that share it.
+            Entry ** link = &mBuckets[BucketIndex(params.mEndpointId, params.mClusterId, params.mAttributeId)];
+            while (*link != nullptr)
+            {
+                Entry * entry = *link;
+                if (entry->mpReader != &aReader)
+                {
+                    link = &entry->mpNext;
+                    continue;
+                }
+
+                *link = entry->mpNext;
+                mShapeCount[entry->Shape()]--;
+                mEntryPool.ReleaseObject(entry);
+            }
+        }
+    }
+
+    /**
+     * Call aFunction(Reader &) for each reader with an interest path that intersects aPath, which must be concrete: it may
+     * not have a wildcard endpoint, cluster or attribute.
+     *
+     * A reader with several such paths is visited once per path.
+     *
+     * @retval Loop::Break if aFunction returned Loop::Break, Loop::Finish otherwise.
+     */
+    template <typename Function>
+    Loop ForEachInterestedReader(const AttributePathParams & aPath, Function && aFunction) const
+    {
+        for (uint8_t shape = 0; shape < kShapeCount; shape++)
+        {
+            if (mShapeCount[shape] == 0)
+            {
+                continue;
+            }
+
+            const EndpointId endpointId   = (shape & kWildcardEndpoint) ? kInvalidEndpointId : aPath.mEndpointId;
+            const ClusterId clusterId     = (shape & kWildcardCluster) ? kInvalidClusterId : aPath.mClusterId;
+            const AttributeId attributeId = (shape & kWildcardAttribute) ? kInvalidAttributeId : aPath.mAttributeId;
+
+            for (Entry * entry = mBuckets[BucketIndex(endpointId, clusterId, attributeId)]; entry != nullptr;
+                 entry         = entry->mpNext)
+            {
+                if (entry->mEndpointId == endpointId && entry->mClusterId == clusterId && entry->mAttributeId == attributeId)
+                {
+                    VerifyOrReturnValue(aFunction(*entry->mpReader) == Loop::Continue, Loop::Break);
+                }
+            }
+        }
+        return Loop::Finish;
+    }
+
+    void Clear()
+    {
+        mEntryPool.ReleaseAll();
+        for (auto & bucket : mBuckets)
+        {
+            bucket = nullptr;
+        }
+        for (auto & count : mShapeCount)
+        {
+            count = 0;
+        }
+    }
+
+    size_t GetEntryCount() const { return mEntryPool.Allocated(); }
+
+private:
+    // The wildcard components of a key.
+    enum Shape : uint8_t
+    {
+        kWildcardEndpoint  = 0x01,
+        kWildcardCluster   = 0x02,
+        kWildcardAttribute = 0x04,
+    };
+    static constexpr uint8_t kShapeCount = 8;
+
+    struct Entry
+    {
+        Entry(Reader & aReader, const AttributePathParams & aPath) :
+            mpReader(&aReader), mEndpointId(aPath.mEndpointId), mClusterId(aPath.mClusterId), mAttributeId(aPath.mAttributeId)
+        {}
+
+        uint8_t Shape() const
+        {
+            return static_cast<uint8_t>((mEndpointId == kInvalidEndpointId ? kWildcardEndpoint : 0) |
+                                        (mClusterId == kInvalidClusterId ? kWildcardCluster : 0) |
+                                        (mAttributeId == kInvalidAttributeId ? kWildcardAttribute : 0));
+        }
+
+        Reader * mpReader;
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        AttributeId mAttributeId;
+        Entry * mpNext = nullptr;
+    };
+
+    static size_t BucketIndex(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId)
+    {
+        uint32_t hash = (aEndpointId * 0x9E3779B1u) ^ (aClusterId * 0x85EBCA77u) ^ (aAttributeId * 0xC2B2AE3Du);
+        hash ^= hash >> 16;
+        return static_cast<size_t>(hash) & (kBucketCount - 1);
+    }
+
+    Entry * mBuckets[kBucketCount];
+    size_t mShapeCount[kShapeCount];
+    ObjectPool<Entry, kEntryPoolSize> mEntryPool;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
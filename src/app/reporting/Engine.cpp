@@ -35,6 +35,7 @@
 #include <app/reporting/Read.h>
 #include <app/util/MatterCallbacks.h>
 #include <app/util/ember-compatibility-functions.h>
+#include <tracing/metric_event.h>
 
 using namespace chip::Access;
 
@@ -59,6 +60,22 @@ void Engine::Shutdown()
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
     mGlobalDirtySet.ReleaseAll();
+#if CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX
+    mAttributeInterestIndex.Clear();
+#endif
+#if CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS
+    ReleaseSharedAttributeReport();
+#endif
+#if CHIP_IM_SERVER_LIST_ITEM_CARRY
+    ReleaseListItemCarry();
+#endif
+#if CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE > 0
+    mDirtyPathBatchCount = 0;
+    mDirtyPathBatchDepth = 0;
+#endif
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+    mReportVirtualTime = 0;
+#endif
 }
 
 bool Engine::IsClusterDataVersionMatch(const SingleLinkedListNode<DataVersionFilter> * aDataVersionFilterList,
@@ -183,9 +200,15 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             ConcreteReadAttributePath pathForRetrieval(readPath);
             // Load the saved state from previous encoding session for chunking of one single attribute (list chunking).
             AttributeEncodeState encodeState = apReadHandler->GetAttributeEncodeState();
+#if CHIP_IM_SERVER_LIST_ITEM_CARRY
+            encodeState.SetListItemCarry(ListItemCarryFor(*apReadHandler));
+#endif
             DataModel::ActionReturnStatus status =
                 Impl::RetrieveClusterData(mpImEngine->GetDataModelProvider(), apReadHandler->GetSubjectDescriptor(),
                                           apReadHandler->IsFabricFiltered(), attributeReportIBs, pathForRetrieval, &encodeState);
+#if CHIP_IM_SERVER_LIST_ITEM_CARRY
+            UpdateListItemCarryHolder(*apReadHandler, !status.IsOutOfSpaceEncodingResponse());
+#endif
             if (status.IsError())
             {
                 // Operation error set, since this will affect early return or override on status encoding
@@ -251,6 +274,14 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
         hasMoreChunks = false;
     }
 exit:
+#if CHIP_IM_SERVER_LIST_ITEM_CARRY
+    if (mListItemCarry.mpHolder == nullptr)
+    {
+        // Nothing to carry to a next chunk: do not keep the buffer between reports.
+        ReleaseListItemCarry();
+    }
+#endif
+
     if (attributeReportIBs.GetWriter()->GetLengthWritten() != emptyReportDataLength)
     {
         // We may encounter BUFFER_TOO_SMALL with nothing actually written for the case of list chunking, so we check if we have
@@ -373,6 +404,160 @@ CHIP_ERROR Engine::CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool &
     return err;
 }
 
+CHIP_ERROR Engine::BuildSharedAttributeReportIBs(ReportDataMessage::Builder & aReportDataBuilder, ReadHandler * apReadHandler,
+                                                 bool * apHasMoreChunks, bool * apHasEncodedData)
+{
+#if CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS
+    TLV::TLVWriter * writer = aReportDataBuilder.GetWriter();
+    if (!CanShareAttributeReport(*apReadHandler))
+    {
+        return BuildSingleReportDataAttributeReportIBs(aReportDataBuilder, apReadHandler, apHasMoreChunks, apHasEncodedData);
+    }
+
+    if (IsSharedAttributeReportFor(*apReadHandler))
+    {
+        // If this report has less room than the one the data was encoded for, it is encoded again below.
+        if (mSharedAttributeReport.mReport.CopyTo(*writer) == CHIP_NO_ERROR)
+        {
+            ChipLogDetail(DataManagement, "Reusing %u bytes of attribute data encoded for another ReadHandler",
+                          static_cast<unsigned>(mSharedAttributeReport.mReport.GetLength()));
+            *apHasMoreChunks  = false;
+            *apHasEncodedData = mSharedAttributeReport.mReport.HasAttributeReportIBs();
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    if (!HasOtherReportableHandlerWithSameAttributeReport(*apReadHandler))
+    {
+        return BuildSingleReportDataAttributeReportIBs(aReportDataBuilder, apReadHandler, apHasMoreChunks, apHasEncodedData);
+    }
+
+    // Encode the attribute data aside, with exactly the room this report has, then copy it into the report.
+    ReleaseSharedAttributeReport();
+    CHIP_ERROR err = mSharedAttributeReport.mReport.Encode(
+        writer->GetRemainingFreeLength(), [&](ReportDataMessage::Builder & reportDataBuilder) {
+            return BuildSingleReportDataAttributeReportIBs(reportDataBuilder, apReadHandler, apHasMoreChunks, apHasEncodedData);
+        });
+    if (mSharedAttributeReport.mReport.IsNull())
+    {
+        // No buffer to encode into, so there is nothing to share.
+        return BuildSingleReportDataAttributeReportIBs(aReportDataBuilder, apReadHandler, apHasMoreChunks, apHasEncodedData);
+    }
+    if (err == CHIP_NO_ERROR)
+    {
+        err = mSharedAttributeReport.mReport.CopyTo(*writer);
+    }
+
+    // The data of a report that does not fit in one chunk depends on the chunks before it, so only whole reports are shared.
+    if (err != CHIP_NO_ERROR || *apHasMoreChunks)
+    {
+        ReleaseSharedAttributeReport();
+        return err;
+    }
+
+    mSharedAttributeReport.mpSource                        = apReadHandler;
+    mSharedAttributeReport.mSubjectDescriptor              = apReadHandler->GetSubjectDescriptor();
+    mSharedAttributeReport.mDirtyGeneration                = mDirtyGeneration;
+    mSharedAttributeReport.mPreviousReportsBeginGeneration = apReadHandler->mPreviousReportsBeginGeneration;
+    mSharedAttributeReport.mFabricFiltered                 = apReadHandler->IsFabricFiltered();
+    return CHIP_NO_ERROR;
+#else
+    return BuildSingleReportDataAttributeReportIBs(aReportDataBuilder, apReadHandler, apHasMoreChunks, apHasEncodedData);
+#endif // CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS
+}
+
+#if CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS
+static bool IsSameSubject(const SubjectDescriptor & aSubject, const SubjectDescriptor & aOther)
+{
+    return aSubject.fabricIndex == aOther.fabricIndex && aSubject.authMode == aOther.authMode &&
+        aSubject.subject == aOther.subject && aSubject.cats == aOther.cats && aSubject.isCommissioning == aOther.isCommissioning;
+}
+
+static bool IsSamePathList(const SingleLinkedListNode<AttributePathParams> * aPaths,
+                           const SingleLinkedListNode<AttributePathParams> * aOther)
+{
+    for (; aPaths != nullptr && aOther != nullptr; aPaths = aPaths->mpNext, aOther = aOther->mpNext)
+    {
+        VerifyOrReturnValue(aPaths->mValue == aOther->mValue, false);
+    }
+    return aPaths == nullptr && aOther == nullptr;
+}
+
+bool Engine::CanShareAttributeReport(const ReadHandler & aReadHandler) const
+{
+    return aReadHandler.IsType(ReadHandler::InteractionType::Subscribe) && !aReadHandler.IsPriming() &&
+        !aReadHandler.IsReporting() && aReadHandler.GetAttributePathList() != nullptr;
+}
+
+bool Engine::HaveSameAttributeReport(const ReadHandler & aReadHandler, const ReadHandler & aOther) const
+{
+    // The subject and fabric filtering decide which attributes are readable and how fabric-scoped ones are encoded, so
+    // subscriptions of different fabrics never share reports.
+    return aReadHandler.mPreviousReportsBeginGeneration == aOther.mPreviousReportsBeginGeneration &&
+        aReadHandler.IsFabricFiltered() == aOther.IsFabricFiltered() &&
+        IsSameSubject(aReadHandler.GetSubjectDescriptor(), aOther.GetSubjectDescriptor()) &&
+        IsSamePathList(aReadHandler.GetAttributePathList(), aOther.GetAttributePathList());
+}
+
+bool Engine::HasOtherReportableHandlerWithSameAttributeReport(ReadHandler & aReadHandler)
+{
+    bool found = false;
+    mpImEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
+        if (handler != &aReadHandler && handler->GetSession() != nullptr && CanShareAttributeReport(*handler) &&
+            HaveSameAttributeReport(aReadHandler, *handler) &&
+            (handler->ShouldReportUnscheduled() || mpImEngine->GetReportScheduler()->IsReportableNow(handler)))
+        {
+            found = true;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return found;
+}
+
+bool Engine::IsSharedAttributeReportFor(const ReadHandler & aReadHandler) const
+{
+    // Attribute data can only have changed if something was marked dirty since it was encoded.
+    return mSharedAttributeReport.mpSource != nullptr && mSharedAttributeReport.mDirtyGeneration == mDirtyGeneration &&
+        mSharedAttributeReport.mPreviousReportsBeginGeneration == aReadHandler.mPreviousReportsBeginGeneration &&
+        mSharedAttributeReport.mFabricFiltered == aReadHandler.IsFabricFiltered() &&
+        IsSameSubject(mSharedAttributeReport.mSubjectDescriptor, aReadHandler.GetSubjectDescriptor()) &&
+        IsSamePathList(mSharedAttributeReport.mpSource->GetAttributePathList(), aReadHandler.GetAttributePathList());
+}
+
+void Engine::ReleaseSharedAttributeReport()
+{
+    mSharedAttributeReport.mReport.Release();
+    mSharedAttributeReport.mpSource = nullptr;
+}
+#endif // CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS
+
+#if CHIP_IM_SERVER_LIST_ITEM_CARRY
+AttributeListItemCarry * Engine::ListItemCarryFor(const ReadHandler & aReadHandler)
+{
+    VerifyOrReturnValue(mListItemCarry.mpHolder == nullptr || mListItemCarry.mpHolder == &aReadHandler, nullptr);
+    return &mListItemCarry.mCarry;
+}
+
+void Engine::UpdateListItemCarryHolder(const ReadHandler & aReadHandler, bool aAttributeComplete)
+{
+    VerifyOrReturn(mListItemCarry.mpHolder == nullptr || mListItemCarry.mpHolder == &aReadHandler);
+
+    if (aAttributeComplete)
+    {
+        // An item held for a list that ended (e.g. got shorter) in the meantime is not going to be used.
+        mListItemCarry.mCarry.Clear();
+    }
+    mListItemCarry.mpHolder = mListItemCarry.mCarry.IsHolding() ? &aReadHandler : nullptr;
+}
+
+void Engine::ReleaseListItemCarry()
+{
+    mListItemCarry.mCarry.Release();
+    mListItemCarry.mpHolder = nullptr;
+}
+#endif // CHIP_IM_SERVER_LIST_ITEM_CARRY
+
 CHIP_ERROR Engine::BuildSingleReportDataEventReports(ReportDataMessage::Builder & aReportDataBuilder, ReadHandler * apReadHandler,
                                                      bool aBufferIsUsed, bool * apHasMoreChunks, bool * apHasEncodedData)
 {
@@ -555,8 +740,7 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
         bool hasEncodedAttributes       = false;
         bool hasEncodedEvents           = false;
 
-        err = BuildSingleReportDataAttributeReportIBs(reportDataBuilder, apReadHandler, &hasMoreChunksForAttributes,
-                                                      &hasEncodedAttributes);
+        err = BuildSharedAttributeReportIBs(reportDataBuilder, apReadHandler, &hasMoreChunksForAttributes, &hasEncodedAttributes);
         SuccessOrExit(err);
         SuccessOrExit(err = reportDataWriter.UnreserveBuffer(kReservedSizeForEventReportIBs));
         err = BuildSingleReportDataEventReports(reportDataBuilder, apReadHandler, hasEncodedAttributes, &hasMoreChunksForEvents,
@@ -602,6 +786,9 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     SuccessOrExit(err);
 
     ChipLogDetail(DataManagement, "<RE> Sending report (payload has %" PRIu32 " bytes)...", reportDataWriter.GetLengthWritten());
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+    mLastReportLength = reportDataWriter.GetLengthWritten();
+#endif
     err = SendReport(apReadHandler, std::move(bufHandle), hasMoreChunks);
     VerifyOrExit(err == CHIP_NO_ERROR,
                  ChipLogError(DataManagement, "<RE> Error sending out report data with %" CHIP_ERROR_FORMAT "!", err.Format()));
@@ -660,6 +847,9 @@ CHIP_ERROR Engine::ScheduleRun()
 
 void Engine::Run()
 {
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+    VerifyOrReturn(RunFairly());
+#else
     uint32_t numReadHandled = 0;
 
     // We may be deallocating read handlers as we go.  Track how many we had
@@ -699,6 +889,7 @@ void Engine::Run()
     {
         mCurReadHandlerIdx = 0;
     }
+#endif // CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
 
     bool allReadClean = true;
 
@@ -720,6 +911,64 @@ void Engine::Run()
     }
 }
 
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+bool Engine::RunFairly()
+{
+    // As with the round-robin, each handler is served at most once per run.
+    mReportRunGeneration++;
+    mCurReadHandlerIdx = 0;
+
+    while (mNumReportsInFlight < CHIP_IM_MAX_REPORTS_IN_FLIGHT)
+    {
+        const System::Clock::Microseconds64 now = System::SystemClock().GetMonotonicMicroseconds64();
+        ReadHandler * readHandler               = nullptr;
+        uint64_t startTag                       = 0;
+
+        // Pick the reportable handler whose next report starts first in virtual time. A handler that was not reportable for
+        // a while starts from the current virtual time, rather than from where it stopped.
+        mpImEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
+            if (handler->mReportRunGeneration == mReportRunGeneration ||
+                !(handler->ShouldReportUnscheduled() || mpImEngine->GetReportScheduler()->IsReportableNow(handler)))
+            {
+                return Loop::Continue;
+            }
+            const uint64_t handlerStartTag = std::max(handler->mReportFinishTag, mReportVirtualTime);
+            if (readHandler == nullptr || handlerStartTag < startTag)
+            {
+                readHandler = handler;
+                startTag    = handlerStartTag;
+            }
+            return Loop::Continue;
+        });
+        VerifyOrReturnValue(readHandler != nullptr, true);
+
+        if (readHandler->mReportableSince != System::Clock::kZero && readHandler->mReportableSince <= now)
+        {
+            const uint64_t queueingDelay = (now - readHandler->mReportableSince).count();
+            MATTER_LOG_METRIC(Tracing::kMetricReportQueueingDelay,
+                              static_cast<uint32_t>(std::min<uint64_t>(queueingDelay, UINT32_MAX)));
+        }
+        readHandler->mReportRunGeneration = mReportRunGeneration;
+        mReportVirtualTime                = startTag;
+
+        mRunningReadHandler         = readHandler;
+        mRunningReadHandlerReleased = false;
+        mLastReportLength           = 0;
+        CHIP_ERROR err              = BuildAndSendSingleReportData(readHandler);
+        mRunningReadHandler         = nullptr;
+        VerifyOrReturnValue(err == CHIP_NO_ERROR, false);
+
+        // Charge the report to its handler, unless the handler is gone with its last report.
+        if (!mRunningReadHandlerReleased)
+        {
+            const System::Clock::Microseconds64 elapsed = System::SystemClock().GetMonotonicMicroseconds64() - now;
+            readHandler->mReportFinishTag               = startTag + mLastReportLength + elapsed.count();
+        }
+    }
+    return true;
+}
+#endif // CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+
 bool Engine::MergeOverlappedAttributePath(const AttributePathParams & aAttributePath)
 {
     return Loop::Break == mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
@@ -857,9 +1106,47 @@ CHIP_ERROR Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttribute
 
 CHIP_ERROR Engine::SetDirty(const AttributePathParams & aAttributePath)
 {
+#if CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE > 0
+    if (mDirtyPathBatchDepth > 0)
+    {
+        for (size_t i = 0; i < mDirtyPathBatchCount; i++)
+        {
+            if (mDirtyPathBatch[i] == aAttributePath)
+            {
+                return CHIP_NO_ERROR;
+            }
+        }
+        if (mDirtyPathBatchCount < ArraySize(mDirtyPathBatch))
+        {
+            mDirtyPathBatch[mDirtyPathBatchCount++] = aAttributePath;
+            return CHIP_NO_ERROR;
+        }
+        // The batch is full: the path is marked dirty right away.
+    }
+#endif // CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE > 0
+
     BumpDirtySetGeneration();
 
     bool intersectsInterestPath = false;
+
+#if CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX
+    // Changes to a wildcard path, such as a whole endpoint, are rare, and still go through every handler below.
+    if (!aAttributePath.HasWildcardEndpointId() && !aAttributePath.HasWildcardClusterId() &&
+        !aAttributePath.HasWildcardAttributeId())
+    {
+        mAttributeInterestIndex.ForEachInterestedReader(aAttributePath, [&](ReadHandler & handler) {
+            // A handler interested through several paths is visited once per path, and is already dirty after the first.
+            if (handler.mDirtyGeneration != mDirtyGeneration && (handler.CanStartReporting() || handler.IsAwaitingReportResponse()))
+            {
+                handler.AttributePathIsDirty(aAttributePath);
+                intersectsInterestPath = true;
+            }
+            return Loop::Continue;
+        });
+        return intersectsInterestPath ? InsertPathIntoDirtySet(aAttributePath) : CHIP_NO_ERROR;
+    }
+#endif // CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX
+
     mpImEngine->mReadHandlers.ForEachActiveObject([&aAttributePath, &intersectsInterestPath](ReadHandler * handler) {
         // We call AttributePathIsDirty for both read interactions and subscribe interactions, since we may send inconsistent
         // attribute data between two chunks. AttributePathIsDirty will not schedule a new run for read handlers which are
@@ -889,6 +1176,48 @@ CHIP_ERROR Engine::SetDirty(const AttributePathParams & aAttributePath)
     return CHIP_NO_ERROR;
 }
 
+void Engine::StartDirtyPathBatch()
+{
+#if CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE > 0
+    mDirtyPathBatchDepth++;
+#endif
+}
+
+void Engine::EndDirtyPathBatch()
+{
+#if CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE > 0
+    VerifyOrReturn(mDirtyPathBatchDepth > 0);
+    VerifyOrReturn(--mDirtyPathBatchDepth == 0);
+
+    const size_t count   = mDirtyPathBatchCount;
+    mDirtyPathBatchCount = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        CHIP_ERROR err = SetDirty(mDirtyPathBatch[i]);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to mark a written path dirty: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+#endif
+}
+
+CHIP_ERROR Engine::RegisterAttributeInterest(ReadHandler & aReadHandler)
+{
+#if CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX
+    return mAttributeInterestIndex.Add(aReadHandler, aReadHandler.GetAttributePathList());
+#else
+    return CHIP_NO_ERROR;
+#endif
+}
+
+void Engine::UnregisterAttributeInterest(ReadHandler & aReadHandler)
+{
+#if CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX
+    mAttributeInterestIndex.Remove(aReadHandler, aReadHandler.GetAttributePathList());
+#endif
+}
+
 CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aHasMoreChunks)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -27,6 +27,9 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/AttributeListItemCarry.h>
+#include <app/reporting/AttributeInterestIndex.h>
+#include <app/reporting/SharedAttributeReport.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -95,6 +98,26 @@ public:
      */
     CHIP_ERROR SetDirty(const AttributePathParams & aAttributePathParams);
 
+    /**
+     * Should be invoked once the attribute path list of a read handler is final, so that SetDirty can find the handler when
+     * one of the paths changes. The handler must unregister before its path list is released.
+     *
+     * A no-op unless CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX is enabled.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY if the index has no room for the paths.
+     */
+    CHIP_ERROR RegisterAttributeInterest(ReadHandler & aReadHandler);
+    void UnregisterAttributeInterest(ReadHandler & aReadHandler);
+
+    /**
+     * Between these calls, SetDirty collects the paths marked dirty, and EndDirtyPathBatch marks each distinct path dirty
+     * once, e.g. for the attributes of a write request. Batches nest.
+     *
+     * A no-op unless CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE is enabled.
+     */
+    void StartDirtyPathBatch();
+    void EndDirtyPathBatch();
+
     /**
      * @brief
      *  Schedule the event delivery
@@ -114,6 +137,9 @@ public:
             // Just decrement, so our increment after we finish running it will
             // do the right thing.
             --mCurReadHandlerIdx;
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+            mRunningReadHandlerReleased = true;
+#endif
         }
         else
         {
@@ -122,6 +148,19 @@ public:
             // https://github.com/project-chip/connectedhomeip/issues/13809
             mCurReadHandlerIdx = 0;
         }
+
+#if CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS
+        if (apReadHandlerBeingDeleted == mSharedAttributeReport.mpSource)
+        {
+            ReleaseSharedAttributeReport();
+        }
+#endif
+#if CHIP_IM_SERVER_LIST_ITEM_CARRY
+        if (apReadHandlerBeingDeleted == mListItemCarry.mpHolder)
+        {
+            ReleaseListItemCarry();
+        }
+#endif
     }
 
     uint32_t GetNumReportsInFlight() const { return mNumReportsInFlight; }
@@ -145,6 +184,14 @@ private:
      * Main work-horse function that executes the run-loop.
      */
     void Run();
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+    /**
+     * Sends the reports of the reportable read handlers, least charged first, as long as reports can be in flight.
+     *
+     * @return false if sending a report failed.
+     */
+    bool RunFairly();
+#endif
 
     friend class TestReportingEngine;
     friend class ::chip::app::TestReadInteraction;
@@ -166,6 +213,30 @@ private:
 
     CHIP_ERROR BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Builder & reportDataBuilder, ReadHandler * apReadHandler,
                                                        bool * apHasMoreChunks, bool * apHasEncodedData);
+
+    /**
+     * Same as BuildSingleReportDataAttributeReportIBs, except that when CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS is enabled,
+     * the attribute data of a report that other read handlers are about to send too is encoded once and copied into each of
+     * their reports.
+     */
+    CHIP_ERROR BuildSharedAttributeReportIBs(ReportDataMessage::Builder & reportDataBuilder, ReadHandler * apReadHandler,
+                                             bool * apHasMoreChunks, bool * apHasEncodedData);
+#if CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS
+    // Whether the next report of the read handler is a whole, non-priming report of dirty attributes, which could be shared.
+    bool CanShareAttributeReport(const ReadHandler & aReadHandler) const;
+    // Whether the two read handlers, which can share reports, would report the same attribute data.
+    bool HaveSameAttributeReport(const ReadHandler & aReadHandler, const ReadHandler & aOther) const;
+    bool HasOtherReportableHandlerWithSameAttributeReport(ReadHandler & aReadHandler);
+    bool IsSharedAttributeReportFor(const ReadHandler & aReadHandler) const;
+    void ReleaseSharedAttributeReport();
+#endif
+#if CHIP_IM_SERVER_LIST_ITEM_CARRY
+    // The list item carry, if the read handler can use it: when it does not hold an item for another handler.
+    AttributeListItemCarry * ListItemCarryFor(const ReadHandler & aReadHandler);
+    // Keeps track of whether the carry holds an item for the read handler, once it has read an attribute with it.
+    void UpdateListItemCarryHolder(const ReadHandler & aReadHandler, bool aAttributeComplete);
+    void ReleaseListItemCarry();
+#endif
     CHIP_ERROR BuildSingleReportDataEventReports(ReportDataMessage::Builder & reportDataBuilder, ReadHandler * apReadHandler,
                                                  bool aBufferIsUsed, bool * apHasMoreChunks, bool * apHasEncodedData);
     CHIP_ERROR CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler);
@@ -252,6 +323,17 @@ private:
      */
     ReadHandler * mRunningReadHandler = nullptr;
 
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+    /**
+     * The fair queuing state: the virtual time is the start tag of the last report sent, which is where the handlers that
+     * become reportable start from, and each run of the engine serves a handler at most once.
+     */
+    uint64_t mReportVirtualTime      = 0;
+    uint32_t mReportRunGeneration    = 0;
+    uint32_t mLastReportLength       = 0;
+    bool mRunningReadHandlerReleased = false;
+#endif
+
     /**
      *  mGlobalDirtySet is used to track the set of attribute/event paths marked dirty for reporting purposes.
      *
@@ -277,6 +359,57 @@ private:
      */
     uint64_t mDirtyGeneration = 1;
 
+#if CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX
+    /**
+     * The attribute paths of the registered read handlers, used by SetDirty to find the handlers interested in a concrete
+     * path without going through the path list of every handler.
+     */
+    AttributeInterestIndex<ReadHandler,
+                           CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS,
+                           CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX_BUCKETS>
+        mAttributeInterestIndex;
+#endif
+
+#if CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS
+    /**
+     * The attribute data last encoded for a read handler that other handlers were about to report too, and what it was
+     * encoded for: it is only valid for handlers with the same paths, subject, fabric filtering and last report generation,
+     * until the dirty set changes.
+     */
+    struct SharedAttributeReportState
+    {
+        SharedAttributeReport mReport;
+        const ReadHandler * mpSource = nullptr;
+        Access::SubjectDescriptor mSubjectDescriptor;
+        uint64_t mDirtyGeneration                = 0;
+        uint64_t mPreviousReportsBeginGeneration = 0;
+        bool mFabricFiltered                     = false;
+    };
+    SharedAttributeReportState mSharedAttributeReport;
+#endif
+
+#if CHIP_IM_SERVER_LIST_ITEM_CARRY
+    /**
+     * Where the list items close to the end of a report chunk are staged, and the list item that did not fit is carried to
+     * the next chunk of the read handler it was encoded for. Other handlers encode their list items directly until then.
+     */
+    struct ListItemCarryState
+    {
+        AttributeListItemCarry mCarry;
+        const ReadHandler * mpHolder = nullptr;
+    };
+    ListItemCarryState mListItemCarry;
+#endif
+
+#if CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE > 0
+    /**
+     * The distinct paths marked dirty since StartDirtyPathBatch.
+     */
+    AttributePathParams mDirtyPathBatch[CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE];
+    size_t mDirtyPathBatchCount   = 0;
+    uint16_t mDirtyPathBatchDepth = 0;
+#endif
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
@@ -174,6 +174,14 @@ public:
         void TimerFired() override
         {
             SetEngineRunScheduled(true);
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+            // The report timer fires when the handler becomes reportable. If it is still waiting for a report response, it only
+            // becomes reportable once that arrives, when the report is scheduled again.
+            if (mReadHandler->CanStartReporting())
+            {
+                ReportScheduler::MarkReportable(mReadHandler);
+            }
+#endif // CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
             mScheduler->ReportTimerCallback();
         }
 
@@ -231,6 +239,18 @@ public:
 #endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
 
 protected:
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+    /// @brief Records that a ReadHandler is reportable from now on, unless it already is. ReadHandler clears it when it stops
+    /// being reportable.
+    static void MarkReportable(ReadHandler * aReadHandler)
+    {
+        if (aReadHandler->mReportableSince == System::Clock::kZero)
+        {
+            aReadHandler->mReportableSince = System::SystemClock().GetMonotonicMicroseconds64();
+        }
+    }
+#endif // CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+
     friend class chip::app::reporting::TestReportScheduler;
 
     /// @brief Find the ReadHandlerNode for a given ReadHandler pointer
@@ -0,0 +1,87 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/SharedAttributeReport.h>
+
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVTypes.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+CHIP_ERROR SharedAttributeReport::FinishEncoding(uint32_t aLength)
+{
+    mBuffer->SetDataLength(aLength);
+
+    TLV::TLVReader reader;
+    TLV::TLVType reportDataType;
+    TLV::TLVType attributeReportIBsType;
+    reader.Init(mBuffer->Start(), mBuffer->DataLength());
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(reportDataType));
+
+    // The message is not closed, so the data ends with the AttributeReportIBs, if there are any: their members run to the end
+    // of the data, which saves parsing them to find their end.
+    CHIP_ERROR err = reader.Next(TLV::kTLVType_Array, TLV::ContextTag(ReportDataMessage::Tag::kAttributeReportIBs));
+    if (err == CHIP_NO_ERROR)
+    {
+        ReturnErrorOnFailure(reader.EnterContainer(attributeReportIBsType));
+        mpAttributeReportIBs      = reader.GetReadPoint();
+        mAttributeReportIBsLength = static_cast<uint32_t>(mBuffer->Start() + aLength - mpAttributeReportIBs);
+        VerifyOrReturnError(mAttributeReportIBsLength > 0 &&
+                                mpAttributeReportIBs[mAttributeReportIBsLength - 1] ==
+                                    static_cast<uint8_t>(TLV::TLVElementType::EndOfContainer),
+                            CHIP_ERROR_INVALID_TLV_ELEMENT);
+    }
+    else if (err != CHIP_END_OF_TLV && err != CHIP_ERROR_TLV_UNDERRUN)
+    {
+        return err;
+    }
+
+    mEncoded = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SharedAttributeReport::CopyTo(TLV::TLVWriter & aWriter) const
+{
+    VerifyOrReturnError(mEncoded, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mpAttributeReportIBs != nullptr, CHIP_NO_ERROR);
+
+    // The members, including the end of the container, are copied as they are.
+    TLV::TLVWriter backup = aWriter;
+    CHIP_ERROR err        = aWriter.PutPreEncodedContainer(TLV::ContextTag(ReportDataMessage::Tag::kAttributeReportIBs),
+                                                           TLV::kTLVType_Array, mpAttributeReportIBs, mAttributeReportIBsLength);
+    if (err != CHIP_NO_ERROR)
+    {
+        aWriter = backup;
+    }
+    return err;
+}
+
+void SharedAttributeReport::Release()
+{
+    mBuffer                   = nullptr;
+    mEncoded                  = false;
+    mpAttributeReportIBs      = nullptr;
+    mAttributeReportIBsLength = 0;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,104 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/MessageDef/ReportDataMessage.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemPacketBuffer.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/**
+ * The AttributeReportIBs of a report, encoded once so that they can be copied into the reports of several subscriptions
+ * that would have encoded exactly the same attribute data.
+ *
+ * The encoding is held in a packet buffer, which is released with Release() or when the object is destroyed.
+ */
+class SharedAttributeReport
+{
+public:
+    /**
+     * Encode the AttributeReportIBs of a report, replacing any previous encoding.
+     *
+     * aEncodeAttributeReportIBs(ReportDataMessage::Builder &) is called with a report message builder, into which it must
+     * create and close the AttributeReportIBs (or leave nothing), as Engine::BuildSingleReportDataAttributeReportIBs
+     * does; it gets aMaxLength bytes of space for them.
+     *
+     * If aEncodeAttributeReportIBs fails, there is nothing to copy, but the buffer is kept until Release(), so that IsNull()
+     * tells this apart from a failure to allocate it.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY if a buffer of aMaxLength bytes cannot be allocated.
+     * @retval the error returned by aEncodeAttributeReportIBs, if any.
+     */
+    template <typename EncodeFunction>
+    CHIP_ERROR Encode(uint32_t aMaxLength, EncodeFunction && aEncodeAttributeReportIBs)
+    {
+        Release();
+
+        // The report message structure, which is not part of what CopyTo() copies, takes a byte to open.
+        const size_t maxLength = static_cast<size_t>(aMaxLength) + kReportDataMessageOverhead;
+        mBuffer                = System::PacketBufferHandle::New(maxLength, 0);
+        VerifyOrReturnError(!mBuffer.IsNull() && mBuffer->AvailableDataLength() >= maxLength, CHIP_ERROR_NO_MEMORY);
+
+        TLV::TLVWriter writer;
+        ReportDataMessage::Builder reportDataBuilder;
+        writer.Init(mBuffer->Start(), maxLength);
+        ReturnErrorOnFailure(reportDataBuilder.Init(&writer));
+        ReturnErrorOnFailure(aEncodeAttributeReportIBs(reportDataBuilder));
+        return FinishEncoding(writer.GetLengthWritten());
+    }
+
+    /**
+     * Write the encoded AttributeReportIBs, if there are any, to aWriter.
+     *
+     * @retval CHIP_ERROR_INCORRECT_STATE if there is no encoding.
+     * @retval CHIP_ERROR_BUFFER_TOO_SMALL or CHIP_ERROR_NO_MEMORY if aWriter does not have enough space left, in which case
+     *         aWriter is left as it was.
+     */
+    CHIP_ERROR CopyTo(TLV::TLVWriter & aWriter) const;
+
+    /**
+     * Whether the encoding has AttributeReportIBs. An encoding of a report without any attribute data has none.
+     */
+    bool HasAttributeReportIBs() const { return mpAttributeReportIBs != nullptr; }
+
+    bool IsNull() const { return mBuffer.IsNull(); }
+    size_t GetLength() const { return mBuffer.IsNull() ? 0 : mBuffer->DataLength(); }
+
+    void Release();
+
+private:
+    static constexpr size_t kReportDataMessageOverhead = 1;
+
+    // Locates the members of the AttributeReportIBs, so that copying them does not have to parse them again.
+    CHIP_ERROR FinishEncoding(uint32_t aLength);
+
+    System::PacketBufferHandle mBuffer;
+    bool mEncoded                        = false;
+    const uint8_t * mpAttributeReportIBs = nullptr;
+    uint32_t mAttributeReportIBsLength   = 0;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -196,6 +196,9 @@ void SynchronizedReportSchedulerImpl::TimerFired()
             // moment, which becomes false if we find a handler that is reportable
             firedEarly = false;
             node->SetEngineRunScheduled(true);
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+            MarkReportable(node->GetReadHandler());
+#endif // CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
             ChipLogProgress(DataManagement, "Handler: %p with min: 0x" ChipLogFormatX64 " and max: 0x" ChipLogFormatX64 "", (node),
                             ChipLogValueX64(node->GetMinTimestamp().count()), ChipLogValueX64(node->GetMaxTimestamp().count()));
         }
@@ -0,0 +1,225 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AttributePathParams.h>
+#include <app/reporting/AttributeInterestIndex.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/LinkedList.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+constexpr size_t kPathsPerReader = 4;
+
+struct TestReader
+{
+    SingleLinkedListNode<AttributePathParams> paths[kPathsPerReader];
+    size_t visits = 0;
+
+    void SetPaths(std::initializer_list<AttributePathParams> aPaths)
+    {
+        size_t count = 0;
+        for (auto & path : aPaths)
+        {
+            paths[count].mValue = path;
+            paths[count].mpNext = nullptr;
+            if (count > 0)
+            {
+                paths[count - 1].mpNext = &paths[count];
+            }
+            count++;
+        }
+    }
+
+    bool Intersects(const AttributePathParams & aPath) const
+    {
+        for (auto path = &paths[0]; path != nullptr; path = path->mpNext)
+        {
+            if (path->mValue.Intersects(aPath))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// A small bucket count, so that different keys share buckets.
+using TestIndex = reporting::AttributeInterestIndex<TestReader, 64, 4>;
+
+class TestAttributeInterestIndex : public ::testing::Test
+{
+public:
+    // The index entry pool allocates from the platform memory when the pools are heap based.
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+void ClearVisits(TestReader * aReaders, size_t aCount)
+{
+    for (size_t i = 0; i < aCount; i++)
+    {
+        aReaders[i].visits = 0;
+    }
+}
+
+void Visit(TestIndex & aIndex, const AttributePathParams & aPath)
+{
+    aIndex.ForEachInterestedReader(aPath, [](TestReader & reader) {
+        reader.visits++;
+        return Loop::Continue;
+    });
+}
+
+TEST_F(TestAttributeInterestIndex, TestMatchesIntersects)
+{
+    EndpointId endpointIds[]   = { 1, 2, kInvalidEndpointId };
+    ClusterId clusterIds[]     = { 6, 8, kInvalidClusterId };
+    AttributeId attributeIds[] = { 0, 1, kInvalidAttributeId };
+
+    // One reader per possible interest path.
+    TestReader readers[27];
+    TestIndex index;
+    size_t count = 0;
+    for (auto endpointId : endpointIds)
+    {
+        for (auto clusterId : clusterIds)
+        {
+            for (auto attributeId : attributeIds)
+            {
+                readers[count].SetPaths({ AttributePathParams(endpointId, clusterId, attributeId) });
+                EXPECT_EQ(index.Add(readers[count], readers[count].paths), CHIP_NO_ERROR);
+                count++;
+            }
+        }
+    }
+    EXPECT_EQ(index.GetEntryCount(), count);
+
+    for (EndpointId endpointId = 1; endpointId <= 3; endpointId++)
+    {
+        for (ClusterId clusterId = 6; clusterId <= 8; clusterId++)
+        {
+            for (AttributeId attributeId = 0; attributeId <= 2; attributeId++)
+            {
+                const AttributePathParams changed(endpointId, clusterId, attributeId);
+                ClearVisits(readers, count);
+                Visit(index, changed);
+                for (size_t i = 0; i < count; i++)
+                {
+                    EXPECT_EQ(readers[i].visits, readers[i].Intersects(changed) ? 1u : 0u);
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        index.Remove(readers[i], readers[i].paths);
+    }
+    EXPECT_EQ(index.GetEntryCount(), 0u);
+}
+
+TEST_F(TestAttributeInterestIndex, TestVisitedOncePerPath)
+{
+    TestReader reader;
+    reader.SetPaths({ AttributePathParams(1, 6, kInvalidAttributeId), AttributePathParams(1, 6, 0), AttributePathParams(2, 6, 0) });
+
+    TestIndex index;
+    EXPECT_EQ(index.Add(reader, reader.paths), CHIP_NO_ERROR);
+
+    Visit(index, AttributePathParams(1, 6, 0));
+    EXPECT_EQ(reader.visits, 2u);
+
+    reader.visits = 0;
+    Visit(index, AttributePathParams(2, 6, 1));
+    EXPECT_EQ(reader.visits, 0u);
+}
+
+TEST_F(TestAttributeInterestIndex, TestRemove)
+{
+    TestReader readers[3];
+    readers[0].SetPaths({ AttributePathParams(1, 6, 0), AttributePathParams(1, 8, kInvalidAttributeId) });
+    readers[1].SetPaths({ AttributePathParams(1, 6, 0), AttributePathParams() });
+    readers[2].SetPaths({ AttributePathParams(1), AttributePathParams(kInvalidEndpointId, 6, 0) });
+
+    TestIndex index;
+    for (auto & reader : readers)
+    {
+        EXPECT_EQ(index.Add(reader, reader.paths), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(index.GetEntryCount(), 6u);
+
+    Visit(index, AttributePathParams(1, 6, 0));
+    EXPECT_EQ(readers[0].visits, 1u);
+    EXPECT_EQ(readers[1].visits, 2u);
+    EXPECT_EQ(readers[2].visits, 2u);
+
+    // Removing a reader leaves the interests of the others, including those sharing its keys.
+    index.Remove(readers[1], readers[1].paths);
+    EXPECT_EQ(index.GetEntryCount(), 4u);
+
+    ClearVisits(readers, 3);
+    Visit(index, AttributePathParams(1, 6, 0));
+    EXPECT_EQ(readers[0].visits, 1u);
+    EXPECT_EQ(readers[1].visits, 0u);
+    EXPECT_EQ(readers[2].visits, 2u);
+
+    ClearVisits(readers, 3);
+    Visit(index, AttributePathParams(3, 8, 5));
+    EXPECT_EQ(readers[0].visits, 0u);
+    EXPECT_EQ(readers[1].visits, 0u);
+    EXPECT_EQ(readers[2].visits, 0u);
+
+    index.Remove(readers[0], readers[0].paths);
+    index.Remove(readers[2], readers[2].paths);
+    EXPECT_EQ(index.GetEntryCount(), 0u);
+}
+
+TEST_F(TestAttributeInterestIndex, TestBreak)
+{
+    TestReader readers[2];
+    readers[0].SetPaths({ AttributePathParams(1, 6, 0) });
+    readers[1].SetPaths({ AttributePathParams(1, 6, kInvalidAttributeId) });
+
+    TestIndex index;
+    for (auto & reader : readers)
+    {
+        EXPECT_EQ(index.Add(reader, reader.paths), CHIP_NO_ERROR);
+    }
+
+    size_t visits = 0;
+    EXPECT_EQ(index.ForEachInterestedReader(AttributePathParams(1, 6, 0),
+                                            [&visits](TestReader &) {
+                                                visits++;
+                                                return Loop::Break;
+                                            }),
+              Loop::Break);
+    EXPECT_EQ(visits, 1u);
+
+    index.Clear();
+    EXPECT_EQ(index.GetEntryCount(), 0u);
+    EXPECT_EQ(index.ForEachInterestedReader(AttributePathParams(1, 6, 0), [](TestReader &) { return Loop::Break; }),
+              Loop::Finish);
+}
+
+} // namespace
@@ -351,4 +351,92 @@ TEST_F(TestAttributePersistenceProvider, TestBufferTooSmallErrors)
     persistenceProvider.Shutdown();
 }
 
+/**
+ * Tests that the values written during a write batch are stored when the batch ends
+ */
+TEST_F(TestAttributePersistenceProvider, TestWriteBatch)
+{
+    TestPersistentStorageDelegate storageDelegate;
+    DefaultAttributePersistenceProvider persistenceProvider;
+    const ConcreteAttributePath otherPath(1, 1, 2);
+
+    // Init
+    ChipError err = persistenceProvider.Init(&storageDelegate);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+
+    uint8_t firstArray[2]  = { 0x01, 0x02 };
+    uint8_t secondArray[3] = { 0x03, 0x04, 0x05 };
+    uint8_t otherArray[1]  = { 0x06 };
+
+    persistenceProvider.StartWriteBatch();
+    persistenceProvider.StartWriteBatch();
+    EXPECT_EQ(persistenceProvider.SafeWriteValue(TestConcretePath, ByteSpan(firstArray)), CHIP_NO_ERROR);
+    EXPECT_EQ(persistenceProvider.SafeWriteValue(TestConcretePath, ByteSpan(secondArray)), CHIP_NO_ERROR);
+    EXPECT_EQ(persistenceProvider.SafeWriteValue(otherPath, ByteSpan(otherArray)), CHIP_NO_ERROR);
+
+    // The latest value is read back while the batch is open.
+    uint8_t getArray[3];
+    MutableByteSpan valueReadBack(getArray);
+    EXPECT_EQ(persistenceProvider.SafeReadValue(TestConcretePath, valueReadBack), CHIP_NO_ERROR);
+    EXPECT_TRUE(valueReadBack.data_equal(ByteSpan(secondArray)));
+
+    uint8_t tooSmallArray[2];
+    MutableByteSpan tooSmall(tooSmallArray);
+    EXPECT_EQ(persistenceProvider.SafeReadValue(TestConcretePath, tooSmall), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+    // Nothing is stored until the outermost batch ends.
+    EXPECT_EQ(persistenceProvider.EndWriteBatch(), CHIP_NO_ERROR);
+    EXPECT_EQ(storageDelegate.GetNumKeys(), 0u);
+#else
+    EXPECT_EQ(persistenceProvider.EndWriteBatch(), CHIP_NO_ERROR);
+#endif
+    EXPECT_EQ(persistenceProvider.EndWriteBatch(), CHIP_NO_ERROR);
+    EXPECT_EQ(storageDelegate.GetNumKeys(), 2u);
+
+    uint8_t storedArray[3];
+    uint16_t storedSize = sizeof(storedArray);
+    EXPECT_EQ(storageDelegate.SyncGetKeyValue(
+                  DefaultStorageKeyAllocator::SafeAttributeValue(TestConcretePath.mEndpointId, TestConcretePath.mClusterId,
+                                                                 TestConcretePath.mAttributeId)
+                      .KeyName(),
+                  storedArray, storedSize),
+              CHIP_NO_ERROR);
+    EXPECT_TRUE(ByteSpan(storedArray, storedSize).data_equal(ByteSpan(secondArray)));
+
+    // Finishing
+    persistenceProvider.Shutdown();
+}
+
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+/**
+ * Tests that the values beyond the size of a write batch are stored right away
+ */
+TEST_F(TestAttributePersistenceProvider, TestWriteBatchFull)
+{
+    TestPersistentStorageDelegate storageDelegate;
+    DefaultAttributePersistenceProvider persistenceProvider;
+    uint8_t valueArray[1] = { 0x42 };
+
+    // Init
+    ChipError err = persistenceProvider.Init(&storageDelegate);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+
+    persistenceProvider.StartWriteBatch();
+    for (AttributeId id = 0; id <= CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE; id++)
+    {
+        EXPECT_EQ(persistenceProvider.SafeWriteValue(ConcreteAttributePath(1, 1, id), ByteSpan(valueArray)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(storageDelegate.GetNumKeys(), 1u);
+    EXPECT_EQ(persistenceProvider.EndWriteBatch(), CHIP_NO_ERROR);
+    EXPECT_EQ(storageDelegate.GetNumKeys(), static_cast<size_t>(CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE + 1));
+
+    // A batch that was not started cannot end.
+    EXPECT_EQ(persistenceProvider.EndWriteBatch(), CHIP_ERROR_INCORRECT_STATE);
+
+    // Finishing
+    persistenceProvider.Shutdown();
+}
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+
 } // anonymous namespace
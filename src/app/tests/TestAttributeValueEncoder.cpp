@@ -17,17 +17,20 @@
  */
 
 #include <optional>
+#include <vector>
 
 #include <lib/core/StringBuilderAdapters.h>
 #include <pw_unit_test/framework.h>
 
 #include <app-common/zap-generated/cluster-objects.h>
+#include <app/AttributeListItemCarry.h>
 #include <app/AttributeValueEncoder.h>
 #include <app/MessageDef/AttributeDataIB.h>
 #include <app/data-model/FabricScopedPreEncodedValue.h>
 #include <app/data-model/PreEncodedValue.h>
 #include <lib/core/TLVTags.h>
 #include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 
 using namespace chip;
@@ -859,6 +862,140 @@ TEST(TestAttributeValueEncoder, TestEncodeFabricFilteredListOfPreEncoded)
     VERIFY_BUFFER_STATE(test, expected);
 }
 
+class TestListItemCarry : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+// A list item that counts how many times it gets encoded.
+struct CountedItem
+{
+    static constexpr bool kIsFabricScoped = false;
+    static size_t sEncodeCount;
+
+    uint8_t id;
+
+    CHIP_ERROR Encode(TLV::TLVWriter & writer, TLV::Tag tag) const
+    {
+        uint8_t payload[24];
+        memset(payload, id, sizeof(payload));
+
+        sEncodeCount++;
+        TLVType outerType;
+        ReturnErrorOnFailure(writer.StartContainer(tag, kTLVType_Structure, outerType));
+        ReturnErrorOnFailure(writer.Put(TLV::ContextTag(0), id));
+        ReturnErrorOnFailure(writer.Put(TLV::ContextTag(1), ByteSpan(payload)));
+        return writer.EndContainer(outerType);
+    }
+};
+
+size_t CountedItem::sEncodeCount = 0;
+
+// Encodes a list of aItemCount items in chunks of N bytes, the way the reporting engine does, and returns the chunks.
+template <size_t N>
+std::vector<std::vector<uint8_t>> EncodeListInChunks(AttributeListItemCarry * aCarry, uint8_t aItemCount)
+{
+    std::vector<std::vector<uint8_t>> chunks;
+    AttributeEncodeState state;
+    state.SetListItemCarry(aCarry);
+
+    auto listEncoder = [aItemCount](const auto & encoder) -> CHIP_ERROR {
+        for (uint8_t i = 0; i < aItemCount; i++)
+        {
+            ReturnErrorOnFailure(encoder.Encode(CountedItem{ i }));
+        }
+        return CHIP_NO_ERROR;
+    };
+
+    for (uint8_t chunk = 0; chunk <= aItemCount; chunk++)
+    {
+        LimitedTestSetup<N> test(kUndefinedFabricIndex, state);
+        CHIP_ERROR err = test.encoder.EncodeList(listEncoder);
+        chunks.emplace_back(test.buf, test.buf + test.writer.GetLengthWritten());
+        if (err == CHIP_NO_ERROR)
+        {
+            break;
+        }
+        EXPECT_TRUE(err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL);
+        EXPECT_TRUE(test.encoder.GetState().AllowPartialData());
+        state = test.encoder.GetState();
+    }
+    return chunks;
+}
+
+TEST_F(TestListItemCarry, TestCopyWithTag)
+{
+    AttributeListItemCarry carry;
+    const ConcreteAttributePath path(kRandomEndpointId, kRandomClusterId, kRandomAttributeId);
+
+    EXPECT_EQ(carry.Stage([](TLVWriter & writer) { return CountedItem{ 7 }.Encode(writer, AnonymousTag()); }), CHIP_NO_ERROR);
+    EXPECT_FALSE(carry.IsHolding());
+
+    // Context tags need a structure to be written in.
+    uint8_t expected[64];
+    uint8_t copied[64];
+    TLVWriter writer;
+    TLVType outerType;
+    writer.Init(expected);
+    EXPECT_EQ(writer.StartContainer(AnonymousTag(), kTLVType_Structure, outerType), CHIP_NO_ERROR);
+    EXPECT_EQ(CountedItem{ 7 }.Encode(writer, ContextTag(AttributeDataIB::Tag::kData)), CHIP_NO_ERROR);
+    const uint32_t expectedLength = writer.GetLengthWritten();
+
+    writer.Init(copied);
+    EXPECT_EQ(writer.StartContainer(AnonymousTag(), kTLVType_Structure, outerType), CHIP_NO_ERROR);
+    EXPECT_EQ(carry.CopyTo(writer, ContextTag(AttributeDataIB::Tag::kData)), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.GetLengthWritten(), expectedLength);
+    EXPECT_EQ(memcmp(copied, expected, expectedLength), 0);
+
+    // Too little room: the writer reports it, the carry keeps the item.
+    writer.Init(copied, carry.GetLength() - 1);
+    CHIP_ERROR err = carry.CopyTo(writer, AnonymousTag());
+    EXPECT_TRUE(err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    carry.Hold(path, kRandomDataVersion, 3);
+    EXPECT_TRUE(carry.Holds(path, kRandomDataVersion, 3));
+    EXPECT_FALSE(carry.Holds(path, kRandomDataVersion, 4));
+    EXPECT_FALSE(carry.Holds(path, kRandomDataVersion + 1, 3));
+    EXPECT_FALSE(carry.Holds(ConcreteAttributePath(kRandomEndpointId, kRandomClusterId, kRandomAttributeId + 1),
+                             kRandomDataVersion, 3));
+
+    // Scalars are copied with their new tag too.
+    EXPECT_EQ(carry.Stage([](TLVWriter & stagingWriter) { return stagingWriter.Put(AnonymousTag(), true); }), CHIP_NO_ERROR);
+    EXPECT_FALSE(carry.IsHolding());
+    writer.Init(copied);
+    EXPECT_EQ(writer.StartContainer(AnonymousTag(), kTLVType_Structure, outerType), CHIP_NO_ERROR);
+    EXPECT_EQ(carry.CopyTo(writer, ContextTag(2)), CHIP_NO_ERROR);
+    const uint8_t expectedTrue[] = { 0x15, 0x29, 0x02 };
+    EXPECT_EQ(writer.GetLengthWritten(), sizeof(expectedTrue));
+    EXPECT_EQ(memcmp(copied, expectedTrue, sizeof(expectedTrue)), 0);
+
+    carry.Release();
+    EXPECT_EQ(carry.CopyTo(writer, AnonymousTag()), CHIP_ERROR_INCORRECT_STATE);
+}
+
+TEST_F(TestListItemCarry, TestListChunkingEncodesEachItemOnce)
+{
+    constexpr uint8_t kItemCount = 10;
+
+    CountedItem::sEncodeCount                                  = 0;
+    const std::vector<std::vector<uint8_t>> chunksWithoutCarry = EncodeListInChunks<150>(nullptr, kItemCount);
+    const size_t encodeCountWithoutCarry                       = CountedItem::sEncodeCount;
+
+    AttributeListItemCarry carry;
+    CountedItem::sEncodeCount                               = 0;
+    const std::vector<std::vector<uint8_t>> chunksWithCarry = EncodeListInChunks<150>(&carry, kItemCount);
+
+    // The chunks are the same either way, but without the carry, the item that does not fit in a chunk is encoded for it,
+    // then again for the next one.
+    EXPECT_GT(chunksWithoutCarry.size(), 2u);
+    EXPECT_TRUE(chunksWithCarry == chunksWithoutCarry);
+    EXPECT_GT(encodeCountWithoutCarry, static_cast<size_t>(kItemCount));
+    EXPECT_EQ(CountedItem::sEncodeCount, static_cast<size_t>(kItemCount));
+    EXPECT_FALSE(carry.IsHolding());
+}
+
 #undef VERIFY_BUFFER_STATE
 
 } // anonymous namespace
@@ -278,7 +278,8 @@ void DataSeriesGenerator::Generate(ForwardedDataCallbackValidator & dataCallback
     callback->OnReportEnd();
 }
 
-class CacheValidator : public ClusterStateCache::Callback
+template <typename CacheType>
+class CacheValidator : public CacheType::Callback
 {
 public:
     CacheValidator(AttributeInstructionListType & instructionList, ForwardedDataCallbackValidator & dataCallbackValidator);
@@ -309,7 +310,7 @@ private:
         }
     }
 
-    void DecodeAttribute(const AttributeInstruction & instruction, const ConcreteAttributePath & path, ClusterStateCache * cache)
+    void DecodeAttribute(const AttributeInstruction & instruction, const ConcreteAttributePath & path, CacheType * cache)
     {
         CHIP_ERROR err;
         bool gotStatus = false;
@@ -322,7 +323,7 @@ private:
             ChipLogProgress(DataManagement, "\t\t -- Validating A");
 
             Clusters::UnitTesting::Attributes::Int16u::TypeInfo::DecodableType v = 0;
-            err = cache->Get<Clusters::UnitTesting::Attributes::Int16u::TypeInfo>(path, v);
+            err = cache->template Get<Clusters::UnitTesting::Attributes::Int16u::TypeInfo>(path, v);
             if (err == CHIP_ERROR_IM_STATUS_CODE_RECEIVED)
             {
                 gotStatus = true;
@@ -341,7 +342,7 @@ private:
             ChipLogProgress(DataManagement, "\t\t -- Validating B");
 
             Clusters::UnitTesting::Attributes::OctetString::TypeInfo::DecodableType v;
-            err = cache->Get<Clusters::UnitTesting::Attributes::OctetString::TypeInfo>(path, v);
+            err = cache->template Get<Clusters::UnitTesting::Attributes::OctetString::TypeInfo>(path, v);
             if (err == CHIP_ERROR_IM_STATUS_CODE_RECEIVED)
             {
                 gotStatus = true;
@@ -360,7 +361,7 @@ private:
             ChipLogProgress(DataManagement, "\t\t -- Validating C");
 
             Clusters::UnitTesting::Attributes::StructAttr::TypeInfo::DecodableType v;
-            err = cache->Get<Clusters::UnitTesting::Attributes::StructAttr::TypeInfo>(path, v);
+            err = cache->template Get<Clusters::UnitTesting::Attributes::StructAttr::TypeInfo>(path, v);
             if (err == CHIP_ERROR_IM_STATUS_CODE_RECEIVED)
             {
                 gotStatus = true;
@@ -379,7 +380,7 @@ private:
             ChipLogProgress(DataManagement, "\t\t -- Validating D");
 
             Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo::DecodableType v;
-            err = cache->Get<Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo>(path, v);
+            err = cache->template Get<Clusters::UnitTesting::Attributes::ListStructOctetString::TypeInfo>(path, v);
             if (err == CHIP_ERROR_IM_STATUS_CODE_RECEIVED)
             {
                 gotStatus = true;
@@ -409,10 +410,9 @@ private:
         }
     }
 
-    void DecodeClusterObject(const AttributeInstruction & instruction, const ConcreteAttributePath & path,
-                             ClusterStateCache * cache)
+    void DecodeClusterObject(const AttributeInstruction & instruction, const ConcreteAttributePath & path, CacheType * cache)
     {
-        std::list<ClusterStateCache::AttributeStatus> statusList;
+        std::list<typename CacheType::AttributeStatus> statusList;
         EXPECT_EQ(cache->Get(path.mEndpointId, path.mClusterId, clusterValue, statusList), CHIP_NO_ERROR);
 
         if (instruction.mValueType == AttributeInstruction::kData)
@@ -462,7 +462,7 @@ private:
         }
     }
 
-    void OnAttributeChanged(ClusterStateCache * cache, const ConcreteAttributePath & path) override
+    void OnAttributeChanged(CacheType * cache, const ConcreteAttributePath & path) override
     {
         StatusIB status;
 
@@ -490,14 +490,14 @@ private:
         }
     }
 
-    void OnClusterChanged(ClusterStateCache * cache, EndpointId endpointId, ClusterId clusterId) override
+    void OnClusterChanged(CacheType * cache, EndpointId endpointId, ClusterId clusterId) override
     {
         auto iter = mExpectedClusters.find(std::make_tuple(endpointId, clusterId));
         ASSERT_NE(iter, mExpectedClusters.end());
         mExpectedClusters.erase(iter);
     }
 
-    void OnEndpointAdded(ClusterStateCache * cache, EndpointId endpointId) override
+    void OnEndpointAdded(CacheType * cache, EndpointId endpointId) override
     {
         auto iter = mExpectedEndpoints.find(endpointId);
         ASSERT_NE(iter, mExpectedEndpoints.end());
@@ -523,8 +523,9 @@ private:
     ForwardedDataCallbackValidator & mDataCallbackValidator;
 };
 
-CacheValidator::CacheValidator(AttributeInstructionListType & instructionList,
-                               ForwardedDataCallbackValidator & dataCallbackValidator) :
+template <typename CacheType>
+CacheValidator<CacheType>::CacheValidator(AttributeInstructionListType & instructionList,
+                                          ForwardedDataCallbackValidator & dataCallbackValidator) :
     mDataCallbackValidator(dataCallbackValidator)
 {
     for (auto & instruction : instructionList)
@@ -542,11 +543,12 @@ CacheValidator::CacheValidator(AttributeInstructionListType & instructionList,
     }
 }
 
+template <typename CacheType>
 void RunAndValidateSequence(AttributeInstructionListType list)
 {
     ForwardedDataCallbackValidator dataCallbackValidator;
-    CacheValidator client(list, dataCallbackValidator);
-    ClusterStateCache cache(client);
+    CacheValidator<CacheType> client(list, dataCallbackValidator);
+    CacheType cache(client);
 
     // In order for the cache to track our data versions, we need to claim to it
     // that we are dealing with a wildcard path.  And we need to do that before
@@ -701,6 +703,14 @@ void RunAndValidateSequence(AttributeInstructionListType list)
     }
 }
 
+void RunAndValidateSequence(AttributeInstructionListType list)
+{
+    ChipLogProgress(DataManagement, "\t -- Map storage");
+    RunAndValidateSequence<ClusterStateCache>(list);
+    ChipLogProgress(DataManagement, "\t -- Flat storage");
+    RunAndValidateSequence<ClusterStateCacheFlat>(list);
+}
+
 /*
  * This validates the cache by issuing different sequences of attribute combinations
  * and ensuring that the latest view in the cache matches up with expectations.
@@ -771,4 +781,188 @@ TEST_F(TestClusterStateCache, TestCache)
                              AttributeInstruction(AttributeInstruction::kAttributeB, 0, AttributeInstruction::kData) });
 }
 
+void SetOctetString(ClusterStateCacheFlatStorage & storage, const ConcreteAttributePath & path, uint8_t fill, size_t length)
+{
+    uint8_t value[512];
+    memset(value, fill, length);
+
+    uint8_t buffer[600];
+    TLV::TLVWriter writer;
+    writer.Init(buffer);
+    EXPECT_EQ(writer.PutBytes(TLV::AnonymousTag(), value, static_cast<uint32_t>(length)), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    reader.Init(buffer, writer.GetLengthWritten());
+    EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
+    EXPECT_EQ(storage.SetAttributeData(path, reader, writer.GetLengthWritten()), CHIP_NO_ERROR);
+}
+
+void ExpectOctetString(const ClusterStateCacheFlatStorage & storage, const ConcreteAttributePath & path, uint8_t fill,
+                       size_t length)
+{
+    ClusterStateCacheAttributeValue value;
+    ASSERT_EQ(storage.GetAttribute(path, value), CHIP_NO_ERROR);
+    ASSERT_EQ(value.mType, ClusterStateCacheAttributeValue::Type::kData);
+
+    TLV::TLVReader reader;
+    reader.Init(value.mData);
+    ASSERT_EQ(reader.Next(), CHIP_NO_ERROR);
+    ByteSpan bytes;
+    ASSERT_EQ(reader.Get(bytes), CHIP_NO_ERROR);
+    ASSERT_EQ(bytes.size(), length);
+    for (auto byte : bytes)
+    {
+        EXPECT_EQ(byte, fill);
+    }
+}
+
+TEST_F(TestClusterStateCache, TestFlatStorage)
+{
+    ClusterStateCacheFlatStorage storage;
+
+    // Out of order, so that records get inserted in the middle of the vectors.
+    const ConcreteAttributePath pathA(2, Clusters::UnitTesting::Id, 5);
+    const ConcreteAttributePath pathB(1, Clusters::UnitTesting::Id, 7);
+    const ConcreteAttributePath pathC(1, Clusters::UnitTesting::Id, 3);
+    const ConcreteAttributePath pathD(1, Clusters::OnOff::Id, 0);
+
+    SetOctetString(storage, pathA, 0xA, 400);
+    SetOctetString(storage, pathB, 0xB, 10);
+    SetOctetString(storage, pathC, 0xC, 20);
+    storage.SetAttributeStatus(pathD, StatusIB(Protocols::InteractionModel::Status::UnsupportedRead));
+
+    EXPECT_TRUE(storage.HasEndpoint(1));
+    EXPECT_TRUE(storage.HasEndpoint(2));
+    EXPECT_FALSE(storage.HasEndpoint(3));
+    EXPECT_NE(storage.FindCluster(1, Clusters::OnOff::Id), nullptr);
+    EXPECT_EQ(storage.FindCluster(2, Clusters::OnOff::Id), nullptr);
+
+    std::vector<AttributeId> attributes;
+    EXPECT_EQ(storage.ForEachAttribute(1, Clusters::UnitTesting::Id,
+                                       [&attributes](AttributeId attributeId, const ClusterStateCacheAttributeValue &) {
+                                           attributes.push_back(attributeId);
+                                           return CHIP_NO_ERROR;
+                                       }),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(attributes, (std::vector<AttributeId>{ 3, 7 }));
+
+    std::vector<ClusterId> clusters;
+    EXPECT_EQ(storage.ForEachCluster(1,
+                                     [&clusters](ClusterId clusterId) {
+                                         clusters.push_back(clusterId);
+                                         return CHIP_NO_ERROR;
+                                     }),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(clusters, (std::vector<ClusterId>{ Clusters::OnOff::Id, Clusters::UnitTesting::Id }));
+
+    ClusterStateCacheAttributeValue value;
+    ASSERT_EQ(storage.GetAttribute(pathD, value), CHIP_NO_ERROR);
+    EXPECT_EQ(value.mType, ClusterStateCacheAttributeValue::Type::kStatus);
+    EXPECT_EQ(value.mStatus.mStatus, Protocols::InteractionModel::Status::UnsupportedRead);
+
+    // Not enough garbage to be worth compacting.
+    const size_t arenaSize = storage.GetArenaSize();
+    SetOctetString(storage, pathB, 0xB, 20);
+    storage.Compact();
+    EXPECT_GT(storage.GetArenaSize(), arenaSize);
+
+    // Replacing the large value several times makes most of the arena garbage.
+    for (uint8_t fill = 1; fill <= 4; fill++)
+    {
+        SetOctetString(storage, pathA, fill, 400);
+    }
+    EXPECT_GT(storage.GetArenaSize(), 2 * storage.GetLiveDataSize());
+    storage.Compact();
+    EXPECT_EQ(storage.GetArenaSize(), storage.GetLiveDataSize());
+
+    ExpectOctetString(storage, pathA, 4, 400);
+    ExpectOctetString(storage, pathB, 0xB, 20);
+    ExpectOctetString(storage, pathC, 0xC, 20);
+
+    // Removing values releases their data.
+    const size_t liveDataSize = storage.GetLiveDataSize();
+    storage.RemoveAttribute(pathC);
+    EXPECT_LT(storage.GetLiveDataSize(), liveDataSize);
+    EXPECT_EQ(storage.GetAttribute(pathC, value), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_NE(storage.FindCluster(1, Clusters::UnitTesting::Id), nullptr);
+
+    storage.RemoveCluster(ConcreteClusterPath(1, Clusters::UnitTesting::Id));
+    EXPECT_EQ(storage.GetAttribute(pathB, value), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(storage.FindCluster(1, Clusters::UnitTesting::Id), nullptr);
+    EXPECT_TRUE(storage.HasEndpoint(1));
+
+    storage.RemoveEndpoint(2);
+    EXPECT_FALSE(storage.HasEndpoint(2));
+    EXPECT_EQ(storage.GetAttribute(pathA, value), CHIP_ERROR_KEY_NOT_FOUND);
+    EXPECT_EQ(storage.GetLiveDataSize(), 0u);
+    ASSERT_EQ(storage.GetAttribute(pathD, value), CHIP_NO_ERROR);
+}
+
+class NullCacheCallback : public ClusterStateCacheFlat::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+// Delivers a single report carrying one octet string value for a concrete path, the way a ReadClient would.
+void ReportOctetString(ClusterStateCacheFlat & cache, const ConcreteAttributePath & path, DataVersion version, uint8_t fill,
+                       size_t length)
+{
+    uint8_t value[512];
+    memset(value, fill, length);
+
+    uint8_t buffer[600];
+    TLV::TLVWriter writer;
+    writer.Init(buffer);
+    EXPECT_EQ(writer.PutBytes(TLV::AnonymousTag(), value, static_cast<uint32_t>(length)), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    reader.Init(buffer, writer.GetLengthWritten());
+    EXPECT_EQ(reader.Next(), CHIP_NO_ERROR);
+
+    ConcreteDataAttributePath dataPath(path.mEndpointId, path.mClusterId, path.mAttributeId, MakeOptional(version));
+    ReadClient::Callback & callback = cache.GetBufferedCallback();
+    callback.OnReportBegin();
+    callback.OnAttributeData(dataPath, &reader, StatusIB());
+    callback.OnReportEnd();
+}
+
+TEST_F(TestClusterStateCache, TestFlatStorageStaysBoundedWithConcretePaths)
+{
+    NullCacheCallback callback;
+    ClusterStateCacheFlat cache(callback);
+    const auto & storage = cache.GetStorageForTesting();
+
+    // No wildcard path is ever requested, so no cluster data version gets committed; the replaced values must still be
+    // reclaimed.
+    const ConcreteAttributePath pathA(1, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::OctetString::Id);
+    const ConcreteAttributePath pathB(2, Clusters::UnitTesting::Id, Clusters::UnitTesting::Attributes::OctetString::Id);
+    constexpr size_t kValueLength = 400;
+    for (DataVersion version = 1; version <= 100; version++)
+    {
+        ReportOctetString(cache, pathA, version, static_cast<uint8_t>(version), kValueLength);
+        ReportOctetString(cache, pathB, version, static_cast<uint8_t>(version), kValueLength);
+
+        // Garbage is only left behind while it is under the compaction threshold or under the live data size.
+        EXPECT_LE(storage.GetArenaSize(), 2 * storage.GetLiveDataSize() + 1024);
+    }
+
+    TLV::TLVReader reader;
+    ASSERT_EQ(cache.Get(pathA, reader), CHIP_NO_ERROR);
+    ByteSpan bytes;
+    ASSERT_EQ(reader.Get(bytes), CHIP_NO_ERROR);
+    ASSERT_EQ(bytes.size(), kValueLength);
+    EXPECT_EQ(bytes[0], 100);
+
+    // Values of removed endpoints are reclaimed by the next report.
+    cache.ClearAttributes(EndpointId(2));
+    for (DataVersion version = 101; version <= 103; version++)
+    {
+        ReportOctetString(cache, pathA, version, static_cast<uint8_t>(version), kValueLength);
+    }
+    EXPECT_LE(storage.GetArenaSize(), 2 * storage.GetLiveDataSize() + 1024);
+    EXPECT_LT(storage.GetArenaSize(), 4 * (kValueLength + 8));
+}
+
 } // namespace
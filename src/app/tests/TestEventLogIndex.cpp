@@ -0,0 +1,167 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/EventLogIndex.h>
+#include <lib/support/CodeUtils.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+EventLogIndex::Entry MakeEntry(EventNumber aEventNumber, uint32_t aLength, FabricIndex aFabricIndex = kUndefinedFabricIndex)
+{
+    EventLogIndex::Entry entry;
+    entry.mEventNumber    = aEventNumber;
+    entry.mEndpointId     = 1;
+    entry.mClusterId      = 0x0006;
+    entry.mEventId        = static_cast<EventId>(aEventNumber);
+    entry.mLength         = aLength;
+    entry.mFabricIndex    = aFabricIndex;
+    entry.mHasFabricIndex = (aFabricIndex != kUndefinedFabricIndex);
+    return entry;
+}
+
+TEST(TestEventLogIndex, TestOffsets)
+{
+    EventLogIndex::Entry entries[8];
+    EventLogIndex index;
+    index.Init(entries, ArraySize(entries));
+    EXPECT_TRUE(index.IsValid());
+    EXPECT_TRUE(index.Covers(0));
+
+    index.Append(MakeEntry(10, 20));
+    index.Append(MakeEntry(11, 30));
+    index.Append(MakeEntry(12, 40));
+    index.Append(MakeEntry(13, 50));
+
+    ASSERT_EQ(index.Count(), 4u);
+    EXPECT_EQ(index.GetLogLength(), 140u);
+    EXPECT_EQ(index.Get(0).mOffset, 0u);
+    EXPECT_EQ(index.Get(1).mOffset, 20u);
+    EXPECT_EQ(index.Get(2).mOffset, 50u);
+    EXPECT_EQ(index.Get(3).mOffset, 90u);
+
+    EXPECT_EQ(index.LowerBound(0), 0u);
+    EXPECT_EQ(index.LowerBound(12), 2u);
+    EXPECT_EQ(index.LowerBound(14), 4u);
+
+    // Dropping an event in the middle of the log moves the events after it.
+    index.Remove(12, 40);
+    ASSERT_EQ(index.Count(), 3u);
+    EXPECT_EQ(index.GetLogLength(), 100u);
+    EXPECT_EQ(index.Get(2).mEventNumber, 13u);
+    EXPECT_EQ(index.Get(2).mOffset, 50u);
+    EXPECT_EQ(index.LowerBound(12), 2u);
+
+    // Dropping the oldest event moves all of them.
+    index.Remove(10, 20);
+    ASSERT_EQ(index.Count(), 2u);
+    EXPECT_EQ(index.Get(0).mEventNumber, 11u);
+    EXPECT_EQ(index.Get(0).mOffset, 0u);
+    EXPECT_EQ(index.Get(1).mOffset, 30u);
+
+    index.Append(MakeEntry(14, 10));
+    EXPECT_EQ(index.Get(2).mOffset, 80u);
+    EXPECT_EQ(index.GetLogLength(), 90u);
+    EXPECT_TRUE(index.IsValid());
+}
+
+TEST(TestEventLogIndex, TestFullIndexKeepsNewestEvents)
+{
+    EventLogIndex::Entry entries[3];
+    EventLogIndex index;
+    index.Init(entries, ArraySize(entries));
+
+    for (EventNumber number = 1; number <= 5; number++)
+    {
+        index.Append(MakeEntry(number, static_cast<uint32_t>(10 * number)));
+    }
+
+    // Events 1 and 2 (30 bytes) are no longer indexed, but still in the log.
+    ASSERT_EQ(index.Count(), 3u);
+    EXPECT_EQ(index.GetLogLength(), 150u);
+    EXPECT_EQ(index.Get(0).mEventNumber, 3u);
+    EXPECT_EQ(index.Get(0).mOffset, 30u);
+    EXPECT_EQ(index.Get(1).mOffset, 60u);
+    EXPECT_EQ(index.Get(2).mOffset, 100u);
+    EXPECT_FALSE(index.Covers(2));
+    EXPECT_TRUE(index.Covers(3));
+
+    // Dropping an event that is no longer indexed only moves the indexed ones.
+    index.Remove(1, 10);
+    EXPECT_EQ(index.GetLogLength(), 140u);
+    EXPECT_EQ(index.Get(0).mOffset, 20u);
+    EXPECT_EQ(index.Get(2).mOffset, 90u);
+
+    index.Remove(2, 20);
+    EXPECT_TRUE(index.Covers(0));
+    EXPECT_EQ(index.Get(0).mOffset, 0u);
+    EXPECT_TRUE(index.IsValid());
+}
+
+TEST(TestEventLogIndex, TestOutOfSync)
+{
+    EventLogIndex::Entry entries[4];
+    EventLogIndex index;
+    index.Init(entries, ArraySize(entries));
+
+    index.Append(MakeEntry(1, 10));
+    index.Append(MakeEntry(2, 10));
+
+    // An event the index does not know about.
+    index.Remove(3, 10);
+    EXPECT_FALSE(index.IsValid());
+    EXPECT_FALSE(index.Covers(0));
+
+    index.Clear();
+    EXPECT_TRUE(index.IsValid());
+    EXPECT_EQ(index.Count(), 0u);
+
+    // An event of an unexpected length.
+    index.Append(MakeEntry(1, 10));
+    index.Remove(1, 12);
+    EXPECT_FALSE(index.IsValid());
+
+    // An index without entries is never valid.
+    EventLogIndex emptyIndex;
+    emptyIndex.Init(nullptr, 0);
+    EXPECT_FALSE(emptyIndex.IsValid());
+}
+
+TEST(TestEventLogIndex, TestFabricRemoved)
+{
+    EventLogIndex::Entry entries[4];
+    EventLogIndex index;
+    index.Init(entries, ArraySize(entries));
+
+    index.Append(MakeEntry(1, 10, 1));
+    index.Append(MakeEntry(2, 10, 2));
+    index.Append(MakeEntry(3, 10));
+
+    index.FabricRemoved(1);
+    EXPECT_TRUE(index.Get(0).mHasFabricIndex);
+    EXPECT_EQ(index.Get(0).mFabricIndex, kUndefinedFabricIndex);
+    EXPECT_EQ(index.Get(1).mFabricIndex, 2);
+    EXPECT_FALSE(index.Get(2).mHasFabricIndex);
+}
+
+} // namespace
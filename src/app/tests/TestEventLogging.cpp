@@ -21,6 +21,7 @@
 #include <app/EventLoggingTypes.h>
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
+#include <app/MessageDef/EventReportIB.h>
 #include <app/tests/AppTestContext.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/ErrorStr.h>
@@ -37,6 +38,8 @@
 #include <platform/CHIPDeviceLayer.h>
 #include <system/TLVPacketBufferBackingStore.h>
 
+#include <vector>
+
 #include <lib/core/StringBuilderAdapters.h>
 #include <pw_unit_test/framework.h>
 
@@ -53,6 +56,11 @@ static uint8_t gInfoEventBuffer[120];
 static uint8_t gCritEventBuffer[120];
 static chip::app::CircularEventBuffer gCircularEventBuffer[3];
 
+// Buffers for logs holding more events than the event log index, when it is enabled.
+static uint8_t gLargeDebugEventBuffer[256];
+static uint8_t gLargeInfoEventBuffer[768];
+static uint8_t gLargeCritEventBuffer[256];
+
 class TestEventLogging : public chip::Test::AppContext
 {
 public:
@@ -153,6 +161,58 @@ static void CheckLogReadOut(chip::app::EventManagement & alogMgmt, chip::EventNu
     chip::TLV::Debug::Dump(reader, SimpleDumpWriter);
 }
 
+struct FetchedEvent
+{
+    chip::EventNumber mEventNumber;
+    chip::EndpointId mEndpointId;
+    int32_t mStatus;
+
+    bool operator==(const FetchedEvent & aOther) const
+    {
+        return mEventNumber == aOther.mEventNumber && mEndpointId == aOther.mEndpointId && mStatus == aOther.mStatus;
+    }
+};
+
+// Fetches the events since startingEventNumber, and decodes them.
+static std::vector<FetchedEvent> FetchEvents(chip::app::EventManagement & alogMgmt, chip::EventNumber startingEventNumber,
+                                             chip::SingleLinkedListNode<chip::app::EventPathParams> * clusterInfo)
+{
+    std::vector<FetchedEvent> events;
+    chip::TLV::TLVWriter writer;
+    size_t eventCount = 0;
+
+    chip::Platform::ScopedMemoryBuffer<uint8_t> backingStore;
+    VerifyOrDie(backingStore.Alloc(4096));
+    writer.Init(backingStore.Get(), 4096);
+    EXPECT_EQ(alogMgmt.FetchEventsSince(writer, clusterInfo, startingEventNumber, eventCount, chip::Access::SubjectDescriptor{}),
+              CHIP_NO_ERROR);
+
+    chip::TLV::TLVReader reader;
+    reader.Init(backingStore.Get(), writer.GetLengthWritten());
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        chip::app::EventReportIB::Parser report;
+        chip::app::EventDataIB::Parser data;
+        chip::app::EventPathIB::Parser path;
+        chip::TLV::TLVReader dataReader;
+        chip::TLV::TLVType containerType;
+        FetchedEvent event;
+
+        EXPECT_EQ(report.Init(reader), CHIP_NO_ERROR);
+        EXPECT_EQ(report.GetEventData(&data), CHIP_NO_ERROR);
+        EXPECT_EQ(data.GetEventNumber(&event.mEventNumber), CHIP_NO_ERROR);
+        EXPECT_EQ(data.GetPath(&path), CHIP_NO_ERROR);
+        EXPECT_EQ(path.GetEndpoint(&event.mEndpointId), CHIP_NO_ERROR);
+        EXPECT_EQ(data.GetData(&dataReader), CHIP_NO_ERROR);
+        EXPECT_EQ(dataReader.EnterContainer(containerType), CHIP_NO_ERROR);
+        EXPECT_EQ(dataReader.Next(kLivenessDeviceStatus), CHIP_NO_ERROR);
+        EXPECT_EQ(dataReader.Get(event.mStatus), CHIP_NO_ERROR);
+        events.push_back(event);
+    }
+    EXPECT_EQ(events.size(), eventCount);
+    return events;
+}
+
 class TestEventGenerator : public chip::app::EventLoggingDelegate
 {
 public:
@@ -283,4 +343,184 @@ TEST_F(TestEventLogging, TestCheckLogEventWithDiscardLowEvent)
     CheckLogState(logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
 
+TEST_F(TestEventLogging, TestFetchRecentEventsMatchesLogScan)
+{
+    // A larger log, which holds more events than CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE: a fetch from the start scans the log,
+    // while a fetch of the recent events reads the indexed ones only.
+    const chip::app::LogStorageResources logStorageResources[] = {
+        { &gLargeDebugEventBuffer[0], sizeof(gLargeDebugEventBuffer), chip::app::PriorityLevel::Debug },
+        { &gLargeInfoEventBuffer[0], sizeof(gLargeInfoEventBuffer), chip::app::PriorityLevel::Info },
+        { &gLargeCritEventBuffer[0], sizeof(gLargeCritEventBuffer), chip::app::PriorityLevel::Critical },
+    };
+    chip::MonotonicallyIncreasingCounter<chip::EventNumber> eventCounter;
+    ASSERT_EQ(eventCounter.Init(0), CHIP_NO_ERROR);
+    chip::app::EventManagement::DestroyEventManagement();
+    chip::app::EventManagement::CreateEventManagement(&GetExchangeManager(), ArraySize(logStorageResources), gCircularEventBuffer,
+                                                      logStorageResources, &eventCounter);
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+
+    // Enough events for the oldest ones to be evicted.
+    TestEventGenerator testEventGenerator;
+    chip::app::EventOptions options;
+    options.mPriority = chip::app::PriorityLevel::Info;
+    for (int32_t i = 0; i < 60; i++)
+    {
+        chip::EventNumber eid;
+        options.mPath = { (i % 3 == 0) ? kTestEndpointId2 : kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+        testEventGenerator.SetStatus(i);
+        EXPECT_EQ(logMgmt.LogEvent(&testEventGenerator, options, eid), CHIP_NO_ERROR);
+    }
+
+    chip::SingleLinkedListNode<chip::app::EventPathParams> wildcardPath;
+    chip::SingleLinkedListNode<chip::app::EventPathParams> endpoint2Path;
+    endpoint2Path.mValue.mEndpointId = kTestEndpointId2;
+    endpoint2Path.mValue.mClusterId  = kLivenessClusterId;
+
+    for (auto * paths : { &wildcardPath, &endpoint2Path })
+    {
+        const std::vector<FetchedEvent> allEvents = FetchEvents(logMgmt, 0, paths);
+        ASSERT_GT(allEvents.size(), 6u);
+        EXPECT_GT(allEvents.front().mEventNumber, 0u);
+#if CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+        if (paths == &wildcardPath)
+        {
+            EXPECT_GT(allEvents.size(), static_cast<size_t>(CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE));
+        }
+#endif // CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
+        // The last events, fetched from the number of the first of them.
+        const std::vector<FetchedEvent> expected(allEvents.end() - 6, allEvents.end());
+        EXPECT_EQ(FetchEvents(logMgmt, expected.front().mEventNumber, paths), expected);
+
+        // Nothing since the last event.
+        EXPECT_TRUE(FetchEvents(logMgmt, allEvents.back().mEventNumber + 1, paths).empty());
+    }
+}
+
+#if CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+static void StopEventLoop(intptr_t context)
+{
+    chip::DeviceLayer::PlatformMgr().StopEventLoopTask();
+}
+
+TEST_F(TestEventLogging, TestStagedEventsAreLoggedLikeLoggedEvents)
+{
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    chip::SingleLinkedListNode<chip::app::EventPathParams> wildcardPath;
+    TestEventGenerator testEventGenerator;
+    chip::app::EventOptions options;
+    options.mPriority = chip::app::PriorityLevel::Critical;
+
+    // The same events, logged right away and then staged.
+    for (int32_t i = 0; i < 3; i++)
+    {
+        chip::EventNumber eid;
+        options.mPath = { (i == 1) ? kTestEndpointId2 : kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+        testEventGenerator.SetStatus(i);
+        EXPECT_EQ(logMgmt.LogEvent(&testEventGenerator, options, eid), CHIP_NO_ERROR);
+    }
+    for (int32_t i = 0; i < 3; i++)
+    {
+        options.mPath = { (i == 1) ? kTestEndpointId2 : kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+        testEventGenerator.SetStatus(i);
+        auto encodeData = [&testEventGenerator](chip::TLV::TLVWriter & aWriter) { return testEventGenerator.WriteEvent(aWriter); };
+        EXPECT_EQ(logMgmt.StageEvent(options, encodeData), CHIP_NO_ERROR);
+    }
+
+    // Staged events are only logged by the Matter thread.
+    const std::vector<FetchedEvent> loggedEvents = FetchEvents(logMgmt, 0, &wildcardPath);
+    ASSERT_EQ(loggedEvents.size(), 3u);
+
+    chip::DeviceLayer::PlatformMgr().ScheduleWork(StopEventLoop);
+    chip::DeviceLayer::PlatformMgr().RunEventLoop();
+
+    // They follow the logged events, in the order they were staged, with the same contents.
+    const std::vector<FetchedEvent> allEvents = FetchEvents(logMgmt, 0, &wildcardPath);
+    ASSERT_EQ(allEvents.size(), 6u);
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(allEvents[i], loggedEvents[i]);
+        EXPECT_EQ(allEvents[i + 3].mEventNumber, loggedEvents[i].mEventNumber + 3);
+        EXPECT_EQ(allEvents[i + 3].mEndpointId, loggedEvents[i].mEndpointId);
+        EXPECT_EQ(allEvents[i + 3].mStatus, loggedEvents[i].mStatus);
+    }
+}
+
+// Runs the work scheduled so far on the Matter thread, which drains the staged events.
+static void RunScheduledWork()
+{
+    chip::DeviceLayer::PlatformMgr().ScheduleWork(StopEventLoop);
+    chip::DeviceLayer::PlatformMgr().RunEventLoop();
+}
+
+TEST_F(TestEventLogging, TestStagedEventBehindEncodeErrorIsLogged)
+{
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    chip::SingleLinkedListNode<chip::app::EventPathParams> wildcardPath;
+    TestEventGenerator testEventGenerator;
+    chip::app::EventOptions options;
+    options.mPriority = chip::app::PriorityLevel::Critical;
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+
+    const chip::EventNumber lastEventNumber = logMgmt.GetLastEventNumber();
+
+    // While the first producer encodes its event, another one stages an event behind it, whose logging runs before the
+    // first event is published and so finds nothing to log. The first event then fails to encode.
+    auto failToEncode = [&](chip::TLV::TLVWriter &) {
+        chip::app::EventOptions otherOptions;
+        otherOptions.mPriority = chip::app::PriorityLevel::Critical;
+        otherOptions.mPath     = { kTestEndpointId2, kLivenessClusterId, kLivenessChangeEvent };
+        testEventGenerator.SetStatus(7);
+        auto encodeData = [&testEventGenerator](chip::TLV::TLVWriter & aWriter) { return testEventGenerator.WriteEvent(aWriter); };
+        EXPECT_EQ(logMgmt.StageEvent(otherOptions, encodeData), CHIP_NO_ERROR);
+        RunScheduledWork();
+        EXPECT_EQ(logMgmt.GetLastEventNumber(), lastEventNumber);
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    };
+    EXPECT_EQ(logMgmt.StageEvent(options, failToEncode), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    // The failed event still schedules the logging of the one behind it.
+    RunScheduledWork();
+    EXPECT_EQ(logMgmt.GetLastEventNumber(), lastEventNumber + 1);
+    const std::vector<FetchedEvent> events = FetchEvents(logMgmt, 0, &wildcardPath);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].mEndpointId, kTestEndpointId2);
+    EXPECT_EQ(events[0].mStatus, 7);
+}
+
+TEST_F(TestEventLogging, TestFullStagingQueueWithNoDrainPendingIsLogged)
+{
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    TestEventGenerator testEventGenerator;
+    chip::app::EventOptions options;
+    options.mPriority = chip::app::PriorityLevel::Critical;
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    auto encodeData   = [&testEventGenerator](chip::TLV::TLVWriter & aWriter) { return testEventGenerator.WriteEvent(aWriter); };
+
+    const chip::EventNumber lastEventNumber = logMgmt.GetLastEventNumber();
+
+    // Other producers fill the queue behind a first one that has not published its event yet, and the logging they
+    // scheduled has already run, so no drain is pending when the queue turns out to be full.
+    auto failToEncode = [&](chip::TLV::TLVWriter &) {
+        for (int32_t i = 0; i < CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE - 1; i++)
+        {
+            testEventGenerator.SetStatus(i);
+            EXPECT_EQ(logMgmt.StageEvent(options, encodeData), CHIP_NO_ERROR);
+        }
+        RunScheduledWork();
+        EXPECT_EQ(logMgmt.StageEvent(options, encodeData), CHIP_ERROR_NO_MEMORY);
+        EXPECT_EQ(logMgmt.GetLastEventNumber(), lastEventNumber);
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    };
+    EXPECT_EQ(logMgmt.StageEvent(options, failToEncode), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    // The queue is drained anyway, and takes events again.
+    RunScheduledWork();
+    EXPECT_EQ(logMgmt.GetLastEventNumber(), lastEventNumber + CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE - 1);
+    EXPECT_EQ(logMgmt.StageEvent(options, encodeData), CHIP_NO_ERROR);
+    RunScheduledWork();
+    EXPECT_EQ(logMgmt.GetLastEventNumber(), lastEventNumber + CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE);
+}
+#endif // CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE > 0
+
 } // namespace
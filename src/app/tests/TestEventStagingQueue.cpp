@@ -0,0 +1,221 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/EventStagingQueue.h>
+#include <app/MessageDef/EventDataIB.h>
+#include <lib/core/TLVReader.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemConfig.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <atomic>
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+using TestQueue = EventStagingQueue<4, 16>;
+
+EventOptions MakeOptions(EventId aEventId)
+{
+    EventOptions options;
+    options.mPath = ConcreteEventPath(1, 0x0006, aEventId);
+    return options;
+}
+
+CHIP_ERROR PushValue(TestQueue & aQueue, EventId aEventId, uint32_t aValue)
+{
+    return aQueue.Push(MakeOptions(aEventId), [aValue](TLV::TLVWriter & aWriter) {
+        return aWriter.Put(TLV::ContextTag(EventDataIB::Tag::kData), aValue);
+    });
+}
+
+CHIP_ERROR DecodeValue(ByteSpan aEncodedData, uint32_t & aValue)
+{
+    TLV::TLVReader reader;
+    TLV::TLVType containerType;
+    reader.Init(aEncodedData);
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+    ReturnErrorOnFailure(reader.Next(TLV::ContextTag(EventDataIB::Tag::kData)));
+    return reader.Get(aValue);
+}
+
+TEST(TestEventStagingQueue, TestOrder)
+{
+    TestQueue queue;
+
+    for (uint32_t lap = 0; lap < 3; lap++)
+    {
+        EXPECT_EQ(PushValue(queue, 1, 10 * lap), CHIP_NO_ERROR);
+        EXPECT_EQ(PushValue(queue, 2, 10 * lap + 1), CHIP_NO_ERROR);
+        EXPECT_EQ(PushValue(queue, 3, 10 * lap + 2), CHIP_NO_ERROR);
+
+        EventId nextEventId = 1;
+        size_t count        = queue.Drain([&](const EventOptions & aOptions, ByteSpan aEncodedData) {
+            uint32_t value = 0;
+            EXPECT_EQ(DecodeValue(aEncodedData, value), CHIP_NO_ERROR);
+            EXPECT_EQ(aOptions.mPath.mEventId, nextEventId);
+            EXPECT_EQ(value, 10 * lap + nextEventId - 1);
+            nextEventId++;
+        });
+        EXPECT_EQ(count, 3u);
+        EXPECT_EQ(queue.Drain([](const EventOptions &, ByteSpan) { FAIL(); }), 0u);
+    }
+}
+
+TEST(TestEventStagingQueue, TestFull)
+{
+    TestQueue queue;
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(PushValue(queue, 1, i), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(PushValue(queue, 1, 4), CHIP_ERROR_NO_MEMORY);
+
+    // Taking the events frees their slots.
+    EXPECT_EQ(queue.Drain([](const EventOptions &, ByteSpan) {}), 4u);
+    EXPECT_EQ(PushValue(queue, 1, 5), CHIP_NO_ERROR);
+
+    uint32_t value = 0;
+    EXPECT_EQ(queue.Drain([&](const EventOptions &, ByteSpan aEncodedData) {
+        EXPECT_EQ(DecodeValue(aEncodedData, value), CHIP_NO_ERROR);
+    }),
+              1u);
+    EXPECT_EQ(value, 5u);
+}
+
+TEST(TestEventStagingQueue, TestEncodeError)
+{
+    TestQueue queue;
+    const uint8_t tooLarge[32] = {};
+
+    EXPECT_EQ(PushValue(queue, 1, 1), CHIP_NO_ERROR);
+    EXPECT_EQ(queue.Push(MakeOptions(2),
+                         [&tooLarge](TLV::TLVWriter & aWriter) {
+                             return aWriter.Put(TLV::ContextTag(EventDataIB::Tag::kData), ByteSpan(tooLarge));
+                         }),
+              CHIP_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_EQ(PushValue(queue, 3, 3), CHIP_NO_ERROR);
+
+    // The event that could not be encoded is skipped.
+    EventId eventIds[3] = {};
+    size_t logged       = 0;
+    EXPECT_EQ(queue.Drain([&](const EventOptions & aOptions, ByteSpan) {
+        VerifyOrReturn(logged < ArraySize(eventIds));
+        eventIds[logged++] = aOptions.mPath.mEventId;
+    }),
+              2u);
+    EXPECT_EQ(logged, 2u);
+    EXPECT_EQ(eventIds[0], 1u);
+    EXPECT_EQ(eventIds[1], 3u);
+}
+
+TEST(TestEventStagingQueue, TestDrainPending)
+{
+    TestQueue queue;
+
+    EXPECT_TRUE(queue.SetDrainPending());
+    EXPECT_FALSE(queue.SetDrainPending());
+    queue.ClearDrainPending();
+    EXPECT_TRUE(queue.SetDrainPending());
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+constexpr size_t kProducerCount       = 4;
+constexpr uint32_t kEventsPerProducer = 2000;
+
+using ThreadedTestQueue = EventStagingQueue<16, 16>;
+
+struct Producer
+{
+    ThreadedTestQueue * mQueue;
+    EventId mEventId;
+    std::atomic<size_t> * mFinishedCount;
+};
+
+void * ProduceEvents(void * aProducer)
+{
+    const Producer & producer = *static_cast<Producer *>(aProducer);
+    for (uint32_t value = 0; value < kEventsPerProducer;)
+    {
+        CHIP_ERROR err = producer.mQueue->Push(MakeOptions(producer.mEventId), [value](TLV::TLVWriter & aWriter) {
+            return aWriter.Put(TLV::ContextTag(EventDataIB::Tag::kData), value);
+        });
+        if (err == CHIP_NO_ERROR)
+        {
+            value++;
+        }
+        else if (err == CHIP_ERROR_NO_MEMORY)
+        {
+            sched_yield();
+        }
+        else
+        {
+            break;
+        }
+    }
+    producer.mFinishedCount->fetch_add(1);
+    return nullptr;
+}
+
+TEST(TestEventStagingQueue, TestConcurrentProducers)
+{
+    ThreadedTestQueue queue;
+    std::atomic<size_t> finishedCount{ 0 };
+    Producer producers[kProducerCount];
+    pthread_t threads[kProducerCount];
+
+    for (size_t i = 0; i < kProducerCount; i++)
+    {
+        producers[i] = { &queue, static_cast<EventId>(i), &finishedCount };
+        ASSERT_EQ(pthread_create(&threads[i], nullptr, ProduceEvents, &producers[i]), 0);
+    }
+
+    // Every event is taken once, and the events of each producer are taken in order.
+    uint32_t nextValues[kProducerCount] = {};
+    size_t total                        = 0;
+    auto checkEvent                     = [&](const EventOptions & aOptions, ByteSpan aEncodedData) {
+        uint32_t value = 0;
+        EXPECT_EQ(DecodeValue(aEncodedData, value), CHIP_NO_ERROR);
+        ASSERT_LT(aOptions.mPath.mEventId, kProducerCount);
+        EXPECT_EQ(value, nextValues[aOptions.mPath.mEventId]++);
+    };
+    while (finishedCount.load() < kProducerCount)
+    {
+        total += queue.Drain(checkEvent);
+    }
+    total += queue.Drain(checkEvent);
+
+    for (pthread_t thread : threads)
+    {
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+    }
+    EXPECT_EQ(total, kProducerCount * kEventsPerProducer);
+    EXPECT_EQ(queue.Drain([](const EventOptions &, ByteSpan) {}), 0u);
+}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+} // namespace
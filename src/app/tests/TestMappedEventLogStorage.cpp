@@ -0,0 +1,216 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <access/SubjectDescriptor.h>
+#include <app/EventLoggingDelegate.h>
+#include <app/EventManagement.h>
+#include <app/MappedEventLogStorage.h>
+#include <app/MessageDef/EventDataIB.h>
+#include <app/tests/AppTestContext.h>
+#include <lib/support/CHIPCounter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/LinkedList.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+constexpr ClusterId kTestClusterId   = 0x00000022;
+constexpr EndpointId kTestEndpointId = 2;
+constexpr EventId kTestEventId       = 1;
+constexpr uint32_t kBufferSize       = 256;
+
+class TestEventGenerator : public EventLoggingDelegate
+{
+public:
+    CHIP_ERROR WriteEvent(TLV::TLVWriter & aWriter) override
+    {
+        TLV::TLVType containerType;
+        ReturnErrorOnFailure(
+            aWriter.StartContainer(TLV::ContextTag(EventDataIB::Tag::kData), TLV::kTLVType_Structure, containerType));
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(1), mValue));
+        return aWriter.EndContainer(containerType);
+    }
+
+    uint32_t mValue = 0;
+};
+
+class TestMappedEventLogStorage : public Test::AppContext
+{
+public:
+    void SetUp() override
+    {
+        AppContext::SetUp();
+        strcpy(mPath, "/tmp/TestMappedEventLogStorage-XXXXXX");
+        int fd = mkstemp(mPath);
+        ASSERT_GE(fd, 0);
+        close(fd);
+    }
+
+    void TearDown() override
+    {
+        StopLogging();
+        unlink(mPath);
+        AppContext::TearDown();
+    }
+
+protected:
+    // Opens the file and starts EventManagement on it, as after a restart with aEventCounter as the persisted event counter.
+    void StartLogging(EventNumber aEventCounter, uint32_t aBufferSize = kBufferSize)
+    {
+        mResources[0] = { nullptr, aBufferSize, PriorityLevel::Debug };
+        mResources[1] = { nullptr, aBufferSize, PriorityLevel::Info };
+        mResources[2] = { nullptr, aBufferSize, PriorityLevel::Critical };
+        ASSERT_EQ(mStorage.Open(mPath, mResources, ArraySize(mResources)), CHIP_NO_ERROR);
+        ASSERT_EQ(mEventCounter.Init(aEventCounter), CHIP_NO_ERROR);
+        EventManagement::CreateEventManagement(&GetExchangeManager(), ArraySize(mResources), mBuffers, mResources,
+                                               &mEventCounter);
+    }
+
+    void StopLogging()
+    {
+        if (mStorage.IsOpen())
+        {
+            EventManagement::DestroyEventManagement();
+            mStorage.Close();
+        }
+    }
+
+    void LogEvents(uint32_t aCount, EventNumber aFirstEventNumber)
+    {
+        TestEventGenerator generator;
+        EventOptions options;
+        options.mPath     = { kTestEndpointId, kTestClusterId, kTestEventId };
+        options.mPriority = PriorityLevel::Info;
+        for (uint32_t i = 0; i < aCount; i++)
+        {
+            EventNumber eventNumber;
+            generator.mValue = i;
+            EXPECT_EQ(EventManagement::GetInstance().LogEvent(&generator, options, eventNumber), CHIP_NO_ERROR);
+            EXPECT_EQ(eventNumber, aFirstEventNumber + i);
+        }
+    }
+
+    // Returns the number of events fetched from the log from aEventMin.
+    size_t FetchEvents(EventNumber aEventMin)
+    {
+        uint8_t buffer[4096];
+        TLV::TLVWriter writer;
+        SingleLinkedListNode<EventPathParams> path;
+        size_t eventCount = 0;
+
+        writer.Init(buffer);
+        CHIP_ERROR err =
+            EventManagement::GetInstance().FetchEventsSince(writer, &path, aEventMin, eventCount, Access::SubjectDescriptor{});
+        EXPECT_TRUE(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV);
+        return eventCount;
+    }
+
+    char mPath[64];
+    MappedEventLogStorage mStorage;
+    LogStorageResources mResources[3];
+    CircularEventBuffer mBuffers[3];
+    MonotonicallyIncreasingCounter<EventNumber> mEventCounter;
+};
+
+TEST_F(TestMappedEventLogStorage, TestRestoreEvents)
+{
+    StartLogging(0);
+    LogEvents(5, 0);
+    EXPECT_EQ(FetchEvents(0), 5u);
+    StopLogging();
+
+    StartLogging(5);
+    EXPECT_EQ(FetchEvents(0), 5u);
+
+    // New events follow the restored ones.
+    LogEvents(2, 5);
+    EXPECT_EQ(FetchEvents(0), 7u);
+}
+
+TEST_F(TestMappedEventLogStorage, TestRestoreEvictedEvents)
+{
+    // Enough events to move some of them to the buffer of the Info events, and to evict the first ones from it.
+    StartLogging(0);
+    LogEvents(40, 0);
+    const size_t eventCount = FetchEvents(0);
+    EXPECT_LT(eventCount, 40u);
+    StopLogging();
+
+    StartLogging(40);
+    EXPECT_EQ(FetchEvents(0), eventCount);
+    LogEvents(1, 40);
+    EXPECT_EQ(FetchEvents(40), 1u);
+}
+
+TEST_F(TestMappedEventLogStorage, TestTornStateRecord)
+{
+    StartLogging(0);
+    LogEvents(3, 0);
+    StopLogging();
+
+    // Tear the latest state record of the buffer the events are in, as a crash while writing it would: the previous
+    // record, from before the last event, is restored.
+    LogStorageResources resources[3] = { { nullptr, kBufferSize, PriorityLevel::Debug },
+                                         { nullptr, kBufferSize, PriorityLevel::Info },
+                                         { nullptr, kBufferSize, PriorityLevel::Critical } };
+    MappedEventLogStorage storage;
+    ASSERT_EQ(storage.Open(mPath, resources, ArraySize(resources)), CHIP_NO_ERROR);
+    PersistedEventBufferState::Record * records = resources[0].mpPersistedState->mRecords;
+    PersistedEventBufferState::Record & latest  = (records[0].mSequence > records[1].mSequence) ? records[0] : records[1];
+    latest.mDataLength++;
+    storage.Close();
+
+    StartLogging(3);
+    EXPECT_EQ(FetchEvents(0), 2u);
+}
+
+TEST_F(TestMappedEventLogStorage, TestEventCounterBehind)
+{
+    StartLogging(0);
+    LogEvents(5, 0);
+    StopLogging();
+
+    // New events would get the numbers of the persisted ones: these are dropped.
+    StartLogging(2);
+    EXPECT_EQ(FetchEvents(0), 0u);
+    LogEvents(1, 2);
+    EXPECT_EQ(FetchEvents(2), 1u);
+}
+
+TEST_F(TestMappedEventLogStorage, TestLayoutChange)
+{
+    StartLogging(0);
+    LogEvents(5, 0);
+    StopLogging();
+
+    // A file created for other buffers starts over empty.
+    StartLogging(5, 2 * kBufferSize);
+    EXPECT_EQ(FetchEvents(0), 0u);
+    LogEvents(1, 5);
+    EXPECT_EQ(FetchEvents(5), 1u);
+}
+
+} // namespace
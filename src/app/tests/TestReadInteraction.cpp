@@ -282,6 +282,7 @@ public:
     }
 
     void TestReadClient();
+    void TestReadChunkedListCarriesItem();
     void TestReadUnexpectedSubscriptionId();
     void TestReadHandler();
     void TestReadClientGenerateAttributePathList();
@@ -298,6 +299,7 @@ public:
     void TestICDProcessSubscribeRequestMaxMinInterval();
     void TestICDProcessSubscribeRequestInvalidIdleModeDuration();
     void TestSubscribeRoundtrip();
+    void TestSubscribeIdenticalSubscriptionsShareReport();
     void TestSubscribeEarlyReport();
     void TestSubscribeUrgentWildcardEvent();
     void TestSubscribeInvalidAttributePathRoundtrip();
@@ -1101,6 +1103,82 @@ TEST_F(TestReadInteraction, TestReadWildcard)
     EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
 }
 
+// The list item that does not fit in the first chunk is carried to the next one (with CHIP_IM_SERVER_LIST_ITEM_CARRY), and
+// every item arrives intact either way.
+TEST_F_FROM_FIXTURE(TestReadInteraction, TestReadChunkedListCarriesItem)
+{
+    Messaging::ReliableMessageMgr * rm = GetExchangeManager().GetReliableMessageMgr();
+    EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    EXPECT_EQ(engine->Init(&GetExchangeManager(), &GetFabricTable(), gReportScheduler), CHIP_NO_ERROR);
+
+    struct ListContentsCallback : public MockInteractionModelApp
+    {
+        void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & status) override
+        {
+            if (apData != nullptr && aPath.IsListItemOperation())
+            {
+                TLV::TLVReader reader(*apData);
+                CheckItem(reader);
+            }
+            else if (apData != nullptr && aPath.IsListOperation())
+            {
+                TLV::TLVReader reader(*apData);
+                TLV::TLVType containerType;
+                EXPECT_EQ(reader.EnterContainer(containerType), CHIP_NO_ERROR);
+                while (reader.Next() == CHIP_NO_ERROR)
+                {
+                    CheckItem(reader);
+                }
+            }
+#if CHIP_IM_SERVER_LIST_ITEM_CARRY
+            // The next chunk is not built yet, so an item left over from this one is held.
+            mSawHeldItem |= (InteractionModelEngine::GetInstance()->GetReportingEngine().mListItemCarry.mpHolder != nullptr);
+#endif // CHIP_IM_SERVER_LIST_ITEM_CARRY
+            MockInteractionModelApp::OnAttributeData(aPath, apData, status);
+        }
+
+        void CheckItem(TLV::TLVReader & reader)
+        {
+            ByteSpan item;
+            EXPECT_EQ(reader.Get(item), CHIP_NO_ERROR);
+            mIntactItems += item.data_equal(ByteSpan(chip::Test::mockAttribute4)) ? 1 : 0;
+        }
+
+        int mIntactItems  = 0;
+        bool mSawHeldItem = false;
+    } delegate;
+
+    chip::app::AttributePathParams attributePathParams(chip::Test::kMockEndpoint3, chip::Test::MockClusterId(2),
+                                                       chip::Test::MockAttributeId(4));
+    ReadPrepareParams readPrepareParams(GetSessionBobToAlice());
+    readPrepareParams.mpAttributePathParamsList    = &attributePathParams;
+    readPrepareParams.mAttributePathParamsListSize = 1;
+
+    {
+        app::ReadClient readClient(engine, &GetExchangeManager(), delegate, chip::app::ReadClient::InteractionType::Read);
+
+        EXPECT_EQ(readClient.SendRequest(readPrepareParams), CHIP_NO_ERROR);
+        DrainAndServiceIO();
+
+        EXPECT_FALSE(delegate.mReadError);
+        EXPECT_EQ(delegate.mNumArrayItems, kMockAttribute4ListLength);
+        EXPECT_EQ(delegate.mIntactItems, kMockAttribute4ListLength);
+#if CHIP_IM_SERVER_LIST_ITEM_CARRY
+        EXPECT_TRUE(delegate.mSawHeldItem);
+        // Nothing is held once the read is done.
+        EXPECT_EQ(engine->GetReportingEngine().mListItemCarry.mpHolder, nullptr);
+        EXPECT_FALSE(engine->GetReportingEngine().mListItemCarry.mCarry.IsHolding());
+#endif // CHIP_IM_SERVER_LIST_ITEM_CARRY
+    }
+
+    EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+    EXPECT_EQ(engine->GetNumActiveReadClients(), 0u);
+    engine->Shutdown();
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
 // TestReadChunking will try to read a few large attributes, the report won't fit into the MTU and result in chunking.
 TEST_F(TestReadInteraction, TestReadChunking)
 {
@@ -1924,6 +2002,68 @@ TEST_F_FROM_FIXTURE(TestReadInteraction, TestSubscribeRoundtrip)
     EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
 }
 
+TEST_F_FROM_FIXTURE(TestReadInteraction, TestSubscribeIdenticalSubscriptionsShareReport)
+{
+    Messaging::ReliableMessageMgr * rm = GetExchangeManager().GetReliableMessageMgr();
+    EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+
+    MockInteractionModelApp delegate1;
+    MockInteractionModelApp delegate2;
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    EXPECT_EQ(engine->Init(&GetExchangeManager(), &GetFabricTable(), gReportScheduler), CHIP_NO_ERROR);
+
+    chip::app::AttributePathParams attributePathParams[2];
+    attributePathParams[0].mEndpointId  = kTestEndpointId;
+    attributePathParams[0].mClusterId   = kTestClusterId;
+    attributePathParams[0].mAttributeId = 1;
+    attributePathParams[1].mEndpointId  = kTestEndpointId;
+    attributePathParams[1].mClusterId   = kTestClusterId;
+    attributePathParams[1].mAttributeId = 2;
+
+    ReadPrepareParams readPrepareParams(GetSessionBobToAlice());
+    readPrepareParams.mpAttributePathParamsList    = attributePathParams;
+    readPrepareParams.mAttributePathParamsListSize = 2;
+    readPrepareParams.mMinIntervalFloorSeconds     = 1;
+    readPrepareParams.mMaxIntervalCeilingSeconds   = 10;
+    readPrepareParams.mKeepSubscriptions           = true;
+
+    {
+        app::ReadClient readClient1(engine, &GetExchangeManager(), delegate1, chip::app::ReadClient::InteractionType::Subscribe);
+        app::ReadClient readClient2(engine, &GetExchangeManager(), delegate2, chip::app::ReadClient::InteractionType::Subscribe);
+
+        EXPECT_EQ(readClient1.SendRequest(readPrepareParams), CHIP_NO_ERROR);
+        DrainAndServiceIO();
+        EXPECT_EQ(readClient2.SendRequest(readPrepareParams), CHIP_NO_ERROR);
+        DrainAndServiceIO();
+
+        EXPECT_EQ(engine->GetNumActiveReadHandlers(ReadHandler::InteractionType::Subscribe), 2u);
+        EXPECT_EQ(delegate1.mNumAttributeResponse, 2);
+        EXPECT_EQ(delegate2.mNumAttributeResponse, 2);
+
+        // Both subscriptions become reportable in the same run, for the same change.
+        gMockClock.AdvanceMonotonic(System::Clock::Seconds16(readPrepareParams.mMinIntervalFloorSeconds));
+        GetIOContext().DriveIO();
+
+        delegate1.mNumAttributeResponse                       = 0;
+        delegate2.mNumAttributeResponse                       = 0;
+        TestImCustomDataModel::Instance().mReadAttributeCount = 0;
+
+        chip::app::AttributePathParams dirtyPath(kTestEndpointId, kTestClusterId, 1);
+        EXPECT_EQ(engine->GetReportingEngine().SetDirty(dirtyPath), CHIP_NO_ERROR);
+        DrainAndServiceIO();
+
+        EXPECT_EQ(delegate1.mNumAttributeResponse, 1);
+        EXPECT_EQ(delegate2.mNumAttributeResponse, 1);
+        // With shared reports, the attribute is read once for both subscriptions.
+        EXPECT_EQ(TestImCustomDataModel::Instance().mReadAttributeCount, CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS ? 1u : 2u);
+    }
+
+    EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+    EXPECT_EQ(engine->GetNumActiveReadClients(), 0u);
+    engine->Shutdown();
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+}
+
 TEST_F_FROM_FIXTURE(TestReadInteraction, TestSubscribeEarlyReport)
 {
 
@@ -23,6 +23,8 @@
  */
 
 #include <cinttypes>
+#include <initializer_list>
+#include <vector>
 
 #include <pw_unit_test/framework.h>
 
@@ -71,10 +73,16 @@ public:
     template <typename... Args>
     static bool VerifyDirtySetContent(const Args &... args);
     static bool InsertToDirtySet(const AttributePathParams & aPath);
+    static System::PacketBufferHandle BuildReadRequest(std::initializer_list<AttributePathParams> aPaths);
+    static bool IsMarkedDirty(const ReadHandler & aHandler);
 
     void TestBuildAndSendSingleReportData();
     void TestMergeOverlappedAttributePath();
     void TestMergeAttributePathWhenDirtySetPoolExhausted();
+    void TestSetDirtyMarksInterestedHandlers();
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+    void TestFairSchedulingServesSmallReportFirst();
+#endif // CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
 
 private:
     chip::app::DataModel::Provider * mOldProvider = nullptr;
@@ -108,6 +116,14 @@ public:
     }
 };
 
+class RecordingDelegate : public DummyDelegate
+{
+public:
+    void OnDone(ReadHandler & apHandler) override { mDone.push_back(&apHandler); }
+
+    std::vector<ReadHandler *> mDone;
+};
+
 template <typename... Args>
 bool TestReportingEngine::VerifyDirtySetContent(const Args &... args)
 {
@@ -153,6 +169,31 @@ bool TestReportingEngine::InsertToDirtySet(const AttributePathParams & aPath)
     return true;
 }
 
+System::PacketBufferHandle TestReportingEngine::BuildReadRequest(std::initializer_list<AttributePathParams> aPaths)
+{
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle buf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    ReadRequestMessage::Builder readRequestBuilder;
+
+    writer.Init(std::move(buf));
+    EXPECT_EQ(readRequestBuilder.Init(&writer), CHIP_NO_ERROR);
+    AttributePathIBs::Builder & attributePathListBuilder = readRequestBuilder.CreateAttributeRequests();
+    for (const auto & path : aPaths)
+    {
+        EXPECT_EQ(attributePathListBuilder.CreatePath().Encode(path), CHIP_NO_ERROR);
+    }
+    attributePathListBuilder.EndOfAttributePathIBs();
+    readRequestBuilder.IsFabricFiltered(false).EndOfReadRequestMessage();
+    EXPECT_EQ(readRequestBuilder.GetError(), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Finalize(&buf), CHIP_NO_ERROR);
+    return buf;
+}
+
+bool TestReportingEngine::IsMarkedDirty(const ReadHandler & aHandler)
+{
+    return aHandler.mDirtyGeneration == InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGeneration();
+}
+
 TEST_F_FROM_FIXTURE(TestReportingEngine, TestBuildAndSendSingleReportData)
 {
     System::PacketBufferTLVWriter writer;
@@ -328,6 +369,138 @@ TEST_F_FROM_FIXTURE(TestReportingEngine, TestMergeAttributePathWhenDirtySetPoolE
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestSetDirtyMarksInterestedHandlers)
+{
+    // SetDirty finds the handlers through the attribute interest index when CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX is
+    // enabled, and by scanning every handler otherwise: both must mark the same handlers dirty.
+    constexpr ClusterId kOtherClusterId = kTestClusterId + 1;
+
+    Engine & reportingEngine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->Init(&GetExchangeManager(), &GetFabricTable(),
+                                                          app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+
+    // SetDirty only looks at the handlers of the engine.
+    auto newReadHandler = [&](std::initializer_list<AttributePathParams> paths) {
+        ReadHandler * handler = InteractionModelEngine::GetInstance()->GetReadHandlerPool().CreateObject(
+            dummy, NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read, app::reporting::GetDefaultReportScheduler(),
+            CodegenDataModelProviderInstance());
+        VerifyOrDie(handler != nullptr);
+        handler->OnInitialRequest(BuildReadRequest(paths));
+        EXPECT_TRUE(handler->CanStartReporting());
+        return handler;
+    };
+
+    ReadHandler * concreteHandler       = newReadHandler({ AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1) });
+    ReadHandler * otherAttributeHandler = newReadHandler({ AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId2) });
+    ReadHandler * wildcardAttributeHandler = newReadHandler({ AttributePathParams(kTestEndpointId, kTestClusterId) });
+    ReadHandler * wildcardEndpointHandler =
+        newReadHandler({ AttributePathParams(kInvalidEndpointId, kOtherClusterId, kTestFieldId1),
+                         AttributePathParams(kTestEndpointId, kOtherClusterId, kTestFieldId2) });
+
+    reportingEngine.mGlobalDirtySet.ReleaseAll();
+
+    EXPECT_EQ(reportingEngine.SetDirty(AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1)), CHIP_NO_ERROR);
+    EXPECT_TRUE(IsMarkedDirty(*concreteHandler));
+    EXPECT_FALSE(IsMarkedDirty(*otherAttributeHandler));
+    EXPECT_TRUE(IsMarkedDirty(*wildcardAttributeHandler));
+    EXPECT_FALSE(IsMarkedDirty(*wildcardEndpointHandler));
+    EXPECT_TRUE(VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1)));
+
+    // Only the wildcard endpoint path covers this endpoint.
+    EXPECT_EQ(reportingEngine.SetDirty(AttributePathParams(kTestEndpointId + 1, kOtherClusterId, kTestFieldId1)), CHIP_NO_ERROR);
+    EXPECT_FALSE(IsMarkedDirty(*concreteHandler));
+    EXPECT_FALSE(IsMarkedDirty(*otherAttributeHandler));
+    EXPECT_FALSE(IsMarkedDirty(*wildcardAttributeHandler));
+    EXPECT_TRUE(IsMarkedDirty(*wildcardEndpointHandler));
+
+    EXPECT_EQ(reportingEngine.SetDirty(AttributePathParams(kTestEndpointId, kOtherClusterId, kTestFieldId2)), CHIP_NO_ERROR);
+    EXPECT_TRUE(IsMarkedDirty(*wildcardEndpointHandler));
+    EXPECT_FALSE(IsMarkedDirty(*concreteHandler));
+
+    // A path that nobody reads does not go into the dirty set.
+    reportingEngine.mGlobalDirtySet.ReleaseAll();
+    EXPECT_EQ(reportingEngine.SetDirty(AttributePathParams(kTestEndpointId, kOtherClusterId, kTestFieldId1 + 10)), CHIP_NO_ERROR);
+    EXPECT_EQ(reportingEngine.mGlobalDirtySet.Allocated(), 0u);
+    EXPECT_FALSE(IsMarkedDirty(*concreteHandler));
+    EXPECT_FALSE(IsMarkedDirty(*otherAttributeHandler));
+    EXPECT_FALSE(IsMarkedDirty(*wildcardAttributeHandler));
+    EXPECT_FALSE(IsMarkedDirty(*wildcardEndpointHandler));
+
+    // A wildcard change reaches every handler that reads from the cluster.
+    EXPECT_EQ(reportingEngine.SetDirty(AttributePathParams(kTestEndpointId, kTestClusterId)), CHIP_NO_ERROR);
+    EXPECT_TRUE(IsMarkedDirty(*concreteHandler));
+    EXPECT_TRUE(IsMarkedDirty(*otherAttributeHandler));
+    EXPECT_TRUE(IsMarkedDirty(*wildcardAttributeHandler));
+    EXPECT_FALSE(IsMarkedDirty(*wildcardEndpointHandler));
+
+    // A released handler is not interested anymore.
+    InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(concreteHandler);
+    InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(wildcardAttributeHandler);
+    reportingEngine.mGlobalDirtySet.ReleaseAll();
+    EXPECT_EQ(reportingEngine.SetDirty(AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1)), CHIP_NO_ERROR);
+    EXPECT_EQ(reportingEngine.mGlobalDirtySet.Allocated(), 0u);
+    EXPECT_FALSE(IsMarkedDirty(*otherAttributeHandler));
+
+    InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(otherAttributeHandler);
+    InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(wildcardEndpointHandler);
+    DrainAndServiceIO();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
+}
+
+
+#if CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+TEST_F_FROM_FIXTURE(TestReportingEngine, TestFairSchedulingServesSmallReportFirst)
+{
+    Engine & reportingEngine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    RecordingDelegate recorder;
+    TestExchangeDelegate delegate;
+
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->Init(&GetExchangeManager(), &GetFabricTable(),
+                                                          app::reporting::GetDefaultReportScheduler()),
+              CHIP_NO_ERROR);
+
+    auto newReadHandler = [&](std::initializer_list<AttributePathParams> paths) {
+        ReadHandler * handler = InteractionModelEngine::GetInstance()->GetReadHandlerPool().CreateObject(
+            recorder, NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read,
+            app::reporting::GetDefaultReportScheduler(), CodegenDataModelProviderInstance());
+        VerifyOrDie(handler != nullptr);
+        handler->OnInitialRequest(BuildReadRequest(paths));
+        EXPECT_TRUE(handler->CanStartReporting());
+        return handler;
+    };
+
+    // The wildcard handler comes first, so the round-robin would serve it first.
+    ReadHandler * wildcardHandler = newReadHandler({ AttributePathParams(kTestEndpointId, kTestClusterId) });
+    ReadHandler * smallHandler    = newReadHandler({ AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1) });
+
+    // Both are reportable from the time they were set up.
+    EXPECT_NE(wildcardHandler->mReportableSince, System::Clock::kZero);
+    EXPECT_NE(smallHandler->mReportableSince, System::Clock::kZero);
+
+    // The wildcard handler was charged for the large reports it was already served.
+    wildcardHandler->mReportFinishTag = reportingEngine.mReportVirtualTime + System::PacketBuffer::kMaxSize;
+
+    reportingEngine.Run();
+
+    ASSERT_EQ(recorder.mDone.size(), 2u);
+    EXPECT_EQ(recorder.mDone[0], smallHandler);
+    EXPECT_EQ(recorder.mDone[1], wildcardHandler);
+
+    // Neither is reportable once its read is done.
+    EXPECT_EQ(wildcardHandler->mReportableSince, System::Clock::kZero);
+    EXPECT_EQ(smallHandler->mReportableSince, System::Clock::kZero);
+
+    InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(wildcardHandler);
+    InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(smallHandler);
+    DrainAndServiceIO();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
+}
+#endif // CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
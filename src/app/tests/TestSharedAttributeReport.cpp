@@ -0,0 +1,157 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <string.h>
+
+#include <app/MessageDef/ReportDataMessage.h>
+#include <app/reporting/SharedAttributeReport.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <pw_unit_test/framework.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+constexpr size_t kBufferSize = 512;
+
+class TestSharedAttributeReport : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+};
+
+CHIP_ERROR EncodeAttributeReportIBs(ReportDataMessage::Builder & aReportDataBuilder, uint32_t aAttributeCount)
+{
+    AttributeReportIBs::Builder & attributeReportIBs = aReportDataBuilder.CreateAttributeReportIBs();
+    ReturnErrorOnFailure(aReportDataBuilder.GetError());
+
+    for (uint32_t i = 0; i < aAttributeCount; i++)
+    {
+        AttributeReportIB::Builder & attributeReportIB = attributeReportIBs.CreateAttributeReport();
+        ReturnErrorOnFailure(attributeReportIBs.GetError());
+        AttributeDataIB::Builder & attributeDataIB = attributeReportIB.CreateAttributeData();
+        ReturnErrorOnFailure(attributeReportIB.GetError());
+        attributeDataIB.DataVersion(i);
+        ReturnErrorOnFailure(attributeDataIB.CreatePath().Endpoint(1).Cluster(6).Attribute(i).EndOfAttributePathIB());
+        ReturnErrorOnFailure(attributeDataIB.GetWriter()->Put(TLV::ContextTag(AttributeDataIB::Tag::kData), i));
+        ReturnErrorOnFailure(attributeDataIB.EndOfAttributeDataIB());
+        ReturnErrorOnFailure(attributeReportIB.EndOfAttributeReportIB());
+    }
+
+    return attributeReportIBs.EndOfAttributeReportIBs();
+}
+
+// Encodes a report message with the given attribute data into aBuffer, returning its length.
+template <typename EncodeFunction>
+uint32_t EncodeReport(uint8_t * aBuffer, size_t aBufferSize, EncodeFunction && aEncodeAttributeReportIBs)
+{
+    TLV::TLVWriter writer;
+    ReportDataMessage::Builder reportDataBuilder;
+    writer.Init(aBuffer, aBufferSize);
+    EXPECT_EQ(reportDataBuilder.Init(&writer), CHIP_NO_ERROR);
+    EXPECT_EQ(aEncodeAttributeReportIBs(reportDataBuilder), CHIP_NO_ERROR);
+    reportDataBuilder.EndOfReportDataMessage();
+    EXPECT_EQ(reportDataBuilder.GetError(), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.Finalize(), CHIP_NO_ERROR);
+    return writer.GetLengthWritten();
+}
+
+TEST_F(TestSharedAttributeReport, TestCopyMatchesEncoding)
+{
+    reporting::SharedAttributeReport sharedReport;
+    EXPECT_TRUE(sharedReport.IsNull());
+    EXPECT_EQ(sharedReport.Encode(kBufferSize, [](ReportDataMessage::Builder & builder) {
+        return EncodeAttributeReportIBs(builder, 10);
+    }),
+              CHIP_NO_ERROR);
+    EXPECT_FALSE(sharedReport.IsNull());
+    EXPECT_TRUE(sharedReport.HasAttributeReportIBs());
+
+    uint8_t encoded[kBufferSize];
+    const uint32_t encodedLength = EncodeReport(encoded, sizeof(encoded), [](ReportDataMessage::Builder & builder) {
+        return EncodeAttributeReportIBs(builder, 10);
+    });
+
+    // Copying the shared data into several reports gives each of them what encoding it would have.
+    for (int i = 0; i < 3; i++)
+    {
+        uint8_t copied[kBufferSize];
+        const uint32_t copiedLength = EncodeReport(copied, sizeof(copied), [&sharedReport](ReportDataMessage::Builder & builder) {
+            return sharedReport.CopyTo(*builder.GetWriter());
+        });
+        ASSERT_EQ(copiedLength, encodedLength);
+        EXPECT_EQ(memcmp(copied, encoded, encodedLength), 0);
+    }
+
+    sharedReport.Release();
+    EXPECT_TRUE(sharedReport.IsNull());
+}
+
+TEST_F(TestSharedAttributeReport, TestNoAttributeData)
+{
+    reporting::SharedAttributeReport sharedReport;
+    EXPECT_EQ(sharedReport.Encode(kBufferSize, [](ReportDataMessage::Builder &) { return CHIP_NO_ERROR; }), CHIP_NO_ERROR);
+    EXPECT_FALSE(sharedReport.IsNull());
+    EXPECT_FALSE(sharedReport.HasAttributeReportIBs());
+
+    uint8_t encoded[kBufferSize];
+    const uint32_t encodedLength =
+        EncodeReport(encoded, sizeof(encoded), [](ReportDataMessage::Builder &) { return CHIP_NO_ERROR; });
+
+    uint8_t copied[kBufferSize];
+    const uint32_t copiedLength = EncodeReport(copied, sizeof(copied), [&sharedReport](ReportDataMessage::Builder & builder) {
+        return sharedReport.CopyTo(*builder.GetWriter());
+    });
+    ASSERT_EQ(copiedLength, encodedLength);
+    EXPECT_EQ(memcmp(copied, encoded, encodedLength), 0);
+}
+
+TEST_F(TestSharedAttributeReport, TestCopyErrors)
+{
+    reporting::SharedAttributeReport sharedReport;
+
+    TLV::TLVWriter writer;
+    uint8_t buffer[kBufferSize];
+    writer.Init(buffer, sizeof(buffer));
+    EXPECT_EQ(sharedReport.CopyTo(writer), CHIP_ERROR_INCORRECT_STATE);
+
+    // The encoding gets no more than the given room.
+    EXPECT_EQ(sharedReport.Encode(32, [](ReportDataMessage::Builder & builder) { return EncodeAttributeReportIBs(builder, 10); }),
+              CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    EXPECT_EQ(sharedReport.Encode(kBufferSize, [](ReportDataMessage::Builder & builder) {
+        return EncodeAttributeReportIBs(builder, 10);
+    }),
+              CHIP_NO_ERROR);
+
+    // A writer without room for the data is left as it was.
+    TLV::TLVType outerType;
+    writer.Init(buffer, 64);
+    ASSERT_EQ(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, outerType), CHIP_NO_ERROR);
+    const uint32_t lengthWritten = writer.GetLengthWritten();
+    EXPECT_NE(sharedReport.CopyTo(writer), CHIP_NO_ERROR);
+    EXPECT_EQ(writer.GetLengthWritten(), lengthWritten);
+    EXPECT_EQ(writer.EndContainer(outerType), CHIP_NO_ERROR);
+}
+
+} // namespace
@@ -18,12 +18,15 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <app-common/zap-generated/cluster-objects.h>
+#include <app/DefaultAttributePersistenceProvider.h>
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/tests/MockReportScheduler.h>
 #include <app/tests/AppTestContext.h>
 #include <app/tests/test-interaction-model-api.h>
+#include <app/util/MatterCallbacks.h>
 #include <credentials/GroupDataProviderImpl.h>
 #include <crypto/DefaultSessionKeystore.h>
 #include <lib/core/CHIPCore.h>
@@ -33,6 +36,7 @@
 #include <lib/core/TLVDebug.h>
 #include <lib/core/TLVUtilities.h>
 #include <lib/support/TestGroupData.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
 #include <lib/support/tests/ExtraPwTestMacros.h>
 #include <messaging/ExchangeContext.h>
@@ -49,6 +53,10 @@ chip::TestPersistentStorageDelegate gTestStorage;
 chip::Crypto::DefaultSessionKeystore gSessionKeystore;
 chip::Credentials::GroupDataProviderImpl gGroupsProvider(kMaxGroupsPerFabric, kMaxGroupKeysPerFabric);
 
+// Outlives the tests that install it, since the global attribute persistence provider cannot be unset.
+chip::TestPersistentStorageDelegate gAttributeStorage;
+chip::app::DefaultAttributePersistenceProvider gAttributePersistenceProvider;
+
 } // namespace
 
 namespace chip {
@@ -621,6 +629,115 @@ TEST_F(TestWriteInteraction, TestWriteHandlerInvalidateFabric)
     CreateSessionBobToAlice();
 }
 
+// The values written by each message of a chunked write are stored, and their paths marked dirty, once the message is
+// processed: with CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE and CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE, once per message, and
+// otherwise as each value is written. Nothing is held back from one message to the next.
+TEST_F(TestWriteInteraction, TestWriteHandlerStoresEachChunk)
+{
+    const ConcreteAttributePath attributePath(2, 3, 4);
+    const StorageKeyName storageKey =
+        DefaultStorageKeyAllocator::AttributeValue(attributePath.mEndpointId, attributePath.mClusterId, attributePath.mAttributeId);
+
+    gAttributeStorage.ClearStorage();
+    ASSERT_EQ(gAttributePersistenceProvider.Init(&gAttributeStorage), CHIP_NO_ERROR);
+    AttributePersistenceProvider * previousPersistenceProvider = GetAttributePersistenceProvider();
+    SetAttributePersistenceProvider(&gAttributePersistenceProvider);
+
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    EXPECT_EQ(engine->Init(&GetExchangeManager(), &GetFabricTable(), app::reporting::GetDefaultReportScheduler()), CHIP_NO_ERROR);
+
+    // Numbers each value written (each list item), stores it, and marks its path dirty, like the attribute storage does.
+    struct PersistingCallbacks : public DataModelCallbacks
+    {
+        struct Write
+        {
+            uint32_t mMessage; // Messages sent so far, which tells the chunks apart.
+            int mStoredValue;  // The value in storage before this write, or -1 if none.
+            uint64_t mDirtyGeneration;
+        };
+
+        void AttributeOperation(OperationType operation, OperationOrder order, const ConcreteAttributePath & path) override
+        {
+            VerifyOrReturn(operation == OperationType::Write && order == OperationOrder::Post);
+            mWrites.push_back({ *mpSentMessageCount, StoredValue(), mpEngine->GetDirtySetGeneration() });
+
+            const uint8_t value = static_cast<uint8_t>(mWrites.size() - 1);
+            EXPECT_EQ(GetAttributePersistenceProvider()->WriteValue(path, ByteSpan(&value, sizeof(value))), CHIP_NO_ERROR);
+            EXPECT_EQ(mpEngine->SetDirty(AttributePathParams(path.mEndpointId, path.mClusterId, path.mAttributeId)),
+                      CHIP_NO_ERROR);
+        }
+
+        int StoredValue()
+        {
+            uint8_t value;
+            uint16_t size = sizeof(value);
+            return (mpStorage->SyncGetKeyValue(mpStorageKey->KeyName(), &value, size) == CHIP_NO_ERROR) ? value : -1;
+        }
+
+        const uint32_t * mpSentMessageCount;
+        PersistentStorageDelegate * mpStorage;
+        const StorageKeyName * mpStorageKey;
+        reporting::Engine * mpEngine;
+        std::vector<Write> mWrites;
+    } callbacks;
+    callbacks.mpSentMessageCount = &GetLoopback().mSentMessageCount;
+    callbacks.mpStorage          = &gAttributeStorage;
+    callbacks.mpStorageKey       = &storageKey;
+    callbacks.mpEngine           = &engine->GetReportingEngine();
+
+    DataModelCallbacks * previousCallbacks = DataModelCallbacks::SetInstance(&callbacks);
+
+    // Reserve all except the last 128 bytes, so that we make sure to chunk.
+    TestWriteClientCallback writeCallback;
+    app::WriteClient writeClient(&GetExchangeManager(), &writeCallback, Optional<uint16_t>::Missing(),
+                                 static_cast<uint16_t>(kMaxSecureSduLengthBytes - 128) /* reserved buffer size */);
+    ByteSpan list[5];
+    EXPECT_EQ(writeClient.EncodeAttribute(AttributePathParams(attributePath.mEndpointId, attributePath.mClusterId,
+                                                              attributePath.mAttributeId),
+                                          app::DataModel::List<ByteSpan>(list, 5)),
+              CHIP_NO_ERROR);
+    GetLoopback().mSentMessageCount = 0;
+    EXPECT_EQ(writeClient.SendWriteRequest(GetSessionBobToAlice()), CHIP_NO_ERROR);
+    DrainAndServiceIO();
+
+    EXPECT_EQ(writeCallback.mOnErrorCalled, 0);
+    EXPECT_EQ(writeCallback.mOnDoneCalled, 1);
+    EXPECT_EQ(InteractionModelEngine::GetInstance()->GetNumActiveWriteHandlers(), 0u);
+
+    const auto & writes = callbacks.mWrites;
+    ASSERT_GT(writes.size(), 1u);
+    EXPECT_EQ(writes[0].mStoredValue, -1);
+    size_t messageCount = 1;
+    for (size_t i = 1; i < writes.size(); i++)
+    {
+        if (writes[i].mMessage != writes[i - 1].mMessage)
+        {
+            // The values and the path written by the previous chunk are stored and marked dirty before the next one.
+            messageCount++;
+            EXPECT_EQ(writes[i].mStoredValue, static_cast<int>(i - 1));
+            EXPECT_EQ(writes[i].mDirtyGeneration, writes[i - 1].mDirtyGeneration + 1);
+            continue;
+        }
+#if CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+        EXPECT_EQ(writes[i].mStoredValue, writes[i - 1].mStoredValue);
+#else
+        EXPECT_EQ(writes[i].mStoredValue, static_cast<int>(i - 1));
+#endif // CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE > 0
+#if CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE > 0
+        EXPECT_EQ(writes[i].mDirtyGeneration, writes[i - 1].mDirtyGeneration);
+#else
+        EXPECT_EQ(writes[i].mDirtyGeneration, writes[i - 1].mDirtyGeneration + 1);
+#endif // CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE > 0
+    }
+    EXPECT_GT(messageCount, 1u);
+    EXPECT_EQ(callbacks.StoredValue(), static_cast<int>(writes.size() - 1));
+    EXPECT_EQ(engine->GetReportingEngine().GetDirtySetGeneration(), writes.back().mDirtyGeneration + 1);
+
+    DataModelCallbacks::SetInstance(previousCallbacks);
+    SetAttributePersistenceProvider(previousPersistenceProvider);
+    gAttributePersistenceProvider.Shutdown();
+    engine->Shutdown();
+}
 #endif
 
 // Write Client sends a write request, receives an unexpected message type, sends a status response to that.
@@ -0,0 +1,236 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the attribute interest index used by
+ *      reporting::Engine::SetDirty.
+ *
+ *      It models a bridge with 100 bridged endpoints of 10 clusters of 10
+ *      attributes. Each subscription (500 by default) asks for 4 clusters of
+ *      random endpoints with a wildcard attribute, 1 whole endpoint, and 2
+ *      concrete attributes; 1 subscription in 50 is a full wildcard. Random
+ *      attributes then change (10000 by default, i.e. one second of changes at
+ *      10k changes per second), and the interested subscriptions are found by
+ *      the handler scan SetDirty does without the index, then by the index.
+ *
+ *      Usage: attribute-interest-index-benchmark [subscription-count] [change-count]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <app/AttributePathParams.h>
+#include <app/reporting/AttributeInterestIndex.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/LinkedList.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::Test;
+
+namespace {
+
+constexpr EndpointId kEndpointCount   = 100;
+constexpr ClusterId kClusterCount     = 10;
+constexpr AttributeId kAttributeCount = 10;
+constexpr size_t kMaxPathCount        = 1 << 16;
+
+struct Subscription
+{
+    std::vector<SingleLinkedListNode<AttributePathParams>> paths;
+    uint64_t dirtyGeneration = 0;
+};
+
+uint64_t NextRandom(uint64_t & state)
+{
+    // xorshift64: deterministic and cheap compared to the operations being measured.
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+EndpointId RandomEndpoint(uint64_t & random)
+{
+    return static_cast<EndpointId>(1 + NextRandom(random) % kEndpointCount);
+}
+
+ClusterId RandomCluster(uint64_t & random)
+{
+    return static_cast<ClusterId>(NextRandom(random) % kClusterCount);
+}
+
+AttributeId RandomAttribute(uint64_t & random)
+{
+    return static_cast<AttributeId>(NextRandom(random) % kAttributeCount);
+}
+
+std::vector<Subscription> MakeSubscriptions(uint32_t subscriptionCount)
+{
+    std::vector<Subscription> subscriptions(subscriptionCount);
+    uint64_t random = 0x9E3779B97F4A7C15ull;
+
+    for (uint32_t i = 0; i < subscriptionCount; i++)
+    {
+        auto & paths = subscriptions[i].paths;
+        if (i % 50 == 0)
+        {
+            paths.push_back({ AttributePathParams() });
+        }
+        else
+        {
+            for (int cluster = 0; cluster < 4; cluster++)
+            {
+                paths.push_back({ AttributePathParams(RandomEndpoint(random), RandomCluster(random)) });
+            }
+            paths.push_back({ AttributePathParams(RandomEndpoint(random)) });
+            for (int attribute = 0; attribute < 2; attribute++)
+            {
+                paths.push_back(
+                    { AttributePathParams(RandomEndpoint(random), RandomCluster(random), RandomAttribute(random)) });
+            }
+        }
+
+        for (size_t path = 0; path + 1 < paths.size(); path++)
+        {
+            paths[path].mpNext = &paths[path + 1];
+        }
+    }
+
+    return subscriptions;
+}
+
+std::vector<AttributePathParams> MakeChanges(uint32_t changeCount)
+{
+    std::vector<AttributePathParams> changes;
+    uint64_t random = 0xD1B54A32D192ED03ull;
+
+    for (uint32_t i = 0; i < changeCount; i++)
+    {
+        changes.emplace_back(RandomEndpoint(random), RandomCluster(random), RandomAttribute(random));
+    }
+    return changes;
+}
+
+void Report(const char * name, double nanoseconds, uint32_t changeCount, uint64_t marked)
+{
+    const double perChange = nanoseconds / changeCount;
+    printf("  %-20s %9.1f ns/change, %5.1f%% of a core at 10k changes/s (%" PRIu64 " subscriptions marked dirty)\n", name,
+           perChange, perChange * 10000 / 1e9 * 100, marked);
+}
+
+// The loop SetDirty runs without the index: every path of every handler is checked.
+uint64_t RunScan(std::vector<Subscription> & subscriptions, const std::vector<AttributePathParams> & changes)
+{
+    uint64_t marked = 0;
+    for (auto & change : changes)
+    {
+        for (auto & subscription : subscriptions)
+        {
+            for (auto path = &subscription.paths.front(); path != nullptr; path = path->mpNext)
+            {
+                if (path->mValue.Intersects(change))
+                {
+                    marked++;
+                    break;
+                }
+            }
+        }
+    }
+    return marked;
+}
+
+template <size_t kBucketCount>
+uint64_t RunIndex(std::vector<Subscription> & subscriptions, const std::vector<AttributePathParams> & changes, double & nanoseconds)
+{
+    using Index = reporting::AttributeInterestIndex<Subscription, kMaxPathCount, kBucketCount>;
+    auto index  = std::make_unique<Index>();
+
+    for (auto & subscription : subscriptions)
+    {
+        subscription.dirtyGeneration = 0;
+        VerifyOrDie(index->Add(subscription, &subscription.paths.front()) == CHIP_NO_ERROR);
+    }
+
+    uint64_t marked     = 0;
+    uint64_t generation = 0;
+
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (auto & change : changes)
+    {
+        // As in SetDirty, the dirty generation filters subscriptions found through several paths.
+        generation++;
+        index->ForEachInterestedReader(change, [&](Subscription & subscription) {
+            if (subscription.dirtyGeneration != generation)
+            {
+                subscription.dirtyGeneration = generation;
+                marked++;
+            }
+            return Loop::Continue;
+        });
+    }
+    nanoseconds = ElapsedNanoseconds(start);
+
+    for (auto & subscription : subscriptions)
+    {
+        index->Remove(subscription, &subscription.paths.front());
+    }
+    VerifyOrDie(index->GetEntryCount() == 0);
+
+    return marked;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t subscriptionCount = std::max(1u, ParseArg(argc, argv, 1, 500));
+    const uint32_t changeCount       = std::max(1u, ParseArg(argc, argv, 2, 10000));
+
+    ScopedPlatformMemory platformMemory;
+
+    std::vector<Subscription> subscriptions  = MakeSubscriptions(subscriptionCount);
+    std::vector<AttributePathParams> changes = MakeChanges(changeCount);
+
+    size_t pathCount = 0;
+    for (auto & subscription : subscriptions)
+    {
+        pathCount += subscription.paths.size();
+    }
+    printf("Attribute interest index benchmark: %" PRIu32 " subscriptions, %zu paths, %" PRIu32 " attribute changes\n",
+           subscriptionCount, pathCount, changeCount);
+
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    const uint64_t scanMarked           = RunScan(subscriptions, changes);
+    Report("Handler scan", ElapsedNanoseconds(start), changeCount, scanMarked);
+
+    double nanoseconds = 0;
+    VerifyOrDie(RunIndex<64>(subscriptions, changes, nanoseconds) == scanMarked);
+    Report("Index, 64 buckets", nanoseconds, changeCount, scanMarked);
+    VerifyOrDie(RunIndex<1024>(subscriptions, changes, nanoseconds) == scanMarked);
+    Report("Index, 1024 buckets", nanoseconds, changeCount, scanMarked);
+
+    return EXIT_SUCCESS;
+}
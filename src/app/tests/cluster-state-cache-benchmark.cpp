@@ -0,0 +1,228 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a memory and throughput benchmark for ClusterStateCache.
+ *
+ *      One cache per node (200 nodes by default) is primed with a wildcard
+ *      subscription report of 8 endpoints x 12 clusters x 16 attributes, mixing
+ *      integers and octet strings. Then rounds of reports changing 5% of the
+ *      attributes with new data versions are applied, and random attributes are
+ *      read back. The heap used per node and the average cost of each operation
+ *      are reported for the map storage (ClusterStateCache) and for the flat
+ *      storage (ClusterStateCacheFlat).
+ *
+ *      Usage: cluster-state-cache-benchmark [node-count] [update-rounds]
+ */
+
+#include <inttypes.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <app/ClusterStateCache.h>
+#include <app/MessageDef/DataVersionFilterIBs.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+
+#include <memory>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::Test;
+
+namespace {
+
+constexpr EndpointId kEndpointCount   = 8;
+constexpr ClusterId kClusterCount     = 12;
+constexpr AttributeId kAttributeCount = 16;
+constexpr uint32_t kAttributesPerNode = kEndpointCount * kClusterCount * kAttributeCount;
+
+size_t HeapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+uint64_t NextRandom(uint64_t & state)
+{
+    // xorshift64: deterministic and cheap compared to the operations being measured.
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+ConcreteAttributePath AttributePath(uint32_t index)
+{
+    const AttributeId attributeId = index % kAttributeCount;
+    const ClusterId clusterId     = (index / kAttributeCount) % kClusterCount;
+    const EndpointId endpointId   = static_cast<EndpointId>(index / (kAttributeCount * kClusterCount));
+    return ConcreteAttributePath(endpointId, clusterId + 1, attributeId);
+}
+
+template <typename CacheType>
+class NullCallback : public CacheType::Callback
+{
+    void OnDone(ReadClient *) override {}
+};
+
+// Delivers the value of an attribute to the cache, as the buffered read callback of a ReadClient would.
+void ReportAttribute(ReadClient::Callback & callback, uint32_t index, DataVersion dataVersion, uint8_t seed)
+{
+    ConcreteDataAttributePath path(AttributePath(index));
+    path.mDataVersion.SetValue(dataVersion);
+
+    uint8_t buffer[128];
+    TLV::TLVWriter writer;
+    writer.Init(buffer);
+    if (path.mAttributeId % 4 == 0)
+    {
+        // Octet strings of 16 to 64 bytes, like labels and serial numbers.
+        uint8_t value[64];
+        const uint32_t length = 16 + (index * 7) % 49;
+        memset(value, seed, length);
+        VerifyOrDie(writer.PutBytes(TLV::AnonymousTag(), value, length) == CHIP_NO_ERROR);
+    }
+    else
+    {
+        VerifyOrDie(writer.Put(TLV::AnonymousTag(), static_cast<uint32_t>(index + seed)) == CHIP_NO_ERROR);
+    }
+    VerifyOrDie(writer.Finalize() == CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    reader.Init(buffer, writer.GetLengthWritten());
+    VerifyOrDie(reader.Next() == CHIP_NO_ERROR);
+    callback.OnAttributeData(path, &reader, StatusIB());
+}
+
+// Tells the cache that it is handling a wildcard subscription, so that it tracks data versions.
+void SetWildcardPath(ReadClient::Callback & callback)
+{
+    AttributePathParams wildcardPath;
+    uint8_t buffer[20];
+    TLV::TLVWriter writer;
+    writer.Init(buffer);
+    DataVersionFilterIBs::Builder builder;
+    VerifyOrDie(builder.Init(&writer) == CHIP_NO_ERROR);
+    bool encodedDataVersionList = false;
+    VerifyOrDie(callback.OnUpdateDataVersionFilterList(builder, Span<AttributePathParams>(&wildcardPath, 1),
+                                                       encodedDataVersionList) == CHIP_NO_ERROR);
+}
+
+template <typename CacheType>
+void RunBenchmark(const char * name, uint32_t nodeCount, uint32_t updateRounds)
+{
+    NullCallback<CacheType> callback;
+    std::vector<std::unique_ptr<CacheType>> caches;
+
+    printf("%s:\n", name);
+
+    size_t heapBefore                   = HeapInUse();
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t node = 0; node < nodeCount; node++)
+    {
+        caches.push_back(std::make_unique<CacheType>(callback));
+        ReadClient::Callback & reportCallback = caches.back()->GetBufferedCallback();
+        SetWildcardPath(reportCallback);
+
+        reportCallback.OnReportBegin();
+        for (uint32_t index = 0; index < kAttributesPerNode; index++)
+        {
+            ReportAttribute(reportCallback, index, 1, 0);
+        }
+        reportCallback.OnReportEnd();
+    }
+    printf("  Prime:   %.1f ns/attribute\n", ElapsedNanoseconds(start) / (nodeCount * kAttributesPerNode));
+    printf("  Heap:    %zu bytes/node after priming\n", (HeapInUse() - heapBefore) / nodeCount);
+
+    // Each round changes 5% of the attributes of each node, clustered the way real reports are.
+    uint64_t random                = 0x9E3779B97F4A7C15ull;
+    const uint32_t updatesPerRound = kAttributesPerNode / 20;
+    start                          = System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t round = 0; round < updateRounds; round++)
+    {
+        for (auto & cache : caches)
+        {
+            ReadClient::Callback & reportCallback = cache->GetBufferedCallback();
+            const uint32_t first                  = static_cast<uint32_t>(NextRandom(random) % kAttributesPerNode);
+
+            reportCallback.OnReportBegin();
+            for (uint32_t i = 0; i < updatesPerRound; i++)
+            {
+                ReportAttribute(reportCallback, (first + i) % kAttributesPerNode, round + 2, static_cast<uint8_t>(round + 1));
+            }
+            reportCallback.OnReportEnd();
+        }
+    }
+    printf("  Update:  %.1f ns/attribute\n", ElapsedNanoseconds(start) / (nodeCount * updateRounds * updatesPerRound));
+    printf("  Heap:    %zu bytes/node after %" PRIu32 " update rounds\n", (HeapInUse() - heapBefore) / nodeCount, updateRounds);
+
+    const uint32_t readCount = nodeCount * kAttributesPerNode * 4;
+    uint64_t checksum        = 0;
+    start                    = System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t i = 0; i < readCount; i++)
+    {
+        const CacheType & cache = *caches[i % nodeCount];
+        TLV::TLVReader reader;
+        VerifyOrDie(cache.Get(AttributePath(static_cast<uint32_t>(NextRandom(random) % kAttributesPerNode)), reader) ==
+                    CHIP_NO_ERROR);
+        checksum += reader.GetLength();
+    }
+    printf("  Get:     %.1f ns/attribute (checksum %" PRIu64 ")\n", ElapsedNanoseconds(start) / readCount, checksum);
+
+    uint32_t visited = 0;
+    start            = System::SystemClock().GetMonotonicMicroseconds64();
+    for (auto & cache : caches)
+    {
+        for (EndpointId endpointId = 0; endpointId < kEndpointCount; endpointId++)
+        {
+            VerifyOrDie(cache->ForEachCluster(endpointId, [&cache, endpointId, &visited](ClusterId clusterId) {
+                return cache->ForEachAttribute(endpointId, clusterId, [&visited](const ConcreteAttributePath &) {
+                    visited++;
+                    return CHIP_NO_ERROR;
+                });
+            }) == CHIP_NO_ERROR);
+        }
+    }
+    VerifyOrDie(visited == nodeCount * kAttributesPerNode);
+    printf("  Iterate: %.1f ns/attribute\n", ElapsedNanoseconds(start) / visited);
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t nodeCount    = ParseArg(argc, argv, 1, 200);
+    const uint32_t updateRounds = ParseArg(argc, argv, 2, 100);
+
+    ScopedPlatformMemory platformMemory;
+
+    printf("ClusterStateCache benchmark: %" PRIu32 " nodes, %" PRIu32 " attributes per node\n", nodeCount, kAttributesPerNode);
+    RunBenchmark<ClusterStateCache>("Map storage", nodeCount, updateRounds);
+    RunBenchmark<ClusterStateCacheFlat>("Flat storage", nodeCount, updateRounds);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,234 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the event log of EventManagement
+ *      in RAM and in a memory-mapped file (MappedEventLogStorage).
+ *
+ *      For each storage, it logs events of 3 fields with the three
+ *      priorities in turn into 3 buffers of the given size, then fetches the
+ *      whole log in report-sized chunks, as a wildcard event read would, and
+ *      reports the events logged and fetched per second.  For the file, it
+ *      also reports the time to write the log back to the file (Sync) and
+ *      to restore the log from it, as after a restart.
+ *
+ *      Usage: event-log-storage-benchmark [event-count] [buffer-size] [file-path]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <access/AccessControl.h>
+#include <access/examples/PermissiveAccessControlDelegate.h>
+#include <app/EventLoggingDelegate.h>
+#include <app/EventManagement.h>
+#include <app/MappedEventLogStorage.h>
+#include <app/MessageDef/EventDataIB.h>
+#include <lib/support/CHIPCounter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/LinkedList.h>
+#include <lib/support/ScopedBuffer.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+
+#include <algorithm>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::Test;
+
+namespace {
+
+constexpr size_t kBufferCount    = 3;
+constexpr size_t kChunkSize      = 1024;
+constexpr uint32_t kFetchCount   = 10;
+constexpr ClusterId kClusterId   = 0x0405; // Relative Humidity Measurement
+constexpr EndpointId kEndpointId = 1;
+
+class DeviceTypeResolver : public Access::AccessControl::DeviceTypeResolver
+{
+public:
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId aDeviceType, EndpointId aEndpoint) override { return false; }
+} gDeviceTypeResolver;
+
+class EventGenerator : public EventLoggingDelegate
+{
+public:
+    CHIP_ERROR WriteEvent(TLV::TLVWriter & aWriter) override
+    {
+        TLV::TLVType containerType;
+        ReturnErrorOnFailure(
+            aWriter.StartContainer(TLV::ContextTag(EventDataIB::Tag::kData), TLV::kTLVType_Structure, containerType));
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(0), mValue));
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(1), static_cast<uint16_t>(mValue % 10000)));
+        ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(2), mValue % 7 == 0));
+        return aWriter.EndContainer(containerType);
+    }
+
+    uint32_t mValue = 0;
+};
+
+void InitResources(LogStorageResources (&aResources)[kBufferCount], uint32_t aBufferSize)
+{
+    aResources[0] = { nullptr, aBufferSize, PriorityLevel::Debug };
+    aResources[1] = { nullptr, aBufferSize, PriorityLevel::Info };
+    aResources[2] = { nullptr, aBufferSize, PriorityLevel::Critical };
+}
+
+void StartLogging(LogStorageResources (&aResources)[kBufferCount], CircularEventBuffer (&aBuffers)[kBufferCount],
+                  MonotonicallyIncreasingCounter<EventNumber> & aCounter, EventNumber aEventCounter)
+{
+    VerifyOrDie(aCounter.Init(aEventCounter) == CHIP_NO_ERROR);
+    EventManagement::CreateEventManagement(nullptr, kBufferCount, aBuffers, aResources, &aCounter);
+}
+
+uint64_t LogEvents(uint32_t aEventCount)
+{
+    EventGenerator generator;
+    EventOptions options;
+    options.mPath = ConcreteEventPath(kEndpointId, kClusterId, 0);
+
+    const uint64_t start = NowMicroseconds();
+    for (uint32_t i = 0; i < aEventCount; i++)
+    {
+        EventNumber eventNumber;
+        generator.mValue  = i;
+        options.mPriority = static_cast<PriorityLevel>(i % kBufferCount);
+        VerifyOrDie(EventManagement::GetInstance().LogEvent(&generator, options, eventNumber) == CHIP_NO_ERROR);
+    }
+    return NowMicroseconds() - start;
+}
+
+// Fetches the whole log in chunks, returning the number of events fetched.
+size_t FetchEvents()
+{
+    uint8_t chunk[kChunkSize];
+    SingleLinkedListNode<EventPathParams> path;
+    EventNumber eventMin = 0;
+    size_t total         = 0;
+
+    for (;;)
+    {
+        TLV::TLVWriter writer;
+        size_t eventCount = 0;
+        writer.Init(chunk);
+        CHIP_ERROR err =
+            EventManagement::GetInstance().FetchEventsSince(writer, &path, eventMin, eventCount, Access::SubjectDescriptor{});
+        total += eventCount;
+        if (err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV)
+        {
+            return total;
+        }
+        VerifyOrDie((err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY) && eventCount > 0);
+    }
+}
+
+void Report(const char * aName, uint32_t aEventCount, uint64_t aLogMicroseconds)
+{
+    size_t fetchedCount  = 0;
+    const uint64_t start = NowMicroseconds();
+    for (uint32_t i = 0; i < kFetchCount; i++)
+    {
+        fetchedCount = FetchEvents();
+    }
+    const uint64_t fetchMicroseconds = NowMicroseconds() - start;
+
+    printf("  %-6s: %10.0f events logged/s, %10.0f events fetched/s (%zu events in the log)\n", aName,
+           PerSecond(aEventCount, aLogMicroseconds), PerSecond(fetchedCount * kFetchCount, fetchMicroseconds), fetchedCount);
+}
+
+void RunInMemory(uint32_t aEventCount, uint32_t aBufferSize)
+{
+    LogStorageResources resources[kBufferCount];
+    CircularEventBuffer buffers[kBufferCount];
+    MonotonicallyIncreasingCounter<EventNumber> counter;
+    Platform::ScopedMemoryBuffer<uint8_t> storage;
+
+    VerifyOrDie(storage.Calloc(kBufferCount * aBufferSize));
+    InitResources(resources, aBufferSize);
+    for (size_t i = 0; i < kBufferCount; i++)
+    {
+        resources[i].mpBuffer = storage.Get() + i * aBufferSize;
+    }
+
+    StartLogging(resources, buffers, counter, 0);
+    Report("ram", aEventCount, LogEvents(aEventCount));
+    EventManagement::DestroyEventManagement();
+}
+
+void RunMapped(uint32_t aEventCount, uint32_t aBufferSize, const char * apPath)
+{
+    LogStorageResources resources[kBufferCount];
+    CircularEventBuffer buffers[kBufferCount];
+    MonotonicallyIncreasingCounter<EventNumber> counter;
+    MappedEventLogStorage storage;
+
+    unlink(apPath);
+    InitResources(resources, aBufferSize);
+    VerifyOrDie(storage.Open(apPath, resources, kBufferCount) == CHIP_NO_ERROR);
+
+    StartLogging(resources, buffers, counter, 0);
+    Report("mapped", aEventCount, LogEvents(aEventCount));
+
+    uint64_t start = NowMicroseconds();
+    VerifyOrDie(storage.Sync() == CHIP_NO_ERROR);
+    const uint64_t syncMicroseconds = NowMicroseconds() - start;
+
+    // Restart on the file, with the event counter persisted with the log.
+    const size_t eventCount = FetchEvents();
+    EventManagement::DestroyEventManagement();
+    storage.Close();
+
+    start = NowMicroseconds();
+    InitResources(resources, aBufferSize);
+    VerifyOrDie(storage.Open(apPath, resources, kBufferCount) == CHIP_NO_ERROR);
+    StartLogging(resources, buffers, counter, aEventCount);
+    const uint64_t restoreMicroseconds = NowMicroseconds() - start;
+    VerifyOrDie(FetchEvents() == eventCount);
+
+    printf("  %-6s: %10" PRIu64 " us to sync the file, %10" PRIu64 " us to restore %zu events\n", "mapped", syncMicroseconds,
+           restoreMicroseconds, eventCount);
+
+    EventManagement::DestroyEventManagement();
+    storage.Close();
+    unlink(apPath);
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t eventCount = std::max(1u, ParseArg(argc, argv, 1, 100000));
+    const uint32_t bufferSize = std::max(256u, ParseArg(argc, argv, 2, 64 * 1024));
+    const char * path         = (argc > 3) ? argv[3] : "/tmp/event-log-storage-benchmark.bin";
+
+    ScopedPlatformMemory platformMemory;
+    VerifyOrDie(Access::GetAccessControl().Init(Access::Examples::GetPermissiveAccessControlDelegate(), gDeviceTypeResolver) ==
+                CHIP_NO_ERROR);
+
+    printf("Event log storage benchmark: %" PRIu32 " events into %zu buffers of %" PRIu32 " bytes, fetched in %zu-byte chunks\n",
+           eventCount, kBufferCount, bufferSize, kChunkSize);
+
+    RunInMemory(eventCount, bufferSize);
+    RunMapped(eventCount, bufferSize, path);
+
+    Access::GetAccessControl().Finish();
+    return 0;
+}
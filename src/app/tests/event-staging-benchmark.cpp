@@ -0,0 +1,258 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of event logging from application
+ *      threads, with and without the EventStagingQueue.
+ *
+ *      8 producer threads log events of 3 fields into a circular TLV log,
+ *      each waiting for an interval between events (none to saturate), while a Matter thread alternates between holding a mutex, standing in
+ *      for the Matter stack lock, to do some work (report generation and the
+ *      like), and sleeping for as long. With the "locked" logging, producers
+ *      take the mutex to write their events into the log, as LogEvent
+ *      requires. With the "staged" logging, producers push their events into
+ *      an EventStagingQueue without a lock, and the Matter thread copies them
+ *      into the log while it holds the mutex, as
+ *      EventManagement::LogStagedEvents does; events that do not fit in the
+ *      queue are dropped, as LogEventFromAnyThread fails for them. For each,
+ *      it reports the log calls per second, the mean and worst time of a log
+ *      call in the producers, and the number of dropped events.
+ *
+ *      Usage: event-staging-benchmark [events-per-thread] [event-interval-us] [matter-work-us]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <app/EventStagingQueue.h>
+#include <app/MessageDef/EventDataIB.h>
+#include <lib/core/TLVCircularBuffer.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::Test;
+
+namespace {
+
+constexpr size_t kProducerCount  = 8;
+constexpr size_t kStagingSize    = 256;
+constexpr size_t kMaxEventSize   = 64;
+constexpr uint32_t kLogSize      = 16 * 1024;
+constexpr ClusterId kClusterId   = 0x0405; // Relative Humidity Measurement
+constexpr EndpointId kEndpointId = 1;
+
+using StagingQueue = EventStagingQueue<kStagingSize, kMaxEventSize>;
+
+enum class Mode
+{
+    kLocked,
+    kStaged,
+};
+
+struct ProducerResult
+{
+    uint64_t totalMicroseconds = 0;
+    uint64_t worstMicroseconds = 0;
+    uint64_t droppedCount      = 0;
+};
+
+struct Context
+{
+    Mode mode;
+    uint32_t eventsPerThread;
+    uint32_t intervalMicroseconds;
+    std::mutex stackLock;
+    uint8_t logBuffer[kLogSize];
+    TLV::TLVCircularBuffer log{ logBuffer, kLogSize };
+    StagingQueue staging;
+    std::atomic<size_t> finishedProducers{ 0 };
+    uint64_t loggedEvents = 0;
+    ProducerResult results[kProducerCount];
+};
+
+CHIP_ERROR EncodeEventData(TLV::TLVWriter & aWriter, uint32_t aProducer, uint32_t aValue)
+{
+    TLV::TLVType containerType;
+    ReturnErrorOnFailure(aWriter.StartContainer(TLV::ContextTag(EventDataIB::Tag::kData), TLV::kTLVType_Structure, containerType));
+    ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(0), aProducer));
+    ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(1), aValue));
+    ReturnErrorOnFailure(aWriter.Put(TLV::ContextTag(2), static_cast<uint16_t>(aValue % 10000)));
+    return aWriter.EndContainer(containerType);
+}
+
+// Writes an event into the log as EventManagement does: an anonymous structure holding the data written by aWriteData.
+template <typename DataFunction>
+CHIP_ERROR WriteToLog(Context & aContext, DataFunction && aWriteData)
+{
+    TLV::CircularTLVWriter writer;
+    TLV::TLVType containerType;
+    writer.Init(aContext.log);
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, containerType));
+    ReturnErrorOnFailure(aWriteData(writer));
+    ReturnErrorOnFailure(writer.EndContainer(containerType));
+    ReturnErrorOnFailure(writer.Finalize());
+    aContext.loggedEvents++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CopyStagedEvent(Context & aContext, ByteSpan aEncodedData)
+{
+    return WriteToLog(aContext, [aEncodedData](TLV::TLVWriter & aWriter) {
+        TLV::TLVReader reader;
+        TLV::TLVType containerType;
+        reader.Init(aEncodedData);
+        ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
+        ReturnErrorOnFailure(reader.EnterContainer(containerType));
+        ReturnErrorOnFailure(reader.Next());
+        return aWriter.CopyElement(reader);
+    });
+}
+
+void RunProducer(Context & aContext, uint32_t aProducer)
+{
+    ProducerResult & result = aContext.results[aProducer];
+    EventOptions options;
+    options.mPath = ConcreteEventPath(kEndpointId, kClusterId, aProducer);
+
+    for (uint32_t value = 0; value < aContext.eventsPerThread; value++)
+    {
+        const uint64_t start = NowMicroseconds();
+        if (aContext.mode == Mode::kLocked)
+        {
+            std::lock_guard<std::mutex> lock(aContext.stackLock);
+            VerifyOrDie(WriteToLog(aContext, [&](TLV::TLVWriter & aWriter) {
+                            return EncodeEventData(aWriter, aProducer, value);
+                        }) == CHIP_NO_ERROR);
+        }
+        else
+        {
+            CHIP_ERROR err = aContext.staging.Push(
+                options, [&](TLV::TLVWriter & aWriter) { return EncodeEventData(aWriter, aProducer, value); });
+            if (err == CHIP_ERROR_NO_MEMORY)
+            {
+                result.droppedCount++;
+            }
+            else
+            {
+                VerifyOrDie(err == CHIP_NO_ERROR);
+            }
+        }
+        const uint64_t elapsed   = NowMicroseconds() - start;
+        result.totalMicroseconds = result.totalMicroseconds + elapsed;
+        result.worstMicroseconds = std::max(result.worstMicroseconds, elapsed);
+
+        if (aContext.intervalMicroseconds > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(aContext.intervalMicroseconds));
+        }
+    }
+    aContext.finishedProducers.fetch_add(1);
+}
+
+void RunMatterThread(Context & aContext, uint32_t aWorkMicroseconds)
+{
+    bool done = false;
+    while (!done)
+    {
+        {
+            std::lock_guard<std::mutex> lock(aContext.stackLock);
+
+            const uint64_t start = NowMicroseconds();
+            while (NowMicroseconds() - start < aWorkMicroseconds)
+            {
+            }
+
+            done = (aContext.finishedProducers.load() == kProducerCount);
+            if (aContext.mode == Mode::kStaged)
+            {
+                aContext.staging.Drain([&](const EventOptions &, ByteSpan aEncodedData) {
+                    VerifyOrDie(CopyStagedEvent(aContext, aEncodedData) == CHIP_NO_ERROR);
+                });
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(aWorkMicroseconds));
+    }
+}
+
+void Run(Mode aMode, uint32_t aEventsPerThread, uint32_t aIntervalMicroseconds, uint32_t aWorkMicroseconds)
+{
+    Context * context             = new Context();
+    context->mode                 = aMode;
+    context->eventsPerThread      = aEventsPerThread;
+    context->intervalMicroseconds = aIntervalMicroseconds;
+    const uint64_t start          = NowMicroseconds();
+    std::thread matterThread(RunMatterThread, std::ref(*context), aWorkMicroseconds);
+
+    std::vector<std::thread> producers;
+    for (uint32_t i = 0; i < kProducerCount; i++)
+    {
+        producers.emplace_back(RunProducer, std::ref(*context), i);
+    }
+    for (std::thread & producer : producers)
+    {
+        producer.join();
+    }
+    matterThread.join();
+    const uint64_t elapsed = NowMicroseconds() - start;
+
+    ProducerResult total;
+    for (const ProducerResult & result : context->results)
+    {
+        total.totalMicroseconds = total.totalMicroseconds + result.totalMicroseconds;
+        total.worstMicroseconds = std::max(total.worstMicroseconds, result.worstMicroseconds);
+        total.droppedCount      = total.droppedCount + result.droppedCount;
+    }
+    const double eventCount = static_cast<double>(kProducerCount) * aEventsPerThread;
+    VerifyOrDie(context->loggedEvents + total.droppedCount == kProducerCount * aEventsPerThread);
+
+    printf("  %-6s: %10.0f log calls/s, %8.2f us mean log call, %8" PRIu64 " us worst, %8" PRIu64 " dropped events\n",
+           (aMode == Mode::kLocked) ? "locked" : "staged", eventCount * 1e6 / static_cast<double>(elapsed),
+           static_cast<double>(total.totalMicroseconds) / eventCount, total.worstMicroseconds, total.droppedCount);
+    delete context;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t eventsPerThread      = std::max(1u, ParseArg(argc, argv, 1, 20000));
+    const uint32_t intervalMicroseconds = ParseArg(argc, argv, 2, 100);
+    const uint32_t workMicroseconds     = ParseArg(argc, argv, 3, 20);
+
+    ScopedPlatformMemory platformMemory;
+
+    printf("Event staging benchmark: %zu producer threads, %" PRIu32 " events per thread every %" PRIu32 " us, %" PRIu32
+           " us of Matter thread work per lock\n",
+           kProducerCount, eventsPerThread, intervalMicroseconds, workMicroseconds);
+
+    Run(Mode::kLocked, eventsPerThread, intervalMicroseconds, workMicroseconds);
+    Run(Mode::kStaged, eventsPerThread, intervalMicroseconds, workMicroseconds);
+
+    return 0;
+}
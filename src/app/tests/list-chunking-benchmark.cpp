@@ -0,0 +1,229 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the chunking of large list
+ *      attributes in reports, with and without an AttributeListItemCarry.
+ *
+ *      Lists of access control entries (4 subjects and 2 targets each),
+ *      user labels (16 character label and value) and parts list endpoints
+ *      (100 items by default) are encoded by AttributeValueEncoder into report
+ *      packets as reporting::Engine does: each chunk gets a new packet, and
+ *      list encoding resumes from the AttributeEncodeState of the previous
+ *      chunk. For each list, it reports the bytes encoded per byte sent
+ *      (encoding that does not fit in a chunk is rolled back and counts as
+ *      encoded, copies out of the carry do not), how many times the items
+ *      were encoded, and the time per item.
+ *
+ *      Usage: list-chunking-benchmark [item-count] [round-count]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <app-common/zap-generated/cluster-objects.h>
+#include <app-common/zap-generated/ids/Attributes.h>
+#include <app-common/zap-generated/ids/Clusters.h>
+#include <app/AttributeListItemCarry.h>
+#include <app/AttributeValueEncoder.h>
+#include <app/MessageDef/ReportDataMessage.h>
+#include <app/StatusResponse.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/TLVPacketBufferBackingStore.h>
+#include <system/tests/BenchmarkSupport.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+using namespace chip::Test;
+
+namespace {
+
+constexpr uint32_t kMaxItemCount        = 1000;
+constexpr FabricIndex kFabricIndex      = 1;
+constexpr DataVersion kDataVersion      = 0x12345678;
+constexpr uint64_t kSubjects[]          = { 0x0102030405060708, 0x1112131415161718, 0x2122232425262728, 0x3132333435363738 };
+constexpr char kLabel[]                 = "Living room 0001";
+constexpr char kLabelValue[]            = "Ceiling lamp 001";
+constexpr EndpointId kFirstPartEndpoint = 2;
+
+struct EncodeCounts
+{
+    size_t bytes = 0;
+    size_t items = 0;
+};
+
+EncodeCounts gEncodeCounts;
+
+/// A list item that counts the bytes written to encode it, including what is written before
+/// running out of space and rolled back.
+template <typename T>
+struct CountedItem
+{
+    static constexpr bool kIsFabricScoped = false;
+
+    const T & item;
+
+    CHIP_ERROR Encode(TLV::TLVWriter & writer, TLV::Tag tag) const
+    {
+        const uint32_t lengthBefore = writer.GetLengthWritten();
+        CHIP_ERROR err;
+        if constexpr (DataModel::IsFabricScoped<T>::value)
+        {
+            err = item.EncodeForRead(writer, tag, kFabricIndex);
+        }
+        else
+        {
+            err = DataModel::Encode(writer, tag, item);
+        }
+        gEncodeCounts.bytes += writer.GetLengthWritten() - lengthBefore;
+        gEncodeCounts.items++;
+        return err;
+    }
+};
+
+Access::SubjectDescriptor Subject()
+{
+    Access::SubjectDescriptor subject;
+    subject.fabricIndex = kFabricIndex;
+    subject.subject     = kSubjects[0];
+    subject.authMode    = Access::AuthMode::kCase;
+    return subject;
+}
+
+/// Encodes the list into as many report packets as it takes, the way reporting::Engine does,
+/// and returns the number of bytes sent.
+template <typename T>
+size_t ReportList(const ConcreteAttributePath & path, const std::vector<T> & items, AttributeListItemCarry * carry)
+{
+    AttributeEncodeState state;
+    state.SetListItemCarry(carry);
+
+    size_t sentLength = 0;
+    for (;;)
+    {
+        System::PacketBufferTLVWriter writer;
+        ReportDataMessage::Builder reportDataBuilder;
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMaxSecureSduLengthBytes);
+        VerifyOrDie(!buffer.IsNull());
+
+        writer.Init(std::move(buffer));
+        VerifyOrDie(writer.ReserveBuffer(Crypto::CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES) == CHIP_NO_ERROR);
+        VerifyOrDie(reportDataBuilder.Init(&writer) == CHIP_NO_ERROR);
+        AttributeReportIBs::Builder & attributeReportIBs = reportDataBuilder.CreateAttributeReportIBs();
+        VerifyOrDie(reportDataBuilder.GetError() == CHIP_NO_ERROR);
+        VerifyOrDie(writer.ReserveBuffer(1) == CHIP_NO_ERROR); // End of the AttributeReportIBs
+
+        AttributeValueEncoder encoder(attributeReportIBs, Subject(), path, kDataVersion, false, state);
+        CHIP_ERROR err = encoder.EncodeList([&items](const auto & listEncoder) -> CHIP_ERROR {
+            for (const T & item : items)
+            {
+                ReturnErrorOnFailure(listEncoder.Encode(CountedItem<T>{ item }));
+            }
+            return CHIP_NO_ERROR;
+        });
+        VerifyOrDie(err == CHIP_NO_ERROR || encoder.GetState().AllowPartialData());
+
+        VerifyOrDie(writer.UnreserveBuffer(1) == CHIP_NO_ERROR);
+        VerifyOrDie(attributeReportIBs.EndOfAttributeReportIBs() == CHIP_NO_ERROR);
+        reportDataBuilder.MoreChunkedMessages(err != CHIP_NO_ERROR).EndOfReportDataMessage();
+        VerifyOrDie(reportDataBuilder.GetError() == CHIP_NO_ERROR);
+        VerifyOrDie(writer.Finalize(&buffer) == CHIP_NO_ERROR);
+        sentLength += buffer->DataLength();
+
+        if (err == CHIP_NO_ERROR)
+        {
+            return sentLength;
+        }
+        state = encoder.GetState();
+    }
+}
+
+template <typename T>
+void Run(const char * name, const ConcreteAttributePath & path, const std::vector<T> & items, uint32_t roundCount)
+{
+    AttributeListItemCarry carry;
+    AttributeListItemCarry * carries[] = { nullptr, &carry };
+
+    for (AttributeListItemCarry * listItemCarry : carries)
+    {
+        size_t sentLength = 0;
+        gEncodeCounts     = EncodeCounts();
+
+        System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+        for (uint32_t round = 0; round < roundCount; round++)
+        {
+            sentLength = ReportList(path, items, listItemCarry);
+        }
+        const double elapsed = ElapsedNanoseconds(start);
+
+        printf("  %-16s %-13s %6zu bytes sent: %5.3f bytes encoded per byte sent, %5.3f encodes per item, %7.1f ns/item\n",
+               name, (listItemCarry == nullptr) ? "without carry" : "with carry", sentLength,
+               static_cast<double>(gEncodeCounts.bytes) / static_cast<double>(sentLength * roundCount),
+               static_cast<double>(gEncodeCounts.items) / static_cast<double>(items.size() * roundCount),
+               elapsed / static_cast<double>(items.size() * roundCount));
+    }
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t itemCount  = std::min(std::max(1u, ParseArg(argc, argv, 1, 100)), kMaxItemCount);
+    const uint32_t roundCount = std::max(1u, ParseArg(argc, argv, 2, 200));
+
+    ScopedPlatformMemory platformMemory;
+
+    printf("List chunking benchmark: %" PRIu32 " items per list, %" PRIu32 " rounds\n", itemCount, roundCount);
+
+    AccessControl::Structs::AccessControlTargetStruct::Type targets[2];
+    targets[0].cluster.SetNonNull(OnOff::Id);
+    targets[0].endpoint.SetNonNull(kFirstPartEndpoint);
+    targets[1].cluster.SetNonNull(LevelControl::Id);
+    targets[1].endpoint.SetNonNull(kFirstPartEndpoint);
+
+    std::vector<AccessControl::Structs::AccessControlEntryStruct::Type> entries(itemCount);
+    std::vector<UserLabel::Structs::LabelStruct::Type> labels(itemCount);
+    std::vector<EndpointId> parts(itemCount);
+    for (uint32_t i = 0; i < itemCount; i++)
+    {
+        entries[i].privilege   = AccessControl::AccessControlEntryPrivilegeEnum::kOperate;
+        entries[i].authMode    = AccessControl::AccessControlEntryAuthModeEnum::kCase;
+        entries[i].fabricIndex = kFabricIndex;
+        entries[i].subjects.SetNonNull(kSubjects);
+        entries[i].targets.SetNonNull(targets);
+        labels[i].label = CharSpan::fromCharString(kLabel);
+        labels[i].value = CharSpan::fromCharString(kLabelValue);
+        parts[i]        = static_cast<EndpointId>(kFirstPartEndpoint + i);
+    }
+
+    Run("access control", ConcreteAttributePath(kRootEndpointId, AccessControl::Id, AccessControl::Attributes::Acl::Id), entries,
+        roundCount);
+    Run("user labels", ConcreteAttributePath(kFirstPartEndpoint, UserLabel::Id, UserLabel::Attributes::LabelList::Id), labels,
+        roundCount);
+    Run("parts list", ConcreteAttributePath(kRootEndpointId, Descriptor::Id, Descriptor::Attributes::PartsList::Id), parts,
+        roundCount);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the attribute data sharing done by
+ *      reporting::Engine between identical subscriptions.
+ *
+ *      Each round, a set of attributes changes (20 by default, half integers
+ *      and half 32 character strings) and 1, 10 then 50 identical
+ *      subscriptions report them. Each report is built in a packet buffer as
+ *      the engine does, with the attribute data either encoded for every
+ *      subscription, or encoded once with SharedAttributeReport and copied
+ *      into every report. Only TLV encoding is measured: the data model reads
+ *      and access checks that the engine also does once per attribute and
+ *      subscription, and that sharing saves as well, are not. With a single
+ *      subscriber, sharing only adds a copy; the engine does not share then.
+ *
+ *      Usage: shared-attribute-report-benchmark [attribute-count] [round-count]
+ *
+ *      The attribute count is limited to 25, which fit in one report.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <app/MessageDef/ReportDataMessage.h>
+#include <app/StatusResponse.h>
+#include <app/reporting/SharedAttributeReport.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/TLVPacketBufferBackingStore.h>
+#include <system/tests/BenchmarkSupport.h>
+
+#include <algorithm>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::Test;
+
+namespace {
+
+constexpr uint32_t kSubscriberCounts[] = { 1, 10, 50 };
+constexpr uint32_t kMaxAttributeCount  = 25;
+constexpr char kStringValue[]          = "Living room ceiling light 0001";
+
+CHIP_ERROR EncodeAttributeReportIBs(ReportDataMessage::Builder & aReportDataBuilder, uint32_t aAttributeCount)
+{
+    AttributeReportIBs::Builder & attributeReportIBs = aReportDataBuilder.CreateAttributeReportIBs();
+    ReturnErrorOnFailure(aReportDataBuilder.GetError());
+
+    for (uint32_t i = 0; i < aAttributeCount; i++)
+    {
+        AttributeReportIB::Builder & attributeReportIB = attributeReportIBs.CreateAttributeReport();
+        ReturnErrorOnFailure(attributeReportIBs.GetError());
+        AttributeDataIB::Builder & attributeDataIB = attributeReportIB.CreateAttributeData();
+        ReturnErrorOnFailure(attributeReportIB.GetError());
+        attributeDataIB.DataVersion(0x12345678 + i);
+        AttributePathIB::Builder & path = attributeDataIB.CreatePath();
+        ReturnErrorOnFailure(path.Endpoint(static_cast<EndpointId>(1 + i / 10)).Cluster(6).Attribute(i).EndOfAttributePathIB());
+        TLV::TLVWriter * writer = attributeDataIB.GetWriter();
+        if (i % 2 == 0)
+        {
+            ReturnErrorOnFailure(writer->Put(TLV::ContextTag(AttributeDataIB::Tag::kData), i * 1000));
+        }
+        else
+        {
+            ReturnErrorOnFailure(writer->PutString(TLV::ContextTag(AttributeDataIB::Tag::kData), kStringValue));
+        }
+        ReturnErrorOnFailure(attributeDataIB.EndOfAttributeDataIB());
+        ReturnErrorOnFailure(attributeReportIB.EndOfAttributeReportIB());
+    }
+
+    return attributeReportIBs.EndOfAttributeReportIBs();
+}
+
+// Builds and finalizes the report of one subscription, as Engine::BuildAndSendSingleReportData does.
+template <typename EncodeFunction>
+size_t BuildReport(SubscriptionId aSubscriptionId, EncodeFunction && aEncodeAttributeReportIBs)
+{
+    System::PacketBufferTLVWriter writer;
+    ReportDataMessage::Builder reportDataBuilder;
+    System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMaxSecureSduLengthBytes);
+    VerifyOrDie(!buffer.IsNull());
+
+    writer.Init(std::move(buffer));
+    VerifyOrDie(reportDataBuilder.Init(&writer) == CHIP_NO_ERROR);
+    reportDataBuilder.SubscriptionId(aSubscriptionId);
+    VerifyOrDie(aEncodeAttributeReportIBs(reportDataBuilder) == CHIP_NO_ERROR);
+    reportDataBuilder.EndOfReportDataMessage();
+    VerifyOrDie(reportDataBuilder.GetError() == CHIP_NO_ERROR);
+    VerifyOrDie(writer.Finalize(&buffer) == CHIP_NO_ERROR);
+    return buffer->DataLength();
+}
+
+double RunPerSubscriber(uint32_t subscriberCount, uint32_t attributeCount, uint32_t roundCount, size_t & reportLength)
+{
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t round = 0; round < roundCount; round++)
+    {
+        for (SubscriptionId subscription = 0; subscription < subscriberCount; subscription++)
+        {
+            reportLength = BuildReport(subscription, [attributeCount](ReportDataMessage::Builder & reportDataBuilder) {
+                return EncodeAttributeReportIBs(reportDataBuilder, attributeCount);
+            });
+        }
+    }
+    return ElapsedNanoseconds(start);
+}
+
+double RunShared(uint32_t subscriberCount, uint32_t attributeCount, uint32_t roundCount, size_t & reportLength)
+{
+    reporting::SharedAttributeReport sharedReport;
+
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t round = 0; round < roundCount; round++)
+    {
+        VerifyOrDie(sharedReport.Encode(kMaxSecureSduLengthBytes, [attributeCount](ReportDataMessage::Builder & reportDataBuilder) {
+            return EncodeAttributeReportIBs(reportDataBuilder, attributeCount);
+        }) == CHIP_NO_ERROR);
+        for (SubscriptionId subscription = 0; subscription < subscriberCount; subscription++)
+        {
+            reportLength = BuildReport(subscription, [&sharedReport](ReportDataMessage::Builder & reportDataBuilder) {
+                return sharedReport.CopyTo(*reportDataBuilder.GetWriter());
+            });
+        }
+    }
+    return ElapsedNanoseconds(start);
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t attributeCount = std::min(std::max(1u, ParseArg(argc, argv, 1, 20)), kMaxAttributeCount);
+    const uint32_t roundCount     = std::max(1u, ParseArg(argc, argv, 2, 2000));
+
+    ScopedPlatformMemory platformMemory;
+
+    printf("Shared attribute report benchmark: %" PRIu32 " changed attributes, %" PRIu32 " rounds\n", attributeCount, roundCount);
+
+    for (uint32_t subscriberCount : kSubscriberCounts)
+    {
+        size_t perSubscriberLength = 0;
+        size_t sharedLength        = 0;
+        const double perSubscriber = RunPerSubscriber(subscriberCount, attributeCount, roundCount, perSubscriberLength);
+        const double shared        = RunShared(subscriberCount, attributeCount, roundCount, sharedLength);
+        VerifyOrDie(perSubscriberLength == sharedLength);
+
+        printf("  %2" PRIu32 " subscribers, %zu byte reports: %9.1f ns/change encoding each, %9.1f ns/change shared (x%.2f)\n",
+               subscriberCount, sharedLength, perSubscriber / roundCount, shared / roundCount, perSubscriber / shared);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -156,6 +156,8 @@ TestImCustomDataModel & TestImCustomDataModel::Instance()
 
 ActionReturnStatus TestImCustomDataModel::ReadAttribute(const ReadAttributeRequest & request, AttributeValueEncoder & encoder)
 {
+    mReadAttributeCount++;
+
     AttributeEncodeState mutableState(&encoder.GetState()); // provide a state copy to start.
 
     CHIP_ERROR err = ReadSingleClusterData(request.subjectDescriptor.value_or(Access::SubjectDescriptor()),
@@ -179,6 +181,12 @@ ActionReturnStatus TestImCustomDataModel::Invoke(const InvokeRequest & request,
     return CHIP_ERROR_NOT_IMPLEMENTED;
 }
 
+CHIP_ERROR TestImCustomDataModel::Shutdown()
+{
+    // The codegen provider answers the metadata queries, so it holds whatever they cached
+    return CodegenDataModelProviderInstance()->Shutdown();
+}
+
 EndpointId TestImCustomDataModel::FirstEndpoint()
 {
     return CodegenDataModelProviderInstance()->FirstEndpoint();
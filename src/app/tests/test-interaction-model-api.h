@@ -116,7 +116,7 @@ class TestImCustomDataModel : public DataModel::Provider
 public:
     static TestImCustomDataModel & Instance();
 
-    CHIP_ERROR Shutdown() override { return CHIP_NO_ERROR; }
+    CHIP_ERROR Shutdown() override;
 
     DataModel::ActionReturnStatus ReadAttribute(const DataModel::ReadAttributeRequest & request,
                                                 AttributeValueEncoder & encoder) override;
@@ -138,6 +138,9 @@ public:
     std::optional<DataModel::CommandInfo> GetAcceptedCommandInfo(const ConcreteCommandPath & path) override;
     ConcreteCommandPath FirstGeneratedCommand(const ConcreteClusterPath & cluster) override;
     ConcreteCommandPath NextGeneratedCommand(const ConcreteCommandPath & before) override;
+
+    /// Number of ReadAttribute calls, for tests that check how often attribute data gets encoded.
+    uint32_t mReadAttributeCount = 0;
 };
 
 } // namespace app
@@ -93,6 +93,9 @@ uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
 uint16_t emberEndpointCount = 0;
 
+// Changed every time endpoints are configured, enabled or disabled.
+uint32_t endpointConfigurationGeneration = 0;
+
 // If we have attributes that are more than 4 bytes, then
 // we need this data block for the defaults
 #if (defined(GENERATED_DEFAULTS) && GENERATED_DEFAULTS_COUNT)
@@ -236,6 +239,8 @@ void emberAfEndpointConfigure()
         }
     }
 #endif
+
+    endpointConfigurationGeneration++;
 }
 
 void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
@@ -696,6 +701,20 @@ const EmberAfEndpointType * emberAfFindEndpointType(EndpointId endpointId)
     return emAfEndpoints[ep].endpointType;
 }
 
+uint32_t emberAfEndpointConfigurationGeneration()
+{
+    return endpointConfigurationGeneration;
+}
+
+const EmberAfEndpointType * emberAfEndpointTypeFromIndex(uint16_t index)
+{
+    if ((index >= emberAfEndpointCount()) || !emberAfEndpointIndexIsEnabled(index))
+    {
+        return nullptr;
+    }
+    return emAfEndpoints[index].endpointType;
+}
+
 const EmberAfCluster * emberAfFindClusterInType(const EmberAfEndpointType * endpointType, ClusterId clusterId,
                                                 EmberAfClusterMask mask, uint8_t * index)
 {
@@ -926,6 +945,8 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
             emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
         }
 
+        endpointConfigurationGeneration++;
+
         EndpointId parentEndpointId = emberAfParentEndpointFromIndex(index);
         while (parentEndpointId != kInvalidEndpointId)
         {
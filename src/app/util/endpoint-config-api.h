@@ -56,6 +56,25 @@ chip::EndpointId emberAfEndpointFromIndex(uint16_t index);
  */
 const EmberAfEndpointType * emberAfFindEndpointType(chip::EndpointId endpointId);
 
+/**
+ * Returns the endpoint descriptor for the endpoint at the given index if there
+ * is an enabled endpoint at that index.  Otherwise (including for indices not
+ * less than emberAfEndpointCount()) returns null.
+ *
+ * Unlike emberAfFindEndpointType, this does not search the endpoints.
+ */
+const EmberAfEndpointType * emberAfEndpointTypeFromIndex(uint16_t index);
+
+/**
+ * Returns a value that changes every time the set of enabled endpoints (and so
+ * the clusters and attributes they have) changes: when endpoints are configured,
+ * enabled or disabled, including dynamic endpoints being set or cleared.
+ *
+ * Allows callers to keep data derived from the endpoint configuration and know
+ * when it needs to be built again.
+ */
+uint32_t emberAfEndpointConfigurationGeneration();
+
 /**
  * Returns the cluster descriptor for the given cluster on the given endpoint.
  *
@@ -189,9 +189,13 @@ MockEndpointConfig::MockEndpointConfig(EndpointId aId, std::initializer_list<Moc
 }
 
 MockEndpointConfig::MockEndpointConfig(const MockEndpointConfig & other) :
-    id(other.id), clusters(other.clusters), mEmberClusters(other.mEmberClusters), mEmberEndpoint(other.mEmberEndpoint)
+    id(other.id), clusters(other.clusters), mEmberEndpoint(other.mEmberEndpoint)
 {
-    // fix self-referencing pointers
+    // fix self-referencing pointers: the EmberAfClusters of `other` reference the attributes of its own clusters
+    for (const auto & cluster : clusters)
+    {
+        mEmberClusters.push_back(*cluster.emberCluster());
+    }
     mEmberEndpoint.cluster = mEmberClusters.data();
 }
 
@@ -205,6 +209,11 @@ MockNodeConfig::MockNodeConfig(std::initializer_list<MockEndpointConfig> aEndpoi
     VerifyOrDie(aEndpoints.size() < kEmberInvalidEndpointIndex);
 }
 
+MockNodeConfig::MockNodeConfig(const std::vector<MockEndpointConfig> & aEndpoints) : endpoints(aEndpoints)
+{
+    VerifyOrDie(aEndpoints.size() < kEmberInvalidEndpointIndex);
+}
+
 const MockEndpointConfig * MockNodeConfig::endpointById(EndpointId endpointId, ptrdiff_t * outIndex) const
 {
     return findById(endpoints, endpointId, outIndex);
@@ -63,6 +63,7 @@ namespace {
 
 DataVersion dataVersion           = 0;
 const MockNodeConfig * mockConfig = nullptr;
+uint32_t mockConfigGeneration     = 0;
 
 const MockNodeConfig & DefaultMockNodeConfig()
 {
@@ -300,6 +301,18 @@ const EmberAfEndpointType * emberAfFindEndpointType(EndpointId endpointId)
     return endpoint->emberEndpoint();
 }
 
+const EmberAfEndpointType * emberAfEndpointTypeFromIndex(uint16_t index)
+{
+    auto & config = GetMockNodeConfig();
+    VerifyOrReturnValue(index < config.endpoints.size(), nullptr);
+    return config.endpoints[index].emberEndpoint();
+}
+
+uint32_t emberAfEndpointConfigurationGeneration()
+{
+    return mockConfigGeneration;
+}
+
 const EmberAfCluster * emberAfFindServerCluster(EndpointId endpointId, ClusterId clusterId)
 {
     auto cluster = GetMockNodeConfig().clusterByIds(endpointId, clusterId);
@@ -461,12 +474,14 @@ CHIP_ERROR ReadSingleMockClusterData(FabricIndex aAccessingFabricIndex, const Co
 void SetMockNodeConfig(const MockNodeConfig & config)
 {
     mockConfig = &config;
+    mockConfigGeneration++;
 }
 
 /// Resets the mock attribute storage to the default configuration.
 void ResetMockNodeConfig()
 {
     mockConfig = nullptr;
+    mockConfigGeneration++;
 }
 
 } // namespace Test
@@ -804,6 +804,8 @@ public:
 
     Credentials::DeviceAttestationVerifier * GetDeviceAttestationVerifier() const { return mDeviceAttestationVerifier; }
 
+    CommissioningDelegate * GetDefaultCommissioner() const { return mDefaultCommissioner; }
+
     Optional<CommissioningParameters> GetCommissioningParameters()
     {
         return mDefaultCommissioner == nullptr ? NullOptional : MakeOptional(mDefaultCommissioner->GetCommissioningParameters());
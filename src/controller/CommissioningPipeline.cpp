@@ -0,0 +1,402 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <controller/CommissioningPipeline.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+using namespace chip::System::Clock;
+
+namespace chip {
+namespace Controller {
+
+namespace {
+
+Milliseconds64 ElapsedSince(Timestamp start)
+{
+    return std::chrono::duration_cast<Milliseconds64>(System::SystemClock().GetMonotonicTimestamp() - start);
+}
+
+} // anonymous namespace
+
+void CommissioningPipeline::StageStatistics::Record(Milliseconds64 duration, CHIP_ERROR err)
+{
+    count++;
+    if (err != CHIP_NO_ERROR)
+    {
+        failures++;
+    }
+    total += duration;
+    if (duration > max)
+    {
+        max = duration;
+    }
+}
+
+void CommissioningPipeline::Lane::Start(const Commissionee & commissionee)
+{
+    ChipLogProgress(Controller, "Commissioning pipeline: queueing node ID 0x" ChipLogFormatX64,
+                    ChipLogValueX64(commissionee.nodeId));
+    mCommissionee = &commissionee;
+    mState        = State::kWaitingForPASE;
+    mStageStart   = System::SystemClock().GetMonotonicTimestamp();
+}
+
+void CommissioningPipeline::Lane::OnHandshakeGranted()
+{
+    mPipeline->mHandshakeWaitStatistics.Record(ElapsedSince(mStageStart), CHIP_NO_ERROR);
+    mStageStart = System::SystemClock().GetMonotonicTimestamp();
+
+    if (mState == State::kWaitingForCASE)
+    {
+        mState         = State::kCASE;
+        CHIP_ERROR err = PerformHeldStep(mStage);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Controller, "Commissioning pipeline: failed to start stage '%s': %" CHIP_ERROR_FORMAT,
+                         StageToString(mStage), err.Format());
+            StopCommissionee(mCommissionee->nodeId);
+            Finish(err, mStage);
+        }
+        return;
+    }
+
+    VerifyOrDie(mState == State::kWaitingForPASE);
+    mState = State::kPASE;
+
+    CHIP_ERROR err = PairCommissionee(*mCommissionee);
+    if (err != CHIP_NO_ERROR)
+    {
+        OnPairingComplete(err);
+    }
+}
+
+void CommissioningPipeline::Lane::ReleaseHandshake()
+{
+    VerifyOrReturn(mState == State::kPASE || mState == State::kCASE);
+    mState = State::kCommissioning;
+
+    VerifyOrDie(mPipeline->mHandshakesInProgress > 0);
+    mPipeline->mHandshakesInProgress--;
+    mPipeline->GrantHandshakes();
+}
+
+void CommissioningPipeline::Lane::Finish(CHIP_ERROR err, CommissioningStage failedStage)
+{
+    VerifyOrReturn(mState != State::kIdle);
+    if (mState == State::kPASE || mState == State::kCASE)
+    {
+        ReleaseHandshake();
+    }
+    mState = State::kIdle;
+    mStage = CommissioningStage::kError;
+    mPipeline->OnLaneDone(*this, err, failedStage);
+}
+
+CommissioningStage CommissioningPipeline::Lane::CurrentStage() const
+{
+    return (mState == State::kWaitingForPASE || mState == State::kPASE) ? CommissioningStage::kSecurePairing : mStage;
+}
+
+CHIP_ERROR CommissioningPipeline::Lane::PerformStep(CommissioningStage nextStage)
+{
+    mStage = nextStage;
+    if (mPipeline == nullptr || !IsCASEStage(nextStage) || mState != State::kCommissioning)
+    {
+        return AutoCommissioner::PerformStep(nextStage);
+    }
+
+    // Hold the stage until a handshake slot is free. The commissioner stays idle in the meantime.
+    mState = State::kWaitingForCASE;
+    mPipeline->GrantHandshakes();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CommissioningPipeline::Lane::Attach()
+{
+    VerifyOrReturnError(mDeviceCommissioner != nullptr && mDeviceCommissioner->GetDefaultCommissioner() == this,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    mDeviceCommissioner->RegisterPairingDelegate(this);
+    return CHIP_NO_ERROR;
+}
+
+void CommissioningPipeline::Lane::Detach()
+{
+    mDeviceCommissioner->RegisterPairingDelegate(nullptr);
+}
+
+CHIP_ERROR CommissioningPipeline::Lane::PairCommissionee(const Commissionee & commissionee)
+{
+    if (commissionee.setUpCode != nullptr)
+    {
+        return mDeviceCommissioner->PairDevice(commissionee.nodeId, commissionee.setUpCode, commissionee.parameters);
+    }
+
+    RendezvousParameters rendezvousParameters = commissionee.rendezvousParameters;
+    CommissioningParameters parameters        = commissionee.parameters;
+    return mDeviceCommissioner->PairDevice(commissionee.nodeId, rendezvousParameters, parameters);
+}
+
+void CommissioningPipeline::Lane::StopCommissionee(NodeId nodeId)
+{
+    LogErrorOnFailure(mDeviceCommissioner->StopPairing(nodeId));
+}
+
+bool CommissioningPipeline::Lane::HasCommissioneeDevice(NodeId nodeId)
+{
+    CommissioneeDeviceProxy * device = nullptr;
+    return mDeviceCommissioner->GetDeviceBeingCommissioned(nodeId, &device) == CHIP_NO_ERROR;
+}
+
+void CommissioningPipeline::Lane::OnPairingComplete(CHIP_ERROR error)
+{
+    VerifyOrReturn(mState == State::kPASE);
+
+    mPipeline->mStageStatistics[CommissioningStage::kSecurePairing].Record(ElapsedSince(mStageStart), error);
+    mStageStart = System::SystemClock().GetMonotonicTimestamp();
+
+    if (error != CHIP_NO_ERROR)
+    {
+        // Commissioning never started, so no other callback will follow.
+        Finish(error, CommissioningStage::kSecurePairing);
+        return;
+    }
+    ReleaseHandshake();
+}
+
+void CommissioningPipeline::Lane::OnCommissioningStatusUpdate(PeerId peerId, CommissioningStage stageCompleted, CHIP_ERROR error)
+{
+    VerifyOrReturn(mState != State::kIdle && stageCompleted < kStageCount);
+
+    mPipeline->mStageStatistics[stageCompleted].Record(ElapsedSince(mStageStart), error);
+    mStageStart = System::SystemClock().GetMonotonicTimestamp();
+
+    // The commissioner reports every stage here before asking the lane for the next one.
+    if (mState == State::kCASE && IsCASEStage(stageCompleted))
+    {
+        ReleaseHandshake();
+    }
+}
+
+void CommissioningPipeline::Lane::OnCommissioningSuccess(PeerId peerId)
+{
+    Finish(CHIP_NO_ERROR, CommissioningStage::kError);
+}
+
+void CommissioningPipeline::Lane::OnCommissioningFailure(PeerId peerId, CHIP_ERROR error, CommissioningStage stageFailed,
+                                                         Optional<Credentials::AttestationVerificationResult> additionalErrorInfo)
+{
+    Finish(error, stageFailed);
+}
+
+CHIP_ERROR CommissioningPipeline::Init(System::Layer * systemLayer, Span<Lane * const> lanes, uint8_t maxConcurrentHandshakes)
+{
+    VerifyOrReturnError(mSystemLayer == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(systemLayer != nullptr && !lanes.empty() && maxConcurrentHandshakes > 0, CHIP_ERROR_INVALID_ARGUMENT);
+    for (auto * lane : lanes)
+    {
+        VerifyOrReturnError(lane != nullptr && lane->IsIdle() && lane->mPipeline == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    for (size_t i = 0; i < lanes.size(); i++)
+    {
+        CHIP_ERROR err = lanes[i]->Attach();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Controller, "Commissioning pipeline: lane %u is not the defaultCommissioner of a DeviceCommissioner",
+                         static_cast<unsigned>(i));
+            while (i-- > 0)
+            {
+                lanes[i]->Detach();
+                lanes[i]->mPipeline = nullptr;
+            }
+            return err;
+        }
+        lanes[i]->mPipeline = this;
+    }
+
+    mSystemLayer             = systemLayer;
+    mLanes                   = lanes;
+    mMaxConcurrentHandshakes = maxConcurrentHandshakes;
+    mHandshakesInProgress    = 0;
+    return CHIP_NO_ERROR;
+}
+
+void CommissioningPipeline::Shutdown()
+{
+    VerifyOrReturn(mSystemLayer != nullptr);
+    mSystemLayer->CancelTimer(StartNextCommissionees, this);
+
+    Delegate * delegate = mDelegate;
+    mDelegate           = nullptr;
+
+    // Detach each lane first, so that stopping its commissionee does not call back into the pipeline.
+    for (auto * lane : mLanes)
+    {
+        lane->Detach();
+        lane->mPipeline = nullptr;
+        if (lane->IsIdle())
+        {
+            continue;
+        }
+
+        const Commissionee * commissionee = lane->mCommissionee;
+        const CommissioningStage stage    = lane->CurrentStage();
+        const bool started                = lane->mState != Lane::State::kWaitingForPASE;
+        lane->mState                      = Lane::State::kIdle;
+        lane->mStage                      = CommissioningStage::kError;
+        lane->mCommissionee               = nullptr;
+        if (started)
+        {
+            lane->StopCommissionee(commissionee->nodeId);
+        }
+        if (delegate != nullptr)
+        {
+            delegate->OnCommissioneeDone(*commissionee, CHIP_ERROR_CANCELLED, stage);
+        }
+    }
+
+    mSystemLayer          = nullptr;
+    mLanes                = Span<Lane * const>();
+    mHandshakesInProgress = 0;
+    mCommissionees        = Span<const Commissionee>();
+    mNextCommissionee     = 0;
+
+    if (delegate != nullptr)
+    {
+        delegate->OnPipelineDone();
+    }
+}
+
+CHIP_ERROR CommissioningPipeline::Commission(Span<const Commissionee> commissionees, Delegate * delegate)
+{
+    VerifyOrReturnError(mSystemLayer != nullptr && !IsRunning(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(delegate != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mDelegate         = delegate;
+    mCommissionees    = commissionees;
+    mNextCommissionee = 0;
+    return mSystemLayer->ScheduleWork(StartNextCommissionees, this);
+}
+
+void CommissioningPipeline::StartNextCommissionees(System::Layer * systemLayer, void * context)
+{
+    auto * self = static_cast<CommissioningPipeline *>(context);
+    VerifyOrReturn(self->IsRunning());
+
+    for (auto * lane : self->mLanes)
+    {
+        if (lane->IsIdle() && self->mNextCommissionee < self->mCommissionees.size())
+        {
+            lane->Start(self->mCommissionees[self->mNextCommissionee++]);
+        }
+    }
+    self->GrantHandshakes();
+
+    bool allIdle = true;
+    for (auto * lane : self->mLanes)
+    {
+        allIdle = allIdle && lane->IsIdle();
+    }
+    if (allIdle && self->mNextCommissionee == self->mCommissionees.size())
+    {
+        Delegate * delegate  = self->mDelegate;
+        self->mDelegate      = nullptr;
+        self->mCommissionees = Span<const Commissionee>();
+        delegate->OnPipelineDone();
+    }
+}
+
+void CommissioningPipeline::GrantHandshakes()
+{
+    // A lane holding back a CASE stage has no stage running on its commissioner, so it is not told when the commissionee
+    // is stopped through the commissioner (which just releases the commissionee's device). Check before granting it.
+    for (auto * lane : mLanes)
+    {
+        if (lane->mState == Lane::State::kWaitingForCASE && !lane->HasCommissioneeDevice(lane->mCommissionee->nodeId))
+        {
+            ChipLogError(Controller, "Commissioning pipeline: node ID 0x" ChipLogFormatX64 " was stopped while waiting for CASE",
+                         ChipLogValueX64(lane->mCommissionee->nodeId));
+            lane->Finish(CHIP_ERROR_CANCELLED, lane->mStage);
+        }
+    }
+
+    // Lanes waiting for CASE go first: they have an armed fail-safe that keeps running while they wait.
+    for (auto waitingState : { Lane::State::kWaitingForCASE, Lane::State::kWaitingForPASE })
+    {
+        for (auto * lane : mLanes)
+        {
+            VerifyOrReturn(mHandshakesInProgress < mMaxConcurrentHandshakes);
+            if (lane->mState == waitingState)
+            {
+                mHandshakesInProgress++;
+                lane->OnHandshakeGranted();
+            }
+        }
+    }
+}
+
+void CommissioningPipeline::OnLaneDone(Lane & lane, CHIP_ERROR err, CommissioningStage failedStage)
+{
+    ChipLogProgress(Controller, "Commissioning pipeline: node ID 0x" ChipLogFormatX64 " done: %" CHIP_ERROR_FORMAT,
+                    ChipLogValueX64(lane.mCommissionee->nodeId), err.Format());
+
+    const Commissionee * commissionee = lane.mCommissionee;
+    lane.mCommissionee                = nullptr;
+    if (mDelegate != nullptr)
+    {
+        mDelegate->OnCommissioneeDone(*commissionee, err, failedStage);
+    }
+
+    // Start the next commissionee once the commissioner of this lane has unwound.
+    LogErrorOnFailure(mSystemLayer->ScheduleWork(StartNextCommissionees, this));
+}
+
+const CommissioningPipeline::StageStatistics & CommissioningPipeline::GetStageStatistics(CommissioningStage stage) const
+{
+    return mStageStatistics[(stage < kStageCount) ? stage : CommissioningStage::kError];
+}
+
+void CommissioningPipeline::ResetStatistics()
+{
+    for (auto & statistics : mStageStatistics)
+    {
+        statistics = StageStatistics();
+    }
+    mHandshakeWaitStatistics = StageStatistics();
+}
+
+void CommissioningPipeline::LogStatistics() const
+{
+    auto log = [](const char * name, const StageStatistics & statistics) {
+        VerifyOrReturn(statistics.count > 0);
+        ChipLogProgress(Controller, "%-40s count %" PRIu32 " failures %" PRIu32 " mean %" PRIu64 " ms max %" PRIu64 " ms", name,
+                        statistics.count, statistics.failures, statistics.total.count() / statistics.count,
+                        statistics.max.count());
+    };
+
+    ChipLogProgress(Controller, "Commissioning pipeline stage latency:");
+    for (size_t stage = 0; stage < kStageCount; stage++)
+    {
+        log(StageToString(static_cast<CommissioningStage>(stage)), mStageStatistics[stage]);
+    }
+    log("Handshake wait", mHandshakeWaitStatistics);
+}
+
+} // namespace Controller
+} // namespace chip
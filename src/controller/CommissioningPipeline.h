@@ -0,0 +1,218 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <controller/AutoCommissioner.h>
+#include <controller/CHIPDeviceController.h>
+#include <controller/CommissioningDelegate.h>
+#include <controller/DevicePairingDelegate.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/NodeId.h>
+#include <lib/support/Span.h>
+#include <protocols/secure_channel/RendezvousParameters.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace Controller {
+
+/**
+ * Commissions a list of devices concurrently.
+ *
+ * A DeviceCommissioner drives a single commissionee at a time, and most of the time spent commissioning a device over IP
+ * is spent waiting for network round-trips. The pipeline runs several commissionees side by side, one per lane. Each lane
+ * is a DeviceCommissioner of its own, with its own stage machine and CommissioningParameters, on the same fabric as the
+ * other lanes (see SetupParams::permitMultiControllerFabrics).
+ *
+ * The number of PASE and CASE handshakes in flight across all lanes is bounded, so that a large pipeline does not
+ * overwhelm the commissionees' networks or the commissioner's CPU. Commissionees waiting to start PASE queue behind
+ * commissionees waiting for CASE, which already have an armed fail-safe.
+ *
+ * The latency of every commissioning stage is recorded, see GetStageStatistics() and LogStatistics().
+ *
+ * Usage:
+ *  - Each lane must be set as the defaultCommissioner of the DeviceCommissioner it is attached to, and that
+ *    DeviceCommissioner must not be used for anything else while the pipeline runs. Init() checks the former.
+ *  - A commissionee stopped through its DeviceCommissioner (StopPairing, Shutdown) is reported as failed with
+ *    CHIP_ERROR_CANCELLED, at the latest when its lane would have been granted a handshake slot.
+ *  - All methods must be called from the Matter event loop.
+ */
+class CommissioningPipeline
+{
+public:
+    struct Commissionee
+    {
+        /// Node ID to assign to the commissionee.
+        NodeId nodeId = kUndefinedNodeId;
+        /// Onboarding payload (QR code or manual pairing code). When null, rendezvousParameters are used instead.
+        const char * setUpCode = nullptr;
+        RendezvousParameters rendezvousParameters;
+        /// Buffers referenced by the parameters must stay valid until the commissionee is done.
+        CommissioningParameters parameters;
+    };
+
+    struct StageStatistics
+    {
+        uint32_t count    = 0;
+        uint32_t failures = 0;
+        System::Clock::Milliseconds64 total{ 0 };
+        System::Clock::Milliseconds64 max{ 0 };
+
+        void Record(System::Clock::Milliseconds64 duration, CHIP_ERROR err);
+    };
+
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /**
+         * Called when a commissionee is done, with the stage that failed if error is not CHIP_NO_ERROR.
+         */
+        virtual void OnCommissioneeDone(const Commissionee & commissionee, CHIP_ERROR error, CommissioningStage failedStage) {}
+
+        /**
+         * Called when every commissionee passed to Commission() is done.
+         */
+        virtual void OnPipelineDone() {}
+    };
+
+    class Lane : public AutoCommissioner, public DevicePairingDelegate
+    {
+    public:
+        void SetDeviceCommissioner(DeviceCommissioner * commissioner) { mDeviceCommissioner = commissioner; }
+        bool IsIdle() const { return mState == State::kIdle; }
+
+        // DevicePairingDelegate overrides
+        void OnPairingComplete(CHIP_ERROR error) override;
+        void OnCommissioningStatusUpdate(PeerId peerId, CommissioningStage stageCompleted, CHIP_ERROR error) override;
+        void OnCommissioningSuccess(PeerId peerId) override;
+        void OnCommissioningFailure(PeerId peerId, CHIP_ERROR error, CommissioningStage stageFailed,
+                                    Optional<Credentials::AttestationVerificationResult> additionalErrorInfo) override;
+
+    protected:
+        // AutoCommissioner overrides
+        CHIP_ERROR PerformStep(CommissioningStage nextStage) override;
+
+        // Operations on the DeviceCommissioner of the lane, overridden by tests to run lanes without one.
+        virtual CHIP_ERROR Attach();
+        virtual void Detach();
+        virtual CHIP_ERROR PairCommissionee(const Commissionee & commissionee);
+        virtual void StopCommissionee(NodeId nodeId);
+        virtual bool HasCommissioneeDevice(NodeId nodeId);
+        virtual CHIP_ERROR PerformHeldStep(CommissioningStage stage) { return AutoCommissioner::PerformStep(stage); }
+
+    private:
+        friend class CommissioningPipeline;
+
+        enum class State : uint8_t
+        {
+            kIdle,
+            kWaitingForPASE, ///< Waiting for a handshake slot to start PASE
+            kPASE,           ///< Establishing PASE, holding a handshake slot
+            kCommissioning,  ///< Running commissioning stages that do not need a handshake
+            kWaitingForCASE, ///< Waiting for a handshake slot to run mStage
+            kCASE,           ///< Running a kFindOperational* stage, holding a handshake slot
+        };
+
+        static bool IsCASEStage(CommissioningStage stage)
+        {
+            return stage == CommissioningStage::kFindOperationalForStayActive ||
+                   stage == CommissioningStage::kFindOperationalForCommissioningComplete;
+        }
+
+        void Start(const Commissionee & commissionee);
+        void OnHandshakeGranted();
+        void ReleaseHandshake();
+        void Finish(CHIP_ERROR err, CommissioningStage failedStage);
+        CommissioningStage CurrentStage() const;
+
+        CommissioningPipeline * mPipeline        = nullptr;
+        DeviceCommissioner * mDeviceCommissioner = nullptr;
+        const Commissionee * mCommissionee       = nullptr;
+        State mState                             = State::kIdle;
+        CommissioningStage mStage                = CommissioningStage::kError; ///< Stage being run, or held for a slot
+        System::Clock::Timestamp mStageStart     = System::Clock::kZero;
+    };
+
+    /**
+     * Initialize the pipeline.
+     *
+     * @param systemLayer             Used to start the next commissionee of a lane outside of the callbacks of the
+     *                                previous one.
+     * @param lanes                   Lanes, each attached to a DeviceCommissioner whose defaultCommissioner it is.
+     * @param maxConcurrentHandshakes Maximum number of PASE and CASE handshakes in flight at once.
+     *
+     * @return CHIP_ERROR_INVALID_ARGUMENT if a lane is not attached to a DeviceCommissioner, or is not its
+     *         defaultCommissioner.
+     */
+    CHIP_ERROR Init(System::Layer * systemLayer, Span<Lane * const> lanes, uint8_t maxConcurrentHandshakes);
+
+    /**
+     * Stop the commissionees in progress, if any, and report them as failed with CHIP_ERROR_CANCELLED, followed by
+     * Delegate::OnPipelineDone. Commissionees that were not started yet are not reported.
+     */
+    void Shutdown();
+
+    /**
+     * Commission the given devices, in order, using all the lanes. The commissionees must stay valid until
+     * Delegate::OnPipelineDone is called.
+     *
+     * @return CHIP_ERROR_INCORRECT_STATE if the pipeline is not initialized or is still running.
+     */
+    CHIP_ERROR Commission(Span<const Commissionee> commissionees, Delegate * delegate);
+
+    bool IsRunning() const { return mDelegate != nullptr; }
+
+    /**
+     * Latency statistics for a commissioning stage, accumulated across runs. The kSecurePairing entry covers
+     * discovery and PASE establishment.
+     */
+    const StageStatistics & GetStageStatistics(CommissioningStage stage) const;
+
+    /**
+     * Time commissionees spent waiting for a handshake slot, accumulated across runs.
+     */
+    const StageStatistics & GetHandshakeWaitStatistics() const { return mHandshakeWaitStatistics; }
+
+    void ResetStatistics();
+    void LogStatistics() const;
+
+private:
+    // CommissioningStage values are contiguous, starting at kError.
+    static constexpr size_t kStageCount = to_underlying(CommissioningStage::kRemoveThreadNetworkConfig) + 1;
+
+    static void StartNextCommissionees(System::Layer * systemLayer, void * context);
+
+    void GrantHandshakes();
+    void OnLaneDone(Lane & lane, CHIP_ERROR err, CommissioningStage failedStage);
+
+    System::Layer * mSystemLayer     = nullptr;
+    uint8_t mMaxConcurrentHandshakes = 0;
+    uint8_t mHandshakesInProgress    = 0;
+    Delegate * mDelegate             = nullptr;
+    size_t mNextCommissionee         = 0;
+    Span<Lane * const> mLanes;
+    Span<const Commissionee> mCommissionees;
+
+    StageStatistics mStageStatistics[kStageCount];
+    StageStatistics mHandshakeWaitStatistics;
+};
+
+} // namespace Controller
+} // namespace chip
@@ -0,0 +1,318 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <controller/CommissioningPipeline.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CodeUtils.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::Controller;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+constexpr CommissioningStage kCASEStage = CommissioningStage::kFindOperationalForStayActive;
+
+// A lane without a DeviceCommissioner: the tests play the commissioner's part by calling the DevicePairingDelegate and
+// PerformStep() entry points of the lane, as the commissioner would.
+class FakeLane : public CommissioningPipeline::Lane
+{
+public:
+    using CommissioningPipeline::Lane::PerformStep;
+
+    CHIP_ERROR attachError   = CHIP_NO_ERROR;
+    CHIP_ERROR pairError     = CHIP_NO_ERROR;
+    CHIP_ERROR heldStepError = CHIP_NO_ERROR;
+    bool hasDevice           = true;
+
+    unsigned detachCount = 0;
+    std::vector<NodeId> paired;
+    std::vector<NodeId> stopped;
+    std::vector<CommissioningStage> heldSteps;
+
+protected:
+    CHIP_ERROR Attach() override { return attachError; }
+    void Detach() override { detachCount++; }
+
+    CHIP_ERROR PairCommissionee(const CommissioningPipeline::Commissionee & commissionee) override
+    {
+        paired.push_back(commissionee.nodeId);
+        return pairError;
+    }
+
+    void StopCommissionee(NodeId nodeId) override { stopped.push_back(nodeId); }
+    bool HasCommissioneeDevice(NodeId nodeId) override { return hasDevice; }
+
+    CHIP_ERROR PerformHeldStep(CommissioningStage stage) override
+    {
+        heldSteps.push_back(stage);
+        return heldStepError;
+    }
+};
+
+class RecordingDelegate : public CommissioningPipeline::Delegate
+{
+public:
+    struct Result
+    {
+        NodeId nodeId;
+        CHIP_ERROR error;
+        CommissioningStage failedStage;
+    };
+
+    void OnCommissioneeDone(const CommissioningPipeline::Commissionee & commissionee, CHIP_ERROR error,
+                            CommissioningStage failedStage) override
+    {
+        results.push_back({ commissionee.nodeId, error, failedStage });
+    }
+
+    void OnPipelineDone() override { pipelineDoneCount++; }
+
+    const Result * Find(NodeId nodeId) const
+    {
+        for (const auto & result : results)
+        {
+            if (result.nodeId == nodeId)
+            {
+                return &result;
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<Result> results;
+    unsigned pipelineDoneCount = 0;
+};
+
+class TestCommissioningPipeline : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(sIOContext.Init(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { sIOContext.Shutdown(); }
+
+    void TearDown() override { mPipeline.Shutdown(); }
+
+protected:
+    CHIP_ERROR Init(uint8_t maxConcurrentHandshakes)
+    {
+        return mPipeline.Init(&sIOContext.GetSystemLayer(), Span<CommissioningPipeline::Lane * const>(mLanes),
+                              maxConcurrentHandshakes);
+    }
+
+    void Commission(size_t count)
+    {
+        ASSERT_LE(count, ArraySize(mCommissionees));
+        for (size_t i = 0; i < count; i++)
+        {
+            mCommissionees[i].nodeId = 0x100 + i;
+        }
+        ASSERT_EQ(mPipeline.Commission(Span<const CommissioningPipeline::Commissionee>(mCommissionees, count), &mDelegate),
+                  CHIP_NO_ERROR);
+        // Commissionees are started from the event loop.
+        DriveIO();
+    }
+
+    void DriveIO() { sIOContext.DriveIO(); }
+
+    void DriveIOUntilPipelineDone()
+    {
+        sIOContext.DriveIOUntil(1000_ms, [this]() { return mDelegate.pipelineDoneCount > 0; });
+    }
+
+    static chip::Test::IOContext sIOContext;
+
+    FakeLane mFakeLanes[3];
+    CommissioningPipeline::Lane * const mLanes[3] = { &mFakeLanes[0], &mFakeLanes[1], &mFakeLanes[2] };
+    CommissioningPipeline::Commissionee mCommissionees[5];
+    RecordingDelegate mDelegate;
+    CommissioningPipeline mPipeline;
+};
+
+chip::Test::IOContext TestCommissioningPipeline::sIOContext;
+
+TEST_F(TestCommissioningPipeline, InitFailsWhenALaneCannotAttach)
+{
+    mFakeLanes[1].attachError = CHIP_ERROR_INVALID_ARGUMENT;
+    EXPECT_EQ(Init(1), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The lane attached before the failing one is detached again, and the pipeline can be initialized afterwards.
+    EXPECT_EQ(mFakeLanes[0].detachCount, 1u);
+    EXPECT_EQ(mFakeLanes[2].detachCount, 0u);
+    EXPECT_EQ(mPipeline.Commission(Span<const CommissioningPipeline::Commissionee>(), &mDelegate), CHIP_ERROR_INCORRECT_STATE);
+
+    mFakeLanes[1].attachError = CHIP_NO_ERROR;
+    EXPECT_EQ(Init(1), CHIP_NO_ERROR);
+}
+
+TEST_F(TestCommissioningPipeline, HandshakesAreLimitedAndCASEGoesFirst)
+{
+    ASSERT_EQ(Init(1), CHIP_NO_ERROR);
+    Commission(3);
+
+    // A single PASE handshake at a time.
+    EXPECT_TRUE(mFakeLanes[0].paired == std::vector<NodeId>{ 0x100 });
+    EXPECT_TRUE(mFakeLanes[1].paired.empty());
+    EXPECT_TRUE(mFakeLanes[2].paired.empty());
+
+    mFakeLanes[0].OnPairingComplete(CHIP_NO_ERROR);
+    EXPECT_TRUE(mFakeLanes[1].paired == std::vector<NodeId>{ 0x101 });
+    EXPECT_TRUE(mFakeLanes[2].paired.empty());
+
+    // The first lane's CASE stage is held while the second lane runs PASE.
+    EXPECT_EQ(mFakeLanes[0].PerformStep(kCASEStage), CHIP_NO_ERROR);
+    EXPECT_TRUE(mFakeLanes[0].heldSteps.empty());
+
+    // Once PASE is done, the held CASE stage gets the slot ahead of the third lane's PASE.
+    mFakeLanes[1].OnPairingComplete(CHIP_NO_ERROR);
+    EXPECT_TRUE(mFakeLanes[0].heldSteps == std::vector<CommissioningStage>{ kCASEStage });
+    EXPECT_TRUE(mFakeLanes[2].paired.empty());
+
+    // The slot is released when the commissioner reports the CASE stage.
+    mFakeLanes[0].OnCommissioningStatusUpdate(PeerId(), kCASEStage, CHIP_NO_ERROR);
+    EXPECT_TRUE(mFakeLanes[2].paired == std::vector<NodeId>{ 0x102 });
+
+    mFakeLanes[0].OnCommissioningSuccess(PeerId());
+    mFakeLanes[1].OnCommissioningFailure(PeerId(), CHIP_ERROR_TIMEOUT, CommissioningStage::kSendNOC, NullOptional);
+    mFakeLanes[2].OnPairingComplete(CHIP_ERROR_INTERNAL);
+    DriveIOUntilPipelineDone();
+
+    ASSERT_EQ(mDelegate.results.size(), 3u);
+    EXPECT_EQ(mDelegate.Find(0x100)->error, CHIP_NO_ERROR);
+    EXPECT_EQ(mDelegate.Find(0x101)->error, CHIP_ERROR_TIMEOUT);
+    EXPECT_EQ(mDelegate.Find(0x101)->failedStage, CommissioningStage::kSendNOC);
+    EXPECT_EQ(mDelegate.Find(0x102)->error, CHIP_ERROR_INTERNAL);
+    EXPECT_EQ(mDelegate.Find(0x102)->failedStage, CommissioningStage::kSecurePairing);
+    EXPECT_EQ(mDelegate.pipelineDoneCount, 1u);
+    EXPECT_FALSE(mPipeline.IsRunning());
+
+    EXPECT_EQ(mPipeline.GetStageStatistics(CommissioningStage::kSecurePairing).count, 3u);
+    EXPECT_EQ(mPipeline.GetStageStatistics(CommissioningStage::kSecurePairing).failures, 1u);
+    EXPECT_EQ(mPipeline.GetStageStatistics(kCASEStage).count, 1u);
+}
+
+TEST_F(TestCommissioningPipeline, LanesTakeTheNextCommissionee)
+{
+    ASSERT_EQ(Init(3), CHIP_NO_ERROR);
+    Commission(5);
+
+    EXPECT_EQ(mFakeLanes[0].paired.size(), 1u);
+    EXPECT_EQ(mFakeLanes[1].paired.size(), 1u);
+    EXPECT_EQ(mFakeLanes[2].paired.size(), 1u);
+
+    // A lane that is done picks up the next commissionee once the event loop runs.
+    mFakeLanes[1].OnPairingComplete(CHIP_ERROR_TIMEOUT);
+    EXPECT_EQ(mFakeLanes[1].paired.size(), 1u);
+    DriveIO();
+    EXPECT_TRUE(mFakeLanes[1].paired == (std::vector<NodeId>{ 0x101, 0x103 }));
+
+    mFakeLanes[1].pairError = CHIP_ERROR_NO_MEMORY;
+    mFakeLanes[1].OnPairingComplete(CHIP_ERROR_TIMEOUT);
+    DriveIO();
+    EXPECT_TRUE(mFakeLanes[1].paired == (std::vector<NodeId>{ 0x101, 0x103, 0x104 }));
+    EXPECT_EQ(mDelegate.Find(0x104)->error, CHIP_ERROR_NO_MEMORY);
+    EXPECT_EQ(mDelegate.pipelineDoneCount, 0u);
+
+    mFakeLanes[0].OnPairingComplete(CHIP_ERROR_TIMEOUT);
+    mFakeLanes[2].OnPairingComplete(CHIP_ERROR_TIMEOUT);
+    DriveIOUntilPipelineDone();
+    EXPECT_EQ(mDelegate.results.size(), 5u);
+    EXPECT_EQ(mDelegate.pipelineDoneCount, 1u);
+}
+
+TEST_F(TestCommissioningPipeline, HeldStepFailure)
+{
+    ASSERT_EQ(Init(1), CHIP_NO_ERROR);
+    Commission(1);
+
+    mFakeLanes[0].heldStepError = CHIP_ERROR_NO_MEMORY;
+    mFakeLanes[0].OnPairingComplete(CHIP_NO_ERROR);
+    EXPECT_EQ(mFakeLanes[0].PerformStep(kCASEStage), CHIP_NO_ERROR);
+
+    // The slot was free, so the stage ran right away, failed, and the commissionee was stopped.
+    EXPECT_TRUE(mFakeLanes[0].heldSteps == std::vector<CommissioningStage>{ kCASEStage });
+    EXPECT_TRUE(mFakeLanes[0].stopped == std::vector<NodeId>{ 0x100 });
+    DriveIOUntilPipelineDone();
+    ASSERT_EQ(mDelegate.results.size(), 1u);
+    EXPECT_EQ(mDelegate.results[0].error, CHIP_ERROR_NO_MEMORY);
+    EXPECT_EQ(mDelegate.results[0].failedStage, kCASEStage);
+}
+
+TEST_F(TestCommissioningPipeline, StoppedWhileWaitingForCASE)
+{
+    ASSERT_EQ(Init(1), CHIP_NO_ERROR);
+    Commission(2);
+
+    mFakeLanes[0].OnPairingComplete(CHIP_NO_ERROR);
+    EXPECT_EQ(mFakeLanes[0].PerformStep(kCASEStage), CHIP_NO_ERROR);
+
+    // The commissionee is stopped through its commissioner, which releases its device without telling the lane.
+    mFakeLanes[0].hasDevice = false;
+    mFakeLanes[1].OnPairingComplete(CHIP_NO_ERROR);
+
+    EXPECT_TRUE(mFakeLanes[0].heldSteps.empty());
+    ASSERT_EQ(mDelegate.results.size(), 1u);
+    EXPECT_EQ(mDelegate.results[0].nodeId, 0x100u);
+    EXPECT_EQ(mDelegate.results[0].error, CHIP_ERROR_CANCELLED);
+    EXPECT_EQ(mDelegate.results[0].failedStage, kCASEStage);
+
+    mFakeLanes[1].OnCommissioningSuccess(PeerId());
+    DriveIOUntilPipelineDone();
+    EXPECT_EQ(mDelegate.results.size(), 2u);
+    EXPECT_EQ(mDelegate.pipelineDoneCount, 1u);
+}
+
+TEST_F(TestCommissioningPipeline, ShutdownCancelsCommissionees)
+{
+    ASSERT_EQ(Init(1), CHIP_NO_ERROR);
+    Commission(5);
+
+    // The first lane runs PASE, the others wait for a slot.
+    mPipeline.Shutdown();
+
+    for (auto & lane : mFakeLanes)
+    {
+        EXPECT_EQ(lane.detachCount, 1u);
+    }
+    EXPECT_TRUE(mFakeLanes[0].stopped == std::vector<NodeId>{ 0x100 });
+    EXPECT_TRUE(mFakeLanes[1].stopped.empty());
+    EXPECT_TRUE(mFakeLanes[2].stopped.empty());
+
+    // Only started commissionees are reported.
+    ASSERT_EQ(mDelegate.results.size(), 3u);
+    for (const auto & result : mDelegate.results)
+    {
+        EXPECT_EQ(result.error, CHIP_ERROR_CANCELLED);
+        EXPECT_EQ(result.failedStage, CommissioningStage::kSecurePairing);
+    }
+    EXPECT_EQ(mDelegate.pipelineDoneCount, 1u);
+    EXPECT_FALSE(mPipeline.IsRunning());
+
+    // Late callbacks from the commissioner are ignored.
+    mFakeLanes[0].OnPairingComplete(CHIP_NO_ERROR);
+    DriveIO();
+    EXPECT_EQ(mDelegate.results.size(), 3u);
+    EXPECT_EQ(mDelegate.pipelineDoneCount, 1u);
+}
+
+} // namespace
@@ -531,6 +531,12 @@ ActionReturnStatus CustomDataModel::Invoke(const InvokeRequest & request, chip::
     return CHIP_ERROR_NOT_IMPLEMENTED;
 }
 
+CHIP_ERROR CustomDataModel::Shutdown()
+{
+    // The codegen provider answers the metadata queries, so it holds whatever they cached
+    return CodegenDataModelProviderInstance()->Shutdown();
+}
+
 EndpointId CustomDataModel::FirstEndpoint()
 {
     return CodegenDataModelProviderInstance()->FirstEndpoint();
@@ -113,7 +113,7 @@ class CustomDataModel : public DataModel::Provider
 public:
     static CustomDataModel & Instance();
 
-    CHIP_ERROR Shutdown() override { return CHIP_NO_ERROR; }
+    CHIP_ERROR Shutdown() override;
 
     DataModel::ActionReturnStatus ReadAttribute(const DataModel::ReadAttributeRequest & request,
                                                 AttributeValueEncoder & encoder) override;
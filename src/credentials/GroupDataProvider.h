@@ -312,6 +312,33 @@ public:
     virtual GroupSessionIterator * IterateGroupSessions(uint16_t session_id)                        = 0;
     virtual Crypto::SymmetricKeyContext * GetKeyContext(FabricIndex fabric_index, GroupId group_id) = 0;
 
+    /**
+     *  Returns a key context for the operational key of the given group whose session ID (key hash) is
+     *  session_id, or nullptr if there is none. Unlike the ones produced by IterateGroupSessions(), the
+     *  context remains valid after the iteration is over; Release() must be called on it when done.
+     *
+     *  The default implementation returns nullptr, which disables group key hints in SessionManager.
+     */
+    virtual Crypto::SymmetricKeyContext * GetKeyContextForSession(FabricIndex fabric_index, GroupId group_id,
+                                                                  uint16_t session_id)
+    {
+        return nullptr;
+    }
+
+    /**
+     *  Returns a value that changes every time operational group keys, or their mapping to groups, may
+     *  have changed. Holders of key contexts obtained from GetKeyContextForSession() use it to know when
+     *  those are stale.
+     */
+    uint32_t GetKeysGeneration() const { return mKeysGeneration; }
+
+    /**
+     *  Returns a value that changes every time the provider releases all the key contexts it handed out,
+     *  e.g. in Finish(). Holders of key contexts obtained from GetKeyContextForSession() must then drop
+     *  them without releasing them.
+     */
+    uint32_t GetKeyContextsGeneration() const { return mKeyContextsGeneration; }
+
     // Listener
     void SetListener(GroupListener * listener) { mListener = listener; };
     void RemoveListener() { mListener = nullptr; };
@@ -331,9 +358,14 @@ protected:
             mListener->OnGroupRemoved(fabric_index, old_group);
         }
     }
+    void KeysChanged() { mKeysGeneration++; }
+    void KeyContextsReleased() { mKeyContextsGeneration++; }
+
     const uint16_t mMaxGroupsPerFabric;
     const uint16_t mMaxGroupKeysPerFabric;
-    GroupListener * mListener = nullptr;
+    GroupListener * mListener       = nullptr;
+    uint32_t mKeysGeneration        = 0;
+    uint32_t mKeyContextsGeneration = 0;
 };
 
 /**
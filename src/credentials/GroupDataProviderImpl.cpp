@@ -832,6 +832,7 @@ void GroupDataProviderImpl::Finish()
     mKeySetIterators.ReleaseAll();
     mGroupSessionsIterator.ReleaseAll();
     mGroupKeyContexPool.ReleaseAll();
+    KeyContextsReleased();
 }
 
 void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage)
@@ -1349,6 +1350,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    KeysChanged();
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1415,6 +1417,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    KeysChanged();
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1447,6 +1450,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    KeysChanged();
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1523,6 +1527,7 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
                                             const KeySet & in_keyset)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    KeysChanged();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1594,6 +1599,7 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    KeysChanged();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1695,6 +1701,8 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
+    KeysChanged();
+
     FabricData fabric(fabric_index);
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
@@ -1769,6 +1777,35 @@ Crypto::SymmetricKeyContext * GroupDataProviderImpl::GetKeyContext(FabricIndex f
     return nullptr;
 }
 
+Crypto::SymmetricKeyContext * GroupDataProviderImpl::GetKeyContextForSession(FabricIndex fabric_index, GroupId group_id,
+                                                                           uint16_t session_id)
+{
+    FabricData fabric(fabric_index);
+    VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), nullptr);
+
+    KeyMapData mapping(fabric.fabric_index, fabric.first_map);
+
+    // Look for the target group in the fabric's keyset-group pairs
+    for (uint16_t i = 0; i < fabric.map_count; ++i, mapping.id = mapping.next)
+    {
+        VerifyOrReturnError(CHIP_NO_ERROR == mapping.Load(mStorage), nullptr);
+        if (mapping.keyset_id > 0 && mapping.group_id == group_id)
+        {
+            KeySetData keyset;
+            VerifyOrReturnError(keyset.Find(mStorage, fabric, mapping.keyset_id), nullptr);
+            for (uint16_t k = 0; k < keyset.keys_count; ++k)
+            {
+                Crypto::GroupOperationalCredentials & creds = keyset.operational_keys[k];
+                if (creds.hash == session_id)
+                {
+                    return mGroupKeyContexPool.CreateObject(*this, creds.encryption_key, creds.hash, creds.privacy_key);
+                }
+            }
+        }
+    }
+    return nullptr;
+}
+
 CHIP_ERROR GroupDataProviderImpl::GetIpkKeySet(FabricIndex fabric_index, KeySet & out_keyset)
 {
     FabricData fabric(fabric_index);
@@ -1824,6 +1861,13 @@ CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::MessageDecrypt(const ByteSpan
                                    mEncryptionKey, nonce.data(), nonce.size(), output);
 }
 
+CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::MessageDecryptInPlace(MutableByteSpan & message, const ByteSpan & aad,
+                                                                         const ByteSpan & nonce, const ByteSpan & mic) const
+{
+    return Crypto::AES_CCM_decrypt_in_place(message.data(), message.size(), aad.data(), aad.size(), mic.data(), mic.size(),
+                                            mEncryptionKey, nonce.data(), nonce.size());
+}
+
 CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::PrivacyEncrypt(const ByteSpan & input, const ByteSpan & nonce,
                                                                   MutableByteSpan & output) const
 {
@@ -95,6 +95,8 @@ public:
 
     // Decryption
     Crypto::SymmetricKeyContext * GetKeyContext(FabricIndex fabric_index, GroupId group_id) override;
+    Crypto::SymmetricKeyContext * GetKeyContextForSession(FabricIndex fabric_index, GroupId group_id,
+                                                          uint16_t session_id) override;
     GroupSessionIterator * IterateGroupSessions(uint16_t session_id) override;
 
 protected:
@@ -193,6 +195,8 @@ protected:
                                   MutableByteSpan & ciphertext) const override;
         CHIP_ERROR MessageDecrypt(const ByteSpan & ciphertext, const ByteSpan & aad, const ByteSpan & nonce, const ByteSpan & mic,
                                   MutableByteSpan & plaintext) const override;
+        CHIP_ERROR MessageDecryptInPlace(MutableByteSpan & message, const ByteSpan & aad, const ByteSpan & nonce,
+                                         const ByteSpan & mic) const override;
         CHIP_ERROR PrivacyEncrypt(const ByteSpan & input, const ByteSpan & nonce, MutableByteSpan & output) const override;
         CHIP_ERROR PrivacyDecrypt(const ByteSpan & input, const ByteSpan & nonce, MutableByteSpan & output) const override;
 
@@ -253,7 +257,8 @@ protected:
     ObjectPool<EndpointIteratorImpl, kIteratorsMax> mEndpointIterators;
     ObjectPool<KeySetIteratorImpl, kIteratorsMax> mKeySetIterators;
     ObjectPool<GroupSessionIteratorImpl, kIteratorsMax> mGroupSessionsIterator;
-    ObjectPool<GroupKeyContext, kIteratorsMax> mGroupKeyContexPool;
+    // Group key hints in SessionManager hold on to up to CHIP_CONFIG_GROUP_KEY_HINT_CACHE_SIZE contexts.
+    ObjectPool<GroupKeyContext, kIteratorsMax + CHIP_CONFIG_GROUP_KEY_HINT_CACHE_SIZE> mGroupKeyContexPool;
 };
 
 } // namespace Credentials
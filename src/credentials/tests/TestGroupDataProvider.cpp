@@ -1222,6 +1222,52 @@ TEST_F(TestGroupDataProvider, TestGroupDecryption)
     it->Release();
 }
 
+TEST_F(TestGroupDataProvider, TestKeyContextForSession)
+{
+    GroupDataProvider * provider = GetGroupDataProvider();
+    EXPECT_TRUE(provider);
+
+    // Reset test
+    ResetProvider(provider);
+
+    EXPECT_EQ(provider->SetGroupInfoAt(kFabric2, 0, kGroupInfo2_2), CHIP_NO_ERROR);
+
+    uint32_t generation = provider->GetKeysGeneration();
+    EXPECT_EQ(provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1), CHIP_NO_ERROR);
+    EXPECT_NE(provider->GetKeysGeneration(), generation);
+
+    generation = provider->GetKeysGeneration();
+    EXPECT_EQ(provider->SetGroupKeyAt(kFabric2, 0, kGroup2Keyset1), CHIP_NO_ERROR);
+    EXPECT_NE(provider->GetKeysGeneration(), generation);
+
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(kFabric2, kGroup2);
+    ASSERT_NE(nullptr, key_context);
+    uint16_t session_id = key_context->GetKeyHash();
+    key_context->Release();
+
+    // The key context is standalone: it outlives any iterator and must be released by the caller
+    key_context = provider->GetKeyContextForSession(kFabric2, kGroup2, session_id);
+    ASSERT_NE(nullptr, key_context);
+    EXPECT_EQ(session_id, key_context->GetKeyHash());
+    key_context->Release();
+
+    // Unknown session, group, or fabric
+    EXPECT_EQ(nullptr, provider->GetKeyContextForSession(kFabric2, kGroup2, static_cast<uint16_t>(session_id + 1)));
+    EXPECT_EQ(nullptr, provider->GetKeyContextForSession(kFabric2, kGroup3, session_id));
+    EXPECT_EQ(nullptr, provider->GetKeyContextForSession(kFabric1, kGroup2, session_id));
+
+    generation = provider->GetKeysGeneration();
+    EXPECT_EQ(provider->RemoveKeySet(kFabric2, kKeySet1.keyset_id), CHIP_NO_ERROR);
+    EXPECT_NE(provider->GetKeysGeneration(), generation);
+    EXPECT_EQ(nullptr, provider->GetKeyContextForSession(kFabric2, kGroup2, session_id));
+
+    // Finish releases the key contexts still handed out, which their holders then drop without releasing them
+    generation = provider->GetKeyContextsGeneration();
+    provider->Finish();
+    EXPECT_NE(provider->GetKeyContextsGeneration(), generation);
+    EXPECT_EQ(provider->Init(), CHIP_NO_ERROR);
+}
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
@@ -785,6 +785,24 @@ CHIP_ERROR AES_CTR_crypt(const uint8_t * input, size_t input_length, const Aes12
     return AES_CCM_encrypt(input, input_length, nullptr, 0, key, nonce, nonce_length, output, tag, kTagLen);
 }
 
+CHIP_ERROR AES_CCM_decrypt_in_place(uint8_t * buffer, size_t buffer_length, const uint8_t * aad, size_t aad_length,
+                                    const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
+                                    size_t nonce_length)
+{
+    VerifyOrReturnError(tag != nullptr && tag_length <= kAES_CCM128_Tag_Length, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The CCM tag authenticates the plaintext, and the CTR keystream that encrypts it depends only on the key and nonce.
+    // So decrypt with AES-CTR, then encrypt the candidate plaintext with AES-CCM, which restores the ciphertext while
+    // computing the tag it should have, and decrypt for good only once that matches.
+    uint8_t expectedTag[kAES_CCM128_Tag_Length];
+    ReturnErrorOnFailure(AES_CTR_crypt(buffer, buffer_length, key, nonce, nonce_length, buffer));
+    ReturnErrorOnFailure(
+        AES_CCM_encrypt(buffer, buffer_length, aad, aad_length, key, nonce, nonce_length, buffer, expectedTag, tag_length));
+    VerifyOrReturnError(IsBufferContentEqualConstantTime(expectedTag, tag, tag_length), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
+    return AES_CTR_crypt(buffer, buffer_length, key, nonce, nonce_length, buffer);
+}
+
 CHIP_ERROR GenerateCompressedFabricId(const Crypto::P256PublicKey & root_public_key, uint64_t fabric_id,
                                       MutableByteSpan & out_compressed_fabric_id)
 {
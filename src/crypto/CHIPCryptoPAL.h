@@ -644,10 +644,18 @@ private:
 
 using Symmetric128BitsKeyByteArray = uint8_t[CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES];
 
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+// The OpenSSL-based PAL keeps the encryption and decryption contexts prepared for a session key after its raw key
+// material (see PrepareAes128KeyContext).
+inline constexpr size_t kSymmetric128BitsKeyHandleContextSize = CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES + 2 * sizeof(void *);
+#else
+inline constexpr size_t kSymmetric128BitsKeyHandleContextSize = CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES;
+#endif
+
 /**
  * @brief Platform-specific 128-bit symmetric key handle
  */
-class Symmetric128BitsKeyHandle : public SymmetricKeyHandle<CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES>
+class Symmetric128BitsKeyHandle : public SymmetricKeyHandle<kSymmetric128BitsKeyHandleContextSize>
 {
 };
 
@@ -786,6 +794,49 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
                            size_t nonce_length, uint8_t * plaintext);
 
+/**
+ * @brief A function that implements AES-CCM decryption in place, verifying the tag before decrypting
+ *
+ * Unlike AES_CCM_decrypt, a buffer that does not match the tag is left as it was, so that decryption can be attempted
+ * again with other keys. This costs two more passes of AES-CTR over the buffer than AES_CCM_decrypt. For an empty
+ * ciphertext, the buffer can be a nullptr, with buffer_length 0.
+ *
+ * @param buffer Ciphertext to decrypt, replaced with the plaintext once verified
+ * @param buffer_length Length of ciphertext
+ * @param aad Additional authentication data
+ * @param aad_length Length of additional authentication data
+ * @param tag Tag to verify
+ * @param tag_length Length of tag
+ * @param key Decryption key
+ * @param nonce Encryption nonce
+ * @param nonce_length Length of encryption nonce
+ * @return Returns CHIP_ERROR_INTEGRITY_CHECK_FAILED if the tag does not match, another CHIP_ERROR on other errors,
+ *         CHIP_NO_ERROR otherwise
+ **/
+CHIP_ERROR AES_CCM_decrypt_in_place(uint8_t * buffer, size_t buffer_length, const uint8_t * aad, size_t aad_length,
+                                    const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
+                                    size_t nonce_length);
+
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+/**
+ * @brief Prepare cipher contexts for an AES key, with the key schedule computed, so that AES_CCM_encrypt and
+ * AES_CCM_decrypt of messages with a CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES nonce and a CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES
+ * tag only set up the nonce, AAD and tag of each message.
+ *
+ * The key material must not change until the contexts are released by ReleaseAes128KeyContext, which
+ * RawKeySessionKeystore::DestroyKey calls. A key with a prepared context must not be used by several threads at once.
+ *
+ * @param key The key, whose previously prepared contexts, if any, are released
+ * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+ **/
+CHIP_ERROR PrepareAes128KeyContext(Aes128KeyHandle & key);
+
+/**
+ * @brief Release the cipher contexts prepared for a key by PrepareAes128KeyContext, if any.
+ **/
+void ReleaseAes128KeyContext(Symmetric128BitsKeyHandle & key);
+#endif // CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+
 /**
  * @brief A function that implements AES-CTR encryption/decryption
  *
@@ -1845,6 +1896,18 @@ public:
     virtual CHIP_ERROR MessageDecrypt(const ByteSpan & ciphertext, const ByteSpan & aad, const ByteSpan & nonce,
                                       const ByteSpan & mic, MutableByteSpan & plaintext) const = 0;
 
+    /**
+     * @brief Perform the message decryption as described in 4.7.3.(Security Processing of Incoming Messages), in place,
+     *        leaving the message as is if it does not match the MIC (see AES_CCM_decrypt_in_place)
+     * @param[in,out] message   Incoming encrypted payload, replaced with the message payload once verified
+     * @param[in] aad           Additional data (message header contents)
+     * @param[in] nonce         Nonce (Security Flags | Message Counter | Source Node ID)
+     * @param[in] mic           Incoming Message Integrity Check
+     * @return CHIP_ERROR
+     */
+    virtual CHIP_ERROR MessageDecryptInPlace(MutableByteSpan & message, const ByteSpan & aad, const ByteSpan & nonce,
+                                             const ByteSpan & mic) const = 0;
+
     /**
      * @brief Perform privacy encoding as described in 4.8.2. (Privacy Processing of Outgoing Messages)
      * @param[in] input         Message header to privacy encrypt
@@ -146,6 +146,91 @@ static int _compareDaysAndSeconds(const int days, const int seconds)
     return 0;
 }
 
+// The context of a 128-bit key handle: the raw key material, followed by the cipher contexts prepared for it by
+// PrepareAes128KeyContext, if any. A BoringSSL AEAD context both seals and opens messages, while an OpenSSL CCM context
+// cannot switch between encryption and decryption without setting up the key again.
+struct Aes128KeyWithContext
+{
+#if CHIP_CRYPTO_BORINGSSL
+    using CipherContext = EVP_AEAD_CTX;
+#else
+    using CipherContext = EVP_CIPHER_CTX;
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    Symmetric128BitsKeyByteArray mKey;
+    CipherContext * mEncryptContext;
+    CipherContext * mDecryptContext;
+};
+
+static_assert(sizeof(Aes128KeyWithContext) <= kSymmetric128BitsKeyHandleContextSize, "Key handle context is too small");
+
+// Returns the cipher context prepared for the key and direction, if any, and if it suits the nonce and tag lengths.
+static Aes128KeyWithContext::CipherContext * _preparedCipherContext(const Aes128KeyHandle & key, bool encrypt,
+                                                                    size_t nonce_length, size_t tag_length)
+{
+    const Aes128KeyWithContext & keyWithContext = key.As<Aes128KeyWithContext>();
+    VerifyOrReturnValue(nonce_length == CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES && tag_length == CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES,
+                        nullptr);
+    return encrypt ? keyWithContext.mEncryptContext : keyWithContext.mDecryptContext;
+}
+
+#if !CHIP_CRYPTO_BORINGSSL
+static EVP_CIPHER_CTX * _newCcmCipherContext(const Symmetric128BitsKeyByteArray & key, int encrypt)
+{
+    EVP_CIPHER_CTX * context = EVP_CIPHER_CTX_new();
+    VerifyOrReturnValue(context != nullptr, nullptr);
+
+    // The nonce and tag lengths go in before the key, from which the key schedule is computed. Each message then only
+    // passes in its nonce.
+    if (EVP_CipherInit_ex(context, EVP_aes_128_ccm(), nullptr, nullptr, nullptr, encrypt) != 1 ||
+        EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES), nullptr) != 1 ||
+        EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES), nullptr) != 1 ||
+        EVP_CipherInit_ex(context, nullptr, nullptr, key, nullptr, encrypt) != 1)
+    {
+        EVP_CIPHER_CTX_free(context);
+        return nullptr;
+    }
+    return context;
+}
+#endif // !CHIP_CRYPTO_BORINGSSL
+
+CHIP_ERROR PrepareAes128KeyContext(Aes128KeyHandle & key)
+{
+    ReleaseAes128KeyContext(key);
+
+    Aes128KeyWithContext & keyWithContext = key.AsMutable<Aes128KeyWithContext>();
+#if CHIP_CRYPTO_BORINGSSL
+    keyWithContext.mEncryptContext = EVP_AEAD_CTX_new(EVP_aead_aes_128_ccm_matter(), keyWithContext.mKey,
+                                                      sizeof(keyWithContext.mKey), CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES);
+    keyWithContext.mDecryptContext = keyWithContext.mEncryptContext;
+#else
+    keyWithContext.mEncryptContext = _newCcmCipherContext(keyWithContext.mKey, 1);
+    keyWithContext.mDecryptContext = _newCcmCipherContext(keyWithContext.mKey, 0);
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    if (keyWithContext.mEncryptContext == nullptr || keyWithContext.mDecryptContext == nullptr)
+    {
+        ReleaseAes128KeyContext(key);
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void ReleaseAes128KeyContext(Symmetric128BitsKeyHandle & key)
+{
+    Aes128KeyWithContext & keyWithContext = key.AsMutable<Aes128KeyWithContext>();
+
+#if CHIP_CRYPTO_BORINGSSL
+    EVP_AEAD_CTX_free(keyWithContext.mEncryptContext);
+#else
+    EVP_CIPHER_CTX_free(keyWithContext.mEncryptContext);
+    EVP_CIPHER_CTX_free(keyWithContext.mDecryptContext);
+#endif // CHIP_CRYPTO_BORINGSSL
+    keyWithContext.mEncryptContext = nullptr;
+    keyWithContext.mDecryptContext = nullptr;
+}
+
 CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
                            const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
                            uint8_t * tag, size_t tag_length)
@@ -160,8 +245,9 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
     size_t ciphertext_length = 0;
     const EVP_CIPHER * type  = nullptr;
 #endif
-    CHIP_ERROR error = CHIP_NO_ERROR;
-    int result       = 1;
+    CHIP_ERROR error       = CHIP_NO_ERROR;
+    int result             = 1;
+    bool contextIsPrepared = false;
 
     // Placeholder location for avoiding null params for plaintexts when
     // size is zero.
@@ -204,8 +290,14 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
 #if CHIP_CRYPTO_BORINGSSL
     aead = EVP_aead_aes_128_ccm_matter();
 
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+    context           = _preparedCipherContext(key, true, nonce_length, tag_length);
+    contextIsPrepared = (context != nullptr);
+    if (!contextIsPrepared)
+    {
+        context =
+            EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
+        VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+    }
 
     result = EVP_AEAD_CTX_seal_scatter(context, ciphertext, tag, &written_tag_len, tag_length, nonce, nonce_length, plaintext,
                                        plaintext_length, nullptr, 0, aad, aad_length);
@@ -213,27 +305,39 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
     VerifyOrExit(written_tag_len == tag_length, error = CHIP_ERROR_INTERNAL);
 #else
 
-    type = EVP_aes_128_ccm();
+    context           = _preparedCipherContext(key, true, nonce_length, tag_length);
+    contextIsPrepared = (context != nullptr);
+    if (contextIsPrepared)
+    {
+        // The cipher, nonce and tag lengths and key are set up already: pass in nonce
+        result = EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
+    else
+    {
+        type = EVP_aes_128_ccm();
 
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+        context = EVP_CIPHER_CTX_new();
+        VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
 
-    // Pass in cipher
-    result = EVP_EncryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in cipher
+        result = EVP_EncryptInit_ex(context, type, nullptr, nullptr, nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in nonce length.  Cast is safe because we checked with CanCastTo.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in nonce length.  Cast is safe because we checked with CanCastTo.
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in tag length. Cast is safe because we checked against CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in tag length. Cast is safe because we checked against CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES.
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in key + nonce
-    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_EncryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in key + nonce
+        static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
+        result =
+            EVP_EncryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
 
     // Pass in plain text length
     VerifyOrExit(CanCastTo<int>(plaintext_length), error = CHIP_ERROR_INVALID_ARGUMENT);
@@ -268,7 +372,7 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
-    if (context != nullptr)
+    if (context != nullptr && !contextIsPrepared)
     {
 #if CHIP_CRYPTO_BORINGSSL
         EVP_AEAD_CTX_free(context);
@@ -294,8 +398,9 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
     int bytesOutput          = 0;
     const EVP_CIPHER * type  = nullptr;
 #endif // CHIP_CRYPTO_BORINGSSL
-    CHIP_ERROR error = CHIP_NO_ERROR;
-    int result       = 1;
+    CHIP_ERROR error       = CHIP_NO_ERROR;
+    int result             = 1;
+    bool contextIsPrepared = false;
 
     // Placeholder location for avoiding null params for ciphertext when
     // size is zero.
@@ -336,39 +441,61 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
 #if CHIP_CRYPTO_BORINGSSL
     aead = EVP_aead_aes_128_ccm_matter();
 
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+    context           = _preparedCipherContext(key, false, nonce_length, tag_length);
+    contextIsPrepared = (context != nullptr);
+    if (!contextIsPrepared)
+    {
+        context =
+            EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
+        VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+    }
 
     result = EVP_AEAD_CTX_open_gather(context, plaintext, nonce, nonce_length, ciphertext, ciphertext_length, tag, tag_length, aad,
                                       aad_length);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 #else
-    type = EVP_aes_128_ccm();
+    context           = _preparedCipherContext(key, false, nonce_length, tag_length);
+    contextIsPrepared = (context != nullptr);
+    if (contextIsPrepared)
+    {
+        // The cipher, nonce and tag lengths and key are set up already: pass in nonce, then expected tag
+        result = EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length),
+                                     const_cast<void *>(static_cast<const void *>(tag)));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
+    else
+    {
+        type = EVP_aes_128_ccm();
 
-    // Pass in cipher
-    result = EVP_DecryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        context = EVP_CIPHER_CTX_new();
+        VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
 
-    // Pass in nonce length
-    VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in cipher
+        result = EVP_DecryptInit_ex(context, type, nullptr, nullptr, nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in expected tag
-    // Removing "const" from |tag| here should hopefully be safe as
-    // we're writing the tag, not reading.
-    VerifyOrExit(CanCastTo<int>(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length),
-                                              const_cast<void *>(static_cast<const void *>(tag)));
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in nonce length
+        VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in key + nonce
-    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_DecryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+        // Pass in expected tag
+        // Removing "const" from |tag| here should hopefully be safe as
+        // we're writing the tag, not reading.
+        VerifyOrExit(CanCastTo<int>(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length),
+                                     const_cast<void *>(static_cast<const void *>(tag)));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        // Pass in key + nonce
+        static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
+        result =
+            EVP_DecryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
 
     // Pass in cipher text length
     VerifyOrExit(CanCastTo<int>(ciphertext_length), error = CHIP_ERROR_INVALID_ARGUMENT);
@@ -397,7 +524,7 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
-    if (context != nullptr)
+    if (context != nullptr && !contextIsPrepared)
     {
 #if CHIP_CRYPTO_BORINGSSL
         EVP_AEAD_CTX_free(context);
@@ -18,6 +18,7 @@
 #include <crypto/RawKeySessionKeystore.h>
 
 #include <lib/support/BufferReader.h>
+#include <lib/support/logging/CHIPLogging.h>
 
 #include <cstdint>
 
@@ -80,10 +81,26 @@ CHIP_ERROR RawKeySessionKeystore::DeriveSessionKeys(const ByteSpan & secret, con
 
     Encoding::LittleEndian::Reader reader(keyMaterial, sizeof(keyMaterial));
 
-    return reader.ReadBytes(i2rKey.AsMutable<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray))
-        .ReadBytes(r2iKey.AsMutable<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray))
-        .ReadBytes(attestationChallenge.Bytes(), AttestationChallenge::Capacity())
-        .StatusCode();
+    ReturnErrorOnFailure(reader.ReadBytes(i2rKey.AsMutable<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray))
+                             .ReadBytes(r2iKey.AsMutable<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray))
+                             .ReadBytes(attestationChallenge.Bytes(), AttestationChallenge::Capacity())
+                             .StatusCode());
+
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+    // Session keys encrypt every message of the session: set up their cipher contexts once. Without them, each message
+    // sets up its own.
+    CHIP_ERROR err = PrepareAes128KeyContext(i2rKey);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = PrepareAes128KeyContext(r2iKey);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Failed to prepare the cipher contexts of session keys: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+#endif // CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR RawKeySessionKeystore::DeriveSessionKeys(const HkdfKeyHandle & hkdfKey, const ByteSpan & salt, const ByteSpan & info,
@@ -95,6 +112,9 @@ CHIP_ERROR RawKeySessionKeystore::DeriveSessionKeys(const HkdfKeyHandle & hkdfKe
 
 void RawKeySessionKeystore::DestroyKey(Symmetric128BitsKeyHandle & key)
 {
+#if CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
+    ReleaseAes128KeyContext(key);
+#endif // CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL
     ClearSecretData(key.AsMutable<Symmetric128BitsKeyByteArray>());
 }
 
@@ -392,6 +392,49 @@ TEST_F(TestChipCryptoPAL, TestAES_CCM_128DecryptTestVectors)
     EXPECT_GT(numOfTestsRan, 0);
 }
 
+TEST_F(TestChipCryptoPAL, TestAES_CCM_128DecryptInPlaceTestVectors)
+{
+    HeapChecker heapChecker;
+    int numOfTestVectors = ArraySize(ccm_128_test_vectors);
+    int numOfTestsRan    = 0;
+    for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+    {
+        const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+        if (vector->pt_len > 0)
+        {
+            numOfTestsRan++;
+            chip::Platform::ScopedMemoryBuffer<uint8_t> buffer;
+            buffer.Alloc(vector->ct_len);
+            EXPECT_TRUE(buffer);
+            memcpy(buffer.Get(), vector->ct, vector->ct_len);
+
+            TestAesKey key(vector->key, vector->key_len);
+
+            CHIP_ERROR err = AES_CCM_decrypt_in_place(buffer.Get(), vector->ct_len, vector->aad, vector->aad_len, vector->tag,
+                                                      vector->tag_len, key.key, vector->nonce, vector->nonce_len);
+
+            // A message that fails authentication is left as it was.
+            EXPECT_EQ(err == CHIP_NO_ERROR, vector->result == CHIP_NO_ERROR);
+            const uint8_t * expected = (err == CHIP_NO_ERROR) ? vector->pt : vector->ct;
+            EXPECT_EQ(memcmp(buffer.Get(), expected, vector->ct_len), 0);
+
+            if (vector->result == CHIP_NO_ERROR)
+            {
+                // Nor is a message with a tampered tag.
+                uint8_t tag[kAES_CCM128_Tag_Length];
+                memcpy(tag, vector->tag, vector->tag_len);
+                tag[0] ^= 0x01;
+                memcpy(buffer.Get(), vector->ct, vector->ct_len);
+                err = AES_CCM_decrypt_in_place(buffer.Get(), vector->ct_len, vector->aad, vector->aad_len, tag, vector->tag_len,
+                                               key.key, vector->nonce, vector->nonce_len);
+                EXPECT_EQ(err, CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+                EXPECT_EQ(memcmp(buffer.Get(), vector->ct, vector->ct_len), 0);
+            }
+        }
+    }
+    EXPECT_GT(numOfTestsRan, 0);
+}
+
 TEST_F(TestChipCryptoPAL, TestAES_CCM_128EncryptInvalidNonceLen)
 {
     HeapChecker heapChecker;
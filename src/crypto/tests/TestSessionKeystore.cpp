@@ -201,4 +201,70 @@ TEST_F(TestSessionKeystore, TestDeriveSessionKeys)
     }
 }
 
+TEST_F(TestSessionKeystore, TestSessionKeysEncryptMessages)
+{
+    TestSessionKeystoreImpl keystore;
+    const DeriveSessionKeysTestVector & test = deriveSessionKeysTestVectors[0];
+
+    Aes128KeyHandle i2r;
+    Aes128KeyHandle r2i;
+    AttestationChallenge challenge;
+    ASSERT_EQ(keystore.DeriveSessionKeys(ToSpan(test.secret), ToSpan(test.salt), ToSpan(test.info), i2r, r2i, challenge),
+              CHIP_NO_ERROR);
+
+    // The same key as I2R, derived on its own, which the crypto PAL may set up differently than session keys.
+    P256ECDHDerivedSecret secret;
+    memcpy(secret.Bytes(), test.secret, strlen(test.secret));
+    secret.SetLength(strlen(test.secret));
+    Aes128KeyHandle derived;
+    ASSERT_EQ(keystore.DeriveKey(secret, ToSpan(test.salt), ToSpan(test.info), derived), CHIP_NO_ERROR);
+
+    // Session keys keep encrypting and decrypting messages like other keys, including after a message fails to decrypt.
+    const uint8_t aad[] = { 0x00, 0x11, 0x22, 0x33 };
+    uint8_t plaintext[100];
+    for (size_t i = 0; i < sizeof(plaintext); i++)
+    {
+        plaintext[i] = static_cast<uint8_t>(i);
+    }
+
+    for (uint8_t messageCounter = 0; messageCounter < 4; messageCounter++)
+    {
+        uint8_t nonce[CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES] = { messageCounter };
+        uint8_t ciphertext[sizeof(plaintext)];
+        uint8_t tag[CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES];
+        uint8_t expectedCiphertext[sizeof(plaintext)];
+        uint8_t expectedTag[CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES];
+        uint8_t decrypted[sizeof(plaintext)];
+
+        EXPECT_EQ(AES_CCM_encrypt(plaintext, sizeof(plaintext), aad, sizeof(aad), i2r, nonce, sizeof(nonce), ciphertext, tag,
+                                  sizeof(tag)),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(AES_CCM_encrypt(plaintext, sizeof(plaintext), aad, sizeof(aad), derived, nonce, sizeof(nonce),
+                                  expectedCiphertext, expectedTag, sizeof(expectedTag)),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(memcmp(ciphertext, expectedCiphertext, sizeof(ciphertext)), 0);
+        EXPECT_EQ(memcmp(tag, expectedTag, sizeof(tag)), 0);
+
+        tag[0] ^= 0x01;
+        EXPECT_NE(AES_CCM_decrypt(ciphertext, sizeof(ciphertext), aad, sizeof(aad), tag, sizeof(tag), i2r, nonce, sizeof(nonce),
+                                  decrypted),
+                  CHIP_NO_ERROR);
+        tag[0] ^= 0x01;
+
+        EXPECT_EQ(AES_CCM_decrypt(ciphertext, sizeof(ciphertext), aad, sizeof(aad), tag, sizeof(tag), i2r, nonce, sizeof(nonce),
+                                  decrypted),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(memcmp(decrypted, plaintext, sizeof(plaintext)), 0);
+
+        // The other key of the session does not decrypt the message.
+        EXPECT_NE(AES_CCM_decrypt(ciphertext, sizeof(ciphertext), aad, sizeof(aad), tag, sizeof(tag), r2i, nonce, sizeof(nonce),
+                                  decrypted),
+                  CHIP_NO_ERROR);
+    }
+
+    keystore.DestroyKey(derived);
+    keystore.DestroyKey(i2r);
+    keystore.DestroyKey(r2i);
+}
+
 } // namespace
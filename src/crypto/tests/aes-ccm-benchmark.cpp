@@ -0,0 +1,129 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a throughput benchmark of the AES-CCM encryption
+ *      and decryption of session messages.
+ *
+ *      For payloads of 64 to 1024 bytes, it encrypts and decrypts messages
+ *      with the header-sized AAD, nonce and tag of secure session messages,
+ *      first with a key created from raw key material, then with a session
+ *      key from DeriveSessionKeys, for which the crypto PAL may keep cipher
+ *      contexts set up, and reports the messages encrypted and decrypted per
+ *      second with each.
+ *
+ *      Usage: aes-ccm-benchmark [message-count]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+
+#include <algorithm>
+
+using namespace chip;
+using namespace chip::Crypto;
+using namespace chip::Test;
+
+namespace {
+
+constexpr size_t kPayloadSizes[] = { 64, 128, 256, 512, 1024 };
+constexpr size_t kMaxPayloadSize = 1024;
+constexpr size_t kAadSize        = 8; // Message header of a secure unicast message without source and destination node IDs.
+
+// Encrypts and decrypts messageCount messages of payloadSize bytes, returning the time it took in microseconds.
+uint64_t RunMessages(const Aes128KeyHandle & key, uint32_t messageCount, size_t payloadSize)
+{
+    uint8_t plaintext[kMaxPayloadSize];
+    uint8_t ciphertext[kMaxPayloadSize];
+    uint8_t decrypted[kMaxPayloadSize];
+    uint8_t aad[kAadSize]                              = {};
+    uint8_t nonce[CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES] = {};
+    uint8_t tag[CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES];
+
+    for (size_t i = 0; i < payloadSize; i++)
+    {
+        plaintext[i] = static_cast<uint8_t>(i);
+    }
+
+    const uint64_t start = NowMicroseconds();
+    for (uint32_t i = 0; i < messageCount; i++)
+    {
+        // The message counter goes into the header and the nonce of each message.
+        memcpy(&aad[4], &i, sizeof(i));
+        memcpy(&nonce[1], &i, sizeof(i));
+
+        VerifyOrDie(AES_CCM_encrypt(plaintext, payloadSize, aad, sizeof(aad), key, nonce, sizeof(nonce), ciphertext, tag,
+                                    sizeof(tag)) == CHIP_NO_ERROR);
+        VerifyOrDie(AES_CCM_decrypt(ciphertext, payloadSize, aad, sizeof(aad), tag, sizeof(tag), key, nonce, sizeof(nonce),
+                                    decrypted) == CHIP_NO_ERROR);
+    }
+    const uint64_t microseconds = NowMicroseconds() - start;
+
+    VerifyOrDie(memcmp(decrypted, plaintext, payloadSize) == 0);
+    return microseconds;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t messageCount = std::max(1u, ParseArg(argc, argv, 1, 100000));
+
+    ScopedPlatformMemory platformMemory;
+
+    DefaultSessionKeystore keystore;
+    const uint8_t secret[] = "session shared secret";
+    const uint8_t salt[]   = "salt";
+    const uint8_t info[]   = "SessionKeys";
+
+    Aes128KeyHandle createdKey;
+    Symmetric128BitsKeyByteArray keyMaterial = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                                 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    VerifyOrDie(keystore.CreateKey(keyMaterial, createdKey) == CHIP_NO_ERROR);
+
+    Aes128KeyHandle i2rKey;
+    Aes128KeyHandle r2iKey;
+    AttestationChallenge challenge;
+    VerifyOrDie(keystore.DeriveSessionKeys(ByteSpan(secret), ByteSpan(salt), ByteSpan(info), i2rKey, r2iKey, challenge) ==
+                CHIP_NO_ERROR);
+
+    printf("AES-CCM benchmark: %" PRIu32 " messages encrypted and decrypted per payload size\n", messageCount);
+
+    for (size_t payloadSize : kPayloadSizes)
+    {
+        const double createdRate = PerSecond(messageCount, RunMessages(createdKey, messageCount, payloadSize));
+        const double sessionRate = PerSecond(messageCount, RunMessages(i2rKey, messageCount, payloadSize));
+        printf("  %4zu bytes: %10.0f messages/s with a created key, %10.0f messages/s with a session key (x%.2f)\n",
+               payloadSize, createdRate, sessionRate, sessionRate / createdRate);
+    }
+
+    keystore.DestroyKey(createdKey);
+    keystore.DestroyKey(i2rKey);
+    keystore.DestroyKey(r2iKey);
+
+    return EXIT_SUCCESS;
+}
@@ -136,6 +136,19 @@
 #define CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE 1
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT
+ *
+ * The number of worker threads used by PlatformManager::ScheduleCryptoWork to run
+ * expensive cryptographic work (CASE and PASE handshake steps) concurrently.
+ *
+ * When 0, crypto work is scheduled as background work. Only supported on platforms
+ * built on GenericPlatformManagerImpl_POSIX.
+ */
+#ifndef CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT
+#define CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT 0
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_ICD_SLOW_POLL_INTERVAL
  *
@@ -211,6 +211,26 @@ public:
      */
     CHIP_ERROR ScheduleBackgroundWork(AsyncWorkFunct workFunct, intptr_t arg = 0);
 
+    /**
+     * Generally this function has the same semantics as ScheduleBackgroundWork
+     * except that work items may run concurrently with each other, on a pool
+     * of worker threads dedicated to expensive cryptographic computations
+     * (see CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT).
+     *
+     * The work function must not touch any stack state; it should post its
+     * results back to the CHIP thread with ScheduleWork.
+     *
+     * Delegates to ScheduleBackgroundWork on platforms without a crypto worker
+     * pool, or when the pool is not running.
+     */
+    CHIP_ERROR ScheduleCryptoWork(AsyncWorkFunct workFunct, intptr_t arg = 0);
+
+    /**
+     * Returns true if work scheduled with ScheduleCryptoWork runs concurrently
+     * with the CHIP event loop, rather than being queued behind it.
+     */
+    bool HasCryptoWorkers();
+
     /**
      * Generally this function has the same semantics as PostEvent
      * except it applies to background processing.
@@ -478,6 +498,16 @@ inline CHIP_ERROR PlatformManager::ScheduleBackgroundWork(AsyncWorkFunct workFun
     return static_cast<ImplClass *>(this)->_ScheduleBackgroundWork(workFunct, arg);
 }
 
+inline CHIP_ERROR PlatformManager::ScheduleCryptoWork(AsyncWorkFunct workFunct, intptr_t arg)
+{
+    return static_cast<ImplClass *>(this)->_ScheduleCryptoWork(workFunct, arg);
+}
+
+inline bool PlatformManager::HasCryptoWorkers()
+{
+    return static_cast<ImplClass *>(this)->_HasCryptoWorkers();
+}
+
 inline CHIP_ERROR PlatformManager::PostBackgroundEvent(const ChipDeviceEvent * event)
 {
     return static_cast<ImplClass *>(this)->_PostBackgroundEvent(event);
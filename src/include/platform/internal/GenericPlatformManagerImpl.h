@@ -59,6 +59,8 @@ protected:
     void _HandleServerShuttingDown();
     CHIP_ERROR _ScheduleWork(AsyncWorkFunct workFunct, intptr_t arg);
     CHIP_ERROR _ScheduleBackgroundWork(AsyncWorkFunct workFunct, intptr_t arg);
+    CHIP_ERROR _ScheduleCryptoWork(AsyncWorkFunct workFunct, intptr_t arg);
+    bool _HasCryptoWorkers() { return false; }
     CHIP_ERROR _PostBackgroundEvent(const ChipDeviceEvent * event);
     void _RunBackgroundEventLoop(void);
     CHIP_ERROR _StartBackgroundEventLoopTask(void);
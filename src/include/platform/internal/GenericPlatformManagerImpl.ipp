@@ -255,6 +255,12 @@ CHIP_ERROR GenericPlatformManagerImpl<ImplClass>::_ScheduleBackgroundWork(AsyncW
     return err;
 }
 
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl<ImplClass>::_ScheduleCryptoWork(AsyncWorkFunct workFunct, intptr_t arg)
+{
+    return Impl()->ScheduleBackgroundWork(workFunct, arg);
+}
+
 template <class ImplClass>
 CHIP_ERROR GenericPlatformManagerImpl<ImplClass>::_PostBackgroundEvent(const ChipDeviceEvent * event)
 {
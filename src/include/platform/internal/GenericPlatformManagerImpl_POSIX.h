@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <platform/CryptoWorkerPool.h>
 #include <platform/DeviceSafeQueue.h>
 #include <platform/internal/GenericPlatformManagerImpl.h>
 
@@ -91,6 +92,8 @@ protected:
     CHIP_ERROR _StartEventLoopTask();
     CHIP_ERROR _StopEventLoopTask();
     CHIP_ERROR _StartChipTimer(System::Clock::Timeout duration);
+    CHIP_ERROR _ScheduleCryptoWork(AsyncWorkFunct workFunct, intptr_t arg);
+    bool _HasCryptoWorkers() { return mCryptoWorkerPool.IsRunning(); }
     void _Shutdown();
 
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
@@ -113,6 +116,8 @@ private:
     static void * EventLoopTaskMain(void * arg);
 #endif
     void ProcessDeviceEvents();
+
+    CryptoWorkerPool mCryptoWorkerPool;
 };
 
 // Instruct the compiler to instantiate the template only when explicitly told to do so.
@@ -72,6 +72,10 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_InitChipStack()
     VerifyOrReturnError(ret == 0, CHIP_ERROR_POSIX(ret));
 #endif
 
+#if CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT > 0
+    ReturnErrorOnFailure(mCryptoWorkerPool.Start(CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT));
+#endif
+
     return CHIP_NO_ERROR;
 }
 
@@ -383,6 +387,16 @@ exit:
 #endif // CHIP_SYSTEM_CONFIG_USE_LIBEV
 }
 
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_ScheduleCryptoWork(AsyncWorkFunct workFunct, intptr_t arg)
+{
+    if (mCryptoWorkerPool.IsRunning())
+    {
+        return mCryptoWorkerPool.Post(workFunct, arg);
+    }
+    return Impl()->ScheduleBackgroundWork(workFunct, arg);
+}
+
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
 {
@@ -393,6 +407,10 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
     //
     VerifyOrDie(mState.load(std::memory_order_relaxed) == State::kStopped);
 
+    // Work still queued on the crypto workers runs to completion here, so that the
+    // helpers it references are released.
+    mCryptoWorkerPool.Stop();
+
 #if !CHIP_SYSTEM_CONFIG_USE_LIBEV
     pthread_mutex_destroy(&mStateLock);
     pthread_cond_destroy(&mEventQueueStoppedCond);
@@ -272,6 +272,29 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+ *
+ *  @brief
+ *    Maximum number of datagrams the socket-based UDP endpoint receives with a
+ *    single recvmmsg() call, and queues for a single sendmmsg() call.
+ *
+ *  @details
+ *    A value of 1 disables batching, and datagrams are received and sent one at
+ *    a time with recvmsg() and sendmsg().
+ *
+ *    Larger values are only honored on Linux. A listening endpoint then keeps
+ *    this many receive PacketBuffers allocated, and outgoing messages are queued
+ *    and handed to the kernel together at the end of the current event loop
+ *    iteration (or as soon as the queue is full). Send errors detected by the
+ *    kernel are therefore logged instead of being returned by SendTo(). When
+ *    the socket send buffer is full, the queued messages are kept and sent once
+ *    the socket is writable again; SendTo() only fails if the queue is full too.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+#define INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE 1
+#endif // INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE
+
 /**
  *  @def HAVE_SO_BINDTODEVICE
  *
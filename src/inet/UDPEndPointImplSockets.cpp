@@ -292,22 +292,57 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     // For now the entire message must fit within a single buffer.
     VerifyOrReturnError(!msg->HasChainedBuffer(), CHIP_ERROR_MESSAGE_TOO_LONG);
 
+#if INET_UDP_SOCKETS_USE_MMSG
+    return EnqueueSend(aPktInfo, std::move(msg));
+#else
     struct iovec msgIOV;
     msgIOV.iov_base = msg->Start();
     msgIOV.iov_len  = msg->DataLength();
 
-#if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
     uint8_t controlData[256];
-    memset(controlData, 0, sizeof(controlData));
-#endif // defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
+    SockAddr peerSockAddr;
 
     struct msghdr msgHeader;
     memset(&msgHeader, 0, sizeof(msgHeader));
     msgHeader.msg_iov    = &msgIOV;
     msgHeader.msg_iovlen = 1;
 
+    ReturnErrorOnFailure(PrepareSendHeader(aPktInfo, peerSockAddr, msgHeader, controlData, sizeof(controlData)));
+
+    // Send IP packet.
+    const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
+    if (lenSent == -1)
+    {
+        return CHIP_ERROR_POSIX(errno);
+    }
+
+    size_t len = static_cast<size_t>(lenSent);
+
+    if (len != msg->DataLength())
+    {
+        return CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG;
+    }
+    return CHIP_NO_ERROR;
+#endif // INET_UDP_SOCKETS_USE_MMSG
+}
+
+/**
+ *  Fill in the destination address and, if needed, the IP_PKTINFO/IPV6_PKTINFO control message of @a msgHeader.
+ *
+ *  @param[in]    aPktInfo          Destination, and optionally source address and interface, of the message.
+ *  @param[out]   peerSockAddr      Storage for the destination socket address referenced by @a msgHeader.
+ *  @param[inout] msgHeader         Message header to fill in; msg_iov is left untouched.
+ *  @param[in]    controlData       Storage for the control message referenced by @a msgHeader.
+ *  @param[in]    controlDataSize   Size of @a controlData.
+ */
+CHIP_ERROR UDPEndPointImplSockets::PrepareSendHeader(const IPPacketInfo * aPktInfo, SockAddr & peerSockAddr,
+                                                     struct msghdr & msgHeader, uint8_t * controlData, size_t controlDataSize)
+{
+#if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
+    memset(controlData, 0, controlDataSize);
+#endif // defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
+
     // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
-    SockAddr peerSockAddr;
     memset(&peerSockAddr, 0, sizeof(peerSockAddr));
     msgHeader.msg_name = &peerSockAddr;
     if (mAddrType == IPAddressType::kIPv6)
@@ -351,7 +386,7 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     {
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
         msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        msgHeader.msg_controllen = controlDataSize;
 
         struct cmsghdr * controlHdr      = CMSG_FIRSTHDR(&msgHeader);
         InterfaceId::PlatformType intfId = intf.GetPlatformInterface();
@@ -409,24 +444,38 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     }
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
-    // Send IP packet.
-    const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
-    if (lenSent == -1)
-    {
-        return CHIP_ERROR_POSIX(errno);
-    }
-
-    size_t len = static_cast<size_t>(lenSent);
-
-    if (len != msg->DataLength())
-    {
-        return CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG;
-    }
     return CHIP_NO_ERROR;
 }
 
 void UDPEndPointImplSockets::CloseImpl()
 {
+#if INET_UDP_SOCKETS_USE_MMSG
+    if (mSocket != kInvalidSocketFd)
+    {
+        // Messages accepted by SendTo() before Close() still go out, as far as the socket send buffer allows.
+        FlushPendingSends();
+    }
+    if (mPendingSendCount > 0)
+    {
+        ChipLogError(Inet, "UDP send failed: %u messages dropped on close", mPendingSendCount);
+        for (unsigned i = 0; i < mPendingSendCount; i++)
+        {
+            mSendBuffers[i] = nullptr;
+        }
+        mPendingSendCount = 0;
+    }
+    mWaitingForWritable = false;
+    if (mFlushScheduled)
+    {
+        GetSystemLayer().CancelTimer(HandleFlushPendingSends, this);
+        mFlushScheduled = false;
+    }
+    for (auto & buffer : mReceiveBuffers)
+    {
+        buffer = nullptr;
+    }
+#endif // INET_UDP_SOCKETS_USE_MMSG
+
     if (mSocket != kInvalidSocketFd)
     {
         static_cast<System::LayerSockets *>(&GetSystemLayer())->StopWatchingSocket(&mWatch);
@@ -572,11 +621,21 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events, intptr
 
 void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
 {
+#if INET_UDP_SOCKETS_USE_MMSG
+    if (mWaitingForWritable && events.Has(System::SocketEventFlags::kWrite))
+    {
+        FlushPendingSends();
+    }
+#endif // INET_UDP_SOCKETS_USE_MMSG
+
     if (mState != State::kListening || OnMessageReceived == nullptr || !events.Has(System::SocketEventFlags::kRead))
     {
         return;
     }
 
+#if INET_UDP_SOCKETS_USE_MMSG
+    ReceiveBatch();
+#else
     CHIP_ERROR lStatus = CHIP_NO_ERROR;
     IPPacketInfo lPacketInfo;
     System::PacketBufferHandle lBuffer;
@@ -621,83 +680,361 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         else
         {
             lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+            lStatus = ReadPacketInfo(msgHeader, lPacketInfo);
+        }
+    }
+    else
+    {
+        lStatus = CHIP_ERROR_NO_MEMORY;
+    }
 
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
+    if (lStatus == CHIP_NO_ERROR)
+    {
+        lBuffer.RightSize();
+        OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+    }
+    else
+    {
+        if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
+        {
+            OnReceiveError(this, lStatus, nullptr);
+        }
+    }
+#endif // INET_UDP_SOCKETS_USE_MMSG
+}
+
+/**
+ *  Fill in the source address and port of @a packetInfo from the peer address of a received message, and its
+ *  destination address and interface from the IP_PKTINFO/IPV6_PKTINFO control message, if any.
+ */
+CHIP_ERROR UDPEndPointImplSockets::ReadPacketInfo(struct msghdr & msgHeader, IPPacketInfo & packetInfo)
+{
+    const SockAddr & peerSockAddr = *static_cast<const SockAddr *>(msgHeader.msg_name);
+
+    if (peerSockAddr.any.sa_family == AF_INET6)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in6.sin6_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in6.sin6_port);
+    }
 #if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
+    else if (peerSockAddr.any.sa_family == AF_INET)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in.sin_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in.sin_port);
+    }
 #endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
-            }
-        }
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
 
-        if (lStatus == CHIP_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
 #if INET_CONFIG_ENABLE_IPV4
 #ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            packetInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
 #endif // defined(IP_PKTINFO)
 #endif // INET_CONFIG_ENABLE_IPV4
 
 #ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
             }
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            packetInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
         }
+#endif // defined(IPV6_PKTINFO)
     }
-    else
+
+    return CHIP_NO_ERROR;
+}
+
+#if INET_UDP_SOCKETS_USE_MMSG
+
+/**
+ *  Receive up to INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE datagrams with a single recvmmsg() call and deliver
+ *  them to OnMessageReceived in order.
+ */
+void UDPEndPointImplSockets::ReceiveBatch()
+{
+    struct mmsghdr msgHeaders[kMmsgBatchSize];
+    struct iovec msgIOVs[kMmsgBatchSize];
+    SockAddr peerSockAddrs[kMmsgBatchSize];
+    uint8_t controlData[kMmsgBatchSize][kMmsgControlSize];
+
+    memset(msgHeaders, 0, sizeof(msgHeaders));
+
+    unsigned count = 0;
+    for (; count < kMmsgBatchSize; count++)
     {
-        lStatus = CHIP_ERROR_NO_MEMORY;
+        System::PacketBufferHandle & buffer = mReceiveBuffers[count];
+        if (buffer.IsNull())
+        {
+            buffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+            if (buffer.IsNull())
+            {
+                break;
+            }
+        }
+
+        msgIOVs[count].iov_base = buffer->Start();
+        msgIOVs[count].iov_len  = buffer->AvailableDataLength();
+
+        memset(&peerSockAddrs[count], 0, sizeof(peerSockAddrs[count]));
+
+        struct msghdr & msgHeader = msgHeaders[count].msg_hdr;
+        msgHeader.msg_name        = &peerSockAddrs[count];
+        msgHeader.msg_namelen     = sizeof(peerSockAddrs[count]);
+        msgHeader.msg_iov         = &msgIOVs[count];
+        msgHeader.msg_iovlen      = 1;
+        msgHeader.msg_control     = controlData[count];
+        msgHeader.msg_controllen  = sizeof(controlData[count]);
     }
 
-    if (lStatus == CHIP_NO_ERROR)
+    if (count == 0)
     {
-        lBuffer.RightSize();
-        OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+        if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, CHIP_ERROR_NO_MEMORY, nullptr);
+        }
+        return;
     }
-    else
+
+    const int received = recvmmsg(mSocket, msgHeaders, count, MSG_DONTWAIT, nullptr);
+    if (received < 0)
     {
+        CHIP_ERROR lStatus = CHIP_ERROR_POSIX(errno);
         if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
         {
             OnReceiveError(this, lStatus, nullptr);
         }
+        return;
+    }
+
+    // An upcall may close or free this endpoint; keep it alive until all received datagrams are processed.
+    Retain();
+
+    for (int i = 0; i < received && mState == State::kListening && OnMessageReceived != nullptr; i++)
+    {
+        CHIP_ERROR lStatus = CHIP_NO_ERROR;
+        IPPacketInfo lPacketInfo;
+        System::PacketBufferHandle lBuffer = std::move(mReceiveBuffers[i]);
+
+        lPacketInfo.Clear();
+        lPacketInfo.DestPort  = mBoundPort;
+        lPacketInfo.Interface = mBoundIntfId;
+
+        if ((msgHeaders[i].msg_hdr.msg_flags & MSG_TRUNC) || lBuffer->AvailableDataLength() < msgHeaders[i].msg_len)
+        {
+            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        }
+        else
+        {
+            lBuffer->SetDataLength(static_cast<uint16_t>(msgHeaders[i].msg_len));
+            lStatus = ReadPacketInfo(msgHeaders[i].msg_hdr, lPacketInfo);
+        }
+
+        if (lStatus == CHIP_NO_ERROR)
+        {
+            lBuffer.RightSize();
+            OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+        }
+        else
+        {
+            // The buffer was not handed out; keep it for the next call.
+            lBuffer->SetDataLength(0);
+            mReceiveBuffers[i] = std::move(lBuffer);
+            if (OnReceiveError != nullptr)
+            {
+                OnReceiveError(this, lStatus, nullptr);
+            }
+        }
+    }
+
+    Release();
+}
+
+/**
+ *  Queue a message for the next FlushPendingSends(), which runs at the end of the current event loop iteration
+ *  or immediately once the queue is full.
+ */
+CHIP_ERROR UDPEndPointImplSockets::EnqueueSend(const IPPacketInfo * aPktInfo, System::PacketBufferHandle && msg)
+{
+    if (mPendingSendCount == kMmsgBatchSize)
+    {
+        // The queue only stays full while the socket send buffer is; fail as sendmsg() would.
+        FlushPendingSends();
+        VerifyOrReturnError(mPendingSendCount < kMmsgBatchSize, CHIP_ERROR_POSIX(EAGAIN));
+    }
+
+    const unsigned index = mPendingSendCount;
+
+    struct msghdr & msgHeader = mSendHeaders[index].msg_hdr;
+    memset(&mSendHeaders[index], 0, sizeof(mSendHeaders[index]));
+
+    mSendIOVs[index].iov_base = msg->Start();
+    mSendIOVs[index].iov_len  = msg->DataLength();
+    msgHeader.msg_iov         = &mSendIOVs[index];
+    msgHeader.msg_iovlen      = 1;
+
+    ReturnErrorOnFailure(PrepareSendHeader(aPktInfo, mSendPeers[index], msgHeader, mSendControlData[index],
+                                           sizeof(mSendControlData[index])));
+
+    mSendBuffers[index] = std::move(msg);
+    mPendingSendCount++;
+
+    if (mWaitingForWritable)
+    {
+        // Sent along with the others once the socket is writable again.
+        return CHIP_NO_ERROR;
+    }
+
+    if (mPendingSendCount == kMmsgBatchSize)
+    {
+        FlushPendingSends();
+    }
+    else if (!mFlushScheduled)
+    {
+        if (GetSystemLayer().ScheduleWork(HandleFlushPendingSends, this) == CHIP_NO_ERROR)
+        {
+            mFlushScheduled = true;
+        }
+        else
+        {
+            // Without a scheduled flush the message would sit in the queue indefinitely; send it right away.
+            FlushPendingSends();
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+/**
+ *  Hand all queued messages to the kernel with as few sendmmsg() calls as possible.
+ *
+ *  Messages that do not fit in the socket send buffer stay queued, and are sent when the socket becomes writable again.
+ */
+void UDPEndPointImplSockets::FlushPendingSends()
+{
+    unsigned sent = 0;
+
+    while (sent < mPendingSendCount)
+    {
+        const int res = sendmmsg(mSocket, &mSendHeaders[sent], mPendingSendCount - sent, 0);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+
+            // sendmmsg() only reports an error for the first message it could not send; drop that one and carry on.
+            ChipLogError(Inet, "UDP send failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+            sent++;
+            continue;
+        }
+
+        for (unsigned i = sent; i < sent + static_cast<unsigned>(res); i++)
+        {
+            if (mSendHeaders[i].msg_len != mSendBuffers[i]->DataLength())
+            {
+                ChipLogError(Inet, "UDP send failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG.Format());
+            }
+        }
+        sent += static_cast<unsigned>(res);
+    }
+
+    if (sent > 0)
+    {
+        for (unsigned i = 0; i < sent; i++)
+        {
+            mSendBuffers[i] = nullptr;
+        }
+        for (unsigned i = sent; i < mPendingSendCount; i++)
+        {
+            MovePendingSend(i, i - sent);
+        }
+        mPendingSendCount -= sent;
+    }
+
+    auto * layer = static_cast<System::LayerSockets *>(&GetSystemLayer());
+    if (mPendingSendCount > 0 && !mWaitingForWritable)
+    {
+        // The socket send buffer is full: send the rest once it has drained.
+        CHIP_ERROR err = layer->SetCallback(mWatch, HandlePendingIO, reinterpret_cast<intptr_t>(this));
+        if (err == CHIP_NO_ERROR)
+        {
+            err = layer->RequestCallbackOnPendingWrite(mWatch);
+        }
+        mWaitingForWritable = (err == CHIP_NO_ERROR);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Inet, "UDP send failed: %" CHIP_ERROR_FORMAT, err.Format());
+            for (unsigned i = 0; i < mPendingSendCount; i++)
+            {
+                mSendBuffers[i] = nullptr;
+            }
+            mPendingSendCount = 0;
+        }
+    }
+    else if (mPendingSendCount == 0 && mWaitingForWritable)
+    {
+        layer->ClearCallbackOnPendingWrite(mWatch);
+        mWaitingForWritable = false;
     }
 }
 
+/**
+ *  Move the queued message at index @a from to index @a to, re-pointing its header at the storage of its new index.
+ */
+void UDPEndPointImplSockets::MovePendingSend(unsigned from, unsigned to)
+{
+    struct msghdr & msgHeader = mSendHeaders[to].msg_hdr;
+
+    mSendHeaders[to] = mSendHeaders[from];
+    mSendIOVs[to]    = mSendIOVs[from];
+    mSendPeers[to]   = mSendPeers[from];
+    memcpy(mSendControlData[to], mSendControlData[from], sizeof(mSendControlData[to]));
+    mSendBuffers[to] = std::move(mSendBuffers[from]);
+
+    msgHeader.msg_iov  = &mSendIOVs[to];
+    msgHeader.msg_name = &mSendPeers[to];
+    if (msgHeader.msg_control != nullptr)
+    {
+        msgHeader.msg_control = mSendControlData[to];
+    }
+}
+
+// static
+void UDPEndPointImplSockets::HandleFlushPendingSends(System::Layer * systemLayer, void * appState)
+{
+    auto * endPoint            = static_cast<UDPEndPointImplSockets *>(appState);
+    endPoint->mFlushScheduled = false;
+    endPoint->FlushPendingSends();
+}
+
+#endif // INET_UDP_SOCKETS_USE_MMSG
+
 #ifdef IPV6_MULTICAST_LOOP
 static CHIP_ERROR SocketsSetMulticastLoopback(int aSocket, bool aLoopback, int aProtocol, int aOption)
 {
@@ -26,6 +26,13 @@
 #include <inet/EndPointStateSockets.h>
 #include <inet/UDPEndPoint.h>
 
+#if INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE > 1 && CHIP_SYSTEM_CONFIG_USE_POSIX_SOCKETS && defined(__linux__)
+#define INET_UDP_SOCKETS_USE_MMSG 1
+#include <sys/socket.h>
+#else
+#define INET_UDP_SOCKETS_USE_MMSG 0
+#endif
+
 namespace chip {
 namespace Inet {
 
@@ -55,12 +62,40 @@ private:
     void CloseImpl() override;
 
     CHIP_ERROR GetSocket(IPAddressType addressType);
+    CHIP_ERROR PrepareSendHeader(const IPPacketInfo * pktInfo, SockAddr & peerSockAddr, struct msghdr & msgHeader,
+                                 uint8_t * controlData, size_t controlDataSize);
+    CHIP_ERROR ReadPacketInfo(struct msghdr & msgHeader, IPPacketInfo & packetInfo);
     void HandlePendingIO(System::SocketEvents events);
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
 
     InterfaceId mBoundIntfId;
     uint16_t mBoundPort;
 
+#if INET_UDP_SOCKETS_USE_MMSG
+    static constexpr unsigned kMmsgBatchSize   = INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE;
+    static constexpr size_t kMmsgControlSize   = 128;
+
+    void ReceiveBatch();
+    CHIP_ERROR EnqueueSend(const IPPacketInfo * pktInfo, System::PacketBufferHandle && msg);
+    void FlushPendingSends();
+    void MovePendingSend(unsigned from, unsigned to);
+    static void HandleFlushPendingSends(System::Layer * systemLayer, void * appState);
+
+    // Receive buffers are kept across HandlePendingIO() calls; only the ones handed to OnMessageReceived are replaced.
+    System::PacketBufferHandle mReceiveBuffers[kMmsgBatchSize];
+
+    // Outgoing messages waiting for FlushPendingSends(). mSendHeaders[i] points into the i-th entry of the other arrays.
+    struct mmsghdr mSendHeaders[kMmsgBatchSize];
+    struct iovec mSendIOVs[kMmsgBatchSize];
+    SockAddr mSendPeers[kMmsgBatchSize];
+    uint8_t mSendControlData[kMmsgBatchSize][kMmsgControlSize];
+    System::PacketBufferHandle mSendBuffers[kMmsgBatchSize];
+    unsigned mPendingSendCount = 0;
+    bool mFlushScheduled       = false;
+    // Set while the queued messages wait for the socket send buffer to drain.
+    bool mWaitingForWritable = false;
+#endif // INET_UDP_SOCKETS_USE_MMSG
+
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
 public:
     enum class MulticastOperation
@@ -0,0 +1,225 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for sending and receiving datagrams over
+ *      loopback with UDP endpoints, one at a time or in batches of
+ *      INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <pw_unit_test/framework.h>
+
+#include <inet/IPAddress.h>
+#include <inet/InetConfig.h>
+#include <inet/UDPEndPoint.h>
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+
+#include "TestInetCommon.h"
+
+#include <vector>
+
+using namespace chip;
+using namespace chip::Inet;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+// Enough datagrams for several full batches and a partial one.
+constexpr uint32_t kBatchSize     = INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE;
+constexpr uint32_t kMessageCount  = 3 * kBatchSize + 1;
+constexpr uint16_t kMessageLength = 64;
+
+struct Receiver
+{
+    std::vector<uint32_t> sequenceNumbers;
+    bool contentsMatch = true;
+    unsigned errors    = 0;
+};
+
+void OnMessageReceived(UDPEndPoint * endPoint, System::PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    auto * receiver = static_cast<Receiver *>(endPoint->mAppState);
+    if (msg->DataLength() != kMessageLength)
+    {
+        receiver->contentsMatch = false;
+        return;
+    }
+
+    uint32_t sequenceNumber;
+    memcpy(&sequenceNumber, msg->Start(), sizeof(sequenceNumber));
+    for (uint16_t i = sizeof(sequenceNumber); i < kMessageLength; i++)
+    {
+        receiver->contentsMatch &= (msg->Start()[i] == static_cast<uint8_t>(sequenceNumber + i));
+    }
+    receiver->sequenceNumbers.push_back(sequenceNumber);
+}
+
+void OnReceiveError(UDPEndPoint * endPoint, CHIP_ERROR err, const IPPacketInfo * pktInfo)
+{
+    static_cast<Receiver *>(endPoint->mAppState)->errors++;
+}
+
+System::PacketBufferHandle MakeMessage(uint32_t sequenceNumber)
+{
+    System::PacketBufferHandle msg = System::PacketBufferHandle::New(kMessageLength);
+    VerifyOrReturnValue(!msg.IsNull(), msg);
+
+    memcpy(msg->Start(), &sequenceNumber, sizeof(sequenceNumber));
+    for (uint16_t i = sizeof(sequenceNumber); i < kMessageLength; i++)
+    {
+        msg->Start()[i] = static_cast<uint8_t>(sequenceNumber + i);
+    }
+    msg->SetDataLength(kMessageLength);
+    return msg;
+}
+
+class TestInetUDPEndPoint : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR);
+        InitSystemLayer();
+        InitNetwork();
+    }
+
+    static void TearDownTestSuite()
+    {
+        ShutdownNetwork();
+        ShutdownSystemLayer();
+        Platform::MemoryShutdown();
+    }
+
+    void SetUp() override
+    {
+        mAddress = IPAddress::Loopback(IPAddressType::kIPv6);
+
+        ASSERT_EQ(gUDP.NewEndPoint(&mReceiverEndPoint), CHIP_NO_ERROR);
+        ASSERT_EQ(mReceiverEndPoint->Bind(IPAddressType::kIPv6, mAddress, 0), CHIP_NO_ERROR);
+        ASSERT_EQ(mReceiverEndPoint->Listen(OnMessageReceived, OnReceiveError, &mReceiver), CHIP_NO_ERROR);
+        mPort = mReceiverEndPoint->GetBoundPort();
+
+        ASSERT_EQ(gUDP.NewEndPoint(&mSenderEndPoint), CHIP_NO_ERROR);
+        ASSERT_EQ(mSenderEndPoint->Bind(IPAddressType::kIPv6, mAddress, 0), CHIP_NO_ERROR);
+    }
+
+    void TearDown() override
+    {
+        if (mSenderEndPoint != nullptr)
+        {
+            mSenderEndPoint->Free();
+        }
+        mReceiverEndPoint->Free();
+    }
+
+    // Services events until the receiver has count messages, or a second has elapsed.
+    void ReceiveMessages(size_t count)
+    {
+        const System::Clock::Timestamp deadline = System::SystemClock().GetMonotonicTimestamp() + 1000_ms;
+        while (mReceiver.sequenceNumbers.size() < count && System::SystemClock().GetMonotonicTimestamp() < deadline)
+        {
+            ServiceEvents(10);
+        }
+        // And a little longer, to catch unexpected extra messages.
+        ServiceEvents(10);
+    }
+
+    void ExpectMessagesInOrder(uint32_t count)
+    {
+        ASSERT_EQ(mReceiver.sequenceNumbers.size(), count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            EXPECT_EQ(mReceiver.sequenceNumbers[i], i);
+        }
+        EXPECT_TRUE(mReceiver.contentsMatch);
+        EXPECT_EQ(mReceiver.errors, 0u);
+    }
+
+    IPAddress mAddress;
+    uint16_t mPort;
+    UDPEndPoint * mReceiverEndPoint = nullptr;
+    UDPEndPoint * mSenderEndPoint   = nullptr;
+    Receiver mReceiver;
+};
+
+TEST_F(TestInetUDPEndPoint, SendAndReceive)
+{
+    for (uint32_t i = 0; i < kMessageCount; i++)
+    {
+        EXPECT_EQ(mSenderEndPoint->SendTo(mAddress, mPort, MakeMessage(i)), CHIP_NO_ERROR);
+    }
+
+    ReceiveMessages(kMessageCount);
+    ExpectMessagesInOrder(kMessageCount);
+}
+
+TEST_F(TestInetUDPEndPoint, SendAcrossEventLoopIterations)
+{
+    // Messages queued for a batch go out with the ones sent in the next iterations, in order.
+    for (uint32_t i = 0; i < kMessageCount; i++)
+    {
+        EXPECT_EQ(mSenderEndPoint->SendTo(mAddress, mPort, MakeMessage(i)), CHIP_NO_ERROR);
+        if (i % 3 == 2)
+        {
+            ServiceEvents(0);
+        }
+    }
+
+    ReceiveMessages(kMessageCount);
+    ExpectMessagesInOrder(kMessageCount);
+}
+
+TEST_F(TestInetUDPEndPoint, SendBeforeFree)
+{
+    // Messages accepted by SendTo() still go out when the endpoint is freed before the event loop runs.
+    constexpr uint32_t kCount = (kBatchSize > 1) ? kBatchSize - 1 : 1;
+    for (uint32_t i = 0; i < kCount; i++)
+    {
+        EXPECT_EQ(mSenderEndPoint->SendTo(mAddress, mPort, MakeMessage(i)), CHIP_NO_ERROR);
+    }
+    mSenderEndPoint->Free();
+    mSenderEndPoint = nullptr;
+
+    ReceiveMessages(kCount);
+    ExpectMessagesInOrder(kCount);
+}
+
+TEST_F(TestInetUDPEndPoint, ReceiveAfterReceiveBuffersWereHandedOut)
+{
+    // The receive buffers handed to OnMessageReceived are replaced, so that later batches are received as well.
+    for (int round = 0; round < 3; round++)
+    {
+        for (uint32_t i = 0; i < kMessageCount; i++)
+        {
+            const uint32_t sequenceNumber = static_cast<uint32_t>(round) * kMessageCount + i;
+            EXPECT_EQ(mSenderEndPoint->SendTo(mAddress, mPort, MakeMessage(sequenceNumber)), CHIP_NO_ERROR);
+        }
+        ReceiveMessages(static_cast<size_t>(round + 1) * kMessageCount);
+    }
+
+    ExpectMessagesInOrder(3 * kMessageCount);
+}
+
+} // namespace
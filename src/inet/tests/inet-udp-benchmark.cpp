@@ -0,0 +1,143 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a loopback throughput benchmark for UDP endpoints.
+ *
+ *      A sender endpoint transmits bursts of datagrams to a receiver endpoint over
+ *      the IPv6 loopback interface while the system layer event loop is serviced,
+ *      and the number of datagrams delivered per second is reported. Build with
+ *      INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE set to 1 and to a larger value to
+ *      compare per-datagram recvmsg()/sendmsg() with recvmmsg()/sendmmsg().
+ *
+ *      Usage: inet-udp-benchmark [packet-count] [burst-size] [payload-size]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <inet/IPPacketInfo.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+
+#include "TestInetCommon.h"
+
+using namespace chip;
+using namespace chip::Inet;
+using namespace chip::System;
+using namespace chip::Test;
+
+namespace {
+
+uint32_t sReceivedCount = 0;
+uint32_t sErrorCount    = 0;
+
+void HandleMessageReceived(UDPEndPoint * endPoint, PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    sReceivedCount++;
+}
+
+void HandleReceiveError(UDPEndPoint * endPoint, CHIP_ERROR err, const IPPacketInfo * pktInfo)
+{
+    sErrorCount++;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t packetCount = ParseArg(argc, argv, 1, 200000);
+    const uint32_t burstSize   = ParseArg(argc, argv, 2, 32);
+    const uint32_t payloadSize = ParseArg(argc, argv, 3, 100);
+
+    UDPEndPoint * receiver = nullptr;
+    UDPEndPoint * sender   = nullptr;
+    IPAddress loopback;
+    uint32_t sentCount = 0;
+    int result         = EXIT_FAILURE;
+
+    InitTestInetCommon();
+    InitSystemLayer();
+    InitNetwork();
+
+    VerifyOrExit(IPAddress::FromString("::1", loopback), printf("Invalid loopback address\n"));
+
+    SuccessOrExit(gUDP.NewEndPoint(&receiver));
+    SuccessOrExit(receiver->Bind(IPAddressType::kIPv6, loopback, 0));
+    SuccessOrExit(receiver->Listen(HandleMessageReceived, HandleReceiveError));
+
+    SuccessOrExit(gUDP.NewEndPoint(&sender));
+    SuccessOrExit(sender->Bind(IPAddressType::kIPv6, loopback, 0));
+
+    printf("UDP loopback benchmark: %" PRIu32 " packets, burst %" PRIu32 ", payload %" PRIu32 " bytes, mmsg batch size %d\n",
+           packetCount, burstSize, payloadSize, INET_CONFIG_UDP_SOCKET_MMSG_BATCH_SIZE);
+
+    {
+        const Clock::Microseconds64 start = SystemClock().GetMonotonicMicroseconds64();
+
+        while (sReceivedCount + sErrorCount < packetCount)
+        {
+            // Keep at most one burst outstanding so that the loopback socket buffer does not overflow.
+            for (uint32_t i = 0; i < burstSize && sentCount < packetCount && sentCount - sReceivedCount < burstSize; i++)
+            {
+                PacketBufferHandle msg = PacketBufferHandle::New(payloadSize);
+                VerifyOrExit(!msg.IsNull(), printf("Out of packet buffers\n"));
+                memset(msg->Start(), 0xA5, payloadSize);
+                msg->SetDataLength(static_cast<uint16_t>(payloadSize));
+
+                SuccessOrExit(sender->SendTo(loopback, receiver->GetBoundPort(), std::move(msg)));
+                sentCount++;
+            }
+
+            ServiceEvents(10);
+
+            // Give up on datagrams dropped by the kernel rather than spinning forever.
+            if (sentCount == packetCount && SystemClock().GetMonotonicMicroseconds64() - start > Clock::Seconds64(60))
+            {
+                break;
+            }
+        }
+
+        const Clock::Microseconds64 elapsed = SystemClock().GetMonotonicMicroseconds64() - start;
+        const double seconds                = static_cast<double>(elapsed.count()) / 1e6;
+
+        printf("Sent %" PRIu32 ", received %" PRIu32 ", errors %" PRIu32 " in %.3f s: %.0f packets/s\n", sentCount, sReceivedCount,
+               sErrorCount, seconds, static_cast<double>(sReceivedCount) / seconds);
+    }
+
+    result = EXIT_SUCCESS;
+
+exit:
+    if (sender != nullptr)
+    {
+        sender->Free();
+    }
+    if (receiver != nullptr)
+    {
+        receiver->Free();
+    }
+
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+    ShutdownTestInetCommon();
+
+    return result;
+}
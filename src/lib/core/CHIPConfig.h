@@ -254,6 +254,27 @@
 #define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS 16
 #endif // CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+/**
+ *  @def CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS
+ *
+ *  @brief
+ *    Number of buckets of the hash index the ExchangeManager uses to find the
+ *    exchange context of an incoming message, a power of two, or 0 to walk
+ *    all exchange contexts instead.
+ *
+ *    Each bucket is a pointer. Controllers and bridges that keep thousands of
+ *    exchanges open (with CHIP_SYSTEM_CONFIG_POOL_USE_HEAP) should size it to
+ *    about the number of exchanges.
+ *
+ */
+#ifndef CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#define CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS 256
+#else
+#define CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS 16
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#endif // CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS
+
 /**
  *  @def CHIP_CONFIG_MCSP_RECEIVE_TABLE_SIZE
  *
@@ -769,6 +790,24 @@
 #define CHIP_CONFIG_SECURE_SESSION_POOL_SIZE (CHIP_CONFIG_MAX_FABRICS * 3 + 2)
 #endif // CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
 
+/**
+ * @def CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+ *
+ * @brief Enables hash indices over the secure session table, keyed by local
+ * session ID and by peer ScopedNodeId.
+ *
+ * Without them, looking up the session for an incoming message or for a peer
+ * walks the whole session pool. That is the cheapest option for the default
+ * pool size, but a commissioner or fabric administrator that sets
+ * CHIP_CONFIG_SECURE_SESSION_POOL_SIZE to thousands of sessions should enable
+ * this. The indices cost roughly 4 * CHIP_CONFIG_SECURE_SESSION_POOL_SIZE
+ * slots of 16 to 24 bytes each.
+ *
+ */
+#ifndef CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+#define CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX 0
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
 /**
  *  @def CHIP_CONFIG_MAX_GROUP_DATA_PEERS
  *
@@ -931,6 +970,147 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX
+ *
+ * @brief Enables the index of the attribute paths read or subscribed to,
+ * used to find the interested read handlers when an attribute changes.
+ *
+ * Without it, marking an attribute dirty checks it against every path of
+ * every read handler. With it, the paths are indexed by endpoint, cluster
+ * and attribute when a read or subscription is set up, and only the handlers
+ * interested in the attribute are visited. This is worth enabling on devices,
+ * such as bridges, with many subscriptions and frequently changing
+ * attributes. The index costs one entry, about 32 bytes, per path group.
+ */
+#ifndef CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX
+#define CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX 0
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX_BUCKETS
+ *
+ * @brief Defines the number of hash buckets of the attribute interest index,
+ * which must be a power of two.
+ */
+#ifndef CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX_BUCKETS
+#define CHIP_IM_SERVER_ATTRIBUTE_INTEREST_INDEX_BUCKETS 64
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS
+ *
+ * @brief Enables sharing the encoded attribute data of a report between
+ * subscriptions that would report exactly the same data.
+ *
+ * Subscriptions from the same subject, fabric filtering and attribute paths,
+ * that last reported at the same time, get the same attribute data when
+ * reporting changes. With this enabled, that data is read and encoded once per
+ * change, then copied into the report of each such subscription. This is worth
+ * enabling on devices with many identical subscriptions, e.g. several
+ * controller applications of one fabric subscribing to the same attributes.
+ * It costs one packet buffer, held between the reports that share it.
+ */
+#ifndef CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS
+#define CHIP_IM_SERVER_SHARED_ATTRIBUTE_REPORTS 0
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_LIST_ITEM_CARRY
+ *
+ * @brief Enables carrying the list item that does not fit in a report chunk
+ * to the next chunk, rather than encoding it again.
+ *
+ * When a list attribute does not fit in a report, it is sent in chunks, and
+ * the list item that did not fit in a chunk is encoded again (its data read
+ * again) for the next one. With this enabled, the list items close to the end
+ * of a chunk are encoded aside first and copied into the report: the one that
+ * does not fit is kept and copied into the next chunk. This is worth enabling
+ * on devices reporting large lists, e.g. access control entries, fabrics or
+ * the parts list of a bridge. It costs one packet buffer, allocated while a
+ * chunk is built and held between the chunks of one list.
+ */
+#ifndef CHIP_IM_SERVER_LIST_ITEM_CARRY
+#define CHIP_IM_SERVER_LIST_ITEM_CARRY 0
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE
+ *
+ * @brief The number of distinct attribute paths the reporting engine holds
+ * back while a write request is processed, or 0 to disable the batching.
+ *
+ * Each attribute written marks its path dirty, which checks the path against
+ * the read handlers, and a write can mark the same path dirty several times,
+ * e.g. for the items of a list. With this enabled, the paths marked dirty
+ * while a write request is processed are collected, and each of them is
+ * marked dirty once after it. Paths beyond this number are marked dirty right
+ * away. It costs 12 bytes per path.
+ */
+#ifndef CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE
+#define CHIP_IM_SERVER_DIRTY_PATH_BATCH_SIZE 0
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+ *
+ * @brief If enabled, the reporting engine serves the reportable read handlers
+ * by fair queuing instead of round-robin.
+ *
+ * Each report sent is charged to its read handler by its size in bytes and
+ * the time, in microseconds, spent building it. When fewer reports can be in
+ * flight (CHIP_IM_MAX_REPORTS_IN_FLIGHT) than there are reportable handlers,
+ * the handlers charged the least go first, so that a subscription with large
+ * or slow reports, e.g. a wildcard one, does not delay the small reports of
+ * the others. Handlers are not credited for the time they are not
+ * reportable. It costs 20 bytes per read handler.
+ */
+#ifndef CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING
+#define CHIP_IM_SERVER_FAIR_REPORT_SCHEDULING 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE
+ *
+ * @brief The number of distinct attribute values DefaultAttributePersistenceProvider
+ * holds back while a write request message is processed, or 0 to disable the
+ * batching.
+ *
+ * Each non-volatile attribute written is otherwise stored right away, and
+ * each write may commit the storage, e.g. rewrite a file or a flash page.
+ * With this enabled, the values written while a write request message is
+ * processed are kept in memory and stored together right after it, once per
+ * attribute however many times it was written. Each chunk of a chunked write
+ * is stored on its own, so no value is held back between messages. A value
+ * beyond this number is stored right away. It costs about 56 bytes per value,
+ * and the values kept, allocated from the heap.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_WRITE_BATCH_SIZE 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+ *
+ * @brief Enables the metadata index of the code generated (ember) data model
+ * provider.
+ *
+ * Ember finds endpoints, clusters, attributes and commands by id with linear
+ * searches of its configuration, then the provider computes their privileges
+ * and quality flags on every lookup. With this enabled, the provider keeps a
+ * sorted copy of the enabled endpoint configuration, with the cluster data
+ * version storage and the attribute and command information precomputed, and
+ * looks them up with binary searches for reads, writes, invokes and metadata
+ * queries. The index is built on first use and again after endpoints are
+ * enabled or disabled. This is worth enabling on devices with many endpoints,
+ * such as bridges (with fewer than about 50 endpoints, the linear searches are
+ * as fast). It costs about 20 bytes of heap per attribute, 28 per
+ * cluster and 12 per accepted command.
+ */
+#ifndef CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX
+#define CHIP_CONFIG_CODEGEN_DATA_MODEL_METADATA_INDEX 0
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1107,6 +1287,24 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_GROUP_KEY_HINT_CACHE_SIZE
+ *
+ * @brief Defines the number of group key hints kept by the SessionManager.
+ *
+ * A hint remembers which operational group key last decrypted a group message
+ * with a given session ID from a given source node, so that later messages
+ * can skip trial decryption over every candidate key (and the persistent
+ * storage reads it involves). Each hint holds one group key context, in
+ * addition to the CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS ones.
+ *
+ * Hints keep their key contexts, and the memory of the provider's pool that
+ * backs them, for as long as the keys do not change. Disabled (0) by default.
+ */
+#ifndef CHIP_CONFIG_GROUP_KEY_HINT_CACHE_SIZE
+#define CHIP_CONFIG_GROUP_KEY_HINT_CACHE_SIZE 0
+#endif
+
 /**
  * @def CHIP_CONFIG_MAX_GROUP_NAME_LENGTH
  *
@@ -1116,6 +1314,36 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_NAME_LENGTH 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_INDEX
+ *
+ * @brief Enables the compiled index of access control entries used by
+ * AccessControl::Check.
+ *
+ * Without it, every check reads every entry of the fabric, with all of its
+ * subjects and targets, through the delegate. With it, the entries of a
+ * fabric are compiled into sorted subject and target tables the first time
+ * they are checked after a change, so that a check costs a few binary
+ * searches. This is worth enabling on devices whose fabrics install large
+ * access control lists. The tables are allocated from the heap.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_INDEX
+#define CHIP_CONFIG_ACCESS_CONTROL_INDEX 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_INDEX_SUBJECT_CACHE_SIZE
+ *
+ * @brief Defines the number of subject descriptors per fabric for which the
+ * access control index remembers the matching entries.
+ *
+ * A wildcard read or subscription checks many paths for the same subject
+ * descriptor, and only has to match the subject against the entries once.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_INDEX_SUBJECT_CACHE_SIZE
+#define CHIP_CONFIG_ACCESS_CONTROL_INDEX_SUBJECT_CACHE_SIZE 4
+#endif
+
 /**
  * @def CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC
  *
@@ -1257,6 +1485,51 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD 512
 #endif /* CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD */
 
+/**
+ * @def CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+ *
+ * @brief The number of events of the event log that are indexed to fetch
+ *   events for reports, or 0 to disable the index.
+ *
+ * Without the index, fetching the events of a report parses every event of
+ * the log to check its event number, path and fabric. The index records these
+ * for the most recent events, along with their position in the log, so that
+ * only the events to report are read from the log. This is worth enabling on
+ * devices with large event buffers and several event subscriptions. It costs
+ * 32 bytes per event; with fewer entries than the log holds events, fetching
+ * events older than the indexed ones scans the log as before.
+ */
+#ifndef CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+#define CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE
+ *
+ * @brief The number of events that can wait in the staging queue of the
+ *   event logging system, or 0 to disable the queue.
+ *
+ * Events are otherwise logged with the Matter stack lock held. With the
+ * staging queue, chip::app::LogEventFromAnyThread encodes events from any
+ * thread into a lock-free queue, and they are logged on the Matter thread,
+ * where they get their event number. This is worth enabling on devices that
+ * generate events from sensor or driver threads. The queue costs about
+ * CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_SIZE + 56 bytes per event.
+ */
+#ifndef CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE
+#define CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_SIZE
+ *
+ * @brief The largest encoded event data, in bytes, that can be staged
+ *   (see CHIP_CONFIG_EVENT_STAGING_QUEUE_SIZE).
+ */
+#ifndef CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_SIZE
+#define CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_SIZE 128
+#endif
+
 /**
  * @def CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
  *
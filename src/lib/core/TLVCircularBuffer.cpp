@@ -106,6 +106,15 @@ void TLVCircularBuffer::Init(uint8_t * inBuffer, uint32_t inBufferLength)
     mImplicitProfileId = kCommonProfileId;
 }
 
+CHIP_ERROR TLVCircularBuffer::SetQueueState(uint32_t inHeadOffset, uint32_t inDataLength)
+{
+    VerifyOrReturnError(inHeadOffset < mQueueSize && inDataLength <= mQueueSize, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mQueueHead   = mQueue + inHeadOffset;
+    mQueueLength = inDataLength;
+    return CHIP_NO_ERROR;
+}
+
 /**
  * @brief
  *   Evicts the oldest top-level TLV element in the TLVCircularBuffer
@@ -70,6 +70,21 @@ public:
 
     CHIP_ERROR EvictHead();
 
+    /**
+     * @brief
+     *   Sets the head and the length of the data of the queue, for a
+     *   backing store that already holds TLV elements, e.g. one restored
+     *   from persistent storage.
+     *
+     * @param[in] inHeadOffset  Offset of the head in the backing store
+     *
+     * @param[in] inDataLength  Length, in bytes, of the data starting at the head
+     *
+     * @retval #CHIP_NO_ERROR               On success.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT If the head or the data do not fit in the backing store.
+     */
+    CHIP_ERROR SetQueueState(uint32_t inHeadOffset, uint32_t inDataLength);
+
     // chip::TLV::TLVBackingStore overrides:
     CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override;
     CHIP_ERROR GetNextBuffer(TLVReader & ioReader, const uint8_t *& outBufStart, uint32_t & outBufLen) override;
@@ -2336,6 +2336,22 @@ TEST_F(TestTLV, CheckCircularTLVBufferSimple)
     TestEnd<TLVReader>(reader);
 }
 
+TEST_F(TestTLV, CheckCircularTLVBufferSetQueueState)
+{
+    uint8_t backingStore[30];
+    TLVCircularBuffer buffer(backingStore, sizeof(backingStore));
+
+    EXPECT_EQ(buffer.SetQueueState(29, 30), CHIP_NO_ERROR);
+    EXPECT_EQ(buffer.QueueHead(), backingStore + 29);
+    EXPECT_EQ(buffer.DataLength(), 30u);
+
+    // The head is an offset into the backing store, so one past its end is not a valid head.
+    EXPECT_EQ(buffer.SetQueueState(30, 0), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(buffer.SetQueueState(0, 31), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(buffer.QueueHead(), backingStore + 29);
+    EXPECT_EQ(buffer.DataLength(), 30u);
+}
+
 TEST_F(TestTLV, CheckCircularTLVBufferStartMidway)
 {
     // Write 40 bytes as 4 separate events into a 30 byte buffer.  On
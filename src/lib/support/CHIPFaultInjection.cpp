@@ -54,6 +54,7 @@ static const nl::FaultInjection::Name sFaultNames[] = {
     "CHIPOBLESend",
 #endif // CONFIG_NETWORK_LAYER_BLE
     "CASEServerBusy",
+    "SessionWorkAfterWorkPost",
 };
 
 /**
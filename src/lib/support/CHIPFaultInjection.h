@@ -72,7 +72,8 @@ typedef enum
 #if CONFIG_NETWORK_LAYER_BLE
     kFault_CHIPOBLESend, /**< Inject a GATT error when sending the first fragment of a chip message over BLE */
 #endif
-    kFault_CASEServerBusy, /**< Respond to CASE_Sigma1 with a BUSY status */
+    kFault_CASEServerBusy,           /**< Respond to CASE_Sigma1 with a BUSY status */
+    kFault_SessionWorkAfterWorkPost, /**< Fail to post the result of a PASE or CASE crypto worker step back to the Matter thread */
     kFault_NumItems,
 } Id;
 
@@ -265,6 +265,10 @@ private:
     ExchangeSessionHolder mSession; // The connection state
     uint16_t mExchangeId;           // Assigned exchange ID.
 
+#if CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS
+    ExchangeContext * mNextInIndex = nullptr; // Next exchange in the same bucket of the exchange index of mExchangeMgr.
+#endif
+
     /**
      *  Track whether we are now expecting a response to a message sent via this exchange (because that
      *  message had the kExpectResponse flag set in its sendFlags).
@@ -245,23 +245,14 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
     if (!packetHeader.IsGroupSession())
     {
         // Search for an existing exchange that the message applies to. If a match is found...
-        bool found = false;
-        mContextPool.ForEachActiveObject([&](auto * ec) {
-            if (ec->MatchExchange(session, packetHeader, payloadHeader))
-            {
-                ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
-                              ChipLogValueExchange(ec), ec->GetDelegate());
-
-                // Matched ExchangeContext; send to message handler.
-                ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
-                found = true;
-                return Loop::Break;
-            }
-            return Loop::Continue;
-        });
-
-        if (found)
+        ExchangeContext * ec = FindExchange(session, packetHeader, payloadHeader);
+        if (ec != nullptr)
         {
+            ChipLogDetail(ExchangeManager, "Found matching exchange: " ChipLogFormatExchange ", Delegate: %p",
+                          ChipLogValueExchange(ec), ec->GetDelegate());
+
+            // Matched ExchangeContext; send to message handler.
+            ec->HandleMessage(packetHeader.GetMessageCounter(), payloadHeader, msgFlags, std::move(msgBuf));
             return;
         }
     }
@@ -412,6 +403,72 @@ void ExchangeManager::SendStandaloneAckIfNeeded(const PacketHeader & packetHeade
     // The exchange should be closed inside HandleMessage function. So don't bother close it here.
 }
 
+#if CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS
+namespace {
+size_t ExchangeIndexBucket(uint16_t exchangeId, bool isInitiator)
+{
+    // Exchanges we initiate get consecutive IDs, which this spreads over all the buckets.
+    return ((static_cast<size_t>(exchangeId) << 1) | (isInitiator ? 1u : 0u)) & (CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS - 1);
+}
+} // namespace
+
+void ExchangeManager::AddToExchangeIndex(ExchangeContext * ec)
+{
+    // Prepend, so that adding does not walk the bucket. The exchange ID, role and session of an open exchange only repeat
+    // after 65536 new exchanges on the session, so the order of a bucket does not decide which exchange a message matches.
+    ExchangeContext *& bucket = mExchangeIndex[ExchangeIndexBucket(ec->GetExchangeId(), ec->IsInitiator())];
+    ec->mNextInIndex          = bucket;
+    bucket                    = ec;
+}
+
+void ExchangeManager::RemoveFromExchangeIndex(ExchangeContext * ec)
+{
+    for (ExchangeContext ** link = &mExchangeIndex[ExchangeIndexBucket(ec->GetExchangeId(), ec->IsInitiator())];
+         *link != nullptr; link = &(*link)->mNextInIndex)
+    {
+        if (*link == ec)
+        {
+            *link = ec->mNextInIndex;
+            return;
+        }
+    }
+}
+
+ExchangeContext * ExchangeManager::FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                                const PayloadHeader & payloadHeader)
+{
+    // The exchange of a message from an initiator is a responder, and the other way around.
+    for (ExchangeContext * ec = mExchangeIndex[ExchangeIndexBucket(payloadHeader.GetExchangeID(), !payloadHeader.IsInitiator())];
+         ec != nullptr; ec = ec->mNextInIndex)
+    {
+        if (ec->MatchExchange(session, packetHeader, payloadHeader))
+        {
+            return ec;
+        }
+    }
+    return nullptr;
+}
+#else
+void ExchangeManager::AddToExchangeIndex(ExchangeContext * ec) {}
+
+void ExchangeManager::RemoveFromExchangeIndex(ExchangeContext * ec) {}
+
+ExchangeContext * ExchangeManager::FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                                const PayloadHeader & payloadHeader)
+{
+    ExchangeContext * found = nullptr;
+    mContextPool.ForEachActiveObject([&](auto * ec) {
+        if (ec->MatchExchange(session, packetHeader, payloadHeader))
+        {
+            found = ec;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return found;
+}
+#endif // CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS
+
 void ExchangeManager::CloseAllContextsForDelegate(const ExchangeDelegate * delegate)
 {
     mContextPool.ForEachActiveObject([&](auto * ec) {
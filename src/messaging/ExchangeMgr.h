@@ -201,6 +201,10 @@ public:
 
     size_t GetNumActiveExchanges() { return mContextPool.Allocated(); }
 
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    void SetNextExchangeId(uint16_t exchangeId) { mNextExchangeId = exchangeId; }
+#endif
+
 private:
     enum class State
     {
@@ -238,6 +242,16 @@ private:
 
     ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> mContextPool;
 
+#if CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS
+    static_assert((CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS & (CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS - 1)) == 0,
+                  "CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS must be a power of two");
+
+    // Exchange contexts by exchange ID and role, the newest first, chained through
+    // ExchangeContext::mNextInIndex.  The session is not part of the key, since an exchange can move
+    // to another session during its lifetime; FindExchange compares it.
+    ExchangeContext * mExchangeIndex[CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS] = {};
+#endif // CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS
+
     SessionManager * mSessionManager;
     ReliableMessageMgr mReliableMessageMgr;
 
@@ -246,6 +260,14 @@ private:
     CHIP_ERROR RegisterUMH(Protocols::Id protocolId, int16_t msgType, UnsolicitedMessageHandler * handler);
     CHIP_ERROR UnregisterUMH(Protocols::Id protocolId, int16_t msgType);
 
+    // Called by ExchangeContext on construction and destruction.
+    void AddToExchangeIndex(ExchangeContext * ec);
+    void RemoveFromExchangeIndex(ExchangeContext * ec);
+
+    // Returns the exchange context that an incoming message belongs to, or nullptr.
+    ExchangeContext * FindExchange(const SessionHandle & session, const PacketHeader & packetHeader,
+                                   const PayloadHeader & payloadHeader);
+
     void OnMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader, const SessionHandle & session,
                            DuplicateMessage isDuplicate, System::PacketBufferHandle && msgBuf) override;
     void SendStandaloneAckIfNeeded(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
@@ -24,6 +24,9 @@
 #include <errno.h>
 #include <inttypes.h>
 
+#include <algorithm>
+#include <utility>
+
 #include <app/icd/server/ICDServerConfig.h>
 #include <lib/support/BitFlags.h>
 #include <lib/support/CHIPFaultInjection.h>
@@ -50,15 +53,17 @@ namespace Messaging {
 
 System::Clock::Timeout ReliableMessageMgr::sAdditionalMRPBackoffTime = CHIP_CONFIG_MRP_RETRY_INTERVAL_SENDER_BOOST;
 
-ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
+RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
     ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
 {
     ec->SetWaitingForAck(true);
+    rc->mRetransEntry = this;
 }
 
-ReliableMessageMgr::RetransTableEntry::~RetransTableEntry()
+RetransTableEntry::~RetransTableEntry()
 {
     ec->SetWaitingForAck(false);
+    ec->GetReliableMessageContext()->mRetransEntry = nullptr;
 }
 
 ReliableMessageMgr::ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool) :
@@ -78,7 +83,7 @@ void ReliableMessageMgr::Shutdown()
 
     // Clear the retransmit table
     mRetransTable.ForEachActiveObject([&](auto * entry) {
-        mRetransTable.ReleaseObject(entry);
+        ReleaseRetransTableEntry(*entry);
         return Loop::Continue;
     });
 
@@ -122,10 +127,11 @@ void ReliableMessageMgr::ExecuteActions()
         }
     });
 
-    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime > now)
-            return Loop::Continue;
+    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired, earliest first.  Retransmitted
+    // entries are queued again for a later time, and cancelled ones are removed from the queue.
+    while (mRetransQueue != nullptr && mRetransQueue->nextRetransTime <= now)
+    {
+        RetransTableEntry * entry = mRetransQueue;
 
         VerifyOrDie(!entry->retainedBuf.IsNull());
 
@@ -161,9 +167,9 @@ void ReliableMessageMgr::ExecuteActions()
             }
 
             // Do not StartTimer, we will schedule the timer at the end of the timer handler.
-            mRetransTable.ReleaseObject(entry);
+            ReleaseRetransTableEntry(*entry);
 
-            return Loop::Continue;
+            continue;
         }
 
         entry->sendCount++;
@@ -175,9 +181,7 @@ void ReliableMessageMgr::ExecuteActions()
 
         CalculateNextRetransTime(*entry);
         SendFromRetransTable(entry);
-
-        return Loop::Continue;
-    });
+    }
 
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
 }
@@ -274,32 +278,49 @@ System::Clock::Timeout ReliableMessageMgr::GetBackoff(System::Clock::Timeout bas
     return std::chrono::duration_cast<System::Clock::Timeout>(mrpBackoffTime);
 }
 
+System::Clock::Milliseconds32 ReliableMessageMgr::GetMinRttRetryInterval(const ReliableMessageProtocolConfig & peerConfig)
+{
+#if CHIP_CONFIG_MRP_RTT_BELOW_ACTIVE_INTERVAL
+    (void) peerConfig;
+    return CHIP_CONFIG_MRP_RTT_MIN_RETRY_INTERVAL;
+#else
+    return std::max<System::Clock::Milliseconds32>(CHIP_CONFIG_MRP_RTT_MIN_RETRY_INTERVAL, peerConfig.mActiveRetransTimeout);
+#endif // CHIP_CONFIG_MRP_RTT_BELOW_ACTIVE_INTERVAL
+}
+
 void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 {
+#if CHIP_CONFIG_MRP_RTT_ESTIMATOR
+    entry->firstSendTime = System::SystemClock().GetMonotonicTimestamp();
+#endif // CHIP_CONFIG_MRP_RTT_ESTIMATOR
     CalculateNextRetransTime(*entry);
     StartTimer();
 }
 
 bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, uint32_t ackMessageCounter)
 {
-    bool removed = false;
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
-        {
-            // Clear the entry from the retransmision table.
-            ClearRetransTable(*entry);
-
-            ChipLogDetail(ExchangeManager,
-                          "Rxd Ack; Removing MessageCounter:" ChipLogFormatMessageCounter
-                          " from Retrans Table on exchange " ChipLogFormatExchange,
-                          ackMessageCounter, ChipLogValueExchange(rc->GetExchangeContext()));
-            removed = true;
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    RetransTableEntry * entry = rc->mRetransEntry;
+    VerifyOrReturnValue(entry != nullptr && entry->retainedBuf.GetMessageCounter() == ackMessageCounter, false);
 
-    return removed;
+#if CHIP_CONFIG_MRP_RTT_ESTIMATOR
+    // Only messages that were not retransmitted give a round-trip time: the ack of a retransmitted message may be the one of
+    // any of its transmissions (Karn's algorithm).
+    if (entry->sendCount == 0 && entry->ec->HasSessionHandle() && entry->ec->GetSessionHandle()->IsSecureSession())
+    {
+        entry->ec->GetSessionHandle()->AsSecureSession()->GetRoundTripTime().AddSample(
+            std::chrono::duration_cast<System::Clock::Milliseconds32>(System::SystemClock().GetMonotonicTimestamp() -
+                                                                      entry->firstSendTime));
+    }
+#endif // CHIP_CONFIG_MRP_RTT_ESTIMATOR
+
+    // Clear the entry from the retransmision table.
+    ClearRetransTable(*entry);
+
+    ChipLogDetail(ExchangeManager,
+                  "Rxd Ack; Removing MessageCounter:" ChipLogFormatMessageCounter
+                  " from Retrans Table on exchange " ChipLogFormatExchange,
+                  ackMessageCounter, ChipLogValueExchange(rc->GetExchangeContext()));
+    return true;
 }
 
 CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
@@ -358,19 +379,15 @@ CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
 
 void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 {
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->ec->GetReliableMessageContext() == rc)
-        {
-            ClearRetransTable(*entry);
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    if (rc->mRetransEntry != nullptr)
+    {
+        ClearRetransTable(*rc->mRetransEntry);
+    }
 }
 
 void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 {
-    mRetransTable.ReleaseObject(&entry);
+    ReleaseRetransTableEntry(entry);
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     StartTimer();
 }
@@ -388,13 +405,10 @@ void ReliableMessageMgr::StartTimer()
     });
 
     // When do we need to next wake up for ReliableMessageProtocol retransmit?
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime < nextWakeTime)
-        {
-            nextWakeTime = entry->nextRetransTime;
-        }
-        return Loop::Continue;
-    });
+    if (mRetransQueue != nullptr && mRetransQueue->nextRetransTime < nextWakeTime)
+    {
+        nextWakeTime = mRetransQueue->nextRetransTime;
+    }
 
     StopTimer();
 
@@ -481,8 +495,125 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
         baseTimeout = entry.ec->GetSessionHandle()->GetMRPBaseTimeout();
     }
 
+#if CHIP_CONFIG_MRP_RTT_ESTIMATOR
+    // Once the round-trip time to an active peer has been measured, base the timeout on it rather than on the active interval
+    // the peer advertises, up to its idle interval.  A peer that is not known to be active may be asleep: keep its idle interval.
+    const auto & session = entry.ec->GetSessionHandle();
+    if (session->IsSecureSession() && session->AsSecureSession()->GetRoundTripTime().HasSample() &&
+        (entry.ec->HasReceivedAtLeastOneMessage() || session->AsSecureSession()->IsPeerActive()))
+    {
+        const ReliableMessageProtocolConfig & peerConfig = session->GetRemoteMRPConfig();
+        baseTimeout = session->AsSecureSession()->GetRoundTripTime().GetRetransmissionTimeout(GetMinRttRetryInterval(peerConfig),
+                                                                                              peerConfig.mIdleRetransTimeout);
+    }
+#endif // CHIP_CONFIG_MRP_RTT_ESTIMATOR
+
     System::Clock::Timeout backoff = ReliableMessageMgr::GetBackoff(baseTimeout, entry.sendCount);
-    entry.nextRetransTime          = System::SystemClock().GetMonotonicTimestamp() + backoff;
+
+    RemoveFromRetransQueue(entry);
+    entry.nextRetransTime = System::SystemClock().GetMonotonicTimestamp() + backoff;
+    AddToRetransQueue(entry);
+}
+
+RetransTableEntry * ReliableMessageMgr::MeldRetransQueues(RetransTableEntry * first, RetransTableEntry * second)
+{
+    // Both queues are detached roots: the later one becomes the first child of the other.
+    VerifyOrReturnValue(first != nullptr, second);
+    VerifyOrReturnValue(second != nullptr, first);
+
+    if (second->nextRetransTime < first->nextRetransTime)
+    {
+        std::swap(first, second);
+    }
+
+    second->mQueuePrev    = first;
+    second->mQueueSibling = first->mQueueChild;
+    if (first->mQueueChild != nullptr)
+    {
+        first->mQueueChild->mQueuePrev = second;
+    }
+    first->mQueueChild = second;
+    return first;
+}
+
+RetransTableEntry * ReliableMessageMgr::MergeRetransQueuePairs(RetransTableEntry * firstChild)
+{
+    // Meld the children by pairs from the first one, then meld the pairs from the last one.  The pairs are chained
+    // in reverse order through mQueueSibling in between.
+    RetransTableEntry * pairs = nullptr;
+    while (firstChild != nullptr)
+    {
+        RetransTableEntry * first  = firstChild;
+        RetransTableEntry * second = first->mQueueSibling;
+        firstChild                 = (second != nullptr) ? second->mQueueSibling : nullptr;
+
+        first->mQueuePrev = first->mQueueSibling = nullptr;
+        if (second != nullptr)
+        {
+            second->mQueuePrev = second->mQueueSibling = nullptr;
+        }
+
+        RetransTableEntry * pair = MeldRetransQueues(first, second);
+        pair->mQueueSibling      = pairs;
+        pairs                    = pair;
+    }
+
+    RetransTableEntry * root = nullptr;
+    while (pairs != nullptr)
+    {
+        RetransTableEntry * pair = pairs;
+        pairs                    = pair->mQueueSibling;
+        pair->mQueueSibling      = nullptr;
+        root                     = MeldRetransQueues(root, pair);
+    }
+    return root;
+}
+
+bool ReliableMessageMgr::IsInRetransQueue(const RetransTableEntry & entry) const
+{
+    return mRetransQueue == &entry || entry.mQueuePrev != nullptr;
+}
+
+void ReliableMessageMgr::AddToRetransQueue(RetransTableEntry & entry)
+{
+    mRetransQueue = MeldRetransQueues(mRetransQueue, &entry);
+}
+
+void ReliableMessageMgr::RemoveFromRetransQueue(RetransTableEntry & entry)
+{
+    VerifyOrReturn(IsInRetransQueue(entry));
+
+    if (mRetransQueue == &entry)
+    {
+        mRetransQueue = MergeRetransQueuePairs(entry.mQueueChild);
+    }
+    else
+    {
+        // Cut the subtree of the entry from its parent, then put the children of the entry back into the queue.
+        if (entry.mQueuePrev->mQueueChild == &entry)
+        {
+            entry.mQueuePrev->mQueueChild = entry.mQueueSibling;
+        }
+        else
+        {
+            entry.mQueuePrev->mQueueSibling = entry.mQueueSibling;
+        }
+        if (entry.mQueueSibling != nullptr)
+        {
+            entry.mQueueSibling->mQueuePrev = entry.mQueuePrev;
+        }
+        mRetransQueue = MeldRetransQueues(mRetransQueue, MergeRetransQueuePairs(entry.mQueueChild));
+    }
+
+    entry.mQueueChild   = nullptr;
+    entry.mQueueSibling = nullptr;
+    entry.mQueuePrev    = nullptr;
+}
+
+void ReliableMessageMgr::ReleaseRetransTableEntry(RetransTableEntry & entry)
+{
+    RemoveFromRetransQueue(entry);
+    mRetransTable.ReleaseObject(&entry);
 }
 
 #if CHIP_CONFIG_TEST
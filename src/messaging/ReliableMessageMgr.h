@@ -43,30 +43,43 @@ namespace Messaging {
 enum class SendMessageFlags : uint16_t;
 class ReliableMessageContext;
 
+/**
+ *  @class RetransTableEntry
+ *
+ *  @brief
+ *    This class is part of the CHIP Reliable Messaging Protocol and is used
+ *    to keep track of CHIP messages that have been sent and are expecting an
+ *    acknowledgment back. If the acknowledgment is not received within a
+ *    specific timeout, the message would be retransmitted from this table.
+ *
+ */
+struct RetransTableEntry
+{
+    RetransTableEntry(ReliableMessageContext * rc);
+    ~RetransTableEntry();
+
+    ExchangeHandle ec;                        /**< The context for the stored CHIP message. */
+    EncryptedPacketBufferHandle retainedBuf;  /**< The packet buffer holding the CHIP message. */
+    System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
+    uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
+                                                   including both successfully and failure send. */
+#if CHIP_CONFIG_MRP_RTT_ESTIMATOR
+    System::Clock::Timestamp firstSendTime; /**< The time the message was first sent, to measure the round-trip time. */
+#endif // CHIP_CONFIG_MRP_RTT_ESTIMATOR
+
+private:
+    friend class ReliableMessageMgr;
+
+    // Links of the entry in the retransmission queue of ReliableMessageMgr, a pairing heap ordered by nextRetransTime.
+    RetransTableEntry * mQueueChild   = nullptr; /**< The first child of the entry. */
+    RetransTableEntry * mQueueSibling = nullptr; /**< The next child of the parent of the entry. */
+    RetransTableEntry * mQueuePrev    = nullptr; /**< The previous child of the parent, or the parent for its first child. */
+};
+
 class ReliableMessageMgr
 {
 public:
-    /**
-     *  @class RetransTableEntry
-     *
-     *  @brief
-     *    This class is part of the CHIP Reliable Messaging Protocol and is used
-     *    to keep track of CHIP messages that have been sent and are expecting an
-     *    acknowledgment back. If the acknowledgment is not received within a
-     *    specific timeout, the message would be retransmitted from this table.
-     *
-     */
-    struct RetransTableEntry
-    {
-        RetransTableEntry(ReliableMessageContext * rc);
-        ~RetransTableEntry();
-
-        ExchangeHandle ec;                        /**< The context for the stored CHIP message. */
-        EncryptedPacketBufferHandle retainedBuf;  /**< The packet buffer holding the CHIP message. */
-        System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
-        uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
-                                                       including both successfully and failure send. */
-    };
+    using RetransTableEntry = Messaging::RetransTableEntry;
 
     ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
     ~ReliableMessageMgr();
@@ -75,9 +88,9 @@ public:
     void Shutdown();
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.  If an
-     * action needs to be triggered by ReliableMessageProtocol time facilities,
-     * execute that action.
+     * Iterate through active exchange contexts, and through the retrans table entries
+     * whose retransmission time has come.  If an action needs to be triggered by
+     * ReliableMessageProtocol time facilities, execute that action.
      */
     void ExecuteActions();
 
@@ -115,6 +128,17 @@ public:
     static System::Clock::Timeout GetBackoff(System::Clock::Timeout baseInterval, uint8_t sendCount,
                                              bool computeMaxPossible = false);
 
+    /**
+     *  Get the smallest base interval of the retransmissions to a peer derived from the round-trip time
+     *  to it (CHIP_CONFIG_MRP_RTT_ESTIMATOR).
+     *
+     *  @param[in]   peerConfig   The MRP parameters of the peer.
+     *
+     *  @retval  The active interval of the peer, unless CHIP_CONFIG_MRP_RTT_BELOW_ACTIVE_INTERVAL is enabled,
+     *           and at least CHIP_CONFIG_MRP_RTT_MIN_RETRY_INTERVAL.
+     */
+    static System::Clock::Milliseconds32 GetMinRttRetryInterval(const ReliableMessageProtocolConfig & peerConfig);
+
     /**
      *  Start retranmisttion of cached encryped packet for current entry.
      *
@@ -125,8 +149,8 @@ public:
     void StartRetransmision(RetransTableEntry * entry);
 
     /**
-     *  Iterate through active exchange contexts and retrans table entries. Clear the entry matching
-     *  the specified ExchangeContext and the message ID from the retransmision table.
+     *  Clear the entry of the specified ExchangeContext from the retransmision table if it is the
+     *  entry of the acknowledged message ID.
      *
      *  @param[in]    rc                 A pointer to the ExchangeContext object.
      *  @param[in]    ackMessageCounter  The acknowledged message counter of the received packet.
@@ -161,7 +185,7 @@ public:
     void ClearRetransTable(RetransTableEntry & rEntry);
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.
+     * Iterate through active exchange contexts and check the earliest retrans table entry.
      * Determine how many ReliableMessageProtocol ticks we need to sleep before we
      * need to physically wake the CPU to perform an action.  Set a timer to go off
      * when we next need to wake the system.
@@ -204,6 +228,11 @@ public:
     {
         mRetransTable.ForEachActiveObject(std::forward<F>(functor));
     }
+
+    // Access to the retransmission queue, for entries that need not be in the retransmission table.
+    void TestAddToRetransQueue(RetransTableEntry & entry) { AddToRetransQueue(entry); }
+    void TestRemoveFromRetransQueue(RetransTableEntry & entry) { RemoveFromRetransQueue(entry); }
+    RetransTableEntry * TestGetRetransQueueHead() const { return mRetransQueue; }
 #endif // CHIP_CONFIG_TEST
 
     /**
@@ -224,7 +253,7 @@ public:
 private:
     /**
      * Calculates the next retransmission time for the entry
-     * Function sets the nextRetransTime of the entry
+     * Function sets the nextRetransTime of the entry, and (re)queues the entry for that time
      *
      * @param[in,out] entry RetransTableEntry for which we need to calculate the nextRetransTime
      */
@@ -245,9 +274,23 @@ private:
 
     void TicklessDebugDumpRetransTable(const char * log);
 
+    // Retransmission queue: adding an entry, and removing any entry, take logarithmic (amortized) time,
+    // and the earliest entry is the root.
+    static RetransTableEntry * MeldRetransQueues(RetransTableEntry * first, RetransTableEntry * second);
+    static RetransTableEntry * MergeRetransQueuePairs(RetransTableEntry * firstChild);
+    bool IsInRetransQueue(const RetransTableEntry & entry) const;
+    void AddToRetransQueue(RetransTableEntry & entry);
+    void RemoveFromRetransQueue(RetransTableEntry & entry);
+
+    // Removes the entry from the queue and releases it.
+    void ReleaseRetransTableEntry(RetransTableEntry & entry);
+
     // ReliableMessageProtocol Global tables for timer context
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
 
+    // Root of the queue of the entries waiting for their retransmission time, which is the entry to retransmit first.
+    RetransTableEntry * mRetransQueue = nullptr;
+
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
 
     static System::Clock::Timeout sAdditionalMRPBackoffTime;
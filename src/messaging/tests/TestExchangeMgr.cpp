@@ -20,6 +20,7 @@
  *    @file
  *      This file implements unit tests for the ExchangeManager implementation.
  */
+#include <algorithm>
 #include <errno.h>
 #include <utility>
 
@@ -109,6 +110,42 @@ class ExpireSessionFromTimeoutDelegate : public WaitForTimeoutDelegate
     }
 };
 
+class RespondingAppDelegate : public UnsolicitedMessageHandler, public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        newDelegate = this;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        return ec->SendMessage(Protocols::BDX::Id, kMsgType_TEST2, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+                               SendFlags(Messaging::SendMessageFlags::kNoAutoRequestAck));
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+};
+
+class ResponseRecordingDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        ResponseCount++;
+        ResponseExchange = ec;
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    int ResponseCount                  = 0;
+    ExchangeContext * ResponseExchange = nullptr;
+};
+
 TEST_F(TestExchangeMgr, CheckNewContextTest)
 {
     MockAppDelegate mockAppDelegate;
@@ -226,6 +263,61 @@ TEST_F(TestExchangeMgr, CheckUmhRegistrationTest)
     EXPECT_NE(err, CHIP_NO_ERROR);
 }
 
+TEST_F(TestExchangeMgr, CheckResponsesReachTheirExchanges)
+{
+    // The initiator and the responder of each exchange share an exchange ID, and are both in this exchange manager.
+    constexpr size_t kExchangeCount = std::min(9, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS - 2);
+#if CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS
+    // Exchange IDs this far apart go to the same bucket of the exchange index, for each role.
+    constexpr uint16_t kExchangeIdStride = CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS;
+#else
+    constexpr uint16_t kExchangeIdStride = 1;
+#endif // CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS
+    constexpr uint16_t kFirstExchangeId = 0x1234;
+
+    RespondingAppDelegate respondingDelegate;
+    CHIP_ERROR err =
+        GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1, &respondingDelegate);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+
+    ResponseRecordingDelegate recordingDelegates[kExchangeCount];
+    ExchangeContext * exchanges[kExchangeCount];
+    for (size_t i = 0; i < kExchangeCount; i++)
+    {
+        GetExchangeManager().SetNextExchangeId(static_cast<uint16_t>(kFirstExchangeId + i * kExchangeIdStride));
+        exchanges[i] = NewExchangeToBob(&recordingDelegates[i]);
+        ASSERT_NE(exchanges[i], nullptr);
+    }
+
+    // Remove an exchange from the middle of its bucket: the others must still be found.
+    exchanges[kExchangeCount / 2]->Close();
+    exchanges[kExchangeCount / 2] = nullptr;
+
+    for (size_t i = 0; i < kExchangeCount; i++)
+    {
+        if (exchanges[i] == nullptr)
+        {
+            continue;
+        }
+        err = exchanges[i]->SendMessage(
+            Protocols::BDX::Id, kMsgType_TEST1, System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize),
+            SendFlags(Messaging::SendMessageFlags::kExpectResponse).Set(Messaging::SendMessageFlags::kNoAutoRequestAck));
+        EXPECT_EQ(err, CHIP_NO_ERROR);
+    }
+
+    DrainAndServiceIO();
+
+    for (size_t i = 0; i < kExchangeCount; i++)
+    {
+        EXPECT_EQ(recordingDelegates[i].ResponseCount, exchanges[i] == nullptr ? 0 : 1);
+        EXPECT_EQ(recordingDelegates[i].ResponseExchange, exchanges[i]);
+    }
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+
+    err = GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::BDX::Id, kMsgType_TEST1);
+    EXPECT_EQ(err, CHIP_NO_ERROR);
+}
+
 TEST_F(TestExchangeMgr, CheckExchangeMessages)
 {
     CHIP_ERROR err;
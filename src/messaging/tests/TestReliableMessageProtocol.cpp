@@ -23,6 +23,12 @@
  */
 #include <errno.h>
 
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
 #include <pw_unit_test/framework.h>
 
 #include <app/icd/server/ICDServerConfig.h>
@@ -171,6 +177,56 @@ private:
     bool mDropAckResponse = false;
 };
 
+// Drops the messages sent over the loopback transport at random, at the given rate.
+class LossyLoopbackDelegate : public chip::Test::LoopbackTransportDelegate
+{
+public:
+    // Drops the given percentage of the messages sent to the given peer, or to any peer.
+    LossyLoopbackDelegate(chip::Test::LoopbackTransport & loopback, uint32_t lossPercent,
+                          Optional<Transport::PeerAddress> lossyPeer = NullOptional) :
+        mLoopback(loopback), mLossPercent(lossPercent), mLossyPeer(lossyPeer)
+    {}
+
+    void WillSendMessage(const Transport::PeerAddress & peer, const System::PacketBufferHandle & message) override
+    {
+        if (mLossyPeer.HasValue() && mLossyPeer.Value() != peer)
+        {
+            return;
+        }
+        if (mRandom() % 100 < mLossPercent)
+        {
+            mLoopback.mNumMessagesToDrop = 1;
+        }
+    }
+
+private:
+    chip::Test::LoopbackTransport & mLoopback;
+    uint32_t mLossPercent;
+    Optional<Transport::PeerAddress> mLossyPeer;
+    std::minstd_rand mRandom{ 1 };
+};
+
+class CountingAppDelegate : public UnsolicitedMessageHandler, public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override
+    {
+        newDelegate = this;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        mReceivedCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    uint32_t mReceivedCount = 0;
+};
+
 class MockSessionEstablishmentExchangeDispatch : public Messaging::ApplicationExchangeDispatch
 {
 public:
@@ -2043,6 +2099,246 @@ TEST_F(TestReliableMessageProtocol, CheckApplicationResponseNeverComes)
     EXPECT_EQ(err, CHIP_NO_ERROR);
 }
 
+TEST_F(TestReliableMessageProtocol, CheckManyInFlightMessagesOverLossyTransport)
+{
+    // Many messages waiting for their ack at once, over a transport that loses some of the messages and of the acks: the
+    // retransmissions of all of them are scheduled, and each one is removed from the retransmission table once acked.
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    constexpr uint32_t kMessageCount = 2000;
+#else
+    constexpr uint32_t kMessageCount = std::min(CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE) - 2;
+#endif
+    constexpr uint32_t kLossPercent = 5;
+
+    CountingAppDelegate receiver;
+    EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest, &receiver), CHIP_NO_ERROR);
+
+    ReliableMessageMgr * rm = GetExchangeManager().GetReliableMessageMgr();
+    ASSERT_NE(rm, nullptr);
+
+    // The messages go from Bob to Alice: retransmit them after Alice's active interval, made short.
+    GetSessionBobToAlice()->AsSecureSession()->SetRemoteSessionParameters(ReliableMessageProtocolConfig({
+        30_ms32, // CHIP_CONFIG_MRP_LOCAL_IDLE_RETRY_INTERVAL
+        30_ms32, // CHIP_CONFIG_MRP_LOCAL_ACTIVE_RETRY_INTERVAL
+    }));
+
+    auto & loopback               = GetLoopback();
+    loopback.mSentMessageCount    = 0;
+    loopback.mNumMessagesToDrop   = 0;
+    loopback.mDroppedMessageCount = 0;
+    // Only the acks are lost: a lost message could be retransmitted after the message counter window of Alice moved past it,
+    // and then be acked without being delivered.
+    LossyLoopbackDelegate lossyDelegate(loopback, kLossPercent, MakeOptional(GetBobAddress()));
+    loopback.SetLoopbackTransportDelegate(&lossyDelegate);
+
+    CountingAppDelegate sender;
+    for (uint32_t i = 0; i < kMessageCount; i++)
+    {
+        ExchangeContext * exchange = NewExchangeToAlice(&sender);
+        ASSERT_NE(exchange, nullptr);
+        // The exchange closes once the message is sent, and lives on until the message is acked.
+        EXPECT_EQ(exchange->SendMessage(Echo::MsgType::EchoRequest, MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD))),
+                  CHIP_NO_ERROR);
+    }
+    EXPECT_GT(rm->TestGetCountRetransTable(), 0);
+
+    GetIOContext().DriveIOUntil(10000_ms32, [&] { return rm->TestGetCountRetransTable() == 0; });
+    DrainAndServiceIO();
+    loopback.SetLoopbackTransportDelegate(nullptr);
+
+    EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+    EXPECT_GT(loopback.mDroppedMessageCount, 0u);
+    // Each message was sent and acked at least once; retransmissions received after the later messages can be dropped as
+    // duplicates, but are acked.
+    EXPECT_GE(loopback.mSentMessageCount, 2 * kMessageCount + loopback.mDroppedMessageCount);
+    // Each message is delivered once; its retransmissions are acked as duplicates.
+    EXPECT_EQ(receiver.mReceivedCount, kMessageCount);
+    EXPECT_EQ(sender.mReceivedCount, 0u);
+    EXPECT_EQ(GetExchangeManager().GetNumActiveExchanges(), 0u);
+
+    EXPECT_EQ(GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest), CHIP_NO_ERROR);
+}
+
+TEST_F(TestReliableMessageProtocol, CheckRetransQueueOrdersEntriesByRetransTime)
+{
+    // Random adds, removals and pops of the retransmission queue, checked against a sorted reference: the head of the queue
+    // is always an entry with the earliest retransmission time.
+    constexpr size_t kEntryCount       = 64;
+    constexpr uint32_t kOperationCount = 20000;
+    constexpr uint32_t kTimeRange      = 100; // Small enough for entries to share retransmission times.
+
+    ReliableMessageMgr * rm = GetExchangeManager().GetReliableMessageMgr();
+    ASSERT_NE(rm, nullptr);
+    ASSERT_EQ(rm->TestGetRetransQueueHead(), nullptr);
+
+    MockAppDelegate mockSender(*this);
+    ExchangeContext * exchange = NewExchangeToAlice(&mockSender);
+    ASSERT_NE(exchange, nullptr);
+
+    {
+        // The entries only go through the queue, not through the retransmission table.
+        std::vector<std::unique_ptr<RetransTableEntry>> entries;
+        for (size_t i = 0; i < kEntryCount; i++)
+        {
+            entries.push_back(std::make_unique<RetransTableEntry>(exchange->GetReliableMessageContext()));
+        }
+        std::vector<bool> queued(kEntryCount, false);
+        std::multiset<System::Clock::Timestamp> reference;
+        std::minstd_rand random(1);
+
+        auto add = [&](size_t i) {
+            entries[i]->nextRetransTime = System::Clock::Timestamp(random() % kTimeRange);
+            rm->TestAddToRetransQueue(*entries[i]);
+            reference.insert(entries[i]->nextRetransTime);
+            queued[i] = true;
+        };
+        auto remove = [&](size_t i) {
+            rm->TestRemoveFromRetransQueue(*entries[i]);
+            reference.erase(reference.find(entries[i]->nextRetransTime));
+            queued[i] = false;
+        };
+
+        for (uint32_t operation = 0; operation < kOperationCount; operation++)
+        {
+            const size_t i = random() % kEntryCount;
+            switch (random() % 4)
+            {
+            case 0:
+                // Add, or requeue for another time as a retransmission does.
+                if (queued[i])
+                {
+                    remove(i);
+                }
+                add(i);
+                break;
+            case 1:
+                if (queued[i])
+                {
+                    remove(i);
+                }
+                break;
+            case 2: {
+                RetransTableEntry * head = rm->TestGetRetransQueueHead();
+                if (head != nullptr)
+                {
+                    remove(static_cast<size_t>(std::find_if(entries.begin(), entries.end(),
+                                                            [head](const auto & entry) { return entry.get() == head; }) -
+                                               entries.begin()));
+                }
+                break;
+            }
+            default:
+                if (!queued[i])
+                {
+                    add(i);
+                }
+                break;
+            }
+
+            RetransTableEntry * head = rm->TestGetRetransQueueHead();
+            ASSERT_EQ(head == nullptr, reference.empty());
+            if (head != nullptr)
+            {
+                ASSERT_EQ(head->nextRetransTime, *reference.begin());
+            }
+        }
+
+        // Popping the rest yields the entries in order of retransmission time.
+        while (RetransTableEntry * head = rm->TestGetRetransQueueHead())
+        {
+            EXPECT_EQ(head->nextRetransTime, *reference.begin());
+            rm->TestRemoveFromRetransQueue(*head);
+            reference.erase(reference.begin());
+        }
+        EXPECT_TRUE(reference.empty());
+    }
+
+    exchange->Close();
+}
+
+#if CHIP_CONFIG_MRP_RTT_ESTIMATOR
+TEST_F(TestReliableMessageProtocol, CheckRetransTimeoutFollowsRoundTripTime)
+{
+    // The base interval of the first retransmission to an active peer is the timeout derived from the measured round-trip
+    // time, within the bounds given by the active and idle intervals of the peer.
+    constexpr System::Clock::Milliseconds32 kIdleInterval   = 5000_ms32;
+    constexpr System::Clock::Milliseconds32 kActiveInterval = 300_ms32;
+
+    CountingAppDelegate receiver;
+    EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest, &receiver), CHIP_NO_ERROR);
+
+    ReliableMessageMgr * rm = GetExchangeManager().GetReliableMessageMgr();
+    ASSERT_NE(rm, nullptr);
+
+    // The messages go from Bob to Alice, who is known to be active.
+    Transport::SecureSession * session = GetSessionBobToAlice()->AsSecureSession();
+    session->SetRemoteSessionParameters(ReliableMessageProtocolConfig(kIdleInterval, kActiveInterval));
+    session->MarkActiveRx();
+
+    // Sends a message and checks that its first retransmission is scheduled as for the given base interval.
+    CountingAppDelegate sender;
+    auto checkFirstRetransmission = [&](System::Clock::Milliseconds32 baseInterval) {
+        ExchangeContext * exchange = NewExchangeToAlice(&sender);
+        ASSERT_NE(exchange, nullptr);
+        const System::Clock::Timestamp sendStart = System::SystemClock().GetMonotonicTimestamp();
+        EXPECT_EQ(exchange->SendMessage(Echo::MsgType::EchoRequest, MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD))),
+                  CHIP_NO_ERROR);
+        const System::Clock::Timestamp sendEnd = System::SystemClock().GetMonotonicTimestamp();
+
+        int entryCount = 0;
+        rm->EnumerateRetransTable([&](auto * entry) {
+            entryCount++;
+            // The backoff, with its margin and jitter, is at least the base interval.
+            EXPECT_GE(entry->nextRetransTime - sendStart, baseInterval);
+            EXPECT_LE(entry->nextRetransTime - sendEnd, ReliableMessageMgr::GetBackoff(baseInterval, 0, true));
+            return Loop::Continue;
+        });
+        EXPECT_EQ(entryCount, 1);
+
+        // Deliver the message, and its ack.
+        DrainAndServiceIO();
+        EXPECT_EQ(rm->TestGetCountRetransTable(), 0);
+    };
+
+    // Without a round-trip time, the active interval.
+    Transport::RoundTripTimeEstimator & roundTripTime = session->GetRoundTripTime();
+    roundTripTime.Reset();
+    checkFirstRetransmission(kActiveInterval);
+
+    // A fast link: the active interval, unless the timeout may go below it.
+    roundTripTime.Reset();
+    for (int i = 0; i < 8; i++)
+    {
+        roundTripTime.AddSample(10_ms32);
+    }
+#if CHIP_CONFIG_MRP_RTT_BELOW_ACTIVE_INTERVAL
+    checkFirstRetransmission(std::max<System::Clock::Milliseconds32>(
+        roundTripTime.GetRetransmissionTimeout(0_ms32, kIdleInterval), CHIP_CONFIG_MRP_RTT_MIN_RETRY_INTERVAL));
+#else
+    checkFirstRetransmission(kActiveInterval);
+#endif // CHIP_CONFIG_MRP_RTT_BELOW_ACTIVE_INTERVAL
+
+    // A slow link: the timeout from the round-trip time.
+    roundTripTime.Reset();
+    for (int i = 0; i < 8; i++)
+    {
+        roundTripTime.AddSample(1000_ms32);
+    }
+    const System::Clock::Milliseconds32 slowTimeout = roundTripTime.GetRetransmissionTimeout(0_ms32, kIdleInterval);
+    EXPECT_GT(slowTimeout, kActiveInterval);
+    EXPECT_LT(slowTimeout, kIdleInterval);
+    checkFirstRetransmission(slowTimeout);
+
+    // A link slower than the idle interval: the idle interval.
+    roundTripTime.Reset();
+    roundTripTime.AddSample(kIdleInterval);
+    checkFirstRetransmission(kIdleInterval);
+
+    roundTripTime.Reset();
+    EXPECT_EQ(GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Echo::MsgType::EchoRequest), CHIP_NO_ERROR);
+}
+#endif // CHIP_CONFIG_MRP_RTT_ESTIMATOR
+
 /**
  * TODO: A test that we should have but can't write with the existing
  * infrastructure we have:
@@ -0,0 +1,167 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the lookup of the exchange of
+ *      incoming messages in ExchangeManager.
+ *
+ *      It opens the given number of exchanges on a secure session, delivers
+ *      messages to exchanges picked at random among them, as SessionManager
+ *      does once it has decrypted them, then closes the exchanges, and
+ *      reports the exchanges opened, messages delivered and exchanges closed
+ *      per second. Build with CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS set
+ *      to 0 to compare with walking all the exchanges.
+ *
+ *      Usage: exchange-lookup-benchmark [exchange-count] [message-count]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <credentials/FabricTable.h>
+#include <crypto/DefaultSessionKeystore.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeMgr.h>
+#include <protocols/echo/Echo.h>
+#include <protocols/secure_channel/MessageCounterManager.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+#include <transport/SessionManager.h>
+#include <transport/tests/LoopbackTransportManager.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Messaging;
+using namespace chip::Test;
+
+namespace {
+
+constexpr uint16_t kSessionId = 1;
+constexpr NodeId kPeerNodeId  = 0x0000000000BEEF01;
+
+// Keeps the exchanges open across the messages they receive.
+class KeepOpenDelegate : public ExchangeDelegate
+{
+public:
+    CHIP_ERROR OnMessageReceived(ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && buffer) override
+    {
+        mReceivedCount++;
+        ec->WillSendMessage();
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(ExchangeContext * ec) override {}
+
+    uint32_t mReceivedCount = 0;
+};
+
+// The stack, set up as in the echo tools.
+Test::LoopbackTransportManager gTransport;
+FabricTable gFabricTable;
+TestPersistentStorageDelegate gStorage;
+Crypto::DefaultSessionKeystore gSessionKeystore;
+SessionManager gSessionManager;
+ExchangeManager gExchangeManager;
+secure_channel::MessageCounterManager gMessageCounterManager;
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t exchangeCount = std::max(1u, ParseArg(argc, argv, 1, 5000));
+    const uint32_t messageCount  = std::max(1u, ParseArg(argc, argv, 2, 100000));
+
+    VerifyOrDie(gTransport.Init() == CHIP_NO_ERROR);
+    VerifyOrDie(gSessionManager.Init(&gTransport.GetSystemLayer(), &gTransport.GetTransportMgr(), &gMessageCounterManager,
+                                     &gStorage, &gFabricTable, gSessionKeystore) == CHIP_NO_ERROR);
+    VerifyOrDie(gExchangeManager.Init(&gSessionManager) == CHIP_NO_ERROR);
+    VerifyOrDie(gMessageCounterManager.Init(&gExchangeManager) == CHIP_NO_ERROR);
+
+    SessionHolder session;
+    VerifyOrDie(gSessionManager.InjectPaseSessionWithTestKey(session, kSessionId, kPeerNodeId, kSessionId, kUndefinedFabricIndex,
+                                                             Transport::PeerAddress(),
+                                                             CryptoContext::SessionRole::kInitiator) == CHIP_NO_ERROR);
+
+#if CHIP_LOG_FILTERING
+    // Keep the log line of every message out of the measurement.
+    Logging::SetLogFilter(Logging::kLogCategory_Error);
+#endif
+
+    printf("Exchange lookup benchmark: %" PRIu32 " messages to %" PRIu32 " exchanges, %u index buckets\n", messageCount,
+           exchangeCount, static_cast<unsigned>(CHIP_CONFIG_EXCHANGE_CONTEXT_INDEX_BUCKETS));
+
+    {
+        const Optional<SessionHandle> sessionHandle = session.Get();
+        KeepOpenDelegate delegate;
+        std::vector<ExchangeContext *> exchanges(exchangeCount);
+
+        uint64_t start = NowMicroseconds();
+        for (auto & ec : exchanges)
+        {
+            ec = gExchangeManager.NewContext(sessionHandle.Value(), &delegate);
+            VerifyOrDie(ec != nullptr);
+        }
+        const uint64_t openMicroseconds = NowMicroseconds() - start;
+
+        // Responses from the peer, which did not initiate the exchanges, on the session of the exchanges.
+        PacketHeader packetHeader;
+        packetHeader.SetSessionId(kSessionId);
+        PayloadHeader payloadHeader;
+        payloadHeader.SetMessageType(Protocols::Echo::MsgType::EchoResponse).SetInitiator(false);
+        SessionMessageDelegate & receiver = gExchangeManager;
+        std::minstd_rand random(1);
+
+        start = NowMicroseconds();
+        for (uint32_t i = 0; i < messageCount; i++)
+        {
+            packetHeader.SetMessageCounter(i);
+            payloadHeader.SetExchangeID(exchanges[random() % exchangeCount]->GetExchangeId());
+            receiver.OnMessageReceived(packetHeader, payloadHeader, sessionHandle.Value(),
+                                       SessionMessageDelegate::DuplicateMessage::No, System::PacketBufferHandle::New(0));
+        }
+        const uint64_t deliverMicroseconds = NowMicroseconds() - start;
+        VerifyOrDie(delegate.mReceivedCount == messageCount);
+
+        start = NowMicroseconds();
+        for (auto * ec : exchanges)
+        {
+            ec->Close();
+        }
+        const uint64_t closeMicroseconds = NowMicroseconds() - start;
+        VerifyOrDie(gExchangeManager.GetNumActiveExchanges() == 0);
+
+        printf("  %10.0f exchanges opened/s, %10.0f messages delivered/s, %10.0f exchanges closed/s\n",
+               PerSecond(exchangeCount, openMicroseconds), PerSecond(messageCount, deliverMicroseconds),
+               PerSecond(exchangeCount, closeMicroseconds));
+    }
+
+    session.Release();
+    gMessageCounterManager.Shutdown();
+    gExchangeManager.Shutdown();
+    gSessionManager.Shutdown();
+    gTransport.Shutdown();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,194 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a simulation of MRP retransmissions over lossy
+ *      links, with the base retry interval of the peer (SAI) and with the one
+ *      derived from the measured round-trip time (CHIP_CONFIG_MRP_RTT_ESTIMATOR).
+ *
+ *      For links of different round-trip times and loss rates, it sends
+ *      messages one after the other to an active peer, in simulated time: each
+ *      transmission and each ack is lost at the loss rate of the link, and the
+ *      retransmissions are scheduled with ReliableMessageMgr::GetBackoff, as
+ *      ReliableMessageMgr does. It reports the mean and 99th percentile of the
+ *      time to get the ack of a message, the retransmissions per message, the
+ *      spurious ones (sent while an ack was still on its way), and the messages
+ *      that were given up on, with each base interval.
+ *
+ *      Usage: mrp-rtt-benchmark [message-count]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lib/support/CodeUtils.h>
+#include <messaging/ReliableMessageMgr.h>
+#include <messaging/ReliableMessageProtocolConfig.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+#include <transport/RoundTripTimeEstimator.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace chip;
+using namespace chip::System::Clock::Literals;
+using namespace chip::Test;
+using chip::Messaging::ReliableMessageMgr;
+using chip::Transport::RoundTripTimeEstimator;
+
+namespace {
+
+struct LinkProfile
+{
+    const char * name;
+    uint32_t minRttMs;         // Round-trip time without queuing, including the time the peer takes to ack.
+    uint32_t meanQueuingMs;    // Mean of the exponentially distributed queuing delay added to it.
+    uint32_t lossPercent;      // Loss rate of the messages, and of the acks.
+    uint32_t activeIntervalMs; // SAI of the peer.
+    uint32_t idleIntervalMs;   // SII of the peer.
+};
+
+constexpr LinkProfile kLinkProfiles[] = {
+    { "ethernet", 1, 1, 2, 300, 500 },
+    { "wi-fi", 5, 20, 3, 300, 500 },
+    { "thread", 60, 60, 5, 2000, 2000 },
+    { "congested", 250, 250, 5, 300, 2000 },
+};
+
+struct Results
+{
+    std::vector<uint64_t> ackTimesMs;
+    uint64_t retransmissions         = 0;
+    uint64_t spuriousRetransmissions = 0;
+    uint32_t failures                = 0;
+};
+
+// Sends messageCount messages over the link, with the base retry interval derived from the measured round-trip time if
+// adaptive is set.
+Results Simulate(const LinkProfile & link, uint32_t messageCount, bool adaptive)
+{
+    std::mt19937 random(1);
+    std::uniform_int_distribution<uint32_t> loss(0, 99);
+    std::exponential_distribution<double> queuing(1.0 / std::max(link.meanQueuingMs, 1u));
+    RoundTripTimeEstimator estimator;
+    Results results;
+
+    results.ackTimesMs.reserve(messageCount);
+    for (uint32_t i = 0; i < messageCount; i++)
+    {
+        System::Clock::Milliseconds32 baseInterval(link.activeIntervalMs);
+        if (adaptive && estimator.HasSample())
+        {
+            const ReliableMessageProtocolConfig peerConfig(System::Clock::Milliseconds32(link.idleIntervalMs),
+                                                           System::Clock::Milliseconds32(link.activeIntervalMs));
+            baseInterval = estimator.GetRetransmissionTimeout(ReliableMessageMgr::GetMinRttRetryInterval(peerConfig),
+                                                              peerConfig.mIdleRetransTimeout);
+        }
+
+        // Times relative to the first transmission of the message.  ackTime is the arrival of the first ack on its way.
+        uint64_t sendTime = 0;
+        uint64_t ackTime  = UINT64_MAX;
+        uint8_t sendCount = 0;
+        for (;;)
+        {
+            if (loss(random) >= link.lossPercent && loss(random) >= link.lossPercent)
+            {
+                const uint64_t rtt = link.minRttMs + static_cast<uint64_t>(queuing(random));
+                ackTime            = std::min(ackTime, sendTime + rtt);
+            }
+
+            const uint64_t retransmitTime = sendTime + ReliableMessageMgr::GetBackoff(baseInterval, sendCount).count();
+            if (ackTime <= retransmitTime)
+            {
+                break;
+            }
+            if (sendCount == CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS)
+            {
+                ackTime = UINT64_MAX;
+                break;
+            }
+
+            results.retransmissions++;
+            if (ackTime != UINT64_MAX)
+            {
+                results.spuriousRetransmissions++;
+            }
+            sendTime = retransmitTime;
+            sendCount++;
+        }
+
+        if (ackTime == UINT64_MAX)
+        {
+            results.failures++;
+            continue;
+        }
+
+        results.ackTimesMs.push_back(ackTime);
+        // As in ReliableMessageMgr: only the messages that were not retransmitted give a round-trip time.
+        if (sendCount == 0)
+        {
+            estimator.AddSample(System::Clock::Milliseconds32(static_cast<uint32_t>(ackTime)));
+        }
+    }
+
+    return results;
+}
+
+void Report(const char * baseName, const Results & results, uint32_t messageCount)
+{
+    std::vector<uint64_t> ackTimesMs = results.ackTimesMs;
+    std::sort(ackTimesMs.begin(), ackTimesMs.end());
+
+    uint64_t total = 0;
+    for (uint64_t ackTimeMs : ackTimesMs)
+    {
+        total += ackTimeMs;
+    }
+    const double mean  = ackTimesMs.empty() ? 0.0 : static_cast<double>(total) / static_cast<double>(ackTimesMs.size());
+    const uint64_t p99 = ackTimesMs.empty() ? 0 : ackTimesMs[(ackTimesMs.size() - 1) * 99 / 100];
+
+    printf("    %-8s: ack in %8.1f ms mean, %6" PRIu64 " ms p99, %6.3f retransmissions (%6.3f spurious) per message, "
+           "%" PRIu32 " given up\n",
+           baseName, mean, p99, static_cast<double>(results.retransmissions) / messageCount,
+           static_cast<double>(results.spuriousRetransmissions) / messageCount, results.failures);
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t messageCount = std::max(1u, ParseArg(argc, argv, 1, 10000));
+
+    printf("MRP retransmission simulation: %" PRIu32 " messages per link, minimum RTT-based interval %" PRIu32 " ms%s\n",
+           messageCount, System::Clock::Milliseconds32(CHIP_CONFIG_MRP_RTT_MIN_RETRY_INTERVAL).count(),
+           CHIP_CONFIG_MRP_RTT_BELOW_ACTIVE_INTERVAL ? "" : " or the SAI");
+
+    for (const LinkProfile & link : kLinkProfiles)
+    {
+        printf("  %s: RTT %" PRIu32 " ms + %" PRIu32 " ms mean queuing, %" PRIu32 "%% loss, SAI %" PRIu32 " ms, SII %" PRIu32
+               " ms\n",
+               link.name, link.minRttMs, link.meanQueuingMs, link.lossPercent, link.activeIntervalMs, link.idleIntervalMs);
+        Report("SAI", Simulate(link, messageCount, false), messageCount);
+        Report("RTT", Simulate(link, messageCount, true), messageCount);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the pool of worker threads used to run expensive
+ *      cryptographic work off the CHIP event loop.
+ */
+
+#include <platform/CryptoWorkerPool.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+CHIP_ERROR CryptoWorkerPool::Start(size_t threadCount)
+{
+    VerifyOrReturnError(threadCount > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    std::unique_lock<std::mutex> lock(mLock);
+    VerifyOrReturnError(!mRunning && mThreads.empty(), CHIP_ERROR_INCORRECT_STATE);
+
+    mRunning = true;
+    mThreads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        mThreads.emplace_back(&CryptoWorkerPool::WorkerMain, this);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void CryptoWorkerPool::Stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(mLock);
+        mRunning = false;
+    }
+    mWorkAvailable.notify_all();
+
+    // The workers drain the queue before exiting: queued items own references (e.g. CASE and PASE work helpers)
+    // that are only released by running them.
+    for (auto & thread : mThreads)
+    {
+        thread.join();
+    }
+    mThreads.clear();
+}
+
+CHIP_ERROR CryptoWorkerPool::Post(AsyncWorkFunct workFunct, intptr_t arg)
+{
+    VerifyOrReturnError(workFunct != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    {
+        std::unique_lock<std::mutex> lock(mLock);
+        VerifyOrReturnError(mRunning, CHIP_ERROR_INCORRECT_STATE);
+        mWorkQueue.push({ workFunct, arg });
+    }
+    mWorkAvailable.notify_one();
+
+    return CHIP_NO_ERROR;
+}
+
+bool CryptoWorkerPool::IsRunning()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    return mRunning;
+}
+
+void CryptoWorkerPool::WorkerMain()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    while (true)
+    {
+        mWorkAvailable.wait(lock, [this] { return !mRunning || !mWorkQueue.empty(); });
+        if (mWorkQueue.empty())
+        {
+            // Stopping, and nothing left to run.
+            return;
+        }
+
+        const WorkItem item = mWorkQueue.front();
+        mWorkQueue.pop();
+
+        lock.unlock();
+        item.workFunct(item.arg);
+        lock.lock();
+    }
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,98 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares a pool of worker threads used to run expensive
+ *      cryptographic work (signature verification, certificate chain
+ *      validation, key derivation) off the CHIP event loop.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <lib/core/CHIPCore.h>
+#include <platform/CHIPDeviceEvent.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ *  @class CryptoWorkerPool
+ *
+ *  @brief
+ *      A fixed set of worker threads fed from a single FIFO work queue. Work items run concurrently with each other and
+ *      with the CHIP event loop, so they must not touch stack state; results are handed back to the event loop with
+ *      PlatformManager::ScheduleWork.
+ *
+ */
+class CryptoWorkerPool
+{
+public:
+    CryptoWorkerPool() = default;
+    ~CryptoWorkerPool() { Stop(); }
+
+    /**
+     * Start threadCount worker threads.
+     *
+     * Returns CHIP_ERROR_INCORRECT_STATE if the pool is already running, and CHIP_ERROR_INVALID_ARGUMENT if threadCount is 0.
+     */
+    CHIP_ERROR Start(size_t threadCount);
+
+    /**
+     * Run the work items that are still queued, then join the worker threads. Work posted while stopping is rejected.
+     */
+    void Stop();
+
+    /**
+     * Queue workFunct(arg) to run on one of the worker threads. Safe to call from any thread.
+     *
+     * Returns CHIP_ERROR_INCORRECT_STATE if the pool is not running.
+     */
+    CHIP_ERROR Post(AsyncWorkFunct workFunct, intptr_t arg);
+
+    bool IsRunning();
+    size_t GetThreadCount() const { return mThreads.size(); }
+
+private:
+    struct WorkItem
+    {
+        AsyncWorkFunct workFunct;
+        intptr_t arg;
+    };
+
+    void WorkerMain();
+
+    std::vector<std::thread> mThreads;
+    std::queue<WorkItem> mWorkQueue;
+    std::mutex mLock;
+    std::condition_variable mWorkAvailable;
+    bool mRunning = false;
+
+    CryptoWorkerPool(const CryptoWorkerPool &)             = delete;
+    CryptoWorkerPool & operator=(const CryptoWorkerPool &) = delete;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
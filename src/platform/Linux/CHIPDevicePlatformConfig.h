@@ -68,6 +68,12 @@
 #define CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS 1
 #endif // CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
 
+// Use ChipLinuxStorageJournal instead of ChipLinuxStorage for the KeyValueStoreManager. Existing INI stores are
+// converted to journals on first use, which builds without the journal cannot read back.
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+
 #define CHIP_DEVICE_CONFIG_ENABLE_WIFI_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY_FULL 0
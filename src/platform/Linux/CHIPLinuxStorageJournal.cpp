@@ -0,0 +1,524 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides a log-structured implementation of the key-value store
+ *          used by KeyValueStoreManagerImpl on Linux.
+ *
+ *          Journal file layout:
+ *
+ *              "CHIPKVJ1" record*
+ *
+ *          where each record is:
+ *
+ *              type:u8 keyLen:u16 valueLen:u32 key value crc:u32
+ *
+ *          with little-endian integers, and crc being the CRC-32 (IEEE 802.3)
+ *          of all the preceding bytes of the record.
+ */
+
+#include <platform/Linux/CHIPLinuxStorageJournal.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <sstream>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <inipp/inipp.h>
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/Base64.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/IniEscaping.h>
+#include <lib/support/TemporaryFileStream.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr char kMagic[]            = { 'C', 'H', 'I', 'P', 'K', 'V', 'J', '1' };
+constexpr size_t kMagicSize        = sizeof(kMagic);
+constexpr size_t kRecordHeaderSize = 1 + 2 + 4;
+constexpr size_t kRecordCrcSize    = 4;
+
+// The journal is only compacted once it is both this large and mostly garbage, so that small
+// stores are never rewritten.
+constexpr size_t kMinCompactionSize = 64 * 1024;
+
+// Same limit as ChipLinuxStorage, whose files are imported by this class.
+constexpr size_t kMaxValueSize = 5 * 1024;
+
+enum RecordType : uint8_t
+{
+    kRecordPut    = 1,
+    kRecordDelete = 2,
+};
+
+uint32_t Crc32(const uint8_t * data, size_t len)
+{
+    static const auto sTable = [] {
+        struct
+        {
+            uint32_t entries[256];
+        } table = {};
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            table.entries[i] = c;
+        }
+        return table;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc = sTable.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+size_t RecordSize(size_t keyLen, size_t valueLen)
+{
+    return kRecordHeaderSize + keyLen + valueLen + kRecordCrcSize;
+}
+
+void AppendRecord(std::vector<uint8_t> & out, RecordType type, const std::string & key, const uint8_t * value, size_t valueLen)
+{
+    const size_t start = out.size();
+    out.resize(start + RecordSize(key.size(), valueLen));
+
+    uint8_t * p = out.data() + start;
+    Encoding::Write8(p, type);
+    Encoding::LittleEndian::Write16(p, static_cast<uint16_t>(key.size()));
+    Encoding::LittleEndian::Write32(p, static_cast<uint32_t>(valueLen));
+    memcpy(p, key.data(), key.size());
+    p += key.size();
+    if (valueLen > 0)
+    {
+        memcpy(p, value, valueLen);
+        p += valueLen;
+    }
+    Encoding::LittleEndian::Write32(p, Crc32(out.data() + start, static_cast<size_t>(p - (out.data() + start))));
+}
+
+CHIP_ERROR WriteAll(int fd, const uint8_t * data, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t rv = write(fd, data, len);
+        if (rv < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(rv > 0, CHIP_ERROR_POSIX(errno != 0 ? errno : EIO));
+        data += rv;
+        len -= static_cast<size_t>(rv);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ReadFile(const std::string & path, std::vector<uint8_t> & contents)
+{
+    contents.clear();
+
+    FileDescriptor fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd.Get() == -1)
+    {
+        // A missing file is an empty store.
+        return (errno == ENOENT) ? CHIP_NO_ERROR : CHIP_ERROR_POSIX(errno);
+    }
+
+    struct stat st;
+    VerifyOrReturnError(fstat(fd.Get(), &st) == 0, CHIP_ERROR_POSIX(errno));
+    contents.resize(static_cast<size_t>(st.st_size));
+
+    size_t total = 0;
+    while (total < contents.size())
+    {
+        ssize_t rv = read(fd.Get(), contents.data() + total, contents.size() - total);
+        if (rv < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(rv >= 0, CHIP_ERROR_POSIX(errno));
+        if (rv == 0)
+        {
+            break;
+        }
+        total += static_cast<size_t>(rv);
+    }
+    contents.resize(total);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+ChipLinuxStorageJournal::~ChipLinuxStorageJournal()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    if (mInitialized)
+    {
+        CommitLocked();
+    }
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::Init(const char * journalFile)
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    VerifyOrReturnError(journalFile != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (mInitialized)
+    {
+        ChipLogProgress(DeviceLayer, "ChipLinuxStorageJournal::Init: Attempt to re-initialize with KVS journal: %s", journalFile);
+        return CHIP_NO_ERROR;
+    }
+
+    mPath = journalFile;
+    mValues.clear();
+    mPendingRecords.clear();
+    mLiveSize = kMagicSize;
+
+    std::vector<uint8_t> contents;
+    ReturnErrorOnFailure(ReadFile(mPath, contents));
+
+    if (contents.size() >= kMagicSize && memcmp(contents.data(), kMagic, kMagicSize) == 0)
+    {
+        size_t validSize;
+        ReturnErrorOnFailure(Replay(contents, validSize));
+        ReturnErrorOnFailure(OpenForAppend());
+
+        if (validSize < contents.size())
+        {
+            // The tail is a record that was being written when the process stopped; it was never
+            // committed, so drop it before appending anything after it.
+            ChipLogError(DeviceLayer, "Discarding %u bytes of incomplete journal records in %s",
+                         static_cast<unsigned>(contents.size() - validSize), mPath.c_str());
+            VerifyOrReturnError(ftruncate(mFd.Get(), static_cast<off_t>(validSize)) == 0, CHIP_ERROR_POSIX(errno));
+            VerifyOrReturnError(fdatasync(mFd.Get()) == 0, CHIP_ERROR_POSIX(errno));
+        }
+        mFileSize = validSize;
+    }
+    else
+    {
+        // Either a new store, or one written by ChipLinuxStorage: write out a fresh journal.
+        const bool isJournalPrefix = contents.size() < kMagicSize && std::equal(contents.begin(), contents.end(), kMagic);
+        if (!isJournalPrefix)
+        {
+            ReturnErrorOnFailure(ImportIni(contents));
+        }
+        ReturnErrorOnFailure(CompactLocked(lock));
+    }
+
+    mInitialized = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::Replay(const std::vector<uint8_t> & contents, size_t & validSize)
+{
+    size_t offset = kMagicSize;
+
+    while (contents.size() - offset >= kRecordHeaderSize + kRecordCrcSize)
+    {
+        const uint8_t * p       = contents.data() + offset;
+        const uint8_t type      = Encoding::Read8(p);
+        const uint16_t keyLen   = Encoding::LittleEndian::Read16(p);
+        const uint32_t valueLen = Encoding::LittleEndian::Read32(p);
+
+        const size_t recordSize = RecordSize(keyLen, valueLen);
+        if (valueLen > kMaxValueSize || contents.size() - offset < recordSize)
+        {
+            break;
+        }
+
+        const uint8_t * crcPosition = contents.data() + offset + recordSize - kRecordCrcSize;
+        if (Encoding::LittleEndian::Get32(crcPosition) != Crc32(contents.data() + offset, recordSize - kRecordCrcSize))
+        {
+            break;
+        }
+
+        std::string key(reinterpret_cast<const char *>(p), keyLen);
+        p += keyLen;
+        if (type == kRecordPut)
+        {
+            ApplyPut(std::move(key), std::vector<uint8_t>(p, p + valueLen));
+        }
+        else if (type == kRecordDelete)
+        {
+            ApplyDelete(key);
+        }
+        else
+        {
+            break;
+        }
+
+        offset += recordSize;
+    }
+
+    validSize = offset;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::ImportIni(const std::vector<uint8_t> & contents)
+{
+    std::istringstream stream(std::string(contents.begin(), contents.end()));
+    inipp::Ini<char> ini;
+    ini.parse(stream);
+
+    auto section = ini.sections.find("DEFAULT");
+    VerifyOrReturnError(section != ini.sections.end(), CHIP_NO_ERROR);
+
+    for (const auto & entry : section->second)
+    {
+        std::string key             = IniEscaping::UnescapeKey(entry.first);
+        const std::string & encoded = entry.second;
+        VerifyOrReturnError(!key.empty() && encoded.size() <= UINT16_MAX, CHIP_ERROR_DECODE_FAILED);
+
+        std::vector<uint8_t> value(BASE64_MAX_DECODED_LEN(encoded.size()));
+        uint16_t decodedLen = Base64Decode(encoded.data(), static_cast<uint16_t>(encoded.size()), value.data());
+        VerifyOrReturnError(decodedLen != UINT16_MAX, CHIP_ERROR_DECODE_FAILED);
+        value.resize(decodedLen);
+
+        ApplyPut(std::move(key), std::move(value));
+    }
+
+    ChipLogProgress(DeviceLayer, "Converting %u values in %s to a KVS journal", static_cast<unsigned>(mValues.size()),
+                    mPath.c_str());
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxStorageJournal::ApplyPut(std::string key, std::vector<uint8_t> value)
+{
+    mLiveSize += RecordSize(key.size(), value.size());
+
+    auto it = mValues.find(key);
+    if (it != mValues.end())
+    {
+        mLiveSize -= RecordSize(it->first.size(), it->second.size());
+        it->second = std::move(value);
+    }
+    else
+    {
+        mValues.emplace(std::move(key), std::move(value));
+    }
+}
+
+void ChipLinuxStorageJournal::ApplyDelete(const std::string & key)
+{
+    auto it = mValues.find(key);
+    if (it != mValues.end())
+    {
+        mLiveSize -= RecordSize(it->first.size(), it->second.size());
+        mValues.erase(it);
+    }
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t & outLen)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    auto it = mValues.find(key);
+    VerifyOrReturnError(it != mValues.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+    outLen = it->second.size();
+    VerifyOrReturnError(outLen <= bufSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+    if (outLen > 0)
+    {
+        memcpy(buf, it->second.data(), outLen);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::WriteValueBin(const char * key, const uint8_t * data, size_t dataLen)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+
+    std::string keyString(key);
+    VerifyOrReturnError(!keyString.empty() && keyString.size() <= UINT16_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(dataLen <= kMaxValueSize, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(data != nullptr || dataLen == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    QueueRecord(kRecordPut, keyString, data, dataLen);
+    ApplyPut(std::move(keyString), std::vector<uint8_t>(data, data + dataLen));
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::ClearValue(const char * key)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+
+    std::string keyString(key);
+    VerifyOrReturnError(mValues.find(keyString) != mValues.end(), CHIP_ERROR_KEY_NOT_FOUND);
+
+    QueueRecord(kRecordDelete, keyString, nullptr, 0);
+    ApplyDelete(keyString);
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxStorageJournal::QueueRecord(uint8_t type, const std::string & key, const uint8_t * value, size_t valueLen)
+{
+    AppendRecord(mPendingRecords, static_cast<RecordType>(type), key, value, valueLen);
+    if (mCompacting)
+    {
+        AppendRecord(mRecordsSinceSnapshot, static_cast<RecordType>(type), key, value, valueLen);
+    }
+}
+
+bool ChipLinuxStorageJournal::HasValue(const char * key)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return mValues.find(key) != mValues.end();
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::Commit()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+    return CommitLocked();
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::CommitLocked()
+{
+    VerifyOrReturnError(!mPendingRecords.empty(), CHIP_NO_ERROR);
+
+    CHIP_ERROR err = WriteAll(mFd.Get(), mPendingRecords.data(), mPendingRecords.size());
+    if (err == CHIP_NO_ERROR && fdatasync(mFd.Get()) != 0)
+    {
+        err = CHIP_ERROR_POSIX(errno);
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        // Keep the records queued, and cut off whatever part of them made it into the file so that
+        // the next attempt does not leave a corrupt record in the middle of the journal.
+        ChipLogError(DeviceLayer, "Failed to commit KVS journal %s: %" CHIP_ERROR_FORMAT, mPath.c_str(), err.Format());
+        if (ftruncate(mFd.Get(), static_cast<off_t>(mFileSize)) != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to truncate KVS journal %s: %s", mPath.c_str(), strerror(errno));
+        }
+        return err;
+    }
+
+    mFileSize += mPendingRecords.size();
+    mPendingRecords.clear();
+    return CHIP_NO_ERROR;
+}
+
+bool ChipLinuxStorageJournal::NeedsCompaction()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    const size_t journalSize = mFileSize + mPendingRecords.size();
+    return mInitialized && journalSize >= kMinCompactionSize && journalSize / 2 > mLiveSize;
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::Compact()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INCORRECT_STATE);
+    return CompactLocked(lock);
+}
+
+// Same approach as ChipLinuxStorageIni::CommitConfig(): write the snapshot to a temporary file,
+// sync it, and rename() it over the journal. The lock is released while the snapshot is written,
+// so that reads and writes are not held up by the disk; records queued in the meantime are
+// appended to the snapshot before it replaces the journal.
+CHIP_ERROR ChipLinuxStorageJournal::CompactLocked(std::unique_lock<std::mutex> & lock)
+{
+    VerifyOrReturnError(!mCompacting, CHIP_NO_ERROR);
+
+    std::vector<uint8_t> snapshot;
+    snapshot.reserve(mLiveSize);
+    snapshot.insert(snapshot.end(), kMagic, kMagic + kMagicSize);
+    for (const auto & entry : mValues)
+    {
+        AppendRecord(snapshot, kRecordPut, entry.first, entry.second.data(), entry.second.size());
+    }
+    mCompacting             = true;
+    const size_t sizeBefore = mFileSize + mPendingRecords.size();
+
+    lock.unlock();
+    TemporaryFileStream tmpFile(mPath + "-XXXXXX");
+    const bool opened = tmpFile.IsOpen();
+    if (opened)
+    {
+        tmpFile.write(reinterpret_cast<const char *>(snapshot.data()), static_cast<std::streamsize>(snapshot.size()));
+        tmpFile.flush();
+    }
+    const bool written   = opened && !tmpFile.fail() && tmpFile.DataSync();
+    const int writeErrno = errno;
+    lock.lock();
+
+    mCompacting                                     = false;
+    const std::vector<uint8_t> recordsSinceSnapshot = std::move(mRecordsSinceSnapshot);
+    mRecordsSinceSnapshot.clear();
+
+    VerifyOrReturnError(opened, CHIP_ERROR_OPEN_FAILED,
+                        ChipLogError(DeviceLayer, "Failed to create temp file %s: %s", tmpFile.GetFileName().c_str(),
+                                     strerror(writeErrno)));
+    VerifyOrReturnError(written, CHIP_ERROR_WRITE_FAILED, unlink(tmpFile.GetFileName().c_str());
+                        ChipLogError(DeviceLayer, "Failed to write temp file %s: %s", tmpFile.GetFileName().c_str(),
+                                     strerror(writeErrno)));
+
+    // Values changed during the write, whether committed to the old journal since or not, are only in these records.
+    if (!recordsSinceSnapshot.empty())
+    {
+        tmpFile.write(reinterpret_cast<const char *>(recordsSinceSnapshot.data()),
+                      static_cast<std::streamsize>(recordsSinceSnapshot.size()));
+        tmpFile.flush();
+        VerifyOrReturnError(!tmpFile.fail() && tmpFile.DataSync(), CHIP_ERROR_WRITE_FAILED, unlink(tmpFile.GetFileName().c_str());
+                            ChipLogError(DeviceLayer, "Failed to write temp file %s: %s", tmpFile.GetFileName().c_str(),
+                                         strerror(errno)));
+    }
+
+    int rv = rename(tmpFile.GetFileName().c_str(), mPath.c_str());
+    VerifyOrReturnError(rv == 0, CHIP_ERROR_WRITE_FAILED, unlink(tmpFile.GetFileName().c_str());
+                        ChipLogError(DeviceLayer, "Failed to rename %s to %s: %s", tmpFile.GetFileName().c_str(),
+                                     mPath.c_str(), strerror(errno)));
+
+    mFileSize = snapshot.size() + recordsSinceSnapshot.size();
+    ChipLogDetail(DeviceLayer, "Compacted KVS journal %s from %u to %u bytes", mPath.c_str(), static_cast<unsigned>(sizeBefore),
+                  static_cast<unsigned>(mFileSize));
+
+    mPendingRecords.clear();
+    return OpenForAppend();
+}
+
+CHIP_ERROR ChipLinuxStorageJournal::OpenForAppend()
+{
+    mFd = FileDescriptor(open(mPath.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC));
+    VerifyOrReturnError(mFd.Get() != -1, CHIP_ERROR_OPEN_FAILED,
+                        ChipLogError(DeviceLayer, "Failed to open KVS journal %s: %s", mPath.c_str(), strerror(errno)));
+    return CHIP_NO_ERROR;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
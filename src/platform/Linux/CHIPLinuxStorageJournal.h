@@ -0,0 +1,130 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file defines a log-structured key-value store for Linux, used by
+ *         KeyValueStoreManagerImpl when CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL is set.
+ *
+ *         All values are kept in memory. Writes are encoded as records and appended
+ *         to a journal file by Commit(), so that a batch of writes costs one append
+ *         and one fdatasync() instead of a rewrite of the whole store per write.
+ *         Compact() replaces the journal with a snapshot of the live values once
+ *         overwritten and deleted records make up most of it.
+ *
+ *         Each record carries a CRC-32, and Init() replays the journal up to the
+ *         first incomplete or corrupt record, which it truncates away: a crash
+ *         loses at most the writes that were not yet committed. A file in the INI
+ *         format of ChipLinuxStorage is converted to a journal on first use.
+ *
+ *         That conversion is one-way: the INI file is replaced, and ChipLinuxStorage
+ *         cannot read a journal, so a build without CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+ *         would not find any of the stored values. Back up the file before enabling the
+ *         journal on a device that may be downgraded.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/FileDescriptor.h>
+
+#include <map>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxStorageJournal
+{
+public:
+    ChipLinuxStorageJournal() = default;
+    ~ChipLinuxStorageJournal();
+
+    ChipLinuxStorageJournal(const ChipLinuxStorageJournal &)             = delete;
+    ChipLinuxStorageJournal & operator=(const ChipLinuxStorageJournal &) = delete;
+
+    CHIP_ERROR Init(const char * journalFile);
+
+    /**
+     * Same contract as ChipLinuxStorage::ReadValueBin(): on CHIP_ERROR_BUFFER_TOO_SMALL, outLen is
+     * set to the size of the value.
+     */
+    CHIP_ERROR ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t & outLen);
+
+    /**
+     * Update the value in memory and queue it for the next Commit().
+     */
+    CHIP_ERROR WriteValueBin(const char * key, const uint8_t * data, size_t dataLen);
+
+    /**
+     * Remove the value from memory and queue the removal for the next Commit().
+     *
+     * @retval CHIP_ERROR_KEY_NOT_FOUND if there is no value for the key.
+     */
+    CHIP_ERROR ClearValue(const char * key);
+
+    bool HasValue(const char * key);
+
+    /**
+     * Append the queued writes to the journal and sync it to storage.
+     */
+    CHIP_ERROR Commit();
+
+    /**
+     * Whether most of the journal is made of overwritten or deleted values.
+     */
+    bool NeedsCompaction();
+
+    /**
+     * Atomically replace the journal with a snapshot of the current values. Queued writes are
+     * included in the snapshot. The store remains usable from other threads while the snapshot
+     * is written and synced; the writes they make in the meantime are carried over to the new
+     * journal.
+     */
+    CHIP_ERROR Compact();
+
+private:
+    CHIP_ERROR Replay(const std::vector<uint8_t> & contents, size_t & validSize);
+    CHIP_ERROR ImportIni(const std::vector<uint8_t> & contents);
+    CHIP_ERROR CommitLocked();
+    CHIP_ERROR CompactLocked(std::unique_lock<std::mutex> & lock);
+    CHIP_ERROR OpenForAppend();
+    void QueueRecord(uint8_t type, const std::string & key, const uint8_t * value, size_t valueLen);
+    void ApplyPut(std::string key, std::vector<uint8_t> value);
+    void ApplyDelete(const std::string & key);
+
+    std::mutex mLock;
+    std::string mPath;
+    FileDescriptor mFd;
+    std::map<std::string, std::vector<uint8_t>> mValues;
+    std::vector<uint8_t> mPendingRecords;       // Encoded records not yet written to the journal
+    std::vector<uint8_t> mRecordsSinceSnapshot; // Encoded records queued while Compact() writes its snapshot
+    size_t mFileSize  = 0;                      // Bytes of the journal file that hold valid records
+    size_t mLiveSize  = 0;                      // Bytes a snapshot of mValues would take
+    bool mCompacting  = false;
+    bool mInitialized = false;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
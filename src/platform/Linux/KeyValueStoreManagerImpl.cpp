@@ -29,6 +29,7 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/CHIPDeviceLayer.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -83,9 +84,13 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value,
     err = mStorage.WriteValueBin(key, reinterpret_cast<const uint8_t *>(value), value_size);
     SuccessOrExit(err);
 
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+    ScheduleCommit();
+#else
     // Commit the value to the persistent store.
     err = mStorage.Commit();
     SuccessOrExit(err);
+#endif
 
 exit:
     return err;
@@ -102,14 +107,70 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
     }
     SuccessOrExit(err);
 
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+    ScheduleCommit();
+#else
     // Commit the value to the persistent store.
     err = mStorage.Commit();
     SuccessOrExit(err);
+#endif
 
 exit:
     return err;
 }
 
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+void KeyValueStoreManagerImpl::ScheduleCommit()
+{
+    // Writes made before the next event loop turn share a single append and sync of the journal.
+    // Without a running System Layer there is no turn to wait for, so commit right away.
+    if (!DeviceLayer::SystemLayer().IsInitialized())
+    {
+        CommitPendingWrites(reinterpret_cast<intptr_t>(this));
+        return;
+    }
+
+    if (!mCommitScheduled.exchange(true) &&
+        PlatformMgr().ScheduleWork(CommitPendingWrites, reinterpret_cast<intptr_t>(this)) != CHIP_NO_ERROR)
+    {
+        CommitPendingWrites(reinterpret_cast<intptr_t>(this));
+    }
+}
+
+void KeyValueStoreManagerImpl::CommitPendingWrites(intptr_t arg)
+{
+    auto * self = reinterpret_cast<KeyValueStoreManagerImpl *>(arg);
+    self->mCommitScheduled.store(false);
+
+    CHIP_ERROR err = self->mStorage.Commit();
+    if (err != CHIP_NO_ERROR)
+    {
+        // The writes stay queued in the journal and go out with the next commit.
+        ChipLogError(DeviceLayer, "Failed to commit KVS writes: %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
+
+    if (self->mStorage.NeedsCompaction() && PlatformMgr().ScheduleBackgroundWork(CompactJournal, arg) != CHIP_NO_ERROR)
+    {
+        CompactJournal(arg);
+    }
+}
+
+void KeyValueStoreManagerImpl::CompactJournal(intptr_t arg)
+{
+    auto * self = reinterpret_cast<KeyValueStoreManagerImpl *>(arg);
+
+    // Checked again, as several compactions may have been scheduled before the first one ran.
+    VerifyOrReturn(self->mStorage.NeedsCompaction());
+
+    CHIP_ERROR err = self->mStorage.Compact();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to compact KVS journal: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
@@ -24,6 +24,11 @@
 #pragma once
 
 #include <platform/Linux/CHIPLinuxStorage.h>
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+#include <platform/Linux/CHIPLinuxStorageJournal.h>
+
+#include <atomic>
+#endif
 
 namespace chip {
 namespace DeviceLayer {
@@ -43,7 +48,17 @@ public:
     CHIP_ERROR _Put(const char * key, const void * value, size_t value_size);
 
 private:
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_JOURNAL
+    // Writes are committed together once per event loop turn, and the journal is compacted in the background.
+    void ScheduleCommit();
+    static void CommitPendingWrites(intptr_t arg);
+    static void CompactJournal(intptr_t arg);
+
+    DeviceLayer::Internal::ChipLinuxStorageJournal mStorage;
+    std::atomic<bool> mCommitScheduled{ false };
+#else
     DeviceLayer::Internal::ChipLinuxStorage mStorage;
+#endif
 
     // ===== Members for internal use by the following friends.
     friend KeyValueStoreManager & KeyValueStoreMgr();
@@ -0,0 +1,184 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the pool of crypto worker threads.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <platform/CryptoWorkerPool.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+void Count(intptr_t arg)
+{
+    reinterpret_cast<std::atomic<unsigned> *>(arg)->fetch_add(1);
+}
+
+// Work items that wait for each other, to show that they run on different threads.
+struct Rendezvous
+{
+    std::mutex lock;
+    std::condition_variable arrived;
+    unsigned count = 0;
+    unsigned met   = 0;
+
+    static void Meet(intptr_t arg)
+    {
+        auto * self = reinterpret_cast<Rendezvous *>(arg);
+        std::unique_lock<std::mutex> lock(self->lock);
+        self->count++;
+        self->arrived.notify_all();
+        if (self->arrived.wait_for(lock, std::chrono::seconds(5), [self] { return self->count >= 2; }))
+        {
+            self->met++;
+        }
+    }
+};
+
+// A work item that holds its worker until released.
+struct Gate
+{
+    std::mutex lock;
+    std::condition_variable changed;
+    bool entered = false;
+    bool open    = false;
+
+    static void Wait(intptr_t arg)
+    {
+        auto * self = reinterpret_cast<Gate *>(arg);
+        std::unique_lock<std::mutex> lock(self->lock);
+        self->entered = true;
+        self->changed.notify_all();
+        self->changed.wait(lock, [self] { return self->open; });
+    }
+
+    void WaitUntilEntered()
+    {
+        std::unique_lock<std::mutex> lock(this->lock);
+        changed.wait(lock, [this] { return entered; });
+    }
+
+    void Open()
+    {
+        std::unique_lock<std::mutex> lock(this->lock);
+        open = true;
+        changed.notify_all();
+    }
+};
+
+TEST(TestCryptoWorkerPool, StartArguments)
+{
+    CryptoWorkerPool pool;
+    EXPECT_FALSE(pool.IsRunning());
+    EXPECT_EQ(pool.Start(0), CHIP_ERROR_INVALID_ARGUMENT);
+    EXPECT_FALSE(pool.IsRunning());
+
+    EXPECT_EQ(pool.Start(2), CHIP_NO_ERROR);
+    EXPECT_TRUE(pool.IsRunning());
+    EXPECT_EQ(pool.GetThreadCount(), 2u);
+    EXPECT_EQ(pool.Start(1), CHIP_ERROR_INCORRECT_STATE);
+    EXPECT_EQ(pool.Post(nullptr, 0), CHIP_ERROR_INVALID_ARGUMENT);
+
+    pool.Stop();
+    EXPECT_FALSE(pool.IsRunning());
+    EXPECT_EQ(pool.GetThreadCount(), 0u);
+}
+
+TEST(TestCryptoWorkerPool, RunsAllWork)
+{
+    constexpr unsigned kWorkCount = 100;
+    std::atomic<unsigned> count{ 0 };
+
+    CryptoWorkerPool pool;
+    ASSERT_EQ(pool.Start(3), CHIP_NO_ERROR);
+    for (unsigned i = 0; i < kWorkCount; i++)
+    {
+        EXPECT_EQ(pool.Post(Count, reinterpret_cast<intptr_t>(&count)), CHIP_NO_ERROR);
+    }
+    pool.Stop();
+
+    EXPECT_EQ(count.load(), kWorkCount);
+}
+
+TEST(TestCryptoWorkerPool, RunsWorkConcurrently)
+{
+    Rendezvous rendezvous;
+
+    CryptoWorkerPool pool;
+    ASSERT_EQ(pool.Start(2), CHIP_NO_ERROR);
+    EXPECT_EQ(pool.Post(Rendezvous::Meet, reinterpret_cast<intptr_t>(&rendezvous)), CHIP_NO_ERROR);
+    EXPECT_EQ(pool.Post(Rendezvous::Meet, reinterpret_cast<intptr_t>(&rendezvous)), CHIP_NO_ERROR);
+    pool.Stop();
+
+    EXPECT_EQ(rendezvous.met, 2u);
+}
+
+TEST(TestCryptoWorkerPool, StopRunsQueuedWork)
+{
+    // Queued items own references (e.g. to CASE and PASE work helpers) that are only released by running them.
+    std::atomic<unsigned> count{ 0 };
+    Gate gate;
+
+    CryptoWorkerPool pool;
+    ASSERT_EQ(pool.Start(1), CHIP_NO_ERROR);
+    EXPECT_EQ(pool.Post(Gate::Wait, reinterpret_cast<intptr_t>(&gate)), CHIP_NO_ERROR);
+    gate.WaitUntilEntered();
+
+    // The only worker is busy, so these stay queued.
+    for (unsigned i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(pool.Post(Count, reinterpret_cast<intptr_t>(&count)), CHIP_NO_ERROR);
+    }
+    EXPECT_EQ(count.load(), 0u);
+
+    gate.Open();
+    pool.Stop();
+    EXPECT_EQ(count.load(), 5u);
+}
+
+TEST(TestCryptoWorkerPool, PostAfterStop)
+{
+    std::atomic<unsigned> count{ 0 };
+
+    CryptoWorkerPool pool;
+    EXPECT_EQ(pool.Post(Count, reinterpret_cast<intptr_t>(&count)), CHIP_ERROR_INCORRECT_STATE);
+
+    ASSERT_EQ(pool.Start(1), CHIP_NO_ERROR);
+    pool.Stop();
+    EXPECT_EQ(pool.Post(Count, reinterpret_cast<intptr_t>(&count)), CHIP_ERROR_INCORRECT_STATE);
+
+    // And the pool can be started again.
+    ASSERT_EQ(pool.Start(1), CHIP_NO_ERROR);
+    EXPECT_EQ(pool.Post(Count, reinterpret_cast<intptr_t>(&count)), CHIP_NO_ERROR);
+    pool.Stop();
+    EXPECT_EQ(count.load(), 1u);
+}
+
+} // namespace
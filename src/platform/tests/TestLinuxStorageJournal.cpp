@@ -0,0 +1,380 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the journaling key-value
+ *      store of the Linux platform, including recovery from a process that is
+ *      killed while it is writing.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPMem.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/Linux/CHIPLinuxStorageJournal.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+constexpr size_t kKeyCount  = 16;
+constexpr size_t kValueSize = 1024;
+
+std::string KeyFor(uint32_t sequence)
+{
+    return "key/" + std::to_string(sequence % kKeyCount);
+}
+
+// Fill a value so that any torn or misplaced write is detected, and so that the sequence number that wrote it can be read back.
+std::vector<uint8_t> ValueFor(uint32_t sequence)
+{
+    std::vector<uint8_t> value(kValueSize);
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        value[i] = static_cast<uint8_t>((sequence >> (8 * (i % 4))) + i / 4);
+    }
+    return value;
+}
+
+uint32_t SequenceOf(const std::vector<uint8_t> & value)
+{
+    return static_cast<uint32_t>(value[0]) | (static_cast<uint32_t>(value[1]) << 8) | (static_cast<uint32_t>(value[2]) << 16) |
+        (static_cast<uint32_t>(value[3]) << 24);
+}
+
+std::vector<uint8_t> ReadFileContents(const std::string & path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void WriteFileContents(const std::string & path, const uint8_t * data, size_t size)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+}
+
+bool ReadValue(ChipLinuxStorageJournal & journal, const char * key, std::vector<uint8_t> & value)
+{
+    value.resize(kValueSize);
+    size_t size = 0;
+    if (journal.ReadValueBin(key, value.data(), value.size(), size) != CHIP_NO_ERROR)
+    {
+        return false;
+    }
+    value.resize(size);
+    return true;
+}
+
+CHIP_ERROR Put(ChipLinuxStorageJournal & journal, const char * key, const char * value)
+{
+    return journal.WriteValueBin(key, reinterpret_cast<const uint8_t *>(value), strlen(value));
+}
+
+std::string GetString(ChipLinuxStorageJournal & journal, const char * key)
+{
+    std::vector<uint8_t> value;
+    return ReadValue(journal, key, value) ? std::string(value.begin(), value.end()) : std::string("<missing>");
+}
+
+class TestLinuxStorageJournal : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite() { ASSERT_EQ(chip::Platform::MemoryInit(), CHIP_NO_ERROR); }
+    static void TearDownTestSuite() { chip::Platform::MemoryShutdown(); }
+
+protected:
+    void SetUp() override
+    {
+        char dirTemplate[] = "/tmp/chip-kvs-journal-XXXXXX";
+        ASSERT_NE(mkdtemp(dirTemplate), nullptr);
+        mDir  = dirTemplate;
+        mPath = mDir + "/kvs";
+    }
+
+    void TearDown() override
+    {
+        std::string command = "rm -rf " + mDir;
+        EXPECT_EQ(system(command.c_str()), 0);
+    }
+
+    std::string mDir;
+    std::string mPath;
+    uint32_t mLastSequence = 0;
+};
+
+TEST_F(TestLinuxStorageJournal, PutGetDelete)
+{
+    {
+        ChipLinuxStorageJournal journal;
+        ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+        EXPECT_EQ(Put(journal, "a", "first"), CHIP_NO_ERROR);
+        EXPECT_EQ(Put(journal, "b", "second"), CHIP_NO_ERROR);
+        EXPECT_EQ(Put(journal, "a", "third"), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.WriteValueBin("empty", nullptr, 0), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.ClearValue("b"), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.ClearValue("b"), CHIP_ERROR_KEY_NOT_FOUND);
+
+        // Uncommitted writes are visible right away.
+        EXPECT_EQ(GetString(journal, "a"), "third");
+        EXPECT_FALSE(journal.HasValue("b"));
+
+        uint8_t small[2];
+        size_t size = 0;
+        EXPECT_EQ(journal.ReadValueBin("a", small, sizeof(small), size), CHIP_ERROR_BUFFER_TOO_SMALL);
+        EXPECT_EQ(size, 5u);
+        EXPECT_EQ(journal.ReadValueBin("missing", small, sizeof(small), size), CHIP_ERROR_KEY_NOT_FOUND);
+
+        EXPECT_EQ(journal.Commit(), CHIP_NO_ERROR);
+    }
+
+    ChipLinuxStorageJournal journal;
+    ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(GetString(journal, "a"), "third");
+    EXPECT_EQ(GetString(journal, "empty"), "");
+    EXPECT_FALSE(journal.HasValue("b"));
+}
+
+TEST_F(TestLinuxStorageJournal, Compaction)
+{
+    {
+        ChipLinuxStorageJournal journal;
+        ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+        for (uint32_t sequence = 0; !journal.NeedsCompaction(); sequence++)
+        {
+            std::vector<uint8_t> value = ValueFor(sequence);
+            ASSERT_EQ(journal.WriteValueBin(KeyFor(sequence).c_str(), value.data(), value.size()), CHIP_NO_ERROR);
+            ASSERT_EQ(journal.Commit(), CHIP_NO_ERROR);
+        }
+        EXPECT_EQ(Put(journal, "pending", "value"), CHIP_NO_ERROR);
+
+        const size_t sizeBefore = ReadFileContents(mPath).size();
+        EXPECT_EQ(journal.Compact(), CHIP_NO_ERROR);
+        EXPECT_LT(ReadFileContents(mPath).size(), sizeBefore / 2);
+        EXPECT_FALSE(journal.NeedsCompaction());
+
+        // The journal keeps working after being replaced.
+        EXPECT_EQ(Put(journal, "after", "compaction"), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Commit(), CHIP_NO_ERROR);
+    }
+
+    ChipLinuxStorageJournal journal;
+    ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(GetString(journal, "pending"), "value");
+    EXPECT_EQ(GetString(journal, "after"), "compaction");
+    for (size_t i = 0; i < kKeyCount; i++)
+    {
+        EXPECT_TRUE(journal.HasValue(KeyFor(static_cast<uint32_t>(i)).c_str()));
+    }
+}
+
+TEST_F(TestLinuxStorageJournal, WritesDuringCompaction)
+{
+    {
+        ChipLinuxStorageJournal journal;
+        ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+        // Compact over and over in the background, while values are written, committed and read back.
+        std::atomic<bool> done{ false };
+        std::atomic<unsigned> compactions{ 0 };
+        std::thread compactor([&] {
+            while (!done.load())
+            {
+                EXPECT_EQ(journal.Compact(), CHIP_NO_ERROR);
+                compactions++;
+            }
+        });
+
+        std::vector<uint8_t> value;
+        for (uint32_t sequence = 0; sequence < 2000 || compactions.load() < 2; sequence++)
+        {
+            std::vector<uint8_t> written = ValueFor(sequence);
+            ASSERT_EQ(journal.WriteValueBin(KeyFor(sequence).c_str(), written.data(), written.size()), CHIP_NO_ERROR);
+            if (sequence % 3 == 0)
+            {
+                ASSERT_EQ(journal.Commit(), CHIP_NO_ERROR);
+            }
+            ASSERT_TRUE(ReadValue(journal, KeyFor(sequence).c_str(), value));
+            EXPECT_EQ(value, written);
+            mLastSequence = sequence;
+        }
+        done = true;
+        compactor.join();
+        EXPECT_EQ(journal.Commit(), CHIP_NO_ERROR);
+    }
+
+    // Every write made during a compaction is in the new journal.
+    ChipLinuxStorageJournal journal;
+    ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+    for (uint32_t sequence = mLastSequence + 1 - kKeyCount; sequence <= mLastSequence; sequence++)
+    {
+        std::vector<uint8_t> value;
+        ASSERT_TRUE(ReadValue(journal, KeyFor(sequence).c_str(), value));
+        EXPECT_EQ(value, ValueFor(sequence));
+    }
+}
+
+TEST_F(TestLinuxStorageJournal, RecoverTornRecord)
+{
+    size_t committedSize;
+    {
+        ChipLinuxStorageJournal journal;
+        ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(Put(journal, "a", "committed"), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Commit(), CHIP_NO_ERROR);
+        committedSize = ReadFileContents(mPath).size();
+
+        EXPECT_EQ(Put(journal, "a", "overwritten"), CHIP_NO_ERROR);
+        EXPECT_EQ(Put(journal, "b", "added"), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Commit(), CHIP_NO_ERROR);
+    }
+    const std::vector<uint8_t> contents = ReadFileContents(mPath);
+
+    // Stop the last commit at every possible byte: everything up to the last complete record must be recovered.
+    for (size_t size = committedSize; size < contents.size(); size++)
+    {
+        WriteFileContents(mPath, contents.data(), size);
+
+        ChipLinuxStorageJournal journal;
+        ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+        const std::string a = GetString(journal, "a");
+        EXPECT_TRUE(a == "committed" || a == "overwritten");
+        EXPECT_FALSE(journal.HasValue("b"));
+
+        // The torn record is gone, so new records are readable after it.
+        EXPECT_EQ(Put(journal, "c", "recovered"), CHIP_NO_ERROR);
+        EXPECT_EQ(journal.Commit(), CHIP_NO_ERROR);
+
+        ChipLinuxStorageJournal reopened;
+        ASSERT_EQ(reopened.Init(mPath.c_str()), CHIP_NO_ERROR);
+        EXPECT_EQ(GetString(reopened, "a"), a);
+        EXPECT_EQ(GetString(reopened, "c"), "recovered");
+    }
+
+    // A record with a bad checksum ends the journal as well.
+    std::vector<uint8_t> corrupt = contents;
+    corrupt[corrupt.size() - 6] ^= 0x01;
+    WriteFileContents(mPath, corrupt.data(), corrupt.size());
+
+    ChipLinuxStorageJournal journal;
+    ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(GetString(journal, "a"), "overwritten");
+    EXPECT_FALSE(journal.HasValue("b"));
+}
+
+TEST_F(TestLinuxStorageJournal, ImportIniFile)
+{
+    {
+        ChipLinuxStorage legacy;
+        ASSERT_EQ(legacy.Init(mPath.c_str()), CHIP_NO_ERROR);
+        const uint8_t binary[] = { 0x00, 0xFF, 0x10, '=', '\n' };
+        EXPECT_EQ(legacy.WriteValueBin("g/a/k=1", binary, sizeof(binary)), CHIP_NO_ERROR);
+        EXPECT_EQ(legacy.WriteValueBin("plain", reinterpret_cast<const uint8_t *>("text"), 4), CHIP_NO_ERROR);
+        EXPECT_EQ(legacy.Commit(), CHIP_NO_ERROR);
+    }
+
+    ChipLinuxStorageJournal journal;
+    ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+    EXPECT_EQ(GetString(journal, "g/a/k=1"), std::string("\x00\xFF\x10=\n", 5));
+    EXPECT_EQ(GetString(journal, "plain"), "text");
+}
+
+TEST_F(TestLinuxStorageJournal, KillDuringWrites)
+{
+    int pipeFds[2];
+    ASSERT_EQ(pipe(pipeFds), 0);
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        // Write and commit as fast as possible, compacting now and then, reporting each commit to the parent.
+        close(pipeFds[0]);
+        ChipLinuxStorageJournal journal;
+        if (journal.Init(mPath.c_str()) != CHIP_NO_ERROR)
+        {
+            _exit(EXIT_FAILURE);
+        }
+        for (uint32_t sequence = 0;; sequence++)
+        {
+            std::vector<uint8_t> value = ValueFor(sequence);
+            if (journal.WriteValueBin(KeyFor(sequence).c_str(), value.data(), value.size()) != CHIP_NO_ERROR ||
+                journal.Commit() != CHIP_NO_ERROR || (journal.NeedsCompaction() && journal.Compact() != CHIP_NO_ERROR) ||
+                write(pipeFds[1], &sequence, sizeof(sequence)) != sizeof(sequence))
+            {
+                _exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    close(pipeFds[1]);
+    uint32_t lastCommitted = 0;
+    for (uint32_t received = 0; received < 2000; received++)
+    {
+        ASSERT_EQ(read(pipeFds[0], &lastCommitted, sizeof(lastCommitted)), static_cast<ssize_t>(sizeof(lastCommitted)));
+    }
+    kill(child, SIGKILL);
+    close(pipeFds[0]);
+
+    int status;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFSIGNALED(status));
+
+    ChipLinuxStorageJournal journal;
+    ASSERT_EQ(journal.Init(mPath.c_str()), CHIP_NO_ERROR);
+
+    // The store must hold exactly the writes of some prefix of the sequence, and that prefix must include every
+    // write that was reported as committed.
+    std::vector<uint8_t> values[kKeyCount];
+    uint32_t newest = 0;
+    for (size_t i = 0; i < kKeyCount; i++)
+    {
+        ASSERT_TRUE(ReadValue(journal, KeyFor(static_cast<uint32_t>(i)).c_str(), values[i]));
+        newest = std::max(newest, SequenceOf(values[i]));
+    }
+    EXPECT_GE(newest, lastCommitted);
+    for (size_t i = 0; i < kKeyCount; i++)
+    {
+        const uint32_t expected = newest - static_cast<uint32_t>((newest - i) % kKeyCount);
+        EXPECT_EQ(values[i], ValueFor(expected));
+    }
+
+    EXPECT_EQ(Put(journal, "after", "crash"), CHIP_NO_ERROR);
+    EXPECT_EQ(journal.Commit(), CHIP_NO_ERROR);
+}
+
+} // namespace
@@ -40,6 +40,7 @@
 #include <lib/support/SafeInt.h>
 #include <lib/support/TypeTraits.h>
 #include <messaging/SessionParameters.h>
+#include <platform/PlatformManager.h>
 #include <protocols/Protocols.h>
 #include <protocols/secure_channel/Constants.h>
 #include <protocols/secure_channel/StatusReport.h>
@@ -58,6 +59,25 @@ const char kSpake2pContext[]        = "CHIP PAKE V1 Commissioning";
 const char kSpake2pI2RSessionInfo[] = "Commissioning I2R Key";
 const char kSpake2pR2ISessionInfo[] = "Commissioning R2I Key";
 
+struct PASESession::ComputeWSData
+{
+    // The last reference to the data may be dropped by a crypto worker, once the session has cancelled the work.
+    ~ComputeWSData()
+    {
+        ClearSecretData(reinterpret_cast<uint8_t *>(&setupPINCode), sizeof(setupPINCode));
+        ClearSecretData(salt, sizeof(salt));
+        ClearSecretData(serializedWS, sizeof(serializedWS));
+    }
+
+    uint32_t iterationCount;
+    uint32_t setupPINCode;
+
+    uint8_t salt[kSpake2p_Max_PBKDF_Salt_Length];
+    size_t saltLength;
+
+    uint8_t serializedWS[kSpake2p_WS_Length * 2] = { 0 };
+};
+
 // Amounts of time to allow for server-side processing of messages.
 //
 // These timeout values only allow for the server-side processing and assume that any transport-specific
@@ -68,6 +88,9 @@ const char kSpake2pR2ISessionInfo[] = "Commissioning R2I Key";
 static constexpr ExchangeContext::Timeout kExpectedLowProcessingTime  = System::Clock::Seconds16(2);
 static constexpr ExchangeContext::Timeout kExpectedHighProcessingTime = System::Clock::Seconds16(30);
 
+// How often to check whether a crypto worker failed to post the result of its work back to the Matter thread.
+static constexpr System::Clock::Timeout kBackgroundWorkWatchdogInterval = System::Clock::Seconds16(1);
+
 PASESession::~PASESession()
 {
     // Let's clear out any security state stored in the object, before destroying it.
@@ -95,6 +118,18 @@ void PASESession::Clear()
     memset(&mPASEVerifier, 0, sizeof(mPASEVerifier));
     mNextExpectedMsg.ClearValue();
 
+    if (mComputeWSHelper)
+    {
+        if (mSessionManager != nullptr)
+        {
+            mSessionManager->SystemLayer()->CancelTimer(BackgroundWorkWatchdogTimeout, this);
+        }
+        // The helper's data clears the setup PIN code and the derived w0 and w1 when it is freed, which happens
+        // on the crypto worker if the work is still in progress.
+        mComputeWSHelper->CancelWork();
+        mComputeWSHelper.reset();
+    }
+
     mSpake2p.Clear();
     mCommissioningHash.Clear();
 
@@ -453,7 +488,7 @@ CHIP_ERROR PASESession::HandlePBKDFParamResponse(System::PacketBufferHandle && m
 
     uint32_t decodeTagIdSeq = 0;
     ByteSpan salt;
-    uint8_t serializedWS[kSpake2p_WS_Length * 2] = { 0 };
+    Platform::SharedPtr<WorkHelper<ComputeWSData>> helper;
 
     ChipLogDetail(SecureChannel, "Received PBKDF param response");
 
@@ -520,24 +555,107 @@ CHIP_ERROR PASESession::HandlePBKDFParamResponse(System::PacketBufferHandle && m
     err = SetupSpake2p();
     SuccessOrExit(err);
 
-    err = Spake2pVerifier::ComputeWS(mIterationCount, salt, mSetupPINCode, serializedWS, sizeof(serializedWS));
-    SuccessOrExit(err);
+    // The PBKDF2 derivation of w0 and w1 runs on a crypto worker when there are any, see ComputeProverWS.
+    helper = WorkHelper<ComputeWSData>::Create(*this, &ComputeProverWS, &PASESession::BeginProverAndSendMsg1);
+    VerifyOrExit(helper, err = CHIP_ERROR_NO_MEMORY);
+    VerifyOrExit(salt.size() <= sizeof(helper->mData.salt), err = CHIP_ERROR_INVALID_PASE_PARAMETER);
+
+    helper->mData.iterationCount = mIterationCount;
+    helper->mData.setupPINCode   = mSetupPINCode;
+    helper->mData.saltLength     = salt.size();
+    memcpy(helper->mData.salt, salt.data(), salt.size());
+
+    if (ShouldScheduleCryptoWork())
+    {
+        SuccessOrExit(err = helper->ScheduleWork());
+        mComputeWSHelper = helper;
+        mExchangeCtxt.Value()->WillSendMessage();
+        // No message is expected until Msg1 is sent, other than a status report.
+        mNextExpectedMsg.ClearValue();
+        // Nothing else wakes the handshake up if the worker cannot post the result back, see InvokeBackgroundWorkWatchdog.
+        SuccessOrExit(err = mSessionManager->SystemLayer()->StartTimer(kBackgroundWorkWatchdogInterval,
+                                                                      BackgroundWorkWatchdogTimeout, this));
+    }
+    else
+    {
+        // Queueing the work behind the event loop would only delay the handshake.
+        SuccessOrExit(err = helper->DoWork());
+    }
 
-    err = mSpake2p.BeginProver(nullptr, 0, nullptr, 0, &serializedWS[0], kSpake2p_WS_Length, &serializedWS[kSpake2p_WS_Length],
-                               kSpake2p_WS_Length);
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+    }
+    return err;
+}
+
+CHIP_ERROR PASESession::ComputeProverWS(ComputeWSData & data, bool & cancel)
+{
+    return Spake2pVerifier::ComputeWS(data.iterationCount, ByteSpan(data.salt, data.saltLength), data.setupPINCode,
+                                      data.serializedWS, sizeof(data.serializedWS));
+}
+
+CHIP_ERROR PASESession::BeginProverAndSendMsg1(ComputeWSData & data, CHIP_ERROR status)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    // Only set when the work was scheduled, rather than done by HandlePBKDFParamResponse.
+    const bool scheduled = (mComputeWSHelper != nullptr);
+
+    SuccessOrExit(err = status);
+
+    err = mSpake2p.BeginProver(nullptr, 0, nullptr, 0, &data.serializedWS[0], kSpake2p_WS_Length,
+                               &data.serializedWS[kSpake2p_WS_Length], kSpake2p_WS_Length);
     SuccessOrExit(err);
 
     err = SendMsg1();
     SuccessOrExit(err);
 
 exit:
-    if (err != CHIP_NO_ERROR)
+    ClearSecretData(data.serializedWS, sizeof(data.serializedWS));
+    if (scheduled)
+    {
+        mSessionManager->SystemLayer()->CancelTimer(BackgroundWorkWatchdogTimeout, this);
+        mComputeWSHelper.reset();
+    }
+
+    if (scheduled && err != CHIP_NO_ERROR)
     {
         SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+        // Fail the pairing, which is normally done by PASESession::OnMessageReceived,
+        // but in the background processing case must be done here.
+        DiscardExchange();
+        Clear();
+        ChipLogError(SecureChannel, "Failed during PASE session setup: %" CHIP_ERROR_FORMAT, err.Format());
+        MATTER_TRACE_COUNTER("PASEFail");
+        // Do this last in case the delegate frees us.
+        NotifySessionEstablishmentError(err);
     }
     return err;
 }
 
+bool PASESession::InvokeBackgroundWorkWatchdog()
+{
+    VerifyOrReturnValue(mComputeWSHelper && mComputeWSHelper->UnableToScheduleAfterWorkCallback(), false);
+
+    ChipLogError(SecureChannel, "ComputeWSHelper was unable to schedule the AfterWorkCallback");
+    mComputeWSHelper->DoAfterWork();
+    return true;
+}
+
+void PASESession::BackgroundWorkWatchdogTimeout(System::Layer * systemLayer, void * context)
+{
+    auto * self = static_cast<PASESession *>(context);
+    VerifyOrReturn(self->mComputeWSHelper);
+
+    if (!self->InvokeBackgroundWorkWatchdog())
+    {
+        // Still computing, or the result is on its way to the Matter thread.
+        LogErrorOnFailure(systemLayer->StartTimer(kBackgroundWorkWatchdogInterval, BackgroundWorkWatchdogTimeout, self));
+    }
+}
+
 CHIP_ERROR PASESession::SendMsg1()
 {
     MATTER_TRACE_SCOPE("SendMsg1", "PASESession");
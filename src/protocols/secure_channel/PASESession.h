@@ -37,6 +37,7 @@
 #include <protocols/secure_channel/Constants.h>
 #include <protocols/secure_channel/PairingSession.h>
 #include <protocols/secure_channel/SessionEstablishmentExchangeDispatch.h>
+#include <protocols/secure_channel/SessionWorkHelper.h>
 #include <system/SystemPacketBuffer.h>
 #include <transport/CryptoContext.h>
 #include <transport/raw/MessageHeader.h>
@@ -135,6 +136,10 @@ public:
      **/
     void Clear();
 
+    // Returns true if the PASE session handshake was stuck due to failing to schedule work on the Matter thread.
+    // If this function returns true, the handshake has been resumed, or failed if resuming it failed.
+    bool InvokeBackgroundWorkWatchdog();
+
     //// ExchangeDelegate Implementation ////
     /**
      * @brief
@@ -186,6 +191,11 @@ private:
     CHIP_ERROR SendPBKDFParamResponse(ByteSpan initiatorRandom, bool initiatorHasPBKDFParams);
     CHIP_ERROR HandlePBKDFParamResponse(System::PacketBufferHandle && msg);
 
+    struct ComputeWSData;
+    static CHIP_ERROR ComputeProverWS(ComputeWSData & data, bool & cancel);
+    CHIP_ERROR BeginProverAndSendMsg1(ComputeWSData & data, CHIP_ERROR status);
+    static void BackgroundWorkWatchdogTimeout(System::Layer * systemLayer, void * context);
+
     CHIP_ERROR SendMsg1();
 
     CHIP_ERROR HandleMsg1_and_SendMsg2(System::PacketBufferHandle && msg);
@@ -225,6 +235,10 @@ private:
         Spake2pErrorType error;
     };
 
+    template <class DATA>
+    using WorkHelper = SessionWorkHelper<PASESession, DATA>;
+    Platform::SharedPtr<WorkHelper<ComputeWSData>> mComputeWSHelper;
+
 protected:
     uint8_t mKe[Crypto::kMAX_Hash_Length];
 
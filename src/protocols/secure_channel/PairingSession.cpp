@@ -273,6 +273,14 @@ void PairingSession::Clear()
     mSessionManager = nullptr;
 }
 
+bool PairingSession::ShouldScheduleCryptoWork() const
+{
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    VerifyOrReturnValue(!mScheduleCryptoWorkForTest, true);
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    return DeviceLayer::PlatformMgr().HasCryptoWorkers();
+}
+
 void PairingSession::NotifySessionEstablishmentError(CHIP_ERROR error, SessionEstablishmentStage stage)
 {
     if (mDelegate == nullptr)
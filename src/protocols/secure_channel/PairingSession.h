@@ -108,7 +108,19 @@ public:
     static CHIP_ERROR EncodeSessionParameters(TLV::Tag tag, const ReliableMessageProtocolConfig & mrpLocalConfig,
                                               TLV::TLVWriter & tlvWriter);
 
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    // Hand the expensive handshake steps to PlatformManager::ScheduleCryptoWork even if there are no crypto workers, so that
+    // tests exercise the scheduled path of the handshake.
+    void SetScheduleCryptoWorkForTest(bool schedule) { mScheduleCryptoWorkForTest = schedule; }
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
 protected:
+    /**
+     * Whether the expensive handshake steps (PBKDF2, certificate chain validation) are scheduled on the crypto workers,
+     * rather than done right away on the Matter thread.
+     */
+    bool ShouldScheduleCryptoWork() const;
+
     /**
      * Allocate a secure session object from the passed session manager for the
      * pending session establishment operation.
@@ -250,6 +262,10 @@ protected:
 
 private:
     Optional<uint16_t> mPeerSessionId;
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    bool mScheduleCryptoWorkForTest = false;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
 };
 
 } // namespace chip
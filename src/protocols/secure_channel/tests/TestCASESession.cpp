@@ -35,6 +35,7 @@
 #include <lib/core/DataModelTypes.h>
 #include <lib/core/ScopedNodeId.h>
 #include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPFaultInjection.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/ScopedBuffer.h>
@@ -84,7 +85,7 @@ void TestCASESession::ServiceEvents()
 {
     // Takes a few rounds of this because handling IO messages may schedule work,
     // and scheduled work may queue messages for sending...
-    for (int i = 0; i < 3; ++i)
+    for (int i = 0; i < 5; ++i)
     {
         DrainAndServiceIO();
 
@@ -510,6 +511,101 @@ TEST_F(TestCASESession, SecurePairingHandshakeTest)
     SecurePairingHandshakeTestCommon(sessionManager, pairingCommissioner, delegateCommissioner);
 }
 
+TEST_F(TestCASESession, SecurePairingHandshakeScheduledSigma2Test)
+{
+    // As on platforms with crypto workers: the responder credentials in Sigma2 are validated by scheduled work.
+    TemporarySessionManager sessionManager(*this);
+    TestCASESecurePairingDelegate delegateCommissioner;
+    CASESession pairingCommissioner;
+    pairingCommissioner.SetGroupDataProvider(&gCommissionerGroupDataProvider);
+    pairingCommissioner.SetScheduleCryptoWorkForTest(true);
+    SecurePairingHandshakeTestCommon(sessionManager, pairingCommissioner, delegateCommissioner);
+}
+
+TEST_F(TestCASESession, ScheduledSigma2CancelledTest)
+{
+    TemporarySessionManager sessionManager(*this);
+    TestCASESecurePairingDelegate delegateCommissioner;
+    TestCASESecurePairingDelegate delegateAccessory;
+    CASESession pairingCommissioner;
+    CASESession pairingAccessory;
+    pairingCommissioner.SetGroupDataProvider(&gCommissionerGroupDataProvider);
+    pairingCommissioner.SetScheduleCryptoWorkForTest(true);
+    pairingAccessory.SetGroupDataProvider(&gDeviceGroupDataProvider);
+
+    EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1,
+                                                                            &pairingAccessory),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(pairingAccessory.PrepareForSessionEstablishment(sessionManager, &gDeviceFabrics, nullptr, nullptr, &delegateAccessory,
+                                                              ScopedNodeId(), Optional<ReliableMessageProtocolConfig>::Missing()),
+              CHIP_NO_ERROR);
+
+    ExchangeContext * contextCommissioner = NewUnauthenticatedExchangeToBob(&pairingCommissioner);
+    EXPECT_EQ(pairingCommissioner.EstablishSession(sessionManager, &gCommissionerFabrics,
+                                                   ScopedNodeId{ Node01_01, gCommissionerFabricIndex }, contextCommissioner,
+                                                   nullptr, nullptr, &delegateCommissioner,
+                                                   Optional<ReliableMessageProtocolConfig>::Missing()),
+              CHIP_NO_ERROR);
+
+    // Sigma2 has been received, and its validation is queued but has not run yet.
+    DrainAndServiceIO();
+    EXPECT_EQ(pairingCommissioner.GetState(), CASESession::State::kHandleSigma2Pending);
+
+    // Cancelling drops the session's reference to the work, which then runs without calling back into the session.
+    pairingCommissioner.Clear();
+    ServiceEvents();
+
+    EXPECT_EQ(pairingCommissioner.GetState(), CASESession::State::kInitialized);
+    EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 0u);
+    EXPECT_EQ(delegateCommissioner.mNumPairingErrors, 0u);
+    EXPECT_EQ(delegateAccessory.mNumPairingComplete, 0u);
+}
+
+#if CHIP_WITH_NLFAULTINJECTION
+TEST_F(TestCASESession, ScheduledSigma2WatchdogTest)
+{
+    TemporarySessionManager sessionManager(*this);
+    TestCASESecurePairingDelegate delegateCommissioner;
+    TestCASESecurePairingDelegate delegateAccessory;
+    CASESession pairingCommissioner;
+    CASESession pairingAccessory;
+    pairingCommissioner.SetGroupDataProvider(&gCommissionerGroupDataProvider);
+    pairingCommissioner.SetScheduleCryptoWorkForTest(true);
+    pairingAccessory.SetGroupDataProvider(&gDeviceGroupDataProvider);
+
+    EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1,
+                                                                            &pairingAccessory),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(pairingAccessory.PrepareForSessionEstablishment(sessionManager, &gDeviceFabrics, nullptr, nullptr, &delegateAccessory,
+                                                              ScopedNodeId(), Optional<ReliableMessageProtocolConfig>::Missing()),
+              CHIP_NO_ERROR);
+
+    // The Sigma2 validation is the first scheduled work of the handshake: its result cannot be posted back.
+    FaultInjection::GetManager().FailAtFault(FaultInjection::kFault_SessionWorkAfterWorkPost, 0, 1);
+
+    ExchangeContext * contextCommissioner = NewUnauthenticatedExchangeToBob(&pairingCommissioner);
+    EXPECT_EQ(pairingCommissioner.EstablishSession(sessionManager, &gCommissionerFabrics,
+                                                   ScopedNodeId{ Node01_01, gCommissionerFabricIndex }, contextCommissioner,
+                                                   nullptr, nullptr, &delegateCommissioner,
+                                                   Optional<ReliableMessageProtocolConfig>::Missing()),
+              CHIP_NO_ERROR);
+    ServiceEvents();
+
+    // Stalled until the watchdog picks up the result.
+    EXPECT_EQ(pairingCommissioner.GetState(), CASESession::State::kHandleSigma2Pending);
+    EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 0u);
+
+    EXPECT_TRUE(pairingCommissioner.InvokeBackgroundWorkWatchdog());
+    ServiceEvents();
+
+    EXPECT_FALSE(pairingCommissioner.InvokeBackgroundWorkWatchdog());
+    EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 1u);
+    EXPECT_EQ(delegateAccessory.mNumPairingComplete, 1u);
+    EXPECT_EQ(delegateCommissioner.mNumPairingErrors, 0u);
+    EXPECT_EQ(delegateAccessory.mNumPairingErrors, 0u);
+}
+#endif // CHIP_WITH_NLFAULTINJECTION
+
 TEST_F(TestCASESession, SecurePairingHandshakeServerTest)
 {
     // TODO: Add cases for mismatching IPK config between initiator/responder
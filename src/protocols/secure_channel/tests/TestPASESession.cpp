@@ -29,10 +29,12 @@
 #include <lib/core/CHIPCore.h>
 #include <lib/core/CHIPSafeCasts.h>
 #include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CHIPFaultInjection.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/UnitTestUtils.h>
 #include <messaging/tests/MessagingContext.h>
+#include <platform/CHIPDeviceLayer.h>
 #include <protocols/secure_channel/PASESession.h>
 #include <stdarg.h>
 
@@ -89,18 +91,48 @@ class TestSecurePairingDelegate;
 class TestPASESession : public chip::Test::LoopbackMessagingContext
 {
 public:
+    // The PBKDF2 step of the handshake may be scheduled with PlatformManager::ScheduleCryptoWork.
+    static void SetUpTestSuite()
+    {
+        LoopbackMessagingContext::SetUpTestSuite();
+        ASSERT_EQ(chip::DeviceLayer::PlatformMgr().InitChipStack(), CHIP_NO_ERROR);
+        chip::DeviceLayer::SetSystemLayerForTesting(&GetSystemLayer());
+    }
+
+    static void TearDownTestSuite()
+    {
+        chip::DeviceLayer::SetSystemLayerForTesting(nullptr);
+        chip::DeviceLayer::PlatformMgr().Shutdown();
+        LoopbackMessagingContext::TearDownTestSuite();
+    }
+
     void SetUp() override
     {
         ConfigInitializeNodes(false);
         chip::Test::LoopbackMessagingContext::SetUp();
     }
 
+    void ServiceEvents();
     void SecurePairingHandshakeTestCommon(SessionManager & sessionManager, PASESession & pairingCommissioner,
                                           Optional<ReliableMessageProtocolConfig> mrpCommissionerConfig,
                                           Optional<ReliableMessageProtocolConfig> mrpAccessoryConfig,
                                           TestSecurePairingDelegate & delegateCommissioner);
 };
 
+void TestPASESession::ServiceEvents()
+{
+    // Takes a few rounds of this because handling IO messages may schedule work,
+    // and scheduled work may queue messages for sending...
+    for (int i = 0; i < 3; ++i)
+    {
+        DrainAndServiceIO();
+
+        chip::DeviceLayer::PlatformMgr().ScheduleWork(
+            [](intptr_t) -> void { chip::DeviceLayer::PlatformMgr().StopEventLoopTask(); }, (intptr_t) nullptr);
+        chip::DeviceLayer::PlatformMgr().RunEventLoop();
+    }
+}
+
 class PASETestLoopbackTransportDelegate : public Test::LoopbackTransportDelegate
 {
 public:
@@ -296,7 +328,7 @@ void TestPASESession::SecurePairingHandshakeTestCommon(SessionManager & sessionM
     EXPECT_EQ(pairingCommissioner.Pair(sessionManager, sTestSpake2p01_PinCode, mrpCommissionerConfig, contextCommissioner,
                                        &delegateCommissioner),
               CHIP_NO_ERROR);
-    DrainAndServiceIO();
+    ServiceEvents();
 
     while (delegate.mMessageDropped)
     {
@@ -431,6 +463,108 @@ TEST_F(TestPASESession, SecurePairingHandshakeWithPacketLossTest)
     EXPECT_EQ(loopback.mNumMessagesToDrop, 0u);
 }
 
+TEST_F(TestPASESession, SecurePairingHandshakeScheduledTest)
+{
+    // As on platforms with crypto workers: the PBKDF2 derivation of w0 and w1 is done by scheduled work.
+    TemporarySessionManager sessionManager(*this);
+
+    TestSecurePairingDelegate delegateCommissioner;
+    PASESession pairingCommissioner;
+    pairingCommissioner.SetScheduleCryptoWorkForTest(true);
+    auto & loopback = GetLoopback();
+    loopback.Reset();
+    SecurePairingHandshakeTestCommon(sessionManager, pairingCommissioner, Optional<ReliableMessageProtocolConfig>::Missing(),
+                                     Optional<ReliableMessageProtocolConfig>::Missing(), delegateCommissioner);
+}
+
+TEST_F(TestPASESession, ScheduledWorkCancelledTest)
+{
+    TemporarySessionManager sessionManager(*this);
+
+    TestSecurePairingDelegate delegateCommissioner;
+    PASESession pairingCommissioner;
+    pairingCommissioner.SetScheduleCryptoWorkForTest(true);
+
+    TestSecurePairingDelegate delegateAccessory;
+    PASESession pairingAccessory;
+
+    auto & loopback = GetLoopback();
+    loopback.Reset();
+
+    ExchangeContext * contextCommissioner = NewUnauthenticatedExchangeToBob(&pairingCommissioner);
+
+    EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::PBKDFParamRequest,
+                                                                            &pairingAccessory),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(pairingAccessory.WaitForPairing(sessionManager, sTestSpake2p01_PASEVerifier, sTestSpake2p01_IterationCount,
+                                              ByteSpan(sTestSpake2p01_Salt), Optional<ReliableMessageProtocolConfig>::Missing(),
+                                              &delegateAccessory),
+              CHIP_NO_ERROR);
+    DrainAndServiceIO();
+
+    // The PBKDF parameters have been received, and the derivation is queued but has not run yet.
+    EXPECT_EQ(pairingCommissioner.Pair(sessionManager, sTestSpake2p01_PinCode, Optional<ReliableMessageProtocolConfig>::Missing(),
+                                       contextCommissioner, &delegateCommissioner),
+              CHIP_NO_ERROR);
+    DrainAndServiceIO();
+
+    // Cancelling drops the session's reference to the work, which then runs without calling back into the session, so
+    // Msg1 is never sent.
+    pairingCommissioner.Clear();
+    ServiceEvents();
+
+    EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 0u);
+    EXPECT_EQ(delegateCommissioner.mNumPairingErrors, 0u);
+    EXPECT_EQ(delegateAccessory.mNumPairingComplete, 0u);
+}
+
+#if CHIP_WITH_NLFAULTINJECTION
+TEST_F(TestPASESession, ScheduledWorkWatchdogTest)
+{
+    TemporarySessionManager sessionManager(*this);
+
+    TestSecurePairingDelegate delegateCommissioner;
+    PASESession pairingCommissioner;
+    pairingCommissioner.SetScheduleCryptoWorkForTest(true);
+
+    TestSecurePairingDelegate delegateAccessory;
+    PASESession pairingAccessory;
+
+    auto & loopback = GetLoopback();
+    loopback.Reset();
+
+    ExchangeContext * contextCommissioner = NewUnauthenticatedExchangeToBob(&pairingCommissioner);
+
+    EXPECT_EQ(GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::PBKDFParamRequest,
+                                                                            &pairingAccessory),
+              CHIP_NO_ERROR);
+    EXPECT_EQ(pairingAccessory.WaitForPairing(sessionManager, sTestSpake2p01_PASEVerifier, sTestSpake2p01_IterationCount,
+                                              ByteSpan(sTestSpake2p01_Salt), Optional<ReliableMessageProtocolConfig>::Missing(),
+                                              &delegateAccessory),
+              CHIP_NO_ERROR);
+    DrainAndServiceIO();
+
+    // The derived w0 and w1 cannot be posted back to the Matter thread.
+    FaultInjection::GetManager().FailAtFault(FaultInjection::kFault_SessionWorkAfterWorkPost, 0, 1);
+
+    EXPECT_EQ(pairingCommissioner.Pair(sessionManager, sTestSpake2p01_PinCode, Optional<ReliableMessageProtocolConfig>::Missing(),
+                                       contextCommissioner, &delegateCommissioner),
+              CHIP_NO_ERROR);
+    ServiceEvents();
+    EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 0u);
+
+    // The watchdog timer resumes the handshake.
+    GetIOContext().DriveIOUntil(2000_ms32, [&] { return delegateCommissioner.mNumPairingComplete != 0; });
+    ServiceEvents();
+
+    EXPECT_FALSE(pairingCommissioner.InvokeBackgroundWorkWatchdog());
+    EXPECT_EQ(delegateCommissioner.mNumPairingComplete, 1u);
+    EXPECT_EQ(delegateAccessory.mNumPairingComplete, 1u);
+    EXPECT_EQ(delegateCommissioner.mNumPairingErrors, 0u);
+    EXPECT_EQ(delegateAccessory.mNumPairingErrors, 0u);
+}
+#endif // CHIP_WITH_NLFAULTINJECTION
+
 TEST_F(TestPASESession, SecurePairingFailedHandshake)
 {
     TemporarySessionManager sessionManager(*this);
@@ -0,0 +1,178 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a throughput benchmark for the crypto worker pool
+ *      used to offload CASE handshake steps.
+ *
+ *      Each handshake performs the public key operations of one side of a CASE
+ *      handshake: ephemeral key generation and ECDH, signing of the TBS data,
+ *      validation of the peer's Root01:ICA01:Node01_01 certificate chain and
+ *      verification of the peer's signature. The handshakes are run inline,
+ *      then on CryptoWorkerPool with 1, 2, 4... threads, and the number of
+ *      handshakes per second is reported for each.
+ *
+ *      Usage: case-crypto-benchmark [handshake-count] [max-threads]
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <credentials/FabricTable.h>
+#include <credentials/tests/CHIPCert_test_vectors.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/support/CodeUtils.h>
+#include <platform/CryptoWorkerPool.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace chip;
+using namespace chip::Credentials;
+using namespace chip::Crypto;
+using namespace chip::Test;
+
+namespace {
+
+constexpr size_t kTBSDataLength = 600; // About the size of Sigma2 and Sigma3 TBS data with an ICAC.
+
+uint8_t gTBSData[kTBSDataLength];
+P256SerializedKeypair gOperationalKeypair;
+P256ECDSASignature gPeerSignature;
+P256PublicKey gPeerEphemeralPublicKey;
+std::atomic<uint32_t> gFailures{ 0 };
+
+CHIP_ERROR PerformHandshake()
+{
+    // Ephemeral key and shared secret
+    P256Keypair ephemeralKey;
+    P256ECDHDerivedSecret sharedSecret;
+    ReturnErrorOnFailure(ephemeralKey.Initialize(ECPKeyTarget::ECDH));
+    ReturnErrorOnFailure(ephemeralKey.ECDH_derive_secret(gPeerEphemeralPublicKey, sharedSecret));
+
+    // Signature of our TBS data with the operational key
+    P256Keypair operationalKey;
+    P256ECDSASignature signature;
+    ReturnErrorOnFailure(operationalKey.Deserialize(gOperationalKeypair));
+    ReturnErrorOnFailure(operationalKey.ECDSA_sign_msg(gTBSData, sizeof(gTBSData), signature));
+
+    // Validation of the peer's identity and signature
+    ValidationContext validContext;
+    CompressedFabricId compressedFabricId;
+    FabricId fabricId;
+    NodeId nodeId;
+    P256PublicKey peerPublicKey;
+    ReturnErrorOnFailure(FabricTable::VerifyCredentials(TestCerts::sTestCert_Node01_01_Chip, TestCerts::sTestCert_ICA01_Chip,
+                                                        TestCerts::sTestCert_Root01_Chip, validContext, compressedFabricId,
+                                                        fabricId, nodeId, peerPublicKey));
+    return peerPublicKey.ECDSA_validate_msg_signature(gTBSData, sizeof(gTBSData), gPeerSignature);
+}
+
+void HandshakeWork(intptr_t)
+{
+    if (PerformHandshake() != CHIP_NO_ERROR)
+    {
+        gFailures++;
+    }
+}
+
+void Setup()
+{
+    for (size_t i = 0; i < sizeof(gTBSData); i++)
+    {
+        gTBSData[i] = static_cast<uint8_t>(i * 31);
+    }
+
+    VerifyOrDie(gOperationalKeypair.SetLength(TestCerts::sTestCert_Node01_01_PublicKey.size() +
+                                              TestCerts::sTestCert_Node01_01_PrivateKey.size()) == CHIP_NO_ERROR);
+    memcpy(gOperationalKeypair.Bytes(), TestCerts::sTestCert_Node01_01_PublicKey.data(),
+           TestCerts::sTestCert_Node01_01_PublicKey.size());
+    memcpy(gOperationalKeypair.Bytes() + TestCerts::sTestCert_Node01_01_PublicKey.size(),
+           TestCerts::sTestCert_Node01_01_PrivateKey.data(), TestCerts::sTestCert_Node01_01_PrivateKey.size());
+
+    // The peer signs with the same Node01_01 key, which its certificate chain vouches for.
+    P256Keypair peerKey;
+    VerifyOrDie(peerKey.Deserialize(gOperationalKeypair) == CHIP_NO_ERROR);
+    VerifyOrDie(peerKey.ECDSA_sign_msg(gTBSData, sizeof(gTBSData), gPeerSignature) == CHIP_NO_ERROR);
+
+    P256Keypair peerEphemeralKey;
+    VerifyOrDie(peerEphemeralKey.Initialize(ECPKeyTarget::ECDH) == CHIP_NO_ERROR);
+    gPeerEphemeralPublicKey = peerEphemeralKey.Pubkey();
+
+    VerifyOrDie(PerformHandshake() == CHIP_NO_ERROR);
+}
+
+void Report(const char * name, uint32_t handshakeCount, double seconds, double baseline)
+{
+    const double rate = handshakeCount / seconds;
+    printf("  %-10s %8.1f handshakes/s (x%.2f)\n", name, rate, rate / baseline);
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t handshakeCount = ParseArg(argc, argv, 1, 400);
+    const uint32_t maxThreads     = std::max(1u, ParseArg(argc, argv, 2, std::thread::hardware_concurrency()));
+
+    ScopedPlatformMemory platformMemory;
+    Setup();
+
+    printf("CASE crypto benchmark: %" PRIu32 " handshakes, up to %" PRIu32 " threads\n", handshakeCount, maxThreads);
+
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (uint32_t i = 0; i < handshakeCount; i++)
+    {
+        HandshakeWork(0);
+    }
+    const double inlineSeconds = ElapsedSeconds(start);
+    const double inlineRate    = handshakeCount / inlineSeconds;
+    Report("inline", handshakeCount, inlineSeconds, inlineRate);
+
+    for (uint32_t threads = 1;; threads = std::min(threads * 2, maxThreads))
+    {
+        DeviceLayer::Internal::CryptoWorkerPool pool;
+        VerifyOrDie(pool.Start(threads) == CHIP_NO_ERROR);
+
+        start = System::SystemClock().GetMonotonicMicroseconds64();
+        for (uint32_t i = 0; i < handshakeCount; i++)
+        {
+            VerifyOrDie(pool.Post(HandshakeWork, 0) == CHIP_NO_ERROR);
+        }
+        // Stopping runs the queued handshakes to completion.
+        pool.Stop();
+
+        char name[16];
+        snprintf(name, sizeof(name), "%" PRIu32 " threads", threads);
+        Report(name, handshakeCount, ElapsedSeconds(start), inlineRate);
+
+        if (threads == maxThreads)
+        {
+            break;
+        }
+    }
+
+    VerifyOrDie(gFailures == 0);
+
+    return EXIT_SUCCESS;
+}
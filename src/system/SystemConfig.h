@@ -512,6 +512,23 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the select- and epoll-based System Layer implementations keep pending timers in
+ *      a hierarchical timing wheel (chip::System::TimerWheel) rather than in a sorted list (chip::System::TimerList).
+ *
+ *      The timing wheel makes starting and cancelling a timer constant-time rather than linear in the number of pending
+ *      timers, at the cost of a few kilobytes of fixed overhead. It is worthwhile on devices, such as busy controllers,
+ *      that may have thousands of timers pending at once. Cancelling goes through an index with a bucket for each of the
+ *      CHIP_SYSTEM_CONFIG_NUM_TIMERS timers of a fixed pool; with CHIP_SYSTEM_CONFIG_POOL_USE_HEAP, the index grows with the
+ *      number of pending timers instead.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#define CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL 0
+#endif /* CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
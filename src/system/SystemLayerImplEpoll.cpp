@@ -0,0 +1,613 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements Layer using epoll() and timerfd.
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TimeUtils.h>
+#include <platform/LockTracker.h>
+#include <system/SystemFaultInjection.h>
+#include <system/SystemLayer.h>
+#include <system/SystemLayerImplEpoll.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Choose an approximation of PTHREAD_NULL if pthread.h doesn't define one.
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+#define PTHREAD_NULL 0
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+
+namespace chip {
+namespace System {
+
+namespace {
+
+constexpr Clock::Seconds64 kDefaultMinSleepPeriod = Clock::Seconds64(60 * 60 * 24 * 30); // Month [sec]
+
+// Index stored in epoll_event.data for the timerfd; socket watches use their pool index.
+constexpr uint32_t kTimerFdIndex = UINT32_MAX;
+
+// The epoll user data carries both the watch index and the file descriptor, so that an event reported
+// for a watch that was stopped (and possibly reused for another socket) by an earlier callback in the
+// same HandleEvents() pass can be recognized and dropped.
+inline uint64_t EncodeEpollData(uint32_t index, int fd)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(fd)) << 32) | index;
+}
+
+inline uint32_t EpollDataIndex(uint64_t data)
+{
+    return static_cast<uint32_t>(data & UINT32_MAX);
+}
+
+inline int EpollDataFd(uint64_t data)
+{
+    return static_cast<int>(static_cast<uint32_t>(data >> 32));
+}
+
+} // anonymous namespace
+
+CHIP_ERROR LayerImplEpoll::Init()
+{
+    VerifyOrReturnError(mLayerState.SetInitializing(), CHIP_ERROR_INCORRECT_STATE);
+
+    RegisterPOSIXErrorFormatter();
+
+    for (auto & w : mSocketWatchPool)
+    {
+        w.Clear();
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrReturnError(mEpollFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    mTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    VerifyOrReturnError(mTimerFd >= 0, CHIP_ERROR_POSIX(errno));
+    mTimerFdArmed = false;
+
+    epoll_event event = {};
+    event.events      = EPOLLIN;
+    event.data.u64    = EncodeEpollData(kTimerFdIndex, mTimerFd);
+    VerifyOrReturnError(epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mTimerFd, &event) == 0, CHIP_ERROR_POSIX(errno));
+
+    // Create an event to allow an arbitrary thread to wake the thread in the epoll loop.
+    ReturnErrorOnFailure(mWakeEvent.Open(*this));
+
+    VerifyOrReturnError(mLayerState.SetInitialized(), CHIP_ERROR_INCORRECT_STATE);
+    return CHIP_NO_ERROR;
+}
+
+void LayerImplEpoll::Shutdown()
+{
+    VerifyOrReturn(mLayerState.SetShuttingDown());
+
+    mTimerList.Clear();
+    mTimerPool.ReleaseAll();
+
+    mWakeEvent.Close(*this);
+
+    if (mTimerFd >= 0)
+    {
+        close(mTimerFd);
+        mTimerFd = -1;
+    }
+    if (mEpollFd >= 0)
+    {
+        close(mEpollFd);
+        mEpollFd = -1;
+    }
+
+    mLayerState.ResetFromShuttingDown(); // Return to uninitialized state to permit re-initialization.
+}
+
+void LayerImplEpoll::Signal()
+{
+    /*
+     * Wake up the I/O thread by notifying the wake event.
+     *
+     * If this is being called from within an I/O event callback, then notifying can be skipped,
+     * since the I/O thread is already awake and will re-evaluate its timeout in PrepareEvents().
+     */
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    if (pthread_equal(mHandleEventsThread, pthread_self()))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    CHIP_ERROR status = mWakeEvent.Notify();
+    if (status != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipSystemLayer, "System wake event notify failed: %" CHIP_ERROR_FORMAT, status.Format());
+    }
+}
+
+CHIP_ERROR LayerImplEpoll::StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_SYSTEM_FAULT_INJECT(FaultInjection::kFault_TimeoutImmediate, delay = System::Clock::kZero);
+
+    CancelTimer(onComplete, appState);
+
+    TimerQueue::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp() + delay, onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    VerifyOrReturnError(delay.count() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    assertChipStackLockedByCurrentThread();
+
+    Clock::Timeout remainingTime = mTimerList.GetRemainingTime(onComplete, appState);
+    if (remainingTime.count() < delay.count())
+    {
+        if (remainingTime == Clock::kZero)
+        {
+            // If remaining time is Clock::kZero, it might possible that our timer is in
+            // the mExpiredTimers list and about to be fired. Remove it from that list, since we are extending it.
+            mExpiredTimers.Remove(onComplete, appState);
+        }
+        return StartTimer(delay, onComplete, appState);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool LayerImplEpoll::IsTimerActive(TimerCompleteCallback onComplete, void * appState)
+{
+    bool timerIsActive = (mTimerList.GetRemainingTime(onComplete, appState) > Clock::kZero);
+
+    if (!timerIsActive)
+    {
+        // check if the timer is in the mExpiredTimers list about to be fired.
+        for (TimerList::Node * timer = mExpiredTimers.Earliest(); timer != nullptr; timer = timer->mNextTimer)
+        {
+            if (timer->GetCallback().GetOnComplete() == onComplete && timer->GetCallback().GetAppState() == appState)
+            {
+                return true;
+            }
+        }
+    }
+
+    return timerIsActive;
+}
+
+Clock::Timeout LayerImplEpoll::GetRemainingTime(TimerCompleteCallback onComplete, void * appState)
+{
+    return mTimerList.GetRemainingTime(onComplete, appState);
+}
+
+void LayerImplEpoll::CancelTimer(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturn(mLayerState.IsInitialized());
+
+    TimerQueue::Node * timer = mTimerList.Remove(onComplete, appState);
+    if (timer == nullptr)
+    {
+        // The timer was not in our "will fire in the future" list, but it might
+        // be in the "we're about to fire these" chunk we already grabbed from
+        // that list.  Check for it there too, and if found there we still want
+        // to cancel it.
+        timer = static_cast<TimerQueue::Node *>(mExpiredTimers.Remove(onComplete, appState));
+    }
+    VerifyOrReturn(timer != nullptr);
+
+    mTimerPool.Release(timer);
+    Signal();
+}
+
+CHIP_ERROR LayerImplEpoll::ScheduleWork(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    // Same as LayerImplSelect: use an expires-ASAP timer as a closure for onComplete and appState,
+    // without cancelling existing timers with the same callback and appState, so ScheduleWork
+    // invocations don't stomp on each other.
+    TimerQueue::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp(), onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::StartWatchingSocket(int fd, SocketWatchToken * tokenOut)
+{
+    // Find a free slot.
+    SocketWatch * watch = nullptr;
+    for (auto & w : mSocketWatchPool)
+    {
+        if (w.mFD == fd)
+        {
+            // Already registered, return the existing token
+            *tokenOut = reinterpret_cast<SocketWatchToken>(&w);
+            return CHIP_NO_ERROR;
+        }
+        if ((w.mFD == kInvalidFd) && (watch == nullptr))
+        {
+            watch = &w;
+        }
+    }
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_ENDPOINT_POOL_FULL);
+
+    // The descriptor is added to the epoll set once the first read or write callback is requested.
+    watch->mFD = fd;
+
+    *tokenOut = reinterpret_cast<SocketWatchToken>(watch);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mCallback     = callback;
+    watch->mCallbackData = data;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kRead);
+    return UpdateRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kWrite);
+    return UpdateRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kRead);
+    return UpdateRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kWrite);
+    return UpdateRegistration(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::StopWatchingSocket(SocketWatchToken * tokenInOut)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(*tokenInOut);
+    *tokenInOut         = InvalidSocketWatchToken();
+
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(watch->mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    if (watch->mRegisteredIO.HasAny())
+    {
+        // Failure is not interesting here: if the descriptor was already closed, the kernel has
+        // removed it from the epoll set by itself.
+        (void) epoll_ctl(mEpollFd, EPOLL_CTL_DEL, watch->mFD, nullptr);
+    }
+    watch->Clear();
+
+    // No need to Signal(): unlike select(), the epoll set is owned by the kernel and the socket
+    // is no longer part of it.
+    return CHIP_NO_ERROR;
+}
+
+/**
+ *  Synchronize the kernel epoll registration of @a watch with the set of events callbacks were requested for.
+ *
+ *  Sockets are level-triggered, so that a callback that consumes only part of the pending data (e.g. a
+ *  single datagram) is invoked again on the next loop iteration.  The registration is only touched when
+ *  the requested events actually change, which for most endpoints happens once over their lifetime.
+ */
+CHIP_ERROR LayerImplEpoll::UpdateRegistration(SocketWatch & watch)
+{
+    VerifyOrReturnError(watch.mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mEpollFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    if (watch.mPendingIO == watch.mRegisteredIO)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    int op;
+    if (!watch.mPendingIO.HasAny())
+    {
+        // Unregister entirely rather than keeping an empty interest set: epoll always reports
+        // EPOLLERR/EPOLLHUP, which would otherwise wake the loop for a socket nobody listens to.
+        op = EPOLL_CTL_DEL;
+    }
+    else
+    {
+        op = watch.mRegisteredIO.HasAny() ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    }
+
+    epoll_event event = {};
+    event.events      = (watch.mPendingIO.Has(SocketEventFlags::kRead) ? (EPOLLIN | EPOLLPRI) : 0u) |
+        (watch.mPendingIO.Has(SocketEventFlags::kWrite) ? EPOLLOUT : 0u);
+    event.data.u64 = EncodeEpollData(static_cast<uint32_t>(&watch - &mSocketWatchPool[0]), watch.mFD);
+
+    if (epoll_ctl(mEpollFd, op, watch.mFD, &event) != 0)
+    {
+        return CHIP_ERROR_POSIX(errno);
+    }
+
+    watch.mRegisteredIO = watch.mPendingIO;
+    return CHIP_NO_ERROR;
+}
+
+/**
+ *  Translate epoll events reported for a socket into the SocketEvents expected by its callback.
+ *
+ *  As with select(), an error or hang-up condition is reported as readiness for whichever operations
+ *  the callback asked for, so that the subsequent recv()/send() surfaces the actual error.
+ *
+ *  @param[in]    watch         The socket watch the events were reported for.
+ *
+ *  @param[in]    epollEvents   The events mask returned by epoll_wait().
+ */
+SocketEvents LayerImplEpoll::SocketEventsFromEpoll(const SocketWatch & watch, uint32_t epollEvents)
+{
+    SocketEvents res;
+
+    const bool failed = (epollEvents & (EPOLLERR | EPOLLHUP)) != 0;
+
+    if (watch.mPendingIO.Has(SocketEventFlags::kRead) && (failed || (epollEvents & EPOLLIN)))
+    {
+        res.Set(SocketEventFlags::kRead);
+    }
+    if (watch.mPendingIO.Has(SocketEventFlags::kWrite) && (failed || (epollEvents & EPOLLOUT)))
+    {
+        res.Set(SocketEventFlags::kWrite);
+    }
+    if (epollEvents & EPOLLPRI)
+    {
+        res.Set(SocketEventFlags::kExcept);
+    }
+
+    return res;
+}
+
+enum : intptr_t
+{
+    kLoopHandlerInactive = 0, // default value for EventLoopHandler::mState
+    kLoopHandlerPending,
+    kLoopHandlerActive,
+};
+
+void LayerImplEpoll::AddLoopHandler(EventLoopHandler & handler)
+{
+    // Add the handler as pending because this method can be called at any point
+    // in a PrepareEvents() / WaitForEvents() / HandleEvents() sequence.
+    // It will be marked active when we call PrepareEvents() on it for the first time.
+    auto & state = LoopHandlerState(handler);
+    VerifyOrDie(state == kLoopHandlerInactive);
+    state = kLoopHandlerPending;
+    mLoopHandlers.PushBack(&handler);
+}
+
+void LayerImplEpoll::RemoveLoopHandler(EventLoopHandler & handler)
+{
+    mLoopHandlers.Remove(&handler);
+    LoopHandlerState(handler) = kLoopHandlerInactive;
+}
+
+/**
+ *  Arm the timerfd to expire after @a sleepTime, unless it is already armed for @a awakenTime.
+ */
+void LayerImplEpoll::ArmTimerFd(Clock::Timestamp awakenTime, Clock::Milliseconds64 sleepTime)
+{
+    if (mTimerFdArmed && mTimerFdAwakenTime == awakenTime)
+    {
+        return;
+    }
+
+    // The deadline is programmed relative to now rather than as an absolute CLOCK_MONOTONIC value, since
+    // SystemClock() may be backed by a mock clock that is unrelated to the kernel's monotonic clock.
+    itimerspec spec       = {};
+    spec.it_value.tv_sec  = static_cast<time_t>(sleepTime.count() / 1000);
+    spec.it_value.tv_nsec = static_cast<long>((sleepTime.count() % 1000) * 1000000);
+
+    if (timerfd_settime(mTimerFd, 0, &spec, nullptr) != 0)
+    {
+        ChipLogError(chipSystemLayer, "timerfd_settime failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        // Fall back to polling with the timeout in epoll_wait().
+        mTimerFdArmed = false;
+        mEpollTimeout = static_cast<int>(std::min<uint64_t>(sleepTime.count(), INT32_MAX));
+        return;
+    }
+
+    mTimerFdArmed      = true;
+    mTimerFdAwakenTime = awakenTime;
+}
+
+void LayerImplEpoll::HandleTimerFd()
+{
+    uint64_t expirations;
+
+    if (read(mTimerFd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+    {
+        ChipLogError(chipSystemLayer, "timerfd read failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+    }
+
+    // The timerfd is one-shot; make sure the next PrepareEvents() re-arms it even if the earliest deadline
+    // did not change (which can happen if SystemClock() has not advanced as far as the kernel clock).
+    mTimerFdArmed = false;
+}
+
+void LayerImplEpoll::PrepareEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    const Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+    Clock::Timestamp awakenTime        = currentTime + kDefaultMinSleepPeriod;
+
+    TimerQueue::Node * timer = mTimerList.Earliest();
+    if (timer)
+    {
+        awakenTime = std::min(awakenTime, timer->AwakenTime());
+    }
+
+    // Activate added EventLoopHandlers and call PrepareEvents on active handlers.
+    auto loopIter = mLoopHandlers.begin();
+    while (loopIter != mLoopHandlers.end())
+    {
+        auto & loop = *loopIter++; // advance before calling out, in case a list modification clobbers the `next` pointer
+        switch (auto & state = LoopHandlerState(loop))
+        {
+        case kLoopHandlerPending:
+            state = kLoopHandlerActive;
+            [[fallthrough]];
+        case kLoopHandlerActive:
+            awakenTime = std::min(awakenTime, loop.PrepareEvents(currentTime));
+            break;
+        }
+    }
+
+    if (awakenTime <= currentTime)
+    {
+        // Something is due already: just poll for I/O.
+        mEpollTimeout = 0;
+        return;
+    }
+
+    mEpollTimeout = -1;
+    ArmTimerFd(awakenTime, awakenTime - currentTime);
+}
+
+void LayerImplEpoll::WaitForEvents()
+{
+    mEpollResult = epoll_wait(mEpollFd, mEpollEvents, kMaxEpollEvents, mEpollTimeout);
+}
+
+void LayerImplEpoll::HandleEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    if (!IsEpollResultValid())
+    {
+        ChipLogError(DeviceLayer, "epoll_wait failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        return;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = pthread_self();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    // Obtain the list of currently expired timers. Any new timers added by timer callback are NOT handled on this pass,
+    // since that could result in infinite handling of new timers blocking any other progress.
+    VerifyOrDieWithMsg(mExpiredTimers.Empty(), DeviceLayer, "Re-entry into HandleEvents from a timer callback?");
+    mExpiredTimers          = mTimerList.ExtractEarlier(Clock::Timeout(1) + SystemClock().GetMonotonicTimestamp());
+    TimerList::Node * timer = nullptr;
+    while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
+    {
+        mTimerPool.Invoke(static_cast<TimerQueue::Node *>(timer));
+    }
+
+    // Process socket events, if any. Only descriptors that are actually ready are visited.
+    for (int i = 0; i < mEpollResult; i++)
+    {
+        const uint64_t data  = mEpollEvents[i].data.u64;
+        const uint32_t index = EpollDataIndex(data);
+
+        if (index == kTimerFdIndex)
+        {
+            HandleTimerFd();
+            continue;
+        }
+
+        VerifyOrDie(index < static_cast<uint32_t>(kSocketWatchMax));
+        SocketWatch & w = mSocketWatchPool[index];
+        if (w.mFD == kInvalidFd || w.mFD != EpollDataFd(data) || w.mCallback == nullptr)
+        {
+            // Watch was stopped or replaced by an earlier callback in this pass.
+            continue;
+        }
+
+        SocketEvents events = SocketEventsFromEpoll(w, mEpollEvents[i].events);
+        if (events.HasAny())
+        {
+            w.mCallback(events, w.mCallbackData);
+        }
+    }
+
+    // Call HandleEvents for active loop handlers
+    auto loopIter = mLoopHandlers.begin();
+    while (loopIter != mLoopHandlers.end())
+    {
+        auto & loop = *loopIter++; // advance before calling out, in case a list modification clobbers the `next` pointer
+        if (LoopHandlerState(loop) == kLoopHandlerActive)
+        {
+            loop.HandleEvents();
+        }
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleEventsThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+void LayerImplEpoll::SocketWatch::Clear()
+{
+    mFD = kInvalidFd;
+    mPendingIO.ClearAll();
+    mRegisteredIO.ClearAll();
+    mCallback     = nullptr;
+    mCallbackData = 0;
+}
+
+} // namespace System
+} // namespace chip
@@ -68,8 +68,9 @@ enum
     kNumEntries
 };
 
-typedef int8_t count_t;
-#define CHIP_SYS_STATS_COUNT_MAX INT8_MAX
+// Wide enough for the packet buffers in use on platforms that allocate them from the heap.
+typedef int16_t count_t;
+#define CHIP_SYS_STATS_COUNT_MAX INT16_MAX
 
 extern count_t ResourcesInUse[kNumEntries];
 extern count_t HighWatermarks[kNumEntries];
@@ -33,6 +33,7 @@
 #include <system/SystemFaultInjection.h>
 #include <system/SystemLayer.h>
 
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 
 namespace chip {
@@ -178,5 +179,404 @@ Clock::Timeout TimerList::GetRemainingTime(TimerCompleteCallback aOnComplete, vo
     return Clock::kZero;
 }
 
+template <TimerWheel::Node * TimerWheel::Node::*Next, TimerWheel::Node * TimerWheel::Node::*Prev>
+void TimerWheel::Append(Node *& head, Node * node)
+{
+    if (head == nullptr)
+    {
+        node->*Next = node;
+        node->*Prev = node;
+        head        = node;
+        return;
+    }
+
+    Node * tail = head->*Prev;
+    node->*Next = head;
+    node->*Prev = tail;
+    tail->*Next = node;
+    head->*Prev = node;
+}
+
+template <TimerWheel::Node * TimerWheel::Node::*Next, TimerWheel::Node * TimerWheel::Node::*Prev>
+void TimerWheel::Unlink(Node *& head, Node * node)
+{
+    if (node->*Next == node)
+    {
+        head = nullptr;
+    }
+    else
+    {
+        (node->*Prev)->*Next = node->*Next;
+        (node->*Next)->*Prev = node->*Prev;
+        if (head == node)
+        {
+            head = node->*Next;
+        }
+    }
+    node->*Next = nullptr;
+    node->*Prev = nullptr;
+}
+
+size_t TimerWheel::IndexBucket(TimerCompleteCallback onComplete, void * appState) const
+{
+    uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(appState)) ^
+        (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(onComplete)) * 0x9E3779B97F4A7C15ull);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return static_cast<size_t>(hash) & (mIndexSize - 1);
+}
+
+unsigned TimerWheel::LevelFor(uint64_t awakenTime, uint64_t currentTime)
+{
+    uint64_t diff  = (awakenTime ^ currentTime) >> kSlotBits;
+    unsigned level = 0;
+    while (diff != 0)
+    {
+        diff >>= kSlotBits;
+        level++;
+    }
+    return level;
+}
+
+TimerWheel::~TimerWheel()
+{
+    if (mIndex != mIndexStorage)
+    {
+        Platform::MemoryFree(mIndex);
+    }
+}
+
+void TimerWheel::Clear()
+{
+    memset(mSlots, 0, sizeof(mSlots));
+    memset(mOccupied, 0, sizeof(mOccupied));
+    memset(mIndex, 0, mIndexSize * sizeof(*mIndex));
+    mDueTimers          = nullptr;
+    mCurrentTime        = 0;
+    mCount              = 0;
+    mEarliestTimer      = nullptr;
+    mEarliestTimerValid = true;
+}
+
+void TimerWheel::Place(Node * timer)
+{
+    const uint64_t awakenTime = timer->AwakenTime().count();
+
+    if (awakenTime < mCurrentTime)
+    {
+        // Keep the due timers sorted, after any with the same expiration time. They are normally added in order of
+        // expiration, so start looking from the end.
+        Node * after = (mDueTimers != nullptr) ? mDueTimers->mPrevInSlot : nullptr;
+        while (after != nullptr && timer->AwakenTime() < after->AwakenTime())
+        {
+            after = (after == mDueTimers) ? nullptr : after->mPrevInSlot;
+        }
+
+        if (after == nullptr)
+        {
+            Append<&Node::mNextInSlot, &Node::mPrevInSlot>(mDueTimers, timer);
+            mDueTimers = timer;
+        }
+        else
+        {
+            timer->mNextInSlot              = after->mNextInSlot;
+            timer->mPrevInSlot              = after;
+            after->mNextInSlot->mPrevInSlot = timer;
+            after->mNextInSlot              = timer;
+        }
+        timer->mSlot = kDueSlot;
+        return;
+    }
+
+    const unsigned level = LevelFor(awakenTime, mCurrentTime);
+    const unsigned slot  = static_cast<unsigned>(awakenTime >> (level * kSlotBits)) & (kSlotsPerLevel - 1);
+    Append<&Node::mNextInSlot, &Node::mPrevInSlot>(mSlots[level][slot], timer);
+    mOccupied[level] |= (1ull << slot);
+    timer->mSlot = static_cast<uint16_t>(level * kSlotsPerLevel + slot);
+}
+
+void TimerWheel::Detach(Node * timer)
+{
+    if (timer->mSlot == kDueSlot)
+    {
+        Unlink<&Node::mNextInSlot, &Node::mPrevInSlot>(mDueTimers, timer);
+    }
+    else
+    {
+        const unsigned level = timer->mSlot / kSlotsPerLevel;
+        const unsigned slot  = timer->mSlot % kSlotsPerLevel;
+        Unlink<&Node::mNextInSlot, &Node::mPrevInSlot>(mSlots[level][slot], timer);
+        if (mSlots[level][slot] == nullptr)
+        {
+            mOccupied[level] &= ~(1ull << slot);
+        }
+    }
+    timer->mSlot = kNoSlot;
+
+    Unlink<&Node::mNextInIndex, &Node::mPrevInIndex>(
+        mIndex[IndexBucket(timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState())], timer);
+    mCount--;
+
+    if (timer == mEarliestTimer)
+    {
+        mEarliestTimerValid = false;
+    }
+}
+
+void TimerWheel::Advance(uint64_t currentTime)
+{
+    // Callers guarantee that no timer in the wheel expires before currentTime.
+    VerifyOrReturn(mCurrentTime < currentTime);
+
+    const unsigned level = LevelFor(currentTime, mCurrentTime);
+    mCurrentTime         = currentTime;
+
+    // Level 0 slots hold a single expiration time, and timers at any other level but this one keep their place:
+    // only the slot that the new current time falls in must be spread over the lower levels.
+    VerifyOrReturn(level > 0);
+    const unsigned slot = static_cast<unsigned>(currentTime >> (level * kSlotBits)) & (kSlotsPerLevel - 1);
+    Node * timer        = mSlots[level][slot];
+    VerifyOrReturn(timer != nullptr);
+    mSlots[level][slot] = nullptr;
+    mOccupied[level] &= ~(1ull << slot);
+
+    // Re-place the timers in their existing order, so that those expiring together stay in the order they were added.
+    Node * const last = timer->mPrevInSlot;
+    for (bool done = false; !done;)
+    {
+        Node * next = timer->mNextInSlot;
+        done        = (timer == last);
+        Place(timer);
+        timer = next;
+    }
+}
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+void TimerWheel::GrowIndex()
+{
+    Node ** const oldIndex = mIndex;
+    const size_t oldSize   = mIndexSize;
+
+    auto ** newIndex = static_cast<Node **>(Platform::MemoryCalloc(2 * oldSize, sizeof(*oldIndex)));
+    // Without memory, the buckets just get longer.
+    VerifyOrReturn(newIndex != nullptr);
+
+    mIndex     = newIndex;
+    mIndexSize = 2 * oldSize;
+    for (size_t i = 0; i < oldSize; i++)
+    {
+        // Moving the timers of each bucket in order keeps the ones with the same callback and app state in the order
+        // they were added.
+        while (oldIndex[i] != nullptr)
+        {
+            Node * timer = oldIndex[i];
+            Unlink<&Node::mNextInIndex, &Node::mPrevInIndex>(oldIndex[i], timer);
+            Append<&Node::mNextInIndex, &Node::mPrevInIndex>(
+                mIndex[IndexBucket(timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState())], timer);
+        }
+    }
+
+    if (oldIndex != mIndexStorage)
+    {
+        Platform::MemoryFree(oldIndex);
+    }
+}
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+TimerWheel::Node * TimerWheel::Add(Node * timer)
+{
+    VerifyOrDie(timer->mSlot == kNoSlot);
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    if (mCount >= mIndexSize)
+    {
+        GrowIndex();
+    }
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+    Place(timer);
+    Append<&Node::mNextInIndex, &Node::mPrevInIndex>(
+        mIndex[IndexBucket(timer->GetCallback().GetOnComplete(), timer->GetCallback().GetAppState())], timer);
+    mCount++;
+
+    if (mEarliestTimerValid && (mEarliestTimer == nullptr || timer->AwakenTime() < mEarliestTimer->AwakenTime()))
+    {
+        mEarliestTimer = timer;
+    }
+    return Earliest();
+}
+
+TimerWheel::Node * TimerWheel::Remove(Node * remove)
+{
+    if (remove != nullptr && remove->mSlot != kNoSlot)
+    {
+        Detach(remove);
+    }
+    return Earliest();
+}
+
+TimerWheel::Node * TimerWheel::Remove(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    Node * timer = Find(aOnComplete, aAppState);
+    if (timer != nullptr)
+    {
+        Detach(timer);
+    }
+    return timer;
+}
+
+TimerWheel::Node * TimerWheel::Find(TimerCompleteCallback aOnComplete, void * aAppState) const
+{
+    Node * const head = mIndex[IndexBucket(aOnComplete, aAppState)];
+    VerifyOrReturnValue(head != nullptr, nullptr);
+
+    // Buckets are in the order timers were added, so the first match wins among those expiring together.
+    Node * found = nullptr;
+    Node * timer = head;
+    do
+    {
+        if (timer->GetCallback().GetOnComplete() == aOnComplete && timer->GetCallback().GetAppState() == aAppState &&
+            (found == nullptr || timer->AwakenTime() < found->AwakenTime()))
+        {
+            found = timer;
+        }
+        timer = timer->mNextInIndex;
+    } while (timer != head);
+    return found;
+}
+
+TimerWheel::Node * TimerWheel::Earliest() const
+{
+    if (mEarliestTimerValid)
+    {
+        return mEarliestTimer;
+    }
+
+    mEarliestTimer      = mDueTimers;
+    mEarliestTimerValid = true;
+    for (unsigned level = 0; mEarliestTimer == nullptr && level < kLevels; level++)
+    {
+        if (mOccupied[level] == 0)
+        {
+            continue;
+        }
+
+        // Lower levels and, within a level, lower slots expire first. Timers in a level 0 slot all expire at the
+        // same time; for higher levels, look for the first one expiring earliest.
+        unsigned slot = 0;
+        while ((mOccupied[level] & (1ull << slot)) == 0)
+        {
+            slot++;
+        }
+        Node * const head = mSlots[level][slot];
+        mEarliestTimer    = head;
+        for (Node * timer = head->mNextInSlot; level > 0 && timer != head; timer = timer->mNextInSlot)
+        {
+            if (timer->AwakenTime() < mEarliestTimer->AwakenTime())
+            {
+                mEarliestTimer = timer;
+            }
+        }
+    }
+    return mEarliestTimer;
+}
+
+TimerWheel::Node * TimerWheel::PopEarliest()
+{
+    Node * earliest = Earliest();
+    if (earliest != nullptr)
+    {
+        const bool due = (earliest->mSlot == kDueSlot);
+        Detach(earliest);
+        if (!due)
+        {
+            Advance(earliest->AwakenTime().count());
+        }
+    }
+    return earliest;
+}
+
+TimerWheel::Node * TimerWheel::PopIfEarlier(Clock::Timestamp t)
+{
+    if (mDueTimers != nullptr)
+    {
+        // Due timers all expire before anything in the wheel.
+        VerifyOrReturnValue(mDueTimers->AwakenTime() < t, nullptr);
+        Node * earliest = mDueTimers;
+        Detach(earliest);
+        return earliest;
+    }
+
+    for (;;)
+    {
+        unsigned level = 0;
+        while (level < kLevels && mOccupied[level] == 0)
+        {
+            level++;
+        }
+        VerifyOrReturnValue(level < kLevels, nullptr);
+
+        unsigned slot = 0;
+        while ((mOccupied[level] & (1ull << slot)) == 0)
+        {
+            slot++;
+        }
+
+        if (level == 0)
+        {
+            Node * earliest = mSlots[0][slot];
+            VerifyOrReturnValue(earliest->AwakenTime() < t, nullptr);
+            Detach(earliest);
+            Advance(earliest->AwakenTime().count());
+            return earliest;
+        }
+
+        // The earliest timer is somewhere in this slot. Move the current time to the start of the slot's span,
+        // which spreads its timers over the lower levels, and look again.
+        const unsigned shift     = level * kSlotBits;
+        const uint64_t upperMask = (shift + kSlotBits >= 64) ? 0 : ~((1ull << (shift + kSlotBits)) - 1);
+        const uint64_t slotStart = (mCurrentTime & upperMask) | (static_cast<uint64_t>(slot) << shift);
+        VerifyOrReturnValue(slotStart < static_cast<uint64_t>(t.count()), nullptr);
+        Advance(slotStart);
+    }
+}
+
+TimerList TimerWheel::ExtractEarlier(Clock::Timestamp t)
+{
+    TimerList out;
+    TimerList::Node * last = nullptr;
+
+    Node * timer;
+    while ((timer = PopIfEarlier(t)) != nullptr)
+    {
+        timer->mNextTimer = nullptr;
+        if (last == nullptr)
+        {
+            out.mEarliestTimer = timer;
+        }
+        else
+        {
+            last->mNextTimer = timer;
+        }
+        last = timer;
+    }
+
+    return out;
+}
+
+Clock::Timeout TimerWheel::GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState)
+{
+    Node * timer = Find(aOnComplete, aAppState);
+    VerifyOrReturnValue(timer != nullptr, Clock::kZero);
+
+    Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+    if (currentTime < timer->AwakenTime())
+    {
+        return Clock::Timeout(timer->AwakenTime() - currentTime);
+    }
+    return Clock::kZero;
+}
+
 } // namespace System
 } // namespace chip
@@ -186,9 +186,176 @@ public:
     Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
 
 private:
+    friend class TimerWheel;
+
     Node * mEarliestTimer;
 };
 
+// Smallest power of two that is at least the given number of timers.
+constexpr size_t TimerWheelIndexSizeFor(size_t timers)
+{
+    size_t size = 1;
+    while (size < timers)
+    {
+        size <<= 1;
+    }
+    return size;
+}
+
+/**
+ * Hierarchical timing wheel with the same interface as TimerList, for System::Layer implementations that may
+ * hold thousands of timers at once. Add() and Remove() are constant-time, the lookups by callback and app state
+ * go through a hash index, and popping the earliest timer is amortized O(kLevels).
+ *
+ * Level L of the wheel has kSlotsPerLevel slots, each spanning 2^(kSlotBits * L) milliseconds. A timer sits at
+ * the level of the highest kSlotBits-bit digit in which its expiration time differs from the wheel's current
+ * time, in the slot given by that digit. Every timer at a lower level therefore expires before every timer at a
+ * higher one, and the slots of level 0 only hold timers expiring at the same millisecond, kept in the order they
+ * were added (which preserves TimerList's ordering of equal expiration times). The current time only moves up
+ * to the earliest pending timer, at which point the slot containing it is redistributed to the lower levels.
+ * Timers added with an expiration time before the wheel's current time are kept in a sorted list ahead of the
+ * wheel; in practice this list only holds timers that are already due.
+ */
+class TimerWheel
+{
+public:
+    class Node : public TimerList::Node
+    {
+    public:
+        Node(Layer & systemLayer, System::Clock::Timestamp awakenTime, TimerCompleteCallback onComplete, void * appState) :
+            TimerList::Node(systemLayer, awakenTime, onComplete, appState)
+        {}
+
+    private:
+        friend class TimerWheel;
+
+        // Links within a wheel slot (or the list of due timers) and within an index bucket, both circular.
+        Node * mNextInSlot  = nullptr;
+        Node * mPrevInSlot  = nullptr;
+        Node * mNextInIndex = nullptr;
+        Node * mPrevInIndex = nullptr;
+        uint16_t mSlot      = kNoSlot;
+    };
+
+    TimerWheel() { Clear(); }
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel &)             = delete;
+    TimerWheel & operator=(const TimerWheel &) = delete;
+
+    /**
+     * Add a timer to the wheel
+     *
+     * @return  The new earliest timer in the wheel. If this is the newly added timer, that implies it is earlier
+     *          than any existing timer.
+     */
+    Node * Add(Node * timer);
+
+    /**
+     * Remove the given timer from the wheel, if present. It is not an error for the timer not to be present.
+     *
+     * @return  The new earliest timer in the wheel, or nullptr if the wheel is empty.
+     */
+    Node * Remove(Node * remove);
+
+    /**
+     * Remove the earliest timer with the given properties, if present. It is not an error for no such timer to be present.
+     *
+     * @return  The removed timer, or nullptr if the wheel contains no matching timer.
+     */
+    Node * Remove(TimerCompleteCallback onComplete, void * appState);
+
+    /**
+     * Remove and return the earliest timer in the wheel.
+     *
+     * @return  The earliest timer, or nullptr if the wheel is empty.
+     */
+    Node * PopEarliest();
+
+    /**
+     * Remove and return the earliest timer in the wheel, provided it expires earlier than the given time @a t.
+     *
+     * @return  The earliest timer expiring before @a t, or nullptr if there is no such timer.
+     */
+    Node * PopIfEarlier(Clock::Timestamp t);
+
+    /**
+     * Get the earliest timer in the wheel.
+     *
+     * @return  The earliest timer, or nullptr if there are no timers.
+     */
+    Node * Earliest() const;
+
+    /**
+     * Test whether there are any timers.
+     */
+    bool Empty() const { return mCount == 0; }
+
+    /**
+     * Remove and return all timers that expire before the given time @a t, as a list ordered by expiration time.
+     */
+    TimerList ExtractEarlier(Clock::Timestamp t);
+
+    /**
+     * Remove all timers.
+     */
+    void Clear();
+
+    /**
+     * Find the timer with the given properties, if present, and return its remaining time
+     *
+     * @return The remaining time on this particular timer or 0 if not found.
+     */
+    Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
+
+private:
+    static constexpr unsigned kSlotBits      = 6;
+    static constexpr unsigned kSlotsPerLevel = 1u << kSlotBits;
+    static constexpr unsigned kLevels        = (64 + kSlotBits - 1) / kSlotBits;
+    static constexpr uint16_t kDueSlot       = kLevels * kSlotsPerLevel;
+    static constexpr uint16_t kNoSlot        = UINT16_MAX;
+
+    // The index has a bucket for every timer the pool can hold. Heap-backed pools have no such bound: the index
+    // then starts at that size and doubles whenever the timers outnumber its buckets.
+    static constexpr size_t kInitialIndexSize = TimerWheelIndexSizeFor(CHIP_SYSTEM_CONFIG_NUM_TIMERS);
+
+    template <Node * Node::*Next, Node * Node::*Prev>
+    static void Append(Node *& head, Node * node);
+    template <Node * Node::*Next, Node * Node::*Prev>
+    static void Unlink(Node *& head, Node * node);
+
+    size_t IndexBucket(TimerCompleteCallback onComplete, void * appState) const;
+    static unsigned LevelFor(uint64_t awakenTime, uint64_t currentTime);
+
+    Node * Find(TimerCompleteCallback onComplete, void * appState) const;
+    void Place(Node * timer);
+    void Detach(Node * timer);
+    void Advance(uint64_t currentTime);
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    void GrowIndex();
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+    Node * mSlots[kLevels][kSlotsPerLevel];
+    uint64_t mOccupied[kLevels]; // Bit S of mOccupied[L] is set when mSlots[L][S] is not empty.
+    Node * mDueTimers;
+    Node * mIndexStorage[kInitialIndexSize];
+    Node ** mIndex    = mIndexStorage;
+    size_t mIndexSize = kInitialIndexSize;
+    uint64_t mCurrentTime;
+    size_t mCount;
+    mutable Node * mEarliestTimer;
+    mutable bool mEarliestTimerValid;
+};
+
+/**
+ * Container used by System::Layer implementations to hold their pending timers.
+ */
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+using TimerQueue = TimerWheel;
+#else
+using TimerQueue = TimerList;
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 /**
  * ObjectPool wrapper that keeps System Timer statistics.
  */
@@ -0,0 +1,66 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "BenchmarkSupport.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace Test {
+
+uint32_t ParseArg(int argc, char * argv[], int index, uint32_t defaultValue)
+{
+    return (argc > index) ? static_cast<uint32_t>(strtoul(argv[index], nullptr, 0)) : defaultValue;
+}
+
+uint64_t NowMicroseconds()
+{
+    return System::SystemClock().GetMonotonicMicroseconds64().count();
+}
+
+double ElapsedNanoseconds(System::Clock::Microseconds64 start)
+{
+    return static_cast<double>((System::SystemClock().GetMonotonicMicroseconds64() - start).count()) * 1000.0;
+}
+
+double ElapsedSeconds(System::Clock::Microseconds64 start)
+{
+    return static_cast<double>((System::SystemClock().GetMonotonicMicroseconds64() - start).count()) / 1000000.0;
+}
+
+double PerSecond(uint64_t count, uint64_t microseconds)
+{
+    return static_cast<double>(count) * 1e6 / static_cast<double>(std::max<uint64_t>(microseconds, 1));
+}
+
+ScopedPlatformMemory::ScopedPlatformMemory()
+{
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+}
+
+ScopedPlatformMemory::~ScopedPlatformMemory()
+{
+    Platform::MemoryShutdown();
+}
+
+} // namespace Test
+} // namespace chip
@@ -0,0 +1,61 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Helpers shared by the benchmark tools: parsing their positional
+ *      arguments, timing what they measure and setting up the platform memory.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace Test {
+
+/// Returns the positional argument at index, parsed as an unsigned integer (in decimal, or in hex
+/// with a 0x prefix), or defaultValue if there are not that many arguments.
+uint32_t ParseArg(int argc, char * argv[], int index, uint32_t defaultValue);
+
+/// Returns the monotonic time, in microseconds.
+uint64_t NowMicroseconds();
+
+/// Returns the time elapsed since start, a monotonic timestamp, in nanoseconds.
+double ElapsedNanoseconds(System::Clock::Microseconds64 start);
+
+/// Returns the time elapsed since start, a monotonic timestamp, in seconds.
+double ElapsedSeconds(System::Clock::Microseconds64 start);
+
+/// Returns the rate at which count operations were done in the given number of microseconds, per second.
+double PerSecond(uint64_t count, uint64_t microseconds);
+
+/// Initializes the platform memory for as long as it is in scope, dying if it cannot.
+class ScopedPlatformMemory
+{
+public:
+    ScopedPlatformMemory();
+    ~ScopedPlatformMemory();
+
+    ScopedPlatformMemory(const ScopedPlatformMemory &)             = delete;
+    ScopedPlatformMemory & operator=(const ScopedPlatformMemory &) = delete;
+};
+
+} // namespace Test
+} // namespace chip
@@ -0,0 +1,286 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the socket watches of the socket-based
+ *      System Layer implementations (select- or epoll-based, depending on
+ *      chip_system_config_event_loop).
+ */
+
+#include <pw_unit_test/framework.h>
+#include <system/SystemConfig.h>
+
+// Socket watches are serviced by the LayerSocketsLoop event loop only.
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+
+#include <stdint.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemLayerImpl.h>
+
+using namespace chip;
+using namespace chip::System;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+class TestSystemSocketWatch : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        ASSERT_EQ(Platform::MemoryInit(), CHIP_NO_ERROR);
+        ASSERT_EQ(sLayer.Init(), CHIP_NO_ERROR);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sLayer.Shutdown();
+        Platform::MemoryShutdown();
+    }
+
+    void SetUp() override
+    {
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, mSockets), 0);
+        ASSERT_EQ(sLayer.StartWatchingSocket(mSockets[0], &mToken), CHIP_NO_ERROR);
+        ASSERT_EQ(sLayer.SetCallback(mToken, HandleSocketEvents, reinterpret_cast<intptr_t>(this)), CHIP_NO_ERROR);
+    }
+
+    void TearDown() override
+    {
+        EXPECT_EQ(sLayer.StopWatchingSocket(&mToken), CHIP_NO_ERROR);
+        close(mSockets[0]);
+        close(mSockets[1]);
+    }
+
+    // Runs event loop iterations until the timeout elapses.  Each iteration waits until a socket is ready or a timer fires.
+    void ServiceEvents(Clock::Timeout timeout)
+    {
+        bool timedOut = false;
+        ASSERT_EQ(sLayer.StartTimer(timeout, HandleTimeout, &timedOut), CHIP_NO_ERROR);
+        while (!timedOut)
+        {
+            sLayer.PrepareEvents();
+            sLayer.WaitForEvents();
+            sLayer.HandleEvents();
+        }
+    }
+
+    // Runs a single event loop iteration, which does not wait for longer than the timeout.
+    void ServiceEventsOnce(Clock::Timeout timeout)
+    {
+        bool timedOut = false;
+        ASSERT_EQ(sLayer.StartTimer(timeout, HandleTimeout, &timedOut), CHIP_NO_ERROR);
+        sLayer.PrepareEvents();
+        sLayer.WaitForEvents();
+        sLayer.HandleEvents();
+        sLayer.CancelTimer(HandleTimeout, &timedOut);
+    }
+
+    void WriteToPeer(size_t length)
+    {
+        const uint8_t data[16] = {};
+        ASSERT_LE(length, sizeof(data));
+        ASSERT_EQ(write(mSockets[1], data, length), static_cast<ssize_t>(length));
+    }
+
+    static LayerImpl sLayer;
+
+    int mSockets[2];
+    SocketWatchToken mToken;
+
+    // What the callback does: how many bytes it reads on kRead.
+    size_t mBytesToRead = SIZE_MAX;
+
+    unsigned mReadCallbacks  = 0;
+    unsigned mWriteCallbacks = 0;
+    size_t mBytesRead        = 0;
+
+private:
+    static void HandleTimeout(Layer *, void * appState) { *static_cast<bool *>(appState) = true; }
+
+    static void HandleSocketEvents(SocketEvents events, intptr_t data)
+    {
+        auto * test = reinterpret_cast<TestSystemSocketWatch *>(data);
+        if (events.Has(SocketEventFlags::kRead))
+        {
+            test->mReadCallbacks++;
+
+            uint8_t buffer[16];
+            const ssize_t length = read(test->mSockets[0], buffer, std::min(test->mBytesToRead, sizeof(buffer)));
+            if (length > 0)
+            {
+                test->mBytesRead += static_cast<size_t>(length);
+            }
+        }
+        if (events.Has(SocketEventFlags::kWrite))
+        {
+            test->mWriteCallbacks++;
+        }
+    }
+};
+
+LayerImpl TestSystemSocketWatch::sLayer;
+
+TEST_F(TestSystemSocketWatch, CallbackOnPendingRead)
+{
+    EXPECT_EQ(sLayer.RequestCallbackOnPendingRead(mToken), CHIP_NO_ERROR);
+
+    // Nothing to read yet.
+    ServiceEventsOnce(10_ms);
+    EXPECT_EQ(mReadCallbacks, 0u);
+
+    WriteToPeer(4);
+    ServiceEventsOnce(1000_ms);
+    EXPECT_EQ(mReadCallbacks, 1u);
+    EXPECT_EQ(mBytesRead, 4u);
+    EXPECT_EQ(mWriteCallbacks, 0u);
+}
+
+TEST_F(TestSystemSocketWatch, CallbackUntilDrained)
+{
+    // Handlers such as the UDP endpoint's consume one datagram per callback, and must be called again while data is left.
+    mBytesToRead = 1;
+    EXPECT_EQ(sLayer.RequestCallbackOnPendingRead(mToken), CHIP_NO_ERROR);
+
+    WriteToPeer(3);
+    for (int i = 0; i < 10 && mBytesRead < 3; i++)
+    {
+        ServiceEventsOnce(1000_ms);
+    }
+    EXPECT_EQ(mBytesRead, 3u);
+    EXPECT_EQ(mReadCallbacks, 3u);
+
+    // And not once drained.
+    ServiceEvents(20_ms);
+    EXPECT_EQ(mReadCallbacks, 3u);
+}
+
+TEST_F(TestSystemSocketWatch, CallbackOnPendingWrite)
+{
+    // The socket is writable right away.
+    EXPECT_EQ(sLayer.RequestCallbackOnPendingWrite(mToken), CHIP_NO_ERROR);
+    ServiceEventsOnce(1000_ms);
+    EXPECT_EQ(mWriteCallbacks, 1u);
+
+    // Switching to read only stops the write callbacks, and the read callback then only comes with data.
+    EXPECT_EQ(sLayer.ClearCallbackOnPendingWrite(mToken), CHIP_NO_ERROR);
+    EXPECT_EQ(sLayer.RequestCallbackOnPendingRead(mToken), CHIP_NO_ERROR);
+    ServiceEvents(20_ms);
+    EXPECT_EQ(mWriteCallbacks, 1u);
+    EXPECT_EQ(mReadCallbacks, 0u);
+
+    WriteToPeer(1);
+    ServiceEventsOnce(1000_ms);
+    EXPECT_EQ(mReadCallbacks, 1u);
+    EXPECT_EQ(mWriteCallbacks, 1u);
+}
+
+TEST_F(TestSystemSocketWatch, ClearCallbackOnPendingRead)
+{
+    EXPECT_EQ(sLayer.RequestCallbackOnPendingRead(mToken), CHIP_NO_ERROR);
+    EXPECT_EQ(sLayer.ClearCallbackOnPendingRead(mToken), CHIP_NO_ERROR);
+
+    WriteToPeer(1);
+    ServiceEvents(20_ms);
+    EXPECT_EQ(mReadCallbacks, 0u);
+
+    // Requesting it again reports the data that is already there.
+    EXPECT_EQ(sLayer.RequestCallbackOnPendingRead(mToken), CHIP_NO_ERROR);
+    ServiceEventsOnce(1000_ms);
+    EXPECT_EQ(mReadCallbacks, 1u);
+    EXPECT_EQ(mBytesRead, 1u);
+}
+
+TEST_F(TestSystemSocketWatch, StopWatchingSocket)
+{
+    EXPECT_EQ(sLayer.RequestCallbackOnPendingRead(mToken), CHIP_NO_ERROR);
+    EXPECT_EQ(sLayer.StopWatchingSocket(&mToken), CHIP_NO_ERROR);
+    EXPECT_EQ(mToken, sLayer.InvalidSocketWatchToken());
+
+    WriteToPeer(1);
+    ServiceEvents(20_ms);
+    EXPECT_EQ(mReadCallbacks, 0u);
+
+    // The watch can be reused for another socket (TearDown stops watching this one).
+    ASSERT_EQ(sLayer.StartWatchingSocket(mSockets[0], &mToken), CHIP_NO_ERROR);
+}
+
+TEST_F(TestSystemSocketWatch, ManySockets)
+{
+    // Fill the remaining watches: each is reported independently of the others.
+    struct Watch
+    {
+        int sockets[2];
+        SocketWatchToken token;
+        unsigned callbacks;
+    };
+    constexpr size_t kMaxWatches = 16;
+    Watch watches[kMaxWatches];
+    size_t watchCount = 0;
+
+    for (; watchCount < kMaxWatches; watchCount++)
+    {
+        Watch & watch = watches[watchCount];
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, watch.sockets), 0);
+        if (sLayer.StartWatchingSocket(watch.sockets[0], &watch.token) != CHIP_NO_ERROR)
+        {
+            close(watch.sockets[0]);
+            close(watch.sockets[1]);
+            break;
+        }
+        watch.callbacks = 0;
+        EXPECT_EQ(sLayer.SetCallback(
+                      watch.token,
+                      [](SocketEvents events, intptr_t data) {
+                          auto * w = reinterpret_cast<Watch *>(data);
+                          uint8_t byte;
+                          if (read(w->sockets[0], &byte, sizeof(byte)) == 1)
+                          {
+                              w->callbacks++;
+                          }
+                      },
+                      reinterpret_cast<intptr_t>(&watch)),
+                  CHIP_NO_ERROR);
+        EXPECT_EQ(sLayer.RequestCallbackOnPendingRead(watch.token), CHIP_NO_ERROR);
+    }
+    ASSERT_GT(watchCount, 0u);
+
+    // Only the odd ones are ready.
+    for (size_t i = 1; i < watchCount; i += 2)
+    {
+        ASSERT_EQ(write(watches[i].sockets[1], "x", 1), 1);
+    }
+    ServiceEvents(20_ms);
+
+    for (size_t i = 0; i < watchCount; i++)
+    {
+        EXPECT_EQ(watches[i].callbacks, (i % 2 == 1) ? 1u : 0u);
+        EXPECT_EQ(sLayer.StopWatchingSocket(&watches[i].token), CHIP_NO_ERROR);
+        close(watches[i].sockets[0]);
+        close(watches[i].sockets[1]);
+    }
+}
+
+} // namespace
+
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH && !CHIP_SYSTEM_CONFIG_USE_LIBEV
@@ -27,6 +27,9 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <memory>
+#include <vector>
+
 #include <pw_unit_test/framework.h>
 
 #include <lib/core/ErrorStr.h>
@@ -564,6 +567,152 @@ TEST_F(TestSystemTimer, CheckTimerPool)
     EXPECT_TRUE(SYSTEM_STATS_TEST_HIGH_WATER_MARK(Stats::kSystemLayer_NumTimers, 4));
 }
 
+// Test TimerWheel against the ordering guarantees of TimerList.
+TEST_F(TestSystemTimer, CheckTimerWheel)
+{
+    using Timer = TimerWheel::Node;
+    struct TestState
+    {
+        static void A(Layer * layer, void * state) {}
+        static void B(Layer * layer, void * state) {}
+    };
+    int stateX = 0;
+    int stateY = 0;
+
+    using namespace Clock::Literals;
+    struct
+    {
+        Clock::Timestamp awakenTime;
+        TimerCompleteCallback onComplete;
+        void * appState;
+        Timer * timer;
+    } testTimer[] = {
+        { 5000_ms, TestState::A, &stateX },          // 0
+        { 100_ms, TestState::A, &stateY },           // 1
+        { 100_ms, TestState::B, &stateX },           // 2: same time as 1, added later
+        { 3600000_ms, TestState::B, &stateY },       // 3
+        { 170_ms, TestState::A, &stateX },           // 4
+        { 0x10000000000_ms, TestState::A, &stateY }, // 5: far in the future
+        { 100_ms, TestState::A, &stateY },           // 6: same time and properties as 1, added later
+    };
+
+    TimerPool<Timer> pool;
+    for (auto & timer : testTimer)
+    {
+        timer.timer = pool.Create(mLayer, timer.awakenTime, timer.onComplete, timer.appState);
+        ASSERT_NE(timer.timer, nullptr);
+    }
+
+    // The wheel is a few kilobytes, so keep it off the stack.
+    auto wheelPtr = Platform::MakeUnique<TimerWheel>();
+    ASSERT_TRUE(wheelPtr);
+    TimerWheel & wheel = *wheelPtr;
+
+    EXPECT_EQ(wheel.Remove(nullptr), nullptr);
+    EXPECT_EQ(wheel.Remove(nullptr, nullptr), nullptr);
+    EXPECT_EQ(wheel.PopEarliest(), nullptr);
+    EXPECT_EQ(wheel.PopIfEarlier(500_ms), nullptr);
+    EXPECT_EQ(wheel.Earliest(), nullptr);
+    EXPECT_TRUE(wheel.Empty());
+
+    EXPECT_EQ(wheel.Add(testTimer[0].timer), testTimer[0].timer);
+    EXPECT_EQ(wheel.Add(testTimer[1].timer), testTimer[1].timer);
+    EXPECT_EQ(wheel.Add(testTimer[2].timer), testTimer[1].timer);
+    EXPECT_EQ(wheel.Add(testTimer[3].timer), testTimer[1].timer);
+    EXPECT_EQ(wheel.Add(testTimer[4].timer), testTimer[1].timer);
+    EXPECT_EQ(wheel.Add(testTimer[5].timer), testTimer[1].timer);
+    EXPECT_EQ(wheel.Add(testTimer[6].timer), testTimer[1].timer);
+    EXPECT_FALSE(wheel.Empty());
+
+    // Removing by properties takes the earliest match, and the first added among equal times.
+    EXPECT_EQ(wheel.Remove(TestState::A, &stateY), testTimer[1].timer);
+    EXPECT_EQ(wheel.Earliest(), testTimer[2].timer);
+    EXPECT_EQ(wheel.Remove(TestState::B, &stateX), testTimer[2].timer);
+    EXPECT_EQ(wheel.Earliest(), testTimer[6].timer);
+    EXPECT_EQ(wheel.Add(testTimer[1].timer), testTimer[6].timer);
+    EXPECT_EQ(wheel.Add(testTimer[2].timer), testTimer[6].timer);
+
+    // Equal expiration times come out in the order they were added.
+    EXPECT_EQ(wheel.PopIfEarlier(100_ms), nullptr);
+    TimerList early = wheel.ExtractEarlier(1000_ms);
+    EXPECT_EQ(early.PopEarliest(), testTimer[6].timer);
+    EXPECT_EQ(early.PopEarliest(), testTimer[1].timer);
+    EXPECT_EQ(early.PopEarliest(), testTimer[2].timer);
+    EXPECT_EQ(early.PopEarliest(), testTimer[4].timer);
+    EXPECT_EQ(early.PopEarliest(), nullptr);
+    EXPECT_EQ(wheel.Earliest(), testTimer[0].timer);
+
+    // A timer added in the past of the wheel's current time still comes first.
+    EXPECT_EQ(wheel.Add(testTimer[1].timer), testTimer[1].timer);
+    EXPECT_EQ(wheel.Remove(testTimer[0].timer), testTimer[1].timer);
+    EXPECT_EQ(wheel.PopEarliest(), testTimer[1].timer);
+    EXPECT_EQ(wheel.PopIfEarlier(3600000_ms), nullptr);
+    EXPECT_EQ(wheel.PopIfEarlier(3600001_ms), testTimer[3].timer);
+    EXPECT_EQ(wheel.PopEarliest(), testTimer[5].timer);
+    EXPECT_EQ(wheel.PopEarliest(), nullptr);
+    EXPECT_TRUE(wheel.Empty());
+
+    wheel.Add(testTimer[0].timer);
+    wheel.Clear();
+    EXPECT_TRUE(wheel.Empty());
+    EXPECT_EQ(wheel.Earliest(), nullptr);
+
+    pool.ReleaseAll();
+}
+
+// Test TimerWheel lookups by properties with more timers than a fixed pool holds, which grows the index of heap-backed pools.
+TEST_F(TestSystemTimer, CheckTimerWheelIndex)
+{
+    using Timer = TimerWheel::Node;
+    struct TestState
+    {
+        static void A(Layer * layer, void * state) {}
+        static void B(Layer * layer, void * state) {}
+    };
+
+    using namespace Clock::Literals;
+    constexpr size_t kTimerCount = 16 * CHIP_SYSTEM_CONFIG_NUM_TIMERS;
+    static uint8_t states[kTimerCount];
+
+    // Each state has a timer for A, and two timers for B expiring together.
+    const Clock::Timestamp now = SystemClock().GetMonotonicTimestamp();
+    std::vector<std::unique_ptr<Timer>> timers;
+    for (size_t i = 0; i < kTimerCount; i++)
+    {
+        const Clock::Timestamp awakenTime = now + 3600000_ms + Clock::Milliseconds64((i % 7) * 10);
+        timers.emplace_back(new Timer(mLayer, awakenTime, TestState::A, &states[i]));
+        timers.emplace_back(new Timer(mLayer, awakenTime, TestState::B, &states[i]));
+        timers.emplace_back(new Timer(mLayer, awakenTime, TestState::B, &states[i]));
+    }
+
+    auto wheelPtr = Platform::MakeUnique<TimerWheel>();
+    ASSERT_TRUE(wheelPtr);
+    TimerWheel & wheel = *wheelPtr;
+    for (auto & timer : timers)
+    {
+        wheel.Add(timer.get());
+    }
+
+    for (size_t i = 0; i < kTimerCount; i++)
+    {
+        // Alternate between the ends, so that the removals are not in the order of addition.
+        const size_t n = (i % 2 == 0) ? i / 2 : kTimerCount - 1 - i / 2;
+        EXPECT_NE(wheel.GetRemainingTime(TestState::A, &states[n]), Clock::kZero);
+        EXPECT_EQ(wheel.Remove(TestState::B, &states[n]), timers[3 * n + 1].get());
+        EXPECT_EQ(wheel.Remove(TestState::A, &states[n]), timers[3 * n].get());
+        EXPECT_EQ(wheel.Remove(TestState::B, &states[n]), timers[3 * n + 2].get());
+        EXPECT_EQ(wheel.Remove(TestState::B, &states[n]), nullptr);
+    }
+    EXPECT_TRUE(wheel.Empty());
+
+    // Clearing keeps the grown index usable.
+    wheel.Add(timers[0].get());
+    wheel.Clear();
+    EXPECT_EQ(wheel.Remove(TestState::A, &states[0]), nullptr);
+    wheel.Add(timers[3].get());
+    EXPECT_EQ(wheel.Remove(TestState::A, &states[1]), timers[3].get());
+}
+
 TEST_F(TestSystemTimer, ExtendTimerToTest)
 {
     if (!LayerEvents<LayerImpl>::HasServiceEvents())
@@ -78,5 +78,8 @@ constexpr MetricKey kMetricDeviceRMPRetryCount = "core_dev_rmp_retry_count";
 // Subscription setup
 constexpr MetricKey kMetricDeviceSubscriptionSetup = "core_dev_subscription_setup";
 
+// Time a reportable read handler waited for the reporting engine to send its report, in microseconds
+constexpr MetricKey kMetricReportQueueingDelay = "core_im_report_queueing_delay";
+
 } // namespace Tracing
 } // namespace chip
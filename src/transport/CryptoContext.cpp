@@ -261,6 +261,35 @@ CHIP_ERROR CryptoContext::Decrypt(const uint8_t * input, size_t input_length, ui
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CryptoContext::DecryptInPlace(uint8_t * data, size_t length, ConstNonceView nonce, const PacketHeader & header,
+                                         const MessageAuthenticationCode & mac, MessageOnFailure onFailure) const
+{
+    const size_t taglen = header.MICTagLength();
+    const uint8_t * tag = mac.GetTag();
+    uint8_t AAD[kMaxAADLen];
+    uint16_t aadLen = sizeof(AAD);
+
+    VerifyOrReturnError(data != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    ReturnErrorOnFailure(GetAdditionalAuthData(header, AAD, aadLen));
+
+    if (nullptr != mKeyContext)
+    {
+        MutableByteSpan message(data, length);
+        ByteSpan mic(tag, taglen);
+
+        if (onFailure == MessageOnFailure::kDiscard)
+        {
+            return mKeyContext->MessageDecrypt(message, ByteSpan(AAD, aadLen), nonce, mic, message);
+        }
+        return mKeyContext->MessageDecryptInPlace(message, ByteSpan(AAD, aadLen), nonce, mic);
+    }
+
+    VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    return AES_CCM_decrypt(data, length, AAD, aadLen, tag, taglen, mDecryptionKey, nonce.data(), nonce.size(), data);
+}
+
 CHIP_ERROR CryptoContext::PrivacyEncrypt(const uint8_t * input, size_t input_length, uint8_t * output, PacketHeader & header,
                                          MessageAuthenticationCode & mac) const
 {
@@ -66,6 +66,15 @@ public:
         kSessionResumption,    /**< An old session is being resumed. */
     };
 
+    /**
+     *    What DecryptInPlace has to leave of a message that a group key fails to decrypt.
+     */
+    enum class MessageOnFailure : uint8_t
+    {
+        kKeep,    /**< The message is left as is, for other keys to be tried on it. */
+        kDiscard, /**< The message is dropped if this key fails: it is decrypted directly and may be left altered. */
+    };
+
     /**
      * @brief
      *   Derive a shared key. The derived key will be used for encrypting/decrypting
@@ -146,6 +155,25 @@ public:
     CHIP_ERROR Decrypt(const uint8_t * input, size_t input_length, uint8_t * output, ConstNonceView nonce,
                        const PacketHeader & header, const MessageAuthenticationCode & mac) const;
 
+    /**
+     * @brief
+     *   Decrypt the data in place using keys established in the secure channel.
+     *
+     *   Data that a group key fails to decrypt is left as is, for other group keys to be tried on it, which costs
+     *   two more AES passes over the data, unless onFailure is kDiscard. A message that fails to decrypt with a
+     *   session key is dropped, so session keys decrypt it directly and may leave it altered.
+     *
+     * @param data Encrypted data, replaced with the decrypted data
+     * @param length Length of the data
+     * @param nonce Nonce buffer for decrypt
+     * @param header message header structure
+     * @param mac Input mac
+     * @param onFailure Whether data a group key fails to decrypt has to be left as is
+     * @return CHIP_ERROR The result of decryption
+     */
+    CHIP_ERROR DecryptInPlace(uint8_t * data, size_t length, ConstNonceView nonce, const PacketHeader & header,
+                              const MessageAuthenticationCode & mac, MessageOnFailure onFailure = MessageOnFailure::kKeep) const;
+
     CHIP_ERROR PrivacyEncrypt(const uint8_t * input, size_t input_length, uint8_t * output, PacketHeader & header,
                               MessageAuthenticationCode & mac) const;
 
@@ -0,0 +1,135 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <transport/GroupKeyHintCache.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace Transport {
+
+using Credentials::GroupDataProvider;
+
+void GroupKeyHintCache::Entry::Release()
+{
+    if (hint.session.keyContext != nullptr)
+    {
+        hint.session.keyContext->Release();
+        hint.session.keyContext = nullptr;
+    }
+}
+
+const GroupKeyHintCache::Hint * GroupKeyHintCache::Find(GroupDataProvider & provider, uint16_t sessionId, NodeId sourceNodeId)
+{
+    Validate(provider);
+
+    Entry * entry = FindEntry(sessionId, sourceNodeId);
+    if (entry == nullptr)
+    {
+        mMissCount++;
+        return nullptr;
+    }
+
+    mHitCount++;
+    entry->lastUsed = ++mUseCounter;
+    return &entry->hint;
+}
+
+void GroupKeyHintCache::Add(GroupDataProvider & provider, uint16_t sessionId, NodeId sourceNodeId,
+                            const GroupDataProvider::GroupSession & session, bool unique)
+{
+    VerifyOrReturn(kCacheSize > 0);
+    Validate(provider);
+
+    Entry * entry = FindEntry(sessionId, sourceNodeId);
+    if (entry == nullptr)
+    {
+        for (Entry & candidate : mEntries)
+        {
+            if (entry == nullptr || candidate.IsFree() || (!entry->IsFree() && candidate.lastUsed < entry->lastUsed))
+            {
+                entry = &candidate;
+            }
+        }
+    }
+    VerifyOrReturn(entry != nullptr);
+    entry->Release();
+
+    Crypto::SymmetricKeyContext * keyContext =
+        provider.GetKeyContextForSession(session.fabric_index, session.group_id, sessionId);
+    VerifyOrReturn(keyContext != nullptr);
+
+    entry->hint.session            = session;
+    entry->hint.session.keyContext = keyContext;
+    entry->hint.unique             = unique;
+    entry->sessionId               = sessionId;
+    entry->sourceNodeId            = sourceNodeId;
+    entry->lastUsed                = ++mUseCounter;
+}
+
+void GroupKeyHintCache::Remove(uint16_t sessionId, NodeId sourceNodeId)
+{
+    Entry * entry = FindEntry(sessionId, sourceNodeId);
+    if (entry != nullptr)
+    {
+        entry->Release();
+    }
+}
+
+void GroupKeyHintCache::Clear()
+{
+    // The key contexts the provider already released are only forgotten.
+    const bool released = (mProvider != nullptr && mProvider->GetKeyContextsGeneration() != mKeyContextsGeneration);
+    for (Entry & entry : mEntries)
+    {
+        if (released)
+        {
+            entry.Forget();
+        }
+        else
+        {
+            entry.Release();
+        }
+    }
+    mProvider = nullptr;
+}
+
+GroupKeyHintCache::Entry * GroupKeyHintCache::FindEntry(uint16_t sessionId, NodeId sourceNodeId)
+{
+    for (Entry & entry : mEntries)
+    {
+        if (!entry.IsFree() && entry.sessionId == sessionId && entry.sourceNodeId == sourceNodeId)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void GroupKeyHintCache::Validate(GroupDataProvider & provider)
+{
+    if (mProvider != &provider || mKeysGeneration != provider.GetKeysGeneration() ||
+        mKeyContextsGeneration != provider.GetKeyContextsGeneration())
+    {
+        Clear();
+        mProvider              = &provider;
+        mKeysGeneration        = provider.GetKeysGeneration();
+        mKeyContextsGeneration = provider.GetKeyContextsGeneration();
+    }
+}
+
+} // namespace Transport
+} // namespace chip
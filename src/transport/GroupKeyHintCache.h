@@ -0,0 +1,110 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a cache of the operational group keys that last decrypted
+ *      group messages, indexed by group session ID and source node.
+ *
+ */
+#pragma once
+
+#include <credentials/GroupDataProvider.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/NodeId.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * Remembers, for a (group session ID, source node ID) pair, which group and operational key last
+ * decrypted a message, so that SessionManager can try that key first instead of trial-decrypting
+ * with every key whose hash matches the session ID.
+ *
+ * Hints own a key context obtained through GroupDataProvider::GetKeyContextForSession() and are all
+ * dropped as soon as the provider's keys generation changes (i.e. on any keyset or group-key map
+ * write), or its key contexts generation does (e.g. on Finish(), which releases the key contexts
+ * itself). The least recently used hint is replaced when the cache is full.
+ */
+class GroupKeyHintCache
+{
+public:
+    struct Hint
+    {
+        Credentials::GroupDataProvider::GroupSession session;
+
+        // True when no other key mapped to session.group_id shares its session ID, on any fabric.
+        // A message addressed to that group can then only be decrypted with this key, so there is
+        // no need to preserve the original message in case the attempt fails.
+        bool unique = false;
+    };
+
+    GroupKeyHintCache() = default;
+    ~GroupKeyHintCache() { Clear(); }
+
+    GroupKeyHintCache(const GroupKeyHintCache &)             = delete;
+    GroupKeyHintCache & operator=(const GroupKeyHintCache &) = delete;
+
+    /**
+     * Look up the hint for a message. Source node ID is kUndefinedNodeId when it is not known
+     * before decryption (privacy-protected messages).
+     *
+     * @return the hint, valid until the next call to a non-const method, or nullptr on a miss.
+     */
+    const Hint * Find(Credentials::GroupDataProvider & provider, uint16_t sessionId, NodeId sourceNodeId);
+
+    /**
+     * Record the group session that decrypted a message. Does nothing if the provider cannot hand
+     * out a standalone key context for it.
+     */
+    void Add(Credentials::GroupDataProvider & provider, uint16_t sessionId, NodeId sourceNodeId,
+             const Credentials::GroupDataProvider::GroupSession & session, bool unique);
+
+    void Remove(uint16_t sessionId, NodeId sourceNodeId);
+    void Clear();
+
+    uint32_t GetHitCount() const { return mHitCount; }
+    uint32_t GetMissCount() const { return mMissCount; }
+
+private:
+    struct Entry
+    {
+        bool IsFree() const { return hint.session.keyContext == nullptr; }
+        void Release();
+        void Forget() { hint.session.keyContext = nullptr; }
+
+        Hint hint;
+        uint16_t sessionId  = 0;
+        NodeId sourceNodeId = kUndefinedNodeId;
+        uint32_t lastUsed   = 0;
+    };
+
+    Entry * FindEntry(uint16_t sessionId, NodeId sourceNodeId);
+    void Validate(Credentials::GroupDataProvider & provider);
+
+    static constexpr size_t kCacheSize = CHIP_CONFIG_GROUP_KEY_HINT_CACHE_SIZE;
+
+    Entry mEntries[kCacheSize > 0 ? kCacheSize : 1];
+    Credentials::GroupDataProvider * mProvider = nullptr;
+    uint32_t mKeysGeneration                   = 0;
+    uint32_t mKeyContextsGeneration            = 0;
+    uint32_t mUseCounter                       = 0;
+    uint32_t mHitCount                         = 0;
+    uint32_t mMissCount                        = 0;
+};
+
+} // namespace Transport
+} // namespace chip
@@ -0,0 +1,114 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the estimator of the round-trip time of a session,
+ *      measured from the acknowledgments of its messages.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <stdint.h>
+
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * Estimates the round-trip time to the peer of a session as TCP does (RFC 6298): a smoothed round-trip time (SRTT) and its
+ * mean deviation (RTTVAR), updated with each sample, from which a retransmission timeout of SRTT + 4 * RTTVAR derives.
+ *
+ * The samples are the times between sending a message and receiving its acknowledgment, for messages that were not
+ * retransmitted, since the acknowledgment of a retransmitted message may be the one of any of its transmissions.  They
+ * include the time the peer took to acknowledge the message.
+ */
+class RoundTripTimeEstimator
+{
+public:
+    /// Adds a round-trip time sample.
+    void AddSample(System::Clock::Milliseconds32 rtt)
+    {
+        const uint32_t sample = rtt.count();
+
+        // As in most TCP implementations, SRTT is kept scaled by 8 and RTTVAR by 4, so that the updates
+        // (SRTT += (sample - SRTT) / 8 and RTTVAR += (|sample - SRTT| - RTTVAR) / 4) keep the fractional parts.
+        if (mSampleCount == 0)
+        {
+            mScaledSmoothedRtt  = sample << kSmoothedRttShift;
+            mScaledRttVariation = sample << (kRttVariationShift - 1);
+            mMinRtt             = sample;
+        }
+        else
+        {
+            const int64_t smoothedRtt = mScaledSmoothedRtt >> kSmoothedRttShift;
+            const int64_t error       = static_cast<int64_t>(sample) - smoothedRtt;
+            const int64_t deviation   = (error < 0) ? -error : error;
+
+            mScaledSmoothedRtt  = static_cast<uint32_t>(static_cast<int64_t>(mScaledSmoothedRtt) + error);
+            mScaledRttVariation = static_cast<uint32_t>(static_cast<int64_t>(mScaledRttVariation) + deviation -
+                                                        static_cast<int64_t>(mScaledRttVariation >> kRttVariationShift));
+            mMinRtt             = std::min(mMinRtt, sample);
+        }
+
+        mLatestRtt = sample;
+        if (mSampleCount < UINT32_MAX)
+        {
+            mSampleCount++;
+        }
+    }
+
+    /// Forgets the samples, e.g. when the path to the peer changes.
+    void Reset() { *this = RoundTripTimeEstimator(); }
+
+    bool HasSample() const { return mSampleCount > 0; }
+    uint32_t GetSampleCount() const { return mSampleCount; }
+
+    System::Clock::Milliseconds32 GetSmoothedRtt() const
+    {
+        return System::Clock::Milliseconds32(mScaledSmoothedRtt >> kSmoothedRttShift);
+    }
+    System::Clock::Milliseconds32 GetRttVariation() const
+    {
+        return System::Clock::Milliseconds32(mScaledRttVariation >> kRttVariationShift);
+    }
+    System::Clock::Milliseconds32 GetLatestRtt() const { return System::Clock::Milliseconds32(mLatestRtt); }
+    System::Clock::Milliseconds32 GetMinRtt() const { return System::Clock::Milliseconds32(mMinRtt); }
+
+    /// Returns SRTT + 4 * RTTVAR, within [minimum, maximum].  Must only be called once HasSample() is true.
+    System::Clock::Milliseconds32 GetRetransmissionTimeout(System::Clock::Milliseconds32 minimum,
+                                                           System::Clock::Milliseconds32 maximum) const
+    {
+        const uint64_t timeout = (mScaledSmoothedRtt >> kSmoothedRttShift) + static_cast<uint64_t>(mScaledRttVariation);
+        return System::Clock::Milliseconds32(static_cast<uint32_t>(
+            std::max<uint64_t>(minimum.count(), std::min<uint64_t>(timeout, std::max(minimum, maximum).count()))));
+    }
+
+private:
+    static constexpr unsigned kSmoothedRttShift  = 3;
+    static constexpr unsigned kRttVariationShift = 2;
+
+    uint32_t mScaledSmoothedRtt  = 0; // SRTT * 8, in milliseconds
+    uint32_t mScaledRttVariation = 0; // RTTVAR * 4, in milliseconds
+    uint32_t mLatestRtt          = 0;
+    uint32_t mMinRtt             = 0;
+    uint32_t mSampleCount        = 0;
+};
+
+} // namespace Transport
+} // namespace chip
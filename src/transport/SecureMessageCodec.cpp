@@ -58,24 +58,15 @@ CHIP_ERROR Encrypt(const CryptoContext & context, CryptoContext::ConstNonceView
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR Decrypt(const CryptoContext & context, CryptoContext::ConstNonceView nonce, PayloadHeader & payloadHeader,
-                   const PacketHeader & packetHeader, System::PacketBufferHandle & msg)
-{
-    ReturnErrorCodeIf(msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+namespace {
 
+CHIP_ERROR DecryptInPlace(const CryptoContext & context, CryptoContext::ConstNonceView nonce, PayloadHeader & payloadHeader,
+                          const PacketHeader & packetHeader, System::PacketBufferHandle & msg,
+                          CryptoContext::MessageOnFailure onFailure)
+{
     uint8_t * data = msg->Start();
     size_t len     = msg->DataLength();
 
-    PacketBufferHandle origMsg;
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-    /* This is a workaround for the case where PacketBuffer payload is not
-        allocated as an inline buffer to PacketBuffer structure */
-    origMsg = std::move(msg);
-    msg     = PacketBufferHandle::New(len);
-    VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_NO_MEMORY);
-    msg->SetDataLength(len);
-#endif
-
     uint16_t footerLen = packetHeader.MICTagLength();
     VerifyOrReturnError(footerLen <= len, CHIP_ERROR_INVALID_MESSAGE_LENGTH);
 
@@ -84,16 +75,35 @@ CHIP_ERROR Decrypt(const CryptoContext & context, CryptoContext::ConstNonceView
     ReturnErrorOnFailure(mac.Decode(packetHeader, &data[len - footerLen], footerLen, &taglen));
     VerifyOrReturnError(taglen == footerLen, CHIP_ERROR_INTERNAL);
 
+    // Leave the buffer as it was until the message is decrypted.
     len = len - taglen;
+    ReturnErrorOnFailure(context.DecryptInPlace(data, len, nonce, packetHeader, mac, onFailure));
     msg->SetDataLength(len);
 
-    uint8_t * plainText = msg->Start();
-    ReturnErrorOnFailure(context.Decrypt(data, len, plainText, nonce, packetHeader, mac));
-
     ReturnErrorOnFailure(payloadHeader.DecodeAndConsume(msg));
     return CHIP_NO_ERROR;
 }
 
+} // namespace
+
+CHIP_ERROR Decrypt(const CryptoContext & context, CryptoContext::ConstNonceView nonce, PayloadHeader & payloadHeader,
+                   const PacketHeader & packetHeader, System::PacketBufferHandle & msg, CryptoContext::MessageOnFailure onFailure)
+{
+    ReturnErrorCodeIf(msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+    /* This is a workaround for the case where PacketBuffer payload is not
+        allocated as an inline buffer to PacketBuffer structure */
+    PacketBufferHandle inlineMsg = PacketBufferHandle::NewWithData(msg->Start(), msg->DataLength());
+    VerifyOrReturnError(!inlineMsg.IsNull(), CHIP_ERROR_NO_MEMORY);
+    ReturnErrorOnFailure(DecryptInPlace(context, nonce, payloadHeader, packetHeader, inlineMsg, onFailure));
+    msg = std::move(inlineMsg);
+    return CHIP_NO_ERROR;
+#else
+    return DecryptInPlace(context, nonce, payloadHeader, packetHeader, msg, onFailure);
+#endif
+}
+
 } // namespace SecureMessageCodec
 
 } // namespace chip
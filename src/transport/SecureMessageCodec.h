@@ -63,11 +63,17 @@ CHIP_ERROR Encrypt(const CryptoContext & context, CryptoContext::ConstNonceView
  *                      portion of the message header
  * @param msgBuf        The message buffer that contains the encrypted message. If
  *                      the operation is successful, this buffer will be mutated to contain
- *                      the decrypted message.
+ *                      the decrypted message. The message is decrypted in place: if it
+ *                      fails to decrypt with a group key, the buffer is left as it was,
+ *                      for other group keys to be tried on it (see CryptoContext::DecryptInPlace),
+ *                      unless onFailure is kDiscard. A message that decrypts but whose payload
+ *                      header does not decode is left decrypted, with a shorter data length.
+ * @param onFailure     Whether a message a group key fails to decrypt has to be left as it was
  * @return A CHIP_ERROR value consistent with the result of the decryption operation
  */
 CHIP_ERROR Decrypt(const CryptoContext & context, CryptoContext::ConstNonceView nonce, PayloadHeader & payloadHeader,
-                   const PacketHeader & packetHeader, System::PacketBufferHandle & msgBuf);
+                   const PacketHeader & packetHeader, System::PacketBufferHandle & msgBuf,
+                   CryptoContext::MessageOnFailure onFailure = CryptoContext::MessageOnFailure::kKeep);
 
 } // namespace SecureMessageCodec
 
@@ -26,6 +26,7 @@
 #include <lib/core/ReferenceCounted.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
 #include <transport/CryptoContext.h>
+#include <transport/RoundTripTimeEstimator.h>
 #include <transport/Session.h>
 #include <transport/SessionMessageCounter.h>
 #include <transport/raw/PeerAddress.h>
@@ -203,7 +204,17 @@ public:
     }
 
     const PeerAddress & GetPeerAddress() const { return mPeerAddress; }
-    void SetPeerAddress(const PeerAddress & address) { mPeerAddress = address; }
+    void SetPeerAddress(const PeerAddress & address)
+    {
+#if CHIP_CONFIG_MRP_RTT_ESTIMATOR
+        // The round-trip time measured on the previous path says little about the new one.
+        if (!(address == mPeerAddress))
+        {
+            mRoundTripTime.Reset();
+        }
+#endif // CHIP_CONFIG_MRP_RTT_ESTIMATOR
+        mPeerAddress = address;
+    }
 
     Type GetSecureSessionType() const { return mSecureSessionType; }
     bool IsCASESession() const { return GetSecureSessionType() == Type::kCASE; }
@@ -222,16 +233,7 @@ public:
 
     // Called when AddNOC has gone through sufficient success that we need to switch the
     // session to reflect a new fabric if it was a PASE session
-    CHIP_ERROR AdoptFabricIndex(FabricIndex fabricIndex)
-    {
-        // It's not legal to augment session type for non-PASE
-        if (mSecureSessionType != Type::kPASE)
-        {
-            return CHIP_ERROR_INVALID_ARGUMENT;
-        }
-        SetFabricIndex(fabricIndex);
-        return CHIP_NO_ERROR;
-    }
+    CHIP_ERROR AdoptFabricIndex(FabricIndex fabricIndex);
 
     System::Clock::Timestamp GetLastActivityTime() const { return mLastActivityTime; }
     System::Clock::Timestamp GetLastPeerActivityTime() const { return mLastPeerActivityTime; }
@@ -270,6 +272,12 @@ public:
 
     SessionMessageCounter & GetSessionMessageCounter() { return mSessionMessageCounter; }
 
+#if CHIP_CONFIG_MRP_RTT_ESTIMATOR
+    /// Round-trip time to the peer, measured from the acknowledgments of the messages sent on the session.
+    RoundTripTimeEstimator & GetRoundTripTime() { return mRoundTripTime; }
+    const RoundTripTimeEstimator & GetRoundTripTime() const { return mRoundTripTime; }
+#endif // CHIP_CONFIG_MRP_RTT_ESTIMATOR
+
     // This should be a private API, only meant to be called by SecureSessionTable
     // Session holders to this session may shift to the target session regarding SessionDelegate::GetNewSessionHandlingPolicy.
     // It requires that the target sessoin is also a CASE session, having the same peer and CATs as this session.
@@ -349,6 +357,9 @@ private:
     SessionParameters mRemoteSessionParams;
     CryptoContext mCryptoContext;
     SessionMessageCounter mSessionMessageCounter;
+#if CHIP_CONFIG_MRP_RTT_ESTIMATOR
+    RoundTripTimeEstimator mRoundTripTime;
+#endif // CHIP_CONFIG_MRP_RTT_ESTIMATOR
 };
 
 } // namespace Transport
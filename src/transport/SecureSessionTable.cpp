@@ -54,7 +54,10 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSessionForTest(Secure
 
     SecureSession * result = mEntries.CreateObject(*this, secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs,
                                                    peerSessionId, fabricIndex, config);
-    return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
+    VerifyOrReturnValue(result != nullptr, Optional<SessionHandle>::Missing());
+
+    AddToIndex(result);
+    return MakeOptional<SessionHandle>(*result);
 }
 
 Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession::Type secureSessionType,
@@ -74,6 +77,10 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession
     if (mEntries.Allocated() < GetMaxSessionTableSize())
     {
         allocated = mEntries.CreateObject(*this, secureSessionType, sessionId.Value());
+        if (allocated != nullptr)
+        {
+            AddToIndex(allocated);
+        }
     }
     else
     {
@@ -139,6 +146,46 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
     //
     // This will be used by the session eviction algorithm later.
     //
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    //
+    // With the peer index available, count sessions per fabric (and per fabric for the
+    // un-indexed undefined peer) in one pass, then look up each session's peer in the
+    // index instead of comparing every pair of sessions.
+    //
+    uint16_t sessionsOnFabric[std::numeric_limits<FabricIndex>::max() + 1]          = {};
+    uint16_t unindexedSessionsOnFabric[std::numeric_limits<FabricIndex>::max() + 1] = {};
+
+    ForEachSession([&sessionsOnFabric, &unindexedSessionsOnFabric](auto * session) {
+        sessionsOnFabric[session->GetFabricIndex()]++;
+        if (!IsIndexedPeer(session->GetPeer()))
+        {
+            unindexedSessionsOnFabric[session->GetFabricIndex()]++;
+        }
+        return Loop::Continue;
+    });
+
+    ForEachSession([&](auto * session) {
+        uint16_t sessionsOnPeer = 0;
+        if (IsIndexedPeer(session->GetPeer()))
+        {
+            mPeerIndex.ForEachMatch(session->GetPeer(), [&sessionsOnPeer](auto *) {
+                sessionsOnPeer++;
+                return Loop::Continue;
+            });
+        }
+        else
+        {
+            sessionsOnPeer = unindexedSessionsOnFabric[session->GetFabricIndex()];
+        }
+
+        sortableSessions[index].mSession             = session;
+        sortableSessions[index].mNumMatchingOnFabric = static_cast<uint16_t>(sessionsOnFabric[session->GetFabricIndex()] - 1);
+        sortableSessions[index].mNumMatchingOnPeer   = static_cast<uint16_t>(sessionsOnPeer - 1);
+
+        index++;
+        return Loop::Continue;
+    });
+#else
     ForEachSession([&index, &sortableSessions, this](auto * session) {
         sortableSessions[index].mSession             = session;
         sortableSessions[index].mNumMatchingOnFabric = 0;
@@ -164,6 +211,7 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
         index++;
         return Loop::Continue;
     });
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
 
     auto sortableSessionSpan = Span<SortableSession>(sortableSessions, mEntries.Allocated());
     EvictionPolicyContext policyContext(sortableSessionSpan, sessionEvictionHint);
@@ -217,7 +265,8 @@ SecureSession * SecureSessionTable::EvictAndAllocate(uint16_t localSessionId, Se
         {
             ChipLogProgress(SecureChannel, "Successfully evicted a session!");
             auto * retSession = mEntries.CreateObject(*this, secureSessionType, localSessionId);
-            VerifyOrDie(session != nullptr);
+            VerifyOrDie(retSession != nullptr);
+            AddToIndex(retSession);
             return retSession;
         }
     }
@@ -339,6 +388,9 @@ void SecureSessionTable::DefaultEvictionPolicy(EvictionPolicyContext & evictionC
 
 Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t localSessionId)
 {
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    SecureSession * result = mLocalSessionIdIndex.FindFirst(localSessionId);
+#else
     SecureSession * result = nullptr;
     mEntries.ForEachActiveObject([&](auto session) {
         if (session->GetLocalSessionId() == localSessionId)
@@ -348,11 +400,24 @@ Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t
         }
         return Loop::Continue;
     });
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
     return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
 }
 
 Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
 {
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    for (uint32_t i = 0; i <= kMaxSessionID; i++)
+    {
+        uint16_t candidate = static_cast<uint16_t>(mNextSessionId + i);
+        if (candidate != kUnsecuredSessionId && mLocalSessionIdIndex.FindFirst(candidate) == nullptr)
+        {
+            return MakeOptional<uint16_t>(candidate);
+        }
+    }
+
+    return NullOptional;
+#else
     uint16_t candidate_base = 0;
     uint64_t candidate_mask = 0;
     for (uint32_t i = 0; i <= kMaxSessionID; i += 64)
@@ -401,6 +466,29 @@ Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
     }
 
     return NullOptional;
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+}
+
+void SecureSessionTable::AddToIndex(SecureSession * session)
+{
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    mLocalSessionIdIndex.Insert(session->GetLocalSessionId(), session);
+    if (IsIndexedPeer(session->GetPeer()))
+    {
+        mPeerIndex.Insert(session->GetPeer(), session);
+    }
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+}
+
+void SecureSessionTable::RemoveFromIndex(SecureSession * session)
+{
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    mLocalSessionIdIndex.Remove(session->GetLocalSessionId(), session);
+    if (IsIndexedPeer(session->GetPeer()))
+    {
+        mPeerIndex.Remove(session->GetPeer(), session);
+    }
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
 }
 
 } // namespace Transport
@@ -23,6 +23,10 @@
 #include <system/TimeSource.h>
 #include <transport/SecureSession.h>
 
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+#include <transport/SecureSessionTableIndex.h>
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
 namespace chip {
 namespace Transport {
 
@@ -76,7 +80,11 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> CreateNewSecureSession(SecureSession::Type secureSessionType, ScopedNodeId sessionEvictionHint);
 
-    void ReleaseSession(SecureSession * session) { mEntries.ReleaseObject(session); }
+    void ReleaseSession(SecureSession * session)
+    {
+        RemoveFromIndex(session);
+        mEntries.ReleaseObject(session);
+    }
 
     template <typename Function>
     Loop ForEachSession(Function && function)
@@ -84,6 +92,40 @@ public:
         return mEntries.ForEachActiveObject(std::forward<Function>(function));
     }
 
+    /**
+     * Call function(SecureSession *) for every session whose GetPeer() matches the given peer,
+     * in no particular order, until it returns Loop::Break.
+     */
+    template <typename Function>
+    Loop ForEachSessionForPeer(const ScopedNodeId & peer, Function && function)
+    {
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+        if (IsIndexedPeer(peer))
+        {
+            return mPeerIndex.ForEachMatch(peer, std::forward<Function>(function));
+        }
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+        return mEntries.ForEachActiveObject([&peer, &function](SecureSession * session) {
+            return session->GetPeer() == peer ? function(session) : Loop::Continue;
+        });
+    }
+
+    // Called by a session whose GetPeer() has changed from previousPeer, to keep lookups by peer up to date.
+    // This is an internal API, using raw pointer to a session is allowed here.
+    void OnSessionPeerChanged(SecureSession * session, const ScopedNodeId & previousPeer)
+    {
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+        if (IsIndexedPeer(previousPeer))
+        {
+            mPeerIndex.Remove(previousPeer, session);
+        }
+        if (IsIndexedPeer(session->GetPeer()))
+        {
+            mPeerIndex.Insert(session->GetPeer(), session);
+        }
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    }
+
     /**
      * Get a secure session given its session ID.
      *
@@ -100,7 +142,7 @@ public:
     void NewerSessionAvailable(SecureSession * session)
     {
         VerifyOrDie(session->GetSecureSessionType() == SecureSession::Type::kCASE);
-        mEntries.ForEachActiveObject([&](SecureSession * oldSession) {
+        ForEachSessionForPeer(session->GetPeer(), [&](SecureSession * oldSession) {
             if (session == oldSession)
                 return Loop::Continue;
 
@@ -248,17 +290,32 @@ private:
      * from the starting mNextSessionId clue.
      *
      * The outer-loop considers 64 session IDs in each iteration to give a
-     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  Speed up could be
-     * achieved with a sorted session table or additional storage.
+     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  When
+     * CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX is enabled, candidate IDs are instead checked
+     * one at a time against the local session ID index.
      *
      * @return an unused session ID if any is found, else NullOptional
      */
     CHECK_RETURN_VALUE
     Optional<uint16_t> FindUnusedSessionId();
 
+    // Must be called on every session right after it is allocated out of mEntries.
+    void AddToIndex(SecureSession * session);
+    void RemoveFromIndex(SecureSession * session);
+
     bool mRunningEvictionLogic = false;
     ObjectPool<SecureSession, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mEntries;
 
+#if CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+    // Sessions that have not learned their peer yet (or PASE sessions, which never do) all share the
+    // same undefined peer, so indexing them would only build one long probe run. Lookups for such a
+    // peer walk mEntries instead.
+    static bool IsIndexedPeer(const ScopedNodeId & peer) { return peer.GetNodeId() != kUndefinedNodeId; }
+
+    SecureSessionTableIndex<uint16_t, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mLocalSessionIdIndex;
+    SecureSessionTableIndex<ScopedNodeId, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mPeerIndex;
+#endif // CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX
+
     size_t GetMaxSessionTableSize() const
     {
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
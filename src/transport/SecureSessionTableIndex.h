@@ -0,0 +1,234 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <lib/core/ScopedNodeId.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Iterators.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Transport {
+
+class SecureSession;
+
+inline size_t HashSecureSessionIndexKey(uint16_t localSessionId)
+{
+    // Multiplying by an odd constant is a bijection on the low bits, so consecutive session IDs
+    // (the common allocation pattern) never collide.
+    return static_cast<size_t>(localSessionId) * 0x9E3779B1u;
+}
+
+inline size_t HashSecureSessionIndexKey(const ScopedNodeId & node)
+{
+    uint64_t hash = node.GetNodeId() ^ (static_cast<uint64_t>(node.GetFabricIndex()) << 56);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return static_cast<size_t>(hash);
+}
+
+/**
+ * Fixed-capacity open-addressed (linear probing) index from a key to the SecureSession objects
+ * carrying it, used by SecureSessionTable to avoid walking the whole session pool on lookups.
+ *
+ * Several sessions may share a key. Removal leaves a tombstone rather than moving entries, so a
+ * ForEachMatch() visitor may release sessions while iterating; runs of tombstones ending at an
+ * empty slot are reclaimed right away, and the rest are purged once they make up a quarter of the
+ * table.
+ */
+template <typename Key, size_t kMaxEntries>
+class SecureSessionTableIndex
+{
+public:
+    void Insert(const Key & key, SecureSession * session)
+    {
+        if (mTombstoneCount > kCapacity / 4 && mIterationDepth == 0)
+        {
+            PurgeTombstones();
+        }
+
+        for (size_t i = 0, index = HomeSlot(key); i < kCapacity; i++, index = NextSlot(index))
+        {
+            Slot & slot = mSlots[index];
+            if (slot.mState != SlotState::kUsed)
+            {
+                if (slot.mState == SlotState::kDeleted)
+                {
+                    mTombstoneCount--;
+                }
+                slot.mState   = SlotState::kUsed;
+                slot.mKey     = key;
+                slot.mSession = session;
+                return;
+            }
+        }
+
+        // The table holds twice as many slots as there can be sessions, so this cannot happen.
+        VerifyOrDie(false);
+    }
+
+    void Remove(const Key & key, SecureSession * session)
+    {
+        size_t index = HomeSlot(key);
+        for (size_t i = 0;; i++, index = NextSlot(index))
+        {
+            Slot & slot = mSlots[index];
+            if (slot.mState == SlotState::kEmpty || i == kCapacity)
+            {
+                return;
+            }
+            if (slot.mState == SlotState::kUsed && slot.mSession == session)
+            {
+                slot.mState = SlotState::kDeleted;
+                mTombstoneCount++;
+                break;
+            }
+        }
+
+        // Nothing probes past an empty slot, so a run of tombstones right before one is dead weight.
+        if (mSlots[NextSlot(index)].mState != SlotState::kEmpty)
+        {
+            return;
+        }
+        while (mSlots[index].mState == SlotState::kDeleted)
+        {
+            mSlots[index].mState = SlotState::kEmpty;
+            mTombstoneCount--;
+            index = PreviousSlot(index);
+        }
+    }
+
+    SecureSession * FindFirst(const Key & key) const
+    {
+        SecureSession * result = nullptr;
+        ForEachMatch(key, [&result](SecureSession * session) {
+            result = session;
+            return Loop::Break;
+        });
+        return result;
+    }
+
+    /**
+     * Call function(SecureSession *) for every session inserted with the given key, until it
+     * returns Loop::Break.
+     */
+    template <typename Function>
+    Loop ForEachMatch(const Key & key, Function && function) const
+    {
+        mIterationDepth++;
+        Loop result = Loop::Finish;
+        for (size_t i = 0, index = HomeSlot(key); i < kCapacity; i++, index = NextSlot(index))
+        {
+            const Slot & slot = mSlots[index];
+            if (slot.mState == SlotState::kEmpty)
+            {
+                break;
+            }
+            if (slot.mState == SlotState::kUsed && slot.mKey == key && function(slot.mSession) == Loop::Break)
+            {
+                result = Loop::Break;
+                break;
+            }
+        }
+        mIterationDepth--;
+        return result;
+    }
+
+private:
+    static constexpr size_t ComputeCapacity()
+    {
+        size_t capacity = 1;
+        while (capacity < 2 * kMaxEntries)
+        {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    static constexpr size_t kCapacity = ComputeCapacity();
+
+    enum class SlotState : uint8_t
+    {
+        kEmpty,
+        kUsed,
+        kDeleted,
+    };
+
+    struct Slot
+    {
+        SecureSession * mSession = nullptr;
+        Key mKey{};
+        SlotState mState = SlotState::kEmpty;
+    };
+
+    static size_t HomeSlot(const Key & key) { return HashSecureSessionIndexKey(key) & (kCapacity - 1); }
+    static size_t NextSlot(size_t index) { return (index + 1) & (kCapacity - 1); }
+    static size_t PreviousSlot(size_t index) { return (index - 1) & (kCapacity - 1); }
+
+    // Drop all tombstones and move every entry to the first free slot of its probe sequence.
+    // Entries are processed in probe order starting right after a slot that was already empty
+    // (which no probe sequence crosses), so each one lands at or before its old position and no
+    // probe sequence is broken along the way.
+    void PurgeTombstones()
+    {
+        size_t start = kCapacity;
+        for (size_t i = 0; i < kCapacity && start == kCapacity; i++)
+        {
+            if (mSlots[i].mState == SlotState::kEmpty)
+            {
+                start = i;
+            }
+        }
+        VerifyOrReturn(start != kCapacity);
+
+        for (Slot & slot : mSlots)
+        {
+            if (slot.mState == SlotState::kDeleted)
+            {
+                slot.mState = SlotState::kEmpty;
+            }
+        }
+        mTombstoneCount = 0;
+
+        for (size_t i = 0, index = NextSlot(start); i < kCapacity; i++, index = NextSlot(index))
+        {
+            if (mSlots[index].mState != SlotState::kUsed)
+            {
+                continue;
+            }
+
+            Slot entry           = mSlots[index];
+            mSlots[index].mState = SlotState::kEmpty;
+            size_t target        = HomeSlot(entry.mKey);
+            while (mSlots[target].mState == SlotState::kUsed)
+            {
+                target = NextSlot(target);
+            }
+            mSlots[target] = entry;
+        }
+    }
+
+    Slot mSlots[kCapacity];
+    size_t mTombstoneCount         = 0;
+    mutable size_t mIterationDepth = 0;
+};
+
+} // namespace Transport
+} // namespace chip
@@ -173,6 +173,9 @@ void SessionManager::Shutdown()
     // partially-shut-down objects.
     ExpireAllSecureSessions();
 
+    // Group key hints hold key contexts from the GroupDataProvider, which may be finished before or after us.
+    mGroupKeyHints.Clear();
+
     // We don't have a safe way to check or affect the state of our
     // mUnauthenticatedSessions.  We can only hope they got shut down properly.
 
@@ -566,9 +569,8 @@ void SessionManager::ExpireAllSecureSessions()
 
 void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Optional<Transport::SecureSession::Type> & type)
 {
-    mSecureSessions.ForEachSession([&node, &type](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == node &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+    mSecureSessions.ForEachSessionForPeer(node, [&type](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
             session->MarkAsDefunct();
         }
@@ -578,10 +580,10 @@ void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Opti
 
 void SessionManager::UpdateAllSessionsPeerAddress(const ScopedNodeId & node, const Transport::PeerAddress & addr)
 {
-    mSecureSessions.ForEachSession([&node, &addr](auto session) {
+    mSecureSessions.ForEachSessionForPeer(node, [&addr](auto session) {
         // Arguably we should only be updating active and defunct sessions, but there is no harm
         // in updating evicted sessions.
-        if (session->GetPeer() == node && Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
+        if (Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
         {
             session->SetPeerAddress(addr);
         }
@@ -1041,58 +1043,106 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
 }
 
 /**
- * Helper function to implement a single attempt to decrypt a groupcast message
+ * Helper function to implement a single attempt to decrypt a groupcast message in place
  * using the given group key and privacy setting.
  *
+ * If the attempt fails, the message is restored as it was received, for further attempts with other keys:
+ * the packet header is put back in front of the message and obfuscated again, and the payload, which is
+ * only decrypted once it is verified (see SecureMessageCodec::Decrypt), is left as is. With onFailure
+ * kDiscard, the payload is decrypted directly instead, and a failed attempt leaves a message to drop.
+ *
+ * A message that the key authenticates but whose payload header does not decode is left decrypted: this is
+ * an error, as no other key is to be tried on it.
+ *
  * @param[in] partialPacketHeader The partial packet header with non-obfuscated message fields (result of calling DecodeFixed).
  * @param[out] packetHeaderCopy A copy of the packet header, to be filled with privacy decrypted fields
  * @param[out] payloadHeader The payload header of the decrypted message
  * @param[in] applyPrivacy Whether to apply privacy deobfuscation
- * @param[out] msgCopy A copy of the message, to be filled with the decrypted message
+ * @param[in,out] msg The message, decrypted in place if the attempt succeeds
  * @param[in] mac The MAC of the message
  * @param[in] groupContext The group context to use for decryption key material
+ * @param[out] decrypted Whether the message was decrypted successfully
+ * @param[in] onFailure Whether the message has to be restored if the attempt fails
  *
- * @return true if the message was decrypted successfully
- * @return false if the message could not be decrypted
+ * @return CHIP_NO_ERROR unless the message could not be restored after a failed attempt, or was authenticated
+ *         but is malformed
  */
-static bool GroupKeyDecryptAttempt(const PacketHeader & partialPacketHeader, PacketHeader & packetHeaderCopy,
-                                   PayloadHeader & payloadHeader, bool applyPrivacy, System::PacketBufferHandle & msgCopy,
-                                   const MessageAuthenticationCode & mac,
-                                   const Credentials::GroupDataProvider::GroupSession & groupContext)
+static CHIP_ERROR
+GroupKeyDecryptAttempt(const PacketHeader & partialPacketHeader, PacketHeader & packetHeaderCopy, PayloadHeader & payloadHeader,
+                       bool applyPrivacy, System::PacketBufferHandle & msg, const MessageAuthenticationCode & mac,
+                       const Credentials::GroupDataProvider::GroupSession & groupContext, bool & decrypted,
+                       CryptoContext::MessageOnFailure onFailure = CryptoContext::MessageOnFailure::kKeep)
 {
-    bool decrypted = false;
     CryptoContext context(groupContext.keyContext);
+    uint8_t * privacyHeader = partialPacketHeader.PrivacyHeader(msg->Start());
+    size_t privacyLength    = partialPacketHeader.PrivacyHeaderLength();
+    decrypted               = false;
 
     if (applyPrivacy)
     {
         // Perform privacy deobfuscation, if applicable.
-        uint8_t * privacyHeader = partialPacketHeader.PrivacyHeader(msgCopy->Start());
-        size_t privacyLength    = partialPacketHeader.PrivacyHeaderLength();
         if (CHIP_NO_ERROR != context.PrivacyDecrypt(privacyHeader, privacyLength, privacyHeader, partialPacketHeader, mac))
         {
-            return false;
+            return CHIP_NO_ERROR;
         }
     }
 
-    if (packetHeaderCopy.DecodeAndConsume(msgCopy) != CHIP_NO_ERROR)
+    uint16_t headerSize = 0;
+    if (packetHeaderCopy.Decode(msg->Start(), msg->DataLength(), &headerSize) != CHIP_NO_ERROR)
     {
         ChipLogError(Inet, "Failed to decode Groupcast packet header. Discarding.");
-        return false;
     }
-
     // Optimization to reduce number of decryption attempts
-    GroupId groupId = packetHeaderCopy.GetDestinationGroupId().Value();
-    if (groupId != groupContext.group_id)
+    else if (packetHeaderCopy.GetDestinationGroupId().Value() == groupContext.group_id)
+    {
+        CryptoContext::NonceStorage nonce;
+        CryptoContext::BuildNonce(nonce, packetHeaderCopy.GetSecurityFlags(), packetHeaderCopy.GetMessageCounter(),
+                                  packetHeaderCopy.GetSourceNodeId().Value());
+
+        uint8_t * start = msg->Start();
+        msg->ConsumeHead(headerSize);
+        const size_t length = msg->DataLength();
+        CHIP_ERROR err      = SecureMessageCodec::Decrypt(context, nonce, payloadHeader, packetHeaderCopy, msg, onFailure);
+        decrypted           = (err == CHIP_NO_ERROR);
+        // Only a message that was decrypted has its data length changed.
+        VerifyOrReturnError(decrypted || msg->DataLength() == length, err);
+        if (!decrypted)
+        {
+            msg->SetStart(start);
+        }
+    }
+
+    if (applyPrivacy && !decrypted)
     {
-        return false;
+        // Privacy obfuscation is AES-CTR, which applied again restores the obfuscated header.
+        ReturnErrorOnFailure(context.PrivacyDecrypt(privacyHeader, privacyLength, privacyHeader, partialPacketHeader, mac));
     }
 
-    CryptoContext::NonceStorage nonce;
-    CryptoContext::BuildNonce(nonce, packetHeaderCopy.GetSecurityFlags(), packetHeaderCopy.GetMessageCounter(),
-                              packetHeaderCopy.GetSourceNodeId().Value());
-    decrypted = (CHIP_NO_ERROR == SecureMessageCodec::Decrypt(context, nonce, payloadHeader, packetHeaderCopy, msgCopy));
+    return CHIP_NO_ERROR;
+}
 
-    return decrypted;
+// Attempt decryption of msg in place with the group key, with and without privacy as applicable, leaving msg as
+// received for further attempts with other keys if it fails. Fails if msg could not be restored, or is authentic but
+// malformed (see GroupKeyDecryptAttempt): either way it is to be dropped.
+static CHIP_ERROR GroupKeyTrialDecrypt(const PacketHeader & partialPacketHeader, PacketHeader & packetHeaderCopy,
+                                       PayloadHeader & payloadHeader, System::PacketBufferHandle & msg,
+                                       const MessageAuthenticationCode & mac,
+                                       const Credentials::GroupDataProvider::GroupSession & groupContext, bool & decrypted)
+{
+    bool privacy = partialPacketHeader.HasPrivacyFlag();
+    ReturnErrorOnFailure(
+        GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, privacy, msg, mac, groupContext, decrypted));
+
+#if CHIP_CONFIG_PRIVACY_ACCEPT_NONSPEC_SVE2
+    if (privacy && !decrypted)
+    {
+        // Try processing the P=1 message again without privacy as a work-around for invalid early-SVE2 nodes.
+        ReturnErrorOnFailure(
+            GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, false, msg, mac, groupContext, decrypted));
+    }
+#endif // CHIP_CONFIG_PRIVACY_ACCEPT_NONSPEC_SVE2
+
+    return CHIP_NO_ERROR;
 }
 
 void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPacketHeader,
@@ -1102,7 +1152,6 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
 
     PayloadHeader payloadHeader;
     PacketHeader packetHeaderCopy; /// Packet header decoded per group key, with privacy decrypted fields
-    System::PacketBufferHandle msgCopy;
     Credentials::GroupDataProvider * groups = Credentials::GetGroupDataProvider();
     VerifyOrReturn(nullptr != groups);
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -1119,18 +1168,6 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
         return;
     }
 
-    // Trial decryption with GroupDataProvider
-    Credentials::GroupDataProvider::GroupSession groupContext;
-
-    AutoRelease<Credentials::GroupDataProvider::GroupSessionIterator> iter(
-        groups->IterateGroupSessions(partialPacketHeader.GetSessionId()));
-
-    if (iter.IsNull())
-    {
-        ChipLogError(Inet, "Failed to retrieve Groups iterator. Discarding everything");
-        return;
-    }
-
     // Extract MIC from the end of the message.
     uint8_t * data     = msg->Start();
     size_t len         = msg->DataLength();
@@ -1142,44 +1179,100 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
     ReturnOnFailure(mac.Decode(partialPacketHeader, &data[len - footerLen], footerLen, &taglen));
     VerifyOrReturn(taglen == footerLen);
 
+    // Without privacy, the source node and destination group are in the clear and make group key hints exact.
+    bool privacy               = partialPacketHeader.HasPrivacyFlag();
+    NodeId sourceNodeId        = kUndefinedNodeId;
+    GroupId destinationGroupId = kUndefinedGroupId;
+    if (!privacy)
+    {
+        PacketHeader cleartextHeader;
+        uint16_t headerSize = 0;
+        if (cleartextHeader.Decode(data, len, &headerSize) == CHIP_NO_ERROR && cleartextHeader.GetSourceNodeId().HasValue() &&
+            cleartextHeader.GetDestinationGroupId().HasValue())
+        {
+            sourceNodeId       = cleartextHeader.GetSourceNodeId().Value();
+            destinationGroupId = cleartextHeader.GetDestinationGroupId().Value();
+        }
+    }
+
+    Credentials::GroupDataProvider::GroupSession groupContext;
     bool decrypted = false;
-    while (!decrypted && iter->Next(groupContext))
+
+    const Transport::GroupKeyHintCache::Hint * hint =
+        mGroupKeyHints.Find(*groups, partialPacketHeader.GetSessionId(), sourceNodeId);
+    if (hint != nullptr && hint->unique && destinationGroupId != kUndefinedGroupId && hint->session.group_id == destinationGroupId)
     {
-        CryptoContext context(groupContext.keyContext);
-        msgCopy = msg.CloneData();
-        if (msgCopy.IsNull())
+        // No other key can decrypt a message to this group with this session ID, so the message need not be kept for
+        // other attempts. Exact hints are only found for messages without privacy.
+        groupContext = hint->session;
+        ReturnOnFailure(GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, false, msg, mac, groupContext,
+                                               decrypted, CryptoContext::MessageOnFailure::kDiscard));
+        if (!decrypted)
         {
-            ChipLogError(Inet, "Failed to clone Groupcast message buffer. Discarding.");
+            ChipLogError(Inet, "Failed to decrypt group message. Discarding everything");
             return;
         }
+    }
+    else
+    {
+        // The hint key is the first one the iterator yields for its fabric and group, which need not be tried again.
+        bool skipHintKey = false;
+        Credentials::GroupDataProvider::GroupSession hintContext;
+        if (hint != nullptr)
+        {
+            groupContext = hintContext = hint->session;
+            ReturnOnFailure(
+                GroupKeyTrialDecrypt(partialPacketHeader, packetHeaderCopy, payloadHeader, msg, mac, groupContext, decrypted));
+            skipHintKey = true;
+        }
 
-        bool privacy = partialPacketHeader.HasPrivacyFlag();
-        decrypted =
-            GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, privacy, msgCopy, mac, groupContext);
-
-#if CHIP_CONFIG_PRIVACY_ACCEPT_NONSPEC_SVE2
-        if (privacy && !decrypted)
+        if (!decrypted)
         {
-            // Try processing the P=1 message again without privacy as a work-around for invalid early-SVE2 nodes.
-            msgCopy = msg.CloneData();
-            if (msgCopy.IsNull())
+            // Trial decryption with GroupDataProvider
+            AutoRelease<Credentials::GroupDataProvider::GroupSessionIterator> iter(
+                groups->IterateGroupSessions(partialPacketHeader.GetSessionId()));
+
+            if (iter.IsNull())
             {
-                ChipLogError(Inet, "Failed to clone Groupcast message buffer. Discarding.");
+                ChipLogError(Inet, "Failed to retrieve Groups iterator. Discarding everything");
                 return;
             }
-            decrypted =
-                GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, false, msgCopy, mac, groupContext);
+
+            // Count the keys that could be tried on a message to the destination group, to know
+            // whether the hint for the successful one is unique.
+            size_t destinationGroupKeys = 0;
+            while (!decrypted && iter->Next(groupContext))
+            {
+                destinationGroupKeys += (groupContext.group_id == destinationGroupId) ? 1 : 0;
+                if (skipHintKey && groupContext.fabric_index == hintContext.fabric_index &&
+                    groupContext.group_id == hintContext.group_id)
+                {
+                    skipHintKey = false;
+                    continue;
+                }
+                ReturnOnFailure(
+                    GroupKeyTrialDecrypt(partialPacketHeader, packetHeaderCopy, payloadHeader, msg, mac, groupContext, decrypted));
+            }
+
+            if (decrypted)
+            {
+                Credentials::GroupDataProvider::GroupSession otherContext;
+                while (destinationGroupId != kUndefinedGroupId && destinationGroupKeys < 2 && iter->Next(otherContext))
+                {
+                    destinationGroupKeys += (otherContext.group_id == destinationGroupId) ? 1 : 0;
+                }
+                mGroupKeyHints.Add(*groups, partialPacketHeader.GetSessionId(), sourceNodeId, groupContext,
+                                   destinationGroupKeys == 1);
+            }
+            iter.Release();
         }
-#endif // CHIP_CONFIG_PRIVACY_ACCEPT_NONSPEC_SVE2
-    }
-    iter.Release();
 
-    if (!decrypted)
-    {
-        ChipLogError(Inet, "Failed to decrypt group message. Discarding everything");
-        return;
+        if (!decrypted)
+        {
+            ChipLogError(Inet, "Failed to decrypt group message. Discarding everything");
+            return;
+        }
     }
-    msg = std::move(msgCopy);
 
     // MCSP check
     if (packetHeaderCopy.IsValidMCSPMsg())
@@ -1269,13 +1362,12 @@ Optional<SessionHandle> SessionManager::FindSecureSessionForNode(ScopedNodeId pe
     SecureSession * tcpSession = nullptr;
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
-    mSecureSessions.ForEachSession([&peerNodeId, &type, &mrpSession,
+    mSecureSessions.ForEachSessionForPeer(peerNodeId, [&type, &mrpSession,
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
-                                    &tcpSession,
+                                                       &tcpSession,
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
-                                    &transportPayloadCapability](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == peerNodeId &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+                                                       &transportPayloadCapability](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
             if (transportPayloadCapability == TransportPayloadCapability::kMRPOrTCPCompatiblePayload ||
                 transportPayloadCapability == TransportPayloadCapability::kLargePayload)
@@ -38,6 +38,7 @@
 #include <messaging/ReliableMessageProtocolConfig.h>
 #include <protocols/secure_channel/Constants.h>
 #include <transport/CryptoContext.h>
+#include <transport/GroupKeyHintCache.h>
 #include <transport/GroupPeerMessageCounter.h>
 #include <transport/GroupSession.h>
 #include <transport/MessageCounterManagerInterface.h>
@@ -461,6 +462,11 @@ public:
     TransportMgrBase * GetTransportManager() const { return mTransportMgr; }
     Transport::SecureSessionTable & GetSecureSessions() { return mSecureSessions; }
 
+    /**
+     * @brief Group key hints used to decrypt incoming group messages, mostly to read their hit and miss counters.
+     */
+    const Transport::GroupKeyHintCache & GetGroupKeyHintCache() const { return mGroupKeyHints; }
+
     /**
      * @brief
      *   Handle received secure message. Implements TransportMgrDelegate
@@ -557,6 +563,7 @@ private:
     Transport::SecureSessionTable mSecureSessions;
     State mState; // < Initialization state of the object
     chip::Transport::GroupOutgoingCounters mGroupClientCounter;
+    Transport::GroupKeyHintCache mGroupKeyHints;
 
 #if INET_CONFIG_ENABLE_TCP_ENDPOINT
     OnTCPConnectionReceivedCallback mConnReceivedCb = nullptr;
@@ -140,6 +140,63 @@ TEST_F(TestPeerConnections, TestFindByKeyId)
     System::Clock::Internal::SetSystemClockForTesting(realClock);
 }
 
+TEST_F(TestPeerConnections, TestFindByPeer)
+{
+    SecureSessionTable connections;
+    System::Clock::Internal::MockClock clock;
+    System::Clock::ClockBase * realClock = &System::SystemClock();
+    System::Clock::Internal::SetSystemClockForTesting(&clock);
+
+    auto countSessionsForPeer = [&connections](const ScopedNodeId & peer) {
+        unsigned count = 0;
+        connections.ForEachSessionForPeer(peer, [&count, &peer](auto * session) {
+            EXPECT_EQ(session->GetPeer(), peer);
+            count++;
+            return Loop::Continue;
+        });
+        return count;
+    };
+
+    // Two sessions to the first peer, local session ids 2 and 6
+    auto session1 = connections.CreateNewSecureSessionForTest(SecureSession::Type::kCASE, 2, kLocalNodeId, kCasePeer1NodeId,
+                                                              kPeer1CATs, 1, kFabricIndex, GetDefaultMRPConfig());
+    EXPECT_TRUE(session1.HasValue());
+    auto session2 = connections.CreateNewSecureSessionForTest(SecureSession::Type::kCASE, 6, kLocalNodeId, kCasePeer1NodeId,
+                                                              kPeer1CATs, 5, kFabricIndex, GetDefaultMRPConfig());
+    EXPECT_TRUE(session2.HasValue());
+
+    // One session to the second peer, local session id 4
+    auto session3 = connections.CreateNewSecureSessionForTest(SecureSession::Type::kCASE, 4, kLocalNodeId, kCasePeer2NodeId,
+                                                              kPeer2CATs, 3, kFabricIndex, GetDefaultMRPConfig());
+    EXPECT_TRUE(session3.HasValue());
+
+    EXPECT_EQ(countSessionsForPeer(ScopedNodeId(kCasePeer1NodeId, kFabricIndex)), 2u);
+    EXPECT_EQ(countSessionsForPeer(ScopedNodeId(kCasePeer2NodeId, kFabricIndex)), 1u);
+    EXPECT_EQ(countSessionsForPeer(ScopedNodeId(kCasePeer2NodeId, static_cast<FabricIndex>(kFabricIndex + 1))), 0u);
+
+    // Released sessions must no longer be found by either key.
+    session2.Value()->AsSecureSession()->MarkForEviction();
+    session2.ClearValue();
+
+    EXPECT_FALSE(connections.FindSecureSessionByLocalKey(6).HasValue());
+    EXPECT_TRUE(connections.FindSecureSessionByLocalKey(2).HasValue());
+    EXPECT_TRUE(connections.FindSecureSessionByLocalKey(4).HasValue());
+    EXPECT_EQ(countSessionsForPeer(ScopedNodeId(kCasePeer1NodeId, kFabricIndex)), 1u);
+
+    // A pending session is found by its local session id, and by its peer once activated.
+    auto pending = connections.CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+    EXPECT_TRUE(pending.HasValue());
+    uint16_t pendingSessionId = pending.Value()->AsSecureSession()->GetLocalSessionId();
+    EXPECT_TRUE(connections.FindSecureSessionByLocalKey(pendingSessionId).HasValue());
+
+    pending.Value()->AsSecureSession()->Activate(ScopedNodeId(kLocalNodeId, kFabricIndex),
+                                                 ScopedNodeId(kCasePeer2NodeId, kFabricIndex), kPeer2CATs, 7,
+                                                 SessionParameters(GetDefaultMRPConfig()));
+    EXPECT_EQ(countSessionsForPeer(ScopedNodeId(kCasePeer2NodeId, kFabricIndex)), 2u);
+
+    System::Clock::Internal::SetSystemClockForTesting(realClock);
+}
+
 struct ExpiredCallInfo
 {
     int callCount                   = 0;
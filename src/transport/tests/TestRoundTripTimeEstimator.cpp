@@ -0,0 +1,132 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the RoundTripTimeEstimator implementation.
+ */
+
+#include <pw_unit_test/framework.h>
+
+#include <lib/core/StringBuilderAdapters.h>
+#include <transport/RoundTripTimeEstimator.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::System::Clock::Literals;
+using chip::Transport::RoundTripTimeEstimator;
+
+constexpr System::Clock::Milliseconds32 kNoMinimum = 0_ms32;
+constexpr System::Clock::Milliseconds32 kNoMaximum = System::Clock::Milliseconds32(UINT32_MAX);
+
+TEST(TestRoundTripTimeEstimator, FirstSample)
+{
+    RoundTripTimeEstimator estimator;
+    EXPECT_FALSE(estimator.HasSample());
+    EXPECT_EQ(estimator.GetSampleCount(), 0u);
+
+    // SRTT = R, RTTVAR = R / 2, RTO = SRTT + 4 * RTTVAR.
+    estimator.AddSample(100_ms32);
+    EXPECT_TRUE(estimator.HasSample());
+    EXPECT_EQ(estimator.GetSampleCount(), 1u);
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 100_ms32);
+    EXPECT_EQ(estimator.GetRttVariation(), 50_ms32);
+    EXPECT_EQ(estimator.GetLatestRtt(), 100_ms32);
+    EXPECT_EQ(estimator.GetMinRtt(), 100_ms32);
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(kNoMinimum, kNoMaximum), 300_ms32);
+}
+
+TEST(TestRoundTripTimeEstimator, SteadyRoundTripTime)
+{
+    RoundTripTimeEstimator estimator;
+    estimator.AddSample(100_ms32);
+
+    // RTTVAR = 3/4 * 50 + 1/4 * 0, with the fraction kept.
+    estimator.AddSample(100_ms32);
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 100_ms32);
+    EXPECT_EQ(estimator.GetRttVariation(), 37_ms32);
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(kNoMinimum, kNoMaximum), 250_ms32);
+
+    // The variation vanishes, and the timeout gets down to the round-trip time.
+    for (int i = 0; i < 50; i++)
+    {
+        estimator.AddSample(100_ms32);
+    }
+    EXPECT_EQ(estimator.GetSampleCount(), 52u);
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 100_ms32);
+    EXPECT_EQ(estimator.GetRttVariation(), 0_ms32);
+    EXPECT_GE(estimator.GetRetransmissionTimeout(kNoMinimum, kNoMaximum), 100_ms32);
+    EXPECT_LE(estimator.GetRetransmissionTimeout(kNoMinimum, kNoMaximum), 105_ms32);
+}
+
+TEST(TestRoundTripTimeEstimator, VaryingRoundTripTime)
+{
+    RoundTripTimeEstimator estimator;
+    for (int i = 0; i < 50; i++)
+    {
+        estimator.AddSample(100_ms32);
+    }
+    const System::Clock::Milliseconds32 steadyTimeout = estimator.GetRetransmissionTimeout(kNoMinimum, kNoMaximum);
+
+    // SRTT moves by 1/8 of the error, and RTTVAR by 1/4 of the deviation, which weighs 4 times in the timeout.
+    estimator.AddSample(180_ms32);
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 110_ms32);
+    EXPECT_EQ(estimator.GetLatestRtt(), 180_ms32);
+    EXPECT_EQ(estimator.GetMinRtt(), 100_ms32);
+    EXPECT_GE(estimator.GetRetransmissionTimeout(kNoMinimum, kNoMaximum), steadyTimeout + 90_ms32);
+
+    // Shorter round-trip times bring SRTT down.
+    for (int i = 0; i < 50; i++)
+    {
+        estimator.AddSample(20_ms32);
+    }
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 20_ms32);
+    EXPECT_EQ(estimator.GetMinRtt(), 20_ms32);
+    EXPECT_LE(estimator.GetRetransmissionTimeout(kNoMinimum, kNoMaximum), 25_ms32);
+}
+
+TEST(TestRoundTripTimeEstimator, RetransmissionTimeoutBounds)
+{
+    RoundTripTimeEstimator estimator;
+    estimator.AddSample(100_ms32);
+
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(200_ms32, 400_ms32), 300_ms32);
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(400_ms32, 500_ms32), 400_ms32);
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(100_ms32, 250_ms32), 250_ms32);
+
+    // The minimum wins over a smaller maximum.
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(350_ms32, 250_ms32), 350_ms32);
+}
+
+TEST(TestRoundTripTimeEstimator, Reset)
+{
+    RoundTripTimeEstimator estimator;
+    estimator.AddSample(100_ms32);
+    estimator.AddSample(300_ms32);
+
+    estimator.Reset();
+    EXPECT_FALSE(estimator.HasSample());
+
+    estimator.AddSample(40_ms32);
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 40_ms32);
+    EXPECT_EQ(estimator.GetRttVariation(), 20_ms32);
+    EXPECT_EQ(estimator.GetMinRtt(), 40_ms32);
+}
+
+} // namespace
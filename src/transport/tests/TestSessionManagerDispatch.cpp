@@ -37,6 +37,7 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
+#include <system/SystemStats.h>
 #include <transport/SessionManager.h>
 #include <transport/TransportMgr.h>
 #include <transport/tests/LoopbackTransportManager.h>
@@ -599,10 +600,20 @@ TEST_F(TestSessionManagerDispatch, TestSessionManagerDispatch)
         chip::System::PacketBufferHandle msg =
             chip::MessagePacketBuffer::NewWithData(reinterpret_cast<const uint8_t *>(privacy), testEntry.privacyLength);
 
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS && !CHIP_SYSTEM_CONFIG_USE_LWIP
+        // Messages are decrypted in place: no copy of the message is made, even across group key trials.
+        const System::Stats::count_t buffersInUse = System::Stats::GetResourcesInUse()[System::Stats::kSystemLayer_NumPacketBufs];
+        System::Stats::GetHighWatermarks()[System::Stats::kSystemLayer_NumPacketBufs] = buffersInUse;
+#endif
+
         const PeerAddress peerAddress = AddressFromString(testEntry.peerAddr);
         sessionManager.OnMessageReceived(peerAddress, std::move(msg));
         EXPECT_EQ(callback.NumMessagesReceived(), testEntry.expectedMessageCount);
 
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS && !CHIP_SYSTEM_CONFIG_USE_LWIP
+        EXPECT_LE(System::Stats::GetHighWatermarks()[System::Stats::kSystemLayer_NumPacketBufs], buffersInUse);
+#endif
+
         if ((testEntry.expectedMessageCount == 0) && (callback.NumMessagesReceived() == 0))
         {
             ChipLogProgress(Test, "::: TestSessionManagerDispatch[%d] PASS (negative test case)", i);
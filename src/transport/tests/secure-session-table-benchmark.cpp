@@ -0,0 +1,113 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a microbenchmark for SecureSessionTable lookups.
+ *
+ *      The table is filled with CASE sessions (up to 10000, or
+ *      CHIP_CONFIG_SECURE_SESSION_POOL_SIZE if smaller), each to a distinct peer,
+ *      and the average cost of FindSecureSessionByLocalKey() and of
+ *      ForEachSessionForPeer() is reported. Build with
+ *      CHIP_CONFIG_SECURE_SESSION_POOL_SIZE=10000 and
+ *      CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX set to 0 and to 1 to compare the
+ *      linear scan with the hash indices.
+ *
+ *      Usage: secure-session-table-benchmark [session-count] [lookup-count]
+ */
+
+#include <algorithm>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/tests/BenchmarkSupport.h>
+#include <transport/SecureSessionTable.h>
+
+using namespace chip;
+using namespace chip::Transport;
+using namespace chip::Test;
+
+namespace {
+
+constexpr NodeId kLocalNodeId      = 0xC439A991071292DB;
+constexpr NodeId kFirstPeerNodeId  = 0x1000;
+constexpr FabricIndex kFabricIndex = 1;
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    const uint32_t sessionCount = std::min<uint32_t>(ParseArg(argc, argv, 1, 10000), CHIP_CONFIG_SECURE_SESSION_POOL_SIZE);
+    const uint32_t lookupCount  = ParseArg(argc, argv, 2, 1000000);
+
+    ScopedPlatformMemory platformMemory;
+
+    {
+        // The table (and its indices) is too large for the stack at this pool size.
+        auto table = Platform::MakeUnique<SecureSessionTable>();
+        VerifyOrDie(table);
+        table->Init();
+
+        // Test sessions hold a reference on themselves until evicted, so they stay in the table
+        // after the returned handles go away.
+        for (uint32_t i = 0; i < sessionCount; i++)
+        {
+            VerifyOrDie(table
+                            ->CreateNewSecureSessionForTest(SecureSession::Type::kCASE, static_cast<uint16_t>(i + 1), kLocalNodeId,
+                                                            kFirstPeerNodeId + i, CATValues(), static_cast<uint16_t>(i + 1),
+                                                            kFabricIndex, GetDefaultMRPConfig())
+                            .HasValue());
+        }
+
+        printf("SecureSession table benchmark: %" PRIu32 " sessions, %" PRIu32 " lookups, pool size %d, index %s\n", sessionCount,
+               lookupCount, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE, CHIP_CONFIG_SECURE_SESSION_TABLE_INDEX ? "enabled" : "disabled");
+
+        // Stride through the sessions by a large prime so that consecutive lookups hit sessions far
+        // apart in the table rather than walking it in allocation order.
+        const uint32_t stride = 7919;
+        uint32_t next         = 0;
+        uint32_t found        = 0;
+
+        System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+        for (uint32_t i = 0; i < lookupCount; i++)
+        {
+            next = (next + stride) % sessionCount;
+            found += table->FindSecureSessionByLocalKey(static_cast<uint16_t>(next + 1)).HasValue() ? 1 : 0;
+        }
+        printf("FindSecureSessionByLocalKey: %.1f ns/lookup (%" PRIu32 " found)\n", ElapsedNanoseconds(start) / lookupCount,
+               found);
+
+        found = 0;
+        start = System::SystemClock().GetMonotonicMicroseconds64();
+        for (uint32_t i = 0; i < lookupCount; i++)
+        {
+            next = (next + stride) % sessionCount;
+            table->ForEachSessionForPeer(ScopedNodeId(kFirstPeerNodeId + next, kFabricIndex), [&found](auto *) {
+                found++;
+                return Loop::Continue;
+            });
+        }
+        printf("ForEachSessionForPeer:       %.1f ns/lookup (%" PRIu32 " found)\n", ElapsedNanoseconds(start) / lookupCount,
+               found);
+    }
+
+    return EXIT_SUCCESS;
+}